@@ -0,0 +1,144 @@
+#include "mbed_events.h"
+#include "mbed.h"
+#include "rtos.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+
+// counter shared between the pool's threads
+volatile int counter = 0;
+Mutex counter_mutex;
+
+void count(int n) {
+    counter_mutex.lock();
+    counter += n;
+    counter_mutex.unlock();
+}
+
+bool wait_for_count(int n) {
+    for (int i = 0; i < 1000 && counter < n; i++) {
+        Thread::wait(1);
+    }
+
+    return counter == n;
+}
+
+void count_one() {
+    count(1);
+}
+
+void failure_test() {
+    // buffers that can not be allocated start no threads
+    EventQueuePool pool(2, 0x7fffffff);
+    TEST_ASSERT(!pool.is_valid());
+    TEST_ASSERT_EQUAL(0, pool.call(count, 1));
+    TEST_ASSERT_EQUAL(0, pool.call_strand(1, count_one));
+}
+
+template <int N>
+void call_test() {
+    EventQueuePool pool(2, 2*N*EVENTS_EVENT_SIZE);
+    counter = 0;
+
+    for (int i = 0; i < N; i++) {
+        int id = pool.call(count, 1);
+        TEST_ASSERT_NOT_EQUAL(0, id);
+    }
+
+    TEST_ASSERT(wait_for_count(N));
+}
+
+template <int N>
+void call_in_test() {
+    EventQueuePool pool(2, 2*N*EVENTS_EVENT_SIZE);
+    counter = 0;
+
+    for (int i = 0; i < N; i++) {
+        int id = pool.call_in(i*10, count, 1);
+        TEST_ASSERT_NOT_EQUAL(0, id);
+    }
+
+    TEST_ASSERT(wait_for_count(N));
+}
+
+template <int N>
+void cancel_test() {
+    EventQueuePool pool(2, 2*N*EVENTS_EVENT_SIZE);
+    counter = 0;
+
+    int ids[N];
+    for (int i = 0; i < N; i++) {
+        ids[i] = pool.call_in(100, count, 1);
+        TEST_ASSERT_NOT_EQUAL(0, ids[i]);
+    }
+
+    for (int i = 0; i < N; i += 2) {
+        pool.cancel(ids[i]);
+    }
+
+    Thread::wait(200);
+    TEST_ASSERT_EQUAL(N/2, counter);
+}
+
+// events in a strand must run one at a time and in order
+volatile bool strand_busy = false;
+int strand_next = 0;
+
+void strand_func(int i) {
+    TEST_ASSERT(!strand_busy);
+    strand_busy = true;
+    Thread::wait(1);
+    TEST_ASSERT_EQUAL(strand_next, i);
+    strand_next++;
+    strand_busy = false;
+
+    count(1);
+}
+
+struct strand_call {
+    int i;
+    void operator()() { strand_func(i); }
+};
+
+template <int N>
+void strand_test() {
+    EventQueuePool pool(3, 4*N*EVENTS_EVENT_SIZE);
+    counter = 0;
+    strand_next = 0;
+
+    for (int i = 0; i < N; i++) {
+        strand_call call = {i};
+        int id = pool.call_strand(7, call);
+        TEST_ASSERT_NOT_EQUAL(0, id);
+
+        id = pool.call(count, 1);
+        TEST_ASSERT_NOT_EQUAL(0, id);
+    }
+
+    TEST_ASSERT(wait_for_count(2*N));
+    TEST_ASSERT_EQUAL(N, strand_next);
+}
+
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+const Case cases[] = {
+    Case("Testing pool allocation failure", failure_test),
+    Case("Testing pool calls", call_test<20>),
+    Case("Testing pool call_in", call_in_test<20>),
+    Case("Testing pool cancel", cancel_test<20>),
+    Case("Testing pool strands", strand_test<20>),
+};
+
+Specification specification(test_setup, cases);
+
+int main() {
+    return !Harness::run(specification);
+}
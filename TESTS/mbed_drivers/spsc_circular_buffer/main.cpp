@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "platform/SPSCCircularBuffer.h"
+
+using namespace utest::v1;
+
+#define BUFFER_SIZE 16
+#define STREAM_LENGTH 4096
+
+void test_case_push_pop()
+{
+    SPSCCircularBuffer<uint32_t, BUFFER_SIZE> buffer;
+    uint32_t data;
+
+    TEST_ASSERT_TRUE(buffer.empty());
+    TEST_ASSERT_FALSE(buffer.pop(data));
+
+    // fill the buffer, a full buffer rejects further data
+    for (uint32_t i = 0; i < BUFFER_SIZE; i++) {
+        TEST_ASSERT_TRUE(buffer.push(i));
+    }
+    TEST_ASSERT_TRUE(buffer.full());
+    TEST_ASSERT_FALSE(buffer.push(BUFFER_SIZE));
+
+    for (uint32_t i = 0; i < BUFFER_SIZE; i++) {
+        TEST_ASSERT_TRUE(buffer.pop(data));
+        TEST_ASSERT_EQUAL_UINT32(i, data);
+    }
+    TEST_ASSERT_TRUE(buffer.empty());
+}
+
+void test_case_bulk_wrap()
+{
+    SPSCCircularBuffer<uint8_t, BUFFER_SIZE> buffer;
+    uint8_t in[BUFFER_SIZE];
+    uint8_t out[BUFFER_SIZE];
+    uint8_t next_in = 0;
+    uint8_t next_out = 0;
+
+    // odd sized spans force copies across the end of the buffer
+    for (int round = 0; round < 100; round++) {
+        uint32_t n = (round % 7) + 3;
+        for (uint32_t i = 0; i < n; i++) {
+            in[i] = next_in + i;
+        }
+        next_in += buffer.push_n(in, n);
+
+        n = buffer.pop_n(out, (round % 5) + 1);
+        for (uint32_t i = 0; i < n; i++) {
+            TEST_ASSERT_EQUAL_UINT8(next_out++, out[i]);
+        }
+    }
+
+    // whatever is left can be consumed in place
+    const uint8_t *span;
+    while (uint32_t n = buffer.peek(&span)) {
+        for (uint32_t i = 0; i < n; i++) {
+            TEST_ASSERT_EQUAL_UINT8(next_out++, span[i]);
+        }
+        buffer.consume(n);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(next_in, next_out);
+    TEST_ASSERT_TRUE(buffer.empty());
+}
+
+// stream bytes from a ticker interrupt to the main thread
+SPSCCircularBuffer<uint8_t, BUFFER_SIZE> stream;
+volatile uint32_t stream_sent;
+
+void stream_isr()
+{
+    uint8_t data[3];
+    uint32_t n = 0;
+    while (n < sizeof(data) && stream_sent + n < STREAM_LENGTH) {
+        data[n] = (uint8_t)(stream_sent + n);
+        n++;
+    }
+
+    stream_sent += stream.push_n(data, n);
+}
+
+void test_case_isr_stream()
+{
+    Ticker ticker;
+    stream.reset();
+    stream_sent = 0;
+    ticker.attach_us(stream_isr, 20);
+
+    uint32_t received = 0;
+    Timer timer;
+    timer.start();
+    while (received < STREAM_LENGTH && timer.read_ms() < 5000) {
+        uint8_t data;
+        if (stream.pop(data)) {
+            TEST_ASSERT_EQUAL_UINT8((uint8_t)received, data);
+            received++;
+        }
+    }
+
+    ticker.detach();
+    TEST_ASSERT_EQUAL_UINT32(STREAM_LENGTH, received);
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("SPSC circular buffer - push and pop", test_case_push_pop, greentea_failure_handler),
+    Case("SPSC circular buffer - bulk copies across the end", test_case_bulk_wrap, greentea_failure_handler),
+    Case("SPSC circular buffer - interrupt to thread stream", test_case_isr_stream, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
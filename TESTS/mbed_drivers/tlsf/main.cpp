@@ -0,0 +1,201 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#include "mbed.h"
+#include "platform/mbed_tlsf.h"
+
+using namespace utest::v1;
+
+#define HEAP_SIZE 8192
+#define SLOTS 64
+#define BENCH_OPS 2000
+
+static uint64_t heap_mem[HEAP_SIZE / sizeof(uint64_t)];
+static void *slots[SLOTS];
+
+static mbed_tlsf_t *create_heap() {
+    memset(slots, 0, sizeof(slots));
+    mbed_tlsf_t *tlsf = mbed_tlsf_create(heap_mem, sizeof(heap_mem));
+    TEST_ASSERT_NOT_NULL(tlsf);
+    return tlsf;
+}
+
+static void check_coalesced(mbed_tlsf_t *tlsf) {
+    mbed_stats_heap_ext_t stats;
+    mbed_tlsf_stats(tlsf, &stats);
+    TEST_ASSERT_EQUAL_UINT32(stats.heap_size, stats.free_size);
+    TEST_ASSERT_EQUAL_UINT32(stats.heap_size, stats.largest_free);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.fragmentation);
+}
+
+void test_malloc_free() {
+    mbed_tlsf_t *tlsf = create_heap();
+
+    for (int i = 0; i < SLOTS; i++) {
+        slots[i] = mbed_tlsf_malloc(tlsf, 1 + i);
+        TEST_ASSERT_NOT_NULL(slots[i]);
+        TEST_ASSERT_EQUAL(0, (uintptr_t)slots[i] % 8);
+        TEST_ASSERT_TRUE(mbed_tlsf_usable_size(slots[i]) >= (size_t)(1 + i));
+        memset(slots[i], i, 1 + i);
+    }
+
+    for (int i = 0; i < SLOTS; i++) {
+        for (int j = 0; j < 1 + i; j++) {
+            TEST_ASSERT_EQUAL_UINT8(i, ((uint8_t *)slots[i])[j]);
+        }
+    }
+
+    for (int i = 0; i < SLOTS; i++) {
+        mbed_tlsf_free(tlsf, slots[i]);
+    }
+    check_coalesced(tlsf);
+}
+
+void test_exhaustion() {
+    mbed_tlsf_t *tlsf = create_heap();
+
+    TEST_ASSERT_NULL(mbed_tlsf_malloc(tlsf, HEAP_SIZE));
+
+    int count = 0;
+    while (count < SLOTS && (slots[count] = mbed_tlsf_malloc(tlsf, 256))) {
+        count++;
+    }
+    TEST_ASSERT_TRUE(count > 0 && count < SLOTS);
+
+    // a freed block is reusable
+    mbed_tlsf_free(tlsf, slots[0]);
+    slots[0] = mbed_tlsf_malloc(tlsf, 256);
+    TEST_ASSERT_NOT_NULL(slots[0]);
+
+    for (int i = 0; i < count; i++) {
+        mbed_tlsf_free(tlsf, slots[i]);
+    }
+    check_coalesced(tlsf);
+}
+
+void test_realloc() {
+    mbed_tlsf_t *tlsf = create_heap();
+
+    uint8_t *p = (uint8_t *)mbed_tlsf_malloc(tlsf, 64);
+    for (int i = 0; i < 64; i++) {
+        p[i] = i;
+    }
+
+    // nothing follows the allocation, so it grows in place
+    uint8_t *q = (uint8_t *)mbed_tlsf_realloc(tlsf, p, 1024);
+    TEST_ASSERT_EQUAL_PTR(p, q);
+
+    // pinned in by a neighbour, so it has to move
+    void *pin = mbed_tlsf_malloc(tlsf, 16);
+    q = (uint8_t *)mbed_tlsf_realloc(tlsf, p, 2048);
+    TEST_ASSERT_NOT_NULL(q);
+    TEST_ASSERT_TRUE(q != p);
+    for (int i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i, q[i]);
+    }
+
+    // shrinking always stays in place
+    p = (uint8_t *)mbed_tlsf_realloc(tlsf, q, 32);
+    TEST_ASSERT_EQUAL_PTR(q, p);
+
+    TEST_ASSERT_NULL(mbed_tlsf_realloc(tlsf, p, 0));
+    mbed_tlsf_free(tlsf, pin);
+    check_coalesced(tlsf);
+}
+
+void test_stats() {
+    mbed_tlsf_t *tlsf = create_heap();
+
+    // free every other block, leaving holes that can not merge
+    for (int i = 0; i < 16; i++) {
+        slots[i] = mbed_tlsf_malloc(tlsf, 200);
+    }
+    for (int i = 0; i < 16; i += 2) {
+        mbed_tlsf_free(tlsf, slots[i]);
+    }
+
+    mbed_stats_heap_ext_t stats;
+    mbed_tlsf_stats(tlsf, &stats);
+    TEST_ASSERT_EQUAL_UINT32(8, stats.free_blocks[1]);
+    TEST_ASSERT_TRUE(stats.largest_free < stats.free_size);
+    TEST_ASSERT_TRUE(stats.fragmentation > 0);
+
+    for (int i = 1; i < 16; i += 2) {
+        mbed_tlsf_free(tlsf, slots[i]);
+    }
+    check_coalesced(tlsf);
+}
+
+// Worst-case malloc and free times under random churn
+void test_benchmark() {
+    mbed_tlsf_t *tlsf = create_heap();
+    Timer timer;
+    int malloc_max = 0;
+    int free_max = 0;
+
+    srand(1);
+    timer.start();
+    for (int i = 0; i < BENCH_OPS; i++) {
+        int slot = rand() % SLOTS;
+        if (slots[slot]) {
+            int start = timer.read_us();
+            mbed_tlsf_free(tlsf, slots[slot]);
+            int time = timer.read_us() - start;
+            free_max = time > free_max ? time : free_max;
+            slots[slot] = NULL;
+        } else {
+            int start = timer.read_us();
+            slots[slot] = mbed_tlsf_malloc(tlsf, 1 + rand() % 256);
+            int time = timer.read_us() - start;
+            malloc_max = time > malloc_max ? time : malloc_max;
+        }
+    }
+
+    for (int i = 0; i < SLOTS; i++) {
+        mbed_tlsf_free(tlsf, slots[i]);
+    }
+    check_coalesced(tlsf);
+
+    printf("tlsf: max malloc %d us, max free %d us\r\n", malloc_max, free_max);
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("TLSF malloc and free", test_malloc_free, greentea_failure_handler),
+    Case("TLSF exhaustion", test_exhaustion, greentea_failure_handler),
+    Case("TLSF realloc", test_realloc, greentea_failure_handler),
+    Case("TLSF stats", test_stats, greentea_failure_handler),
+    Case("TLSF benchmark", test_benchmark, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main() {
+    Harness::run(specification);
+}
@@ -0,0 +1,231 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#include "mbed.h"
+#include "ticker_api.h"
+#include "us_ticker_api.h"
+
+using namespace utest::v1;
+
+/* The event queue is driven through a fake ticker interface so the
+ * measurements only cover the queue itself, not the hardware counter. */
+static volatile timestamp_t fake_now;
+static volatile bool fake_armed;
+static volatile timestamp_t fake_match;
+
+static void fake_init(void) {}
+static uint32_t fake_read(void) { return fake_now; }
+static void fake_disable_interrupt(void) { fake_armed = false; }
+static void fake_clear_interrupt(void) {}
+static void fake_set_interrupt(timestamp_t timestamp) {
+    fake_armed = true;
+    fake_match = timestamp;
+}
+
+static const ticker_interface_t fake_interface = {
+    fake_init,
+    fake_read,
+    fake_disable_interrupt,
+    fake_clear_interrupt,
+    fake_set_interrupt,
+};
+
+static ticker_event_queue_t fake_queue;
+static const ticker_data_t fake_data = {
+    &fake_interface,
+    &fake_queue,
+};
+
+#define MAX_EVENTS 1000
+#define BENCH_REPEAT 100
+
+static ticker_event_t events[MAX_EVENTS + 1];
+static uint32_t fired[MAX_EVENTS + 1];
+static uint32_t fired_count;
+
+static void record_handler(uint32_t id) {
+    fired[fired_count++] = id;
+}
+
+static void reset_queue(timestamp_t now) {
+    fake_queue.head = NULL;
+    fake_now = now;
+    fake_armed = false;
+    fired_count = 0;
+    memset(events, 0, sizeof(events));
+    ticker_set_handler(&fake_data, record_handler);
+}
+
+// pseudo-random spread of timestamps, deterministic between runs
+static timestamp_t spread(uint32_t i) {
+    return (i * 2654435761u) % 1000000;
+}
+
+void test_ordering() {
+    reset_queue(0);
+
+    for (uint32_t i = 0; i < 100; i++) {
+        ticker_insert_event(&fake_data, &events[i], spread(i), i);
+    }
+
+    fake_now = 1000000;
+    ticker_irq_handler(&fake_data);
+
+    TEST_ASSERT_EQUAL_UINT32(100, fired_count);
+    for (uint32_t i = 1; i < fired_count; i++) {
+        TEST_ASSERT_TRUE(spread(fired[i-1]) <= spread(fired[i]));
+    }
+    TEST_ASSERT_FALSE(fake_armed);
+}
+
+void test_wrap_around() {
+    reset_queue(0xfffff000);
+
+    ticker_insert_event(&fake_data, &events[0], 0x00000800, 0);
+    ticker_insert_event(&fake_data, &events[1], 0xfffff800, 1);
+    ticker_insert_event(&fake_data, &events[2], 0x00000000, 2);
+
+    timestamp_t next;
+    TEST_ASSERT_EQUAL(1, ticker_get_next_timestamp(&fake_data, &next));
+    TEST_ASSERT_EQUAL_UINT32(0xfffff800, next);
+    TEST_ASSERT_EQUAL_UINT32(0xfffff800, fake_match);
+
+    fake_now = 0x00000400;
+    ticker_irq_handler(&fake_data);
+
+    TEST_ASSERT_EQUAL_UINT32(2, fired_count);
+    TEST_ASSERT_EQUAL_UINT32(1, fired[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, fired[1]);
+    TEST_ASSERT_TRUE(fake_armed);
+    TEST_ASSERT_EQUAL_UINT32(0x00000800, fake_match);
+}
+
+void test_remove() {
+    reset_queue(0);
+
+    for (uint32_t i = 0; i < 100; i++) {
+        ticker_insert_event(&fake_data, &events[i], spread(i), i);
+    }
+
+    // remove every other event, plus one that was never inserted
+    for (uint32_t i = 0; i < 100; i += 2) {
+        ticker_remove_event(&fake_data, &events[i]);
+    }
+    ticker_remove_event(&fake_data, &events[MAX_EVENTS]);
+
+    timestamp_t next;
+    TEST_ASSERT_EQUAL(1, ticker_get_next_timestamp(&fake_data, &next));
+    TEST_ASSERT_EQUAL_UINT32(next, fake_match);
+
+    fake_now = 1000000;
+    ticker_irq_handler(&fake_data);
+
+    TEST_ASSERT_EQUAL_UINT32(50, fired_count);
+    for (uint32_t i = 0; i < fired_count; i++) {
+        TEST_ASSERT_EQUAL_UINT32(1, fired[i] % 2);
+    }
+    TEST_ASSERT_EQUAL(0, ticker_get_next_timestamp(&fake_data, &next));
+}
+
+void test_coalescing() {
+    reset_queue(0);
+
+    ticker_stats_t before;
+    ticker_get_stats(&fake_data, &before);
+
+    // five events 10 ticks apart, each tolerating 100 ticks of delay
+    for (uint32_t i = 0; i < 5; i++) {
+        ticker_insert_event_with_slack(&fake_data, &events[i], 100 + 10*i, 100, i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(200, fake_match);
+
+    fake_now = 200;
+    ticker_irq_handler(&fake_data);
+
+    ticker_stats_t after;
+    ticker_get_stats(&fake_data, &after);
+    TEST_ASSERT_EQUAL_UINT32(5, fired_count);
+    TEST_ASSERT_EQUAL_UINT32(1, after.irq_count - before.irq_count);
+    TEST_ASSERT_EQUAL_UINT32(5, after.event_count - before.event_count);
+    TEST_ASSERT_FALSE(fake_armed);
+}
+
+template <uint32_t N>
+void test_benchmark() {
+    uint32_t insert_us = 0;
+    uint32_t remove_us = 0;
+    uint32_t irq_us = 0;
+
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        reset_queue(0);
+        for (uint32_t i = 0; i < N; i++) {
+            ticker_insert_event(&fake_data, &events[i], spread(i + r), i);
+        }
+
+        // cost of one insert and one remove with N events pending
+        timestamp_t start = us_ticker_read();
+        ticker_insert_event(&fake_data, &events[N], spread(N + r), N);
+        insert_us += us_ticker_read() - start;
+
+        start = us_ticker_read();
+        ticker_remove_event(&fake_data, &events[(N * r) / BENCH_REPEAT]);
+        remove_us += us_ticker_read() - start;
+
+        // cost of expiring the earliest event
+        timestamp_t next;
+        ticker_get_next_timestamp(&fake_data, &next);
+        fake_now = next;
+        start = us_ticker_read();
+        ticker_irq_handler(&fake_data);
+        irq_us += us_ticker_read() - start;
+    }
+
+    printf("%4lu events: insert %lu ns, remove %lu ns, irq %lu ns\r\n",
+            (unsigned long)N,
+            (unsigned long)(insert_us * (1000 / BENCH_REPEAT)),
+            (unsigned long)(remove_us * (1000 / BENCH_REPEAT)),
+            (unsigned long)(irq_us * (1000 / BENCH_REPEAT)));
+}
+
+status_t greentea_failure_handler(const Case *const source, const failure_t reason) {
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("Ticker queue ordering", test_ordering, greentea_failure_handler),
+    Case("Ticker queue wrap-around", test_wrap_around, greentea_failure_handler),
+    Case("Ticker queue removal", test_remove, greentea_failure_handler),
+    Case("Ticker queue coalescing", test_coalescing, greentea_failure_handler),
+    Case("Ticker queue benchmark, 10 events", test_benchmark<10>, greentea_failure_handler),
+    Case("Ticker queue benchmark, 100 events", test_benchmark<100>, greentea_failure_handler),
+    Case("Ticker queue benchmark, 1000 events", test_benchmark<1000>, greentea_failure_handler),
+};
+
+status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(60, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main() {
+    Harness::run(specification);
+}
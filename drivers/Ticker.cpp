@@ -33,12 +33,12 @@ void Ticker::setup(timestamp_t t) {
     core_util_critical_section_enter();
     remove();
     _delay = t;
-    insert(_delay + ticker_read(_ticker_data));
+    insert(_delay + ticker_read(_ticker_data), _slack);
     core_util_critical_section_exit();
 }
 
 void Ticker::handler() {
-    insert(event.timestamp + _delay);
+    insert(event.timestamp + _delay, _slack);
     _function.call();
 }
 
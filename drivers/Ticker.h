@@ -62,10 +62,10 @@ namespace mbed {
 class Ticker : public TimerEvent {
 
 public:
-    Ticker() : TimerEvent() {
+    Ticker() : TimerEvent(), _slack(0) {
     }
 
-    Ticker(const ticker_data_t *data) : TimerEvent(data) {
+    Ticker(const ticker_data_t *data) : TimerEvent(data), _slack(0) {
         data->interface->init();
     }
 
@@ -122,6 +122,19 @@ public:
         attach_us(Callback<void()>(obj, method), t);
     }
 
+    /** Allow the function to be called late by up to the given number of micro-seconds
+     *
+     *  Ticker events whose windows overlap are serviced from a single
+     *  interrupt, which reduces wakeups on battery powered devices. The
+     *  interval between calls does not drift, only each call may be late.
+     *  Takes effect from the next attach.
+     *
+     *  @param slack the tolerated delay in micro-seconds, 0 to call on time
+     */
+    void set_slack_us(timestamp_t slack) {
+        _slack = slack;
+    }
+
     virtual ~Ticker() {
         detach();
     }
@@ -137,6 +150,7 @@ protected:
 protected:
     timestamp_t         _delay;     /**< Time delay (in microseconds) for re-setting the multi-shot callback. */
     Callback<void()>    _function;  /**< Callback. */
+    timestamp_t         _slack;     /**< Tolerated delay (in microseconds) of each callback. */
 };
 
 } // namespace mbed
@@ -47,6 +47,9 @@ protected:
     // insert in to linked list
     void insert(timestamp_t timestamp);
 
+    // insert in to linked list, allowing the event to fire up to slack late
+    void insert(timestamp_t timestamp, timestamp_t slack);
+
     // remove from linked list, if in it
     void remove();
 
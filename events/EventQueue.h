@@ -42,158 +42,22 @@ template <typename F>
 class Event;
 
 
-/** EventQueue
+/** EventQueueCalls
  *
- *  Flexible event queue for dispatching events
+ *  Overloads of call, call_in and call_every shared by EventQueue and
+ *  EventQueuePool. The arguments are bound into a single function object,
+ *  which is posted with the call(F), call_in(int, F) and call_every(int, F)
+ *  of the derived class Q.
  */
-class EventQueue {
+template <typename Q>
+class EventQueueCalls {
 public:
-    /** Create an EventQueue
-     *
-     *  Create an event queue. The event queue either allocates a buffer of
-     *  the specified size with malloc or uses the user provided buffer.
-     *
-     *  @param size     Size of buffer to use for events in bytes
-     *                  (default to EVENTS_QUEUE_SIZE)
-     *  @param buffer   Pointer to buffer to use for events
-     *                  (default to NULL)
-     */
-    EventQueue(unsigned size=EVENTS_QUEUE_SIZE, unsigned char *buffer=NULL);
-
-    /** Destroy an EventQueue
-     */
-    ~EventQueue();
-
-    /** Dispatch events
-     *
-     *  Executes events until the specified milliseconds have passed.
-     *  If ms is negative, the dispatch function will dispatch events
-     *  indefinitely or until break_dispatch is called on this queue.
-     *
-     *  When called with a finite timeout, the dispatch function is guaranteed
-     *  to terminate. When called with a timeout of 0, the dispatch function
-     *  does not wait and is irq safe.
-     *
-     *  @param ms       Time to wait for events in milliseconds, a negative
-     *                  value will dispatch events indefinitely
-     *                  (default to -1)
-     */
-    void dispatch(int ms=-1);
-
-    /** Dispatch events without a timeout
-     *
-     *  This is equivalent to EventQueue::dispatch with no arguments, but 
-     *  avoids overload ambiguities when passed as a callback.
-     *
-     *  @see EventQueue::dispatch
-     */
-    void dispatch_forever() { dispatch(); }
-
-    /** Break out of a running event loop
-     *
-     *  Forces the specified event queue's dispatch loop to terminate. Pending
-     *  events may finish executing, but no new events will be executed.
-     */
-    void break_dispatch();
-
-    /** Millisecond counter
-     *
-     *  Returns the underlying tick of the event queue represented as the 
-     *  number of milliseconds that have passed since an arbitrary point in
-     *  time. Intentionally overflows to 0 after 2^32-1.
-     *
-     *  @return         The underlying tick of the event queue in milliseconds
-     */
-    unsigned tick();
-
-    /** Cancel an in-flight event
-     *
-     *  Attempts to cancel an event referenced by the unique id returned from
-     *  one of the call functions. It is safe to call cancel after an event
-     *  has already been dispatched.
-     *
-     *  The cancel function is irq safe.
-     *
-     *  If called while the event queue's dispatch loop is active, the cancel
-     *  function does not garuntee that the event will not execute after it
-     *  returns, as the event may have already begun executing.
-     *
-     *  @param id       Unique id of the event
-     */
-    void cancel(int id);
-
-    /** Background an event queue onto a single-shot timer-interrupt
-     *
-     *  When updated, the event queue will call the provided update function
-     *  with a timeout indicating when the queue should be dispatched. A
-     *  negative timeout will be passed to the update function when the
-     *  timer-interrupt is no longer needed.
-     *
-     *  Passing a null function disables the existing update function.
-     *
-     *  The background function allows an event queue to take advantage of
-     *  hardware timers or other event loops, allowing an event queue to be
-     *  ran in the background without consuming the foreground thread.
-     *
-     *  @param update   Function called to indicate when the queue should be
-     *                  dispatched
-     */
-    void background(mbed::Callback<void(int)> update);
-
-    /** Chain an event queue onto another event queue
-     *
-     *  After chaining a queue to a target, calling dispatch on the target
-     *  queue will also dispatch events from this queue. The queues use
-     *  their own buffers and events must be handled independently.
-     *
-     *  A null queue as the target will unchain the existing queue.
-     *
-     *  The chain function allows multiple event queues to be composed,
-     *  sharing the context of a dispatch loop while still being managed
-     *  independently
-     *
-     *  @param target   Queue that will dispatch this queue's events as a
-     *                  part of its dispatch loop
-     */
-    void chain(EventQueue *target);
-
-    /** Calls an event on the queue
-     *
-     *  The specified callback will be executed in the context of the event
-     *  queue's dispatch loop.
-     *
-     *  The call function is irq safe and can act as a mechanism for moving
-     *  events out of irq contexts.
-     *
-     *  @param f        Function to execute in the context of the dispatch loop
-     *  @param a0..a4   Arguments to pass to the callback
-     *  @return         A unique id that represents the posted event and can
-     *                  be passed to cancel, or an id of 0 if there is not
-     *                  enough memory to allocate the event.
-     */
-    template <typename F>
-    int call(F f) {
-        struct local {
-            static void call(void *p) { (*static_cast<F*>(p))(); }
-            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
-        };
-
-        void *p = equeue_alloc(&_equeue, sizeof(F));
-        if (!p) {
-            return 0;
-        }
-
-        F *e = new (p) F(f);
-        equeue_event_dtor(e, &local::dtor);
-        return equeue_post(&_equeue, &local::call, e);
-    }
-
     /** Calls an event on the queue
      *  @see EventQueue::call
      */
     template <typename F, typename A0>
     int call(F f, A0 a0) {
-        return call(context10<F, A0>(f, a0));
+        return static_cast<Q*>(this)->call(context10<F, A0>(f, a0));
     }
 
     /** Calls an event on the queue
@@ -201,7 +65,7 @@ public:
      */
     template <typename F, typename A0, typename A1>
     int call(F f, A0 a0, A1 a1) {
-        return call(context20<F, A0, A1>(f, a0, a1));
+        return static_cast<Q*>(this)->call(context20<F, A0, A1>(f, a0, a1));
     }
 
     /** Calls an event on the queue
@@ -209,7 +73,7 @@ public:
      */
     template <typename F, typename A0, typename A1, typename A2>
     int call(F f, A0 a0, A1 a1, A2 a2) {
-        return call(context30<F, A0, A1, A2>(f, a0, a1, a2));
+        return static_cast<Q*>(this)->call(context30<F, A0, A1, A2>(f, a0, a1, a2));
     }
 
     /** Calls an event on the queue
@@ -217,7 +81,7 @@ public:
      */
     template <typename F, typename A0, typename A1, typename A2, typename A3>
     int call(F f, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call(context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
+        return static_cast<Q*>(this)->call(context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
     }
 
     /** Calls an event on the queue
@@ -225,7 +89,7 @@ public:
      */
     template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call(F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call(context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
+        return static_cast<Q*>(this)->call(context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
     }
 
     /** Calls an event on the queue
@@ -233,7 +97,7 @@ public:
      */
     template <typename T, typename R>
     int call(T *obj, R (T::*method)()) {
-        return call(mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue
@@ -241,7 +105,7 @@ public:
      */
     template <typename T, typename R>
     int call(const T *obj, R (T::*method)() const) {
-        return call(mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue
@@ -249,7 +113,7 @@ public:
      */
     template <typename T, typename R>
     int call(volatile T *obj, R (T::*method)() volatile) {
-        return call(mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue
@@ -257,7 +121,7 @@ public:
      */
     template <typename T, typename R>
     int call(const volatile T *obj, R (T::*method)() const volatile) {
-        return call(mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue
@@ -265,7 +129,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call(T *obj, R (T::*method)(A0), A0 a0) {
-        return call(mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue
@@ -273,7 +137,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call(const T *obj, R (T::*method)(A0) const, A0 a0) {
-        return call(mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue
@@ -281,7 +145,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call(volatile T *obj, R (T::*method)(A0) volatile, A0 a0) {
-        return call(mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue
@@ -289,7 +153,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call(const volatile T *obj, R (T::*method)(A0) const volatile, A0 a0) {
-        return call(mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue
@@ -297,7 +161,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call(T *obj, R (T::*method)(A0, A1), A0 a0, A1 a1) {
-        return call(mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue
@@ -305,7 +169,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call(const T *obj, R (T::*method)(A0, A1) const, A0 a0, A1 a1) {
-        return call(mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue
@@ -313,7 +177,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call(volatile T *obj, R (T::*method)(A0, A1) volatile, A0 a0, A1 a1) {
-        return call(mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue
@@ -321,7 +185,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call(const volatile T *obj, R (T::*method)(A0, A1) const volatile, A0 a0, A1 a1) {
-        return call(mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue
@@ -329,7 +193,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call(T *obj, R (T::*method)(A0, A1, A2), A0 a0, A1 a1, A2 a2) {
-        return call(mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue
@@ -337,7 +201,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call(const T *obj, R (T::*method)(A0, A1, A2) const, A0 a0, A1 a1, A2 a2) {
-        return call(mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue
@@ -345,7 +209,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call(volatile T *obj, R (T::*method)(A0, A1, A2) volatile, A0 a0, A1 a1, A2 a2) {
-        return call(mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue
@@ -353,7 +217,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call(const volatile T *obj, R (T::*method)(A0, A1, A2) const volatile, A0 a0, A1 a1, A2 a2) {
-        return call(mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue
@@ -361,7 +225,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call(T *obj, R (T::*method)(A0, A1, A2, A3), A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call(mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue
@@ -369,7 +233,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call(const T *obj, R (T::*method)(A0, A1, A2, A3) const, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call(mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue
@@ -377,7 +241,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call(volatile T *obj, R (T::*method)(A0, A1, A2, A3) volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call(mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue
@@ -385,7 +249,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call(const volatile T *obj, R (T::*method)(A0, A1, A2, A3) const volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call(mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue
@@ -393,7 +257,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call(T *obj, R (T::*method)(A0, A1, A2, A3, A4), A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call(mbed::callback(obj, method), a0, a1, a2, a3, a4);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Calls an event on the queue
@@ -401,7 +265,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call(const T *obj, R (T::*method)(A0, A1, A2, A3, A4) const, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call(mbed::callback(obj, method), a0, a1, a2, a3, a4);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Calls an event on the queue
@@ -409,7 +273,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call(volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call(mbed::callback(obj, method), a0, a1, a2, a3, a4);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Calls an event on the queue
@@ -417,40 +281,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call(const volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call(mbed::callback(obj, method), a0, a1, a2, a3, a4);
-    }
-
-    /** Calls an event on the queue after a specified delay
-     *
-     *  The specified callback will be executed in the context of the event
-     *  queue's dispatch loop.
-     *
-     *  The call_in function is irq safe and can act as a mechanism for moving
-     *  events out of irq contexts.
-     *
-     *  @param f        Function to execute in the context of the dispatch loop
-     *  @param a0..a4   Arguments to pass to the callback
-     *  @param ms       Time to delay in milliseconds
-     *  @return         A unique id that represents the posted event and can
-     *                  be passed to cancel, or an id of 0 if there is not
-     *                  enough memory to allocate the event.
-     */
-    template <typename F>
-    int call_in(int ms, F f) {
-        struct local {
-            static void call(void *p) { (*static_cast<F*>(p))(); }
-            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
-        };
-
-        void *p = equeue_alloc(&_equeue, sizeof(F));
-        if (!p) {
-            return 0;
-        }
-
-        F *e = new (p) F(f);
-        equeue_event_delay(e, ms);
-        equeue_event_dtor(e, &local::dtor);
-        return equeue_post(&_equeue, &local::call, e);
+        return static_cast<Q*>(this)->call(mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -458,7 +289,7 @@ public:
      */
     template <typename F, typename A0>
     int call_in(int ms, F f, A0 a0) {
-        return call_in(ms, context10<F, A0>(f, a0));
+        return static_cast<Q*>(this)->call_in(ms, context10<F, A0>(f, a0));
     }
 
     /** Calls an event on the queue after a specified delay
@@ -466,7 +297,7 @@ public:
      */
     template <typename F, typename A0, typename A1>
     int call_in(int ms, F f, A0 a0, A1 a1) {
-        return call_in(ms, context20<F, A0, A1>(f, a0, a1));
+        return static_cast<Q*>(this)->call_in(ms, context20<F, A0, A1>(f, a0, a1));
     }
 
     /** Calls an event on the queue after a specified delay
@@ -474,7 +305,7 @@ public:
      */
     template <typename F, typename A0, typename A1, typename A2>
     int call_in(int ms, F f, A0 a0, A1 a1, A2 a2) {
-        return call_in(ms, context30<F, A0, A1, A2>(f, a0, a1, a2));
+        return static_cast<Q*>(this)->call_in(ms, context30<F, A0, A1, A2>(f, a0, a1, a2));
     }
 
     /** Calls an event on the queue after a specified delay
@@ -482,7 +313,7 @@ public:
      */
     template <typename F, typename A0, typename A1, typename A2, typename A3>
     int call_in(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_in(ms, context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
+        return static_cast<Q*>(this)->call_in(ms, context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
     }
 
     /** Calls an event on the queue after a specified delay
@@ -490,7 +321,7 @@ public:
      */
     template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call_in(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_in(ms, context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
+        return static_cast<Q*>(this)->call_in(ms, context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
     }
 
     /** Calls an event on the queue after a specified delay
@@ -498,7 +329,7 @@ public:
      */
     template <typename T, typename R>
     int call_in(int ms, T *obj, R (T::*method)()) {
-        return call_in(ms, mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue after a specified delay
@@ -506,7 +337,7 @@ public:
      */
     template <typename T, typename R>
     int call_in(int ms, const T *obj, R (T::*method)() const) {
-        return call_in(ms, mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue after a specified delay
@@ -514,7 +345,7 @@ public:
      */
     template <typename T, typename R>
     int call_in(int ms, volatile T *obj, R (T::*method)() volatile) {
-        return call_in(ms, mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue after a specified delay
@@ -522,7 +353,7 @@ public:
      */
     template <typename T, typename R>
     int call_in(int ms, const volatile T *obj, R (T::*method)() const volatile) {
-        return call_in(ms, mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue after a specified delay
@@ -530,7 +361,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call_in(int ms, T *obj, R (T::*method)(A0), A0 a0) {
-        return call_in(ms, mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -538,7 +369,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call_in(int ms, const T *obj, R (T::*method)(A0) const, A0 a0) {
-        return call_in(ms, mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -546,7 +377,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call_in(int ms, volatile T *obj, R (T::*method)(A0) volatile, A0 a0) {
-        return call_in(ms, mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -554,7 +385,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call_in(int ms, const volatile T *obj, R (T::*method)(A0) const volatile, A0 a0) {
-        return call_in(ms, mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -562,7 +393,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call_in(int ms, T *obj, R (T::*method)(A0, A1), A0 a0, A1 a1) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -570,7 +401,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call_in(int ms, const T *obj, R (T::*method)(A0, A1) const, A0 a0, A1 a1) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -578,7 +409,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call_in(int ms, volatile T *obj, R (T::*method)(A0, A1) volatile, A0 a0, A1 a1) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -586,7 +417,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call_in(int ms, const volatile T *obj, R (T::*method)(A0, A1) const volatile, A0 a0, A1 a1) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -594,7 +425,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call_in(int ms, T *obj, R (T::*method)(A0, A1, A2), A0 a0, A1 a1, A2 a2) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -602,7 +433,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call_in(int ms, const T *obj, R (T::*method)(A0, A1, A2) const, A0 a0, A1 a1, A2 a2) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -610,7 +441,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call_in(int ms, volatile T *obj, R (T::*method)(A0, A1, A2) volatile, A0 a0, A1 a1, A2 a2) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -618,7 +449,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call_in(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2) const volatile, A0 a0, A1 a1, A2 a2) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -626,7 +457,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call_in(int ms, T *obj, R (T::*method)(A0, A1, A2, A3), A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -634,7 +465,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call_in(int ms, const T *obj, R (T::*method)(A0, A1, A2, A3) const, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -642,7 +473,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call_in(int ms, volatile T *obj, R (T::*method)(A0, A1, A2, A3) volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -650,7 +481,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call_in(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2, A3) const volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -658,7 +489,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call_in(int ms, T *obj, R (T::*method)(A0, A1, A2, A3, A4), A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -666,7 +497,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call_in(int ms, const T *obj, R (T::*method)(A0, A1, A2, A3, A4) const, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -674,7 +505,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call_in(int ms, volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Calls an event on the queue after a specified delay
@@ -682,41 +513,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call_in(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
-    }
-
-    /** Calls an event on the queue periodically
-     *
-     *  The specified callback will be executed in the context of the event
-     *  queue's dispatch loop.
-     *
-     *  The call_every function is irq safe and can act as a mechanism for
-     *  moving events out of irq contexts.
-     *
-     *  @param f        Function to execute in the context of the dispatch loop
-     *  @param a0..a4   Arguments to pass to the callback
-     *  @param ms       Period of the event in milliseconds
-     *  @return         A unique id that represents the posted event and can
-     *                  be passed to cancel, or an id of 0 if there is not
-     *                  enough memory to allocate the event.
-     */
-    template <typename F>
-    int call_every(int ms, F f) {
-        struct local {
-            static void call(void *p) { (*static_cast<F*>(p))(); }
-            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
-        };
-
-        void *p = equeue_alloc(&_equeue, sizeof(F));
-        if (!p) {
-            return 0;
-        }
-
-        F *e = new (p) F(f);
-        equeue_event_delay(e, ms);
-        equeue_event_period(e, ms);
-        equeue_event_dtor(e, &local::dtor);
-        return equeue_post(&_equeue, &local::call, e);
+        return static_cast<Q*>(this)->call_in(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Calls an event on the queue periodically
@@ -724,7 +521,7 @@ public:
      */
     template <typename F, typename A0>
     int call_every(int ms, F f, A0 a0) {
-        return call_every(ms, context10<F, A0>(f, a0));
+        return static_cast<Q*>(this)->call_every(ms, context10<F, A0>(f, a0));
     }
 
     /** Calls an event on the queue periodically
@@ -732,7 +529,7 @@ public:
      */
     template <typename F, typename A0, typename A1>
     int call_every(int ms, F f, A0 a0, A1 a1) {
-        return call_every(ms, context20<F, A0, A1>(f, a0, a1));
+        return static_cast<Q*>(this)->call_every(ms, context20<F, A0, A1>(f, a0, a1));
     }
 
     /** Calls an event on the queue periodically
@@ -740,7 +537,7 @@ public:
      */
     template <typename F, typename A0, typename A1, typename A2>
     int call_every(int ms, F f, A0 a0, A1 a1, A2 a2) {
-        return call_every(ms, context30<F, A0, A1, A2>(f, a0, a1, a2));
+        return static_cast<Q*>(this)->call_every(ms, context30<F, A0, A1, A2>(f, a0, a1, a2));
     }
 
     /** Calls an event on the queue periodically
@@ -748,7 +545,7 @@ public:
      */
     template <typename F, typename A0, typename A1, typename A2, typename A3>
     int call_every(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_every(ms, context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
+        return static_cast<Q*>(this)->call_every(ms, context40<F, A0, A1, A2, A3>(f, a0, a1, a2, a3));
     }
 
     /** Calls an event on the queue periodically
@@ -756,7 +553,7 @@ public:
      */
     template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call_every(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_every(ms, context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
+        return static_cast<Q*>(this)->call_every(ms, context50<F, A0, A1, A2, A3, A4>(f, a0, a1, a2, a3, a4));
     }
 
     /** Calls an event on the queue periodically
@@ -764,7 +561,7 @@ public:
      */
     template <typename T, typename R>
     int call_every(int ms, T *obj, R (T::*method)()) {
-        return call_every(ms, mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue periodically
@@ -772,7 +569,7 @@ public:
      */
     template <typename T, typename R>
     int call_every(int ms, const T *obj, R (T::*method)() const) {
-        return call_every(ms, mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue periodically
@@ -780,7 +577,7 @@ public:
      */
     template <typename T, typename R>
     int call_every(int ms, volatile T *obj, R (T::*method)() volatile) {
-        return call_every(ms, mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue periodically
@@ -788,7 +585,7 @@ public:
      */
     template <typename T, typename R>
     int call_every(int ms, const volatile T *obj, R (T::*method)() const volatile) {
-        return call_every(ms, mbed::callback(obj, method));
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method));
     }
 
     /** Calls an event on the queue periodically
@@ -796,7 +593,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call_every(int ms, T *obj, R (T::*method)(A0), A0 a0) {
-        return call_every(ms, mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue periodically
@@ -804,7 +601,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call_every(int ms, const T *obj, R (T::*method)(A0) const, A0 a0) {
-        return call_every(ms, mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue periodically
@@ -812,7 +609,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call_every(int ms, volatile T *obj, R (T::*method)(A0) volatile, A0 a0) {
-        return call_every(ms, mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue periodically
@@ -820,7 +617,7 @@ public:
      */
     template <typename T, typename R, typename A0>
     int call_every(int ms, const volatile T *obj, R (T::*method)(A0) const volatile, A0 a0) {
-        return call_every(ms, mbed::callback(obj, method), a0);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0);
     }
 
     /** Calls an event on the queue periodically
@@ -828,7 +625,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call_every(int ms, T *obj, R (T::*method)(A0, A1), A0 a0, A1 a1) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue periodically
@@ -836,7 +633,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call_every(int ms, const T *obj, R (T::*method)(A0, A1) const, A0 a0, A1 a1) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue periodically
@@ -844,7 +641,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1) volatile, A0 a0, A1 a1) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue periodically
@@ -852,7 +649,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1>
     int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1) const volatile, A0 a0, A1 a1) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1);
     }
 
     /** Calls an event on the queue periodically
@@ -860,7 +657,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call_every(int ms, T *obj, R (T::*method)(A0, A1, A2), A0 a0, A1 a1, A2 a2) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue periodically
@@ -868,7 +665,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call_every(int ms, const T *obj, R (T::*method)(A0, A1, A2) const, A0 a0, A1 a1, A2 a2) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue periodically
@@ -876,7 +673,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1, A2) volatile, A0 a0, A1 a1, A2 a2) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue periodically
@@ -884,7 +681,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2>
     int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2) const volatile, A0 a0, A1 a1, A2 a2) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2);
     }
 
     /** Calls an event on the queue periodically
@@ -892,7 +689,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call_every(int ms, T *obj, R (T::*method)(A0, A1, A2, A3), A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue periodically
@@ -900,7 +697,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call_every(int ms, const T *obj, R (T::*method)(A0, A1, A2, A3) const, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue periodically
@@ -908,7 +705,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1, A2, A3) volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue periodically
@@ -916,7 +713,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
     int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2, A3) const volatile, A0 a0, A1 a1, A2 a2, A3 a3) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3);
     }
 
     /** Calls an event on the queue periodically
@@ -924,7 +721,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call_every(int ms, T *obj, R (T::*method)(A0, A1, A2, A3, A4), A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Calls an event on the queue periodically
@@ -932,7 +729,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call_every(int ms, const T *obj, R (T::*method)(A0, A1, A2, A3, A4) const, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Calls an event on the queue periodically
@@ -940,7 +737,7 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call_every(int ms, volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
     /** Calls an event on the queue periodically
@@ -948,1533 +745,1786 @@ public:
      */
     template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
     int call_every(int ms, const volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-        return call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
+        return static_cast<Q*>(this)->call_every(ms, mbed::callback(obj, method), a0, a1, a2, a3, a4);
     }
 
-    /** Creates an event bound to the event queue
-     *
-     *  Constructs an event bound to the specified event queue. The specified
-     *  callback acts as the target for the event and is executed in the
-     *  context of the event queue's dispatch loop once posted.
-     *
-     *  @param f        Function to execute when the event is dispatched
-     *  @param a0..a4   Arguments to pass to the callback
-     *  @return         Event that will dispatch on the specific queue
-     */
-    template <typename R>
-    Event<void()> event(R (*func)());
+protected:
+    template <typename F>
+    struct context00 {
+        F f;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R>
-    Event<void()> event(T *obj, R (T::*method)());
+        context00(F f)
+            : f(f) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R>
-    Event<void()> event(const T *obj, R (T::*method)() const);
+        void operator()() {
+            f();
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R>
-    Event<void()> event(volatile T *obj, R (T::*method)() volatile);
+    template <typename F, typename C0>
+    struct context10 {
+        F f; C0 c0;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R>
-    Event<void()> event(const volatile T *obj, R (T::*method)() const volatile);
+        context10(F f, C0 c0)
+            : f(f), c0(c0) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename R, typename B0, typename C0>
-    Event<void()> event(R (*func)(B0), C0 c0);
+        void operator()() {
+            f(c0);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename C0>
-    Event<void()> event(T *obj, R (T::*method)(B0), C0 c0);
+    template <typename F, typename C0, typename C1>
+    struct context20 {
+        F f; C0 c0; C1 c1;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename C0>
-    Event<void()> event(const T *obj, R (T::*method)(B0) const, C0 c0);
+        context20(F f, C0 c0, C1 c1)
+            : f(f), c0(c0), c1(c1) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename C0>
-    Event<void()> event(volatile T *obj, R (T::*method)(B0) volatile, C0 c0);
+        void operator()() {
+            f(c0, c1);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename C0>
-    Event<void()> event(const volatile T *obj, R (T::*method)(B0) const volatile, C0 c0);
+    template <typename F, typename C0, typename C1, typename C2>
+    struct context30 {
+        F f; C0 c0; C1 c1; C2 c2;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename R, typename B0, typename B1, typename C0, typename C1>
-    Event<void()> event(R (*func)(B0, B1), C0 c0, C1 c1);
+        context30(F f, C0 c0, C1 c1, C2 c2)
+            : f(f), c0(c0), c1(c1), c2(c2) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1>
-    Event<void()> event(T *obj, R (T::*method)(B0, B1), C0 c0, C1 c1);
+        void operator()() {
+            f(c0, c1, c2);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1>
-    Event<void()> event(const T *obj, R (T::*method)(B0, B1) const, C0 c0, C1 c1);
+    template <typename F, typename C0, typename C1, typename C2, typename C3>
+    struct context40 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1>
-    Event<void()> event(volatile T *obj, R (T::*method)(B0, B1) volatile, C0 c0, C1 c1);
+        context40(F f, C0 c0, C1 c1, C2 c2, C3 c3)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1>
-    Event<void()> event(const volatile T *obj, R (T::*method)(B0, B1) const volatile, C0 c0, C1 c1);
+        void operator()() {
+            f(c0, c1, c2, c3);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2>
-    Event<void()> event(R (*func)(B0, B1, B2), C0 c0, C1 c1, C2 c2);
+    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4>
+    struct context50 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2>
-    Event<void()> event(T *obj, R (T::*method)(B0, B1, B2), C0 c0, C1 c1, C2 c2);
+        context50(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2>
-    Event<void()> event(const T *obj, R (T::*method)(B0, B1, B2) const, C0 c0, C1 c1, C2 c2);
+        void operator()() {
+            f(c0, c1, c2, c3, c4);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2>
-    Event<void()> event(volatile T *obj, R (T::*method)(B0, B1, B2) volatile, C0 c0, C1 c1, C2 c2);
+    template <typename F, typename A0>
+    struct context01 {
+        F f;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2>
-    Event<void()> event(const volatile T *obj, R (T::*method)(B0, B1, B2) const volatile, C0 c0, C1 c1, C2 c2);
+        context01(F f)
+            : f(f) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3>
-    Event<void()> event(R (*func)(B0, B1, B2, B3), C0 c0, C1 c1, C2 c2, C3 c3);
+        void operator()(A0 a0) {
+            f(a0);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3>
-    Event<void()> event(T *obj, R (T::*method)(B0, B1, B2, B3), C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename F, typename C0, typename A0>
+    struct context11 {
+        F f; C0 c0;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3>
-    Event<void()> event(const T *obj, R (T::*method)(B0, B1, B2, B3) const, C0 c0, C1 c1, C2 c2, C3 c3);
+        context11(F f, C0 c0)
+            : f(f), c0(c0) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3>
-    Event<void()> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+        void operator()(A0 a0) {
+            f(c0, a0);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3>
-    Event<void()> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename F, typename C0, typename C1, typename A0>
+    struct context21 {
+        F f; C0 c0; C1 c1;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4>
-    Event<void()> event(R (*func)(B0, B1, B2, B3, B4), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+        context21(F f, C0 c0, C1 c1)
+            : f(f), c0(c0), c1(c1) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4>
-    Event<void()> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+        void operator()(A0 a0) {
+            f(c0, c1, a0);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4>
-    Event<void()> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename F, typename C0, typename C1, typename C2, typename A0>
+    struct context31 {
+        F f; C0 c0; C1 c1; C2 c2;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4>
-    Event<void()> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+        context31(F f, C0 c0, C1 c1, C2 c2)
+            : f(f), c0(c0), c1(c1), c2(c2) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4>
-    Event<void()> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+        void operator()(A0 a0) {
+            f(c0, c1, c2, a0);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename R, typename A0>
-    Event<void(A0)> event(R (*func)(A0));
+    template <typename F, typename C0, typename C1, typename C2, typename C3, typename A0>
+    struct context41 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename A0>
-    Event<void(A0)> event(T *obj, R (T::*method)(A0));
+        context41(F f, C0 c0, C1 c1, C2 c2, C3 c3)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename A0>
-    Event<void(A0)> event(const T *obj, R (T::*method)(A0) const);
+        void operator()(A0 a0) {
+            f(c0, c1, c2, c3, a0);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename A0>
-    Event<void(A0)> event(volatile T *obj, R (T::*method)(A0) volatile);
+    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
+    struct context51 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
+
+        context51(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
+
+        void operator()(A0 a0) {
+            f(c0, c1, c2, c3, c4, a0);
+        }
+    };
+
+    template <typename F, typename A0, typename A1>
+    struct context02 {
+        F f;
+
+        context02(F f)
+            : f(f) {}
+
+        void operator()(A0 a0, A1 a1) {
+            f(a0, a1);
+        }
+    };
+
+    template <typename F, typename C0, typename A0, typename A1>
+    struct context12 {
+        F f; C0 c0;
+
+        context12(F f, C0 c0)
+            : f(f), c0(c0) {}
+
+        void operator()(A0 a0, A1 a1) {
+            f(c0, a0, a1);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename A0, typename A1>
+    struct context22 {
+        F f; C0 c0; C1 c1;
+
+        context22(F f, C0 c0, C1 c1)
+            : f(f), c0(c0), c1(c1) {}
+
+        void operator()(A0 a0, A1 a1) {
+            f(c0, c1, a0, a1);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename C2, typename A0, typename A1>
+    struct context32 {
+        F f; C0 c0; C1 c1; C2 c2;
+
+        context32(F f, C0 c0, C1 c1, C2 c2)
+            : f(f), c0(c0), c1(c1), c2(c2) {}
+
+        void operator()(A0 a0, A1 a1) {
+            f(c0, c1, c2, a0, a1);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
+    struct context42 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3;
+
+        context42(F f, C0 c0, C1 c1, C2 c2, C3 c3)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
+
+        void operator()(A0 a0, A1 a1) {
+            f(c0, c1, c2, c3, a0, a1);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
+    struct context52 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
+
+        context52(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
+
+        void operator()(A0 a0, A1 a1) {
+            f(c0, c1, c2, c3, c4, a0, a1);
+        }
+    };
+
+    template <typename F, typename A0, typename A1, typename A2>
+    struct context03 {
+        F f;
+
+        context03(F f)
+            : f(f) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2) {
+            f(a0, a1, a2);
+        }
+    };
+
+    template <typename F, typename C0, typename A0, typename A1, typename A2>
+    struct context13 {
+        F f; C0 c0;
+
+        context13(F f, C0 c0)
+            : f(f), c0(c0) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2) {
+            f(c0, a0, a1, a2);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename A0, typename A1, typename A2>
+    struct context23 {
+        F f; C0 c0; C1 c1;
+
+        context23(F f, C0 c0, C1 c1)
+            : f(f), c0(c0), c1(c1) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2) {
+            f(c0, c1, a0, a1, a2);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
+    struct context33 {
+        F f; C0 c0; C1 c1; C2 c2;
+
+        context33(F f, C0 c0, C1 c1, C2 c2)
+            : f(f), c0(c0), c1(c1), c2(c2) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2) {
+            f(c0, c1, c2, a0, a1, a2);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
+    struct context43 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3;
+
+        context43(F f, C0 c0, C1 c1, C2 c2, C3 c3)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2) {
+            f(c0, c1, c2, c3, a0, a1, a2);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
+    struct context53 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
+
+        context53(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2) {
+            f(c0, c1, c2, c3, c4, a0, a1, a2);
+        }
+    };
+
+    template <typename F, typename A0, typename A1, typename A2, typename A3>
+    struct context04 {
+        F f;
+
+        context04(F f)
+            : f(f) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
+            f(a0, a1, a2, a3);
+        }
+    };
+
+    template <typename F, typename C0, typename A0, typename A1, typename A2, typename A3>
+    struct context14 {
+        F f; C0 c0;
+
+        context14(F f, C0 c0)
+            : f(f), c0(c0) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
+            f(c0, a0, a1, a2, a3);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
+    struct context24 {
+        F f; C0 c0; C1 c1;
+
+        context24(F f, C0 c0, C1 c1)
+            : f(f), c0(c0), c1(c1) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
+            f(c0, c1, a0, a1, a2, a3);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
+    struct context34 {
+        F f; C0 c0; C1 c1; C2 c2;
+
+        context34(F f, C0 c0, C1 c1, C2 c2)
+            : f(f), c0(c0), c1(c1), c2(c2) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
+            f(c0, c1, c2, a0, a1, a2, a3);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
+    struct context44 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3;
+
+        context44(F f, C0 c0, C1 c1, C2 c2, C3 c3)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
+            f(c0, c1, c2, c3, a0, a1, a2, a3);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
+    struct context54 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
+
+        context54(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
+            f(c0, c1, c2, c3, c4, a0, a1, a2, a3);
+        }
+    };
+
+    template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
+    struct context05 {
+        F f;
+
+        context05(F f)
+            : f(f) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+            f(a0, a1, a2, a3, a4);
+        }
+    };
+
+    template <typename F, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
+    struct context15 {
+        F f; C0 c0;
+
+        context15(F f, C0 c0)
+            : f(f), c0(c0) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+            f(c0, a0, a1, a2, a3, a4);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
+    struct context25 {
+        F f; C0 c0; C1 c1;
+
+        context25(F f, C0 c0, C1 c1)
+            : f(f), c0(c0), c1(c1) {}
+
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+            f(c0, c1, a0, a1, a2, a3, a4);
+        }
+    };
+
+    template <typename F, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
+    struct context35 {
+        F f; C0 c0; C1 c1; C2 c2;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename A0>
-    Event<void(A0)> event(const volatile T *obj, R (T::*method)(A0) const volatile);
+        context35(F f, C0 c0, C1 c1, C2 c2)
+            : f(f), c0(c0), c1(c1), c2(c2) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename R, typename B0, typename C0, typename A0>
-    Event<void(A0)> event(R (*func)(B0, A0), C0 c0);
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+            f(c0, c1, c2, a0, a1, a2, a3, a4);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename C0, typename A0>
-    Event<void(A0)> event(T *obj, R (T::*method)(B0, A0), C0 c0);
+    template <typename F, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
+    struct context45 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename C0, typename A0>
-    Event<void(A0)> event(const T *obj, R (T::*method)(B0, A0) const, C0 c0);
+        context45(F f, C0 c0, C1 c1, C2 c2, C3 c3)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename C0, typename A0>
-    Event<void(A0)> event(volatile T *obj, R (T::*method)(B0, A0) volatile, C0 c0);
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+            f(c0, c1, c2, c3, a0, a1, a2, a3, a4);
+        }
+    };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename C0, typename A0>
-    Event<void(A0)> event(const volatile T *obj, R (T::*method)(B0, A0) const volatile, C0 c0);
+    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
+    struct context55 {
+        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename R, typename B0, typename B1, typename C0, typename C1, typename A0>
-    Event<void(A0)> event(R (*func)(B0, B1, A0), C0 c0, C1 c1);
+        context55(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
+            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0>
-    Event<void(A0)> event(T *obj, R (T::*method)(B0, B1, A0), C0 c0, C1 c1);
+        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
+            f(c0, c1, c2, c3, c4, a0, a1, a2, a3, a4);
+        }
+    };
+};
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+/** EventQueue
+ *
+ *  Flexible event queue for dispatching events
+ */
+class EventQueue : public EventQueueCalls<EventQueue> {
+public:
+    /** Create an EventQueue
+     *
+     *  Create an event queue. The event queue either allocates a buffer of
+     *  the specified size with malloc or uses the user provided buffer.
+     *
+     *  @param size     Size of buffer to use for events in bytes
+     *                  (default to EVENTS_QUEUE_SIZE)
+     *  @param buffer   Pointer to buffer to use for events
+     *                  (default to NULL)
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0>
-    Event<void(A0)> event(const T *obj, R (T::*method)(B0, B1, A0) const, C0 c0, C1 c1);
+    EventQueue(unsigned size=EVENTS_QUEUE_SIZE, unsigned char *buffer=NULL);
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+    /** Destroy an EventQueue
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0>
-    Event<void(A0)> event(volatile T *obj, R (T::*method)(B0, B1, A0) volatile, C0 c0, C1 c1);
+    ~EventQueue();
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+    /** Dispatch events
+     *
+     *  Executes events until the specified milliseconds have passed.
+     *  If ms is negative, the dispatch function will dispatch events
+     *  indefinitely or until break_dispatch is called on this queue.
+     *
+     *  When called with a finite timeout, the dispatch function is guaranteed
+     *  to terminate. When called with a timeout of 0, the dispatch function
+     *  does not wait and is irq safe.
+     *
+     *  @param ms       Time to wait for events in milliseconds, a negative
+     *                  value will dispatch events indefinitely
+     *                  (default to -1)
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0>
-    Event<void(A0)> event(const volatile T *obj, R (T::*method)(B0, B1, A0) const volatile, C0 c0, C1 c1);
+    void dispatch(int ms=-1);
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+    /** Dispatch events without a timeout
+     *
+     *  This is equivalent to EventQueue::dispatch with no arguments, but 
+     *  avoids overload ambiguities when passed as a callback.
+     *
+     *  @see EventQueue::dispatch
      */
-    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0>
-    Event<void(A0)> event(R (*func)(B0, B1, B2, A0), C0 c0, C1 c1, C2 c2);
+    void dispatch_forever() { dispatch(); }
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+    /** Break out of a running event loop
+     *
+     *  Forces the specified event queue's dispatch loop to terminate. Pending
+     *  events may finish executing, but no new events will be executed.
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0>
-    Event<void(A0)> event(T *obj, R (T::*method)(B0, B1, B2, A0), C0 c0, C1 c1, C2 c2);
+    void break_dispatch();
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+    /** Millisecond counter
+     *
+     *  Returns the underlying tick of the event queue represented as the 
+     *  number of milliseconds that have passed since an arbitrary point in
+     *  time. Intentionally overflows to 0 after 2^32-1.
+     *
+     *  @return         The underlying tick of the event queue in milliseconds
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0>
-    Event<void(A0)> event(const T *obj, R (T::*method)(B0, B1, B2, A0) const, C0 c0, C1 c1, C2 c2);
+    unsigned tick();
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+    /** Cancel an in-flight event
+     *
+     *  Attempts to cancel an event referenced by the unique id returned from
+     *  one of the call functions. It is safe to call cancel after an event
+     *  has already been dispatched.
+     *
+     *  The cancel function is irq safe.
+     *
+     *  If called while the event queue's dispatch loop is active, the cancel
+     *  function does not garuntee that the event will not execute after it
+     *  returns, as the event may have already begun executing.
+     *
+     *  @param id       Unique id of the event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0>
-    Event<void(A0)> event(volatile T *obj, R (T::*method)(B0, B1, B2, A0) volatile, C0 c0, C1 c1, C2 c2);
+    void cancel(int id);
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+    /** Background an event queue onto a single-shot timer-interrupt
+     *
+     *  When updated, the event queue will call the provided update function
+     *  with a timeout indicating when the queue should be dispatched. A
+     *  negative timeout will be passed to the update function when the
+     *  timer-interrupt is no longer needed.
+     *
+     *  Passing a null function disables the existing update function.
+     *
+     *  The background function allows an event queue to take advantage of
+     *  hardware timers or other event loops, allowing an event queue to be
+     *  ran in the background without consuming the foreground thread.
+     *
+     *  @param update   Function called to indicate when the queue should be
+     *                  dispatched
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0>
-    Event<void(A0)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, A0) const volatile, C0 c0, C1 c1, C2 c2);
+    void background(mbed::Callback<void(int)> update);
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+    /** Chain an event queue onto another event queue
+     *
+     *  After chaining a queue to a target, calling dispatch on the target
+     *  queue will also dispatch events from this queue. The queues use
+     *  their own buffers and events must be handled independently.
+     *
+     *  A null queue as the target will unchain the existing queue.
+     *
+     *  The chain function allows multiple event queues to be composed,
+     *  sharing the context of a dispatch loop while still being managed
+     *  independently
+     *
+     *  @param target   Queue that will dispatch this queue's events as a
+     *                  part of its dispatch loop
      */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0>
-    Event<void(A0)> event(R (*func)(B0, B1, B2, B3, A0), C0 c0, C1 c1, C2 c2, C3 c3);
+    void chain(EventQueue *target);
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+    /** Calls an event on the queue
+     *
+     *  The specified callback will be executed in the context of the event
+     *  queue's dispatch loop.
+     *
+     *  The call function is irq safe and can act as a mechanism for moving
+     *  events out of irq contexts.
+     *
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @param a0..a4   Arguments to pass to the callback
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0>
-    Event<void(A0)> event(T *obj, R (T::*method)(B0, B1, B2, B3, A0), C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename F>
+    int call(F f) {
+        struct local {
+            static void call(void *p) { (*static_cast<F*>(p))(); }
+            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
+        };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0>
-    Event<void(A0)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, A0) const, C0 c0, C1 c1, C2 c2, C3 c3);
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+        F *e = new (p) F(f);
+        equeue_event_dtor(e, &local::dtor);
+        return equeue_post(&_equeue, &local::call, e);
+    }
+
+    /** Calls an event on the queue ahead of lower priority events
+     *
+     *  The specified callback will be executed in the context of the event
+     *  queue's dispatch loop, before any events of lower priority that are
+     *  ready at the same time. Events posted with call have priority 0.
+     *
+     *  The call_priority function is irq safe.
+     *
+     *  @param priority Priority of the event, from 0 to EQUEUE_PRIORITIES-1
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0>
-    Event<void(A0)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename F>
+    int call_priority(int priority, F f) {
+        struct local {
+            static void call(void *p) { (*static_cast<F*>(p))(); }
+            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
+        };
+
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0>
-    Event<void(A0)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+        F *e = new (p) F(f);
+        equeue_event_priority(e, priority);
+        equeue_event_dtor(e, &local::dtor);
+        return equeue_post(&_equeue, &local::call, e);
+    }
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
-    Event<void(A0)> event(R (*func)(B0, B1, B2, B3, B4, A0), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    using EventQueueCalls<EventQueue>::call;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+    /** Calls an event on the queue after a specified delay
+     *
+     *  The specified callback will be executed in the context of the event
+     *  queue's dispatch loop.
+     *
+     *  The call_in function is irq safe and can act as a mechanism for moving
+     *  events out of irq contexts.
+     *
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @param a0..a4   Arguments to pass to the callback
+     *  @param ms       Time to delay in milliseconds
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
-    Event<void(A0)> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename F>
+    int call_in(int ms, F f) {
+        struct local {
+            static void call(void *p) { (*static_cast<F*>(p))(); }
+            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
+        };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
-    Event<void(A0)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
-    Event<void(A0)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+        F *e = new (p) F(f);
+        equeue_event_delay(e, ms);
+        equeue_event_dtor(e, &local::dtor);
+        return equeue_post(&_equeue, &local::call, e);
+    }
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
-    Event<void(A0)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    using EventQueueCalls<EventQueue>::call_in;
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+    /** Calls an event on the queue periodically
+     *
+     *  The specified callback will be executed in the context of the event
+     *  queue's dispatch loop.
+     *
+     *  The call_every function is irq safe and can act as a mechanism for
+     *  moving events out of irq contexts.
+     *
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @param a0..a4   Arguments to pass to the callback
+     *  @param ms       Period of the event in milliseconds
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
      */
-    template <typename R, typename A0, typename A1>
-    Event<void(A0, A1)> event(R (*func)(A0, A1));
+    template <typename F>
+    int call_every(int ms, F f) {
+        struct local {
+            static void call(void *p) { (*static_cast<F*>(p))(); }
+            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
+        };
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename A0, typename A1>
-    Event<void(A0, A1)> event(T *obj, R (T::*method)(A0, A1));
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
 
-    /** Creates an event bound to the event queue
-     *  @see EventQueue::event
-     */
-    template <typename T, typename R, typename A0, typename A1>
-    Event<void(A0, A1)> event(const T *obj, R (T::*method)(A0, A1) const);
+        F *e = new (p) F(f);
+        equeue_event_delay(e, ms);
+        equeue_event_period(e, ms);
+        equeue_event_dtor(e, &local::dtor);
+        return equeue_post(&_equeue, &local::call, e);
+    }
+
+    using EventQueueCalls<EventQueue>::call_every;
 
     /** Creates an event bound to the event queue
-     *  @see EventQueue::event
+     *
+     *  Constructs an event bound to the specified event queue. The specified
+     *  callback acts as the target for the event and is executed in the
+     *  context of the event queue's dispatch loop once posted.
+     *
+     *  @param f        Function to execute when the event is dispatched
+     *  @param a0..a4   Arguments to pass to the callback
+     *  @return         Event that will dispatch on the specific queue
      */
-    template <typename T, typename R, typename A0, typename A1>
-    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(A0, A1) volatile);
+    template <typename R>
+    Event<void()> event(R (*func)());
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1>
-    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(A0, A1) const volatile);
+    template <typename T, typename R>
+    Event<void()> event(T *obj, R (T::*method)());
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename C0, typename A0, typename A1>
-    Event<void(A0, A1)> event(R (*func)(B0, A0, A1), C0 c0);
+    template <typename T, typename R>
+    Event<void()> event(const T *obj, R (T::*method)() const);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1>
-    Event<void(A0, A1)> event(T *obj, R (T::*method)(B0, A0, A1), C0 c0);
+    template <typename T, typename R>
+    Event<void()> event(volatile T *obj, R (T::*method)() volatile);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1>
-    Event<void(A0, A1)> event(const T *obj, R (T::*method)(B0, A0, A1) const, C0 c0);
+    template <typename T, typename R>
+    Event<void()> event(const volatile T *obj, R (T::*method)() const volatile);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1>
-    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(B0, A0, A1) volatile, C0 c0);
+    template <typename R, typename B0, typename C0>
+    Event<void()> event(R (*func)(B0), C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1>
-    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(B0, A0, A1) const volatile, C0 c0);
+    template <typename T, typename R, typename B0, typename C0>
+    Event<void()> event(T *obj, R (T::*method)(B0), C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1>
-    Event<void(A0, A1)> event(R (*func)(B0, B1, A0, A1), C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0>
+    Event<void()> event(const T *obj, R (T::*method)(B0) const, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1>
-    Event<void(A0, A1)> event(T *obj, R (T::*method)(B0, B1, A0, A1), C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0>
+    Event<void()> event(volatile T *obj, R (T::*method)(B0) volatile, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1>
-    Event<void(A0, A1)> event(const T *obj, R (T::*method)(B0, B1, A0, A1) const, C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0>
+    Event<void()> event(const volatile T *obj, R (T::*method)(B0) const volatile, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1>
-    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(B0, B1, A0, A1) volatile, C0 c0, C1 c1);
+    template <typename R, typename B0, typename B1, typename C0, typename C1>
+    Event<void()> event(R (*func)(B0, B1), C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1>
-    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(B0, B1, A0, A1) const volatile, C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1>
+    Event<void()> event(T *obj, R (T::*method)(B0, B1), C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1>
-    Event<void(A0, A1)> event(R (*func)(B0, B1, B2, A0, A1), C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1>
+    Event<void()> event(const T *obj, R (T::*method)(B0, B1) const, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1>
-    Event<void(A0, A1)> event(T *obj, R (T::*method)(B0, B1, B2, A0, A1), C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1>
+    Event<void()> event(volatile T *obj, R (T::*method)(B0, B1) volatile, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1>
-    Event<void(A0, A1)> event(const T *obj, R (T::*method)(B0, B1, B2, A0, A1) const, C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1>
+    Event<void()> event(const volatile T *obj, R (T::*method)(B0, B1) const volatile, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1>
-    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1) volatile, C0 c0, C1 c1, C2 c2);
+    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2>
+    Event<void()> event(R (*func)(B0, B1, B2), C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1>
-    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1) const volatile, C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2>
+    Event<void()> event(T *obj, R (T::*method)(B0, B1, B2), C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
-    Event<void(A0, A1)> event(R (*func)(B0, B1, B2, B3, A0, A1), C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2>
+    Event<void()> event(const T *obj, R (T::*method)(B0, B1, B2) const, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
-    Event<void(A0, A1)> event(T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1), C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2>
+    Event<void()> event(volatile T *obj, R (T::*method)(B0, B1, B2) volatile, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
-    Event<void(A0, A1)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1) const, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2>
+    Event<void()> event(const volatile T *obj, R (T::*method)(B0, B1, B2) const volatile, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
-    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3>
+    Event<void()> event(R (*func)(B0, B1, B2, B3), C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
-    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3>
+    Event<void()> event(T *obj, R (T::*method)(B0, B1, B2, B3), C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
-    Event<void(A0, A1)> event(R (*func)(B0, B1, B2, B3, B4, A0, A1), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3>
+    Event<void()> event(const T *obj, R (T::*method)(B0, B1, B2, B3) const, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
-    Event<void(A0, A1)> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3>
+    Event<void()> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
-    Event<void(A0, A1)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3>
+    Event<void()> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
-    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4>
+    Event<void()> event(R (*func)(B0, B1, B2, B3, B4), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
-    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4>
+    Event<void()> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(R (*func)(A0, A1, A2));
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4>
+    Event<void()> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(A0, A1, A2));
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4>
+    Event<void()> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(A0, A1, A2) const);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4>
+    Event<void()> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(A0, A1, A2) volatile);
+    template <typename R, typename A0>
+    Event<void(A0)> event(R (*func)(A0));
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(A0, A1, A2) const volatile);
+    template <typename T, typename R, typename A0>
+    Event<void(A0)> event(T *obj, R (T::*method)(A0));
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename C0, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(R (*func)(B0, A0, A1, A2), C0 c0);
+    template <typename T, typename R, typename A0>
+    Event<void(A0)> event(const T *obj, R (T::*method)(A0) const);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(B0, A0, A1, A2), C0 c0);
+    template <typename T, typename R, typename A0>
+    Event<void(A0)> event(volatile T *obj, R (T::*method)(A0) volatile);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(B0, A0, A1, A2) const, C0 c0);
+    template <typename T, typename R, typename A0>
+    Event<void(A0)> event(const volatile T *obj, R (T::*method)(A0) const volatile);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(B0, A0, A1, A2) volatile, C0 c0);
+    template <typename R, typename B0, typename C0, typename A0>
+    Event<void(A0)> event(R (*func)(B0, A0), C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(B0, A0, A1, A2) const volatile, C0 c0);
+    template <typename T, typename R, typename B0, typename C0, typename A0>
+    Event<void(A0)> event(T *obj, R (T::*method)(B0, A0), C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(R (*func)(B0, B1, A0, A1, A2), C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0, typename A0>
+    Event<void(A0)> event(const T *obj, R (T::*method)(B0, A0) const, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(B0, B1, A0, A1, A2), C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0, typename A0>
+    Event<void(A0)> event(volatile T *obj, R (T::*method)(B0, A0) volatile, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(B0, B1, A0, A1, A2) const, C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0, typename A0>
+    Event<void(A0)> event(const volatile T *obj, R (T::*method)(B0, A0) const volatile, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2) volatile, C0 c0, C1 c1);
+    template <typename R, typename B0, typename B1, typename C0, typename C1, typename A0>
+    Event<void(A0)> event(R (*func)(B0, B1, A0), C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2) const volatile, C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0>
+    Event<void(A0)> event(T *obj, R (T::*method)(B0, B1, A0), C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(R (*func)(B0, B1, B2, A0, A1, A2), C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0>
+    Event<void(A0)> event(const T *obj, R (T::*method)(B0, B1, A0) const, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2), C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0>
+    Event<void(A0)> event(volatile T *obj, R (T::*method)(B0, B1, A0) volatile, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2) const, C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0>
+    Event<void(A0)> event(const volatile T *obj, R (T::*method)(B0, B1, A0) const volatile, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2) volatile, C0 c0, C1 c1, C2 c2);
+    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0>
+    Event<void(A0)> event(R (*func)(B0, B1, B2, A0), C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2) const volatile, C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0>
+    Event<void(A0)> event(T *obj, R (T::*method)(B0, B1, B2, A0), C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(R (*func)(B0, B1, B2, B3, A0, A1, A2), C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0>
+    Event<void(A0)> event(const T *obj, R (T::*method)(B0, B1, B2, A0) const, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2), C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0>
+    Event<void(A0)> event(volatile T *obj, R (T::*method)(B0, B1, B2, A0) volatile, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2) const, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0>
+    Event<void(A0)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, A0) const volatile, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0>
+    Event<void(A0)> event(R (*func)(B0, B1, B2, B3, A0), C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0>
+    Event<void(A0)> event(T *obj, R (T::*method)(B0, B1, B2, B3, A0), C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(R (*func)(B0, B1, B2, B3, B4, A0, A1, A2), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0>
+    Event<void(A0)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, A0) const, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0>
+    Event<void(A0)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0>
+    Event<void(A0)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
+    Event<void(A0)> event(R (*func)(B0, B1, B2, B3, B4, A0), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
-    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
+    Event<void(A0)> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(R (*func)(A0, A1, A2, A3));
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
+    Event<void(A0)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(A0, A1, A2, A3));
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
+    Event<void(A0)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(A0, A1, A2, A3) const);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
+    Event<void(A0)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(A0, A1, A2, A3) volatile);
+    template <typename R, typename A0, typename A1>
+    Event<void(A0, A1)> event(R (*func)(A0, A1));
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(A0, A1, A2, A3) const volatile);
+    template <typename T, typename R, typename A0, typename A1>
+    Event<void(A0, A1)> event(T *obj, R (T::*method)(A0, A1));
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(R (*func)(B0, A0, A1, A2, A3), C0 c0);
+    template <typename T, typename R, typename A0, typename A1>
+    Event<void(A0, A1)> event(const T *obj, R (T::*method)(A0, A1) const);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(B0, A0, A1, A2, A3), C0 c0);
+    template <typename T, typename R, typename A0, typename A1>
+    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(A0, A1) volatile);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(B0, A0, A1, A2, A3) const, C0 c0);
+    template <typename T, typename R, typename A0, typename A1>
+    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(A0, A1) const volatile);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(B0, A0, A1, A2, A3) volatile, C0 c0);
+    template <typename R, typename B0, typename C0, typename A0, typename A1>
+    Event<void(A0, A1)> event(R (*func)(B0, A0, A1), C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(B0, A0, A1, A2, A3) const volatile, C0 c0);
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1>
+    Event<void(A0, A1)> event(T *obj, R (T::*method)(B0, A0, A1), C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(R (*func)(B0, B1, A0, A1, A2, A3), C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1>
+    Event<void(A0, A1)> event(const T *obj, R (T::*method)(B0, A0, A1) const, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3), C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1>
+    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(B0, A0, A1) volatile, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3) const, C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1>
+    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(B0, A0, A1) const volatile, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3) volatile, C0 c0, C1 c1);
+    template <typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1>
+    Event<void(A0, A1)> event(R (*func)(B0, B1, A0, A1), C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3) const volatile, C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1>
+    Event<void(A0, A1)> event(T *obj, R (T::*method)(B0, B1, A0, A1), C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(R (*func)(B0, B1, B2, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1>
+    Event<void(A0, A1)> event(const T *obj, R (T::*method)(B0, B1, A0, A1) const, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1>
+    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(B0, B1, A0, A1) volatile, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3) const, C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1>
+    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(B0, B1, A0, A1) const volatile, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3) volatile, C0 c0, C1 c1, C2 c2);
+    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1>
+    Event<void(A0, A1)> event(R (*func)(B0, B1, B2, A0, A1), C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3) const volatile, C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1>
+    Event<void(A0, A1)> event(T *obj, R (T::*method)(B0, B1, B2, A0, A1), C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(R (*func)(B0, B1, B2, B3, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1>
+    Event<void(A0, A1)> event(const T *obj, R (T::*method)(B0, B1, B2, A0, A1) const, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1>
+    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1) volatile, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3) const, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1>
+    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1) const volatile, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
+    Event<void(A0, A1)> event(R (*func)(B0, B1, B2, B3, A0, A1), C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
+    Event<void(A0, A1)> event(T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1), C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(R (*func)(B0, B1, B2, B3, B4, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
+    Event<void(A0, A1)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1) const, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
+    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
+    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
+    Event<void(A0, A1)> event(R (*func)(B0, B1, B2, B3, B4, A0, A1), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
-    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
+    Event<void(A0, A1)> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(A0, A1, A2, A3, A4));
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
+    Event<void(A0, A1)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(A0, A1, A2, A3, A4));
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
+    Event<void(A0, A1)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(A0, A1, A2, A3, A4) const);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
+    Event<void(A0, A1)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile);
+    template <typename R, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(R (*func)(A0, A1, A2));
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile);
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(A0, A1, A2));
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(B0, A0, A1, A2, A3, A4), C0 c0);
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(A0, A1, A2) const);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(B0, A0, A1, A2, A3, A4), C0 c0);
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(A0, A1, A2) volatile);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(B0, A0, A1, A2, A3, A4) const, C0 c0);
+    template <typename T, typename R, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(A0, A1, A2) const volatile);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(B0, A0, A1, A2, A3, A4) volatile, C0 c0);
+    template <typename R, typename B0, typename C0, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(R (*func)(B0, A0, A1, A2), C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(B0, A0, A1, A2, A3, A4) const volatile, C0 c0);
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(B0, A0, A1, A2), C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(B0, B1, A0, A1, A2, A3, A4), C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(B0, A0, A1, A2) const, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3, A4), C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(B0, A0, A1, A2) volatile, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3, A4) const, C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(B0, A0, A1, A2) const volatile, C0 c0);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3, A4) volatile, C0 c0, C1 c1);
+    template <typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(R (*func)(B0, B1, A0, A1, A2), C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3, A4) const volatile, C0 c0, C1 c1);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(B0, B1, A0, A1, A2), C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(B0, B1, B2, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(B0, B1, A0, A1, A2) const, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2) volatile, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3, A4) const, C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2) const volatile, C0 c0, C1 c1);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3, A4) volatile, C0 c0, C1 c1, C2 c2);
+    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(R (*func)(B0, B1, B2, A0, A1, A2), C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3, A4) const volatile, C0 c0, C1 c1, C2 c2);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2), C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(B0, B1, B2, B3, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2) const, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2) volatile, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3, A4) const, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2) const volatile, C0 c0, C1 c1, C2 c2);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3, A4) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(R (*func)(B0, B1, B2, B3, A0, A1, A2), C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3, A4) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2), C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(B0, B1, B2, B3, B4, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2) const, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3, A4) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3, A4) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(R (*func)(B0, B1, B2, B3, B4, A0, A1, A2), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
     /** Creates an event bound to the event queue
      *  @see EventQueue::event
      */
-    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
-    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3, A4) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
-
-protected:
-    template <typename F>
-    friend class Event;
-    struct equeue _equeue;
-    mbed::Callback<void(int)> _update;
-
-    template <typename F>
-    struct context00 {
-        F f;
-
-        context00(F f)
-            : f(f) {}
-
-        void operator()() {
-            f();
-        }
-    };
-
-    template <typename F, typename C0>
-    struct context10 {
-        F f; C0 c0;
-
-        context10(F f, C0 c0)
-            : f(f), c0(c0) {}
-
-        void operator()() {
-            f(c0);
-        }
-    };
-
-    template <typename F, typename C0, typename C1>
-    struct context20 {
-        F f; C0 c0; C1 c1;
-
-        context20(F f, C0 c0, C1 c1)
-            : f(f), c0(c0), c1(c1) {}
-
-        void operator()() {
-            f(c0, c1);
-        }
-    };
-
-    template <typename F, typename C0, typename C1, typename C2>
-    struct context30 {
-        F f; C0 c0; C1 c1; C2 c2;
-
-        context30(F f, C0 c0, C1 c1, C2 c2)
-            : f(f), c0(c0), c1(c1), c2(c2) {}
-
-        void operator()() {
-            f(c0, c1, c2);
-        }
-    };
-
-    template <typename F, typename C0, typename C1, typename C2, typename C3>
-    struct context40 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3;
-
-        context40(F f, C0 c0, C1 c1, C2 c2, C3 c3)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
-
-        void operator()() {
-            f(c0, c1, c2, c3);
-        }
-    };
-
-    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4>
-    struct context50 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
-
-        context50(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
-
-        void operator()() {
-            f(c0, c1, c2, c3, c4);
-        }
-    };
-
-    template <typename F, typename A0>
-    struct context01 {
-        F f;
-
-        context01(F f)
-            : f(f) {}
-
-        void operator()(A0 a0) {
-            f(a0);
-        }
-    };
-
-    template <typename F, typename C0, typename A0>
-    struct context11 {
-        F f; C0 c0;
-
-        context11(F f, C0 c0)
-            : f(f), c0(c0) {}
-
-        void operator()(A0 a0) {
-            f(c0, a0);
-        }
-    };
-
-    template <typename F, typename C0, typename C1, typename A0>
-    struct context21 {
-        F f; C0 c0; C1 c1;
-
-        context21(F f, C0 c0, C1 c1)
-            : f(f), c0(c0), c1(c1) {}
-
-        void operator()(A0 a0) {
-            f(c0, c1, a0);
-        }
-    };
-
-    template <typename F, typename C0, typename C1, typename C2, typename A0>
-    struct context31 {
-        F f; C0 c0; C1 c1; C2 c2;
-
-        context31(F f, C0 c0, C1 c1, C2 c2)
-            : f(f), c0(c0), c1(c1), c2(c2) {}
-
-        void operator()(A0 a0) {
-            f(c0, c1, c2, a0);
-        }
-    };
-
-    template <typename F, typename C0, typename C1, typename C2, typename C3, typename A0>
-    struct context41 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3;
-
-        context41(F f, C0 c0, C1 c1, C2 c2, C3 c3)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
-
-        void operator()(A0 a0) {
-            f(c0, c1, c2, c3, a0);
-        }
-    };
-
-    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0>
-    struct context51 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
-
-        context51(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
-
-        void operator()(A0 a0) {
-            f(c0, c1, c2, c3, c4, a0);
-        }
-    };
-
-    template <typename F, typename A0, typename A1>
-    struct context02 {
-        F f;
-
-        context02(F f)
-            : f(f) {}
-
-        void operator()(A0 a0, A1 a1) {
-            f(a0, a1);
-        }
-    };
-
-    template <typename F, typename C0, typename A0, typename A1>
-    struct context12 {
-        F f; C0 c0;
-
-        context12(F f, C0 c0)
-            : f(f), c0(c0) {}
-
-        void operator()(A0 a0, A1 a1) {
-            f(c0, a0, a1);
-        }
-    };
-
-    template <typename F, typename C0, typename C1, typename A0, typename A1>
-    struct context22 {
-        F f; C0 c0; C1 c1;
-
-        context22(F f, C0 c0, C1 c1)
-            : f(f), c0(c0), c1(c1) {}
-
-        void operator()(A0 a0, A1 a1) {
-            f(c0, c1, a0, a1);
-        }
-    };
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-    template <typename F, typename C0, typename C1, typename C2, typename A0, typename A1>
-    struct context32 {
-        F f; C0 c0; C1 c1; C2 c2;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-        context32(F f, C0 c0, C1 c1, C2 c2)
-            : f(f), c0(c0), c1(c1), c2(c2) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-        void operator()(A0 a0, A1 a1) {
-            f(c0, c1, c2, a0, a1);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
+    Event<void(A0, A1, A2)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-    template <typename F, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1>
-    struct context42 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(R (*func)(A0, A1, A2, A3));
 
-        context42(F f, C0 c0, C1 c1, C2 c2, C3 c3)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(A0, A1, A2, A3));
 
-        void operator()(A0 a0, A1 a1) {
-            f(c0, c1, c2, c3, a0, a1);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(A0, A1, A2, A3) const);
 
-    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1>
-    struct context52 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(A0, A1, A2, A3) volatile);
 
-        context52(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(A0, A1, A2, A3) const volatile);
 
-        void operator()(A0 a0, A1 a1) {
-            f(c0, c1, c2, c3, c4, a0, a1);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(R (*func)(B0, A0, A1, A2, A3), C0 c0);
 
-    template <typename F, typename A0, typename A1, typename A2>
-    struct context03 {
-        F f;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(B0, A0, A1, A2, A3), C0 c0);
 
-        context03(F f)
-            : f(f) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(B0, A0, A1, A2, A3) const, C0 c0);
 
-        void operator()(A0 a0, A1 a1, A2 a2) {
-            f(a0, a1, a2);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(B0, A0, A1, A2, A3) volatile, C0 c0);
 
-    template <typename F, typename C0, typename A0, typename A1, typename A2>
-    struct context13 {
-        F f; C0 c0;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(B0, A0, A1, A2, A3) const volatile, C0 c0);
 
-        context13(F f, C0 c0)
-            : f(f), c0(c0) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(R (*func)(B0, B1, A0, A1, A2, A3), C0 c0, C1 c1);
 
-        void operator()(A0 a0, A1 a1, A2 a2) {
-            f(c0, a0, a1, a2);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3), C0 c0, C1 c1);
 
-    template <typename F, typename C0, typename C1, typename A0, typename A1, typename A2>
-    struct context23 {
-        F f; C0 c0; C1 c1;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3) const, C0 c0, C1 c1);
 
-        context23(F f, C0 c0, C1 c1)
-            : f(f), c0(c0), c1(c1) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3) volatile, C0 c0, C1 c1);
 
-        void operator()(A0 a0, A1 a1, A2 a2) {
-            f(c0, c1, a0, a1, a2);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3) const volatile, C0 c0, C1 c1);
 
-    template <typename F, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2>
-    struct context33 {
-        F f; C0 c0; C1 c1; C2 c2;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(R (*func)(B0, B1, B2, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2);
 
-        context33(F f, C0 c0, C1 c1, C2 c2)
-            : f(f), c0(c0), c1(c1), c2(c2) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2);
 
-        void operator()(A0 a0, A1 a1, A2 a2) {
-            f(c0, c1, c2, a0, a1, a2);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3) const, C0 c0, C1 c1, C2 c2);
 
-    template <typename F, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2>
-    struct context43 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3) volatile, C0 c0, C1 c1, C2 c2);
 
-        context43(F f, C0 c0, C1 c1, C2 c2, C3 c3)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3) const volatile, C0 c0, C1 c1, C2 c2);
 
-        void operator()(A0 a0, A1 a1, A2 a2) {
-            f(c0, c1, c2, c3, a0, a1, a2);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(R (*func)(B0, B1, B2, B3, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2, C3 c3);
 
-    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2>
-    struct context53 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2, C3 c3);
 
-        context53(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3) const, C0 c0, C1 c1, C2 c2, C3 c3);
 
-        void operator()(A0 a0, A1 a1, A2 a2) {
-            f(c0, c1, c2, c3, c4, a0, a1, a2);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
-    template <typename F, typename A0, typename A1, typename A2, typename A3>
-    struct context04 {
-        F f;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
-        context04(F f)
-            : f(f) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(R (*func)(B0, B1, B2, B3, B4, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
-            f(a0, a1, a2, a3);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-    template <typename F, typename C0, typename A0, typename A1, typename A2, typename A3>
-    struct context14 {
-        F f; C0 c0;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
+
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-        context14(F f, C0 c0)
-            : f(f), c0(c0) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
+    Event<void(A0, A1, A2, A3)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
-            f(c0, a0, a1, a2, a3);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(A0, A1, A2, A3, A4));
 
-    template <typename F, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3>
-    struct context24 {
-        F f; C0 c0; C1 c1;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(A0, A1, A2, A3, A4));
 
-        context24(F f, C0 c0, C1 c1)
-            : f(f), c0(c0), c1(c1) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(A0, A1, A2, A3, A4) const);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
-            f(c0, c1, a0, a1, a2, a3);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) volatile);
 
-    template <typename F, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3>
-    struct context34 {
-        F f; C0 c0; C1 c1; C2 c2;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(A0, A1, A2, A3, A4) const volatile);
 
-        context34(F f, C0 c0, C1 c1, C2 c2)
-            : f(f), c0(c0), c1(c1), c2(c2) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(B0, A0, A1, A2, A3, A4), C0 c0);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
-            f(c0, c1, c2, a0, a1, a2, a3);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(B0, A0, A1, A2, A3, A4), C0 c0);
 
-    template <typename F, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3>
-    struct context44 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(B0, A0, A1, A2, A3, A4) const, C0 c0);
 
-        context44(F f, C0 c0, C1 c1, C2 c2, C3 c3)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(B0, A0, A1, A2, A3, A4) volatile, C0 c0);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
-            f(c0, c1, c2, c3, a0, a1, a2, a3);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(B0, A0, A1, A2, A3, A4) const volatile, C0 c0);
 
-    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3>
-    struct context54 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(B0, B1, A0, A1, A2, A3, A4), C0 c0, C1 c1);
 
-        context54(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3, A4), C0 c0, C1 c1);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3) {
-            f(c0, c1, c2, c3, c4, a0, a1, a2, a3);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3, A4) const, C0 c0, C1 c1);
 
-    template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
-    struct context05 {
-        F f;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3, A4) volatile, C0 c0, C1 c1);
 
-        context05(F f)
-            : f(f) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(B0, B1, A0, A1, A2, A3, A4) const volatile, C0 c0, C1 c1);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-            f(a0, a1, a2, a3, a4);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(B0, B1, B2, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2);
 
-    template <typename F, typename C0, typename A0, typename A1, typename A2, typename A3, typename A4>
-    struct context15 {
-        F f; C0 c0;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2);
 
-        context15(F f, C0 c0)
-            : f(f), c0(c0) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3, A4) const, C0 c0, C1 c1, C2 c2);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-            f(c0, a0, a1, a2, a3, a4);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3, A4) volatile, C0 c0, C1 c1, C2 c2);
 
-    template <typename F, typename C0, typename C1, typename A0, typename A1, typename A2, typename A3, typename A4>
-    struct context25 {
-        F f; C0 c0; C1 c1;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, A0, A1, A2, A3, A4) const volatile, C0 c0, C1 c1, C2 c2);
 
-        context25(F f, C0 c0, C1 c1)
-            : f(f), c0(c0), c1(c1) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(B0, B1, B2, B3, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2, C3 c3);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-            f(c0, c1, a0, a1, a2, a3, a4);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2, C3 c3);
 
-    template <typename F, typename C0, typename C1, typename C2, typename A0, typename A1, typename A2, typename A3, typename A4>
-    struct context35 {
-        F f; C0 c0; C1 c1; C2 c2;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3, A4) const, C0 c0, C1 c1, C2 c2, C3 c3);
 
-        context35(F f, C0 c0, C1 c1, C2 c2)
-            : f(f), c0(c0), c1(c1), c2(c2) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3, A4) volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-            f(c0, c1, c2, a0, a1, a2, a3, a4);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, A0, A1, A2, A3, A4) const volatile, C0 c0, C1 c1, C2 c2, C3 c3);
 
-    template <typename F, typename C0, typename C1, typename C2, typename C3, typename A0, typename A1, typename A2, typename A3, typename A4>
-    struct context45 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(R (*func)(B0, B1, B2, B3, B4, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-        context45(F f, C0 c0, C1 c1, C2 c2, C3 c3)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3, A4), C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-            f(c0, c1, c2, c3, a0, a1, a2, a3, a4);
-        }
-    };
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3, A4) const, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-    template <typename F, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
-    struct context55 {
-        F f; C0 c0; C1 c1; C2 c2; C3 c3; C4 c4;
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3, A4) volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-        context55(F f, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4)
-            : f(f), c0(c0), c1(c1), c2(c2), c3(c3), c4(c4) {}
+    /** Creates an event bound to the event queue
+     *  @see EventQueue::event
+     */
+    template <typename T, typename R, typename B0, typename B1, typename B2, typename B3, typename B4, typename C0, typename C1, typename C2, typename C3, typename C4, typename A0, typename A1, typename A2, typename A3, typename A4>
+    Event<void(A0, A1, A2, A3, A4)> event(const volatile T *obj, R (T::*method)(B0, B1, B2, B3, B4, A0, A1, A2, A3, A4) const volatile, C0 c0, C1 c1, C2 c2, C3 c3, C4 c4);
 
-        void operator()(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) {
-            f(c0, c1, c2, c3, c4, a0, a1, a2, a3, a4);
-        }
-    };
+protected:
+    template <typename F>
+    friend class Event;
+    struct equeue _equeue;
+    mbed::Callback<void(int)> _update;
 };
 
 }
@@ -0,0 +1,70 @@
+/* events
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "events/EventQueuePool.h"
+
+#ifdef MBED_CONF_RTOS_PRESENT
+
+#include "events/mbed_events.h"
+#include "mbed.h"
+
+
+EventQueuePool::EventQueuePool(unsigned threads, unsigned size,
+        osPriority priority) {
+    _workers = 0;
+    int err = equeue_pool_create(&_pool, threads, size);
+    if (err < 0) {
+        // an empty pool starts no threads and fails every call
+        return;
+    }
+
+    _workers = new worker[threads];
+    for (unsigned i = 0; i < threads; i++) {
+        _workers[i].pool = this;
+        _workers[i].index = i;
+        _workers[i].thread = new rtos::Thread(priority);
+        _workers[i].thread->start(
+                mbed::callback(&_workers[i], &worker::dispatch));
+    }
+}
+
+EventQueuePool::~EventQueuePool() {
+    equeue_pool_break(&_pool);
+    for (unsigned i = 0; _workers && i < _pool.count; i++) {
+        _workers[i].thread->join();
+        delete _workers[i].thread;
+    }
+
+    delete[] _workers;
+    equeue_pool_destroy(&_pool);
+}
+
+void EventQueuePool::worker::dispatch() {
+    equeue_pool_dispatch(&pool->_pool, index, -1);
+}
+
+bool EventQueuePool::is_valid() const {
+    return _workers != 0;
+}
+
+unsigned EventQueuePool::tick() {
+    return equeue_tick();
+}
+
+void EventQueuePool::cancel(int id) {
+    return equeue_pool_cancel(&_pool, id);
+}
+
+#endif
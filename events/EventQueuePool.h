@@ -0,0 +1,221 @@
+/* events
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef EVENT_QUEUE_POOL_H
+#define EVENT_QUEUE_POOL_H
+
+#ifdef MBED_CONF_RTOS_PRESENT
+
+#include "events/EventQueue.h"
+#include "rtos/Thread.h"
+
+namespace events {
+/** \addtogroup events */
+/** @{*/
+
+/** EventQueuePool
+ *
+ *  Pool of threads dispatching events in parallel
+ *
+ *  Each thread of the pool dispatches its own event queue. Events are
+ *  spread between the queues, and a thread whose queue has no ready events
+ *  steals ready events from the other queues.
+ *
+ *  Events posted to the same strand always run on the same thread, one at
+ *  a time and in the order they are posted. No ordering is guaranteed
+ *  between other events.
+ */
+class EventQueuePool : public EventQueueCalls<EventQueuePool> {
+public:
+    /** Create an EventQueuePool
+     *
+     *  Create a pool of threads, each dispatching an event queue with a
+     *  buffer allocated with malloc. If the buffers can not be allocated,
+     *  no threads are started and every call fails, see is_valid.
+     *
+     *  @param threads  Number of dispatch threads
+     *  @param size     Size of buffer to use for each thread's events in
+     *                  bytes (default to EVENTS_QUEUE_SIZE)
+     *  @param priority Priority of the dispatch threads
+     *                  (default to osPriorityNormal)
+     */
+    EventQueuePool(unsigned threads, unsigned size=EVENTS_QUEUE_SIZE,
+            osPriority priority=osPriorityNormal);
+
+    /** Destroy an EventQueuePool
+     *
+     *  Stops and joins the dispatch threads. Pending events are not
+     *  executed.
+     */
+    ~EventQueuePool();
+
+    /** Check if the pool was created
+     *
+     *  @return         True if the pool's buffers were allocated and its
+     *                  threads started, false otherwise
+     */
+    bool is_valid() const;
+
+    /** Millisecond counter
+     *  @see EventQueue::tick
+     */
+    unsigned tick();
+
+    /** Cancel an in-flight event
+     *
+     *  Attempts to cancel an event referenced by the unique id returned from
+     *  one of the call functions, with the same guarantees as
+     *  EventQueue::cancel.
+     *
+     *  @param id       Unique id of the event
+     */
+    void cancel(int id);
+
+    /** Calls an event on the pool
+     *
+     *  The specified callback will be executed on one of the pool's
+     *  threads.
+     *
+     *  The call function is irq safe.
+     *
+     *  @param f        Function to execute in the context of the pool
+     *  @param a0..a4   Arguments to pass to the callback
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call(F f) {
+        return post(-1, 0, -1, f);
+    }
+
+    using EventQueueCalls<EventQueuePool>::call;
+
+    /** Calls an event on the pool after a specified delay
+     *
+     *  The specified callback will be executed on one of the pool's threads
+     *  after the specified delay in milliseconds.
+     *
+     *  The call_in function is irq safe.
+     *
+     *  @param ms       Time to delay in milliseconds
+     *  @param f        Function to execute in the context of the pool
+     *  @param a0..a4   Arguments to pass to the callback
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_in(int ms, F f) {
+        return post(-1, ms, -1, f);
+    }
+
+    using EventQueueCalls<EventQueuePool>::call_in;
+
+    /** Calls an event on the pool periodically
+     *
+     *  The specified callback will be executed on one of the pool's threads
+     *  repeatedly at the specified period in milliseconds.
+     *
+     *  The call_every function is irq safe.
+     *
+     *  @param ms       Period of the event in milliseconds
+     *  @param f        Function to execute in the context of the pool
+     *  @param a0..a4   Arguments to pass to the callback
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_every(int ms, F f) {
+        return post(-1, ms, ms, f);
+    }
+
+    using EventQueueCalls<EventQueuePool>::call_every;
+
+    /** Calls an event on a strand of the pool
+     *
+     *  The specified callback will be executed on the thread that owns the
+     *  strand, after any events previously posted to the same strand.
+     *  Use mbed::callback to bind arguments.
+     *
+     *  The call_strand function is irq safe.
+     *
+     *  @param strand   Non-negative number identifying the strand
+     *  @param f        Function to execute in the context of the pool
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_strand(int strand, F f) {
+        return post(strand, 0, -1, f);
+    }
+
+    /** Calls an event on a strand of the pool after a specified delay
+     *  @see EventQueuePool::call_strand
+     */
+    template <typename F>
+    int call_in_strand(int strand, int ms, F f) {
+        return post(strand, ms, -1, f);
+    }
+
+    /** Calls an event on a strand of the pool periodically
+     *  @see EventQueuePool::call_strand
+     */
+    template <typename F>
+    int call_every_strand(int strand, int ms, F f) {
+        return post(strand, ms, ms, f);
+    }
+
+protected:
+    struct worker {
+        EventQueuePool *pool;
+        unsigned index;
+        rtos::Thread *thread;
+
+        void dispatch();
+    };
+
+    struct equeue_pool _pool;
+    worker *_workers;
+
+    template <typename F>
+    int post(int strand, int ms, int period, F f) {
+        struct local {
+            static void call(void *p) { (*static_cast<F*>(p))(); }
+            static void dtor(void *p) { static_cast<F*>(p)->~F(); }
+        };
+
+        void *p = equeue_pool_alloc(&_pool, strand, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(f);
+        equeue_event_delay(e, ms);
+        equeue_event_period(e, period);
+        equeue_event_dtor(e, &local::dtor);
+        return equeue_pool_post(&_pool, &local::call, e);
+    }
+};
+
+}
+
+#endif
+
+#endif
+
+/** @}*/
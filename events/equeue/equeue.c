@@ -17,6 +17,7 @@
  */
 #include "equeue/equeue.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -34,6 +35,14 @@ static inline int equeue_clampdiff(unsigned a, unsigned b) {
     return ~(diff >> (8*sizeof(int)-1)) & diff;
 }
 
+// check if an event should be dispatched before another, events with the
+// same target are ordered by when they were posted
+static inline bool equeue_before(struct equeue_event *a,
+        struct equeue_event *b) {
+    int diff = equeue_tickdiff(a->target, b->target);
+    return diff < 0 || (diff == 0 && equeue_tickdiff(a->seq, b->seq) < 0);
+}
+
 // Increment the unique id in an event, hiding the event from cancel
 static inline void equeue_incid(equeue_t *q, struct equeue_event *e) {
     e->id += 1;
@@ -67,12 +76,35 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer) {
     }
 
     q->chunks = 0;
+#if EQUEUE_SIZE_CLASSES > 0
+    for (int i = 0; i < EQUEUE_SIZE_CLASSES; i++) {
+        q->classes[i] = 0;
+    }
+#endif
     q->slab.size = size;
     q->slab.data = buffer;
 
+#if EQUEUE_IRQ_STASH > 0
+    q->stash.head = 0;
+    q->stash.tail = 0;
+    // leave at least half of the chunks to the locked allocator
+    q->stash.cap = size / EQUEUE_EVENT_SIZE / 2;
+    if (q->stash.cap > EQUEUE_IRQ_STASH) {
+        q->stash.cap = EQUEUE_IRQ_STASH;
+    }
+#endif
+
+    q->stats.current_size = 0;
+    q->stats.max_size = 0;
+    q->stats.alloc_cnt = 0;
+    q->stats.alloc_fail_cnt = 0;
+
     q->queue = 0;
-    q->tick = equeue_tick();
-    q->generation = 0;
+    for (int i = 0; i < EQUEUE_PRIORITIES; i++) {
+        q->ready[i].head = 0;
+        q->ready[i].tail = &q->ready[i].head;
+    }
+    q->seq = 0;
     q->breaks = 0;
 
     q->background.active = false;
@@ -99,10 +131,20 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer) {
     return 0;
 }
 
+static void equeue_heap_pop(equeue_t *q);
+
 void equeue_destroy(equeue_t *q) {
     // call destructors on pending events
-    for (struct equeue_event *es = q->queue; es; es = es->next) {
-        for (struct equeue_event *e = q->queue; e; e = e->sibling) {
+    while (q->queue) {
+        struct equeue_event *e = q->queue;
+        equeue_heap_pop(q);
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
+
+    for (int i = 0; i < EQUEUE_PRIORITIES; i++) {
+        for (struct equeue_event *e = q->ready[i].head; e; e = e->next) {
             if (e->dtor) {
                 e->dtor(e + 1);
             }
@@ -123,14 +165,37 @@ void equeue_destroy(equeue_t *q) {
 
 
 // equeue chunk allocation functions
-static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size) {
-    // add event overhead
-    size += sizeof(struct equeue_event);
-    size = (size + sizeof(void*)-1) & ~(sizeof(void*)-1);
+#if EQUEUE_SIZE_CLASSES > 0
+// find the smallest size class that fits a chunk, or EQUEUE_SIZE_CLASSES
+// if the chunk is too large for any class
+static inline int equeue_sizeclass(size_t size) {
+    int c = 0;
+    while (c < EQUEUE_SIZE_CLASSES && (EQUEUE_EVENT_SIZE << c) < size) {
+        c++;
+    }
 
-    equeue_mutex_lock(&q->memlock);
+    return c;
+}
+#endif
+
+// account for a chunk leaving or returning to the allocator, must be
+// called with memlock held
+static inline void equeue_mem_account(equeue_t *q, struct equeue_event *e) {
+    q->stats.current_size += e->size;
+    if (q->stats.current_size > q->stats.max_size) {
+        q->stats.max_size = q->stats.current_size;
+    }
+    q->stats.alloc_cnt += 1;
+}
 
-    // check if a good chunk is available
+static inline void equeue_mem_unaccount(equeue_t *q, struct equeue_event *e) {
+    q->stats.current_size -= e->size;
+    q->stats.alloc_cnt -= 1;
+}
+
+// take the first chunk that fits from the list of free chunks, must be
+// called with memlock held
+static struct equeue_event *equeue_mem_firstfit(equeue_t *q, size_t size) {
     for (struct equeue_event **p = &q->chunks; *p; p = &(*p)->next) {
         if ((*p)->size >= size) {
             struct equeue_event *e = *p;
@@ -141,30 +206,96 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size) {
                 *p = e->next;
             }
 
-            equeue_mutex_unlock(&q->memlock);
             return e;
         }
     }
 
+    return 0;
+}
+
+static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size) {
+    // add event overhead
+    size += sizeof(struct equeue_event);
+    size = (size + sizeof(void*)-1) & ~(sizeof(void*)-1);
+
+    equeue_mutex_lock(&q->memlock);
+
+    // check if a good chunk is available
+    struct equeue_event *e;
+#if EQUEUE_SIZE_CLASSES > 0
+    int c = equeue_sizeclass(size);
+    if (c < EQUEUE_SIZE_CLASSES) {
+        size = EQUEUE_EVENT_SIZE << c;
+        e = q->classes[c];
+        if (e) {
+            q->classes[c] = e->next;
+        }
+    } else {
+        e = equeue_mem_firstfit(q, size);
+    }
+#else
+    e = equeue_mem_firstfit(q, size);
+#endif
+
     // otherwise allocate a new chunk out of the slab
-    if (q->slab.size >= size) {
-        struct equeue_event *e = (struct equeue_event *)q->slab.data;
+    if (!e && q->slab.size >= size) {
+        e = (struct equeue_event *)q->slab.data;
         q->slab.data += size;
         q->slab.size -= size;
         e->size = size;
         e->id = 1;
+    }
 
-        equeue_mutex_unlock(&q->memlock);
-        return e;
+    if (e) {
+        equeue_mem_account(q, e);
+    }
+#if EQUEUE_IRQ_STASH > 0
+    // otherwise take a chunk back from the interrupt stash, the consumer
+    // can not run while memlock is held and the chunk is still accounted for
+    else if (size <= EQUEUE_EVENT_SIZE && q->stash.tail != q->stash.head) {
+        e = q->stash.events[q->stash.tail % EQUEUE_IRQ_STASH];
+        q->stash.tail += 1;
+    }
+#endif
+
+    if (!e) {
+        q->stats.alloc_fail_cnt += 1;
     }
 
     equeue_mutex_unlock(&q->memlock);
-    return 0;
+    return e;
 }
 
 static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e) {
     equeue_mutex_lock(&q->memlock);
 
+#if EQUEUE_IRQ_STASH > 0
+    // top up the interrupt stash first, the chunk stays accounted for
+    // since the consumer can not update the stats
+    if (e->size == EQUEUE_EVENT_SIZE &&
+        q->stash.head - q->stash.tail < q->stash.cap) {
+        q->stash.events[q->stash.head % EQUEUE_IRQ_STASH] = e;
+        q->stash.head += 1;
+
+        equeue_mutex_unlock(&q->memlock);
+        return;
+    }
+#endif
+
+    equeue_mem_unaccount(q, e);
+
+#if EQUEUE_SIZE_CLASSES > 0
+    // stick chunk into its size class
+    int c = equeue_sizeclass(e->size);
+    if (c < EQUEUE_SIZE_CLASSES) {
+        e->next = q->classes[c];
+        q->classes[c] = e;
+
+        equeue_mutex_unlock(&q->memlock);
+        return;
+    }
+#endif
+
     // stick chunk into list of chunks
     struct equeue_event **p = &q->chunks;
     while (*p && (*p)->size < e->size) {
@@ -191,11 +322,38 @@ void *equeue_alloc(equeue_t *q, size_t size) {
 
     e->target = 0;
     e->period = -1;
+    e->priority = 0;
+    e->pinned = 0;
     e->dtor = 0;
 
     return e + 1;
 }
 
+void *equeue_alloc_irq(equeue_t *q, size_t size) {
+#if EQUEUE_IRQ_STASH > 0
+    // take a chunk from the stash if it fits, the producer only writes
+    // slots between tail and head while holding memlock, so the single
+    // consumer needs no lock
+    if (size + sizeof(struct equeue_event) <= EQUEUE_EVENT_SIZE) {
+        unsigned tail = q->stash.tail;
+        if (tail != q->stash.head) {
+            struct equeue_event *e = q->stash.events[tail % EQUEUE_IRQ_STASH];
+            q->stash.tail = tail + 1;
+
+            e->target = 0;
+            e->period = -1;
+            e->priority = 0;
+            e->pinned = 0;
+            e->dtor = 0;
+
+            return e + 1;
+        }
+    }
+#endif
+
+    return equeue_alloc(q, size);
+}
+
 void equeue_dealloc(equeue_t *q, void *p) {
     struct equeue_event *e = (struct equeue_event*)p - 1;
 
@@ -207,45 +365,124 @@ void equeue_dealloc(equeue_t *q, void *p) {
 }
 
 
+// equeue heap functions, must be called with queuelock held
+static struct equeue_event *equeue_heap_meld(
+        struct equeue_event *a, struct equeue_event *b) {
+    if (equeue_before(b, a)) {
+        struct equeue_event *t = a;
+        a = b;
+        b = t;
+    }
+
+    // b becomes the first child of a
+    b->next = a->sibling;
+    if (b->next) {
+        b->next->ref = &b->next;
+    }
+
+    a->sibling = b;
+    b->ref = &a->sibling;
+    return a;
+}
+
+static struct equeue_event *equeue_heap_merge(struct equeue_event *first) {
+    // meld siblings in pairs from left to right, collecting the results
+    // in reverse order
+    struct equeue_event *pairs = 0;
+    while (first) {
+        struct equeue_event *a = first;
+        struct equeue_event *b = a->next;
+        if (b) {
+            first = b->next;
+            a->next = 0;
+            b->next = 0;
+            a = equeue_heap_meld(a, b);
+        } else {
+            first = 0;
+        }
+
+        a->next = pairs;
+        pairs = a;
+    }
+
+    // then meld the results from right to left
+    struct equeue_event *root = pairs;
+    pairs = root->next;
+    root->next = 0;
+    while (pairs) {
+        struct equeue_event *e = pairs;
+        pairs = e->next;
+        e->next = 0;
+        root = equeue_heap_meld(root, e);
+    }
+
+    return root;
+}
+
+static void equeue_heap_push(equeue_t *q, struct equeue_event *e) {
+    q->queue = q->queue ? equeue_heap_meld(q->queue, e) : e;
+    q->queue->ref = &q->queue;
+}
+
+static void equeue_heap_pop(equeue_t *q) {
+    struct equeue_event *e = q->queue;
+    q->queue = e->sibling ? equeue_heap_merge(e->sibling) : 0;
+    if (q->queue) {
+        q->queue->ref = &q->queue;
+    }
+}
+
+// find the delay until the next pending event, must be called with
+// queuelock held
+static int equeue_nextdelay(equeue_t *q, unsigned tick) {
+    for (int i = 0; i < EQUEUE_PRIORITIES; i++) {
+        if (q->ready[i].head) {
+            return 0;
+        }
+    }
+
+    if (q->queue) {
+        return equeue_clampdiff(q->queue->target, tick);
+    }
+
+    return -1;
+}
+
+
+void equeue_mem_stats(equeue_t *q, struct equeue_mem_stats *stats) {
+    equeue_mutex_lock(&q->memlock);
+    *stats = q->stats;
+    equeue_mutex_unlock(&q->memlock);
+}
+
+
 // equeue scheduling functions
 static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick) {
     // setup event and hash local id with buffer offset for unique id
     int id = (e->id << q->npw2) | ((unsigned char *)e - q->buffer);
     e->target = tick + equeue_clampdiff(e->target, tick);
-    e->generation = q->generation;
+    e->next = 0;
+    e->sibling = 0;
 
     equeue_mutex_lock(&q->queuelock);
+    e->seq = q->seq++;
 
-    // find the event slot
-    struct equeue_event **p = &q->queue;
-    while (*p && equeue_tickdiff((*p)->target, e->target) < 0) {
-        p = &(*p)->next;
-    }
-
-    // insert at head in slot
-    if (*p && (*p)->target == e->target) {
-        e->next = (*p)->next;
-        if (e->next) {
-            e->next->ref = &e->next;
-        }
+    bool first;
+    if (e->target == tick) {
+        // ready events skip the heap, appending to their priority's list
+        first = equeue_nextdelay(q, tick) != 0;
 
-        e->sibling = *p;
-        e->sibling->ref = &e->sibling;
+        struct equeue_ready *r = &q->ready[e->priority];
+        e->ref = r->tail;
+        *r->tail = e;
+        r->tail = &e->next;
     } else {
-        e->next = *p;
-        if (e->next) {
-            e->next->ref = &e->next;
-        }
-
-        e->sibling = 0;
+        equeue_heap_push(q, e);
+        first = q->queue == e && equeue_nextdelay(q, tick) != 0;
     }
 
-    *p = e;
-    e->ref = p;
-
     // notify background timer
-    if ((q->background.update && q->background.active) &&
-        (q->queue == e && !e->sibling)) {
+    if ((q->background.update && q->background.active) && first) {
         q->background.update(q->background.timer,
                 equeue_clampdiff(e->target, tick));
     }
@@ -270,26 +507,24 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id) {
     e->cb = 0;
     e->period = -1;
 
-    int diff = equeue_tickdiff(e->target, q->tick);
-    if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
+    if (!e->ref) {
         equeue_mutex_unlock(&q->queuelock);
         return 0;
     }
 
     // disentangle from queue
-    if (e->sibling) {
-        e->sibling->next = e->next;
-        if (e->sibling->next) {
-            e->sibling->next->ref = &e->sibling->next;
-        }
+    *e->ref = e->next;
+    if (e->next) {
+        e->next->ref = e->ref;
+    } else if (q->ready[e->priority].tail == &e->next) {
+        q->ready[e->priority].tail = e->ref;
+    }
 
-        *e->ref = e->sibling;
-        e->sibling->ref = e->ref;
-    } else {
-        *e->ref = e->next;
-        if (e->next) {
-            e->next->ref = e->ref;
-        }
+    // any children are handed back to the heap
+    if (e->sibling) {
+        struct equeue_event *children = equeue_heap_merge(e->sibling);
+        e->sibling = 0;
+        equeue_heap_push(q, children);
     }
 
     equeue_incid(q, e);
@@ -299,47 +534,149 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id) {
 }
 
 static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target) {
+    struct equeue_event *expired[EQUEUE_PRIORITIES];
+    struct equeue_event **tails[EQUEUE_PRIORITIES];
+    for (int i = 0; i < EQUEUE_PRIORITIES; i++) {
+        expired[i] = 0;
+        tails[i] = &expired[i];
+    }
+
     equeue_mutex_lock(&q->queuelock);
 
-    // find all expired events and mark a new generation
-    q->generation += 1;
-    if (equeue_tickdiff(q->tick, target) <= 0) {
-        q->tick = target;
+    // find all expired events in the heap, in order, by priority
+    while (q->queue && equeue_tickdiff(q->queue->target, target) <= 0) {
+        struct equeue_event *e = q->queue;
+        equeue_heap_pop(q);
+
+        e->sibling = 0;
+        e->next = 0;
+        *tails[e->priority] = e;
+        tails[e->priority] = &e->next;
     }
 
-    struct equeue_event *head = q->queue;
-    struct equeue_event **p = &head;
-    while (*p && equeue_tickdiff((*p)->target, target) <= 0) {
-        p = &(*p)->next;
+    // merge with the ready events, highest priority first, marking the
+    // events as in-flight
+    struct equeue_event *head = 0;
+    struct equeue_event **tail = &head;
+    for (int i = EQUEUE_PRIORITIES-1; i >= 0; i--) {
+        struct equeue_event *a = expired[i];
+        struct equeue_event *b = q->ready[i].head;
+        q->ready[i].head = 0;
+        q->ready[i].tail = &q->ready[i].head;
+
+        while (a || b) {
+            struct equeue_event *e;
+            if (!b || (a && equeue_before(a, b))) {
+                e = a;
+                a = a->next;
+            } else {
+                e = b;
+                b = b->next;
+            }
+
+            e->ref = 0;
+            *tail = e;
+            tail = &e->next;
+        }
     }
 
-    q->queue = *p;
-    if (q->queue) {
-        q->queue->ref = &q->queue;
+    *tail = 0;
+
+    equeue_mutex_unlock(&q->queuelock);
+
+    return head;
+}
+
+// move expired events from the heap onto the ready lists, must be called
+// with queuelock held
+static void equeue_promote(equeue_t *q, unsigned target) {
+    while (q->queue && equeue_tickdiff(q->queue->target, target) <= 0) {
+        struct equeue_event *e = q->queue;
+        equeue_heap_pop(q);
+
+        struct equeue_ready *r = &q->ready[e->priority];
+        e->sibling = 0;
+        e->next = 0;
+        e->ref = r->tail;
+        *r->tail = e;
+        r->tail = &e->next;
     }
+}
+
+// take the next ready event off the front of the queue, marking it as
+// in-flight
+static struct equeue_event *equeue_take(equeue_t *q, unsigned target) {
+    equeue_mutex_lock(&q->queuelock);
+    equeue_promote(q, target);
+
+    for (int i = EQUEUE_PRIORITIES-1; i >= 0; i--) {
+        struct equeue_ready *r = &q->ready[i];
+        struct equeue_event *e = r->head;
+        if (e) {
+            r->head = e->next;
+            if (e->next) {
+                e->next->ref = &r->head;
+            } else {
+                r->tail = &r->head;
+            }
 
-    *p = 0;
+            e->ref = 0;
+            equeue_mutex_unlock(&q->queuelock);
+            return e;
+        }
+    }
 
     equeue_mutex_unlock(&q->queuelock);
+    return 0;
+}
 
-    // reverse and flatten each slot to match insertion order
-    struct equeue_event **tail = &head;
-    struct equeue_event *ess = head;
-    while (ess) {
-        struct equeue_event *es = ess;
-        ess = es->next;
-
-        struct equeue_event *prev = 0;
-        for (struct equeue_event *e = es; e; e = e->sibling) {
-            e->next = prev;
-            prev = e;
+// steal the most recently posted ready event off the back of the queue,
+// pinned events are left for the queue's own worker
+static struct equeue_event *equeue_steal(equeue_t *q, unsigned target) {
+    equeue_mutex_lock(&q->queuelock);
+    equeue_promote(q, target);
+
+    for (int i = EQUEUE_PRIORITIES-1; i >= 0; i--) {
+        struct equeue_ready *r = &q->ready[i];
+        if (r->tail == &r->head) {
+            continue;
         }
 
-        *tail = prev;
-        tail = &es->next;
+        struct equeue_event *e = (struct equeue_event *)
+                ((unsigned char *)r->tail - offsetof(struct equeue_event, next));
+        if (!e->pinned) {
+            *e->ref = 0;
+            r->tail = e->ref;
+
+            e->ref = 0;
+            equeue_mutex_unlock(&q->queuelock);
+            return e;
+        }
     }
 
-    return head;
+    equeue_mutex_unlock(&q->queuelock);
+    return 0;
+}
+
+// run a dequeued event, then reenqueue periodic events or deallocate,
+// returns true if the event was reenqueued
+static bool equeue_run(equeue_t *q, struct equeue_event *e) {
+    // actually dispatch the callbacks
+    void (*cb)(void *) = e->cb;
+    if (cb) {
+        cb(e + 1);
+    }
+
+    // reenqueue periodic events or deallocate
+    if (e->period >= 0) {
+        e->target += e->period;
+        equeue_enqueue(q, e, equeue_tick());
+        return true;
+    } else {
+        equeue_incid(q, e);
+        equeue_dealloc(q, e+1);
+        return false;
+    }
 }
 
 int equeue_post(equeue_t *q, void (*cb)(void*), void *p) {
@@ -385,20 +722,7 @@ void equeue_dispatch(equeue_t *q, int ms) {
             struct equeue_event *e = es;
             es = e->next;
 
-            // actually dispatch the callbacks
-            void (*cb)(void *) = e->cb;
-            if (cb) {
-                cb(e + 1);
-            }
-
-            // reenqueue periodic events or deallocate
-            if (e->period >= 0) {
-                e->target += e->period;
-                equeue_enqueue(q, e, equeue_tick());
-            } else {
-                equeue_incid(q, e);
-                equeue_dealloc(q, e+1);
-            }
+            equeue_run(q, e);
         }
 
         int deadline = -1;
@@ -411,9 +735,9 @@ void equeue_dispatch(equeue_t *q, int ms) {
                 // update background timer if necessary
                 if (q->background.update) {
                     equeue_mutex_lock(&q->queuelock);
-                    if (q->background.update && q->queue) {
-                        q->background.update(q->background.timer,
-                                equeue_clampdiff(q->queue->target, tick));
+                    int delay = equeue_nextdelay(q, tick);
+                    if (q->background.update && delay >= 0) {
+                        q->background.update(q->background.timer, delay);
                     }
                     q->background.active = true;
                     equeue_mutex_unlock(&q->queuelock);
@@ -424,11 +748,9 @@ void equeue_dispatch(equeue_t *q, int ms) {
 
         // find closest deadline
         equeue_mutex_lock(&q->queuelock);
-        if (q->queue) {
-            int diff = equeue_clampdiff(q->queue->target, tick);
-            if ((unsigned)diff < (unsigned)deadline) {
-                deadline = diff;
-            }
+        int diff = equeue_nextdelay(q, tick);
+        if ((unsigned)diff < (unsigned)deadline) {
+            deadline = diff;
         }
         equeue_mutex_unlock(&q->queuelock);
 
@@ -463,6 +785,17 @@ void equeue_event_period(void *p, int ms) {
     e->period = ms;
 }
 
+void equeue_event_priority(void *p, int priority) {
+    struct equeue_event *e = (struct equeue_event*)p - 1;
+    if (priority < 0) {
+        priority = 0;
+    } else if (priority > EQUEUE_PRIORITIES-1) {
+        priority = EQUEUE_PRIORITIES-1;
+    }
+
+    e->priority = priority;
+}
+
 void equeue_event_dtor(void *p, void (*dtor)(void *)) {
     struct equeue_event *e = (struct equeue_event*)p - 1;
     e->dtor = dtor;
@@ -528,9 +861,9 @@ void equeue_background(equeue_t *q,
     q->background.update = update;
     q->background.timer = timer;
 
-    if (q->background.update && q->queue) {
-        q->background.update(q->background.timer,
-                equeue_clampdiff(q->queue->target, equeue_tick()));
+    int delay = equeue_nextdelay(q, equeue_tick());
+    if (q->background.update && delay >= 0) {
+        q->background.update(q->background.timer, delay);
     }
     q->background.active = true;
     equeue_mutex_unlock(&q->queuelock);
@@ -567,3 +900,245 @@ void equeue_chain(equeue_t *q, equeue_t *target) {
 
     equeue_background(q, equeue_chain_update, c);
 }
+
+
+// event queue pools
+int equeue_pool_create(equeue_pool_t *p, unsigned count, size_t size) {
+    // workers share a single buffer, so an event's worker can be found
+    // from its address
+    p->count = 0;
+    p->workers = 0;
+    p->buffer = 0;
+    if (count && (size > SIZE_MAX / count ||
+            count > SIZE_MAX / sizeof(struct equeue_pool_worker))) {
+        return -1;
+    }
+
+    p->workers = malloc(count*sizeof(struct equeue_pool_worker));
+    p->buffer = malloc(count*size);
+    if (!p->workers || !p->buffer) {
+        equeue_pool_destroy(p);
+        return -1;
+    }
+
+    p->size = size;
+    p->next = 0;
+
+    for (unsigned i = 0; i < count; i++) {
+        int err = equeue_create_inplace(&p->workers[i].queue,
+                size, p->buffer + i*size);
+        if (err < 0) {
+            equeue_pool_destroy(p);
+            return err;
+        }
+
+        p->workers[i].idle = false;
+        p->count++;
+    }
+
+    return 0;
+}
+
+void equeue_pool_destroy(equeue_pool_t *p) {
+    for (unsigned i = 0; i < p->count; i++) {
+        equeue_destroy(&p->workers[i].queue);
+    }
+
+    free(p->workers);
+    free(p->buffer);
+
+    // leave an empty pool behind, which is safe to destroy again
+    p->count = 0;
+    p->workers = 0;
+    p->buffer = 0;
+}
+
+// find the worker an event was allocated from
+static inline unsigned equeue_pool_home(equeue_pool_t *p,
+        struct equeue_event *e) {
+    return ((unsigned char *)e - p->buffer) / p->size;
+}
+
+void *equeue_pool_alloc(equeue_pool_t *p, int strand, size_t size) {
+    if (!p->count) {
+        return 0;
+    }
+
+    // strands always live on the same worker
+    if (strand >= 0) {
+        equeue_t *q = &p->workers[(unsigned)strand % p->count].queue;
+        void *e = equeue_alloc(q, size);
+        if (e) {
+            ((struct equeue_event *)e - 1)->pinned = 1;
+        }
+
+        return e;
+    }
+
+    // spread other events between the workers, falling back on the other
+    // workers if a queue runs out of memory, racing on next only affects
+    // the spread
+    unsigned first = p->next++;
+    for (unsigned i = 0; i < p->count; i++) {
+        void *e = equeue_alloc(&p->workers[(first + i) % p->count].queue, size);
+        if (e) {
+            return e;
+        }
+    }
+
+    return 0;
+}
+
+void equeue_pool_dealloc(equeue_pool_t *p, void *ev) {
+    struct equeue_event *e = (struct equeue_event*)ev - 1;
+    equeue_dealloc(&p->workers[equeue_pool_home(p, e)].queue, ev);
+}
+
+int equeue_pool_post(equeue_pool_t *p, void (*cb)(void *), void *ev) {
+    struct equeue_event *e = (struct equeue_event*)ev - 1;
+    unsigned home = equeue_pool_home(p, e);
+    bool stealable = !e->pinned && !e->target;
+
+    int id = equeue_post(&p->workers[home].queue, cb, ev);
+
+    // equeue_post wakes up the event's own worker, if it is busy wake up
+    // an idle worker to steal the event
+    if (stealable && !p->workers[home].idle) {
+        for (unsigned i = 1; i < p->count; i++) {
+            struct equeue_pool_worker *w = &p->workers[(home + i) % p->count];
+            if (w->idle) {
+                equeue_sema_signal(&w->queue.eventsema);
+                break;
+            }
+        }
+    }
+
+    return (int)((unsigned)id*p->count + home);
+}
+
+void equeue_pool_cancel(equeue_pool_t *p, int id) {
+    if (!id || !p->count) {
+        return;
+    }
+
+    equeue_cancel(&p->workers[(unsigned)id % p->count].queue,
+            (int)((unsigned)id / p->count));
+}
+
+void equeue_pool_break(equeue_pool_t *p) {
+    for (unsigned i = 0; i < p->count; i++) {
+        equeue_break(&p->workers[i].queue);
+    }
+}
+
+void equeue_pool_dispatch(equeue_pool_t *p, unsigned worker, int ms) {
+    struct equeue_pool_worker *w = &p->workers[worker];
+    equeue_t *q = &w->queue;
+    unsigned tick = equeue_tick();
+    unsigned timeout = tick + ms;
+
+    // the worker counts as idle whenever it is not running an event, this
+    // is set before looking for work so a concurrent post either finds us
+    // idle or is found by us
+    w->idle = true;
+
+    while (1) {
+        // run our own events first, otherwise try to steal an event from
+        // the other workers, starting with our neighbour
+        equeue_t *home = q;
+        struct equeue_event *e = equeue_take(q, tick);
+        for (unsigned i = 1; !e && i < p->count; i++) {
+            home = &p->workers[(worker + i) % p->count].queue;
+            e = equeue_steal(home, tick);
+        }
+
+        if (e) {
+            w->idle = false;
+            bool reenqueued = equeue_run(home, e);
+            w->idle = true;
+
+            // a stolen periodic event returns to its own queue, whose
+            // worker needs to update its deadline
+            if (reenqueued && home != q) {
+                equeue_sema_signal(&home->eventsema);
+            }
+        }
+
+        int deadline = -1;
+        tick = equeue_tick();
+
+        // check if we should stop dispatching soon, with a timeout of 0 we
+        // stop once no events are ready
+        if (ms >= 0) {
+            deadline = equeue_tickdiff(timeout, tick);
+            if (deadline <= 0 && (!e || ms > 0)) {
+                w->idle = false;
+                return;
+            }
+        }
+
+        if (!e) {
+            // find closest deadline
+            equeue_mutex_lock(&q->queuelock);
+            int diff = equeue_nextdelay(q, tick);
+            if ((unsigned)diff < (unsigned)deadline) {
+                deadline = diff;
+            }
+            equeue_mutex_unlock(&q->queuelock);
+
+            // wait for events
+            equeue_sema_wait(&q->eventsema, deadline);
+            tick = equeue_tick();
+        }
+
+        // check if we were notified to break out of dispatch
+        if (q->breaks) {
+            equeue_mutex_lock(&q->queuelock);
+            if (q->breaks > 0) {
+                q->breaks--;
+                equeue_mutex_unlock(&q->queuelock);
+                w->idle = false;
+                return;
+            }
+            equeue_mutex_unlock(&q->queuelock);
+        }
+    }
+}
+
+int equeue_pool_call(equeue_pool_t *p, void (*cb)(void*), void *data) {
+    struct ecallback *e = equeue_pool_alloc(p, -1, sizeof(struct ecallback));
+    if (!e) {
+        return 0;
+    }
+
+    e->cb = cb;
+    e->data = data;
+    return equeue_pool_post(p, ecallback_dispatch, e);
+}
+
+int equeue_pool_call_in(equeue_pool_t *p, int ms,
+        void (*cb)(void*), void *data) {
+    struct ecallback *e = equeue_pool_alloc(p, -1, sizeof(struct ecallback));
+    if (!e) {
+        return 0;
+    }
+
+    equeue_event_delay(e, ms);
+    e->cb = cb;
+    e->data = data;
+    return equeue_pool_post(p, ecallback_dispatch, e);
+}
+
+int equeue_pool_call_every(equeue_pool_t *p, int ms,
+        void (*cb)(void*), void *data) {
+    struct ecallback *e = equeue_pool_alloc(p, -1, sizeof(struct ecallback));
+    if (!e) {
+        return 0;
+    }
+
+    equeue_event_delay(e, ms);
+    equeue_event_period(e, ms);
+    e->cb = cb;
+    e->data = data;
+    return equeue_pool_post(p, ecallback_dispatch, e);
+}
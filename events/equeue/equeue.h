@@ -36,17 +36,59 @@ extern "C" {
 // This size is guaranteed to fit events created by event_call
 #define EQUEUE_EVENT_SIZE (sizeof(struct equeue_event) + 2*sizeof(void*))
 
+// The number of event priorities
+// Events that are ready at the same time are dispatched in order of
+// priority, from EQUEUE_PRIORITIES-1 down to 0. Events default to 0.
+#ifndef EQUEUE_PRIORITIES
+#define EQUEUE_PRIORITIES 4
+#endif
+
+// Allocator size classes
+//
+// By default event memory is allocated first-fit from a list of free
+// chunks sorted by size. Defining EQUEUE_SIZE_CLASSES to a non-zero count
+// instead rounds allocations up to power-of-two multiples of
+// EQUEUE_EVENT_SIZE, each size class with its own free list. Allocation
+// and deallocation are then constant time and fragmentation is bounded,
+// at the cost of up to half of each chunk. Allocations larger than the
+// largest class fall back to the first-fit list.
+#ifndef EQUEUE_SIZE_CLASSES
+#define EQUEUE_SIZE_CLASSES 0
+#endif
+
+// Interrupt allocation stash
+//
+// Defining EQUEUE_IRQ_STASH to a non-zero count reserves up to that many
+// free EQUEUE_EVENT_SIZE chunks for equeue_alloc_irq, which takes them
+// without locking the queue's memory. The stash never holds more than
+// half of the queue's chunks, and equeue_alloc takes chunks back from it
+// before failing.
+#ifndef EQUEUE_IRQ_STASH
+#define EQUEUE_IRQ_STASH 0
+#endif
+
 // Internal event structure
+//
+// Pending events with a delay are kept in a pairing heap ordered by
+// target, where sibling points to the first child and next to the next
+// sibling. Events that are ready immediately skip the heap and are
+// appended to a list per priority. In both cases ref points to the pointer
+// referencing the event, allowing it to be unlinked in constant time.
+//
+// Pinned events belong to a strand of an event queue pool and are never
+// stolen by other workers.
 struct equeue_event {
     unsigned size;
     uint8_t id;
-    uint8_t generation;
+    uint8_t priority;
+    uint8_t pinned;
 
     struct equeue_event *next;
     struct equeue_event *sibling;
     struct equeue_event **ref;
 
     unsigned target;
+    unsigned seq;
     int period;
     void (*dtor)(void *);
 
@@ -57,20 +99,42 @@ struct equeue_event {
 // Event queue structure
 typedef struct equeue {
     struct equeue_event *queue;
-    unsigned tick;
+    struct equeue_ready {
+        struct equeue_event *head;
+        struct equeue_event **tail;
+    } ready[EQUEUE_PRIORITIES];
+    unsigned seq;
     unsigned breaks;
-    uint8_t generation;
 
     unsigned char *buffer;
     unsigned npw2;
     void *allocated;
 
     struct equeue_event *chunks;
+#if EQUEUE_SIZE_CLASSES > 0
+    struct equeue_event *classes[EQUEUE_SIZE_CLASSES];
+#endif
     struct equeue_slab {
         size_t size;
         unsigned char *data;
     } slab;
 
+#if EQUEUE_IRQ_STASH > 0
+    struct equeue_stash {
+        struct equeue_event *volatile events[EQUEUE_IRQ_STASH];
+        volatile unsigned head;
+        volatile unsigned tail;
+        unsigned cap;
+    } stash;
+#endif
+
+    struct equeue_mem_stats {
+        size_t current_size;
+        size_t max_size;
+        unsigned alloc_cnt;
+        unsigned alloc_fail_cnt;
+    } stats;
+
     struct equeue_background {
         bool active;
         void (*update)(void *timer, int ms);
@@ -82,6 +146,19 @@ typedef struct equeue {
     equeue_mutex_t memlock;
 } equeue_t;
 
+// Event queue pool structure
+typedef struct equeue_pool {
+    struct equeue_pool_worker {
+        equeue_t queue;
+        volatile bool idle;
+    } *workers;
+    unsigned count;
+    unsigned next;
+
+    unsigned char *buffer;
+    size_t size;
+} equeue_pool_t;
+
 
 // Queue lifetime operations
 //
@@ -104,6 +181,10 @@ void equeue_destroy(equeue_t *queue);
 // When called with a finite timeout, the equeue_dispatch function is
 // guaranteed to terminate. When called with a timeout of 0, the
 // equeue_dispatch does not wait and is irq safe.
+//
+// Events that are ready are dispatched in order of priority, then in order
+// of their target time, with events sharing a target dispatched in the
+// order they were posted.
 void equeue_dispatch(equeue_t *queue, int ms);
 
 // Break out of a running event loop
@@ -151,13 +232,39 @@ int equeue_call_every(equeue_t *queue, int ms, void (*cb)(void *), void *data);
 void *equeue_alloc(equeue_t *queue, size_t size);
 void equeue_dealloc(equeue_t *queue, void *event);
 
+// Allocate memory for events without locking
+//
+// The equeue_alloc_irq function allocates an event like equeue_alloc, but
+// first tries to take a chunk from the queue's interrupt stash (see
+// EQUEUE_IRQ_STASH) without locking the queue's memory. The stash is
+// refilled as events of EQUEUE_EVENT_SIZE are deallocated, and
+// equeue_alloc_irq falls back to equeue_alloc if the stash is empty or the
+// event does not fit.
+//
+// The stash has a single lock-free consumer, so equeue_alloc_irq must only
+// be called from one context, and that context must not run while another
+// holds the queue's lock. A single interrupt handler satisfies this where
+// the platform mutex is a critical section, as on mbed.
+void *equeue_alloc_irq(equeue_t *queue, size_t size);
+
+// Memory statistics
+//
+// The equeue_mem_stats function reports the bytes of event memory in use
+// and its high-water mark, the number of chunks in use, and the number of
+// failed allocations. Chunks reserved in the interrupt stash count as in
+// use.
+void equeue_mem_stats(equeue_t *queue, struct equeue_mem_stats *stats);
+
 // Configure an allocated event
 //
-// equeue_event_delay  - Millisecond delay before dispatching an event
-// equeue_event_period - Millisecond period for repeating dispatching an event
-// equeue_event_dtor   - Destructor to run when the event is deallocated
+// equeue_event_delay    - Millisecond delay before dispatching an event
+// equeue_event_period   - Millisecond period for repeating dispatching an event
+// equeue_event_priority - Priority of an event over other ready events,
+//                         from 0 (default) to EQUEUE_PRIORITIES-1
+// equeue_event_dtor     - Destructor to run when the event is deallocated
 void equeue_event_delay(void *event, int ms);
 void equeue_event_period(void *event, int ms);
+void equeue_event_priority(void *event, int priority);
 void equeue_event_dtor(void *event, void (*dtor)(void *));
 
 // Post an event onto the event queue
@@ -214,6 +321,81 @@ void equeue_background(equeue_t *queue,
 void equeue_chain(equeue_t *queue, equeue_t *target);
 
 
+// Event queue pool lifetime operations
+//
+// Creates and destroys a pool of event queues, one per worker. The pool
+// allocates a buffer of the specified size per worker with malloc.
+//
+// Ids returned by the pool encode the worker, so each buffer must be small
+// enough that an id of its queue multiplied by the count still fits in an
+// int.
+//
+// If the pool creation fails, including when count*size does not fit in a
+// size_t, equeue_pool_create returns a negative, platform-specific error
+// code and leaves an empty pool, which allocates no events and may still
+// be destroyed.
+int equeue_pool_create(equeue_pool_t *pool, unsigned count, size_t size);
+void equeue_pool_destroy(equeue_pool_t *pool);
+
+// Dispatch events on a pool worker
+//
+// Executes events on behalf of the specified worker, from 0 to count-1,
+// until the specified milliseconds have passed. Each worker must be
+// dispatched by its own thread. If ms is negative, equeue_pool_dispatch
+// will dispatch events indefinitely or until equeue_pool_break is called.
+//
+// A worker runs events from its own queue in the same order as
+// equeue_dispatch. When its queue has no ready events, it steals the most
+// recently posted ready event from another worker's queue instead.
+void equeue_pool_dispatch(equeue_pool_t *pool, unsigned worker, int ms);
+
+// Break out of the pool's event loops
+//
+// Forces the dispatch loop of every worker to terminate.
+void equeue_pool_break(equeue_pool_t *pool);
+
+// Allocate memory for pool events
+//
+// The equeue_pool_alloc function allocates an event from one of the pool's
+// queues. The event can be configured with the equeue_event functions and
+// must be posted with equeue_pool_post or freed with equeue_pool_dealloc.
+//
+// If strand is negative, the event may run on any worker. Otherwise the
+// event is pinned to the worker selected by strand, and events in the same
+// strand never run concurrently and run in the order they are posted.
+//
+// Both equeue_pool_alloc and equeue_pool_dealloc are irq safe.
+void *equeue_pool_alloc(equeue_pool_t *pool, int strand, size_t size);
+void equeue_pool_dealloc(equeue_pool_t *pool, void *event);
+
+// Post an event onto the pool
+//
+// The equeue_pool_post function takes a callback and a pointer to an event
+// allocated by equeue_pool_alloc, and wakes an idle worker if the event's
+// own worker is busy.
+//
+// The equeue_pool_post function is irq safe. The return value is a unique id
+// that represents the posted event and can be passed to equeue_pool_cancel.
+int equeue_pool_post(equeue_pool_t *pool, void (*cb)(void *), void *event);
+
+// Cancel an in-flight pool event
+//
+// Attempts to cancel an event referenced by the unique id returned from
+// equeue_pool_post or one of the equeue_pool_call functions, with the same
+// guarantees as equeue_cancel.
+void equeue_pool_cancel(equeue_pool_t *pool, int id);
+
+// Simple pool calls
+//
+// Post a callback that may run on any worker of the pool, see equeue_call.
+int equeue_pool_call(equeue_pool_t *pool,
+        void (*cb)(void *), void *data);
+int equeue_pool_call_in(equeue_pool_t *pool, int ms,
+        void (*cb)(void *), void *data);
+int equeue_pool_call_every(equeue_pool_t *pool, int ms,
+        void (*cb)(void *), void *data);
+
+
 #ifdef __cplusplus
 }
 #endif
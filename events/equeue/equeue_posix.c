@@ -87,9 +87,12 @@ bool equeue_sema_wait(equeue_sema_t *s, int ms) {
             struct timeval tv;
             gettimeofday(&tv, 0);
 
+            // tv_nsec must stay below a second, or pthread_cond_timedwait
+            // fails immediately and dispatch spins until the deadline
+            long nsec = (ms%1000)*1000000L + tv.tv_usec*1000L;
             struct timespec ts = {
-                .tv_sec = ms/1000 + tv.tv_sec,
-                .tv_nsec = ms*1000000 + tv.tv_usec*1000,
+                .tv_sec = ms/1000 + tv.tv_sec + nsec/1000000000L,
+                .tv_nsec = nsec%1000000000L,
             };
 
             pthread_cond_timedwait(&s->cond, &s->mutex, &ts);
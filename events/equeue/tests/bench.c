@@ -0,0 +1,195 @@
+/*
+ * Throughput benchmark for event queue pools
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "equeue.h"
+#include <unistd.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <time.h>
+#include <pthread.h>
+
+
+// Benchmark setup
+#define BENCH_EVENTS 20000
+#define BENCH_SPIN 2000
+#define BENCH_SLEEP 50
+#define BENCH_MAX_THREADS 8
+
+static volatile int bench_count;
+static pthread_mutex_t bench_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t bench_done = PTHREAD_COND_INITIALIZER;
+
+static uint64_t bench_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+
+static void bench_finish(void) {
+    if (__sync_add_and_fetch(&bench_count, 1) == BENCH_EVENTS) {
+        pthread_mutex_lock(&bench_lock);
+        pthread_cond_signal(&bench_done);
+        pthread_mutex_unlock(&bench_lock);
+    }
+}
+
+static void bench_wait(void) {
+    pthread_mutex_lock(&bench_lock);
+    while (bench_count < BENCH_EVENTS) {
+        pthread_cond_wait(&bench_done, &bench_lock);
+    }
+    pthread_mutex_unlock(&bench_lock);
+}
+
+
+// Workloads, the data pointer carries the cost of each event
+static void spin_func(void *p) {
+    for (volatile uintptr_t i = 0; i < (uintptr_t)p; i++);
+    bench_finish();
+}
+
+static void sleep_func(void *p) {
+    usleep((uintptr_t)p);
+    bench_finish();
+}
+
+struct bench_workload {
+    const char *name;
+    void (*cb)(void *);
+    uintptr_t (*cost)(int i, unsigned threads);
+};
+
+// every event costs the same
+static uintptr_t uniform_spin(int i, unsigned threads) {
+    return BENCH_SPIN;
+}
+
+// events are spread round-robin, so without stealing the first worker
+// gets all of the heavy events
+static uintptr_t skewed_spin(int i, unsigned threads) {
+    return (i % BENCH_MAX_THREADS == 0) ? 4*BENCH_SPIN : BENCH_SPIN/2;
+}
+
+// events block, as if waiting on io
+static uintptr_t uniform_sleep(int i, unsigned threads) {
+    return BENCH_SLEEP;
+}
+
+static const struct bench_workload bench_workloads[] = {
+    {"spin", spin_func, uniform_spin},
+    {"skewed_spin", spin_func, skewed_spin},
+    {"sleep", sleep_func, uniform_sleep},
+};
+
+
+// Single queue baseline
+static void *queue_thread(void *p) {
+    equeue_dispatch((equeue_t *)p, -1);
+    return 0;
+}
+
+static uint64_t queue_bench(const struct bench_workload *w) {
+    equeue_t q;
+    int err = equeue_create(&q, BENCH_EVENTS*EQUEUE_EVENT_SIZE);
+    if (err) {
+        exit(1);
+    }
+
+    pthread_t thread;
+    pthread_create(&thread, 0, queue_thread, &q);
+
+    bench_count = 0;
+    uint64_t start = bench_time();
+    for (int i = 0; i < BENCH_EVENTS; i++) {
+        equeue_call(&q, w->cb, (void *)w->cost(i, 1));
+    }
+    bench_wait();
+    uint64_t time = bench_time() - start;
+
+    equeue_break(&q);
+    pthread_join(thread, 0);
+    equeue_destroy(&q);
+    return time;
+}
+
+
+// Pool with a thread per worker
+struct pool_thread {
+    pthread_t thread;
+    equeue_pool_t *p;
+    unsigned worker;
+};
+
+static void *pool_thread(void *p) {
+    struct pool_thread *t = (struct pool_thread *)p;
+    equeue_pool_dispatch(t->p, t->worker, -1);
+    return 0;
+}
+
+static uint64_t pool_bench(const struct bench_workload *w, unsigned threads) {
+    equeue_pool_t p;
+    int err = equeue_pool_create(&p, threads, BENCH_EVENTS*EQUEUE_EVENT_SIZE);
+    if (err) {
+        exit(1);
+    }
+
+    struct pool_thread t[BENCH_MAX_THREADS];
+    for (unsigned i = 0; i < threads; i++) {
+        t[i].p = &p;
+        t[i].worker = i;
+        pthread_create(&t[i].thread, 0, pool_thread, &t[i]);
+    }
+
+    bench_count = 0;
+    uint64_t start = bench_time();
+    for (int i = 0; i < BENCH_EVENTS; i++) {
+        equeue_pool_call(&p, w->cb, (void *)w->cost(i, threads));
+    }
+    bench_wait();
+    uint64_t time = bench_time() - start;
+
+    equeue_pool_break(&p);
+    for (unsigned i = 0; i < threads; i++) {
+        pthread_join(t[i].thread, 0);
+    }
+    equeue_pool_destroy(&p);
+    return time;
+}
+
+
+int main() {
+    printf("beginning benchmark, %d events per run, %ld cpus...\n",
+            BENCH_EVENTS, sysconf(_SC_NPROCESSORS_ONLN));
+
+    for (unsigned i = 0; i < sizeof(bench_workloads)/sizeof(bench_workloads[0]); i++) {
+        const struct bench_workload *w = &bench_workloads[i];
+
+        uint64_t base = queue_bench(w);
+        printf("%s, equeue: %"PRIu64" events/s\n", w->name,
+                (uint64_t)BENCH_EVENTS*1000000000 / base);
+
+        for (unsigned threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2) {
+            uint64_t time = pool_bench(w, threads);
+            printf("%s, pool of %u: %"PRIu64" events/s (x%.2f)\n",
+                    w->name, threads,
+                    (uint64_t)BENCH_EVENTS*1000000000 / time,
+                    (double)base / time);
+        }
+    }
+
+    printf("done!\n");
+}
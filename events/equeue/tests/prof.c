@@ -150,6 +150,21 @@ void equeue_alloc_prof(void) {
     equeue_destroy(&q);
 }
 
+void equeue_alloc_irq_prof(void) {
+    struct equeue q;
+    equeue_create(&q, 32*EQUEUE_EVENT_SIZE);
+
+    prof_loop() {
+        prof_start();
+        void *e = equeue_alloc_irq(&q, 2*sizeof(void*));
+        prof_stop();
+
+        equeue_dealloc(&q, e);
+    }
+
+    equeue_destroy(&q);
+}
+
 void equeue_alloc_many_prof(int count) {
     struct equeue q;
     equeue_create(&q, count*EQUEUE_EVENT_SIZE);
@@ -253,6 +268,28 @@ void equeue_post_future_many_prof(int count) {
     equeue_destroy(&q);
 }
 
+void equeue_post_timed_many_prof(int count) {
+    struct equeue q;
+    equeue_create(&q, count*EQUEUE_EVENT_SIZE);
+
+    for (int i = 0; i < count-1; i++) {
+        equeue_call_in(&q, 1000 + (i*7919) % count, no_func, 0);
+    }
+
+    prof_loop() {
+        void *e = equeue_alloc(&q, 0);
+        equeue_event_delay(e, 1000 + count/2);
+
+        prof_start();
+        int id = equeue_post(&q, no_func, e);
+        prof_stop();
+
+        equeue_cancel(&q, id);
+    }
+
+    equeue_destroy(&q);
+}
+
 void equeue_dispatch_prof(void) {
     struct equeue q;
     equeue_create(&q, EQUEUE_EVENT_SIZE);
@@ -319,6 +356,48 @@ void equeue_cancel_many_prof(int count) {
     equeue_destroy(&q);
 }
 
+void equeue_dispatch_timed_many_prof(int count) {
+    struct equeue q;
+    equeue_create(&q, count*EQUEUE_EVENT_SIZE);
+
+    for (int i = 0; i < count-1; i++) {
+        equeue_call_in(&q, 1000 + (i*7919) % count, no_func, 0);
+    }
+
+    prof_loop() {
+        void *e = equeue_alloc(&q, 0);
+        equeue_event_period(e, 1000 + count/2);
+        int id = equeue_post(&q, no_func, e);
+
+        prof_start();
+        equeue_dispatch(&q, 0);
+        prof_stop();
+
+        equeue_cancel(&q, id);
+    }
+
+    equeue_destroy(&q);
+}
+
+void equeue_cancel_timed_many_prof(int count) {
+    struct equeue q;
+    equeue_create(&q, count*EQUEUE_EVENT_SIZE);
+
+    for (int i = 0; i < count-1; i++) {
+        equeue_call_in(&q, 1000 + (i*7919) % count, no_func, 0);
+    }
+
+    prof_loop() {
+        int id = equeue_call_in(&q, 1000 + count/2, no_func, 0);
+
+        prof_start();
+        equeue_cancel(&q, id);
+        prof_stop();
+    }
+
+    equeue_destroy(&q);
+}
+
 void equeue_alloc_size_prof(void) {
     size_t size = 32*EQUEUE_EVENT_SIZE;
 
@@ -388,6 +467,7 @@ int main() {
 
     prof_measure(equeue_tick_prof);
     prof_measure(equeue_alloc_prof);
+    prof_measure(equeue_alloc_irq_prof);
     prof_measure(equeue_post_prof);
     prof_measure(equeue_post_future_prof);
     prof_measure(equeue_dispatch_prof);
@@ -399,6 +479,13 @@ int main() {
     prof_measure(equeue_dispatch_many_prof, 100);
     prof_measure(equeue_cancel_many_prof, 100);
 
+    prof_measure(equeue_post_timed_many_prof, 1000);
+    prof_measure(equeue_post_timed_many_prof, 10000);
+    prof_measure(equeue_dispatch_timed_many_prof, 1000);
+    prof_measure(equeue_dispatch_timed_many_prof, 10000);
+    prof_measure(equeue_cancel_timed_many_prof, 1000);
+    prof_measure(equeue_cancel_timed_many_prof, 10000);
+
     prof_measure(equeue_alloc_size_prof);
     prof_measure(equeue_alloc_many_size_prof, 1000);
     prof_measure(equeue_alloc_fragmented_size_prof, 1000);
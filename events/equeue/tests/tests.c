@@ -119,6 +119,17 @@ void cancel_func(void *p) {
     equeue_cancel(cancel->q, cancel->id);
 }
 
+struct order {
+    int *log;
+    int *count;
+    int value;
+};
+
+void order_func(void *p) {
+    struct order *order = (struct order *)p;
+    order->log[(*order->count)++] = order->value;
+}
+
 struct nest {
     equeue_t *q;
     void (*cb)(void *);
@@ -269,6 +280,92 @@ void allocation_failure_test(void) {
     equeue_destroy(&q);
 }
 
+void mem_stats_test(void) {
+    equeue_t q;
+    int err = equeue_create(&q, 4*EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+
+    struct equeue_mem_stats stats;
+    equeue_mem_stats(&q, &stats);
+    test_assert(stats.current_size == 0);
+    test_assert(stats.alloc_cnt == 0);
+
+    void *es[4];
+    for (int i = 0; i < 4; i++) {
+        es[i] = equeue_alloc(&q, 2*sizeof(void*));
+        test_assert(es[i]);
+    }
+
+    test_assert(!equeue_alloc(&q, 2*sizeof(void*)));
+
+    equeue_mem_stats(&q, &stats);
+    test_assert(stats.current_size == 4*EQUEUE_EVENT_SIZE);
+    test_assert(stats.max_size == 4*EQUEUE_EVENT_SIZE);
+    test_assert(stats.alloc_cnt == 4);
+    test_assert(stats.alloc_fail_cnt == 1);
+
+    for (int i = 0; i < 4; i++) {
+        equeue_dealloc(&q, es[i]);
+    }
+
+    // chunks held by the interrupt stash stay accounted for, the stash
+    // holds at most half of the chunks
+    equeue_mem_stats(&q, &stats);
+    test_assert(stats.alloc_cnt ==
+            (EQUEUE_IRQ_STASH < 2 ? EQUEUE_IRQ_STASH : 2));
+    test_assert(stats.max_size == 4*EQUEUE_EVENT_SIZE);
+
+    equeue_destroy(&q);
+}
+
+void alloc_reuse_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, 4*EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+
+    // every chunk must be reusable, including chunks parked in the
+    // interrupt stash
+    void *es[4];
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < 4; j++) {
+            es[j] = (i % 2 && j % 2) ?
+                    equeue_alloc_irq(&q, 2*sizeof(void*)) :
+                    equeue_alloc(&q, 2*sizeof(void*));
+            test_assert(es[j]);
+        }
+
+        for (int j = 0; j < 4; j++) {
+            equeue_dealloc(&q, es[j]);
+        }
+    }
+
+    equeue_destroy(&q);
+}
+
+void alloc_irq_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, N*EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+
+    int touched = 0;
+    for (int i = 0; i < 3*N; i++) {
+        int **e = equeue_alloc_irq(&q, sizeof(int*));
+        test_assert(e);
+
+        *e = &touched;
+        int id = equeue_post(&q, indirect_func, e);
+        test_assert(id);
+
+        if (i % N == N-1) {
+            equeue_dispatch(&q, 0);
+        }
+    }
+
+    test_assert(touched == 3*N);
+
+    equeue_destroy(&q);
+}
+
 void cancel_test(int N) {
     equeue_t q;
     int err = equeue_create(&q, 2048);
@@ -391,6 +488,108 @@ void break_test(void) {
     equeue_destroy(&q);
 }
 
+void cancel_timed_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, N*EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+
+    int touched = 0;
+    int *ids = malloc(N*sizeof(int));
+
+    for (int i = 0; i < N; i++) {
+        ids[i] = equeue_call_in(&q, 1 + (i*7) % 13, simple_func, &touched);
+        test_assert(ids[i]);
+    }
+
+    // cancel every other event from the middle of the heap
+    for (int i = 0; i < N; i += 2) {
+        equeue_cancel(&q, ids[i]);
+    }
+
+    free(ids);
+
+    equeue_dispatch(&q, 20);
+    test_assert(touched == N/2);
+
+    equeue_destroy(&q);
+}
+
+void order_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, 2*N*(EQUEUE_EVENT_SIZE+sizeof(struct order)));
+    test_assert(!err);
+
+    int *log = malloc(N*sizeof(int));
+    int count = 0;
+
+    // events are posted with decreasing delays, in batches sharing a target
+    for (int i = 0; i < N; i++) {
+        struct order *order = equeue_alloc(&q, sizeof(struct order));
+        test_assert(order);
+
+        order->log = log;
+        order->count = &count;
+        order->value = i;
+        equeue_event_delay(order, 10 * (4 - (i*4)/N));
+
+        int id = equeue_post(&q, order_func, order);
+        test_assert(id);
+    }
+
+    equeue_dispatch(&q, 50);
+    test_assert(count == N);
+
+    // later targets dispatch last, equal targets in the order posted
+    for (int i = 1; i < N; i++) {
+        int a = log[i-1];
+        int b = log[i];
+        test_assert((a*4)/N > (b*4)/N || ((a*4)/N == (b*4)/N && a < b));
+    }
+
+    free(log);
+    equeue_destroy(&q);
+}
+
+void priority_test(int N) {
+    equeue_t q;
+    int err = equeue_create(&q, 2*N*(EQUEUE_EVENT_SIZE+sizeof(struct order)));
+    test_assert(!err);
+
+    int *log = malloc(N*sizeof(int));
+    int count = 0;
+
+    for (int i = 0; i < N; i++) {
+        struct order *order = equeue_alloc(&q, sizeof(struct order));
+        test_assert(order);
+
+        order->log = log;
+        order->count = &count;
+        order->value = i;
+        equeue_event_delay(order, (i % 2) ? 0 : 5);
+        equeue_event_priority(order, i % EQUEUE_PRIORITIES);
+
+        int id = equeue_post(&q, order_func, order);
+        test_assert(id);
+    }
+
+    usleep(10000);
+    equeue_dispatch(&q, 0);
+    test_assert(count == N);
+
+    // higher priorities dispatch first, equal priorities in target order
+    for (int i = 1; i < N; i++) {
+        int a = log[i-1];
+        int b = log[i];
+        int pa = a % EQUEUE_PRIORITIES;
+        int pb = b % EQUEUE_PRIORITIES;
+        test_assert(pa > pb || (pa == pb &&
+                ((a % 2) > (b % 2) || ((a % 2) == (b % 2) && a < b))));
+    }
+
+    free(log);
+    equeue_destroy(&q);
+}
+
 void period_test(void) {
     equeue_t q;
     int err = equeue_create(&q, 2048);
@@ -491,6 +690,215 @@ void multithread_test(void) {
     equeue_destroy(&q);
 }
 
+// Event queue pool tests
+void atomic_func(void *p) {
+    __sync_fetch_and_add((int *)p, 1);
+}
+
+struct pool_thread {
+    pthread_t thread;
+    equeue_pool_t *p;
+    unsigned worker;
+};
+
+void *pool_thread_dispatch(void *p) {
+    struct pool_thread *t = (struct pool_thread *)p;
+    equeue_pool_dispatch(t->p, t->worker, -1);
+    return 0;
+}
+
+void pool_start(equeue_pool_t *p, struct pool_thread *threads) {
+    for (unsigned i = 0; i < p->count; i++) {
+        threads[i].p = p;
+        threads[i].worker = i;
+        int err = pthread_create(&threads[i].thread, 0,
+                pool_thread_dispatch, &threads[i]);
+        test_assert(!err);
+    }
+}
+
+void pool_stop(equeue_pool_t *p, struct pool_thread *threads) {
+    equeue_pool_break(p);
+    for (unsigned i = 0; i < p->count; i++) {
+        int err = pthread_join(threads[i].thread, 0);
+        test_assert(!err);
+    }
+}
+
+// wait up to a second for a counter to reach a value
+bool pool_wait(volatile int *count, int n) {
+    for (int i = 0; i < 1000 && *count < n; i++) {
+        usleep(1000);
+    }
+
+    return *count == n;
+}
+
+void pool_failure_test(void) {
+    equeue_pool_t p;
+    int err = equeue_pool_create(&p, 2, (size_t)-1 / 2);
+    test_assert(err < 0);
+
+    // a failed pool is empty and can still be destroyed
+    test_assert(!equeue_pool_alloc(&p, -1, sizeof(int)));
+    test_assert(!equeue_pool_alloc(&p, 3, sizeof(int)));
+    test_assert(!equeue_pool_call(&p, simple_func, 0));
+    equeue_pool_cancel(&p, 1);
+    equeue_pool_destroy(&p);
+
+    // the total size of the buffers must not overflow, here to zero
+    err = equeue_pool_create(&p, 4, (size_t)-1 / 4 + 1);
+    test_assert(err < 0);
+    test_assert(!equeue_pool_alloc(&p, -1, sizeof(int)));
+    equeue_pool_destroy(&p);
+}
+
+void pool_call_test(int N) {
+    equeue_pool_t p;
+    int err = equeue_pool_create(&p, 4, N*EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+
+    struct pool_thread threads[4];
+    pool_start(&p, threads);
+
+    volatile int touched = 0;
+    for (int i = 0; i < N; i++) {
+        int id = equeue_pool_call(&p, atomic_func, (void *)&touched);
+        test_assert(id);
+    }
+
+    int every = 0;
+    int id = equeue_pool_call_every(&p, 1, atomic_func, &every);
+    test_assert(id);
+
+    test_assert(pool_wait(&touched, N));
+    usleep(10000);
+    test_assert(every > 1);
+
+    pool_stop(&p, threads);
+    equeue_pool_destroy(&p);
+}
+
+void pool_cancel_test(int N) {
+    equeue_pool_t p;
+    int err = equeue_pool_create(&p, 2, N*EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+
+    int touched = 0;
+    int ids[N];
+    for (int i = 0; i < N; i++) {
+        ids[i] = equeue_pool_call_in(&p, 10, simple_func, &touched);
+        test_assert(ids[i]);
+    }
+
+    for (int i = 0; i < N; i += 2) {
+        equeue_pool_cancel(&p, ids[i]);
+    }
+
+    struct pool_thread threads[2];
+    pool_start(&p, threads);
+    usleep(20000);
+    pool_stop(&p, threads);
+
+    test_assert(touched == N/2);
+
+    equeue_pool_destroy(&p);
+}
+
+struct strand {
+    volatile bool busy;
+    volatile int count;
+    int order[64];
+};
+
+struct strand_event {
+    struct strand *strand;
+    int i;
+};
+
+void strand_func(void *p) {
+    struct strand_event *e = (struct strand_event *)p;
+    test_assert(!e->strand->busy);
+    e->strand->busy = true;
+    usleep(100);
+    e->strand->order[e->strand->count] = e->i;
+    e->strand->busy = false;
+    e->strand->count++;
+}
+
+void pool_strand_test(int N) {
+    equeue_pool_t p;
+    int err = equeue_pool_create(&p, 4,
+            2*N*(EQUEUE_EVENT_SIZE+sizeof(struct strand_event)));
+    test_assert(!err);
+
+    struct pool_thread threads[4];
+    pool_start(&p, threads);
+
+    struct strand strand = {0};
+    volatile int touched = 0;
+    for (int i = 0; i < N; i++) {
+        struct strand_event *e = equeue_pool_alloc(&p, 3,
+                sizeof(struct strand_event));
+        test_assert(e);
+        e->strand = &strand;
+        e->i = i;
+        int id = equeue_pool_post(&p, strand_func, e);
+        test_assert(id);
+
+        id = equeue_pool_call(&p, atomic_func, (void *)&touched);
+        test_assert(id);
+    }
+
+    test_assert(pool_wait(&strand.count, N));
+    test_assert(pool_wait(&touched, N));
+    for (int i = 0; i < N; i++) {
+        test_assert(strand.order[i] == i);
+    }
+
+    pool_stop(&p, threads);
+    equeue_pool_destroy(&p);
+}
+
+struct blocker {
+    volatile int *touched;
+    int n;
+    bool stolen;
+};
+
+void blocker_func(void *p) {
+    struct blocker *b = (struct blocker *)p;
+    b->stolen = pool_wait(b->touched, b->n);
+}
+
+void pool_steal_test(int N) {
+    equeue_pool_t p;
+    int err = equeue_pool_create(&p, 2, 2*N*EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+
+    struct pool_thread threads[2];
+    pool_start(&p, threads);
+
+    // block the first worker, its share of the events must be stolen by
+    // the second worker
+    volatile int touched = 0;
+    struct blocker b = {&touched, N, false};
+    int id = equeue_pool_call(&p, blocker_func, &b);
+    test_assert(id);
+    usleep(1000);
+
+    for (int i = 0; i < N; i++) {
+        id = equeue_pool_call(&p, atomic_func, (void *)&touched);
+        test_assert(id);
+    }
+
+    test_assert(pool_wait(&touched, N));
+    pool_stop(&p, threads);
+    test_assert(b.stolen);
+
+    equeue_pool_destroy(&p);
+}
+
 void background_func(void *p, int ms) {
     *(unsigned *)p = ms;
 }
@@ -661,17 +1069,28 @@ int main() {
     test_run(simple_post_test);
     test_run(destructor_test);
     test_run(allocation_failure_test);
+    test_run(mem_stats_test);
+    test_run(alloc_irq_test, 20);
+    test_run(alloc_reuse_test, 100);
     test_run(cancel_test, 20);
     test_run(cancel_inflight_test);
     test_run(cancel_unnecessarily_test);
     test_run(loop_protect_test);
     test_run(break_test);
+    test_run(cancel_timed_test, 20);
+    test_run(order_test, 20);
+    test_run(priority_test, 20);
     test_run(period_test);
     test_run(nested_test);
     test_run(sloth_test);
     test_run(background_test);
     test_run(chain_test);
     test_run(multithread_test);
+    test_run(pool_failure_test);
+    test_run(pool_call_test, 20);
+    test_run(pool_cancel_test, 20);
+    test_run(pool_strand_test, 20);
+    test_run(pool_steal_test, 20);
     test_run(simple_barrage_test, 20);
     test_run(fragmenting_barrage_test, 20);
     test_run(multithreaded_barrage_test, 20);
@@ -27,6 +27,7 @@
 
 #include "events/EventQueue.h"
 #include "events/Event.h"
+#include "events/EventQueuePool.h"
 
 using namespace events;
 
@@ -227,6 +227,32 @@ typedef struct sn_coap_hdr_ {
     sn_coap_options_list_s *options_list_ptr;   /**< Must be set to NULL if not used */
 } sn_coap_hdr_s;
 
+/**
+ * \brief Option value as a view into Packet data
+ */
+typedef struct sn_coap_option_view_ {
+    uint16_t                number;             /**< Option number, see sn_coap_option_numbers_e */
+    uint16_t                offset;             /**< Offset of Option value from start of Packet data */
+    uint16_t                len;                /**< Length of Option value, 0 for empty Option */
+} sn_coap_option_view_s;
+
+/**
+ * \brief CoAP message parsed into a caller provided arena
+ *
+ * Pointers in hdr and options refer either to the parsed Packet data or to
+ * the arena, never to heap, so the message must not be released with
+ * sn_coap_parser_release_allocated_coap_msg_mem().
+ */
+typedef struct sn_coap_msg_view_ {
+    sn_coap_hdr_s           hdr;                /**< Parsed message */
+    sn_coap_options_list_s  options;            /**< Storage for hdr.options_list_ptr */
+
+    uint8_t                *packet_data_ptr;    /**< Parsed Packet data, base of option views */
+    sn_coap_option_view_s  *option_views_ptr;   /**< Every Option of the message in Packet data order */
+    uint16_t                option_count;       /**< Number of option views */
+    uint16_t                arena_used;         /**< Bytes of the arena used by this message */
+} sn_coap_msg_view_s;
+
 /* * * * * * * * * * * * * * * * * * * * * * */
 /* * * * EXTERNAL FUNCTION PROTOTYPES  * * * */
 /* * * * * * * * * * * * * * * * * * * * * * */
@@ -374,6 +400,63 @@ extern sn_coap_hdr_s *sn_coap_parser_alloc_message(struct coap_s *handle);
  */
 extern sn_coap_options_list_s *sn_coap_parser_alloc_options(struct coap_s *handle, sn_coap_hdr_s *coap_msg_ptr);
 
+/**
+ * \fn sn_coap_msg_view_s *sn_coap_parser_view(uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr, void *arena_ptr, uint16_t arena_len)
+ *
+ * \brief Parses CoAP message from given Packet data without allocating memory
+ *
+ *        The message, the option views and joined multi-part options
+ *        (e.g. Uri-Path with several segments) are placed in the given
+ *        arena. Token, single part options and Payload point to Packet data,
+ *        which must therefore outlive the parsed message. Reusing the arena
+ *        discards the previous message.
+ *
+ * \param packet_data_len is length of given Packet data to be parsed to CoAP message
+ *
+ * \param *packet_data_ptr is source for Packet data to be parsed to CoAP message
+ *
+ * \param *coap_version_ptr is destination for parsed CoAP specification version
+ *
+ * \param *arena_ptr is caller provided memory, e.g. a stack buffer
+ *
+ * \param arena_len is length of the arena in bytes
+ *
+ * \return Return value is pointer to parsed CoAP message in the arena, with
+ *         hdr.coap_status set as in sn_coap_parser().\n
+ *         In following failure cases NULL is returned:\n
+ *          -Failure in given pointer (= NULL)\n
+ *          -Arena is too small for the message
+ */
+extern sn_coap_msg_view_s *sn_coap_parser_view(uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr, void *arena_ptr, uint16_t arena_len);
+
+/**
+ * \fn int16_t sn_coap_builder_view(uint8_t *dst_packet_data_ptr, uint16_t dst_packet_data_len, sn_coap_hdr_s *src_coap_msg_ptr, const sn_coap_option_view_s *option_views_ptr, uint16_t option_count, uint8_t *option_data_ptr)
+ *
+ * \brief Builds an outgoing message buffer with options written from option views
+ *
+ *        Header, Token and Payload are taken from the CoAP header structure,
+ *        whose Options are ignored. Every Option is copied from the view's
+ *        value in option data, so options of a parsed message can be echoed
+ *        by passing its option views and Packet data.
+ *
+ * \param *dst_packet_data_ptr is pointer to destination for built CoAP packet
+ *
+ * \param dst_packet_data_len is length of the destination
+ *
+ * \param *src_coap_msg_ptr is pointer to source structure for Header, Token and Payload
+ *
+ * \param *option_views_ptr is pointer to options to be built, in ascending Option number order
+ *
+ * \param option_count is number of option views
+ *
+ * \param *option_data_ptr is base of the option view offsets
+ *
+ * \return Return value is byte count of built Packet data. In failure cases:\n
+ *          -1 = Failure in given CoAP header structure or option views, or destination is too small\n
+ *          -2 = Failure in given pointer (= NULL)
+ */
+extern int16_t sn_coap_builder_view(uint8_t *dst_packet_data_ptr, uint16_t dst_packet_data_len, sn_coap_hdr_s *src_coap_msg_ptr, const sn_coap_option_view_s *option_views_ptr, uint16_t option_count, uint8_t *option_data_ptr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,17 @@ extern "C" {
 
 #include "sn_coap_header.h"
 
+/**
+ * \brief Counters of the duplicate detection and re-sending queues.
+ */
+typedef struct sn_coap_protocol_stats_ {
+    uint32_t duplicates_detected;       /**< Received messages rejected as duplicates */
+    uint32_t duplication_evictions;     /**< Duplication infos dropped to make room before they expired */
+    uint32_t resend_queue_full;         /**< Confirmable messages not queued because re-sending queue was full */
+    uint32_t resends;                   /**< Messages re-sent */
+    uint32_t resend_timeouts;           /**< Messages dropped after all re-sendings were done */
+} sn_coap_protocol_stats_s;
+
 /**
  * \fn struct coap_s *sn_coap_protocol_init(void* (*used_malloc_func_ptr)(uint16_t), void (*used_free_func_ptr)(void*),
         uint8_t (*used_tx_callback_ptr)(sn_nsdl_capab_e , uint8_t *, uint16_t, sn_nsdl_addr_s *),
@@ -143,6 +154,51 @@ extern int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time
  */
 extern int8_t sn_coap_protocol_set_block_size(struct coap_s *handle, uint16_t block_size);
 
+/**
+ * \fn int8_t sn_coap_protocol_set_block_stream(struct coap_s *handle, block_sink, block_source)
+ *
+ * \brief If block transfer is enabled, this function sets callbacks for streaming blockwise payloads
+ *        instead of storing whole payloads to RAM.
+ *
+ *        When the sink is set, every received Block1 request block and Block2 response block is passed to it
+ *        with the block option still in the message, and nothing is stored. The message with the last block is
+ *        returned to the user with status COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED and without payload.
+ *        If the sink fails, a Block1 transfer is answered with 5.00 and a Block2 transfer is not continued; the
+ *        message is returned with status COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED.
+ *
+ *        When the source is set, messages sent with sn_coap_protocol_send_stream() read their blocks from it as
+ *        they are requested by the peer.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param block_sink is called with the received message, its source address, the offset of the block payload
+ *        and the param given to sn_coap_protocol_parse(). Returns 0 when the block was consumed, -1 to abort. NULL to store blocks.
+ * \param block_source is called with the sent message header, its destination address, the offset and length to
+ *        read and the destination buffer. Returns the number of bytes read, negative to abort.
+ * \return  0 = success
+ *          -1 = failure
+ */
+extern int8_t sn_coap_protocol_set_block_stream(struct coap_s *handle,
+        int8_t (*block_sink)(sn_coap_hdr_s *, sn_nsdl_addr_s *, uint32_t, void *),
+        int16_t (*block_source)(sn_coap_hdr_s *, sn_nsdl_addr_s *, uint32_t, uint8_t *, uint16_t, void *));
+
+/**
+ * \fn int8_t sn_coap_protocol_send_stream(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, sn_coap_hdr_s *src_coap_msg_ptr, uint32_t payload_len, void *param)
+ *
+ * \brief Builds and sends a message whose payload is read block by block from the block source, so that only one
+ *        block is held in RAM at a time. The rest of the blocks are sent when the peer asks for them.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param *dst_addr_ptr is pointer to destination address where CoAP message will be sent
+ * \param *src_coap_msg_ptr is pointer to the message to be sent, without payload
+ * \param payload_len is length of the whole payload
+ * \param param void pointer that will be passed to the source and TX callbacks
+ * \return  0 = success
+ *          -1 = failure, e.g. no block source set or reading the first block failed
+ *          -2 = failure when allocating memory
+ */
+extern int8_t sn_coap_protocol_send_stream(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr,
+        sn_coap_hdr_s *src_coap_msg_ptr, uint32_t payload_len, void *param);
+
 /**
  * \fn int8_t sn_coap_protocol_set_duplicate_buffer_size(uint8_t message_count)
  *
@@ -212,6 +268,17 @@ extern void sn_coap_protocol_block_remove(struct coap_s *handle, sn_nsdl_addr_s
  */
 extern int8_t sn_coap_protocol_delete_retransmission(struct coap_s *handle, uint16_t msg_id);
 
+/**
+ * \fn int8_t sn_coap_protocol_get_stats(struct coap_s *handle, sn_coap_protocol_stats_s *stats)
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param *stats Destination for the counters
+ * \return returns 0 when success, -1 for invalid parameter
+ *
+ * \brief Reads the duplicate detection and re-sending counters, which count up from sn_coap_protocol_init().
+ */
+extern int8_t sn_coap_protocol_get_stats(struct coap_s *handle, sn_coap_protocol_stats_s *stats);
+
 #endif /* SN_COAP_PROTOCOL_H_ */
 
 #ifdef __cplusplus
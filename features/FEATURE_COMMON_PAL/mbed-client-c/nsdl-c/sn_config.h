@@ -71,6 +71,51 @@
  */
 #undef SN_COAP_RESENDING_QUEUE_SIZE_BYTES   /* 0  */ // Default re-sending queue size - defines size of the re-sending buffer. Setting this to 0 disables feature
 
+/**
+ * \def SN_COAP_RESENDING_HASH_SIZE
+ *
+ * \brief Sets the number of hash buckets used to match
+ * acknowledgements to messages in the re-sending queue.
+ * Must be a power of two. Default is 8.
+ */
+#undef SN_COAP_RESENDING_HASH_SIZE          /* 8  */
+
+/**
+ * \def SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS
+ *
+ * \brief Sets the largest re-sending queue size in messages
+ * that application can set with sn_coap_protocol_set_retransmission_buffer(),
+ * at most 255. Default is 6.
+ */
+#undef SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS     /* 6 */
+
+/**
+ * \def SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES
+ *
+ * \brief Sets the largest re-sending queue size in bytes
+ * that application can set with sn_coap_protocol_set_retransmission_buffer().
+ * Default is 512.
+ */
+#undef SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES    /* 512 */
+
+/**
+ * \def SN_COAP_DUPLICATION_HASH_SIZE
+ *
+ * \brief Sets the number of hash buckets used to look up
+ * messages stored for duplication detection.
+ * Must be a power of two. Default is 8.
+ */
+#undef SN_COAP_DUPLICATION_HASH_SIZE        /* 8  */
+
+/**
+ * \def SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT
+ *
+ * \brief Sets the largest duplication detection buffer size
+ * that application can set with sn_coap_protocol_set_duplicate_buffer_size(),
+ * at most 255. Default is 6.
+ */
+#undef SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT    /* 6 */
+
 /**
  * \def SN_COAP_MAX_INCOMING_MESSAGE_SIZE
  *
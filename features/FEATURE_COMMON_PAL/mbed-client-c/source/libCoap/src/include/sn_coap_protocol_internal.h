@@ -25,6 +25,7 @@
 #define SN_COAP_PROTOCOL_INTERNAL_H_
 
 #include "ns_list.h"
+#include "sn_coap_protocol.h"
 #include "sn_coap_header_internal.h"
 #include "sn_config.h"
 
@@ -67,10 +68,39 @@ struct sn_coap_hdr_;
 
 /* These parameters sets maximum values application can set with API */
 #define SN_COAP_MAX_ALLOWED_RESENDING_COUNT             6   /**< Maximum allowed count of re-sending */
-#define SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS    6   /**< Maximum allowed number of saved re-sending messages */
+
+#ifdef YOTTA_CFG_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS
+#define SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS YOTTA_CFG_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS
+#elif defined MBED_CONF_MBED_CLIENT_SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS
+#define SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS MBED_CONF_MBED_CLIENT_SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS
+#endif
+
+#ifndef SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS
+#define SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_MSGS    6   /**< Maximum allowed number of saved re-sending messages, at most 255 */
+#endif
+
+#ifdef YOTTA_CFG_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES
+#define SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES YOTTA_CFG_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES
+#elif defined MBED_CONF_MBED_CLIENT_SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES
+#define SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES MBED_CONF_MBED_CLIENT_SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES
+#endif
+
+#ifndef SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES
 #define SN_COAP_MAX_ALLOWED_RESENDING_BUFF_SIZE_BYTES   512 /**< Maximum allowed size of re-sending buffer */
+#endif
+
 #define SN_COAP_MAX_ALLOWED_RESPONSE_TIMEOUT            40  /**< Maximum allowed re-sending timeout */
 
+#ifdef YOTTA_CFG_COAP_RESENDING_HASH_SIZE
+#define SN_COAP_RESENDING_HASH_SIZE YOTTA_CFG_COAP_RESENDING_HASH_SIZE
+#elif defined MBED_CONF_MBED_CLIENT_SN_COAP_RESENDING_HASH_SIZE
+#define SN_COAP_RESENDING_HASH_SIZE MBED_CONF_MBED_CLIENT_SN_COAP_RESENDING_HASH_SIZE
+#endif
+
+#ifndef SN_COAP_RESENDING_HASH_SIZE
+#define SN_COAP_RESENDING_HASH_SIZE                     8   /**< Number of hash buckets for acknowledgement lookup in the re-sending queue, must be 2^x */
+#endif
+
 #define RESPONSE_RANDOM_FACTOR                          1   /**< Resending random factor, value is specified in IETF CoAP specification */
 
 /* * For Message duplication detecting * */
@@ -91,8 +121,27 @@ struct sn_coap_hdr_;
 
 
 
-/* Maximum allowed number of saved messages for duplicate searching */
+/* Maximum allowed number of saved messages for duplicate searching, at most 255 */
+#ifdef YOTTA_CFG_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT
+#define SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT YOTTA_CFG_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT
+#elif defined MBED_CONF_MBED_CLIENT_SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT
+#define SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT MBED_CONF_MBED_CLIENT_SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT
+#endif
+
+#ifndef SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT
 #define SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT   6
+#endif
+
+/* Number of hash buckets for duplication detection lookup, must be 2^x */
+#ifdef YOTTA_CFG_COAP_DUPLICATION_HASH_SIZE
+#define SN_COAP_DUPLICATION_HASH_SIZE YOTTA_CFG_COAP_DUPLICATION_HASH_SIZE
+#elif defined MBED_CONF_MBED_CLIENT_SN_COAP_DUPLICATION_HASH_SIZE
+#define SN_COAP_DUPLICATION_HASH_SIZE MBED_CONF_MBED_CLIENT_SN_COAP_DUPLICATION_HASH_SIZE
+#endif
+
+#ifndef SN_COAP_DUPLICATION_HASH_SIZE
+#define SN_COAP_DUPLICATION_HASH_SIZE               8
+#endif
 
 /* Maximum time in seconds of messages to be stored for duplication detection */
 #define SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED    60 /* RESPONSE_TIMEOUT * RESPONSE_RANDOM_FACTOR * (2 ^ MAX_RETRANSMIT - 1) + the expected maximum round trip time */
@@ -142,13 +191,15 @@ int8_t prepare_blockwise_message(struct coap_s *handle, struct sn_coap_hdr_ *coa
 typedef struct coap_send_msg_ {
     uint8_t             resending_counter;  /* Tells how many times message is still tried to resend */
     uint32_t            resending_time;     /* Tells next resending time */
+    uint16_t            msg_id;             /* Message ID of the stored packet */
 
     sn_nsdl_transmit_s *send_msg_ptr;
 
     struct coap_s       *coap;              /* CoAP library handle */
     void                *param;             /* Extra parameter that will be passed to TX/RX callback functions */
 
-    ns_list_link_t      link;
+    struct coap_send_msg_ *hash_next;       /* Next message in the same hash bucket */
+    ns_list_link_t      link;               /* Linked list is ordered by resending_time */
 } coap_send_msg_s;
 
 typedef NS_LIST_HEAD(coap_send_msg_s, link) coap_send_msg_list_t;
@@ -165,7 +216,8 @@ typedef struct coap_duplication_info_ {
 
     struct coap_s       *coap;  /* CoAP library handle */
 
-    ns_list_link_t     link;
+    struct coap_duplication_info_ *hash_next; /* Next info in the same hash bucket */
+    ns_list_link_t     link;    /* Linked list is ordered by timestamp */
 } coap_duplication_info_s;
 
 typedef NS_LIST_HEAD(coap_duplication_info_s, link) coap_duplication_info_list_t;
@@ -175,6 +227,7 @@ typedef struct coap_blockwise_msg_ {
     uint32_t            timestamp;  /* Tells when Blockwise message is stored to Linked list */
 
     sn_coap_hdr_s       *coap_msg_ptr;
+    uint32_t            stream_len; /* Whole payload length when blocks are read from the block source, else 0 */
     struct coap_s       *coap;      /* CoAP library handle */
 
     ns_list_link_t     link;
@@ -208,23 +261,30 @@ struct coap_s {
 
     #if ENABLE_RESENDINGS /* If Message resending is not used at all, this part of code will not be compiled */
         coap_send_msg_list_t linked_list_resent_msgs; /* Active resending messages are stored to this Linked list */
+        coap_send_msg_s     *hash_resent_msgs[SN_COAP_RESENDING_HASH_SIZE]; /* Same messages hashed by address, port and Message ID */
         uint16_t count_resent_msgs;
+        uint32_t size_resent_msgs; /* Total packet length of active resending messages */
     #endif
 
     #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
         coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list */
+        coap_duplication_info_s      *hash_duplication_msgs[SN_COAP_DUPLICATION_HASH_SIZE]; /* Same messages hashed by address, port and Message ID */
         uint16_t                      count_duplication_msgs;
     #endif
 
+    sn_coap_protocol_stats_s stats;
+
     #if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwise is not used at all, this part of code will not be compiled */
         coap_blockwise_msg_list_t     linked_list_blockwise_sent_msgs; /* Blockwise message to to be sent is stored to this Linked list */
         coap_blockwise_payload_list_t linked_list_blockwise_received_payloads; /* Blockwise payload to to be received is stored to this Linked list */
+        int8_t (*sn_coap_block_sink)(sn_coap_hdr_s *, sn_nsdl_addr_s *, uint32_t, void *); /* If set, received blocks are passed here instead of being stored */
+        int16_t (*sn_coap_block_source)(sn_coap_hdr_s *, sn_nsdl_addr_s *, uint32_t, uint8_t *, uint16_t, void *); /* Reads blocks of streamed messages */
     #endif
 
     uint32_t system_time;    /* System time seconds */
     uint16_t sn_coap_block_data_size;
     uint8_t sn_coap_resending_queue_msgs;
-    uint8_t sn_coap_resending_queue_bytes;
+    uint16_t sn_coap_resending_queue_bytes;
     uint8_t sn_coap_resending_count;
     uint8_t sn_coap_resending_intervall;
     uint8_t sn_coap_duplication_buffer_size;
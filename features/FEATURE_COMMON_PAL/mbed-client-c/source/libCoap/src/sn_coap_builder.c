@@ -49,6 +49,7 @@ static uint16_t sn_coap_builder_options_get_option_part_length_from_whole_option
 static int16_t  sn_coap_builder_options_get_option_part_position(uint16_t query_len, uint8_t *query_ptr, uint8_t query_index, sn_coap_option_numbers_e option);
 static void     sn_coap_builder_payload_build(uint8_t **dst_packet_data_pptr, sn_coap_hdr_s *src_coap_msg_ptr);
 static uint8_t  sn_coap_builder_options_calculate_jump_need(sn_coap_hdr_s *src_coap_msg_ptr/*, uint8_t block_option*/);
+static uint16_t sn_coap_builder_options_calc_view_size(uint16_t option_len, uint16_t option_delta);
 
 sn_coap_hdr_s *sn_coap_build_response(struct coap_s *handle, sn_coap_hdr_s *coap_packet_ptr, uint8_t msg_code)
 {
@@ -142,6 +143,76 @@ int16_t sn_coap_builder_2(uint8_t *dst_packet_data_ptr, sn_coap_hdr_s *src_coap_
     /* * * * Return built Packet data length * * * */
     return (dst_packet_data_ptr - base_packet_data_ptr);
 }
+int16_t sn_coap_builder_view(uint8_t *dst_packet_data_ptr, uint16_t dst_packet_data_len, sn_coap_hdr_s *src_coap_msg_ptr,
+                             const sn_coap_option_view_s *option_views_ptr, uint16_t option_count, uint8_t *option_data_ptr)
+{
+    uint8_t  *base_packet_data_ptr   = dst_packet_data_ptr;
+    uint32_t  dst_byte_count         = COAP_HEADER_LENGTH;
+    uint16_t  previous_option_number = 0;
+    uint16_t  i;
+
+    /* * * * Check given pointers  * * * */
+    if (dst_packet_data_ptr == NULL || src_coap_msg_ptr == NULL || (option_count && (option_views_ptr == NULL || option_data_ptr == NULL))) {
+        return -2;
+    }
+
+    /* Reset message must be empty */
+    if (src_coap_msg_ptr->msg_type == COAP_MSG_TYPE_RESET) {
+        option_count = 0;
+    } else {
+        /* * * * Calculate needed Packet data size, checking option order on the way * * * */
+        dst_byte_count += src_coap_msg_ptr->token_len;
+
+        for (i = 0; i < option_count; i++) {
+            if (option_views_ptr[i].number < previous_option_number) {
+                return -1;
+            }
+            dst_byte_count += sn_coap_builder_options_calc_view_size(option_views_ptr[i].len, option_views_ptr[i].number - previous_option_number);
+            previous_option_number = option_views_ptr[i].number;
+        }
+
+        if (src_coap_msg_ptr->payload_len && src_coap_msg_ptr->payload_ptr != NULL) {
+            dst_byte_count += 1 + src_coap_msg_ptr->payload_len;
+        }
+    }
+
+    if (dst_byte_count > dst_packet_data_len || dst_byte_count > INT16_MAX) {
+        return -1;
+    }
+
+    /* Header building adds fields to zeroed first byte */
+    *dst_packet_data_ptr = 0;
+
+    /* * * * * * * * * * * * * * * * * * */
+    /* * * * Header part building  * * * */
+    /* * * * * * * * * * * * * * * * * * */
+    if (sn_coap_builder_header_build(&dst_packet_data_ptr, src_coap_msg_ptr) != 0) {
+        /* Header building failed */
+        return -1;
+    }
+
+    if (src_coap_msg_ptr->msg_type != COAP_MSG_TYPE_RESET) {
+        /* * * * Token * * * */
+        if (src_coap_msg_ptr->token_len && src_coap_msg_ptr->token_ptr) {
+            memcpy(dst_packet_data_ptr, src_coap_msg_ptr->token_ptr, src_coap_msg_ptr->token_len);
+        }
+        dst_packet_data_ptr += src_coap_msg_ptr->token_len;
+
+        /* * * * Options are written straight from the views * * * */
+        previous_option_number = 0;
+        for (i = 0; i < option_count; i++) {
+            sn_coap_builder_options_build_add_one_option(&dst_packet_data_ptr, option_views_ptr[i].len, option_data_ptr + option_views_ptr[i].offset,
+                    (sn_coap_option_numbers_e)option_views_ptr[i].number, &previous_option_number);
+        }
+
+        /* * * * Payload part building * * * */
+        sn_coap_builder_payload_build(&dst_packet_data_ptr, src_coap_msg_ptr);
+    }
+
+    /* * * * Return built Packet data length * * * */
+    return (dst_packet_data_ptr - base_packet_data_ptr);
+}
+
 uint16_t sn_coap_builder_calc_needed_packet_data_size(sn_coap_hdr_s *src_coap_msg_ptr)
 {
     return sn_coap_builder_calc_needed_packet_data_size_2(src_coap_msg_ptr, SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE);
@@ -1054,6 +1125,34 @@ static int16_t sn_coap_builder_options_get_option_part_position(uint16_t query_l
 }
 
 
+/**
+ * \brief Calculates size of an option written from a view
+ *
+ * \param option_len is Option value length
+ *
+ * \param option_delta is difference to previous Option number
+ *
+ * \return Return value is Option size with header and extensions
+ */
+static uint16_t sn_coap_builder_options_calc_view_size(uint16_t option_len, uint16_t option_delta)
+{
+    uint16_t size = 1 + option_len;
+
+    if (option_delta >= 269) {
+        size += 2;
+    } else if (option_delta > 12) {
+        size += 1;
+    }
+
+    if (option_len >= 269) {
+        size += 2;
+    } else if (option_len > 12) {
+        size += 1;
+    }
+
+    return size;
+}
+
 /**
  * \fn static void sn_coap_builder_payload_build(uint8_t **dst_packet_data_pptr, sn_coap_hdr_s *src_coap_msg_ptr)
  *
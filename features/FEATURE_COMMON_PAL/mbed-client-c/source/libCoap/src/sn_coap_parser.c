@@ -46,6 +46,15 @@ static int8_t   sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pa
 static int8_t   sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len);
 static int16_t  sn_coap_parser_options_count_needed_memory_multiple_option(uint8_t *packet_data_ptr, uint16_t packet_left_len, sn_coap_option_numbers_e option, uint16_t option_number_len);
 static int8_t   sn_coap_parser_payload_parse(uint16_t packet_data_len, uint8_t *packet_data_start_ptr, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr);
+static void     sn_coap_parser_init_options(sn_coap_options_list_s *options_list_ptr);
+static int8_t   sn_coap_parser_options_parse_views(uint8_t **packet_data_pptr, uint8_t *packet_data_start_ptr, uint16_t packet_len, sn_coap_option_view_s *views_ptr, uint16_t max_view_count, uint16_t *view_count_ptr);
+static int8_t   sn_coap_parser_options_parse_extension(uint8_t **option_pptr, uint8_t *packet_end_ptr, uint32_t *value_ptr);
+static int8_t   sn_coap_parser_options_apply_views(sn_coap_msg_view_s *msg_ptr, uint8_t **arena_free_pptr, uint8_t *arena_end_ptr);
+static int8_t   sn_coap_parser_options_join_views(sn_coap_msg_view_s *msg_ptr, uint16_t first_view, uint16_t part_count, uint16_t max_part_len, uint8_t separator,
+                                                  uint8_t **dst_pptr, uint16_t *dst_len_ptr, uint8_t **arena_free_pptr, uint8_t *arena_end_ptr);
+
+/* Alignment of a message placed in a caller provided arena */
+#define SN_COAP_PARSER_ARENA_ALIGN  (sizeof(void *) > sizeof(uint32_t) ? sizeof(void *) : sizeof(uint32_t))
 
 sn_coap_hdr_s *sn_coap_parser_init_message(sn_coap_hdr_s *coap_msg_ptr)
 {
@@ -96,19 +105,29 @@ sn_coap_options_list_s *sn_coap_parser_alloc_options(struct coap_s *handle, sn_c
         return NULL;
     }
 
-    /* XXX not technically legal to memset pointers to 0 */
-    memset(coap_msg_ptr->options_list_ptr, 0x00, sizeof(sn_coap_options_list_s));
-
-    coap_msg_ptr->options_list_ptr->max_age = COAP_OPTION_MAX_AGE_DEFAULT;
-    coap_msg_ptr->options_list_ptr->uri_port = COAP_OPTION_URI_PORT_NONE;
-    coap_msg_ptr->options_list_ptr->observe = COAP_OBSERVE_NONE;
-    coap_msg_ptr->options_list_ptr->accept = COAP_CT_NONE;
-    coap_msg_ptr->options_list_ptr->block2 = COAP_OPTION_BLOCK_NONE;
-    coap_msg_ptr->options_list_ptr->block1 = COAP_OPTION_BLOCK_NONE;
+    sn_coap_parser_init_options(coap_msg_ptr->options_list_ptr);
 
     return coap_msg_ptr->options_list_ptr;
 }
 
+/**
+ * \brief Initialises options list structure to default values
+ *
+ * \param *options_list_ptr is pointer to options to initialise
+ */
+static void sn_coap_parser_init_options(sn_coap_options_list_s *options_list_ptr)
+{
+    /* XXX not technically legal to memset pointers to 0 */
+    memset(options_list_ptr, 0x00, sizeof(sn_coap_options_list_s));
+
+    options_list_ptr->max_age = COAP_OPTION_MAX_AGE_DEFAULT;
+    options_list_ptr->uri_port = COAP_OPTION_URI_PORT_NONE;
+    options_list_ptr->observe = COAP_OBSERVE_NONE;
+    options_list_ptr->accept = COAP_CT_NONE;
+    options_list_ptr->block2 = COAP_OPTION_BLOCK_NONE;
+    options_list_ptr->block1 = COAP_OPTION_BLOCK_NONE;
+}
+
 sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
 {
     uint8_t       *data_temp_ptr                    = packet_data_ptr;
@@ -145,6 +164,83 @@ sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, u
     return parsed_and_returned_coap_msg_ptr;
 }
 
+sn_coap_msg_view_s *sn_coap_parser_view(uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr, void *arena_ptr, uint16_t arena_len)
+{
+    uint8_t            *data_temp_ptr   = packet_data_ptr;
+    uint8_t            *arena_start_ptr = arena_ptr;
+    uint8_t            *arena_end_ptr   = arena_start_ptr + arena_len;
+    uint8_t            *arena_free_ptr  = NULL;
+    sn_coap_msg_view_s *msg_ptr         = NULL;
+    uint16_t            arena_padding   = 0;
+    int8_t              ret_status      = 0;
+
+    /* * * * Check given pointers * * * */
+    if (packet_data_ptr == NULL || packet_data_len < 4 || coap_version_ptr == NULL || arena_ptr == NULL) {
+        return NULL;
+    }
+
+    /* * * * Place the message at the first aligned address of the arena * * * */
+    if ((uintptr_t)arena_start_ptr % SN_COAP_PARSER_ARENA_ALIGN) {
+        arena_padding = SN_COAP_PARSER_ARENA_ALIGN - ((uintptr_t)arena_start_ptr % SN_COAP_PARSER_ARENA_ALIGN);
+    }
+
+    if (arena_len < arena_padding + sizeof(sn_coap_msg_view_s)) {
+        return NULL;
+    }
+
+    msg_ptr = (sn_coap_msg_view_s *)(arena_start_ptr + arena_padding);
+    arena_free_ptr = (uint8_t *)(msg_ptr + 1);
+
+    sn_coap_parser_init_message(&msg_ptr->hdr);
+    sn_coap_parser_init_options(&msg_ptr->options);
+    msg_ptr->packet_data_ptr = packet_data_ptr;
+    msg_ptr->option_views_ptr = (sn_coap_option_view_s *)arena_free_ptr;
+    msg_ptr->option_count = 0;
+
+    /* * * * Header parsing, move pointer over the header...  * * * */
+    sn_coap_parser_header_parse(&data_temp_ptr, &msg_ptr->hdr, coap_version_ptr);
+
+    /* * * * Token points to Packet data * * * */
+    msg_ptr->hdr.token_len = *packet_data_ptr & COAP_HEADER_TOKEN_LENGTH_MASK;
+
+    if (msg_ptr->hdr.token_len > 8 || msg_ptr->hdr.token_len > packet_data_len - 4) {
+        ret_status = -1;
+    } else if (msg_ptr->hdr.token_len) {
+        msg_ptr->hdr.token_ptr = data_temp_ptr;
+        data_temp_ptr += msg_ptr->hdr.token_len;
+    }
+
+    /* * * * Options parsing, first into views and then into the message * * * */
+    if (ret_status == 0) {
+        ret_status = sn_coap_parser_options_parse_views(&data_temp_ptr, packet_data_ptr, packet_data_len, msg_ptr->option_views_ptr,
+                     (arena_end_ptr - arena_free_ptr) / sizeof(sn_coap_option_view_s), &msg_ptr->option_count);
+    }
+
+    if (ret_status == 0) {
+        arena_free_ptr += msg_ptr->option_count * sizeof(sn_coap_option_view_s);
+        ret_status = sn_coap_parser_options_apply_views(msg_ptr, &arena_free_ptr, arena_end_ptr);
+    }
+
+    /* * * * Payload parsing * * * */
+    if (ret_status == 0 && sn_coap_parser_payload_parse(packet_data_len, packet_data_ptr, &data_temp_ptr, &msg_ptr->hdr) == -1) {
+        ret_status = -1;
+    }
+
+    /* Arena is too small for the message */
+    if (ret_status == -2) {
+        return NULL;
+    }
+
+    if (ret_status != 0) {
+        msg_ptr->hdr.coap_status = COAP_STATUS_PARSER_ERROR_IN_HEADER;
+    }
+
+    msg_ptr->arena_used = arena_free_ptr - arena_start_ptr;
+
+    /* * * * Return parsed CoAP message  * * * * */
+    return msg_ptr;
+}
+
 void sn_coap_parser_release_allocated_coap_msg_mem(struct coap_s *handle, sn_coap_hdr_s *freed_coap_msg_ptr)
 {
     if (handle == NULL) {
@@ -751,3 +847,323 @@ static int8_t sn_coap_parser_payload_parse(uint16_t packet_data_len, uint8_t *pa
     }
     return 0;
 }
+
+/**
+ * \brief Parses CoAP message's Options part from given Packet data into option views
+ *
+ * \param **packet_data_pptr is source of Packet data, moved over the Options part
+ * \param *packet_data_start_ptr is start of Packet data
+ * \param packet_len is length of Packet data
+ * \param *views_ptr is destination for option views
+ * \param max_view_count is number of option views that fit into destination
+ * \param *view_count_ptr is destination for number of parsed option views
+ *
+ * \return Return value is 0 in ok case, -1 in failure case and -2 if
+ *         destination is too small
+ */
+static int8_t sn_coap_parser_options_parse_views(uint8_t **packet_data_pptr, uint8_t *packet_data_start_ptr, uint16_t packet_len,
+        sn_coap_option_view_s *views_ptr, uint16_t max_view_count, uint16_t *view_count_ptr)
+{
+    uint8_t  *packet_end_ptr = packet_data_start_ptr + packet_len;
+    uint32_t  option_number  = 0;
+
+    *view_count_ptr = 0;
+
+    /* Loop all Options */
+    while (*packet_data_pptr < packet_end_ptr && **packet_data_pptr != 0xff) {
+        uint8_t  *option_ptr   = *packet_data_pptr;
+        uint32_t  option_delta = (*option_ptr >> COAP_OPTIONS_OPTION_NUMBER_SHIFT);
+        uint32_t  option_len   = (*option_ptr & 0x0F);
+
+        option_ptr++;
+
+        /* Value 15 is reserved for payload marker - ERROR */
+        if (option_delta == 15 || option_len == 15) {
+            return -1;
+        }
+
+        /* Option delta extension comes before option length extension */
+        if (sn_coap_parser_options_parse_extension(&option_ptr, packet_end_ptr, &option_delta) != 0 ||
+                sn_coap_parser_options_parse_extension(&option_ptr, packet_end_ptr, &option_len) != 0) {
+            return -1;
+        }
+
+        option_number += option_delta;
+
+        if (option_number > UINT16_MAX || option_len > (uint32_t)(packet_end_ptr - option_ptr)) {
+            return -1;
+        }
+
+        if (*view_count_ptr == max_view_count) {
+            return -2;
+        }
+
+        views_ptr[*view_count_ptr].number = option_number;
+        views_ptr[*view_count_ptr].offset = option_ptr - packet_data_start_ptr;
+        views_ptr[*view_count_ptr].len = option_len;
+        (*view_count_ptr)++;
+
+        *packet_data_pptr = option_ptr + option_len;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Resolves an extended option delta or length
+ *
+ * \param **option_pptr is source of extension bytes, moved over them
+ * \param *packet_end_ptr is end of Packet data
+ * \param *value_ptr is 4-bit value from option header, replaced by resolved value
+ *
+ * \return Return value is 0 in ok case and -1 if Packet data ends
+ */
+static int8_t sn_coap_parser_options_parse_extension(uint8_t **option_pptr, uint8_t *packet_end_ptr, uint32_t *value_ptr)
+{
+    if (*value_ptr == 13) {
+        if (packet_end_ptr - *option_pptr < 1) {
+            return -1;
+        }
+        *value_ptr = **option_pptr + 13;
+        (*option_pptr) += 1;
+    } else if (*value_ptr == 14) {
+        if (packet_end_ptr - *option_pptr < 2) {
+            return -1;
+        }
+        *value_ptr = ((*option_pptr)[0] << 8) + (*option_pptr)[1] + 269;
+        (*option_pptr) += 2;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Fills CoAP message's Options from its option views
+ *
+ * Applies the same limits as sn_coap_parser() does. Repeated options are
+ * adjacent in views, as option numbers never decrease in Packet data.
+ *
+ * \param *msg_ptr is message with parsed option views
+ * \param **arena_free_pptr is free space of the arena for joined options
+ * \param *arena_end_ptr is end of the arena
+ *
+ * \return Return value is 0 in ok case, -1 in failure case and -2 if the
+ *         arena is too small
+ */
+static int8_t sn_coap_parser_options_apply_views(sn_coap_msg_view_s *msg_ptr, uint8_t **arena_free_pptr, uint8_t *arena_end_ptr)
+{
+    sn_coap_hdr_s          *hdr_ptr     = &msg_ptr->hdr;
+    sn_coap_options_list_s *options_ptr = &msg_ptr->options;
+    uint16_t                i           = 0;
+
+    while (i < msg_ptr->option_count) {
+        const sn_coap_option_view_s *view_ptr   = &msg_ptr->option_views_ptr[i];
+        uint8_t                     *value_ptr  = msg_ptr->packet_data_ptr + view_ptr->offset;
+        uint16_t                     part_count = 1;
+        uint16_t                     etag_len   = 0;
+        int8_t                       ret_status = 0;
+
+        while (i + part_count < msg_ptr->option_count && msg_ptr->option_views_ptr[i + part_count].number == view_ptr->number) {
+            part_count++;
+        }
+
+        if (view_ptr->number != COAP_OPTION_CONTENT_FORMAT && view_ptr->number != COAP_OPTION_URI_PATH) {
+            hdr_ptr->options_list_ptr = options_ptr;
+        }
+
+        /* Parse option */
+        switch (view_ptr->number) {
+            case COAP_OPTION_ETAG:
+                ret_status = sn_coap_parser_options_join_views(msg_ptr, i, part_count, 8, '&',
+                             &options_ptr->etag_ptr, &etag_len, arena_free_pptr, arena_end_ptr);
+                if (ret_status == 0 && etag_len > UINT8_MAX) {
+                    ret_status = -1;
+                }
+                options_ptr->etag_len = etag_len;
+                break;
+
+            case COAP_OPTION_LOCATION_PATH:
+                ret_status = sn_coap_parser_options_join_views(msg_ptr, i, part_count, 255, '/',
+                             &options_ptr->location_path_ptr, &options_ptr->location_path_len, arena_free_pptr, arena_end_ptr);
+                break;
+
+            case COAP_OPTION_LOCATION_QUERY:
+                ret_status = sn_coap_parser_options_join_views(msg_ptr, i, part_count, 255, '&',
+                             &options_ptr->location_query_ptr, &options_ptr->location_query_len, arena_free_pptr, arena_end_ptr);
+                break;
+
+            case COAP_OPTION_URI_PATH:
+                ret_status = sn_coap_parser_options_join_views(msg_ptr, i, part_count, 255, '/',
+                             &hdr_ptr->uri_path_ptr, &hdr_ptr->uri_path_len, arena_free_pptr, arena_end_ptr);
+                break;
+
+            case COAP_OPTION_URI_QUERY:
+                ret_status = sn_coap_parser_options_join_views(msg_ptr, i, part_count, 255, '&',
+                             &options_ptr->uri_query_ptr, &options_ptr->uri_query_len, arena_free_pptr, arena_end_ptr);
+                break;
+
+            default:
+                /* Rest of the options are not repeatable */
+                if (part_count > 1) {
+                    return -1;
+                }
+
+                switch (view_ptr->number) {
+                    case COAP_OPTION_CONTENT_FORMAT:
+                        if (view_ptr->len > 2) {
+                            return -1;
+                        }
+                        hdr_ptr->content_format = (sn_coap_content_format_e) sn_coap_parser_options_parse_uint(&value_ptr, view_ptr->len);
+                        break;
+
+                    case COAP_OPTION_MAX_AGE:
+                        if (view_ptr->len > 4) {
+                            return -1;
+                        }
+                        options_ptr->max_age = sn_coap_parser_options_parse_uint(&value_ptr, view_ptr->len);
+                        break;
+
+                    case COAP_OPTION_PROXY_URI:
+                        if ((view_ptr->len > 1034) || (view_ptr->len < 1)) {
+                            return -1;
+                        }
+                        options_ptr->proxy_uri_len = view_ptr->len;
+                        options_ptr->proxy_uri_ptr = value_ptr;
+                        break;
+
+                    case COAP_OPTION_URI_HOST:
+                        if ((view_ptr->len > 255) || (view_ptr->len < 1)) {
+                            return -1;
+                        }
+                        options_ptr->uri_host_len = view_ptr->len;
+                        options_ptr->uri_host_ptr = value_ptr;
+                        break;
+
+                    case COAP_OPTION_URI_PORT:
+                        if (view_ptr->len > 2) {
+                            return -1;
+                        }
+                        options_ptr->uri_port = sn_coap_parser_options_parse_uint(&value_ptr, view_ptr->len);
+                        break;
+
+                    case COAP_OPTION_OBSERVE:
+                        if (view_ptr->len > 2) {
+                            return -1;
+                        }
+                        options_ptr->observe = sn_coap_parser_options_parse_uint(&value_ptr, view_ptr->len);
+                        break;
+
+                    case COAP_OPTION_BLOCK2:
+                        if (view_ptr->len > 3) {
+                            return -1;
+                        }
+                        options_ptr->block2 = sn_coap_parser_options_parse_uint(&value_ptr, view_ptr->len);
+                        break;
+
+                    case COAP_OPTION_BLOCK1:
+                        if (view_ptr->len > 3) {
+                            return -1;
+                        }
+                        options_ptr->block1 = sn_coap_parser_options_parse_uint(&value_ptr, view_ptr->len);
+                        break;
+
+                    case COAP_OPTION_ACCEPT:
+                        if (view_ptr->len > 2) {
+                            return -1;
+                        }
+                        options_ptr->accept = (sn_coap_content_format_e) sn_coap_parser_options_parse_uint(&value_ptr, view_ptr->len);
+                        break;
+
+                    case COAP_OPTION_SIZE1:
+                        if (view_ptr->len > 4) {
+                            return -1;
+                        }
+                        options_ptr->use_size1 = true;
+                        options_ptr->size1 = sn_coap_parser_options_parse_uint(&value_ptr, view_ptr->len);
+                        break;
+
+                    case COAP_OPTION_SIZE2:
+                        if (view_ptr->len > 4) {
+                            return -1;
+                        }
+                        options_ptr->use_size2 = true;
+                        options_ptr->size2 = sn_coap_parser_options_parse_uint(&value_ptr, view_ptr->len);
+                        break;
+
+                    default:
+                        return -1;
+                }
+                break;
+        }
+
+        if (ret_status != 0) {
+            return ret_status;
+        }
+
+        i += part_count;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Resolves a repeatable option from its option views
+ *
+ * A single part points to Packet data. Several parts are joined with the
+ * separator into the arena, in the format sn_coap_parser() uses.
+ *
+ * \param *msg_ptr is message with parsed option views
+ * \param first_view is index of the first part in option views
+ * \param part_count is number of parts
+ * \param max_part_len is maximum length of one part
+ * \param separator is placed between joined parts
+ * \param **dst_pptr is destination for option value pointer
+ * \param *dst_len_ptr is destination for option value length
+ * \param **arena_free_pptr is free space of the arena
+ * \param *arena_end_ptr is end of the arena
+ *
+ * \return Return value is 0 in ok case, -1 in failure case and -2 if the
+ *         arena is too small
+ */
+static int8_t sn_coap_parser_options_join_views(sn_coap_msg_view_s *msg_ptr, uint16_t first_view, uint16_t part_count, uint16_t max_part_len, uint8_t separator,
+                                                uint8_t **dst_pptr, uint16_t *dst_len_ptr, uint8_t **arena_free_pptr, uint8_t *arena_end_ptr)
+{
+    const sn_coap_option_view_s *view_ptr = &msg_ptr->option_views_ptr[first_view];
+    uint32_t                     joined_len = part_count - 1;
+    uint16_t                     i;
+
+    for (i = 0; i < part_count; i++) {
+        if (view_ptr[i].len > max_part_len) {
+            return -1;
+        }
+        joined_len += view_ptr[i].len;
+    }
+
+    if (part_count == 1) {
+        *dst_pptr = view_ptr->len ? msg_ptr->packet_data_ptr + view_ptr->offset : NULL;
+        *dst_len_ptr = view_ptr->len;
+        return 0;
+    }
+
+    if (joined_len > UINT16_MAX) {
+        return -1;
+    }
+
+    if (joined_len > (uint32_t)(arena_end_ptr - *arena_free_pptr)) {
+        return -2;
+    }
+
+    *dst_pptr = *arena_free_pptr;
+    *dst_len_ptr = joined_len;
+
+    for (i = 0; i < part_count; i++) {
+        if (i > 0) {
+            **arena_free_pptr = separator;
+            (*arena_free_pptr)++;
+        }
+        memcpy(*arena_free_pptr, msg_ptr->packet_data_ptr + view_ptr[i].offset, view_ptr[i].len);
+        (*arena_free_pptr) += view_ptr[i].len;
+    }
+
+    return 0;
+}
@@ -50,7 +50,7 @@ static void                  sn_coap_protocol_send_rst(struct coap_s *handle, ui
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT/* If Message duplication detection is not used at all, this part of code will not be compiled */
 static void                  sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
 static int8_t                sn_coap_protocol_linked_list_duplication_info_search(struct coap_s *handle, sn_nsdl_addr_s *scr_addr_ptr, uint16_t msg_id);
-static void                  sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *scr_addr_ptr, uint16_t port, uint16_t msg_id);
+static void                  sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr);
 static void                  sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle);
 #endif
 #if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwising is not used at all, this part of code will not be compiled */
@@ -61,6 +61,7 @@ static void                  sn_coap_protocol_linked_list_blockwise_payload_remo
 static void                  sn_coap_protocol_linked_list_blockwise_payload_remove_oldest(struct coap_s *handle);
 static uint32_t              sn_coap_protocol_linked_list_blockwise_payloads_get_len(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr);
 static void                  sn_coap_protocol_linked_list_blockwise_remove_old_data(struct coap_s *handle);
+static int8_t                sn_coap_protocol_blockwise_msg_read_block(struct coap_s *handle, coap_blockwise_msg_s *stored_blockwise_msg_ptr, sn_nsdl_addr_s *addr_ptr, uint32_t block_number, uint16_t block_size, void *param);
 static sn_coap_hdr_s        *sn_coap_handle_blockwise_message(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr, void *param);
 static int8_t                sn_coap_convert_block_size(uint16_t block_size);
 static sn_coap_hdr_s        *sn_coap_protocol_copy_header(struct coap_s *handle, sn_coap_hdr_s *source_header_ptr);
@@ -69,9 +70,18 @@ static sn_coap_hdr_s        *sn_coap_protocol_copy_header(struct coap_s *handle,
 static void                  sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len, uint8_t *send_packet_data_ptr, uint32_t sending_time, void *param, uint8_t *uri_path_ptr, uint8_t uri_path_len);
 static sn_nsdl_transmit_s   *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle,sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
 static void                  sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
+static coap_send_msg_s      *sn_coap_protocol_linked_list_send_msg_find(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, uint16_t msg_id);
+static void                  sn_coap_protocol_linked_list_send_msg_schedule(struct coap_s *handle, coap_send_msg_s *scheduled_msg_ptr);
+static void                  sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *unlinked_msg_ptr);
 static coap_send_msg_s      *sn_coap_protocol_allocate_mem_for_msg(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t packet_data_len);
 static void                  sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handle, coap_send_msg_s *freed_send_msg_ptr);
-static uint16_t              sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr);
+#endif
+#if ENABLE_RESENDINGS || SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+static uint16_t              sn_coap_protocol_hash(const uint8_t *addr_ptr, uint8_t addr_len, uint16_t port, uint16_t msg_id);
+#endif
+
+#if (SN_COAP_RESENDING_HASH_SIZE & (SN_COAP_RESENDING_HASH_SIZE - 1)) || (SN_COAP_DUPLICATION_HASH_SIZE & (SN_COAP_DUPLICATION_HASH_SIZE - 1))
+#error "SN_COAP_RESENDING_HASH_SIZE and SN_COAP_DUPLICATION_HASH_SIZE must be powers of two"
 #endif
 
 /* * * * * * * * * * * * * * * * * */
@@ -235,6 +245,25 @@ int8_t sn_coap_protocol_set_block_size(struct coap_s *handle, uint16_t block_siz
 
 }
 
+int8_t sn_coap_protocol_set_block_stream(struct coap_s *handle,
+        int8_t (*block_sink)(sn_coap_hdr_s *, sn_nsdl_addr_s *, uint32_t, void *),
+        int16_t (*block_source)(sn_coap_hdr_s *, sn_nsdl_addr_s *, uint32_t, uint8_t *, uint16_t, void *))
+{
+    (void) handle;
+    (void) block_sink;
+    (void) block_source;
+#if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    if (handle == NULL) {
+        return -1;
+    }
+    handle->sn_coap_block_sink = block_sink;
+    handle->sn_coap_block_source = block_source;
+    return 0;
+#else
+    return -1;
+#endif
+}
+
 int8_t sn_coap_protocol_set_duplicate_buffer_size(struct coap_s *handle, uint8_t message_count)
 {
     (void) handle;
@@ -324,6 +353,8 @@ void sn_coap_protocol_clear_retransmission_buffer(struct coap_s *handle)
         handle->sn_coap_protocol_free(tmp);
         tmp = 0;
     }
+    memset(handle->hash_resent_msgs, 0, sizeof(handle->hash_resent_msgs));
+    handle->size_resent_msgs = 0;
 #endif
 }
 
@@ -333,22 +364,28 @@ int8_t sn_coap_protocol_delete_retransmission(struct coap_s *handle, uint16_t ms
     if (handle == NULL) {
         return -1;
     }
+    /* Without the destination address the hash can not be used */
     ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        if (tmp->send_msg_ptr && tmp->send_msg_ptr->packet_ptr ) {
-            uint16_t temp_msg_id = (tmp->send_msg_ptr->packet_ptr[2] << 8);
-            temp_msg_id += (uint16_t)tmp->send_msg_ptr->packet_ptr[3];
-            if(temp_msg_id == msg_id){
-                ns_list_remove(&handle->linked_list_resent_msgs, tmp);
-                --handle->count_resent_msgs;
-                sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-                return 0;
-            }
+        if (tmp->msg_id == msg_id) {
+            sn_coap_protocol_linked_list_send_msg_unlink(handle, tmp);
+            sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
+            return 0;
         }
     }
 #endif
     return -2;
 }
 
+int8_t sn_coap_protocol_get_stats(struct coap_s *handle, sn_coap_protocol_stats_s *stats)
+{
+    if (handle == NULL || stats == NULL) {
+        return -1;
+    }
+
+    *stats = handle->stats;
+    return 0;
+}
+
 #if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwising is not used at all, this part of code will not be compiled */
 int8_t prepare_blockwise_message(struct coap_s *handle, sn_coap_hdr_s *src_coap_msg_ptr)
 {
@@ -529,6 +566,114 @@ int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_p
     return byte_count_built;
 }
 
+int8_t sn_coap_protocol_send_stream(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr,
+                                    sn_coap_hdr_s *src_coap_msg_ptr, uint32_t payload_len, void *param)
+{
+    (void) handle;
+    (void) dst_addr_ptr;
+    (void) src_coap_msg_ptr;
+    (void) payload_len;
+    (void) param;
+#if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwising is not used at all, this part of code will not be compiled */
+    coap_blockwise_msg_s *stored_blockwise_msg_ptr = NULL;
+    uint8_t *block_ptr           = NULL;
+    uint8_t *dst_packet_data_ptr = NULL;
+    uint16_t dst_packet_data_len = 0;
+    uint16_t block_len           = 0;
+    int16_t  byte_count_built    = 0;
+
+    /* * * * Check given pointers  * * * */
+    if (handle == NULL || dst_addr_ptr == NULL || src_coap_msg_ptr == NULL || handle->sn_coap_block_source == NULL ||
+            handle->sn_coap_block_data_size == 0 || payload_len == 0) {
+        return -1;
+    }
+
+    block_len = handle->sn_coap_block_data_size;
+    if (payload_len < block_len) {
+        block_len = payload_len;
+    }
+
+    /* * * * Only the first block is read now, the rest when the peer asks for them * * * */
+    block_ptr = handle->sn_coap_protocol_malloc(block_len);
+    if (!block_ptr) {
+        return -2;
+    }
+
+    if (handle->sn_coap_block_source(src_coap_msg_ptr, dst_addr_ptr, 0, block_ptr, block_len, param) != block_len) {
+        handle->sn_coap_protocol_free(block_ptr);
+        return -1;
+    }
+
+    if (payload_len > handle->sn_coap_block_data_size) {
+        if (sn_coap_parser_alloc_options(handle, src_coap_msg_ptr) == NULL) {
+            handle->sn_coap_protocol_free(block_ptr);
+            return -2;
+        }
+
+        /* First block (BLOCK NUMBER, 4 MSB bits) + More to come (MORE, 1 bit) + block size, and size of the whole payload */
+        if (src_coap_msg_ptr->msg_code < COAP_MSG_CODE_RESPONSE_CREATED) {
+            src_coap_msg_ptr->options_list_ptr->block1 = 0x08 | sn_coap_convert_block_size(handle->sn_coap_block_data_size);
+            src_coap_msg_ptr->options_list_ptr->use_size1 = true;
+            src_coap_msg_ptr->options_list_ptr->size1 = payload_len;
+        } else {
+            src_coap_msg_ptr->options_list_ptr->block2 = 0x08 | sn_coap_convert_block_size(handle->sn_coap_block_data_size);
+            src_coap_msg_ptr->options_list_ptr->use_size2 = true;
+            src_coap_msg_ptr->options_list_ptr->size2 = payload_len;
+        }
+    }
+
+    src_coap_msg_ptr->payload_ptr = block_ptr;
+    src_coap_msg_ptr->payload_len = block_len;
+
+    /* * * * Build first block, storing it for resending * * * */
+    dst_packet_data_len = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_msg_ptr, handle->sn_coap_block_data_size);
+    dst_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packet_data_len);
+    if (dst_packet_data_ptr) {
+        byte_count_built = sn_coap_protocol_build(handle, dst_addr_ptr, dst_packet_data_ptr, src_coap_msg_ptr, param);
+    }
+
+    src_coap_msg_ptr->payload_ptr = NULL;
+    src_coap_msg_ptr->payload_len = 0;
+    handle->sn_coap_protocol_free(block_ptr);
+
+    if (!dst_packet_data_ptr || byte_count_built < 0) {
+        handle->sn_coap_protocol_free(dst_packet_data_ptr);
+        return dst_packet_data_ptr ? -1 : -2;
+    }
+
+    /* * * * Store header for sending rest of the blocks, the payload stays with the source * * * */
+    if (payload_len > handle->sn_coap_block_data_size) {
+        stored_blockwise_msg_ptr = handle->sn_coap_protocol_malloc(sizeof(coap_blockwise_msg_s));
+        if (stored_blockwise_msg_ptr) {
+            memset(stored_blockwise_msg_ptr, 0, sizeof(coap_blockwise_msg_s));
+            stored_blockwise_msg_ptr->coap_msg_ptr = sn_coap_protocol_copy_header(handle, src_coap_msg_ptr);
+        }
+
+        if (!stored_blockwise_msg_ptr || !stored_blockwise_msg_ptr->coap_msg_ptr) {
+            handle->sn_coap_protocol_free(stored_blockwise_msg_ptr);
+            handle->sn_coap_protocol_free(dst_packet_data_ptr);
+#if ENABLE_RESENDINGS
+            sn_coap_protocol_linked_list_send_msg_remove(handle, dst_addr_ptr, src_coap_msg_ptr->msg_id);
+#endif
+            return -2;
+        }
+
+        stored_blockwise_msg_ptr->timestamp = handle->system_time;
+        stored_blockwise_msg_ptr->stream_len = payload_len;
+        stored_blockwise_msg_ptr->coap = handle;
+
+        ns_list_add_to_end(&handle->linked_list_blockwise_sent_msgs, stored_blockwise_msg_ptr);
+    }
+
+    handle->sn_coap_tx_callback(dst_packet_data_ptr, byte_count_built, dst_addr_ptr, param);
+    handle->sn_coap_protocol_free(dst_packet_data_ptr);
+
+    return 0;
+#else
+    return -1;
+#endif
+}
+
 sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, void *param)
 {
     tr_debug("sn_coap_protocol_parse");
@@ -622,12 +767,17 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
             coap_duplication_info_s *stored_duplication_info_ptr = ns_list_get_first(&handle->linked_list_duplication_msgs);
 
             /* Remove oldest stored duplication message for getting room for new duplication message */
-            sn_coap_protocol_linked_list_duplication_info_remove(handle, stored_duplication_info_ptr->addr_ptr, stored_duplication_info_ptr->port, stored_duplication_info_ptr->msg_id);
+            if (stored_duplication_info_ptr) {
+                sn_coap_protocol_linked_list_duplication_info_remove(handle, stored_duplication_info_ptr);
+                handle->stats.duplication_evictions++;
+            }
         }
 
         /* Store Duplication info to Linked list */
         sn_coap_protocol_linked_list_duplication_info_store(handle, src_addr_ptr, returned_dst_coap_msg_ptr->msg_id);
     } else { /* * * Message duplication detected * * */
+        handle->stats.duplicates_detected++;
+
         /* Set returned status to User */
         returned_dst_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_DUPLICATED_MSG;
 
@@ -739,50 +889,56 @@ int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time)
 #endif
 
 #if ENABLE_RESENDINGS
-    /* Check if there is ongoing active message sendings */
-    ns_list_foreach_safe(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        // First check that msg belongs to handle
-        if( stored_msg_ptr->coap == handle ){
-            /* Check if it is time to send this message */
-            if (current_time >= stored_msg_ptr->resending_time) {
-                /* * * Increase Resending counter  * * */
-                stored_msg_ptr->resending_counter++;
-
-                /* Check if all re-sendings have been done */
-                if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
-                    coap_version_e coap_version = COAP_VERSION_UNKNOWN;
-
-                    /* Get message ID from stored sending message */
-                    uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-                    temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
-                    /* If RX callback have been defined.. */
-                    if (stored_msg_ptr->coap->sn_coap_rx_callback != 0) {
-                        sn_coap_hdr_s *tmp_coap_hdr_ptr;
-                        /* Parse CoAP message, set status and call RX callback */
-                        tmp_coap_hdr_ptr = sn_coap_parser(stored_msg_ptr->coap, stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->packet_ptr, &coap_version);
-
-                        if (tmp_coap_hdr_ptr != 0) {
-                            tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
-
-                            stored_msg_ptr->coap->sn_coap_rx_callback(tmp_coap_hdr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
-
-                            sn_coap_parser_release_allocated_coap_msg_mem(stored_msg_ptr->coap, tmp_coap_hdr_ptr);
-                        }
-                    }
-                    /* Remove message from Linked list */
-                    sn_coap_protocol_linked_list_send_msg_remove(handle, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, temp_msg_id);
-                } else {
-                    /* Send message  */
-                    stored_msg_ptr->coap->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr->packet_ptr,
-                            stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
+    /* Resending messages are ordered by resending time, so only the due ones */
+    /* at the head of the list are visited, each at most once per call        */
+    uint16_t unvisited_msgs_count = handle->count_resent_msgs;
 
-                    /* * * Count new Resending time  * * */
-                    stored_msg_ptr->resending_time = current_time + (((uint32_t)(handle->sn_coap_resending_intervall * RESPONSE_RANDOM_FACTOR)) <<
-                                                     stored_msg_ptr->resending_counter);
-                }
+    while (unvisited_msgs_count-- > 0) {
+        coap_send_msg_s *stored_msg_ptr = ns_list_get_first(&handle->linked_list_resent_msgs);
 
+        /* Check if it is time to send this message */
+        if (stored_msg_ptr == NULL || current_time < stored_msg_ptr->resending_time) {
+            break;
+        }
+
+        /* * * Increase Resending counter  * * */
+        stored_msg_ptr->resending_counter++;
+
+        /* Check if all re-sendings have been done */
+        if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
+            coap_version_e coap_version = COAP_VERSION_UNKNOWN;
+
+            /* Remove message from Linked list before the callback, which may modify the list */
+            sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg_ptr);
+            handle->stats.resend_timeouts++;
+
+            /* If RX callback have been defined.. */
+            if (handle->sn_coap_rx_callback != 0) {
+                sn_coap_hdr_s *tmp_coap_hdr_ptr;
+                /* Parse CoAP message, set status and call RX callback */
+                tmp_coap_hdr_ptr = sn_coap_parser(handle, stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->packet_ptr, &coap_version);
+
+                if (tmp_coap_hdr_ptr != 0) {
+                    tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
+
+                    handle->sn_coap_rx_callback(tmp_coap_hdr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
+
+                    sn_coap_parser_release_allocated_coap_msg_mem(handle, tmp_coap_hdr_ptr);
+                }
             }
+
+            sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
+        } else {
+            /* * * Count new Resending time and move message to its place in the Linked list  * * */
+            stored_msg_ptr->resending_time = current_time + (((uint32_t)(handle->sn_coap_resending_intervall * RESPONSE_RANDOM_FACTOR)) <<
+                                             stored_msg_ptr->resending_counter);
+            ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+            sn_coap_protocol_linked_list_send_msg_schedule(handle, stored_msg_ptr);
+            handle->stats.resends++;
+
+            /* Send message  */
+            handle->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr->packet_ptr,
+                    stored_msg_ptr->send_msg_ptr->packet_len, stored_msg_ptr->send_msg_ptr->dst_addr_ptr, stored_msg_ptr->param);
         }
     }
 
@@ -820,13 +976,15 @@ static void sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, s
 
     if (handle->sn_coap_resending_queue_msgs > 0) {
         if (handle->count_resent_msgs >= handle->sn_coap_resending_queue_msgs) {
+            handle->stats.resend_queue_full++;
             return;
         }
     }
 
-    /* Count resending queue size, if buffer size is defined */
+    /* Check resending queue size, if buffer size is defined */
     if (handle->sn_coap_resending_queue_bytes > 0) {
-        if ((sn_coap_count_linked_list_size(&handle->linked_list_resent_msgs) + send_packet_data_len) > handle->sn_coap_resending_queue_bytes) {
+        if ((handle->size_resent_msgs + send_packet_data_len) > handle->sn_coap_resending_queue_bytes) {
+            handle->stats.resend_queue_full++;
             return;
         }
     }
@@ -841,6 +999,8 @@ static void sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, s
     /* Filling of coap_send_msg_s with initialization values */
     stored_msg_ptr->resending_counter = 0;
     stored_msg_ptr->resending_time = sending_time;
+    stored_msg_ptr->msg_id = (send_packet_data_ptr[2] << 8);
+    stored_msg_ptr->msg_id += (uint16_t)send_packet_data_ptr[3];
 
     /* Filling of sn_nsdl_transmit_s */
     stored_msg_ptr->send_msg_ptr->protocol = SN_NSDL_PROTOCOL_COAP;
@@ -859,6 +1019,7 @@ static void sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, s
     if (uri_path_len) {
         stored_msg_ptr->send_msg_ptr->uri_path_ptr = handle->sn_coap_protocol_malloc(uri_path_len);
         if (stored_msg_ptr->send_msg_ptr->uri_path_ptr == NULL){
+            sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
             return;
         }
         stored_msg_ptr->send_msg_ptr->uri_path_len = uri_path_len;
@@ -866,9 +1027,94 @@ static void sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, s
     }
 
 
-    /* Storing Resending message to Linked list */
-    ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    /* Storing Resending message to hash table and Linked list */
+    coap_send_msg_s **bucket_ptr = &handle->hash_resent_msgs[sn_coap_protocol_hash(dst_addr_ptr->addr_ptr, dst_addr_ptr->addr_len,
+                                   dst_addr_ptr->port, stored_msg_ptr->msg_id) & (SN_COAP_RESENDING_HASH_SIZE - 1)];
+    stored_msg_ptr->hash_next = *bucket_ptr;
+    *bucket_ptr = stored_msg_ptr;
+
+    sn_coap_protocol_linked_list_send_msg_schedule(handle, stored_msg_ptr);
     ++handle->count_resent_msgs;
+    handle->size_resent_msgs += send_packet_data_len;
+}
+
+/**************************************************************************//**
+ * \fn static coap_send_msg_s *sn_coap_protocol_linked_list_send_msg_find(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
+ *
+ * \brief Looks up stored resending message from hash table
+ *
+ * \param *addr_ptr is destination address of searched message
+ * \param msg_id is Message ID of searched message
+ *
+ * \return Return value is pointer to found message or NULL if message not found
+ *****************************************************************************/
+
+static coap_send_msg_s *sn_coap_protocol_linked_list_send_msg_find(struct coap_s *handle, sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
+{
+    coap_send_msg_s *stored_msg_ptr = handle->hash_resent_msgs[sn_coap_protocol_hash(addr_ptr->addr_ptr, addr_ptr->addr_len,
+                                      addr_ptr->port, msg_id) & (SN_COAP_RESENDING_HASH_SIZE - 1)];
+
+    for (; stored_msg_ptr != NULL; stored_msg_ptr = stored_msg_ptr->hash_next) {
+        sn_nsdl_addr_s *stored_addr_ptr = stored_msg_ptr->send_msg_ptr->dst_addr_ptr;
+
+        if (stored_msg_ptr->msg_id == msg_id &&
+                stored_addr_ptr->port == addr_ptr->port &&
+                stored_addr_ptr->addr_len == addr_ptr->addr_len &&
+                0 == memcmp(stored_addr_ptr->addr_ptr, addr_ptr->addr_ptr, addr_ptr->addr_len)) {
+            return stored_msg_ptr;
+        }
+    }
+
+    return NULL;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_send_msg_schedule(struct coap_s *handle, coap_send_msg_s *scheduled_msg_ptr)
+ *
+ * \brief Inserts message to Linked list, keeping the list ordered by resending time
+ *
+ * \param *scheduled_msg_ptr is message to be inserted, not already in Linked list
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_schedule(struct coap_s *handle, coap_send_msg_s *scheduled_msg_ptr)
+{
+    /* New and rescheduled messages usually have the latest resending time, so search from the end */
+    ns_list_foreach_reverse(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
+        if (stored_msg_ptr->resending_time <= scheduled_msg_ptr->resending_time) {
+            ns_list_add_after(&handle->linked_list_resent_msgs, stored_msg_ptr, scheduled_msg_ptr);
+            return;
+        }
+    }
+
+    ns_list_add_to_start(&handle->linked_list_resent_msgs, scheduled_msg_ptr);
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *unlinked_msg_ptr)
+ *
+ * \brief Removes message from hash table and Linked list without freeing it
+ *
+ * \param *unlinked_msg_ptr is message to be removed
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *unlinked_msg_ptr)
+{
+    sn_nsdl_addr_s *addr_ptr = unlinked_msg_ptr->send_msg_ptr->dst_addr_ptr;
+    coap_send_msg_s **link_ptr = &handle->hash_resent_msgs[sn_coap_protocol_hash(addr_ptr->addr_ptr, addr_ptr->addr_len,
+                                 addr_ptr->port, unlinked_msg_ptr->msg_id) & (SN_COAP_RESENDING_HASH_SIZE - 1)];
+
+    while (*link_ptr != NULL) {
+        if (*link_ptr == unlinked_msg_ptr) {
+            *link_ptr = unlinked_msg_ptr->hash_next;
+            break;
+        }
+        link_ptr = &(*link_ptr)->hash_next;
+    }
+    unlinked_msg_ptr->hash_next = NULL;
+
+    ns_list_remove(&handle->linked_list_resent_msgs, unlinked_msg_ptr);
+    --handle->count_resent_msgs;
+    handle->size_resent_msgs -= unlinked_msg_ptr->send_msg_ptr->packet_len;
 }
 
 /**************************************************************************//**
@@ -887,27 +1133,15 @@ static void sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, s
 static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle,
         sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
 {
-    /* Loop all stored resending messages Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        /* Get message ID from stored resending message */
-        uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-        temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
-        /* If message's Message ID is same than is searched */
-        if (temp_msg_id == msg_id) {
-            /* If message's Source address is same than is searched */
-            if (0 == memcmp(src_addr_ptr->addr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr->addr_ptr, src_addr_ptr->addr_len)) {
-                /* If message's Source address port is same than is searched */
-                if (stored_msg_ptr->send_msg_ptr->dst_addr_ptr->port == src_addr_ptr->port) {
-                    /* * * Message found, return pointer to that stored resending message * * * */
-                    return stored_msg_ptr->send_msg_ptr;
-                }
-            }
-        }
+    coap_send_msg_s *stored_msg_ptr = sn_coap_protocol_linked_list_send_msg_find(handle, src_addr_ptr, msg_id);
+
+    if (stored_msg_ptr == NULL) {
+        /* Message not found */
+        return NULL;
     }
 
-    /* Message not found */
-    return NULL;
+    /* * * Message found, return pointer to that stored resending message * * * */
+    return stored_msg_ptr->send_msg_ptr;
 }
 /**************************************************************************//**
  * \fn static void sn_coap_protocol_linked_list_send_msg_remove(sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
@@ -920,31 +1154,14 @@ static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(struct c
 
 static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
 {
-    /* Loop all stored resending messages in Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        /* Get message ID from stored resending message */
-        uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-        temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
-        /* If message's Message ID is same than is searched */
-        if (temp_msg_id == msg_id) {
-            /* If message's Source address is same than is searched */
-            if (0 == memcmp(src_addr_ptr->addr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr->addr_ptr, src_addr_ptr->addr_len)) {
-                /* If message's Source address port is same than is searched */
-                if (stored_msg_ptr->send_msg_ptr->dst_addr_ptr->port == src_addr_ptr->port) {
-                    /* * * Message found * * */
-
-                    /* Remove message from Linked list */
-                    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                    --handle->count_resent_msgs;
-
-                    /* Free memory of stored message */
-                    sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
-
-                    return;
-                }
-            }
-        }
+    coap_send_msg_s *stored_msg_ptr = sn_coap_protocol_linked_list_send_msg_find(handle, src_addr_ptr, msg_id);
+
+    if (stored_msg_ptr != NULL) {
+        /* Remove message from hash table and Linked list */
+        sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg_ptr);
+
+        /* Free memory of stored message */
+        sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
     }
 }
 #endif /* ENABLE_RESENDINGS */
@@ -1013,7 +1230,12 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
 
     stored_duplication_info_ptr->coap = handle;
 
-    /* * * * Storing Duplication info to Linked list * * * */
+    /* * * * Storing Duplication info to hash table and Linked list * * * */
+
+    coap_duplication_info_s **bucket_ptr = &handle->hash_duplication_msgs[sn_coap_protocol_hash(addr_ptr->addr_ptr, addr_ptr->addr_len,
+                                           addr_ptr->port, msg_id) & (SN_COAP_DUPLICATION_HASH_SIZE - 1)];
+    stored_duplication_info_ptr->hash_next = *bucket_ptr;
+    *bucket_ptr = stored_duplication_info_ptr;
 
     ns_list_add_to_end(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
     ++handle->count_duplication_msgs;
@@ -1022,7 +1244,7 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
 /**************************************************************************//**
  * \fn static int8_t sn_coap_protocol_linked_list_duplication_info_search(sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
  *
- * \brief Searches stored message from Linked list (Address and Message ID as key)
+ * \brief Searches stored message from hash table (Address and Message ID as key)
  *
  * \param *addr_ptr is pointer to Address key to be searched
  * \param msg_id is Message ID key to be searched
@@ -1033,18 +1255,17 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
 static int8_t sn_coap_protocol_linked_list_duplication_info_search(struct coap_s *handle,
         sn_nsdl_addr_s *addr_ptr, uint16_t msg_id)
 {
-    /* Loop all nodes in Linked list for searching Message ID */
-    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        /* If message's Message ID is same than is searched */
-        if (stored_duplication_info_ptr->msg_id == msg_id) {
-            /* If message's Source address is same than is searched */
-            if (0 == memcmp(addr_ptr->addr_ptr, stored_duplication_info_ptr->addr_ptr, addr_ptr->addr_len)) {
-                /* If message's Source address port is same than is searched */
-                if (stored_duplication_info_ptr->port == addr_ptr->port) {
-                    /* * * Correct Duplication info found * * * */
-                    return 0;
-                }
-            }
+    coap_duplication_info_s *stored_duplication_info_ptr = handle->hash_duplication_msgs[sn_coap_protocol_hash(addr_ptr->addr_ptr,
+            addr_ptr->addr_len, addr_ptr->port, msg_id) & (SN_COAP_DUPLICATION_HASH_SIZE - 1)];
+
+    /* Loop all nodes in hash bucket for searching Message ID */
+    for (; stored_duplication_info_ptr != NULL; stored_duplication_info_ptr = stored_duplication_info_ptr->hash_next) {
+        if (stored_duplication_info_ptr->msg_id == msg_id &&
+                stored_duplication_info_ptr->port == addr_ptr->port &&
+                stored_duplication_info_ptr->addr_len == addr_ptr->addr_len &&
+                0 == memcmp(addr_ptr->addr_ptr, stored_duplication_info_ptr->addr_ptr, addr_ptr->addr_len)) {
+            /* * * Correct Duplication info found * * * */
+            return 0;
         }
     }
 
@@ -1052,42 +1273,35 @@ static int8_t sn_coap_protocol_linked_list_duplication_info_search(struct coap_s
 }
 
 /**************************************************************************//**
- * \fn static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *addr_ptr, uint16_t port, uint16_t msg_id)
- *
- * \brief Removes stored Duplication info from Linked list
- *
- * \param *addr_ptr is pointer to Address key to be removed
+ * \fn static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr)
  *
- * \param port is Port key to be removed
+ * \brief Removes stored Duplication info from hash table and Linked list
  *
- * \param msg_id is Message ID key to be removed
+ * \param *removed_duplication_info_ptr is Duplication info to be removed
  *****************************************************************************/
 
-static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *addr_ptr, uint16_t port, uint16_t msg_id)
+static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, coap_duplication_info_s *removed_duplication_info_ptr)
 {
-    /* Loop all stored duplication messages in Linked list */
-    ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        /* If message's Address is same than is searched */
-        if (handle == removed_duplication_info_ptr->coap && 0 == memcmp(addr_ptr, removed_duplication_info_ptr->addr_ptr, removed_duplication_info_ptr->addr_len)) {
-            /* If message's Address prt is same than is searched */
-            if (removed_duplication_info_ptr->port == port) {
-                /* If Message ID is same than is searched */
-                if (removed_duplication_info_ptr->msg_id == msg_id) {
-                    /* * * * Correct Duplication info found, remove it from Linked list * * * */
-                    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-                    --handle->count_duplication_msgs;
-
-                    /* Free memory of stored Duplication info */
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr->addr_ptr);
-                    removed_duplication_info_ptr->addr_ptr = 0;
-                    handle->sn_coap_protocol_free(removed_duplication_info_ptr);
-                    removed_duplication_info_ptr = 0;
-
-                    return;
-                }
-            }
+    coap_duplication_info_s **link_ptr = &handle->hash_duplication_msgs[sn_coap_protocol_hash(removed_duplication_info_ptr->addr_ptr,
+                                         removed_duplication_info_ptr->addr_len, removed_duplication_info_ptr->port,
+                                         removed_duplication_info_ptr->msg_id) & (SN_COAP_DUPLICATION_HASH_SIZE - 1)];
+
+    while (*link_ptr != NULL) {
+        if (*link_ptr == removed_duplication_info_ptr) {
+            *link_ptr = removed_duplication_info_ptr->hash_next;
+            break;
         }
+        link_ptr = &(*link_ptr)->hash_next;
     }
+
+    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
+    --handle->count_duplication_msgs;
+
+    /* Free memory of stored Duplication info */
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr->addr_ptr);
+    removed_duplication_info_ptr->addr_ptr = 0;
+    handle->sn_coap_protocol_free(removed_duplication_info_ptr);
+    removed_duplication_info_ptr = 0;
 }
 
 /**************************************************************************//**
@@ -1098,19 +1312,14 @@ static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *
 
 static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle)
 {
-    /* Loop all stored duplication messages in Linked list */
+    /* Linked list is in storing order, so stop at the first info which is not old */
     ns_list_foreach_safe(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        if ((handle->system_time - removed_duplication_info_ptr->timestamp)  > SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
-            /* * * * Old Duplication info found, remove it from Linked list * * * */
-            ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-            --handle->count_duplication_msgs;
-
-            /* Free memory of stored Duplication info */
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr->addr_ptr);
-            removed_duplication_info_ptr->addr_ptr = 0;
-            handle->sn_coap_protocol_free(removed_duplication_info_ptr);
-            removed_duplication_info_ptr = 0;
+        if ((handle->system_time - removed_duplication_info_ptr->timestamp) <= SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
+            break;
         }
+
+        /* * * * Old Duplication info found, remove it * * * */
+        sn_coap_protocol_linked_list_duplication_info_remove(handle, removed_duplication_info_ptr);
     }
 }
 
@@ -1456,26 +1665,34 @@ static void sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handl
     }
 }
 
+#endif
+
+#if ENABLE_RESENDINGS || SN_COAP_DUPLICATION_MAX_MSGS_COUNT
 /**************************************************************************//**
- * \fn static uint16_t sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr)
+ * \fn static uint16_t sn_coap_protocol_hash(const uint8_t *addr_ptr, uint8_t addr_len, uint16_t port, uint16_t msg_id)
  *
- * \brief Counts total message size of all messages in linked list
+ * \brief Hashes message key for resending and duplication hash tables (FNV-1a)
  *
- * \param const coap_send_msg_list_t *linked_list_ptr pointer to linked list
+ * \param *addr_ptr is pointer to Address key
+ * \param addr_len is length of Address key
+ * \param port is Port key
+ * \param msg_id is Message ID key
+ *
+ * \return Hash value, to be masked with hash table size
  *****************************************************************************/
-static uint16_t sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr)
+static uint16_t sn_coap_protocol_hash(const uint8_t *addr_ptr, uint8_t addr_len, uint16_t port, uint16_t msg_id)
 {
-    uint16_t total_size = 0;
+    uint32_t hash = 2166136261u;
+    uint8_t i;
 
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, linked_list_ptr) {
-        if (stored_msg_ptr->send_msg_ptr) {
-            total_size += stored_msg_ptr->send_msg_ptr->packet_len;
-        }
+    for (i = 0; i < addr_len; i++) {
+        hash = (hash ^ addr_ptr[i]) * 16777619u;
     }
+    hash = (hash ^ port) * 16777619u;
+    hash = (hash ^ msg_id) * 16777619u;
 
-    return total_size;
+    return (uint16_t)(hash ^ (hash >> 16));
 }
-
 #endif
 
 #if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
@@ -1510,6 +1727,63 @@ void sn_coap_protocol_block_remove(struct coap_s *handle, sn_nsdl_addr_s *source
         }
     }
 }
+/**************************************************************************//**
+ * \fn static int8_t sn_coap_protocol_blockwise_msg_read_block(struct coap_s *handle, coap_blockwise_msg_s *stored_blockwise_msg_ptr, sn_nsdl_addr_s *addr_ptr, uint32_t block_number, uint16_t block_size, void *param)
+ *
+ * \brief Sets payload of stored blockwise message to the given block. Blocks of streamed
+ *        messages are read from the block source to allocated memory, which caller frees.
+ *
+ * \param *stored_blockwise_msg_ptr is pointer to stored blockwise message, payload of which is replaced
+ * \param *addr_ptr is pointer to address of the peer
+ * \param block_number is number of the block
+ * \param block_size is size of the block
+ * \param param is passed to the block source
+ *
+ * \return 1 if more blocks follow, 0 for the last block, -1 if the block can not be read
+ *****************************************************************************/
+static int8_t sn_coap_protocol_blockwise_msg_read_block(struct coap_s *handle, coap_blockwise_msg_s *stored_blockwise_msg_ptr,
+        sn_nsdl_addr_s *addr_ptr, uint32_t block_number, uint16_t block_size, void *param)
+{
+    sn_coap_hdr_s *coap_msg_ptr = stored_blockwise_msg_ptr->coap_msg_ptr;
+    uint32_t whole_payload_len = coap_msg_ptr->payload_len;
+    uint32_t offset = (uint32_t)block_size * block_number;
+    uint16_t block_len = block_size;
+    int8_t more = 1;
+
+    if (stored_blockwise_msg_ptr->stream_len) {
+        whole_payload_len = stored_blockwise_msg_ptr->stream_len;
+    }
+
+    if (offset >= whole_payload_len) {
+        return -1;
+    }
+
+    if (whole_payload_len - offset <= block_size) {
+        block_len = whole_payload_len - offset;
+        more = 0;
+    }
+
+    if (!stored_blockwise_msg_ptr->stream_len) {
+        coap_msg_ptr->payload_ptr += offset;
+        coap_msg_ptr->payload_len = block_len;
+        return more;
+    }
+
+    uint8_t *block_ptr = handle->sn_coap_protocol_malloc(block_len);
+    if (!block_ptr) {
+        return -1;
+    }
+
+    if (handle->sn_coap_block_source(coap_msg_ptr, addr_ptr, offset, block_ptr, block_len, param) != block_len) {
+        handle->sn_coap_protocol_free(block_ptr);
+        return -1;
+    }
+
+    coap_msg_ptr->payload_ptr = block_ptr;
+    coap_msg_ptr->payload_len = block_len;
+    return more;
+}
+
 /**************************************************************************//**
  * \fn static int8_t sn_coap_handle_blockwise_message(void)
  *
@@ -1529,6 +1803,8 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 
     uint16_t original_payload_len = 0;
     uint8_t *original_payload_ptr = NULL;
+    int8_t more_blocks = 0;
+    bool block_rejected = false;
 
     /* Block1 Option in a request (e.g., PUT or POST) */
     // Blocked request sending, received ACK, sending next block..
@@ -1577,23 +1853,27 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     original_payload_len = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len;
                     original_payload_ptr = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_ptr;
 
-                    if ((block_size * (block_number + 1)) > stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len) {
-                        src_coap_blockwise_ack_msg_ptr->payload_len = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len - (block_size * (block_number));
-                        src_coap_blockwise_ack_msg_ptr->payload_ptr = src_coap_blockwise_ack_msg_ptr->payload_ptr + (block_size * block_number);
+                    more_blocks = sn_coap_protocol_blockwise_msg_read_block(handle, stored_blockwise_msg_temp_ptr, src_addr_ptr, block_number, block_size, param);
+                    if (more_blocks < 0) {
+                        tr_debug("sn_coap_handle_blockwise_message - block1 request, block %d not available", block_number);
+                        sn_coap_protocol_linked_list_blockwise_msg_remove(handle, stored_blockwise_msg_temp_ptr);
+                        received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED;
+                        return received_coap_msg_ptr;
                     }
 
                     /* Not last block */
-                    else {
+                    if (more_blocks) {
                         /* set more - bit */
                         src_coap_blockwise_ack_msg_ptr->options_list_ptr->block1 |= 0x08;
-                        src_coap_blockwise_ack_msg_ptr->payload_len = block_size;
-                        src_coap_blockwise_ack_msg_ptr->payload_ptr = src_coap_blockwise_ack_msg_ptr->payload_ptr + (block_size * block_number);
                     }
                     /* Build and send block message */
                     dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
 
                     dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
                     if (!dst_ack_packet_data_ptr) {
+                        if (stored_blockwise_msg_temp_ptr->stream_len) {
+                            handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->payload_ptr);
+                        }
                         handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
                         src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
                         handle->sn_coap_protocol_free(original_payload_ptr);
@@ -1616,6 +1896,9 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
                     dst_ack_packet_data_ptr = 0;
 
+                    if (stored_blockwise_msg_temp_ptr->stream_len) {
+                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->payload_ptr);
+                    }
                     stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len = original_payload_len;
                     stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_ptr = original_payload_ptr;
 
@@ -1636,10 +1919,17 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 received_coap_msg_ptr->payload_len = handle->sn_coap_block_data_size;
             }
 
-            sn_coap_protocol_linked_list_blockwise_payload_store(handle, src_addr_ptr, received_coap_msg_ptr->payload_len, received_coap_msg_ptr->payload_ptr);
-            /* If not last block (more value is set) */
+            /* Pass block to the sink, or store it until the whole payload is received */
+            if (handle->sn_coap_block_sink) {
+                block_temp = received_coap_msg_ptr->options_list_ptr->block1 & 0x07;
+                block_rejected = handle->sn_coap_block_sink(received_coap_msg_ptr, src_addr_ptr,
+                                 (uint32_t)(received_coap_msg_ptr->options_list_ptr->block1 >> 4) << (block_temp + 4), param) < 0;
+            } else {
+                sn_coap_protocol_linked_list_blockwise_payload_store(handle, src_addr_ptr, received_coap_msg_ptr->payload_len, received_coap_msg_ptr->payload_ptr);
+            }
+            /* If not last block (more value is set), or block is rejected */
             /* Block option length can be 1-3 bytes. First 4-20 bits are for block number. Last 4 bits are ALWAYS more bit + block size. */
-            if (received_coap_msg_ptr->options_list_ptr->block1 & 0x08) {
+            if ((received_coap_msg_ptr->options_list_ptr->block1 & 0x08) || block_rejected) {
                 tr_debug("sn_coap_handle_blockwise_message - block1 received, send ack");
                 src_coap_blockwise_ack_msg_ptr = sn_coap_parser_alloc_message(handle);
                 if (src_coap_blockwise_ack_msg_ptr == NULL) {
@@ -1657,7 +1947,9 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 // Response with COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE if the payload size is more than we can handle
                 tr_debug("sn_coap_handle_blockwise_message - block1 received - incoming size: [%d]", received_coap_msg_ptr->options_list_ptr->size1);
                 uint32_t max_size = SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE;
-                if (received_coap_msg_ptr->options_list_ptr->size1 > max_size) {
+                if (block_rejected) {
+                    src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_INTERNAL_SERVER_ERROR;
+                } else if (received_coap_msg_ptr->options_list_ptr->size1 > max_size) {
                     // Include maximum size that stack can handle into response
                     src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
                     src_coap_blockwise_ack_msg_ptr->options_list_ptr->size1 = max_size;
@@ -1704,8 +1996,18 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
                 dst_ack_packet_data_ptr = 0;
 
-                received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING;
+                if (block_rejected) {
+                    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED;
+                } else {
+                    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING;
+                }
 
+            } else if (handle->sn_coap_block_sink) {
+                tr_debug("sn_coap_handle_blockwise_message - block1 received, last block passed to sink");
+                /* Whole payload is already with the sink */
+                received_coap_msg_ptr->payload_ptr = NULL;
+                received_coap_msg_ptr->payload_len = 0;
+                received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED;
             } else {
                 tr_debug("sn_coap_handle_blockwise_message - block1 received, last block received");
                 /* * * This is the last block when whole Blockwise payload from received * * */
@@ -1752,9 +2054,19 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
             tr_debug("sn_coap_handle_blockwise_message - send block2 request");
             uint32_t block_number = 0;
 
-            /* Store blockwise payload to Linked list */
-            //todo: add block number to stored values - just to make sure all packets are in order
-            sn_coap_protocol_linked_list_blockwise_payload_store(handle, src_addr_ptr, received_coap_msg_ptr->payload_len, received_coap_msg_ptr->payload_ptr);
+            /* Pass block to the sink, or store blockwise payload to Linked list */
+            if (handle->sn_coap_block_sink) {
+                block_temp = received_coap_msg_ptr->options_list_ptr->block2 & 0x07;
+                if (handle->sn_coap_block_sink(received_coap_msg_ptr, src_addr_ptr,
+                                               (uint32_t)(received_coap_msg_ptr->options_list_ptr->block2 >> 4) << (block_temp + 4), param) < 0) {
+                    tr_debug("sn_coap_handle_blockwise_message - block2 rejected by sink");
+                    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED;
+                    return received_coap_msg_ptr;
+                }
+            } else {
+                //todo: add block number to stored values - just to make sure all packets are in order
+                sn_coap_protocol_linked_list_blockwise_payload_store(handle, src_addr_ptr, received_coap_msg_ptr->payload_len, received_coap_msg_ptr->payload_ptr);
+            }
 
             /* If not last block (more value is set) */
             if (received_coap_msg_ptr->options_list_ptr->block2 & 0x08) {
@@ -1774,7 +2086,8 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     return 0;
                 }
 
-                src_coap_blockwise_ack_msg_ptr = sn_coap_parser_alloc_message(handle);
+                /* Next request asks the same resource as the previous one */
+                src_coap_blockwise_ack_msg_ptr = sn_coap_protocol_copy_header(handle, previous_blockwise_msg_ptr->coap_msg_ptr);
                 if (src_coap_blockwise_ack_msg_ptr == NULL) {
                     return 0;
                 }
@@ -1794,7 +2107,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 /* * * Then build CoAP Acknowledgement message * * */
 
                 if (sn_coap_parser_alloc_options(handle, src_coap_blockwise_ack_msg_ptr) == NULL) {
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+                    sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
                     src_coap_blockwise_ack_msg_ptr = 0;
                     sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
                     return NULL;
@@ -1820,9 +2133,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
 
                 if (dst_ack_packet_data_ptr == NULL) {
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                    src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+                    sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
                     src_coap_blockwise_ack_msg_ptr = 0;
                     sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
                     return NULL;
@@ -1833,9 +2144,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 if ((sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size)) < 0) {
                     handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
                     dst_ack_packet_data_ptr = 0;
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                    src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+                    sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
                     src_coap_blockwise_ack_msg_ptr = 0;
                     sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
                     return NULL;
@@ -1848,9 +2157,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 if (!stored_blockwise_msg_ptr) {
                     handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
                     dst_ack_packet_data_ptr = 0;
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
-                    src_coap_blockwise_ack_msg_ptr->options_list_ptr = 0;
-                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
+                    sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
                     src_coap_blockwise_ack_msg_ptr = 0;
                     sn_coap_parser_release_allocated_coap_msg_mem(handle, received_coap_msg_ptr);
                     return 0;
@@ -1878,6 +2185,13 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 dst_ack_packet_data_ptr = 0;
             }
 
+            //Last block received, whole payload is already with the sink
+            else if (handle->sn_coap_block_sink) {
+                received_coap_msg_ptr->payload_ptr = NULL;
+                received_coap_msg_ptr->payload_len = 0;
+                received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED;
+            }
+
             //Last block received
             else {
                 /* * * This is the last block when whole Blockwise payload from received * * */
@@ -1951,16 +2265,18 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 original_payload_len = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len;
                 original_payload_ptr = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_ptr;
 
-                if ((block_size * (block_number + 1)) > stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len) {
-                    src_coap_blockwise_ack_msg_ptr->payload_len = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len - (block_size * block_number);
-                    src_coap_blockwise_ack_msg_ptr->payload_ptr = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_ptr + (block_size * block_number);
+                more_blocks = sn_coap_protocol_blockwise_msg_read_block(handle, stored_blockwise_msg_temp_ptr, src_addr_ptr, block_number, block_size, param);
+                if (more_blocks < 0) {
+                    tr_debug("sn_coap_handle_blockwise_message - block2 received, block %d not available", block_number);
+                    sn_coap_protocol_linked_list_blockwise_msg_remove(handle, stored_blockwise_msg_temp_ptr);
+                    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED;
+                    return received_coap_msg_ptr;
                 }
+
                 /* Not last block */
-                else {
+                if (more_blocks) {
                     /* set more - bit */
                     src_coap_blockwise_ack_msg_ptr->options_list_ptr->block2 |= 0x08;
-                    src_coap_blockwise_ack_msg_ptr->payload_len = block_size;
-                    src_coap_blockwise_ack_msg_ptr->payload_ptr = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_ptr + (block_size * block_number);
                 }
 
                 /* Build and send block message */
@@ -1968,6 +2284,9 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 
                 dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
                 if (!dst_ack_packet_data_ptr) {
+                    if (stored_blockwise_msg_temp_ptr->stream_len) {
+                        handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->payload_ptr);
+                    }
                     if(original_payload_ptr){
                         handle->sn_coap_protocol_free(original_payload_ptr);
                         original_payload_ptr = NULL;
@@ -1986,10 +2305,13 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
                 dst_ack_packet_data_ptr = 0;
 
+                if (stored_blockwise_msg_temp_ptr->stream_len) {
+                    handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->payload_ptr);
+                }
                 stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len = original_payload_len;
                 stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_ptr = original_payload_ptr;
 
-                if ((block_size * (block_number + 1)) > stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len) {
+                if (!more_blocks) {
                     sn_coap_protocol_linked_list_blockwise_msg_remove(handle, stored_blockwise_msg_temp_ptr);
                 }
 
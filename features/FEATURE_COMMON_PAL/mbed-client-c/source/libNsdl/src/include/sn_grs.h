@@ -48,6 +48,21 @@ typedef struct sn_grs_version_ {
 
 typedef NS_LIST_HEAD(sn_nsdl_resource_info_s, link) resource_list_t;
 
+/* Resource index node, one for each path segment in use. Nodes form a trie
+ * of path segments and are also hashed by their full path. */
+typedef struct sn_grs_index_node_ {
+    struct sn_grs_index_node_   *parent;
+    struct sn_grs_index_node_   *child;         /* First subsegment */
+    struct sn_grs_index_node_   *prev;          /* Sibling segments */
+    struct sn_grs_index_node_   *next;
+    struct sn_grs_index_node_   *hash_next;
+    sn_nsdl_resource_info_s     *resource;      /* Resource at this path, or NULL */
+    uint8_t                     *segment;
+    uint32_t                    hash;           /* Hash of the full path */
+    uint16_t                    pathlen;        /* Length of the full path */
+    uint16_t                    segment_len;
+} sn_grs_index_node_s;
+
 struct grs_s {
     struct coap_s *coap;
 
@@ -58,6 +73,12 @@ struct grs_s {
 
     uint16_t resource_root_count;
     resource_list_t resource_root_list;
+
+    sn_grs_index_node_s **index_table;
+    sn_grs_index_node_s *index_root;            /* Top level segments */
+    uint16_t index_table_size;
+    uint16_t index_node_count;
+    uint16_t index_resource_count;
 };
 
 
@@ -39,6 +39,15 @@
 #define WELLKNOWN_PATH_LEN              16
 #define WELLKNOWN_PATH                  (".well-known/core")
 
+/* Resource index hash table sizes, the table doubles when there are more
+ * nodes than buckets */
+#define SN_GRS_INDEX_MIN_SIZE           16
+#define SN_GRS_INDEX_MAX_SIZE           4096
+
+/* FNV-1a */
+#define SN_GRS_INDEX_HASH_INIT          2166136261u
+#define SN_GRS_INDEX_HASH_STEP(h, c)    (((h) ^ (uint8_t)(c)) * 16777619u)
+
 /* Local static function prototypes */
 static int8_t                       sn_grs_resource_info_free(struct grs_s *handle, sn_nsdl_resource_info_s *resource_ptr);
 static uint8_t                     *sn_grs_convert_uri(uint16_t *uri_len, uint8_t *uri_ptr);
@@ -46,6 +55,10 @@ static int8_t                       sn_grs_add_resource_to_list(struct grs_s *ha
 static int8_t                       sn_grs_core_request(struct nsdl_s *handle, sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *coap_packet_ptr);
 static uint8_t                      coap_tx_callback(uint8_t *, uint16_t, sn_nsdl_addr_s *, void *);
 static int8_t                       coap_rx_callback(sn_coap_hdr_s *coap_ptr, sn_nsdl_addr_s *address_ptr, void *param);
+static int8_t                       sn_grs_index_insert(struct grs_s *handle, sn_nsdl_resource_info_s *resource_ptr);
+static void                         sn_grs_index_remove(struct grs_s *handle, sn_nsdl_resource_info_s *resource_ptr);
+static sn_grs_index_node_s         *sn_grs_index_find(struct grs_s *handle, uint16_t pathlen, const uint8_t *path);
+static void                         sn_grs_index_free(struct grs_s *handle);
 
 /* Extern function prototypes */
 extern int8_t                       sn_nsdl_build_registration_body(struct nsdl_s *handle, sn_coap_hdr_s *message_ptr, uint8_t updating_registeration);
@@ -65,6 +78,7 @@ extern int8_t sn_grs_destroy(struct grs_s *handle)
         --handle->resource_root_count;
         sn_grs_resource_info_free(handle, tmp);
     }
+    sn_grs_index_free(handle);
     handle->sn_grs_free(handle);
 
     return 0;
@@ -261,6 +275,7 @@ extern int8_t sn_grs_delete_resource(struct grs_s *handle, uint16_t pathlen, uin
         /* Remove from list */
         ns_list_remove(&handle->resource_root_list, resource_temp);
         --handle->resource_root_count;
+        sn_grs_index_remove(handle, resource_temp);
 
         /* Free */
         sn_grs_resource_info_free(handle, resource_temp);
@@ -366,6 +381,10 @@ int8_t sn_grs_put_resource(struct grs_s *handle, sn_nsdl_resource_info_s *res)
 
     res->is_put = true;
 
+    if (sn_grs_index_insert(handle, res) != SN_NSDL_SUCCESS) {
+        return SN_GRS_LIST_ADDING_FAILURE;
+    }
+
     ns_list_add_to_start(&handle->resource_root_list, res);
     ++handle->resource_root_count;
 
@@ -741,9 +760,11 @@ static int8_t sn_grs_core_request(struct nsdl_s *handle, sn_nsdl_addr_s *src_add
 /**
  * \fn  static sn_grs_resource_info_s *sn_grs_search_resource(uint16_t pathlen, uint8_t *path, uint8_t search_method)
  *
- * \brief Searches given resource from linked list
+ * \brief Searches given resource from the resource index
  *
  *  Search either precise path, or subresources, eg. dr/x -> returns dr/x/1, dr/x/2 etc...
+ *  Resources linked to the list without going through sn_grs_create_resource()
+ *  or sn_grs_put_resource() are not indexed, the list is scanned while there are any.
  *
  *  \param  pathlen         Length of the path to be search
  *
@@ -768,6 +789,25 @@ sn_nsdl_resource_info_s *sn_grs_search_resource(struct grs_s *handle, uint16_t p
     /* Remove '/' - marks from the end and beginning */
     path_temp_ptr = sn_grs_convert_uri(&pathlen, path);
 
+    if (handle->index_resource_count == handle->resource_root_count) {
+        sn_grs_index_node_s *node = sn_grs_index_find(handle, pathlen, path_temp_ptr);
+        if (!node) {
+            return NULL;
+        }
+
+        if (search_method == SN_GRS_SEARCH_METHOD) {
+            return node->resource;
+        } else if (search_method == SN_GRS_DELETE_METHOD) {
+            /* Empty nodes are pruned, so every leaf below holds a resource */
+            for (node = node->child; node; node = node->child) {
+                if (node->resource) {
+                    return node->resource;
+                }
+            }
+        }
+        return NULL;
+    }
+
     /* Searchs exact path */
     if (search_method == SN_GRS_SEARCH_METHOD) {
         /* Scan all nodes on list */
@@ -919,6 +959,11 @@ static int8_t sn_grs_add_resource_to_list(struct grs_s *handle, sn_nsdl_resource
                 */
     }
 
+    if (sn_grs_index_insert(handle, resource_copy_ptr) != SN_NSDL_SUCCESS) {
+        sn_grs_resource_info_free(handle, resource_copy_ptr);
+        return SN_NSDL_FAILURE;
+    }
+
     /* Add copied resource to the linked list */
     ns_list_add_to_start(&handle->resource_root_list, resource_copy_ptr);
     ++handle->resource_root_count;
@@ -952,7 +997,7 @@ static uint8_t *sn_grs_convert_uri(uint16_t *uri_len, uint8_t *uri_ptr)
     }
 
     /* If '/' at the end, update uri len */
-    if (*(uri_start_ptr + *uri_len - 1) == '/') {
+    if (*uri_len && *(uri_start_ptr + *uri_len - 1) == '/') {
         *uri_len = *uri_len - 1;
     }
 
@@ -1016,6 +1061,286 @@ static int8_t sn_grs_resource_info_free(struct grs_s *handle, sn_nsdl_resource_i
     return SN_NSDL_FAILURE; //Dead code?
 }
 
+/**
+ * \fn  static bool sn_grs_index_path_equals(const sn_grs_index_node_s *node, uint16_t pathlen, const uint8_t *path)
+ *
+ * \brief Compares the full path of an index node, from the node up to the top level segment
+ *
+ *  \return true if the node is at the given path
+ *
+*/
+static bool sn_grs_index_path_equals(const sn_grs_index_node_s *node, uint16_t pathlen, const uint8_t *path)
+{
+    uint16_t end = pathlen;
+
+    if (node->pathlen != pathlen) {
+        return false;
+    }
+
+    while (true) {
+        if (node->segment_len > end) {
+            return false;
+        }
+        end -= node->segment_len;
+        if (memcmp(path + end, node->segment, node->segment_len) != 0) {
+            return false;
+        }
+
+        node = node->parent;
+        if (!node) {
+            return end == 0;
+        }
+        if (end == 0 || path[--end] != '/') {
+            return false;
+        }
+    }
+}
+
+static sn_grs_index_node_s *sn_grs_index_lookup(struct grs_s *handle, uint16_t pathlen, const uint8_t *path, uint32_t hash)
+{
+    sn_grs_index_node_s *node;
+
+    if (!handle->index_table) {
+        return NULL;
+    }
+
+    for (node = handle->index_table[hash & (handle->index_table_size - 1)]; node; node = node->hash_next) {
+        if (node->hash == hash && sn_grs_index_path_equals(node, pathlen, path)) {
+            return node;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \fn  static sn_grs_index_node_s *sn_grs_index_find(struct grs_s *handle, uint16_t pathlen, const uint8_t *path)
+ *
+ * \brief Finds the index node of a path
+ *
+ *  \return Pointer to the node, NULL if no resource is at or below the path
+ *
+*/
+static sn_grs_index_node_s *sn_grs_index_find(struct grs_s *handle, uint16_t pathlen, const uint8_t *path)
+{
+    uint32_t hash = SN_GRS_INDEX_HASH_INIT;
+    uint16_t i;
+
+    for (i = 0; i < pathlen; i++) {
+        hash = SN_GRS_INDEX_HASH_STEP(hash, path[i]);
+    }
+
+    return sn_grs_index_lookup(handle, pathlen, path, hash);
+}
+
+/**
+ * \fn  static void sn_grs_index_resize(struct grs_s *handle, uint16_t size)
+ *
+ * \brief Rehashes the index nodes to a table of the given size
+ *
+ *  If the new table can not be allocated, the old one is kept.
+ *
+*/
+static void sn_grs_index_resize(struct grs_s *handle, uint16_t size)
+{
+    sn_grs_index_node_s **table;
+    uint16_t i;
+
+    table = handle->sn_grs_alloc(size * sizeof(sn_grs_index_node_s *));
+    if (!table) {
+        return;
+    }
+    memset(table, 0, size * sizeof(sn_grs_index_node_s *));
+
+    for (i = 0; i < handle->index_table_size; i++) {
+        sn_grs_index_node_s *node = handle->index_table[i];
+        while (node) {
+            sn_grs_index_node_s *next = node->hash_next;
+            node->hash_next = table[node->hash & (size - 1)];
+            table[node->hash & (size - 1)] = node;
+            node = next;
+        }
+    }
+
+    if (handle->index_table) {
+        handle->sn_grs_free(handle->index_table);
+    }
+    handle->index_table = table;
+    handle->index_table_size = size;
+}
+
+static sn_grs_index_node_s *sn_grs_index_add_node(struct grs_s *handle, sn_grs_index_node_s *parent,
+                                                  const uint8_t *segment, uint16_t segment_len,
+                                                  uint16_t pathlen, uint32_t hash)
+{
+    sn_grs_index_node_s *node;
+    sn_grs_index_node_s **first = parent ? &parent->child : &handle->index_root;
+
+    if (handle->index_node_count == UINT16_MAX ||
+            segment_len > UINT16_MAX - sizeof(sn_grs_index_node_s)) {
+        return NULL;
+    }
+
+    if (!handle->index_table) {
+        sn_grs_index_resize(handle, SN_GRS_INDEX_MIN_SIZE);
+        if (!handle->index_table) {
+            return NULL;
+        }
+    } else if (handle->index_node_count >= handle->index_table_size &&
+               handle->index_table_size < SN_GRS_INDEX_MAX_SIZE) {
+        sn_grs_index_resize(handle, handle->index_table_size * 2);
+    }
+
+    /* Segment is stored right after the node */
+    node = handle->sn_grs_alloc(sizeof(sn_grs_index_node_s) + segment_len);
+    if (!node) {
+        return NULL;
+    }
+    memset(node, 0, sizeof(sn_grs_index_node_s));
+
+    node->segment = (uint8_t *)(node + 1);
+    memcpy(node->segment, segment, segment_len);
+    node->segment_len = segment_len;
+    node->pathlen = pathlen;
+    node->hash = hash;
+
+    node->parent = parent;
+    node->next = *first;
+    if (node->next) {
+        node->next->prev = node;
+    }
+    *first = node;
+
+    node->hash_next = handle->index_table[hash & (handle->index_table_size - 1)];
+    handle->index_table[hash & (handle->index_table_size - 1)] = node;
+    ++handle->index_node_count;
+
+    return node;
+}
+
+/**
+ * \fn  static void sn_grs_index_prune(struct grs_s *handle, sn_grs_index_node_s *node)
+ *
+ * \brief Frees the node and its parents, up to the first one with a resource or other subsegments
+ *
+*/
+static void sn_grs_index_prune(struct grs_s *handle, sn_grs_index_node_s *node)
+{
+    while (node && !node->resource && !node->child) {
+        sn_grs_index_node_s *parent = node->parent;
+        sn_grs_index_node_s **link;
+
+        if (node->prev) {
+            node->prev->next = node->next;
+        } else if (parent) {
+            parent->child = node->next;
+        } else {
+            handle->index_root = node->next;
+        }
+        if (node->next) {
+            node->next->prev = node->prev;
+        }
+
+        link = &handle->index_table[node->hash & (handle->index_table_size - 1)];
+        while (*link != node) {
+            link = &(*link)->hash_next;
+        }
+        *link = node->hash_next;
+        --handle->index_node_count;
+
+        handle->sn_grs_free(node);
+        node = parent;
+    }
+}
+
+/**
+ * \fn  static int8_t sn_grs_index_insert(struct grs_s *handle, sn_nsdl_resource_info_s *resource_ptr)
+ *
+ * \brief Adds a resource to the index, creating the nodes of its path segments
+ *
+ *  \return 0 = SN_NSDL_SUCCESS, -1 = SN_NSDL_FAILURE
+ *
+*/
+static int8_t sn_grs_index_insert(struct grs_s *handle, sn_nsdl_resource_info_s *resource_ptr)
+{
+    const uint8_t *path = resource_ptr->path;
+    uint16_t pathlen = resource_ptr->pathlen;
+    sn_grs_index_node_s *node = NULL;
+    uint32_t hash = SN_GRS_INDEX_HASH_INIT;
+    uint32_t start = 0;
+    uint32_t i;
+
+    if (handle->index_resource_count == UINT16_MAX) {
+        return SN_NSDL_FAILURE;
+    }
+
+    /* Find or create the node of each path prefix ending at a segment */
+    for (i = 0; i <= pathlen; i++) {
+        if (i < pathlen && path[i] != '/') {
+            hash = SN_GRS_INDEX_HASH_STEP(hash, path[i]);
+            continue;
+        }
+
+        sn_grs_index_node_s *prefix = sn_grs_index_lookup(handle, i, path, hash);
+        if (!prefix) {
+            prefix = sn_grs_index_add_node(handle, node, path + start, i - start, i, hash);
+            if (!prefix) {
+                sn_grs_index_prune(handle, node);
+                return SN_NSDL_FAILURE;
+            }
+        }
+        node = prefix;
+
+        hash = SN_GRS_INDEX_HASH_STEP(hash, '/');
+        start = i + 1;
+    }
+
+    if (node->resource) {
+        return SN_NSDL_FAILURE;
+    }
+    node->resource = resource_ptr;
+    ++handle->index_resource_count;
+
+    return SN_NSDL_SUCCESS;
+}
+
+static void sn_grs_index_remove(struct grs_s *handle, sn_nsdl_resource_info_s *resource_ptr)
+{
+    sn_grs_index_node_s *node = sn_grs_index_find(handle, resource_ptr->pathlen, resource_ptr->path);
+
+    /* Resources linked to the list directly are not indexed */
+    if (!node || node->resource != resource_ptr) {
+        return;
+    }
+
+    node->resource = NULL;
+    --handle->index_resource_count;
+    sn_grs_index_prune(handle, node);
+}
+
+static void sn_grs_index_free(struct grs_s *handle)
+{
+    uint16_t i;
+
+    for (i = 0; i < handle->index_table_size; i++) {
+        sn_grs_index_node_s *node = handle->index_table[i];
+        while (node) {
+            sn_grs_index_node_s *next = node->hash_next;
+            handle->sn_grs_free(node);
+            node = next;
+        }
+    }
+
+    if (handle->index_table) {
+        handle->sn_grs_free(handle->index_table);
+    }
+    handle->index_table = NULL;
+    handle->index_root = NULL;
+    handle->index_table_size = 0;
+    handle->index_node_count = 0;
+    handle->index_resource_count = 0;
+}
+
 void sn_grs_mark_resources_as_registered(struct nsdl_s *handle)
 {
     if( !handle ){
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2016 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host benchmark of the CoAP parser and builder. Parses and rebuilds an
+ * LWM2M style read request, once through the heap allocating
+ * sn_coap_parser()/sn_coap_builder() and once through the arena based
+ * sn_coap_parser_view()/sn_coap_builder_view(), reporting the cost and the
+ * heap allocations per message.
+ *
+ * With a fast host malloc the two parsers take about the same time; what the
+ * view parser saves is the allocations. The view builder is roughly four
+ * times faster, as it copies options straight from the parsed datagram.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ns_types.h"
+#include "sn_nsdl.h"
+#include "sn_coap_header.h"
+#include "sn_coap_protocol_internal.h"
+
+// Benchmark setup
+#define BENCH_MESSAGES      200000
+#define BENCH_ARENA_SIZE    256
+
+static unsigned allocations;
+
+static void *bench_alloc(uint16_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+static void bench_free(void *ptr)
+{
+    free(ptr);
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// GET 3303/0/5700?pmin=10&pmax=60 with Accept and a token
+static int16_t build_request(uint8_t *packet, uint16_t packet_len)
+{
+    static uint8_t token[] = {0x12, 0x34, 0x56, 0x78};
+    static uint8_t path[] = "3303/0/5700";
+    static uint8_t query[] = "pmin=10&pmax=60";
+    sn_coap_hdr_s hdr;
+    sn_coap_options_list_s options;
+
+    sn_coap_parser_init_message(&hdr);
+    memset(&options, 0, sizeof(options));
+    options.max_age = COAP_OPTION_MAX_AGE_DEFAULT;
+    options.uri_port = COAP_OPTION_URI_PORT_NONE;
+    options.observe = COAP_OBSERVE_NONE;
+    options.accept = COAP_CT_TEXT_PLAIN;
+    options.block1 = COAP_OPTION_BLOCK_NONE;
+    options.block2 = COAP_OPTION_BLOCK_NONE;
+    options.uri_query_ptr = query;
+    options.uri_query_len = sizeof(query) - 1;
+
+    hdr.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    hdr.msg_code = COAP_MSG_CODE_REQUEST_GET;
+    hdr.msg_id = 1;
+    hdr.token_ptr = token;
+    hdr.token_len = sizeof(token);
+    hdr.uri_path_ptr = path;
+    hdr.uri_path_len = sizeof(path) - 1;
+    hdr.options_list_ptr = &options;
+
+    if (sn_coap_builder_calc_needed_packet_data_size(&hdr) > packet_len) {
+        return -1;
+    }
+
+    return sn_coap_builder(packet, &hdr);
+}
+
+static void report(const char *name, uint64_t parse_ns, uint64_t build_ns)
+{
+    printf("%-6s parse %7.1f ns, build %7.1f ns, %5.2f allocations per message\r\n",
+           name,
+           (double)parse_ns / BENCH_MESSAGES,
+           (double)build_ns / BENCH_MESSAGES,
+           (double)allocations / BENCH_MESSAGES);
+}
+
+static int bench_heap(uint8_t *packet, uint16_t packet_len)
+{
+    struct coap_s handle;
+    coap_version_e version;
+    uint8_t out[64];
+    uint64_t parse_ns = 0;
+    uint64_t build_ns = 0;
+
+    memset(&handle, 0, sizeof(handle));
+    handle.sn_coap_protocol_malloc = bench_alloc;
+    handle.sn_coap_protocol_free = bench_free;
+    allocations = 0;
+
+    for (unsigned i = 0; i < BENCH_MESSAGES; i++) {
+        uint64_t start = now_ns();
+        sn_coap_hdr_s *hdr = sn_coap_parser(&handle, packet_len, packet, &version);
+        if (!hdr || hdr->coap_status != COAP_STATUS_OK) {
+            printf("heap parse failed\r\n");
+            return -1;
+        }
+        uint64_t parsed = now_ns();
+
+        // The builder needs the size first for the destination
+        int16_t len = -1;
+        if (sn_coap_builder_calc_needed_packet_data_size(hdr) <= sizeof(out)) {
+            len = sn_coap_builder(out, hdr);
+        }
+        build_ns += now_ns() - parsed;
+        parse_ns += parsed - start;
+
+        sn_coap_parser_release_allocated_coap_msg_mem(&handle, hdr);
+        if (len != packet_len || memcmp(out, packet, len)) {
+            printf("heap build failed\r\n");
+            return -1;
+        }
+    }
+
+    report("heap", parse_ns, build_ns);
+    return 0;
+}
+
+static int bench_view(uint8_t *packet, uint16_t packet_len)
+{
+    uint8_t arena[BENCH_ARENA_SIZE];
+    coap_version_e version;
+    uint8_t out[64];
+    uint64_t parse_ns = 0;
+    uint64_t build_ns = 0;
+
+    allocations = 0;
+
+    for (unsigned i = 0; i < BENCH_MESSAGES; i++) {
+        uint64_t start = now_ns();
+        sn_coap_msg_view_s *msg = sn_coap_parser_view(packet_len, packet, &version, arena, sizeof(arena));
+        if (!msg || msg->hdr.coap_status != COAP_STATUS_OK) {
+            printf("view parse failed\r\n");
+            return -1;
+        }
+        uint64_t parsed = now_ns();
+
+        int16_t len = sn_coap_builder_view(out, sizeof(out), &msg->hdr, msg->option_views_ptr, msg->option_count, msg->packet_data_ptr);
+        build_ns += now_ns() - parsed;
+        parse_ns += parsed - start;
+
+        if (len != packet_len || memcmp(out, packet, len)) {
+            printf("view build failed\r\n");
+            return -1;
+        }
+    }
+
+    report("view", parse_ns, build_ns);
+    return 0;
+}
+
+int main(void)
+{
+    uint8_t packet[64];
+    int16_t packet_len = build_request(packet, sizeof(packet));
+    if (packet_len < 0) {
+        printf("building request failed\r\n");
+        return 1;
+    }
+
+    printf("%d byte request, %d messages\r\n", packet_len, BENCH_MESSAGES);
+
+    if (bench_heap(packet, packet_len) < 0 || bench_view(packet, packet_len) < 0) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2017 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host loopback test of streamed blockwise transfers. A client and a server
+ * handle exchange messages through an in-memory queue, with both block sink
+ * and block source set:
+ *
+ * - Block1: the client PUTs a payload with sn_coap_protocol_send_stream(),
+ *   and the server receives it through its sink.
+ * - Block2: the client GETs the resource, the server answers with
+ *   sn_coap_protocol_send_stream(), and the client receives it through its
+ *   sink. The follow-up requests for the later blocks are built by the
+ *   library from the original request, and must still ask for the same
+ *   resource.
+ *
+ * Checks that the payloads arrive intact, that no heap is left allocated,
+ * and reports the peak heap used by each transfer.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ns_types.h"
+#include "sn_nsdl.h"
+#include "sn_coap_header.h"
+#include "sn_coap_protocol.h"
+#include "sn_coap_protocol_internal.h"
+
+// Test setup
+#define STREAM_PAYLOAD_SIZE 20000
+#define STREAM_QUEUE_SIZE   64
+#define STREAM_PACKET_SIZE  256
+
+static uint8_t source_data[STREAM_PAYLOAD_SIZE];
+static uint8_t sink_data[STREAM_PAYLOAD_SIZE];
+static uint32_t sink_bytes;
+
+static struct coap_s *client;
+static struct coap_s *server;
+static uint8_t client_ip[16] = {1};
+static uint8_t server_ip[16] = {2};
+static sn_nsdl_addr_s client_addr = {16, SN_NSDL_ADDRESS_TYPE_IPV6, 1, client_ip};
+static sn_nsdl_addr_s server_addr = {16, SN_NSDL_ADDRESS_TYPE_IPV6, 2, server_ip};
+
+static uint8_t resource_path[] = "fw";
+
+// Heap accounting; the size is kept in front of each block
+static unsigned heap_blocks;
+static size_t heap_used;
+static size_t heap_peak;
+
+static void *stream_alloc(uint16_t size)
+{
+    size_t *block = malloc(sizeof(size_t) + size);
+    if (!block) {
+        return NULL;
+    }
+
+    *block = size;
+    heap_blocks++;
+    heap_used += size;
+    if (heap_used > heap_peak) {
+        heap_peak = heap_used;
+    }
+    return block + 1;
+}
+
+static void stream_free(void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    size_t *block = (size_t *)ptr - 1;
+    heap_blocks--;
+    heap_used -= *block;
+    free(block);
+}
+
+// Sent datagrams wait in a queue until pumped to the other handle
+static struct {
+    struct coap_s *to;
+    sn_nsdl_addr_s *from;
+    uint16_t len;
+    uint8_t data[STREAM_PACKET_SIZE];
+} queue[STREAM_QUEUE_SIZE];
+static unsigned queue_head;
+static unsigned queue_tail;
+
+static uint8_t stream_tx(uint8_t *data, uint16_t len, sn_nsdl_addr_s *addr, void *param)
+{
+    if (len > STREAM_PACKET_SIZE || queue_tail - queue_head >= STREAM_QUEUE_SIZE) {
+        printf("tx queue overflow\r\n");
+        exit(1);
+    }
+
+    unsigned i = queue_tail++ % STREAM_QUEUE_SIZE;
+    queue[i].to = (addr->port == server_addr.port) ? server : client;
+    queue[i].from = (addr->port == server_addr.port) ? &client_addr : &server_addr;
+    queue[i].len = len;
+    memcpy(queue[i].data, data, len);
+    return 1;
+}
+
+static int8_t stream_sink(sn_coap_hdr_s *msg, sn_nsdl_addr_s *addr, uint32_t offset, void *param)
+{
+    if (offset + msg->payload_len > STREAM_PAYLOAD_SIZE) {
+        return -1;
+    }
+
+    memcpy(sink_data + offset, msg->payload_ptr, msg->payload_len);
+    sink_bytes += msg->payload_len;
+    return 0;
+}
+
+static int16_t stream_source(sn_coap_hdr_s *msg, sn_nsdl_addr_s *addr, uint32_t offset, uint8_t *data, uint16_t len, void *param)
+{
+    if (offset + len > STREAM_PAYLOAD_SIZE) {
+        return -1;
+    }
+
+    memcpy(data, source_data + offset, len);
+    return len;
+}
+
+// What the application sees of each transfer
+static int client_status;
+static uint8_t client_code;
+static unsigned followup_requests;
+static unsigned bad_followup_requests;
+
+static void send_message(struct coap_s *handle, sn_nsdl_addr_s *addr, sn_coap_hdr_s *msg)
+{
+    uint8_t packet[STREAM_PACKET_SIZE];
+    if (sn_coap_builder_calc_needed_packet_data_size(msg) > sizeof(packet) ||
+            sn_coap_protocol_build(handle, addr, packet, msg, NULL) < 0) {
+        printf("building message failed\r\n");
+        exit(1);
+    }
+    stream_tx(packet, sn_coap_builder_calc_needed_packet_data_size(msg), addr, NULL);
+}
+
+static void server_receive(sn_coap_hdr_s *msg)
+{
+    if (msg->msg_code == COAP_MSG_CODE_REQUEST_GET && msg->options_list_ptr &&
+            msg->options_list_ptr->block2 != COAP_OPTION_BLOCK_NONE) {
+        // Follow-up request of a Block2 transfer, answered by the library
+        followup_requests++;
+        if (msg->uri_path_len != sizeof(resource_path) - 1 ||
+                memcmp(msg->uri_path_ptr, resource_path, msg->uri_path_len)) {
+            bad_followup_requests++;
+        }
+        return;
+    }
+
+    if (msg->coap_status == COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED) {
+        // Last block of the PUT
+        sn_coap_hdr_s *resp = sn_coap_build_response(server, msg, COAP_MSG_CODE_RESPONSE_CHANGED);
+        send_message(server, &client_addr, resp);
+        sn_coap_parser_release_allocated_coap_msg_mem(server, resp);
+    } else if (msg->coap_status == COAP_STATUS_OK && msg->msg_code == COAP_MSG_CODE_REQUEST_GET) {
+        sn_coap_hdr_s *resp = sn_coap_build_response(server, msg, COAP_MSG_CODE_RESPONSE_CONTENT);
+        if (sn_coap_protocol_send_stream(server, &client_addr, resp, STREAM_PAYLOAD_SIZE, NULL) < 0) {
+            printf("server send_stream failed\r\n");
+            exit(1);
+        }
+        sn_coap_parser_release_allocated_coap_msg_mem(server, resp);
+    }
+}
+
+static void pump(void)
+{
+    while (queue_head != queue_tail) {
+        unsigned i = queue_head++ % STREAM_QUEUE_SIZE;
+        struct coap_s *to = queue[i].to;
+
+        sn_coap_hdr_s *msg = sn_coap_protocol_parse(to, queue[i].from, queue[i].len, queue[i].data, NULL);
+        if (!msg) {
+            continue;
+        }
+
+        if (to == server) {
+            server_receive(msg);
+        } else if (msg->coap_status != COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING &&
+                   msg->coap_status != COAP_STATUS_PARSER_BLOCKWISE_ACK) {
+            client_status = msg->coap_status;
+            client_code = msg->msg_code;
+        }
+
+        if (msg->coap_status == COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED && msg->payload_ptr) {
+            printf("streamed message returned with payload\r\n");
+            exit(1);
+        }
+        sn_coap_parser_release_allocated_coap_msg_mem(to, msg);
+    }
+}
+
+static void init_request(sn_coap_hdr_s *msg, sn_coap_msg_code_e code)
+{
+    sn_coap_parser_init_message(msg);
+    msg->msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    msg->msg_code = code;
+    msg->uri_path_ptr = resource_path;
+    msg->uri_path_len = sizeof(resource_path) - 1;
+}
+
+static int check_transfer(const char *name, int sent)
+{
+    int ok = sent == 0 &&
+             sink_bytes == STREAM_PAYLOAD_SIZE &&
+             !memcmp(source_data, sink_data, STREAM_PAYLOAD_SIZE);
+
+    printf("%-6s %u bytes, peak heap %u bytes%s\r\n",
+           name, (unsigned)sink_bytes, (unsigned)heap_peak, ok ? "" : ", FAILED");
+
+    memset(sink_data, 0, sizeof(sink_data));
+    sink_bytes = 0;
+    heap_peak = heap_used;
+    return ok ? 0 : -1;
+}
+
+static int test_block1(void)
+{
+    sn_coap_hdr_s put;
+    init_request(&put, COAP_MSG_CODE_REQUEST_PUT);
+
+    int sent = sn_coap_protocol_send_stream(client, &server_addr, &put, STREAM_PAYLOAD_SIZE, NULL);
+    pump();
+    stream_free(put.options_list_ptr);
+
+    if (client_code != COAP_MSG_CODE_RESPONSE_CHANGED) {
+        printf("block1 response code %d\r\n", client_code);
+        return -1;
+    }
+    return check_transfer("block1", sent);
+}
+
+static int test_block2(void)
+{
+    sn_coap_hdr_s get;
+    init_request(&get, COAP_MSG_CODE_REQUEST_GET);
+
+    send_message(client, &server_addr, &get);
+    pump();
+
+    if (client_status != COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED || client_code != COAP_MSG_CODE_RESPONSE_CONTENT) {
+        printf("block2 response status %d code %d\r\n", client_status, client_code);
+        return -1;
+    }
+    if (followup_requests != (STREAM_PAYLOAD_SIZE - 1) / SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE || bad_followup_requests) {
+        printf("block2 %u follow-up requests, %u for the wrong resource\r\n", followup_requests, bad_followup_requests);
+        return -1;
+    }
+    return check_transfer("block2", 0);
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < STREAM_PAYLOAD_SIZE; i++) {
+        source_data[i] = (uint8_t)(i * 7);
+    }
+
+    client = sn_coap_protocol_init(stream_alloc, stream_free, stream_tx, NULL);
+    server = sn_coap_protocol_init(stream_alloc, stream_free, stream_tx, NULL);
+    if (!client || !server ||
+            sn_coap_protocol_set_block_stream(client, stream_sink, stream_source) < 0 ||
+            sn_coap_protocol_set_block_stream(server, stream_sink, stream_source) < 0) {
+        printf("init failed\r\n");
+        return 1;
+    }
+
+    printf("%d byte payloads in %d byte blocks\r\n", STREAM_PAYLOAD_SIZE, SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE);
+    heap_peak = heap_used;
+
+    int err = test_block1() < 0 || test_block2() < 0;
+
+    sn_coap_protocol_destroy(client);
+    sn_coap_protocol_destroy(server);
+    if (heap_blocks) {
+        printf("%u heap blocks leaked\r\n", heap_blocks);
+        err = 1;
+    }
+
+    return err;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2016 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host benchmark of the GRS resource directory. Registers LWM2M style
+ * resources and drives sn_grs_process_coap() with a synthetic stream of
+ * requests, reporting the cost per request as the directory grows.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ns_types.h"
+#include "ns_list.h"
+#include "sn_nsdl.h"
+#include "sn_coap_header.h"
+#include "sn_coap_protocol.h"
+#include "sn_nsdl_lib.h"
+#include "sn_grs.h"
+
+// Benchmark setup
+#define BENCH_REQUESTS      20000
+#define BENCH_INSTANCE_SIZE 10      // Resources per object instance
+#define BENCH_MISS_RATE     8       // One request in BENCH_MISS_RATE is for a missing path
+
+static const uint16_t resource_counts[] = {10, 100, 500, 1000, 2000, 5000};
+
+static unsigned responses;
+
+static void *bench_alloc(uint16_t size)
+{
+    return malloc(size);
+}
+
+static void bench_free(void *ptr)
+{
+    free(ptr);
+}
+
+static uint8_t bench_tx(struct nsdl_s *handle, sn_nsdl_capab_e protocol, uint8_t *data, uint16_t len, sn_nsdl_addr_s *address)
+{
+    responses++;
+    return 1;
+}
+
+static uint8_t bench_rx(struct nsdl_s *handle, sn_coap_hdr_s *coap, sn_nsdl_addr_s *address)
+{
+    return 0;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Object 3303 (temperature), BENCH_INSTANCE_SIZE resources per instance
+static uint16_t resource_path(char *path, unsigned n)
+{
+    return sprintf(path, "3303/%u/%u", n / BENCH_INSTANCE_SIZE, 5700 + n % BENCH_INSTANCE_SIZE);
+}
+
+static int create_resources(struct nsdl_s *handle, unsigned count)
+{
+    static uint8_t value[] = "21.5";
+    char path[32];
+    sn_nsdl_resource_info_s res;
+
+    for (unsigned n = 0; n < count; n++) {
+        memset(&res, 0, sizeof(res));
+        res.mode = SN_GRS_STATIC;
+        res.access = SN_GRS_GET_ALLOWED | SN_GRS_PUT_ALLOWED;
+        res.path = (uint8_t *)path;
+        res.pathlen = resource_path(path, n);
+        res.resource = value;
+        res.resourcelen = sizeof(value) - 1;
+        if (sn_nsdl_create_resource(handle, &res) != SN_NSDL_SUCCESS) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int request(struct nsdl_s *handle, sn_coap_msg_code_e code, const char *path, uint16_t pathlen, uint16_t msg_id)
+{
+    static uint8_t payload[] = "22.0";
+    static uint8_t address_bytes[16];
+    static sn_nsdl_addr_s address = {16, SN_NSDL_ADDRESS_TYPE_IPV6, 5683, address_bytes};
+    sn_coap_hdr_s *coap = sn_coap_parser_alloc_message(handle->grs->coap);
+    if (!coap) {
+        return -1;
+    }
+
+    coap->msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    coap->msg_code = code;
+    coap->msg_id = msg_id;
+    coap->uri_path_ptr = malloc(pathlen);
+    if (!coap->uri_path_ptr) {
+        sn_coap_parser_release_allocated_coap_msg_mem(handle->grs->coap, coap);
+        return -1;
+    }
+    memcpy(coap->uri_path_ptr, path, pathlen);
+    coap->uri_path_len = pathlen;
+
+    // The payload belongs to the received datagram, which GRS does not free
+    if (code == COAP_MSG_CODE_REQUEST_PUT) {
+        coap->payload_ptr = payload;
+        coap->payload_len = sizeof(payload) - 1;
+    }
+
+    return sn_grs_process_coap(handle, coap, &address);
+}
+
+static void bench(unsigned count)
+{
+    char path[32];
+    uint16_t pathlen;
+    struct nsdl_s *handle = sn_nsdl_init(bench_tx, bench_rx, bench_alloc, bench_free);
+    if (!handle) {
+        printf("init failed\r\n");
+        return;
+    }
+
+    uint64_t start = now_ns();
+    if (create_resources(handle, count) < 0) {
+        printf("creating %u resources failed\r\n", count);
+        sn_nsdl_destroy(handle);
+        return;
+    }
+    uint64_t create_ns = now_ns() - start;
+
+    // GET, PUT and missing paths in a fixed pseudo random order
+    unsigned seed = 1;
+    responses = 0;
+    start = now_ns();
+    for (unsigned i = 0; i < BENCH_REQUESTS; i++) {
+        seed = seed * 1103515245 + 12345;
+        unsigned n = (seed >> 8) % count;
+
+        if (i % BENCH_MISS_RATE == 0) {
+            pathlen = sprintf(path, "3303/%u/5800", n);
+        } else {
+            pathlen = resource_path(path, n);
+        }
+
+        request(handle, (i & 1) ? COAP_MSG_CODE_REQUEST_PUT : COAP_MSG_CODE_REQUEST_GET,
+                path, pathlen, (uint16_t)i);
+    }
+    uint64_t request_ns = now_ns() - start;
+
+    // Delete whole instances, which also searches for subresources
+    start = now_ns();
+    for (unsigned instance = 0; instance * BENCH_INSTANCE_SIZE < count; instance++) {
+        pathlen = sprintf(path, "3303/%u", instance);
+        sn_nsdl_delete_resource(handle, pathlen, (uint8_t *)path);
+        for (unsigned n = 0; n < BENCH_INSTANCE_SIZE; n++) {
+            pathlen = resource_path(path, instance * BENCH_INSTANCE_SIZE + n);
+            sn_nsdl_delete_resource(handle, pathlen, (uint8_t *)path);
+        }
+    }
+    uint64_t delete_ns = now_ns() - start;
+
+    printf("%5u resources: create %7.2f us, request %7.2f us, delete %7.2f us (%u responses)\r\n",
+           count,
+           create_ns / 1000.0 / count,
+           request_ns / 1000.0 / BENCH_REQUESTS,
+           delete_ns / 1000.0 / count,
+           responses);
+
+    sn_nsdl_destroy(handle);
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < sizeof(resource_counts) / sizeof(resource_counts[0]); i++) {
+        bench(resource_counts[i]);
+    }
+
+    return 0;
+}
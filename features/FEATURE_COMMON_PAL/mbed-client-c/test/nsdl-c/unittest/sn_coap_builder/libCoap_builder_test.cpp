@@ -496,6 +496,49 @@ TEST(libCoap_builder, sn_coap_builder_options_get_option_part_position)
     CHECK(val == 11);
 }
 
+TEST(libCoap_builder, sn_coap_builder_view)
+{
+    uint8_t option_data[300];
+    memset(option_data, 'a', sizeof(option_data));
+    sn_coap_option_view_s views[] = {{COAP_OPTION_URI_PATH, 0, 1}, {COAP_OPTION_URI_PATH, 1, 2}, {COAP_OPTION_CONTENT_FORMAT, 0, 0}};
+
+    CHECK(-2 == sn_coap_builder_view(NULL, sizeof(buffer), &coap_header, views, 3, option_data));
+    CHECK(-2 == sn_coap_builder_view(buffer, sizeof(buffer), NULL, views, 3, option_data));
+    CHECK(-2 == sn_coap_builder_view(buffer, sizeof(buffer), &coap_header, NULL, 3, option_data));
+    CHECK(-2 == sn_coap_builder_view(buffer, sizeof(buffer), &coap_header, views, 3, NULL));
+
+    // Header is 4 bytes and each option 1 byte plus its value
+    CHECK(-1 == sn_coap_builder_view(buffer, 9, &coap_header, views, 3, option_data));
+    CHECK(10 == sn_coap_builder_view(buffer, 10, &coap_header, views, 3, option_data));
+    CHECK(0x60 == buffer[0]);
+    CHECK(0xB1 == buffer[4]);
+    CHECK(0x02 == buffer[6]);
+    CHECK(0x10 == buffer[9]);
+
+    // Options of the header structure are ignored
+    coap_header.options_list_ptr->max_age = 1;
+    CHECK(4 == sn_coap_builder_view(buffer, sizeof(buffer), &coap_header, NULL, 0, NULL));
+
+    coap_header.payload_ptr = temp;
+    coap_header.payload_len = 3;
+    CHECK(14 == sn_coap_builder_view(buffer, sizeof(buffer), &coap_header, views, 3, option_data));
+    CHECK(0xFF == buffer[10]);
+    coap_header.payload_ptr = NULL;
+    coap_header.payload_len = 0;
+
+    // Options must be in ascending order
+    sn_coap_option_view_s unordered[] = {{COAP_OPTION_CONTENT_FORMAT, 0, 0}, {COAP_OPTION_URI_PATH, 0, 1}};
+    CHECK(-1 == sn_coap_builder_view(buffer, sizeof(buffer), &coap_header, unordered, 2, option_data));
+
+    // Extended option delta and length
+    sn_coap_option_view_s proxy_uri[] = {{COAP_OPTION_PROXY_URI, 0, 300}};
+    CHECK(308 == sn_coap_builder_view(buffer, sizeof(buffer), &coap_header, proxy_uri, 1, option_data));
+    CHECK(0xDE == buffer[4]);
+
+    sn_coap_header_check_stub.expectedInt8 = -1;
+    CHECK(-1 == sn_coap_builder_view(buffer, sizeof(buffer), &coap_header, views, 3, option_data));
+}
+
 TEST(libCoap_builder, sn_coap_builder_payload_build)
 {
     sn_coap_hdr_s header;
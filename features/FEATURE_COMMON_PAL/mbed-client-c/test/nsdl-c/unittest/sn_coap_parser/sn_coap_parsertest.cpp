@@ -49,3 +49,8 @@ TEST(sn_coap_parser, test_sn_coap_parser_release_allocated_coap_msg_mem)
 {
     CHECK(test_sn_coap_parser_release_allocated_coap_msg_mem());
 }
+
+TEST(sn_coap_parser, test_sn_coap_parser_view)
+{
+    CHECK(test_sn_coap_parser_view());
+}
@@ -980,3 +980,97 @@ bool test_sn_coap_parser_release_allocated_coap_msg_mem()
     return true; //this is a memory leak check, so that will pass/fail
 }
 
+bool test_sn_coap_parser_view()
+{
+    uint64_t arena[40];
+    uint8_t *arena_ptr = (uint8_t*)arena;
+    coap_version_e ver;
+    sn_coap_msg_view_s *msg;
+
+    /* CON GET with token, Uri-Path a/bc, empty Content-Format, Uri-Query x and payload */
+    uint8_t packet[] = {0x42, 0x01, 0x12, 0x34, 0xAA, 0xBB,
+                        0xB1, 'a',
+                        0x02, 'b', 'c',
+                        0x10,
+                        0x31, 'x',
+                        0xFF, 'h', 'i'};
+
+    if( sn_coap_parser_view(sizeof(packet), NULL, &ver, arena, sizeof(arena)) ||
+        sn_coap_parser_view(3, packet, &ver, arena, sizeof(arena)) ||
+        sn_coap_parser_view(sizeof(packet), packet, NULL, arena, sizeof(arena)) ||
+        sn_coap_parser_view(sizeof(packet), packet, &ver, NULL, sizeof(arena)) ){
+        return false;
+    }
+
+    /* Arena too small for the message, the option views or the joined Uri-Path */
+    if( sn_coap_parser_view(sizeof(packet), packet, &ver, arena, sizeof(sn_coap_msg_view_s) - 1) ||
+        sn_coap_parser_view(sizeof(packet), packet, &ver, arena, sizeof(sn_coap_msg_view_s) + 3 * sizeof(sn_coap_option_view_s)) ||
+        sn_coap_parser_view(sizeof(packet), packet, &ver, arena, sizeof(sn_coap_msg_view_s) + 4 * sizeof(sn_coap_option_view_s) + 3) ){
+        return false;
+    }
+
+    /* Unaligned arena is aligned by the parser */
+    msg = sn_coap_parser_view(sizeof(packet), packet, &ver, arena_ptr + 1, sizeof(arena) - 1);
+    if( !msg || (uint8_t*)msg == arena_ptr + 1 || msg->hdr.coap_status != COAP_STATUS_OK ){
+        return false;
+    }
+
+    msg = sn_coap_parser_view(sizeof(packet), packet, &ver, arena, sizeof(arena));
+    if( !msg || msg->hdr.coap_status != COAP_STATUS_OK || ver != COAP_VERSION_1 ||
+        msg->hdr.msg_type != COAP_MSG_TYPE_CONFIRMABLE || msg->hdr.msg_code != COAP_MSG_CODE_REQUEST_GET ||
+        msg->hdr.msg_id != 0x1234 ){
+        return false;
+    }
+
+    if( msg->hdr.token_len != 2 || msg->hdr.token_ptr != packet + 4 ){
+        return false;
+    }
+
+    if( msg->hdr.uri_path_len != 4 || memcmp(msg->hdr.uri_path_ptr, "a/bc", 4) ||
+        msg->hdr.uri_path_ptr < arena_ptr || msg->hdr.uri_path_ptr >= arena_ptr + sizeof(arena) ){
+        return false;
+    }
+
+    if( msg->hdr.content_format != COAP_CT_TEXT_PLAIN || msg->hdr.options_list_ptr != &msg->options ||
+        msg->options.uri_query_len != 1 || msg->options.uri_query_ptr != packet + 13 ){
+        return false;
+    }
+
+    if( msg->hdr.payload_len != 2 || msg->hdr.payload_ptr != packet + 15 ){
+        return false;
+    }
+
+    if( msg->packet_data_ptr != packet || msg->option_count != 4 ||
+        msg->option_views_ptr[1].number != COAP_OPTION_URI_PATH ||
+        msg->option_views_ptr[1].offset != 9 || msg->option_views_ptr[1].len != 2 ||
+        msg->option_views_ptr[2].number != COAP_OPTION_CONTENT_FORMAT || msg->option_views_ptr[2].len != 0 ){
+        return false;
+    }
+
+    if( msg->arena_used != (uint8_t*)(msg->option_views_ptr + 4) + 4 - arena_ptr ){
+        return false;
+    }
+
+    /* Malformed messages are parsed with error status */
+    uint8_t long_token[] = {0x49, 0x01, 0x00, 0x01};
+    uint8_t short_token[] = {0x42, 0x01, 0x00, 0x01, 0xAA};
+    uint8_t short_extension[] = {0x40, 0x01, 0x00, 0x01, 0xD1};
+    uint8_t short_value[] = {0x40, 0x01, 0x00, 0x01, 0xB3, 'a'};
+    uint8_t unknown_option[] = {0x40, 0x01, 0x00, 0x01, 0x20};
+    uint8_t repeated_option[] = {0x40, 0x01, 0x00, 0x01, 0xC0, 0x00};
+    uint8_t long_etag[] = {0x40, 0x01, 0x00, 0x01, 0x49, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint8_t empty_payload[] = {0x40, 0x01, 0x00, 0x01, 0xFF};
+
+    uint8_t *malformed[] = {long_token, short_token, short_extension, short_value, unknown_option, repeated_option, long_etag, empty_payload};
+    uint16_t malformed_len[] = {sizeof(long_token), sizeof(short_token), sizeof(short_extension), sizeof(short_value),
+                                sizeof(unknown_option), sizeof(repeated_option), sizeof(long_etag), sizeof(empty_payload)};
+
+    for( uint8_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++ ){
+        msg = sn_coap_parser_view(malformed_len[i], malformed[i], &ver, arena, sizeof(arena));
+        if( !msg || msg->hdr.coap_status != COAP_STATUS_PARSER_ERROR_IN_HEADER ){
+            return false;
+        }
+    }
+
+    return true;
+}
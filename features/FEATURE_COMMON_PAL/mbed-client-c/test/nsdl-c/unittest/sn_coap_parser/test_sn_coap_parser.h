@@ -25,6 +25,8 @@ bool test_sn_coap_parser_parsing();
 
 bool test_sn_coap_parser_release_allocated_coap_msg_mem();
 
+bool test_sn_coap_parser_view();
+
 
 #ifdef __cplusplus
 }
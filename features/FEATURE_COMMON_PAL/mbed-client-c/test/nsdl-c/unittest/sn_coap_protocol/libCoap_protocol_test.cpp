@@ -189,6 +189,137 @@ TEST(libCoap_protocol, sn_coap_protocol_delete_retransmission)
 #endif
 }
 
+TEST(libCoap_protocol, sn_coap_protocol_get_stats)
+{
+    sn_coap_protocol_stats_s stats;
+
+    CHECK( -1 == sn_coap_protocol_get_stats(NULL, &stats));
+    CHECK( -1 == sn_coap_protocol_get_stats(coap_handle, NULL));
+
+    CHECK( 0 == sn_coap_protocol_get_stats(coap_handle, &stats));
+    CHECK( 0 == stats.duplicates_detected );
+    CHECK( 0 == stats.duplication_evictions );
+    CHECK( 0 == stats.resend_queue_full );
+    CHECK( 0 == stats.resends );
+    CHECK( 0 == stats.resend_timeouts );
+}
+
+TEST(libCoap_protocol, sn_coap_protocol_resending_queue)
+{
+#if ENABLE_RESENDINGS
+    retCounter = 20;
+    sn_coap_protocol_stats_s stats;
+    sn_nsdl_addr_s dst_addr_ptr;
+    sn_coap_hdr_s src_coap_msg_ptr;
+    uint8_t temp_addr_a[4] = {192, 168, 0, 1};
+    uint8_t temp_addr_b[4] = {192, 168, 0, 2};
+    uint8_t dst_packet_data_ptr[4] = {0x40, 0x01, 0x00, 0x07};
+
+    memset(&dst_addr_ptr, 0, sizeof(sn_nsdl_addr_s));
+    memset(&src_coap_msg_ptr, 0, sizeof(sn_coap_hdr_s));
+
+    dst_addr_ptr.addr_len = 4;
+    dst_addr_ptr.type = SN_NSDL_ADDRESS_TYPE_IPV4;
+    dst_addr_ptr.port = 5683;
+    src_coap_msg_ptr.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    src_coap_msg_ptr.msg_id = 7;
+
+    CHECK( 0 == sn_coap_protocol_set_retransmission_buffer(coap_handle, 2, 0) );
+    CHECK( 0 == sn_coap_protocol_set_retransmission_parameters(coap_handle, 1, 1) );
+
+    sn_coap_builder_stub.expectedInt16 = 4;
+
+    /* Same Message ID to two peers, third message does not fit to the queue */
+    dst_addr_ptr.addr_ptr = temp_addr_a;
+    CHECK( 4 == sn_coap_protocol_build(coap_handle, &dst_addr_ptr, dst_packet_data_ptr, &src_coap_msg_ptr, NULL) );
+    dst_addr_ptr.addr_ptr = temp_addr_b;
+    CHECK( 4 == sn_coap_protocol_build(coap_handle, &dst_addr_ptr, dst_packet_data_ptr, &src_coap_msg_ptr, NULL) );
+    CHECK( 4 == sn_coap_protocol_build(coap_handle, &dst_addr_ptr, dst_packet_data_ptr, &src_coap_msg_ptr, NULL) );
+
+    CHECK( 2 == coap_handle->count_resent_msgs );
+    CHECK( 8 == coap_handle->size_resent_msgs );
+    sn_coap_protocol_get_stats(coap_handle, &stats);
+    CHECK( 1 == stats.resend_queue_full );
+
+    /* Acknowledgement removes only the message sent to that peer */
+    sn_coap_header_check_stub.expectedInt8 = 0;
+    sn_coap_parser_stub.expectedHeader = (sn_coap_hdr_s *)malloc(sizeof(sn_coap_hdr_s));
+    memset(sn_coap_parser_stub.expectedHeader, 0, sizeof(sn_coap_hdr_s));
+    sn_coap_parser_stub.expectedHeader->msg_type = COAP_MSG_TYPE_ACKNOWLEDGEMENT;
+    sn_coap_parser_stub.expectedHeader->msg_id = 7;
+
+    sn_coap_hdr_s *ack_ptr = sn_coap_protocol_parse(coap_handle, &dst_addr_ptr, 4, dst_packet_data_ptr, NULL);
+    CHECK( ack_ptr != NULL );
+    free(ack_ptr);
+
+    CHECK( 1 == coap_handle->count_resent_msgs );
+    CHECK( 4 == coap_handle->size_resent_msgs );
+    CHECK( -2 == sn_coap_protocol_delete_retransmission(coap_handle, 8) );
+
+    /* Remaining message is resent once and then dropped */
+    CHECK( 0 == sn_coap_protocol_exec(coap_handle, 0) );
+    sn_coap_protocol_get_stats(coap_handle, &stats);
+    CHECK( 0 == stats.resends );
+
+    CHECK( 0 == sn_coap_protocol_exec(coap_handle, 1) );
+    sn_coap_protocol_get_stats(coap_handle, &stats);
+    CHECK( 1 == stats.resends );
+    CHECK( 1 == coap_handle->count_resent_msgs );
+
+    CHECK( 0 == sn_coap_protocol_exec(coap_handle, 3) );
+    sn_coap_protocol_get_stats(coap_handle, &stats);
+    CHECK( 1 == stats.resends );
+    CHECK( 1 == stats.resend_timeouts );
+    CHECK( 0 == coap_handle->count_resent_msgs );
+    CHECK( 0 == coap_handle->size_resent_msgs );
+
+    sn_coap_builder_stub.expectedInt16 = 0;
+#endif
+}
+
+TEST(libCoap_protocol, sn_coap_protocol_duplication_info)
+{
+#if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+    retCounter = 20;
+    sn_coap_protocol_stats_s stats;
+    sn_nsdl_addr_s src_addr_ptr;
+    uint8_t temp_addr[4] = {192, 168, 0, 1};
+    uint8_t packet_data_ptr[4] = {0x50, 0x01, 0x00, 0x07};
+    uint16_t msg_ids[3] = {7, 7, 8};
+    sn_coap_status_e statuses[3] = {COAP_STATUS_OK, COAP_STATUS_PARSER_DUPLICATED_MSG, COAP_STATUS_OK};
+
+    memset(&src_addr_ptr, 0, sizeof(sn_nsdl_addr_s));
+    src_addr_ptr.addr_ptr = temp_addr;
+    src_addr_ptr.addr_len = 4;
+    src_addr_ptr.port = 5683;
+
+    CHECK( 0 == sn_coap_protocol_set_duplicate_buffer_size(coap_handle, 1) );
+    sn_coap_header_check_stub.expectedInt8 = 0;
+
+    for (int i = 0; i < 3; i++) {
+        sn_coap_parser_stub.expectedHeader = (sn_coap_hdr_s *)malloc(sizeof(sn_coap_hdr_s));
+        memset(sn_coap_parser_stub.expectedHeader, 0, sizeof(sn_coap_hdr_s));
+        sn_coap_parser_stub.expectedHeader->msg_type = COAP_MSG_TYPE_NON_CONFIRMABLE;
+        sn_coap_parser_stub.expectedHeader->msg_code = COAP_MSG_CODE_REQUEST_GET;
+        sn_coap_parser_stub.expectedHeader->msg_id = msg_ids[i];
+
+        sn_coap_hdr_s *msg_ptr = sn_coap_protocol_parse(coap_handle, &src_addr_ptr, 4, packet_data_ptr, NULL);
+        CHECK( msg_ptr != NULL );
+        CHECK( statuses[i] == msg_ptr->coap_status );
+        free(msg_ptr);
+    }
+
+    CHECK( 1 == coap_handle->count_duplication_msgs );
+    sn_coap_protocol_get_stats(coap_handle, &stats);
+    CHECK( 1 == stats.duplicates_detected );
+    CHECK( 1 == stats.duplication_evictions );
+
+    /* Old duplication info is removed */
+    CHECK( 0 == sn_coap_protocol_exec(coap_handle, SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED + 1) );
+    CHECK( 0 == coap_handle->count_duplication_msgs );
+#endif
+}
+
 TEST(libCoap_protocol, sn_coap_protocol_build)
 {
     retCounter = 1;
@@ -1050,10 +1181,11 @@ TEST(libCoap_protocol, sn_coap_protocol_parse)
     free(tmp_addr.addr_ptr);
     free(dst_packet_data_ptr);
 
+    // Stored request has no payload for the asked block
     retCounter = 5;
     ret = sn_coap_protocol_parse(handle, addr, packet_data_len, packet_data_ptr, NULL);
     CHECK( NULL != ret );
-    CHECK( COAP_STATUS_PARSER_BLOCKWISE_ACK == ret->coap_status );
+    CHECK( COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED == ret->coap_status );
     free(payload);
     sn_coap_parser_release_allocated_coap_msg_mem(handle, ret);
 
@@ -1363,10 +1495,11 @@ TEST(libCoap_protocol, sn_coap_protocol_parse)
     free(tmp_addr.addr_ptr);
     free(dst_packet_data_ptr);
 
+    // Asked block is past the end of the stored payload
     retCounter = 6;
     ret = sn_coap_protocol_parse(handle, addr, packet_data_len, packet_data_ptr, NULL);
     CHECK( NULL != ret );
-    CHECK( COAP_STATUS_PARSER_BLOCKWISE_ACK == ret->coap_status );
+    CHECK( COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED == ret->coap_status );
     free(payload);
     sn_coap_parser_release_allocated_coap_msg_mem(handle, sn_coap_parser_stub.expectedHeader);
 
@@ -2258,3 +2391,239 @@ TEST(libCoap_protocol, sn_coap_protocol_block_remove)
     sn_coap_protocol_destroy(handle);
 }
 
+
+#if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+static uint8_t stream_payload[SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE * 3 + 5];
+static uint32_t stream_offset;
+static int stream_blocks;
+static int8_t stream_sink_result;
+static bool stream_source_fails;
+
+int8_t stream_sink(sn_coap_hdr_s *coap_msg_ptr, sn_nsdl_addr_s *addr_ptr, uint32_t offset, void *param)
+{
+    stream_offset = offset;
+    stream_blocks++;
+    return stream_sink_result;
+}
+
+int16_t stream_source(sn_coap_hdr_s *coap_msg_ptr, sn_nsdl_addr_s *addr_ptr, uint32_t offset, uint8_t *dst_ptr, uint16_t len, void *param)
+{
+    if (stream_source_fails || offset + len > sizeof(stream_payload)) {
+        return -1;
+    }
+    memcpy(dst_ptr, stream_payload + offset, len);
+    stream_offset = offset;
+    stream_blocks++;
+    return len;
+}
+#endif
+
+TEST(libCoap_protocol, sn_coap_protocol_set_block_stream)
+{
+#if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    CHECK( -1 == sn_coap_protocol_set_block_stream(NULL, stream_sink, stream_source) );
+    CHECK( 0 == sn_coap_protocol_set_block_stream(coap_handle, stream_sink, stream_source) );
+    CHECK( 0 == sn_coap_protocol_set_block_stream(coap_handle, NULL, NULL) );
+#else
+    CHECK( -1 == sn_coap_protocol_set_block_stream(coap_handle, NULL, NULL) );
+#endif
+}
+
+TEST(libCoap_protocol, sn_coap_protocol_block_sink)
+{
+#if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    sn_nsdl_addr_s addr;
+    uint8_t addr_bytes[5] = {'a', 'a', 'a', 'a', 'a'};
+    uint8_t payload[16];
+    sn_coap_hdr_s *ret;
+
+    memset(&addr, 0, sizeof(sn_nsdl_addr_s));
+    addr.addr_ptr = addr_bytes;
+    addr.addr_len = sizeof(addr_bytes);
+
+    CHECK( 0 == sn_coap_protocol_set_block_stream(coap_handle, stream_sink, NULL) );
+    sn_coap_builder_stub.expectedUint16 = 1;
+    sn_coap_builder_stub.expectedInt16 = 1;
+
+    sn_coap_parser_stub.expectedHeader = (sn_coap_hdr_s *)malloc(sizeof(sn_coap_hdr_s));
+    memset(sn_coap_parser_stub.expectedHeader, 0, sizeof(sn_coap_hdr_s));
+    sn_coap_parser_stub.expectedHeader->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+    memset(sn_coap_parser_stub.expectedHeader->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
+    sn_coap_parser_stub.expectedHeader->options_list_ptr->block2 = COAP_OPTION_BLOCK_NONE;
+    sn_coap_parser_stub.expectedHeader->msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    sn_coap_parser_stub.expectedHeader->msg_code = COAP_MSG_CODE_REQUEST_PUT;
+
+    // Block1 request, blocks are passed to sink and acknowledged without storing them
+    stream_blocks = 0;
+    stream_sink_result = 0;
+    retCounter = 10;
+    sn_coap_parser_stub.expectedHeader->msg_id = 30;
+    sn_coap_parser_stub.expectedHeader->options_list_ptr->block1 = 0x08 | 0x06;
+    sn_coap_parser_stub.expectedHeader->payload_ptr = payload;
+    sn_coap_parser_stub.expectedHeader->payload_len = sizeof(payload);
+    ret = sn_coap_protocol_parse(coap_handle, &addr, sizeof(payload), payload, NULL);
+    CHECK( NULL != ret );
+    CHECK( COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING == ret->coap_status );
+    CHECK( 1 == stream_blocks );
+    CHECK( 0 == stream_offset );
+    CHECK( 0 == ns_list_count(&coap_handle->linked_list_blockwise_received_payloads) );
+
+    // Last block is returned to user without payload
+    retCounter = 10;
+    sn_coap_parser_stub.expectedHeader->msg_id = 31;
+    sn_coap_parser_stub.expectedHeader->options_list_ptr->block1 = (2 << 4) | 0x06;
+    ret = sn_coap_protocol_parse(coap_handle, &addr, sizeof(payload), payload, NULL);
+    CHECK( NULL != ret );
+    CHECK( COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED == ret->coap_status );
+    CHECK( 2 == stream_blocks );
+    CHECK( 2048 == stream_offset );
+    CHECK( NULL == ret->payload_ptr );
+    CHECK( 0 == ret->payload_len );
+    CHECK( 0 == ns_list_count(&coap_handle->linked_list_blockwise_received_payloads) );
+
+    // Block rejected by sink, also the last one
+    stream_sink_result = -1;
+    retCounter = 10;
+    sn_coap_parser_stub.expectedHeader->msg_id = 32;
+    sn_coap_parser_stub.expectedHeader->options_list_ptr->block1 = 0x08 | 0x06;
+    ret = sn_coap_protocol_parse(coap_handle, &addr, sizeof(payload), payload, NULL);
+    CHECK( NULL != ret );
+    CHECK( COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED == ret->coap_status );
+
+    retCounter = 10;
+    sn_coap_parser_stub.expectedHeader->msg_id = 33;
+    sn_coap_parser_stub.expectedHeader->options_list_ptr->block1 = (1 << 4) | 0x06;
+    ret = sn_coap_protocol_parse(coap_handle, &addr, sizeof(payload), payload, NULL);
+    CHECK( NULL != ret );
+    CHECK( COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED == ret->coap_status );
+    CHECK( 4 == stream_blocks );
+
+    // Block2 response, last block is returned to user without payload
+    stream_sink_result = 0;
+    retCounter = 10;
+    sn_coap_parser_stub.expectedHeader->msg_id = 34;
+    sn_coap_parser_stub.expectedHeader->msg_type = COAP_MSG_TYPE_ACKNOWLEDGEMENT;
+    sn_coap_parser_stub.expectedHeader->msg_code = COAP_MSG_CODE_RESPONSE_CONTENT;
+    sn_coap_parser_stub.expectedHeader->options_list_ptr->block1 = COAP_OPTION_BLOCK_NONE;
+    sn_coap_parser_stub.expectedHeader->options_list_ptr->block2 = (3 << 4) | 0x06;
+    sn_coap_parser_stub.expectedHeader->payload_ptr = payload;
+    sn_coap_parser_stub.expectedHeader->payload_len = sizeof(payload);
+    ret = sn_coap_protocol_parse(coap_handle, &addr, sizeof(payload), payload, NULL);
+    CHECK( NULL != ret );
+    CHECK( COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED == ret->coap_status );
+    CHECK( 5 == stream_blocks );
+    CHECK( 3072 == stream_offset );
+    CHECK( NULL == ret->payload_ptr );
+    CHECK( 0 == ns_list_count(&coap_handle->linked_list_blockwise_received_payloads) );
+
+    // Block2 rejected by sink is not continued
+    stream_sink_result = -1;
+    retCounter = 10;
+    sn_coap_parser_stub.expectedHeader->msg_id = 35;
+    sn_coap_parser_stub.expectedHeader->options_list_ptr->block2 = 0x08 | 0x06;
+    ret = sn_coap_protocol_parse(coap_handle, &addr, sizeof(payload), payload, NULL);
+    CHECK( NULL != ret );
+    CHECK( COAP_STATUS_PARSER_BLOCKWISE_MSG_REJECTED == ret->coap_status );
+
+    free(sn_coap_parser_stub.expectedHeader->options_list_ptr);
+    free(sn_coap_parser_stub.expectedHeader);
+    sn_coap_parser_stub.expectedHeader = NULL;
+    sn_coap_builder_stub.expectedUint16 = 0;
+    sn_coap_builder_stub.expectedInt16 = 0;
+#endif
+}
+
+TEST(libCoap_protocol, sn_coap_protocol_send_stream)
+{
+    sn_nsdl_addr_s addr;
+    uint8_t addr_bytes[5] = {'a', 'a', 'a', 'a', 'a'};
+    sn_coap_hdr_s hdr;
+
+    memset(&addr, 0, sizeof(sn_nsdl_addr_s));
+    addr.addr_ptr = addr_bytes;
+    addr.addr_len = sizeof(addr_bytes);
+    memset(&hdr, 0, sizeof(sn_coap_hdr_s));
+    hdr.msg_type = COAP_MSG_TYPE_ACKNOWLEDGEMENT;
+    hdr.msg_code = COAP_MSG_CODE_RESPONSE_CONTENT;
+    hdr.msg_id = 40;
+
+    // No block source
+    CHECK( -1 == sn_coap_protocol_send_stream(coap_handle, &addr, &hdr, 100, NULL) );
+
+#if SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    sn_coap_hdr_s *ret;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(stream_payload); i++) {
+        stream_payload[i] = (uint8_t)i;
+    }
+    CHECK( 0 == sn_coap_protocol_set_block_stream(coap_handle, NULL, stream_source) );
+    CHECK( -1 == sn_coap_protocol_send_stream(NULL, &addr, &hdr, 100, NULL) );
+    CHECK( -1 == sn_coap_protocol_send_stream(coap_handle, &addr, &hdr, 0, NULL) );
+
+    // Source fails
+    stream_source_fails = true;
+    retCounter = 10;
+    CHECK( -1 == sn_coap_protocol_send_stream(coap_handle, &addr, &hdr, sizeof(stream_payload), NULL) );
+    stream_source_fails = false;
+
+    // Out of memory
+    retCounter = 0;
+    CHECK( -2 == sn_coap_protocol_send_stream(coap_handle, &addr, &hdr, sizeof(stream_payload), NULL) );
+
+    // First block is sent, only header is stored
+    sn_coap_builder_stub.expectedUint16 = 1;
+    sn_coap_builder_stub.expectedInt16 = 1;
+    stream_blocks = 0;
+    retCounter = 10;
+    CHECK( 0 == sn_coap_protocol_send_stream(coap_handle, &addr, &hdr, sizeof(stream_payload), NULL) );
+    CHECK( 1 == stream_blocks );
+    CHECK( 0 == stream_offset );
+    CHECK( NULL == hdr.payload_ptr );
+    CHECK( NULL != hdr.options_list_ptr );
+    CHECK( hdr.options_list_ptr->use_size2 );
+    CHECK( sizeof(stream_payload) == hdr.options_list_ptr->size2 );
+    CHECK( 1 == ns_list_count(&coap_handle->linked_list_blockwise_sent_msgs) );
+    coap_blockwise_msg_s *stored = ns_list_get_first(&coap_handle->linked_list_blockwise_sent_msgs);
+    CHECK( sizeof(stream_payload) == stored->stream_len );
+    CHECK( NULL == stored->coap_msg_ptr->payload_ptr );
+
+    // Rest of the blocks are read from source when asked for
+    sn_coap_parser_stub.expectedHeader = (sn_coap_hdr_s *)malloc(sizeof(sn_coap_hdr_s));
+    memset(sn_coap_parser_stub.expectedHeader, 0, sizeof(sn_coap_hdr_s));
+    sn_coap_parser_stub.expectedHeader->options_list_ptr = (sn_coap_options_list_s*)malloc(sizeof(sn_coap_options_list_s));
+    memset(sn_coap_parser_stub.expectedHeader->options_list_ptr, 0, sizeof(sn_coap_options_list_s));
+    sn_coap_parser_stub.expectedHeader->options_list_ptr->block1 = COAP_OPTION_BLOCK_NONE;
+    sn_coap_parser_stub.expectedHeader->msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+    sn_coap_parser_stub.expectedHeader->msg_code = COAP_MSG_CODE_REQUEST_GET;
+
+    retCounter = 10;
+    sn_coap_parser_stub.expectedHeader->msg_id = 41;
+    sn_coap_parser_stub.expectedHeader->options_list_ptr->block2 = (1 << 4) | 0x06;
+    ret = sn_coap_protocol_parse(coap_handle, &addr, 1, addr_bytes, NULL);
+    CHECK( NULL != ret );
+    CHECK( COAP_STATUS_PARSER_BLOCKWISE_ACK == ret->coap_status );
+    CHECK( 2 == stream_blocks );
+    CHECK( 1024 == stream_offset );
+    CHECK( 1 == ns_list_count(&coap_handle->linked_list_blockwise_sent_msgs) );
+    CHECK( NULL == stored->coap_msg_ptr->payload_ptr );
+
+    // Last block removes the stored message
+    retCounter = 10;
+    sn_coap_parser_stub.expectedHeader->msg_id = 42;
+    sn_coap_parser_stub.expectedHeader->options_list_ptr->block2 = (3 << 4) | 0x06;
+    ret = sn_coap_protocol_parse(coap_handle, &addr, 1, addr_bytes, NULL);
+    CHECK( NULL != ret );
+    CHECK( COAP_STATUS_PARSER_BLOCKWISE_ACK == ret->coap_status );
+    CHECK( 3 == stream_blocks );
+    CHECK( 3072 == stream_offset );
+    CHECK( 0 == ns_list_count(&coap_handle->linked_list_blockwise_sent_msgs) );
+
+    free(hdr.options_list_ptr);
+    free(sn_coap_parser_stub.expectedHeader->options_list_ptr);
+    free(sn_coap_parser_stub.expectedHeader);
+    sn_coap_parser_stub.expectedHeader = NULL;
+    sn_coap_builder_stub.expectedUint16 = 0;
+    sn_coap_builder_stub.expectedInt16 = 0;
+#endif
+}
@@ -86,3 +86,8 @@ TEST(sn_grs, test_sn_grs_mark_resources_as_registered)
     CHECK(test_sn_grs_mark_resources_as_registered());
 }
 
+TEST(sn_grs, test_sn_grs_resource_index)
+{
+    CHECK(test_sn_grs_resource_index());
+}
+
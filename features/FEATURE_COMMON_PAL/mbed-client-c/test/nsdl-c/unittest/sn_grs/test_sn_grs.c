@@ -3,6 +3,7 @@
  */
 #include "test_sn_grs.h"
 #include <string.h>
+#include <stdio.h>
 #include <inttypes.h>
 #include "sn_coap_header.h"
 #include "sn_nsdl.h"
@@ -507,7 +508,19 @@ bool test_sn_grs_create_resource()
         return false;
     }
 
+    // Index table
     retCounter = 6;
+    if( SN_GRS_LIST_ADDING_FAILURE != sn_grs_create_resource(handle, res) ){
+        return false;
+    }
+
+    // Index node
+    retCounter = 7;
+    if( SN_GRS_LIST_ADDING_FAILURE != sn_grs_create_resource(handle, res) ){
+        return false;
+    }
+
+    retCounter = 8;
     if( SN_NSDL_SUCCESS != sn_grs_create_resource(handle, res) ){
         return false;
     }
@@ -554,6 +567,12 @@ bool test_sn_grs_put_resource()
     uint8_t ifp[2];
     res->resource_parameters_ptr->interface_description_ptr = &ifp;
 
+    retCounter = 1;
+    if( SN_GRS_LIST_ADDING_FAILURE != sn_grs_put_resource(handle, res) ){
+        return false;
+    }
+
+    retCounter = 2;
     if( SN_NSDL_SUCCESS != sn_grs_put_resource(handle, res) ){
         return false;
     }
@@ -1188,6 +1207,120 @@ bool test_sn_grs_search_resource()
     return true;
 }
 
+static sn_nsdl_resource_info_s *create_test_resource(struct grs_s *handle, const char *path)
+{
+    sn_nsdl_resource_info_s res;
+    memset(&res, 0, sizeof(sn_nsdl_resource_info_s));
+    res.path = (uint8_t*)path;
+    res.pathlen = strlen(path);
+
+    if( SN_NSDL_SUCCESS != sn_grs_create_resource(handle, &res) ){
+        return NULL;
+    }
+    return sn_grs_search_resource(handle, res.pathlen, res.path, SN_GRS_SEARCH_METHOD);
+}
+
+bool test_sn_grs_resource_index()
+{
+    struct grs_s* handle = (struct grs_s*)malloc(sizeof(struct grs_s));
+    memset(handle, 0, sizeof(struct grs_s));
+    handle->sn_grs_alloc = myMalloc;
+    handle->sn_grs_free = myFree;
+
+    retCounter = 100;
+    sn_nsdl_resource_info_s* a1 = create_test_resource(handle, "a/1");
+    sn_nsdl_resource_info_s* a10 = create_test_resource(handle, "a/10");
+    sn_nsdl_resource_info_s* a100 = create_test_resource(handle, "/a/10/0/");
+    sn_nsdl_resource_info_s* b = create_test_resource(handle, "b");
+    if( !a1 || !a10 || !a100 || !b ){
+        return false;
+    }
+
+    // Only "a" has no resource
+    if( handle->index_resource_count != 4 || handle->index_node_count != 5 ){
+        return false;
+    }
+
+    uint8_t path[] = "/a/10/0";
+    if( a100 != sn_grs_search_resource(handle, 7, path, SN_GRS_SEARCH_METHOD) ){
+        return false;
+    }
+    if( NULL != sn_grs_search_resource(handle, 1, path + 1, SN_GRS_SEARCH_METHOD) ){
+        return false;
+    }
+    // "a/10" is not below "a/1"
+    if( NULL != sn_grs_search_resource(handle, 3, path + 1, SN_GRS_DELETE_METHOD) ){
+        return false;
+    }
+    if( a100 != sn_grs_search_resource(handle, 5, path, SN_GRS_DELETE_METHOD) ){
+        return false;
+    }
+    if( NULL == sn_grs_search_resource(handle, 2, path, SN_GRS_DELETE_METHOD) ){
+        return false;
+    }
+
+    // Allocation failure half way through a path leaves no empty nodes
+    retCounter = 1;
+    sn_nsdl_resource_info_s res;
+    memset(&res, 0, sizeof(sn_nsdl_resource_info_s));
+    res.path = (uint8_t*)"c/1/2";
+    res.pathlen = 5;
+    if( SN_GRS_LIST_ADDING_FAILURE != sn_grs_create_resource(handle, &res) ){
+        return false;
+    }
+    retCounter = 3;
+    if( SN_GRS_LIST_ADDING_FAILURE != sn_grs_create_resource(handle, &res) ){
+        return false;
+    }
+    if( handle->index_node_count != 5 ){
+        return false;
+    }
+
+    // Deleting "a/10" takes "a/10/0" and the "a" node with it
+    retCounter = 100;
+    if( SN_NSDL_FAILURE != sn_grs_delete_resource(handle, 1, path + 1) ){
+        return false;
+    }
+    if( SN_NSDL_SUCCESS != sn_grs_delete_resource(handle, 4, path + 1) ){
+        return false;
+    }
+    if( handle->resource_root_count != 2 || handle->index_node_count != 3 ){
+        return false;
+    }
+    if( SN_NSDL_SUCCESS != sn_grs_delete_resource(handle, 3, path + 1) ){
+        return false;
+    }
+    if( handle->index_node_count != 1 || handle->index_root == NULL ){
+        return false;
+    }
+
+    // Growing the hash table keeps every path reachable
+    char name[8];
+    int i;
+    retCounter = 1000;
+    for( i = 0; i < 100; i++ ){
+        sprintf(name, "3/0/%d", i);
+        if( !create_test_resource(handle, name) ){
+            return false;
+        }
+    }
+    if( handle->index_table_size <= 16 ){
+        return false;
+    }
+    for( i = 0; i < 100; i++ ){
+        sprintf(name, "3/0/%d", i);
+        if( NULL == sn_grs_search_resource(handle, strlen(name), (uint8_t*)name, SN_GRS_SEARCH_METHOD) ){
+            return false;
+        }
+    }
+    if( b != sn_grs_search_resource(handle, 1, (uint8_t*)"b", SN_GRS_SEARCH_METHOD) ){
+        return false;
+    }
+
+    sn_grs_destroy(handle);
+    return true;
+}
+
 bool test_sn_grs_mark_resources_as_registered()
 {
     sn_grs_mark_resources_as_registered(NULL);
@@ -24,6 +24,7 @@ bool test_sn_grs_create_resource();
 bool test_sn_grs_put_resource();
 bool test_sn_grs_delete_resource();
 bool test_sn_grs_mark_resources_as_registered();
+bool test_sn_grs_resource_index();
 
 #ifdef __cplusplus
 }
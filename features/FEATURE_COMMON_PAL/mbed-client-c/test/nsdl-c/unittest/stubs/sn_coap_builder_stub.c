@@ -49,6 +49,12 @@ int16_t sn_coap_builder(uint8_t *dst_packet_data_ptr, sn_coap_hdr_s *src_coap_ms
     return sn_coap_builder_stub.expectedInt16;
 }
 
+int16_t sn_coap_builder_view(uint8_t *dst_packet_data_ptr, uint16_t dst_packet_data_len, sn_coap_hdr_s *src_coap_msg_ptr,
+                             const sn_coap_option_view_s *option_views_ptr, uint16_t option_count, uint8_t *option_data_ptr)
+{
+    return sn_coap_builder_stub.expectedInt16;
+}
+
 uint16_t sn_coap_builder_calc_needed_packet_data_size_2(sn_coap_hdr_s *src_coap_msg_ptr, uint16_t blockwise_size)
 {
     return sn_coap_builder_stub.expectedUint16;
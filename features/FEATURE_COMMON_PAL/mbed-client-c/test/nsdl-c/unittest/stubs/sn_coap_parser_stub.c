@@ -36,6 +36,11 @@ sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, u
     return sn_coap_parser_stub.expectedHeader;
 }
 
+sn_coap_msg_view_s *sn_coap_parser_view(uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr, void *arena_ptr, uint16_t arena_len)
+{
+    return NULL;
+}
+
 void sn_coap_parser_release_allocated_coap_msg_mem(struct coap_s *handle, sn_coap_hdr_s *freed_coap_msg_ptr)
 {
     if (freed_coap_msg_ptr != NULL) {
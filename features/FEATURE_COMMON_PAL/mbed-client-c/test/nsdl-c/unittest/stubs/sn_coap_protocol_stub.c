@@ -64,6 +64,19 @@ int8_t sn_coap_protocol_set_block_size(struct coap_s *handle, uint16_t block_siz
     return sn_coap_protocol_stub.expectedInt8;
 }
 
+int8_t sn_coap_protocol_set_block_stream(struct coap_s *handle,
+        int8_t (*block_sink)(sn_coap_hdr_s *, sn_nsdl_addr_s *, uint32_t, void *),
+        int16_t (*block_source)(sn_coap_hdr_s *, sn_nsdl_addr_s *, uint32_t, uint8_t *, uint16_t, void *))
+{
+    return sn_coap_protocol_stub.expectedInt8;
+}
+
+int8_t sn_coap_protocol_send_stream(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr,
+                                    sn_coap_hdr_s *src_coap_msg_ptr, uint32_t payload_len, void *param)
+{
+    return sn_coap_protocol_stub.expectedInt8;
+}
+
 int8_t sn_coap_protocol_set_duplicate_buffer_size(struct coap_s *handle, uint8_t message_count)
 {
     return sn_coap_protocol_stub.expectedInt8;
@@ -38,6 +38,7 @@
  * \endcode
  * Activate with compiler flag: YOTTA_CFG_MBED_TRACE
  * Configure trace line buffer size with compiler flag: YOTTA_CFG_MBED_TRACE_LINE_LENGTH. Default length: 1024.
+ * Remove traces above a level at compile time with compiler flag: YOTTA_CFG_MBED_TRACE_MAX_LEVEL, e.g. TRACE_LEVEL_INFO.
  *
  */
 #ifndef MBED_TRACE_H_
@@ -69,6 +70,14 @@ extern "C" {
 #define MBED_CONF_MBED_TRACE_ENABLE 0
 #endif
 
+#ifndef YOTTA_CFG_MBED_TRACE_FEA_DEFERRED
+#ifdef MBED_CONF_MBED_TRACE_FEA_DEFERRED
+#define YOTTA_CFG_MBED_TRACE_FEA_DEFERRED MBED_CONF_MBED_TRACE_FEA_DEFERRED
+#else
+#define YOTTA_CFG_MBED_TRACE_FEA_DEFERRED 1
+#endif
+#endif
+
 /** 3 upper bits are trace modes related,
     and 5 lower bits are trace level configuration */
 
@@ -110,14 +119,48 @@ extern "C" {
 /** special level for cmdline. Behaviours like "plain mode" */
 #define TRACE_LEVEL_CMD           0x01
 
+/** Highest trace level compiled in. Usage macros of higher levels expand to nothing,
+    e.g. TRACE_LEVEL_INFO removes tr_debug() calls and their arguments from the image */
+#ifndef MBED_TRACE_MAX_LEVEL
+#if defined(YOTTA_CFG_MBED_TRACE_MAX_LEVEL)
+#define MBED_TRACE_MAX_LEVEL      YOTTA_CFG_MBED_TRACE_MAX_LEVEL
+#elif defined(MBED_CONF_MBED_TRACE_MAX_LEVEL)
+#define MBED_TRACE_MAX_LEVEL      MBED_CONF_MBED_TRACE_MAX_LEVEL
+#else
+#define MBED_TRACE_MAX_LEVEL      TRACE_LEVEL_DEBUG
+#endif
+#endif
+
 //usage macros:
+#if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_INFO
 #define tr_info(...)            mbed_tracef(TRACE_LEVEL_INFO,    TRACE_GROUP, __VA_ARGS__)   //!< Print info message
+#else
+#define tr_info(...)            ((void) 0)
+#endif
+#if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_DEBUG
 #define tr_debug(...)           mbed_tracef(TRACE_LEVEL_DEBUG,   TRACE_GROUP, __VA_ARGS__)   //!< Print debug message
+#else
+#define tr_debug(...)           ((void) 0)
+#endif
+#if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_WARN
 #define tr_warning(...)         mbed_tracef(TRACE_LEVEL_WARN,    TRACE_GROUP, __VA_ARGS__)   //!< Print warning message
 #define tr_warn(...)            mbed_tracef(TRACE_LEVEL_WARN,    TRACE_GROUP, __VA_ARGS__)   //!< Alternative warning message
+#else
+#define tr_warning(...)         ((void) 0)
+#define tr_warn(...)            ((void) 0)
+#endif
+#if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_ERROR
 #define tr_error(...)           mbed_tracef(TRACE_LEVEL_ERROR,   TRACE_GROUP, __VA_ARGS__)   //!< Print Error Message
 #define tr_err(...)             mbed_tracef(TRACE_LEVEL_ERROR,   TRACE_GROUP, __VA_ARGS__)   //!< Alternative error message
+#else
+#define tr_error(...)           ((void) 0)
+#define tr_err(...)             ((void) 0)
+#endif
+#if MBED_TRACE_MAX_LEVEL >= TRACE_LEVEL_CMD
 #define tr_cmdline(...)         mbed_tracef(TRACE_LEVEL_CMD,     TRACE_GROUP, __VA_ARGS__)   //!< Special print for cmdline. See more from TRACE_LEVEL_CMD -level
+#else
+#define tr_cmdline(...)         ((void) 0)
+#endif
 
 //aliases for the most commonly used functions and the helper functions
 #define tracef(dlevel, grp, ...)                mbed_tracef(dlevel, grp, __VA_ARGS__)       //!< Alias for mbed_tracef()
@@ -332,6 +375,81 @@ char* mbed_trace_ipv6_prefix(const uint8_t *prefix, uint8_t prefix_len);
  */
 char* mbed_trace_array(const uint8_t* buf, uint16_t len);
 
+#if YOTTA_CFG_MBED_TRACE_FEA_DEFERRED == 1
+/** record is missing arguments or string characters which did not fit */
+#define TRACE_RECORD_TRUNCATED    0x01
+
+/**
+ * Header of a deferred trace record.
+ * The header is followed by the arguments of the conversions in fmt, in order:
+ * integers, floating point values and pointers in the size of their promoted
+ * C type, '*' widths and precisions as int, and %s strings copied with
+ * a terminating null. Arguments are packed without alignment.
+ */
+typedef struct mbed_trace_record_s {
+    /** whole record length in bytes, including header and padding */
+    uint16_t length;
+    /** trace level */
+    uint8_t level;
+    /** record flags, e.g. TRACE_RECORD_TRUNCATED */
+    uint8_t flags;
+    /** value of the timestamp function, 0 if not set */
+    uint32_t timestamp;
+    /** format string pointer */
+    const char *fmt;
+    /** group string pointer */
+    const char *grp;
+} mbed_trace_record_t;
+
+/**
+ * Set deferred trace buffer size
+ * When the buffer is set, traces are not formatted by mbed_tracef() but stored
+ * as binary records (see mbed_trace_record_t) to a ring buffer, and rendered
+ * later by mbed_trace_deferred_flush() or a host tool via mbed_trace_deferred_read().
+ * Only pointers of format and group strings are stored, so they must remain valid,
+ * e.g. string literals. %s arguments are copied. Cmdline traces are always printed immediately.
+ * When the buffer is full new traces are dropped, see mbed_trace_deferred_dropped().
+ * Must be called after mbed_trace_init().
+ *
+ * @param size  buffer size in bytes, 0 = free the buffer and print traces immediately
+ * @return 0 when all success, otherwise non zero
+ */
+int mbed_trace_deferred_buffer_size(int size);
+/**
+ * Set timestamp function for deferred traces
+ * The value is stored to every deferred record, and rendered in
+ * the beginning of the trace text, e.g. "[12345] hello"
+ * e.g.
+ *   uint32_t trace_ticks(){ return us_ticker_read(); }
+ *   mbed_trace_timestamp_function_set( &trace_ticks );
+ */
+void mbed_trace_timestamp_function_set(uint32_t (*timestamp_f)(void));
+/**
+ * Render deferred traces with the print function
+ * This is meant to be called from a low priority thread or idle loop.
+ * Records are read without the trace mutex, which is taken only while printing,
+ * so only one thread may flush or read at a time.
+ *
+ * @param max_count  maximum number of traces to print, 0 = all pending traces
+ * @return number of traces printed
+ */
+int mbed_trace_deferred_flush(int max_count);
+/**
+ * Read raw deferred trace records, e.g. to render them on a host
+ * Whole records are copied and removed from the buffer. Format and group
+ * are pointers into the image, so the host needs the image to resolve them.
+ *
+ * @param buf  destination buffer
+ * @param len  destination buffer length
+ * @return number of bytes copied
+ */
+int mbed_trace_deferred_read(uint8_t *buf, int len);
+/**
+ * Get number of deferred traces dropped because the buffer was full
+ */
+uint32_t mbed_trace_deferred_dropped(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -370,6 +488,11 @@ char* mbed_trace_array(const uint8_t* buf, uint16_t len);
 #undef mbed_trace_ipv6
 #undef mbed_trace_ipv6_prefix
 #undef mbed_trace_array
+#undef mbed_trace_deferred_buffer_size
+#undef mbed_trace_timestamp_function_set
+#undef mbed_trace_deferred_flush
+#undef mbed_trace_deferred_read
+#undef mbed_trace_deferred_dropped
 
 #elif !defined(MBED_TRACE_DUMMIES_DEFINED)
 // define dummies, hiding the real functions
@@ -392,6 +515,11 @@ char* mbed_trace_array(const uint8_t* buf, uint16_t len);
 #define mbed_trace_last(...)                        ((const char *) 0)
 #define mbed_tracef(...)                            ((void) 0)
 #define mbed_vtracef(...)                           ((void) 0)
+#define mbed_trace_deferred_buffer_size(...)        ((int) 0)
+#define mbed_trace_timestamp_function_set(...)      ((void) 0)
+#define mbed_trace_deferred_flush(...)              ((int) 0)
+#define mbed_trace_deferred_read(...)               ((int) 0)
+#define mbed_trace_deferred_dropped(...)            ((uint32_t) 0)
 /**
  * These helper functions accumulate strings in a buffer that is only flushed by actual trace calls. Using these
  * functions outside trace calls could cause the buffer to overflow.
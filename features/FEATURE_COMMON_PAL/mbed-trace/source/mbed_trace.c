@@ -69,11 +69,38 @@
 #endif
 /** default max filters (include/exclude) length in bytes */
 #define DEFAULT_TRACE_FILTER_LENGTH       24
+/** default max deferred trace record size in bytes, header included */
+#ifdef YOTTA_CFG_MBED_TRACE_DEFERRED_RECORD_LENGTH
+#define DEFAULT_TRACE_DEFERRED_RECORD_LENGTH  YOTTA_CFG_MBED_TRACE_DEFERRED_RECORD_LENGTH
+#else
+#define DEFAULT_TRACE_DEFERRED_RECORD_LENGTH  128
+#endif
+
+#if YOTTA_CFG_MBED_TRACE_FEA_DEFERRED == 1
+/** deferred records are kept aligned for the pointers in their header */
+#define TRACE_RECORD_ALIGN(len)  (((len) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+#define TRACE_RECORD_LENGTH      TRACE_RECORD_ALIGN(DEFAULT_TRACE_DEFERRED_RECORD_LENGTH)
+
+/** orders record data against the ring indexes shared by writer and reader */
+#if defined(__GNUC__)
+#define TRACE_MEMORY_BARRIER()   __sync_synchronize()
+#elif defined(__CC_ARM)
+#define TRACE_MEMORY_BARRIER()   __dmb(0xF)
+#elif defined(__ICCARM__)
+#include <intrinsics.h>
+#define TRACE_MEMORY_BARRIER()   __DMB()
+#else
+#define TRACE_MEMORY_BARRIER()
+#endif
+#endif
 
 /** default print function, just redirect str to printf */
 static void mbed_trace_realloc( char **buffer, int *length_ptr, int new_length);
 static void mbed_trace_default_print(const char *str);
 static void mbed_trace_reset_tmp(void);
+#if YOTTA_CFG_MBED_TRACE_FEA_DEFERRED == 1
+static void mbed_trace_deferred_store(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+#endif
 
 typedef struct trace_s {
     /** trace configuration bits */
@@ -109,6 +136,24 @@ typedef struct trace_s {
     void (*mutex_release_f)(void);
     /** number of times the mutex has been locked */
     int mutex_lock_count;
+#if YOTTA_CFG_MBED_TRACE_FEA_DEFERRED == 1
+    /** deferred trace ring buffer */
+    uint8_t *deferred_data;
+    /** deferred trace ring buffer length */
+    uint32_t deferred_size;
+    /** offset of next record to write, only changed by trace calls */
+    volatile uint32_t deferred_head;
+    /** offset of next record to read, only changed by flush and read */
+    volatile uint32_t deferred_tail;
+    /** number of traces dropped because ring buffer was full */
+    volatile uint32_t deferred_dropped;
+    /** deferred trace text, rendered without holding the mutex */
+    char *deferred_line;
+    /** deferred trace text length */
+    int deferred_line_length;
+    /** timestamp function for deferred traces */
+    uint32_t (*timestamp_f)(void);
+#endif
 } trace_t;
 
 static trace_t m_trace = {
@@ -122,7 +167,12 @@ static trace_t m_trace = {
     .cmd_printf = 0,
     .mutex_wait_f = 0,
     .mutex_release_f = 0,
-    .mutex_lock_count = 0
+    .mutex_lock_count = 0,
+#if YOTTA_CFG_MBED_TRACE_FEA_DEFERRED == 1
+    .deferred_data = 0,
+    .deferred_line = 0,
+    .timestamp_f = 0
+#endif
 };
 
 int mbed_trace_init(void)
@@ -185,6 +235,10 @@ void mbed_trace_free(void)
     m_trace.mutex_wait_f = 0;
     m_trace.mutex_release_f = 0;
     m_trace.mutex_lock_count = 0;
+#if YOTTA_CFG_MBED_TRACE_FEA_DEFERRED == 1
+    mbed_trace_deferred_buffer_size(0);
+    m_trace.timestamp_f = 0;
+#endif
 }
 static void mbed_trace_realloc( char **buffer, int *length_ptr, int new_length)
 {
@@ -281,99 +335,28 @@ static void mbed_trace_default_print(const char *str)
 {
     puts(str);
 }
-void mbed_tracef(uint8_t dlevel, const char *grp, const char *fmt, ...)
+static void mbed_trace_vprint(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
 {
-    va_list ap;
-    va_start(ap, fmt);
-    mbed_vtracef(dlevel, grp, fmt, ap);
-    va_end(ap);
-}
-void mbed_vtracef(uint8_t dlevel, const char* grp, const char *fmt, va_list ap)
-{
-    if ( m_trace.mutex_wait_f ) {
-        m_trace.mutex_wait_f();
-        m_trace.mutex_lock_count++;
-    }
-
-    if (NULL == m_trace.line) {
-        goto end;
-    }
-
-    m_trace.line[0] = 0; //by default trace is empty
+    bool color = (m_trace.trace_config & TRACE_MODE_COLOR) != 0;
+    bool plain = (m_trace.trace_config & TRACE_MODE_PLAIN) != 0;
+    bool cr    = (m_trace.trace_config & TRACE_CARRIAGE_RETURN) != 0;
 
-    if (mbed_trace_skip(dlevel, grp) || fmt == 0 || grp == 0 || !m_trace.printf) {
-        //return tmp data pointer back to the beginning
-        mbed_trace_reset_tmp();
-        goto end;
-    }
-    if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
-        bool color = (m_trace.trace_config & TRACE_MODE_COLOR) != 0;
-        bool plain = (m_trace.trace_config & TRACE_MODE_PLAIN) != 0;
-        bool cr    = (m_trace.trace_config & TRACE_CARRIAGE_RETURN) != 0;
-
-        int retval = 0, bLeft = m_trace.line_length;
-        char *ptr = m_trace.line;
-        if (plain == true || dlevel == TRACE_LEVEL_CMD) {
-            //add trace data
-            retval = vsnprintf(ptr, bLeft, fmt, ap);
-            if (dlevel == TRACE_LEVEL_CMD && m_trace.cmd_printf) {
-                m_trace.cmd_printf(m_trace.line);
-                m_trace.cmd_printf("\n");
-            } else {
-                //print out whole data
-                m_trace.printf(m_trace.line);
-            }
+    int retval = 0, bLeft = m_trace.line_length;
+    char *ptr = m_trace.line;
+    if (plain == true || dlevel == TRACE_LEVEL_CMD) {
+        //add trace data
+        retval = vsnprintf(ptr, bLeft, fmt, ap);
+        if (dlevel == TRACE_LEVEL_CMD && m_trace.cmd_printf) {
+            m_trace.cmd_printf(m_trace.line);
+            m_trace.cmd_printf("\n");
         } else {
-            if (color) {
-                if (cr) {
-                    retval = snprintf(ptr, bLeft, "\r\x1b[2K");
-                    if (retval >= bLeft) {
-                        retval = 0;
-                    }
-                    if (retval > 0) {
-                        ptr += retval;
-                        bLeft -= retval;
-                    }
-                }
-                if (bLeft > 0) {
-                    //include color in ANSI/VT100 escape code
-                    switch (dlevel) {
-                        case (TRACE_LEVEL_ERROR):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_ERROR);
-                            break;
-                        case (TRACE_LEVEL_WARN):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_WARN);
-                            break;
-                        case (TRACE_LEVEL_INFO):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_INFO);
-                            break;
-                        case (TRACE_LEVEL_DEBUG):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_DEBUG);
-                            break;
-                        default:
-                            color = 0; //avoid unneeded color-terminate code
-                            retval = 0;
-                            break;
-                    }
-                    if (retval >= bLeft) {
-                        retval = 0;
-                    }
-                    if (retval > 0 && color) {
-                        ptr += retval;
-                        bLeft -= retval;
-                    }
-                }
-
-            }
-            if (bLeft > 0 && m_trace.prefix_f) {
-                //find out length of body
-                size_t sz = 0;
-                va_list ap2;
-                va_copy(ap2, ap);
-                sz = vsnprintf(NULL, 0, fmt, ap2) + retval + (retval ? 4 : 0);
-                va_end(ap2);
-                //add prefix string
-                retval = snprintf(ptr, bLeft, "%s", m_trace.prefix_f(sz));
+            //print out whole data
+            m_trace.printf(m_trace.line);
+        }
+    } else {
+        if (color) {
+            if (cr) {
+                retval = snprintf(ptr, bLeft, "\r\x1b[2K");
                 if (retval >= bLeft) {
                     retval = 0;
                 }
@@ -383,70 +366,152 @@ void mbed_vtracef(uint8_t dlevel, const char* grp, const char *fmt, va_list ap)
                 }
             }
             if (bLeft > 0) {
-                //add group tag
+                //include color in ANSI/VT100 escape code
                 switch (dlevel) {
                     case (TRACE_LEVEL_ERROR):
-                        retval = snprintf(ptr, bLeft, "[ERR ][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_ERROR);
                         break;
                     case (TRACE_LEVEL_WARN):
-                        retval = snprintf(ptr, bLeft, "[WARN][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_WARN);
                         break;
                     case (TRACE_LEVEL_INFO):
-                        retval = snprintf(ptr, bLeft, "[INFO][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_INFO);
                         break;
                     case (TRACE_LEVEL_DEBUG):
-                        retval = snprintf(ptr, bLeft, "[DBG ][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_DEBUG);
                         break;
                     default:
-                        retval = snprintf(ptr, bLeft, "              ");
+                        color = 0; //avoid unneeded color-terminate code
+                        retval = 0;
                         break;
                 }
                 if (retval >= bLeft) {
                     retval = 0;
                 }
-                if (retval > 0) {
+                if (retval > 0 && color) {
                     ptr += retval;
                     bLeft -= retval;
                 }
             }
-            if (retval > 0 && bLeft > 0) {
-                //add trace text
-                retval = vsnprintf(ptr, bLeft, fmt, ap);
-                if (retval >= bLeft) {
-                    retval = 0;
-                }
-                if (retval > 0) {
-                    ptr += retval;
-                    bLeft -= retval;
-                }
+
+        }
+        if (bLeft > 0 && m_trace.prefix_f) {
+            //find out length of body
+            size_t sz = 0;
+            va_list ap2;
+            va_copy(ap2, ap);
+            sz = vsnprintf(NULL, 0, fmt, ap2) + retval + (retval ? 4 : 0);
+            va_end(ap2);
+            //add prefix string
+            retval = snprintf(ptr, bLeft, "%s", m_trace.prefix_f(sz));
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
+            }
+        }
+        if (bLeft > 0) {
+            //add group tag
+            switch (dlevel) {
+                case (TRACE_LEVEL_ERROR):
+                    retval = snprintf(ptr, bLeft, "[ERR ][%-4s]: ", grp);
+                    break;
+                case (TRACE_LEVEL_WARN):
+                    retval = snprintf(ptr, bLeft, "[WARN][%-4s]: ", grp);
+                    break;
+                case (TRACE_LEVEL_INFO):
+                    retval = snprintf(ptr, bLeft, "[INFO][%-4s]: ", grp);
+                    break;
+                case (TRACE_LEVEL_DEBUG):
+                    retval = snprintf(ptr, bLeft, "[DBG ][%-4s]: ", grp);
+                    break;
+                default:
+                    retval = snprintf(ptr, bLeft, "              ");
+                    break;
             }
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
+            }
+        }
+        if (retval > 0 && bLeft > 0) {
+            //add trace text
+            retval = vsnprintf(ptr, bLeft, fmt, ap);
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
+            }
+        }
 
-            if (retval > 0 && bLeft > 0  && m_trace.suffix_f) {
-                //add suffix string
-                retval = snprintf(ptr, bLeft, "%s", m_trace.suffix_f());
-                if (retval >= bLeft) {
-                    retval = 0;
-                }
-                if (retval > 0) {
-                    ptr += retval;
-                    bLeft -= retval;
-                }
+        if (retval > 0 && bLeft > 0  && m_trace.suffix_f) {
+            //add suffix string
+            retval = snprintf(ptr, bLeft, "%s", m_trace.suffix_f());
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
             }
+        }
 
-            if (retval > 0 && bLeft > 0  && color) {
-                //add zero color VT100 when color mode
-                retval = snprintf(ptr, bLeft, "\x1b[0m");
-                if (retval >= bLeft) {
-                    retval = 0;
-                }
-                if (retval > 0) {
-                    // not used anymore
-                    //ptr += retval;
-                    //bLeft -= retval;
-                }
+        if (retval > 0 && bLeft > 0  && color) {
+            //add zero color VT100 when color mode
+            retval = snprintf(ptr, bLeft, "\x1b[0m");
+            if (retval >= bLeft) {
+                retval = 0;
             }
-            //print out whole data
-            m_trace.printf(m_trace.line);
+            if (retval > 0) {
+                // not used anymore
+                //ptr += retval;
+                //bLeft -= retval;
+            }
+        }
+        //print out whole data
+        m_trace.printf(m_trace.line);
+    }
+}
+void mbed_tracef(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    mbed_vtracef(dlevel, grp, fmt, ap);
+    va_end(ap);
+}
+void mbed_vtracef(uint8_t dlevel, const char* grp, const char *fmt, va_list ap)
+{
+    if ( m_trace.mutex_wait_f ) {
+        m_trace.mutex_wait_f();
+        m_trace.mutex_lock_count++;
+    }
+
+    if (NULL == m_trace.line) {
+        goto end;
+    }
+
+    m_trace.line[0] = 0; //by default trace is empty
+
+    if (mbed_trace_skip(dlevel, grp) || fmt == 0 || grp == 0 || !m_trace.printf) {
+        //return tmp data pointer back to the beginning
+        mbed_trace_reset_tmp();
+        goto end;
+    }
+    if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
+#if YOTTA_CFG_MBED_TRACE_FEA_DEFERRED == 1
+        if (m_trace.deferred_data && dlevel != TRACE_LEVEL_CMD) {
+            mbed_trace_deferred_store(dlevel, grp, fmt, ap);
+        } else
+#endif
+        {
+            mbed_trace_vprint(dlevel, grp, fmt, ap);
         }
         //return tmp data pointer back to the beginning
         mbed_trace_reset_tmp();
@@ -570,3 +635,428 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len)
     m_trace.tmp_data_ptr = wptr;
     return str;
 }
+#if YOTTA_CFG_MBED_TRACE_FEA_DEFERRED == 1
+/* Deferred traces */
+
+/** argument types of printf conversions, in the size they are stored */
+typedef enum {
+    TRACE_ARG_NONE = 0,
+    TRACE_ARG_INT,
+    TRACE_ARG_LONG,
+    TRACE_ARG_LONG_LONG,
+    TRACE_ARG_SIZE,
+    TRACE_ARG_INTMAX,
+    TRACE_ARG_PTRDIFF,
+    TRACE_ARG_DOUBLE,
+    TRACE_ARG_LONG_DOUBLE,
+    TRACE_ARG_POINTER,
+    TRACE_ARG_STRING,
+    TRACE_ARG_COUNT
+} trace_arg_e;
+
+/** Parse conversion following '%' up to and including the conversion character */
+static const char *mbed_trace_conversion(const char *fmt, trace_arg_e *type)
+{
+    trace_arg_e integer = TRACE_ARG_INT;
+    bool long_double = false;
+
+    while (*fmt && strchr("-+ #0", *fmt)) {
+        fmt++;
+    }
+    while ((*fmt >= '0' && *fmt <= '9') || *fmt == '*' || *fmt == '.') {
+        fmt++;
+    }
+    switch (*fmt) {
+        case 'h':
+            fmt += (fmt[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            if (fmt[1] == 'l') {
+                integer = TRACE_ARG_LONG_LONG;
+                fmt++;
+            } else {
+                integer = TRACE_ARG_LONG;
+            }
+            fmt++;
+            break;
+        case 'z':
+            integer = TRACE_ARG_SIZE;
+            fmt++;
+            break;
+        case 'j':
+            integer = TRACE_ARG_INTMAX;
+            fmt++;
+            break;
+        case 't':
+            integer = TRACE_ARG_PTRDIFF;
+            fmt++;
+            break;
+        case 'L':
+            long_double = true;
+            fmt++;
+            break;
+        default:
+            break;
+    }
+    switch (*fmt) {
+        case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+            *type = integer;
+            break;
+        case 'c':
+            *type = TRACE_ARG_INT;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            *type = long_double ? TRACE_ARG_LONG_DOUBLE : TRACE_ARG_DOUBLE;
+            break;
+        case 'p':
+            *type = TRACE_ARG_POINTER;
+            break;
+        case 's':
+            *type = TRACE_ARG_STRING;
+            break;
+        case 'n':
+            *type = TRACE_ARG_COUNT;
+            break;
+        case '\0':
+            // truncated conversion, don't step over the terminator
+            *type = TRACE_ARG_NONE;
+            return fmt;
+        default:
+            *type = TRACE_ARG_NONE;
+            break;
+    }
+    return fmt + 1;
+}
+static uint8_t *mbed_trace_deferred_put(uint8_t *ptr, const uint8_t *end, const void *value, size_t size)
+{
+    if (ptr == NULL || (size_t)(end - ptr) < size) {
+        return NULL;
+    }
+    memcpy(ptr, value, size);
+    return ptr + size;
+}
+#define TRACE_ARG_STORE(c_type) \
+    { c_type value = va_arg(ap2, c_type); ptr = mbed_trace_deferred_put(ptr, end, &value, sizeof(value)); }
+
+/** Reserve space for a record. Only called by trace calls, which hold the mutex. */
+static uint8_t *mbed_trace_deferred_reserve(void)
+{
+    uint32_t head = m_trace.deferred_head;
+    uint32_t tail = m_trace.deferred_tail;
+    TRACE_MEMORY_BARRIER();
+
+    // head must not reach tail, equal offsets mean an empty buffer
+    if (head >= tail) {
+        uint32_t left = m_trace.deferred_size - head;
+        if (left > TRACE_RECORD_LENGTH || (left == TRACE_RECORD_LENGTH && tail != 0)) {
+            return m_trace.deferred_data + head;
+        }
+        if (TRACE_RECORD_LENGTH < tail) {
+            // zero length tells the reader to continue from the beginning
+            ((mbed_trace_record_t *)(m_trace.deferred_data + head))->length = 0;
+            return m_trace.deferred_data;
+        }
+    } else if (TRACE_RECORD_LENGTH < tail - head) {
+        return m_trace.deferred_data + head;
+    }
+    return NULL;
+}
+static void mbed_trace_deferred_store(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    uint8_t *start = mbed_trace_deferred_reserve();
+    if (start == NULL) {
+        m_trace.deferred_dropped++;
+        return;
+    }
+
+    mbed_trace_record_t record;
+    record.level = dlevel;
+    record.flags = 0;
+    record.timestamp = m_trace.timestamp_f ? m_trace.timestamp_f() : 0;
+    record.fmt = fmt;
+    record.grp = grp;
+
+    uint8_t *ptr = start + sizeof(record);
+    const uint8_t *end = start + TRACE_RECORD_LENGTH;
+    va_list ap2;
+    va_copy(ap2, ap);
+    while (*fmt && ptr) {
+        if (*fmt++ != '%') {
+            continue;
+        }
+        const char *spec = fmt;
+        trace_arg_e type;
+        fmt = mbed_trace_conversion(fmt, &type);
+        for (; spec < fmt && ptr; spec++) {
+            if (*spec == '*') {
+                TRACE_ARG_STORE(int);
+            }
+        }
+        if (ptr == NULL) {
+            break;
+        }
+        switch (type) {
+            case TRACE_ARG_INT:         TRACE_ARG_STORE(int); break;
+            case TRACE_ARG_LONG:        TRACE_ARG_STORE(long); break;
+            case TRACE_ARG_LONG_LONG:   TRACE_ARG_STORE(long long); break;
+            case TRACE_ARG_SIZE:        TRACE_ARG_STORE(size_t); break;
+            case TRACE_ARG_INTMAX:      TRACE_ARG_STORE(intmax_t); break;
+            case TRACE_ARG_PTRDIFF:     TRACE_ARG_STORE(ptrdiff_t); break;
+            case TRACE_ARG_DOUBLE:      TRACE_ARG_STORE(double); break;
+            case TRACE_ARG_LONG_DOUBLE: TRACE_ARG_STORE(long double); break;
+            case TRACE_ARG_POINTER:     TRACE_ARG_STORE(void *); break;
+            case TRACE_ARG_STRING: {
+                // strings are copied, the helper functions reuse their buffer
+                const char *str = va_arg(ap2, const char *);
+                size_t len, left = end - ptr;
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                len = strlen(str);
+                if (left == 0) {
+                    ptr = NULL;
+                } else if (len >= left) {
+                    len = left - 1;
+                    ptr[len] = 0;
+                    memcpy(ptr, str, len);
+                    ptr = NULL;
+                } else {
+                    memcpy(ptr, str, len + 1);
+                    ptr += len + 1;
+                }
+                break;
+            }
+            case TRACE_ARG_COUNT:
+                // nothing is written back for deferred traces
+                (void)va_arg(ap2, void *);
+                break;
+            default:
+                break;
+        }
+    }
+    va_end(ap2);
+
+    if (ptr == NULL) {
+        record.flags |= TRACE_RECORD_TRUNCATED;
+        ptr = (uint8_t *)end;
+    }
+    record.length = TRACE_RECORD_ALIGN(ptr - start);
+    memcpy(start, &record, sizeof(record));
+
+    uint32_t head = (start - m_trace.deferred_data) + record.length;
+    if (head == m_trace.deferred_size) {
+        head = 0;
+    }
+    TRACE_MEMORY_BARRIER();
+    m_trace.deferred_head = head;
+}
+/** Get oldest record, NULL when buffer is empty */
+static const mbed_trace_record_t *mbed_trace_deferred_peek(void)
+{
+    while (m_trace.deferred_tail != m_trace.deferred_head) {
+        TRACE_MEMORY_BARRIER();
+        const mbed_trace_record_t *record = (const mbed_trace_record_t *)(m_trace.deferred_data + m_trace.deferred_tail);
+        if (record->length) {
+            return record;
+        }
+        m_trace.deferred_tail = 0;
+    }
+    return NULL;
+}
+static void mbed_trace_deferred_release(const mbed_trace_record_t *record)
+{
+    uint32_t tail = m_trace.deferred_tail + record->length;
+    if (tail == m_trace.deferred_size) {
+        tail = 0;
+    }
+    TRACE_MEMORY_BARRIER();
+    m_trace.deferred_tail = tail;
+}
+#define TRACE_ARG_RENDER(c_type) \
+    { c_type value; \
+      if ((size_t)(end - args) < sizeof(value)) { missing = true; break; } \
+      memcpy(&value, args, sizeof(value)); args += sizeof(value); \
+      retval = snprintf(ptr, bLeft, spec, value); }
+
+/** Render record text into line, like vsnprintf() would have done */
+static void mbed_trace_deferred_render(char *line, int line_length, const mbed_trace_record_t *record)
+{
+    const uint8_t *args = (const uint8_t *)record + sizeof(*record);
+    const uint8_t *end = (const uint8_t *)record + record->length;
+    const char *fmt = record->fmt;
+    char *ptr = line;
+    int retval, bLeft = line_length;
+    char spec[24];
+
+    line[0] = 0;
+    if (m_trace.timestamp_f) {
+        retval = snprintf(ptr, bLeft, "[%lu] ", (unsigned long)record->timestamp);
+        if (retval > 0 && retval < bLeft) {
+            ptr += retval;
+            bLeft -= retval;
+        }
+    }
+    while (*fmt && bLeft > 1) {
+        if (*fmt != '%') {
+            *ptr++ = *fmt++;
+            *ptr = 0;
+            bLeft--;
+            continue;
+        }
+        const char *conversion = fmt++;
+        trace_arg_e type;
+        fmt = mbed_trace_conversion(fmt, &type);
+
+        // copy conversion, with '*' widths and precisions written out
+        size_t spec_len = 0;
+        bool missing = false;
+        for (; conversion < fmt && spec_len < sizeof(spec) - 12; conversion++) {
+            if (*conversion != '*') {
+                spec[spec_len++] = *conversion;
+                continue;
+            }
+            int value;
+            if ((size_t)(end - args) < sizeof(value)) {
+                missing = true;
+                break;
+            }
+            memcpy(&value, args, sizeof(value));
+            args += sizeof(value);
+            if (value < 0 && spec_len && spec[spec_len - 1] == '.') {
+                // negative precision is taken as if it was omitted
+                spec_len--;
+                continue;
+            }
+            spec_len += sprintf(spec + spec_len, "%d", value);
+        }
+        if (missing || conversion < fmt) {
+            break;
+        }
+        spec[spec_len] = 0;
+
+        retval = 0;
+        switch (type) {
+            case TRACE_ARG_INT:         TRACE_ARG_RENDER(int); break;
+            case TRACE_ARG_LONG:        TRACE_ARG_RENDER(long); break;
+            case TRACE_ARG_LONG_LONG:   TRACE_ARG_RENDER(long long); break;
+            case TRACE_ARG_SIZE:        TRACE_ARG_RENDER(size_t); break;
+            case TRACE_ARG_INTMAX:      TRACE_ARG_RENDER(intmax_t); break;
+            case TRACE_ARG_PTRDIFF:     TRACE_ARG_RENDER(ptrdiff_t); break;
+            case TRACE_ARG_DOUBLE:      TRACE_ARG_RENDER(double); break;
+            case TRACE_ARG_LONG_DOUBLE: TRACE_ARG_RENDER(long double); break;
+            case TRACE_ARG_POINTER:     TRACE_ARG_RENDER(void *); break;
+            case TRACE_ARG_STRING: {
+                const char *str = (const char *)args;
+                const char *str_end = memchr(str, 0, end - args);
+                if (str_end == NULL) {
+                    missing = true;
+                    break;
+                }
+                args = (const uint8_t *)str_end + 1;
+                retval = snprintf(ptr, bLeft, spec, str);
+                break;
+            }
+            case TRACE_ARG_COUNT:
+                break;
+            default:
+                // "%%" and unknown conversions
+                retval = snprintf(ptr, bLeft, "%s", spec[1] == '%' ? "%" : spec);
+                break;
+        }
+        if (missing || retval < 0) {
+            break;
+        }
+        if (retval >= bLeft) {
+            retval = bLeft - 1;
+        }
+        ptr += retval;
+        bLeft -= retval;
+    }
+    if ((record->flags & TRACE_RECORD_TRUNCATED) && ptr > line) {
+        // same mark as mbed_trace_array() uses for cut data
+        *(ptr - 1) = '*';
+    }
+}
+static void mbed_trace_deferred_printf(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    mbed_trace_vprint(dlevel, grp, fmt, ap);
+    va_end(ap);
+}
+int mbed_trace_deferred_buffer_size(int size)
+{
+    MBED_TRACE_MEM_FREE(m_trace.deferred_data);
+    m_trace.deferred_data = 0;
+    MBED_TRACE_MEM_FREE(m_trace.deferred_line);
+    m_trace.deferred_line = 0;
+    m_trace.deferred_size = 0;
+    m_trace.deferred_head = 0;
+    m_trace.deferred_tail = 0;
+    m_trace.deferred_dropped = 0;
+
+    if (size <= 0) {
+        return 0;
+    }
+    size = TRACE_RECORD_ALIGN(size - (sizeof(void *) - 1));
+    if (m_trace.line == NULL || size <= (int)TRACE_RECORD_LENGTH) {
+        return -1;
+    }
+    m_trace.deferred_line_length = m_trace.line_length;
+    m_trace.deferred_line = MBED_TRACE_MEM_ALLOC(m_trace.deferred_line_length);
+    m_trace.deferred_data = MBED_TRACE_MEM_ALLOC(size);
+    if (m_trace.deferred_line == NULL || m_trace.deferred_data == NULL) {
+        mbed_trace_deferred_buffer_size(0);
+        return -1;
+    }
+    m_trace.deferred_size = size;
+    return 0;
+}
+void mbed_trace_timestamp_function_set(uint32_t (*timestamp_f)(void))
+{
+    m_trace.timestamp_f = timestamp_f;
+}
+int mbed_trace_deferred_flush(int max_count)
+{
+    const mbed_trace_record_t *record;
+    int count = 0;
+
+    while ((max_count == 0 || count < max_count) &&
+            m_trace.deferred_data && (record = mbed_trace_deferred_peek()) != NULL) {
+        uint8_t dlevel = record->level;
+        const char *grp = record->grp;
+        mbed_trace_deferred_render(m_trace.deferred_line, m_trace.deferred_line_length, record);
+        mbed_trace_deferred_release(record);
+
+        // only printing is serialised with trace calls
+        if (m_trace.mutex_wait_f) {
+            m_trace.mutex_wait_f();
+        }
+        if (m_trace.line && m_trace.printf) {
+            mbed_trace_deferred_printf(dlevel, grp, "%s", m_trace.deferred_line);
+        }
+        if (m_trace.mutex_release_f) {
+            m_trace.mutex_release_f();
+        }
+        count++;
+    }
+    return count;
+}
+int mbed_trace_deferred_read(uint8_t *buf, int len)
+{
+    const mbed_trace_record_t *record;
+    int copied = 0;
+
+    while (m_trace.deferred_data && (record = mbed_trace_deferred_peek()) != NULL &&
+            record->length <= len - copied) {
+        memcpy(buf + copied, record, record->length);
+        copied += record->length;
+        mbed_trace_deferred_release(record);
+    }
+    return copied;
+}
+uint32_t mbed_trace_deferred_dropped(void)
+{
+    return m_trace.deferred_dropped;
+}
+#endif //YOTTA_CFG_MBED_TRACE_FEA_DEFERRED
@@ -429,3 +429,150 @@ TEST(trace, uninitialized)
     STRCMP_EQUAL("hello", buf);
 }
 
+TEST(trace, deferred)
+{
+    CHECK(mbed_trace_deferred_buffer_size(1024) == 0);
+    buf[0] = 0;
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "hello %d %s", 12, "world");
+    mbed_tracef(TRACE_LEVEL_INFO, "mygr", "second");
+    STRCMP_EQUAL("", buf);
+
+    CHECK(mbed_trace_deferred_flush(1) == 1);
+    STRCMP_EQUAL("hello 12 world", buf);
+    CHECK(mbed_trace_deferred_flush(0) == 1);
+    STRCMP_EQUAL("second", buf);
+    CHECK(mbed_trace_deferred_flush(0) == 0);
+
+    mbed_trace_config_set(TRACE_ACTIVE_LEVEL_ALL);
+    mbed_tracef(TRACE_LEVEL_WARN, "mygr", "test");
+    mbed_trace_deferred_flush(0);
+    STRCMP_EQUAL("[WARN][mygr]: test", buf);
+
+    // cmdline is not deferred
+    mbed_tracef(TRACE_LEVEL_CMD, "mygr", "cmd");
+    STRCMP_EQUAL("cmd", buf);
+
+    // filtered levels are not stored
+    mbed_trace_config_set(TRACE_ACTIVE_LEVEL_INFO);
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "not stored");
+    CHECK(mbed_trace_deferred_flush(0) == 0);
+
+    CHECK(mbed_trace_deferred_buffer_size(0) == 0);
+    mbed_tracef(TRACE_LEVEL_INFO, "mygr", "immediate");
+    STRCMP_EQUAL("[INFO][mygr]: immediate", buf);
+}
+TEST(trace, deferred_formatting)
+{
+    char expected[256];
+    int value = 7;
+    const char *fmt = "%5d|%-4s|%lu|%lld|%#x|%c|%.2f|%p|%%|%*d|%.*s|%zu|%hhd|%-*.*s|";
+    snprintf(expected, sizeof(expected), fmt, -12, "ab", 123456UL, -5LL, 255, 'z', 3.14159,
+             (void *)&value, 6, 42, 3, "abcdef", (size_t)99, 5, -6, 2, "xyz");
+
+    mbed_trace_deferred_buffer_size(1024);
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", fmt, -12, "ab", 123456UL, -5LL, 255, 'z', 3.14159,
+                (void *)&value, 6, 42, 3, "abcdef", (size_t)99, 5, -6, 2, "xyz");
+    CHECK(mbed_trace_deferred_flush(0) == 1);
+    STRCMP_EQUAL(expected, buf);
+}
+TEST(trace, deferred_strings)
+{
+    uint8_t arr[] = {0x01, 0x02, 0x03};
+    char str[] = "stack";
+
+    mbed_trace_deferred_buffer_size(1024);
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "%s %s", mbed_trace_array(arr, 3), str);
+    // both the helper buffer and the string are reused before flushing
+    uint8_t arr2[] = {0xff};
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "%s", mbed_trace_array(arr2, 1));
+    strcpy(str, "xxxxx");
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "%s", (char *)NULL);
+
+    mbed_trace_deferred_flush(1);
+    STRCMP_EQUAL("01:02:03 stack", buf);
+    mbed_trace_deferred_flush(1);
+    STRCMP_EQUAL("ff", buf);
+    mbed_trace_deferred_flush(1);
+    STRCMP_EQUAL("(null)", buf);
+}
+TEST(trace, deferred_truncated)
+{
+    char longStr[300];
+    memset(longStr, 'a', sizeof(longStr) - 1);
+    longStr[sizeof(longStr) - 1] = 0;
+
+    mbed_trace_deferred_buffer_size(1024);
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "%s %d", longStr, 5);
+    CHECK(mbed_trace_deferred_flush(0) == 1);
+    CHECK(strlen(buf) > 32 && strlen(buf) < 128);
+    CHECK(buf[0] == 'a');
+    CHECK(buf[strlen(buf) - 1] == '*');
+}
+TEST(trace, deferred_full)
+{
+    int i, count = 0;
+    char expected[32];
+
+    mbed_trace_deferred_buffer_size(512);
+    for (i = 0; i < 100; i++) {
+        mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "trace %d", i);
+    }
+    CHECK(mbed_trace_deferred_dropped() > 0);
+    count = mbed_trace_deferred_flush(0);
+    CHECK(count > 0);
+    CHECK(count + mbed_trace_deferred_dropped() == 100);
+    sprintf(expected, "trace %d", count - 1);
+    STRCMP_EQUAL(expected, buf);
+
+    // records wrap around the end of the buffer
+    for (i = 0; i < 1000; i++) {
+        mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "wrap %d %s", i, (i % 3) ? "x" : "longer string");
+        if (i >= 2) {
+            CHECK(mbed_trace_deferred_flush(1) == 1);
+            sprintf(expected, "wrap %d %s", i - 2, ((i - 2) % 3) ? "x" : "longer string");
+            STRCMP_EQUAL(expected, buf);
+        }
+    }
+    CHECK(mbed_trace_deferred_flush(0) == 2);
+}
+uint32_t trace_timestamp()
+{
+    return 42;
+}
+TEST(trace, deferred_timestamp)
+{
+    mbed_trace_deferred_buffer_size(1024);
+    mbed_trace_timestamp_function_set(&trace_timestamp);
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "test");
+    mbed_trace_deferred_flush(0);
+    STRCMP_EQUAL("[42] test", buf);
+}
+TEST(trace, deferred_read)
+{
+    uint8_t data[256];
+    const char *fmt = "raw %d";
+    mbed_trace_record_t record;
+
+    mbed_trace_deferred_buffer_size(1024);
+    mbed_trace_timestamp_function_set(&trace_timestamp);
+    mbed_tracef(TRACE_LEVEL_ERROR, "mygr", fmt, 1234);
+    mbed_tracef(TRACE_LEVEL_ERROR, "mygr", fmt, 5678);
+
+    // only whole records are read
+    CHECK(mbed_trace_deferred_read(data, sizeof(record)) == 0);
+    int len = mbed_trace_deferred_read(data, sizeof(data));
+    CHECK(len > 0);
+    memcpy(&record, data, sizeof(record));
+    CHECK(record.length * 2 == len);
+    CHECK(record.level == TRACE_LEVEL_ERROR);
+    CHECK(record.flags == 0);
+    CHECK(record.timestamp == 42);
+    POINTERS_EQUAL(fmt, record.fmt);
+    STRCMP_EQUAL("mygr", record.grp);
+    int value;
+    memcpy(&value, data + sizeof(record), sizeof(value));
+    CHECK(value == 1234);
+    memcpy(&value, data + record.length + sizeof(record), sizeof(value));
+    CHECK(value == 5678);
+    CHECK(mbed_trace_deferred_flush(0) == 0);
+}
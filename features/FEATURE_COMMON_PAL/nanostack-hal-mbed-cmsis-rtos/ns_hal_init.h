@@ -19,9 +19,8 @@ extern "C" {
  * they call this first with a "large" heap size, before anyone
  * requests a smaller one.
  *
- * Parameters are as for ns_dyn_mem_init (but note that nsdynmemlib
- * currently limits heap size to 16-bit, so be wary of passing large
- * sizes.
+ * Parameters are as for ns_dyn_mem_init. Further memory regions can be
+ * added afterwards with ns_dyn_mem_region_add.
  *
  * If heap is NULL, h_size will be allocated from the malloc() heap,
  * else the passed-in pointer will be used.
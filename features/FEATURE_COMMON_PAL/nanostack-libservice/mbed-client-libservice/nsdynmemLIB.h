@@ -28,6 +28,9 @@ extern "C" {
 
 #include "ns_types.h"
 
+typedef size_t ns_mem_block_size_t; //external interface unsigned heap block size type
+typedef size_t ns_mem_heap_size_t; //total heap size type.
+
 /*!
  * \enum heap_fail_t
  * \brief Dynamically heap system failure call back event types.
@@ -47,12 +50,18 @@ typedef enum {
  */
 typedef struct mem_stat_t {
     /*Heap stats*/
-    int16_t heap_sector_size;                   /**< Heap total Sector len. */
-    int16_t heap_sector_alloc_cnt;              /**< Reserved Heap sector cnt. */
-    int16_t heap_sector_allocated_bytes;        /**< Reserved Heap data in bytes. */
-    int16_t heap_sector_allocated_bytes_max;    /**< Reserved Heap data in bytes max value. */
-    uint32_t heap_alloc_total_bytes;            /**< Total Heap allocated bytes. */
-    uint32_t heap_alloc_fail_cnt;               /**< Counter for Heap allocation fail. */
+    ns_mem_heap_size_t heap_sector_size;                /**< Heap total Sector len. */
+    ns_mem_heap_size_t heap_sector_alloc_cnt;           /**< Reserved Heap sector cnt. */
+    ns_mem_heap_size_t heap_sector_allocated_bytes;     /**< Reserved Heap data in bytes. */
+    ns_mem_heap_size_t heap_sector_allocated_bytes_max; /**< Reserved Heap data in bytes max value. */
+    uint32_t heap_alloc_total_bytes;                    /**< Total Heap allocated bytes. */
+    uint32_t heap_alloc_fail_cnt;                       /**< Counter for Heap allocation fail. */
+    /*Fragmentation stats, the last three are refreshed by ns_dyn_mem_get_mem_stat()*/
+    ns_mem_heap_size_t heap_hole_cnt;                   /**< Free hole cnt. */
+    ns_mem_heap_size_t heap_hole_bytes;                 /**< Free hole data in bytes. */
+    ns_mem_heap_size_t heap_longest_hole;               /**< Longest free hole in bytes. */
+    ns_mem_heap_size_t heap_longest_hole_min;           /**< Longest free hole in bytes min value, as seen by ns_dyn_mem_get_mem_stat(). */
+    uint8_t heap_fragmentation;                         /**< Percentage of free hole bytes outside the longest hole. */
 } mem_stat_t;
 
 /**
@@ -62,7 +71,23 @@ typedef struct mem_stat_t {
   * \param heap_size size of the heap buffer
   * \return None
   */
-extern void ns_dyn_mem_init(uint8_t *heap, uint16_t h_size, void (*passed_fptr)(heap_fail_t), mem_stat_t *info_ptr);
+extern void ns_dyn_mem_init(uint8_t *heap, ns_mem_heap_size_t h_size, void (*passed_fptr)(heap_fail_t), mem_stat_t *info_ptr);
+
+/**
+  * \brief Add a further memory region to the heap.
+  *
+  * Allocations may be served from any region, so this can extend the heap
+  * with eg. external SDRAM. A single allocation never spans two regions.
+  * Up to NS_DYN_MEM_REGIONS regions, including the one given to
+  * ns_dyn_mem_init(), are supported.
+  *
+  * \param heap Pointer to the region
+  * \param h_size size of the region
+  *
+  * \return 0, Region added
+  * \return -1, Heap not initialized, no free region slots or region too small
+  */
+extern int ns_dyn_mem_region_add(uint8_t *heap, ns_mem_heap_size_t h_size);
 
 
 /**
@@ -84,7 +109,7 @@ extern void ns_dyn_mem_free(void *heap_ptr);
   * \return 0, Allocate Fail
   * \return >0, Pointer to allocated data sector.
   */
-extern void *ns_dyn_mem_temporary_alloc(int16_t alloc_size);
+extern void *ns_dyn_mem_temporary_alloc(ns_mem_block_size_t alloc_size);
 /**
   * \brief Allocate long period data.
   *
@@ -95,13 +120,15 @@ extern void *ns_dyn_mem_temporary_alloc(int16_t alloc_size);
   * \return 0, Allocate Fail
   * \return >0, Pointer to allocated data sector.
   */
-extern void *ns_dyn_mem_alloc(int16_t alloc_size);
+extern void *ns_dyn_mem_alloc(ns_mem_block_size_t alloc_size);
 
 /**
   * \brief Get pointer to the current mem_stat_t set via ns_dyn_mem_init.
   *
   * Get pointer to the statistics information, if one is set during the
   * initialization. This may be useful for statistics collection purposes.
+  * The longest hole and fragmentation stats are only updated by this call,
+  * since finding the longest hole is too slow to do on every allocation.
   *
   * Note: the caller may not modify the returned structure.
   *
@@ -23,9 +23,25 @@
 void (*heap_failure_callback)(heap_fail_t);
 
 #ifndef STANDARD_MALLOC
-static int *heap_main = 0;
-static int *heap_main_end = 0;
-static uint16_t heap_size = 0;
+typedef int ns_mem_word_size_t; // internal signed heap block size type
+
+// Maximum number of memory regions, including the one given to ns_dyn_mem_init()
+#ifndef NS_DYN_MEM_REGIONS
+#define NS_DYN_MEM_REGIONS 2
+#endif
+
+// Holes are binned by the floor of log2 of their size in words, the last
+// bin also takes all larger holes
+#define NS_DYN_MEM_BINS 24
+
+typedef struct {
+    int *start;     // first word of the region
+    int *end;       // last word of the region
+} heap_region_t;
+
+static heap_region_t heap_regions[NS_DYN_MEM_REGIONS];
+static uint_fast8_t heap_region_cnt = 0;
+static ns_mem_heap_size_t heap_size = 0;
 
 typedef enum mem_stat_update_t {
     DEV_HEAP_ALLOC_OK,
@@ -35,15 +51,23 @@ typedef enum mem_stat_update_t {
 
 
 static mem_stat_t *mem_stat_info_ptr = 0;
+static void dev_stat_holes_update(void);
 
 typedef struct {
     ns_list_link_t link;
 } hole_t;
 
-static NS_LIST_DEFINE(holes_list, hole_t, link);
+typedef NS_LIST_HEAD(hole_t, link) hole_list_t;
+
+// One list per size class, with a bit set in holes_bitmap for each
+// non-empty list
+static hole_list_t holes_bins[NS_DYN_MEM_BINS];
+static uint32_t holes_bitmap;
+static ns_mem_heap_size_t holes_cnt;
+static ns_mem_heap_size_t holes_words;
 
 // size of a hole_t in our word units
-#define HOLE_T_SIZE ((sizeof(hole_t) + sizeof(int) - 1) / sizeof(int))
+#define HOLE_T_SIZE ((ns_mem_word_size_t) ((sizeof(hole_t) + sizeof(int) - 1) / sizeof(int)))
 
 static NS_INLINE hole_t *hole_from_block_start(int *start)
 {
@@ -55,6 +79,86 @@ static NS_INLINE int *block_start_from_hole(hole_t *start)
     return ((int *)start) - 1;
 }
 
+// Index of the most significant set bit, value must not be 0
+static NS_INLINE uint_fast8_t ns_dyn_mem_fls(uint32_t value)
+{
+#if defined __GNUC__
+    return 31 - __builtin_clz(value);
+#elif defined __CC_ARM
+    return 31 - __clz(value);
+#else
+    uint_fast8_t bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// Index of the least significant set bit, value must not be 0
+static NS_INLINE uint_fast8_t ns_dyn_mem_ffs(uint32_t value)
+{
+#if defined __GNUC__
+    return __builtin_ctz(value);
+#else
+    return ns_dyn_mem_fls(value & -value);
+#endif
+}
+
+static NS_INLINE uint_fast8_t hole_bin(ns_mem_word_size_t size)
+{
+    uint_fast8_t bin = ns_dyn_mem_fls(size);
+    return bin < NS_DYN_MEM_BINS ? bin : NS_DYN_MEM_BINS - 1;
+}
+
+static heap_region_t *heap_region_find(const int *ptr)
+{
+    for (uint_fast8_t i = 0; i < heap_region_cnt; i++) {
+        if (ptr >= heap_regions[i].start && ptr < heap_regions[i].end) {
+            return &heap_regions[i];
+        }
+    }
+    return NULL;
+}
+
+// Blocks too small for a hole_t are not tracked, they are only recovered
+// when a neighbour is freed.
+// Temporary allocations take holes from the start of a bin and long period
+// allocations from the end, so holes in the lower half of a region go to the
+// start to keep the two kinds apart as the address ordered list did.
+static void hole_insert(const heap_region_t *region, int *block_start)
+{
+    ns_mem_word_size_t size = -*block_start;
+    if (size < HOLE_T_SIZE) {
+        return;
+    }
+
+    uint_fast8_t bin = hole_bin(size);
+    if (block_start < region->start + (region->end - region->start) / 2) {
+        ns_list_add_to_start(&holes_bins[bin], hole_from_block_start(block_start));
+    } else {
+        ns_list_add_to_end(&holes_bins[bin], hole_from_block_start(block_start));
+    }
+    holes_bitmap |= (uint32_t)1 << bin;
+    holes_cnt++;
+    holes_words += size;
+}
+
+static void hole_remove(int *block_start)
+{
+    ns_mem_word_size_t size = -*block_start;
+    if (size < HOLE_T_SIZE) {
+        return;
+    }
+
+    uint_fast8_t bin = hole_bin(size);
+    ns_list_remove(&holes_bins[bin], hole_from_block_start(block_start));
+    if (ns_list_is_empty(&holes_bins[bin])) {
+        holes_bitmap &= ~((uint32_t)1 << bin);
+    }
+    holes_cnt--;
+    holes_words -= size;
+}
 
 static void heap_failure(heap_fail_t reason)
 {
@@ -63,51 +167,99 @@ static void heap_failure(heap_fail_t reason)
     }
 }
 
-#endif
-
-void ns_dyn_mem_init(uint8_t *heap, uint16_t h_size, void (*passed_fptr)(heap_fail_t), mem_stat_t *info_ptr)
+static bool heap_region_init(uint8_t *heap, ns_mem_heap_size_t h_size)
 {
-#ifndef STANDARD_MALLOC
     int *ptr;
-    int temp_int;
+    ns_mem_word_size_t temp_int;
     /* Do memory alignment */
     temp_int = ((uintptr_t)heap % sizeof(int));
     if (temp_int) {
+        if (h_size < sizeof(int) - temp_int) {
+            return false;
+        }
         heap += (sizeof(int) - temp_int);
         h_size -= (sizeof(int) - temp_int);
     }
 
     /* Make correction for total length also */
-    temp_int = (h_size % sizeof(int));
-    if (temp_int) {
-        h_size -= (sizeof(int) - temp_int);
-    }
-    heap_main = (int *)heap; // SET Heap Pointer
-    heap_size = h_size; //Set Heap Size
+    h_size -= (h_size % sizeof(int));
     temp_int = (h_size / sizeof(int));
     temp_int -= 2;
-    ptr = heap_main;
+    if (temp_int < HOLE_T_SIZE) {
+        return false;
+    }
+
+    heap_region_t *region = &heap_regions[heap_region_cnt++];
+    ptr = (int *)heap;
+    region->start = ptr;
     *ptr = -(temp_int);
     ptr += (temp_int + 1);
     *ptr = -(temp_int);
-    heap_main_end = ptr;
+    region->end = ptr;
+
+    heap_size += h_size;
+    hole_insert(region, region->start);
+    return true;
+}
 
-    ns_list_init(&holes_list);
-    ns_list_add_to_start(&holes_list, hole_from_block_start(heap_main));
+#endif
+
+void ns_dyn_mem_init(uint8_t *heap, ns_mem_heap_size_t h_size, void (*passed_fptr)(heap_fail_t), mem_stat_t *info_ptr)
+{
+#ifndef STANDARD_MALLOC
+    heap_region_cnt = 0;
+    heap_size = 0;
+    holes_bitmap = 0;
+    holes_cnt = 0;
+    holes_words = 0;
+    for (uint_fast8_t i = 0; i < NS_DYN_MEM_BINS; i++) {
+        ns_list_init(&holes_bins[i]);
+    }
+    heap_region_init(heap, h_size);
 
     //RESET Memory by Hea Len
+    mem_stat_info_ptr = info_ptr;
     if (info_ptr) {
-        mem_stat_info_ptr = info_ptr;
         memset(mem_stat_info_ptr, 0, sizeof(mem_stat_t));
         mem_stat_info_ptr->heap_sector_size = heap_size;
+        mem_stat_info_ptr->heap_longest_hole_min = holes_words * sizeof(int);
+        dev_stat_holes_update();
     }
 #endif
     heap_failure_callback = passed_fptr;
 }
 
+int ns_dyn_mem_region_add(uint8_t *heap, ns_mem_heap_size_t h_size)
+{
+#ifndef STANDARD_MALLOC
+    int ret_val = -1;
+
+    platform_enter_critical();
+    if (heap_region_cnt == 0) {
+        heap_failure(NS_DYN_MEM_HEAP_SECTOR_UNITIALIZED);
+    } else if (heap_region_cnt < NS_DYN_MEM_REGIONS && heap_region_init(heap, h_size)) {
+        if (mem_stat_info_ptr) {
+            mem_stat_info_ptr->heap_sector_size = heap_size;
+            dev_stat_holes_update();
+        }
+        ret_val = 0;
+    }
+    platform_exit_critical();
+
+    return ret_val;
+#else
+    return -1;
+#endif
+}
+
 const mem_stat_t *ns_dyn_mem_get_mem_stat(void)
 {
 #ifndef STANDARD_MALLOC
+    if (mem_stat_info_ptr) {
+        platform_enter_critical();
+        dev_stat_holes_update();
+        platform_exit_critical();
+    }
     return mem_stat_info_ptr;
 #else
     return NULL;
@@ -115,7 +267,32 @@ const mem_stat_t *ns_dyn_mem_get_mem_stat(void)
 }
 
 #ifndef STANDARD_MALLOC
-void dev_stat_update(mem_stat_update_t type, int16_t size)
+// Finding the longest hole walks the highest non-empty bin, so this is only
+// done on init, region add and ns_dyn_mem_get_mem_stat(), never per
+// allocation
+static void dev_stat_holes_update(void)
+{
+    ns_mem_word_size_t longest = 0;
+    if (holes_bitmap) {
+        ns_list_foreach(hole_t, cur_hole, &holes_bins[ns_dyn_mem_fls(holes_bitmap)]) {
+            ns_mem_word_size_t size = -*block_start_from_hole(cur_hole);
+            if (size > longest) {
+                longest = size;
+            }
+        }
+    }
+
+    mem_stat_info_ptr->heap_hole_cnt = holes_cnt;
+    mem_stat_info_ptr->heap_hole_bytes = holes_words * sizeof(int);
+    mem_stat_info_ptr->heap_longest_hole = longest * sizeof(int);
+    if (mem_stat_info_ptr->heap_longest_hole_min > mem_stat_info_ptr->heap_longest_hole) {
+        mem_stat_info_ptr->heap_longest_hole_min = mem_stat_info_ptr->heap_longest_hole;
+    }
+    mem_stat_info_ptr->heap_fragmentation = holes_words ?
+            100 - (uint8_t)((uint64_t)longest * 100 / holes_words) : 0;
+}
+
+void dev_stat_update(mem_stat_update_t type, ns_mem_block_size_t size)
 {
     if (mem_stat_info_ptr) {
         switch (type) {
@@ -126,6 +303,8 @@ void dev_stat_update(mem_stat_update_t type, int16_t size)
                     mem_stat_info_ptr->heap_sector_allocated_bytes_max = mem_stat_info_ptr->heap_sector_allocated_bytes;
                 }
                 mem_stat_info_ptr->heap_alloc_total_bytes += size;
+                mem_stat_info_ptr->heap_hole_cnt = holes_cnt;
+                mem_stat_info_ptr->heap_hole_bytes = holes_words * sizeof(int);
                 break;
             case DEV_HEAP_ALLOC_FAIL:
                 mem_stat_info_ptr->heap_alloc_fail_cnt++;
@@ -133,21 +312,25 @@ void dev_stat_update(mem_stat_update_t type, int16_t size)
             case DEV_HEAP_FREE:
                 mem_stat_info_ptr->heap_sector_alloc_cnt--;
                 mem_stat_info_ptr->heap_sector_allocated_bytes -= size;
+                mem_stat_info_ptr->heap_hole_cnt = holes_cnt;
+                mem_stat_info_ptr->heap_hole_bytes = holes_words * sizeof(int);
                 break;
         }
     }
 }
 
-static int convert_allocation_size(int16_t requested_bytes)
+static ns_mem_word_size_t convert_allocation_size(ns_mem_block_size_t requested_bytes)
 {
-    if (heap_main == 0) {
+    if (heap_region_cnt == 0) {
         heap_failure(NS_DYN_MEM_HEAP_SECTOR_UNITIALIZED);
     } else if (requested_bytes < 1) {
         heap_failure(NS_DYN_MEM_ALLOCATE_SIZE_NOT_VALID);
     } else if (requested_bytes > (heap_size - 2 * sizeof(int)) ) {
         heap_failure(NS_DYN_MEM_ALLOCATE_SIZE_NOT_VALID);
+    } else {
+        return (requested_bytes + sizeof(int) - 1) / sizeof(int);
     }
-    return (requested_bytes + sizeof(int) - 1) / sizeof(int);
+    return 0;
 }
 
 // Checks that block length indicators are valid
@@ -165,75 +348,108 @@ static int8_t ns_block_validate(int *block_start, int direction)
     }
     return ret_val;
 }
-#endif
 
-// For direction, use 1 for direction up and -1 for down
-static void *ns_dyn_mem_internal_alloc(const int16_t alloc_size, int direction)
+static bool ns_hole_validate(int *block_start, int direction)
 {
-#ifndef STANDARD_MALLOC
-    int *block_ptr = NULL;
+    if (ns_block_validate(block_start, direction) != 0 || *block_start >= 0) {
+        //Validation failed, or this supposed hole has positive (allocated) size
+        heap_failure(NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+        return false;
+    }
+    return true;
+}
 
-    platform_enter_critical();
+// Every hole in a bin above the one for data_size is big enough, so the
+// smallest of those non-empty bins gives a good fit in constant time. The
+// first hole in the bin for data_size is tried before that, as it is likely
+// an even closer fit, and only if the larger bins are all empty is the rest
+// of that bin searched.
+static int *ns_hole_find(ns_mem_word_size_t data_size, int direction)
+{
+    uint_fast8_t bin = hole_bin(data_size);
+    uint32_t larger = holes_bitmap & ~(((uint32_t)2 << bin) - 1);
 
-    int data_size = convert_allocation_size(alloc_size);
-    if (!data_size) {
-        goto done;
+    if (holes_bitmap & ((uint32_t)1 << bin)) {
+        hole_list_t *list = &holes_bins[bin];
+        hole_t *cur_hole = direction > 0 ? ns_list_get_first(list)
+                                         : ns_list_get_last(list);
+        int *p = block_start_from_hole(cur_hole);
+        if (!ns_hole_validate(p, direction)) {
+            return NULL;
+        }
+        if (-*p >= data_size) {
+            return p;
+        }
+    }
+
+    if (larger) {
+        hole_list_t *list = &holes_bins[ns_dyn_mem_ffs(larger)];
+        hole_t *cur_hole = direction > 0 ? ns_list_get_first(list)
+                                         : ns_list_get_last(list);
+        int *p = block_start_from_hole(cur_hole);
+        return ns_hole_validate(p, direction) ? p : NULL;
     }
 
     // ns_list_foreach, either forwards or backwards, result to ptr
-    for (hole_t *cur_hole = direction > 0 ? ns_list_get_first(&holes_list)
-                                          : ns_list_get_last(&holes_list);
+    hole_list_t *list = &holes_bins[bin];
+    for (hole_t *cur_hole = direction > 0 ? ns_list_get_first(list)
+                                          : ns_list_get_last(list);
          cur_hole;
-         cur_hole = direction > 0 ? ns_list_get_next(&holes_list, cur_hole)
-                                  : ns_list_get_previous(&holes_list, cur_hole)
+         cur_hole = direction > 0 ? ns_list_get_next(list, cur_hole)
+                                  : ns_list_get_previous(list, cur_hole)
         ) {
         int *p = block_start_from_hole(cur_hole);
-        if (ns_block_validate(p, direction) != 0 || *p >= 0) {
-            //Validation failed, or this supposed hole has positive (allocated) size
-            heap_failure(NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+        if (!ns_hole_validate(p, direction)) {
             break;
         }
         if (-*p >= data_size) {
             // Found a big enough block
-            block_ptr = p;
-            break;
+            return p;
         }
     }
+    return NULL;
+}
+#endif
 
+// For direction, use 1 for direction up and -1 for down
+static void *ns_dyn_mem_internal_alloc(const ns_mem_block_size_t alloc_size, int direction)
+{
+#ifndef STANDARD_MALLOC
+    int *block_ptr = NULL;
+
+    platform_enter_critical();
+
+    ns_mem_word_size_t data_size = convert_allocation_size(alloc_size);
+    if (!data_size) {
+        goto done;
+    }
+
+    block_ptr = ns_hole_find(data_size, direction);
     if (!block_ptr) {
         goto done;
     }
 
-    int block_data_size = -*block_ptr;
+    ns_mem_word_size_t block_data_size = -*block_ptr;
+    hole_remove(block_ptr);
     if (block_data_size >= (data_size + 2 + HOLE_T_SIZE)) {
-        int hole_size = block_data_size - data_size - 2;
+        ns_mem_word_size_t hole_size = block_data_size - data_size - 2;
         int *hole_ptr;
         //There is enough room for a new hole so create it first
         if ( direction > 0 ) {
-            hole_ptr = block_ptr + 1 + data_size + 1;
             // Hole will be left at end of area.
-            // Would like to just replace this block_ptr with new descriptor, but
-            // they could overlap, so ns_list_replace might fail
-            //ns_list_replace(&holes_list, block_ptr, hole_from_block_start(hole_ptr));
-            hole_t *before = ns_list_get_previous(&holes_list, hole_from_block_start(block_ptr));
-            ns_list_remove(&holes_list, hole_from_block_start(block_ptr));
-            if (before) {
-                ns_list_add_after(&holes_list, before, hole_from_block_start(hole_ptr));
-            } else {
-                ns_list_add_to_start(&holes_list, hole_from_block_start(hole_ptr));
-            }
+            hole_ptr = block_ptr + 1 + data_size + 1;
         } else {
+            // Hole remains at start of area.
             hole_ptr = block_ptr;
-            // Hole remains at start of area - keep existing descriptor in place.
             block_ptr += 1 + hole_size + 1;
         }
 
         hole_ptr[0] = -hole_size;
         hole_ptr[1 + hole_size] = -hole_size;
+        hole_insert(heap_region_find(hole_ptr), hole_ptr);
     } else {
         // Not enough room for a left-over hole, so use the whole block
         data_size = block_data_size;
-        ns_list_remove(&holes_list, hole_from_block_start(block_ptr));
     }
     block_ptr[0] = data_size;
     block_ptr[1 + data_size] = data_size;
@@ -263,96 +479,48 @@ static void *ns_dyn_mem_internal_alloc(const int16_t alloc_size, int direction)
 #endif
 }
 
-void *ns_dyn_mem_alloc(int16_t alloc_size)
+void *ns_dyn_mem_alloc(ns_mem_block_size_t alloc_size)
 {
     return ns_dyn_mem_internal_alloc(alloc_size, -1);
 }
 
-void *ns_dyn_mem_temporary_alloc(int16_t alloc_size)
+void *ns_dyn_mem_temporary_alloc(ns_mem_block_size_t alloc_size)
 {
     return ns_dyn_mem_internal_alloc(alloc_size, 1);
 }
 
 #ifndef STANDARD_MALLOC
-static void ns_free_and_merge_with_adjacent_blocks(int *cur_block, int data_size)
+static void ns_free_and_merge_with_adjacent_blocks(const heap_region_t *region, int *cur_block, ns_mem_word_size_t data_size)
 {
     // Theory of operation: Block is always in form | Len | Data | Len |
-    // So we need to check length of previous (if current not heap start)
-    // and next (if current not heap end) blocks. Negative length means
+    // So we need to check length of previous (if current not region start)
+    // and next (if current not region end) blocks. Negative length means
     // free memory so we can merge freed block with those.
 
-    hole_t *existing_start = NULL;
-    hole_t *existing_end = NULL;
     int *start = cur_block;
     int *end = cur_block + data_size + 1;
     //invalidate current block
-    *cur_block = -data_size;
+    *start = -data_size;
     *end = -data_size;
-    int merged_data_size = data_size;
-
-    if (cur_block != heap_main) {
-        cur_block--;
-        if (*cur_block < 0) {
-            merged_data_size += (2 - *cur_block);
-            start -= (2 - *cur_block);
-            if (-*start >= HOLE_T_SIZE) {
-                existing_start = hole_from_block_start(start);
-            }
-        }
-        cur_block++;
-    }
+    ns_mem_word_size_t merged_data_size = data_size;
 
-    if (end != heap_main_end) {
-        end++;
-        if (*end < 0) {
-            merged_data_size += (2 - *end);
-            if (-*end >= HOLE_T_SIZE) {
-                existing_end = hole_from_block_start(end);
-            }
-            end += (1 - *end);
-        }else{
-            end--;
-        }
+    if (start != region->start && start[-1] < 0) {
+        int *prev = start - (2 - start[-1]);
+        merged_data_size += (2 - start[-1]);
+        hole_remove(prev);
+        start = prev;
     }
 
-    hole_t *to_add = hole_from_block_start(start);
-    hole_t *before = NULL;
-    if (existing_end) {
-        // Extending hole described by "existing_end" downwards.
-        // Will replace with descriptor at bottom of merged block.
-        // (Can't use ns_list_replace, because of danger of overlap)
-        // Optimisation - note our position for insertion below.
-        before = ns_list_get_next(&holes_list, existing_end);
-        ns_list_remove(&holes_list, existing_end);
-    }
-    if (existing_start) {
-        // Extending hole described by "existing_start" upwards.
-        // No need to modify that descriptor - it remains at the bottom
-        // of the merged block to describe it.
-    } else {
-        // Didn't find adjacent descriptors, but may still
-        // be merging with small blocks without descriptors.
-        if ( merged_data_size >= HOLE_T_SIZE ) {
-            // Locate hole position in list, if we don't already know
-            // from merging with the block above.
-            if (!existing_end) {
-                ns_list_foreach(hole_t, ptr, &holes_list) {
-                    if (ptr > to_add) {
-                        before = ptr;
-                        break;
-                    }
-                }
-            }
-            if (before) {
-                ns_list_add_before(&holes_list, before, to_add);
-            } else {
-                ns_list_add_to_end(&holes_list, to_add);
-            }
-
-        }
+    if (end != region->end && end[1] < 0) {
+        int *next = end + 1;
+        merged_data_size += (2 - *next);
+        hole_remove(next);
+        end = next + (1 - *next);
     }
+
     *start = -merged_data_size;
     *end = -merged_data_size;
+    hole_insert(region, start);
 }
 #endif
 
@@ -360,32 +528,34 @@ void ns_dyn_mem_free(void *block)
 {
 #ifndef STANDARD_MALLOC
     int *ptr = block;
-    int size;
+    ns_mem_word_size_t size;
+    heap_region_t *region;
 
     if (!block) {
         return;
     }
 
-    if (!heap_main) {
+    if (heap_region_cnt == 0) {
         heap_failure(NS_DYN_MEM_HEAP_SECTOR_UNITIALIZED);
         return;
     }
 
     platform_enter_critical();
     ptr --;
+    region = heap_region_find(ptr);
     //Read Current Size
-    size = *ptr;
-    if (size < 0) {
-        heap_failure(NS_DYN_MEM_DOUBLE_FREE);
-    } else if (ptr < heap_main || ptr >= heap_main_end) {
+    size = region ? *ptr : 0;
+    if (!region) {
         heap_failure(NS_DYN_MEM_POINTER_NOT_VALID);
-    } else if ((ptr + size) >= heap_main_end) {
+    } else if (size < 0) {
+        heap_failure(NS_DYN_MEM_DOUBLE_FREE);
+    } else if ((ptr + size) >= region->end) {
         heap_failure(NS_DYN_MEM_POINTER_NOT_VALID);
     } else {
         if (ns_block_validate(ptr, 1) != 0) {
             heap_failure(NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
         } else {
-            ns_free_and_merge_with_adjacent_blocks(ptr, size);
+            ns_free_and_merge_with_adjacent_blocks(region, ptr, size);
             if (mem_stat_info_ptr) {
                 //Update Free Counter
                 dev_stat_update(DEV_HEAP_FREE, (size + 2) * sizeof(int));
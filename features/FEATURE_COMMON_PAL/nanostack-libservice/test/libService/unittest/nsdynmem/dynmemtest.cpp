@@ -413,6 +413,123 @@ TEST(dynmem, not_negative_stats)
     free(heap);
 }
 
+TEST(dynmem, large_heap)
+{
+    ns_mem_heap_size_t size = 200000;
+    mem_stat_t info;
+    uint8_t *heap = (uint8_t*)malloc(size);
+    CHECK(NULL != heap);
+    reset_heap_error();
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+    CHECK(info.heap_sector_size >= (size-4));
+    CHECK(!heap_have_failed());
+
+    void *p = ns_dyn_mem_alloc(100000);
+    CHECK(p);
+    void *q = ns_dyn_mem_temporary_alloc(90000);
+    CHECK(q);
+    CHECK(!heap_have_failed());
+    CHECK(info.heap_sector_allocated_bytes >= 190000);
+    ns_dyn_mem_free(p);
+    ns_dyn_mem_free(q);
+    CHECK(!heap_have_failed());
+    CHECK(info.heap_sector_allocated_bytes == 0);
+    free(heap);
+}
+
+TEST(dynmem, regions)
+{
+    uint16_t size = 1000;
+    mem_stat_t info;
+    uint8_t *heap = (uint8_t*)malloc(size);
+    uint8_t *heap2 = (uint8_t*)malloc(size);
+    void *p[4];
+    CHECK(NULL != heap);
+    CHECK(NULL != heap2);
+    reset_heap_error();
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+    CHECK(ns_dyn_mem_region_add(heap2, size) == 0);
+    CHECK(!heap_have_failed());
+    CHECK(info.heap_sector_size >= 2*(size-4));
+
+    // neither region alone can hold all four
+    for (int i=0; i<4; i++) {
+        p[i] = ns_dyn_mem_alloc(400);
+        CHECK(p[i]);
+    }
+    CHECK(NULL == ns_dyn_mem_alloc(400));
+
+    // blocks in different regions are never merged
+    for (int i=0; i<4; i++) {
+        ns_dyn_mem_free(p[i]);
+    }
+    CHECK(!heap_have_failed());
+    CHECK(info.heap_sector_alloc_cnt == 0);
+    CHECK(info.heap_hole_cnt == 2);
+    CHECK(NULL == ns_dyn_mem_alloc(size));
+
+    // pointers from the added region are validated too
+    reset_heap_error();
+    ns_dyn_mem_free(&heap2[-1]);
+    CHECK(heap_have_failed());
+    CHECK(NS_DYN_MEM_POINTER_NOT_VALID == current_heap_error);
+
+    // all region slots are in use
+    uint8_t buf[100];
+    CHECK(ns_dyn_mem_region_add(buf, sizeof(buf)) == -1);
+    free(heap);
+    free(heap2);
+}
+
+TEST(dynmem, hole_stats)
+{
+    uint16_t size = 1000;
+    mem_stat_t info;
+    uint8_t *heap = (uint8_t*)malloc(size);
+    void *p[8];
+    CHECK(NULL != heap);
+    reset_heap_error();
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+    CHECK(info.heap_hole_cnt == 1);
+    CHECK(info.heap_longest_hole == info.heap_hole_bytes);
+    CHECK(info.heap_fragmentation == 0);
+    ns_mem_heap_size_t longest = info.heap_longest_hole;
+
+    for (int i=0; i<8; i++) {
+        p[i] = ns_dyn_mem_temporary_alloc(100);
+    }
+    // free every other block, leaving holes that can not merge
+    for (int i=0; i<8; i+=2) {
+        ns_dyn_mem_free(p[i]);
+    }
+    CHECK(info.heap_hole_cnt == 5);
+    CHECK(ns_dyn_mem_get_mem_stat() == &info);
+    CHECK(info.heap_longest_hole < info.heap_hole_bytes);
+    CHECK(info.heap_fragmentation > 0);
+    CHECK(info.heap_longest_hole_min <= info.heap_longest_hole);
+
+    // a hole of the exact size is reused, leaving the longest hole alone
+    ns_mem_heap_size_t before = info.heap_longest_hole;
+    p[0] = ns_dyn_mem_temporary_alloc(100);
+    CHECK(info.heap_hole_cnt == 4);
+    ns_dyn_mem_get_mem_stat();
+    CHECK(info.heap_longest_hole == before);
+
+    ns_dyn_mem_free(p[0]);
+    for (int i=1; i<8; i+=2) {
+        ns_dyn_mem_free(p[i]);
+    }
+    CHECK(!heap_have_failed());
+    CHECK(info.heap_hole_cnt == 1);
+    // the longest hole is only refreshed on request
+    CHECK(info.heap_longest_hole == before);
+    ns_dyn_mem_get_mem_stat();
+    CHECK(info.heap_longest_hole == longest);
+    CHECK(info.heap_fragmentation == 0);
+    CHECK(info.heap_longest_hole_min < longest);
+    free(heap);
+}
+
 TEST(dynmem, test_invalid_pointer_freed) {
     uint16_t size = 28;
     uint8_t *heap = (uint8_t*)malloc(size);
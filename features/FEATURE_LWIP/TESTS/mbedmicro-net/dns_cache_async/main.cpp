@@ -0,0 +1,80 @@
+#if !FEATURE_LWIP
+    #error [NOT_SUPPORTED] LWIP not supported for this target
+#endif
+
+#include "mbed.h"
+#include "EthernetInterface.h"
+#include "nsapi_dns.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+
+#ifndef MBED_CFG_DNS_CACHE_ASYNC_HOST
+#define MBED_CFG_DNS_CACHE_ASYNC_HOST "pool.ntp.org"
+#endif
+
+namespace {
+    volatile bool async_done = false;
+    int async_result = 0;
+    SocketAddress async_address;
+}
+
+void async_callback(int result, SocketAddress *address) {
+    async_result = result;
+    if (address) {
+        async_address = *address;
+    }
+    async_done = true;
+}
+
+int main() {
+    GREENTEA_SETUP(60, "default_auto");
+
+    EthernetInterface eth;
+    eth.connect();
+    printf("MBED: Client IP Address is %s\n", eth.get_ip_address());
+
+    nsapi_dns_cache_flush();
+    nsapi_dns_reset_stats();
+
+    // The first lookup goes to a server, the second is served from the cache
+    SocketAddress first;
+    Timer timer;
+    timer.start();
+    TEST_ASSERT_EQUAL(0, nsapi_dns_query(&eth, MBED_CFG_DNS_CACHE_ASYNC_HOST, &first));
+    int first_us = timer.read_us();
+
+    SocketAddress second;
+    timer.reset();
+    TEST_ASSERT_EQUAL(0, nsapi_dns_query(&eth, MBED_CFG_DNS_CACHE_ASYNC_HOST, &second));
+    int second_us = timer.read_us();
+
+    printf("MBED: %s is %s, resolved in %d us, cached in %d us\r\n",
+            MBED_CFG_DNS_CACHE_ASYNC_HOST, first.get_ip_address(), first_us, second_us);
+    TEST_ASSERT(first == second);
+
+    // Asynchronous lookup of the cached host completes from the queue
+    EventQueue queue;
+    int id = nsapi_dns_query_async(&eth, MBED_CFG_DNS_CACHE_ASYNC_HOST,
+            async_callback, &queue);
+    TEST_ASSERT(id > 0);
+    TEST_ASSERT(!async_done);
+
+    timer.reset();
+    while (!async_done && timer.read_ms() < 15000) {
+        queue.dispatch(100);
+    }
+    TEST_ASSERT(async_done);
+    TEST_ASSERT_EQUAL(0, async_result);
+    TEST_ASSERT(async_address == first);
+
+    nsapi_dns_stats_t stats;
+    nsapi_dns_get_stats(&stats);
+    printf("MBED: %u queries, %u cache hits, %u resolved in %u ms max\r\n",
+            stats.queries, stats.cache_hits, stats.resolved, stats.latency_max);
+    TEST_ASSERT_EQUAL(3, stats.queries);
+    TEST_ASSERT_EQUAL(2, stats.cache_hits);
+    TEST_ASSERT_EQUAL(1, stats.resolved);
+
+    eth.disconnect();
+    GREENTEA_TESTSUITE_RESULT(true);
+}
@@ -0,0 +1,150 @@
+#if !FEATURE_LWIP
+    #error [NOT_SUPPORTED] LWIP not supported for this target
+#endif
+
+#include "mbed.h"
+#include "EthernetInterface.h"
+#include "TCPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+
+
+#ifndef MBED_CFG_TCP_CLIENT_NOCOPY_BUFFER_SIZE
+#define MBED_CFG_TCP_CLIENT_NOCOPY_BUFFER_SIZE 1460
+#endif
+
+#ifndef MBED_CFG_TCP_CLIENT_NOCOPY_TOTAL_SIZE
+#define MBED_CFG_TCP_CLIENT_NOCOPY_TOTAL_SIZE (64*1024)
+#endif
+
+namespace {
+    char tx_buffer[MBED_CFG_TCP_CLIENT_NOCOPY_BUFFER_SIZE] = {0};
+    char rx_buffer[MBED_CFG_TCP_CLIENT_NOCOPY_BUFFER_SIZE] = {0};
+    volatile unsigned released = 0;
+}
+
+void prep_buffer(char *tx_buffer, size_t tx_size) {
+    for (size_t i=0; i<tx_size; ++i) {
+        tx_buffer[i] = (rand() % 10) + '0';
+    }
+}
+
+void release_buffer(void *context) {
+    // tx_buffer is static, so there is nothing to free
+    released += 1;
+}
+
+// Streams MBED_CFG_TCP_CLIENT_NOCOPY_TOTAL_SIZE bytes of tx_buffer through
+// the echo server and checks the echo. Returns the time taken in
+// milliseconds, which includes the host echoing, so only the relative
+// figures of the two send paths are meaningful.
+int stream(TCPSocket &sock, bool nocopy, unsigned *sends) {
+    size_t sent = 0;
+    size_t received = 0;
+    *sends = 0;
+
+    sock.set_blocking(false);
+
+    Timer timer;
+    timer.start();
+
+    while (received < MBED_CFG_TCP_CLIENT_NOCOPY_TOTAL_SIZE) {
+        bool idle = true;
+
+        if (sent < MBED_CFG_TCP_CLIENT_NOCOPY_TOTAL_SIZE) {
+            size_t offset = sent % sizeof(tx_buffer);
+            size_t size = sizeof(tx_buffer) - offset;
+            if (size > MBED_CFG_TCP_CLIENT_NOCOPY_TOTAL_SIZE - sent) {
+                size = MBED_CFG_TCP_CLIENT_NOCOPY_TOTAL_SIZE - sent;
+            }
+
+            int ret = nocopy
+                    ? sock.send_nocopy(tx_buffer + offset, size, release_buffer, NULL)
+                    : sock.send(tx_buffer + offset, size);
+            if (ret > 0) {
+                sent += ret;
+                *sends += 1;
+                idle = false;
+            } else if (ret != NSAPI_ERROR_WOULD_BLOCK) {
+                printf("MBED: send failed: %d\r\n", ret);
+                return -1;
+            }
+        }
+
+        int ret = sock.recv(rx_buffer, sizeof(rx_buffer));
+        if (ret > 0) {
+            for (int i = 0; i < ret; i++) {
+                if (rx_buffer[i] != tx_buffer[(received + i) % sizeof(tx_buffer)]) {
+                    printf("MBED: echo mismatch at %u\r\n", received + i);
+                    return -1;
+                }
+            }
+            received += ret;
+            idle = false;
+        } else if (ret != NSAPI_ERROR_WOULD_BLOCK) {
+            printf("MBED: recv failed: %d\r\n", ret);
+            return -1;
+        }
+
+        if (idle) {
+            Thread::wait(1);
+        }
+    }
+
+    return timer.read_ms();
+}
+
+int main() {
+    GREENTEA_SETUP(60, "tcp_echo_client");
+
+    EthernetInterface eth;
+    eth.connect();
+
+    printf("MBED: TCPClient IP address is '%s'\n", eth.get_ip_address());
+    printf("MBED: TCPClient waiting for server IP and port...\n");
+
+    greentea_send_kv("target_ip", eth.get_ip_address());
+
+    char recv_key[] = "host_port";
+    char ipbuf[60] = {0};
+    char portbuf[16] = {0};
+    unsigned int port = 0;
+
+    greentea_send_kv("host_ip", " ");
+    greentea_parse_kv(recv_key, ipbuf, sizeof(recv_key), sizeof(ipbuf));
+
+    greentea_send_kv("host_port", " ");
+    greentea_parse_kv(recv_key, portbuf, sizeof(recv_key), sizeof(ipbuf));
+    sscanf(portbuf, "%u", &port);
+
+    printf("MBED: Server IP address received: %s:%d \n", ipbuf, port);
+
+    SocketAddress tcp_addr(ipbuf, port);
+    prep_buffer(tx_buffer, sizeof(tx_buffer));
+
+    // Copying send path
+    TCPSocket copy_sock(&eth);
+    TEST_ASSERT_EQUAL(0, copy_sock.connect(tcp_addr));
+    unsigned copy_sends;
+    int copy_ms = stream(copy_sock, false, &copy_sends);
+    copy_sock.close();
+    TEST_ASSERT(copy_ms >= 0);
+
+    // Zero-copy send path, which must release every queued buffer by the
+    // time the socket is closed
+    TCPSocket nocopy_sock(&eth);
+    TEST_ASSERT_EQUAL(0, nocopy_sock.connect(tcp_addr));
+    unsigned nocopy_sends;
+    int nocopy_ms = stream(nocopy_sock, true, &nocopy_sends);
+    nocopy_sock.close();
+    TEST_ASSERT(nocopy_ms >= 0);
+    TEST_ASSERT_EQUAL(nocopy_sends, released);
+
+    printf("MBED: send:        %d bytes in %d ms (%d sends)\r\n",
+            MBED_CFG_TCP_CLIENT_NOCOPY_TOTAL_SIZE, copy_ms, copy_sends);
+    printf("MBED: send_nocopy: %d bytes in %d ms (%d sends)\r\n",
+            MBED_CFG_TCP_CLIENT_NOCOPY_TOTAL_SIZE, nocopy_ms, nocopy_sends);
+
+    eth.disconnect();
+    GREENTEA_TESTSUITE_RESULT(true);
+}
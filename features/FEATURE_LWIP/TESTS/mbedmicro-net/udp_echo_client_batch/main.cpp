@@ -0,0 +1,139 @@
+#if !FEATURE_LWIP
+    #error [NOT_SUPPORTED] LWIP not supported for this target
+#endif
+
+#include "mbed.h"
+#include "EthernetInterface.h"
+#include "UDPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+
+#ifndef MBED_CFG_UDP_CLIENT_BATCH_BUFFER_SIZE
+#define MBED_CFG_UDP_CLIENT_BATCH_BUFFER_SIZE 32
+#endif
+
+#ifndef MBED_CFG_UDP_CLIENT_BATCH_SIZE
+#define MBED_CFG_UDP_CLIENT_BATCH_SIZE 8
+#endif
+
+#ifndef MBED_CFG_UDP_CLIENT_BATCH_PACKETS
+#define MBED_CFG_UDP_CLIENT_BATCH_PACKETS 512
+#endif
+
+namespace {
+    char tx_buffer[MBED_CFG_UDP_CLIENT_BATCH_SIZE][MBED_CFG_UDP_CLIENT_BATCH_BUFFER_SIZE] = {{0}};
+    char rx_buffer[MBED_CFG_UDP_CLIENT_BATCH_SIZE][MBED_CFG_UDP_CLIENT_BATCH_BUFFER_SIZE] = {{0}};
+    nsapi_send_datagram_t tx_datagrams[MBED_CFG_UDP_CLIENT_BATCH_SIZE];
+    nsapi_datagram_t rx_datagrams[MBED_CFG_UDP_CLIENT_BATCH_SIZE];
+}
+
+void prep_buffer(char *tx_buffer, size_t tx_size) {
+    for (size_t i=0; i<tx_size; ++i) {
+        tx_buffer[i] = (rand() % 10) + '0';
+    }
+}
+
+// Sends MBED_CFG_UDP_CLIENT_BATCH_PACKETS datagrams in rounds of
+// MBED_CFG_UDP_CLIENT_BATCH_SIZE and receives what is echoed back. Returns
+// the rate in packets per second, counting both directions. Datagrams may
+// be lost, so only the send rate and a lower bound on echoes are checked.
+int packets_per_second(UDPSocket &sock, SocketAddress &addr, bool batch, int *echoed) {
+    int sent = 0;
+    *echoed = 0;
+
+    Timer timer;
+    timer.start();
+
+    while (sent < MBED_CFG_UDP_CLIENT_BATCH_PACKETS) {
+        if (batch) {
+            int ret = sock.sendto_batch(tx_datagrams, MBED_CFG_UDP_CLIENT_BATCH_SIZE);
+            TEST_ASSERT(ret > 0);
+            sent += ret;
+        } else {
+            for (int i=0; i < MBED_CFG_UDP_CLIENT_BATCH_SIZE; ++i) {
+                TEST_ASSERT_EQUAL(sizeof(tx_buffer[i]), sock.sendto(addr, tx_buffer[i], sizeof(tx_buffer[i])));
+                sent += 1;
+            }
+        }
+
+        // Drain the echoes of this round
+        sock.set_timeout(100);
+        while (true) {
+            int ret;
+            if (batch) {
+                ret = sock.recvfrom_batch(rx_datagrams, MBED_CFG_UDP_CLIENT_BATCH_SIZE);
+            } else {
+                ret = sock.recvfrom(NULL, rx_buffer[0], sizeof(rx_buffer[0]));
+                ret = (ret > 0) ? 1 : ret;
+            }
+
+            if (ret <= 0) {
+                break;
+            }
+            *echoed += ret;
+            sock.set_timeout(0);
+        }
+    }
+
+    int elapsed = timer.read_ms();
+    return (int)((sent + *echoed) * 1000LL / (elapsed ? elapsed : 1));
+}
+
+int main() {
+    GREENTEA_SETUP(60, "udp_echo_client");
+
+    EthernetInterface eth;
+    eth.connect();
+    printf("UDP client IP Address is %s\n", eth.get_ip_address());
+
+    greentea_send_kv("target_ip", eth.get_ip_address());
+
+    char recv_key[] = "host_port";
+    char ipbuf[60] = {0};
+    char portbuf[16] = {0};
+    unsigned int port = 0;
+
+    UDPSocket sock;
+    sock.open(&eth);
+
+    greentea_send_kv("host_ip", " ");
+    greentea_parse_kv(recv_key, ipbuf, sizeof(recv_key), sizeof(ipbuf));
+
+    greentea_send_kv("host_port", " ");
+    greentea_parse_kv(recv_key, portbuf, sizeof(recv_key), sizeof(ipbuf));
+    sscanf(portbuf, "%u", &port);
+
+    printf("MBED: UDP Server IP address received: %s:%d \n", ipbuf, port);
+
+    SocketAddress addr(ipbuf, port);
+
+    for (int i=0; i < MBED_CFG_UDP_CLIENT_BATCH_SIZE; ++i) {
+        prep_buffer(tx_buffer[i], sizeof(tx_buffer[i]));
+        tx_datagrams[i].addr = addr.get_addr();
+        tx_datagrams[i].port = addr.get_port();
+        tx_datagrams[i].data = tx_buffer[i];
+        tx_datagrams[i].size = sizeof(tx_buffer[i]);
+        rx_datagrams[i].data = rx_buffer[i];
+        rx_datagrams[i].size = sizeof(rx_buffer[i]);
+    }
+
+    int single_echoed;
+    int single_pps = packets_per_second(sock, addr, false, &single_echoed);
+    int batch_echoed;
+    int batch_pps = packets_per_second(sock, addr, true, &batch_echoed);
+
+    printf("MBED: sendto/recvfrom:             %d packets/s (%d echoed)\r\n",
+            single_pps, single_echoed);
+    printf("MBED: sendto_batch/recvfrom_batch: %d packets/s (%d echoed)\r\n",
+            batch_pps, batch_echoed);
+
+    TEST_ASSERT(batch_echoed > 0);
+    for (int i=0; i < MBED_CFG_UDP_CLIENT_BATCH_SIZE; ++i) {
+        TEST_ASSERT_EQUAL(sizeof(tx_buffer[i]), tx_datagrams[i].length);
+    }
+    TEST_ASSERT(SocketAddress(rx_datagrams[0].addr, rx_datagrams[0].port) == addr);
+
+    sock.close();
+    eth.disconnect();
+    GREENTEA_TESTSUITE_RESULT(true);
+}
@@ -0,0 +1,121 @@
+#if !FEATURE_LWIP
+    #error [NOT_SUPPORTED] LWIP not supported for this target
+#endif
+
+#include "mbed.h"
+#include "EthernetInterface.h"
+#include "UDPSocket.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+
+#ifndef MBED_CFG_UDP_CLIENT_SCALING_BUFFER_SIZE
+#define MBED_CFG_UDP_CLIENT_SCALING_BUFFER_SIZE 64
+#endif
+
+#ifndef MBED_CFG_UDP_CLIENT_SCALING_MAX_SOCKETS
+#define MBED_CFG_UDP_CLIENT_SCALING_MAX_SOCKETS 16
+#endif
+
+namespace {
+    char tx_buffer[MBED_CFG_UDP_CLIENT_SCALING_BUFFER_SIZE] = {0};
+    char rx_buffer[MBED_CFG_UDP_CLIENT_SCALING_BUFFER_SIZE] = {0};
+    const int ECHO_LOOPS = 32;
+    const int BURST_SIZE = 4;
+    volatile int callbacks = 0;
+}
+
+void prep_buffer(char *tx_buffer, size_t tx_size) {
+    for (size_t i=0; i<tx_size; ++i) {
+        tx_buffer[i] = (rand() % 10) + '0';
+    }
+}
+
+void count_callback() {
+    callbacks += 1;
+}
+
+// Average echo round trip in microseconds, which includes dispatching the
+// stack's receive event to the socket
+int echo_round_trip(UDPSocket &sock, SocketAddress &addr) {
+    Timer timer;
+    timer.start();
+
+    for (int i=0; i < ECHO_LOOPS; ++i) {
+        prep_buffer(tx_buffer, sizeof(tx_buffer));
+        TEST_ASSERT_EQUAL(sizeof(tx_buffer), sock.sendto(addr, tx_buffer, sizeof(tx_buffer)));
+        TEST_ASSERT_EQUAL(sizeof(rx_buffer), sock.recvfrom(NULL, rx_buffer, sizeof(rx_buffer)));
+        TEST_ASSERT_EQUAL(0, memcmp(rx_buffer, tx_buffer, sizeof(rx_buffer)));
+    }
+
+    return timer.read_us() / ECHO_LOOPS;
+}
+
+int main() {
+    GREENTEA_SETUP(60, "udp_echo_client");
+
+    EthernetInterface eth;
+    eth.connect();
+    printf("UDP client IP Address is %s\n", eth.get_ip_address());
+
+    greentea_send_kv("target_ip", eth.get_ip_address());
+
+    char recv_key[] = "host_port";
+    char ipbuf[60] = {0};
+    char portbuf[16] = {0};
+    unsigned int port = 0;
+
+    UDPSocket sock;
+    sock.open(&eth);
+
+    greentea_send_kv("host_ip", " ");
+    greentea_parse_kv(recv_key, ipbuf, sizeof(recv_key), sizeof(ipbuf));
+
+    greentea_send_kv("host_port", " ");
+    greentea_parse_kv(recv_key, portbuf, sizeof(recv_key), sizeof(ipbuf));
+    sscanf(portbuf, "%u", &port);
+
+    printf("MBED: UDP Server IP address received: %s:%d \n", ipbuf, port);
+
+    SocketAddress addr(ipbuf, port);
+
+    // Echo round trip as idle sockets are added, until the stack runs out
+    UDPSocket idle[MBED_CFG_UDP_CLIENT_SCALING_MAX_SOCKETS];
+    int sockets = 1;
+    while (true) {
+        printf("MBED: %2d sockets: %d us per echo\r\n", sockets, echo_round_trip(sock, addr));
+
+        if (sockets > MBED_CFG_UDP_CLIENT_SCALING_MAX_SOCKETS
+                || idle[sockets-1].open(&eth) != 0) {
+            break;
+        }
+        sockets += 1;
+    }
+
+    // A burst of datagrams received before the application reads any of
+    // them is signalled once
+    sock.set_blocking(false);
+    sock.attach(count_callback);
+    callbacks = 0;
+
+    for (int i=0; i < BURST_SIZE; ++i) {
+        TEST_ASSERT_EQUAL(sizeof(tx_buffer), sock.sendto(addr, tx_buffer, sizeof(tx_buffer)));
+    }
+    wait_ms(500);
+    int burst_callbacks = callbacks;
+
+    int received = 0;
+    while (sock.recvfrom(NULL, rx_buffer, sizeof(rx_buffer)) > 0) {
+        received += 1;
+    }
+
+    printf("MBED: %d datagrams received, %d callbacks\r\n", received, burst_callbacks);
+    TEST_ASSERT(received > 0);
+    TEST_ASSERT_EQUAL(1, burst_callbacks);
+
+    for (int i=0; i < sockets-1; ++i) {
+        idle[i].close();
+    }
+    sock.close();
+    eth.disconnect();
+    GREENTEA_TESTSUITE_RESULT(true);
+}
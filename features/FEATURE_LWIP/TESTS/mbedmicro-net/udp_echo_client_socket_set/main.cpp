@@ -0,0 +1,110 @@
+#if !FEATURE_LWIP
+    #error [NOT_SUPPORTED] LWIP not supported for this target
+#endif
+
+#include "mbed.h"
+#include "EthernetInterface.h"
+#include "UDPSocket.h"
+#include "SocketSet.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+
+#ifndef MBED_CFG_UDP_CLIENT_SOCKET_SET_BUFFER_SIZE
+#define MBED_CFG_UDP_CLIENT_SOCKET_SET_BUFFER_SIZE 64
+#endif
+
+#ifndef MBED_CFG_UDP_CLIENT_SOCKET_SET_SOCKETS
+#define MBED_CFG_UDP_CLIENT_SOCKET_SET_SOCKETS 4
+#endif
+
+namespace {
+    char tx_buffer[MBED_CFG_UDP_CLIENT_SOCKET_SET_SOCKETS][MBED_CFG_UDP_CLIENT_SOCKET_SET_BUFFER_SIZE] = {{0}};
+    char rx_buffer[MBED_CFG_UDP_CLIENT_SOCKET_SET_BUFFER_SIZE] = {0};
+    const int ECHO_LOOPS = 16;
+    const int WAIT_TIMEOUT = 5000;
+}
+
+void prep_buffer(char *tx_buffer, size_t tx_size) {
+    for (size_t i=0; i<tx_size; ++i) {
+        tx_buffer[i] = (rand() % 10) + '0';
+    }
+}
+
+int main() {
+    GREENTEA_SETUP(60, "udp_echo_client");
+
+    EthernetInterface eth;
+    eth.connect();
+    printf("UDP client IP Address is %s\n", eth.get_ip_address());
+
+    greentea_send_kv("target_ip", eth.get_ip_address());
+
+    char recv_key[] = "host_port";
+    char ipbuf[60] = {0};
+    char portbuf[16] = {0};
+    unsigned int port = 0;
+
+    greentea_send_kv("host_ip", " ");
+    greentea_parse_kv(recv_key, ipbuf, sizeof(recv_key), sizeof(ipbuf));
+
+    greentea_send_kv("host_port", " ");
+    greentea_parse_kv(recv_key, portbuf, sizeof(recv_key), sizeof(ipbuf));
+    sscanf(portbuf, "%u", &port);
+
+    printf("MBED: UDP Server IP address received: %s:%d \n", ipbuf, port);
+
+    SocketAddress addr(ipbuf, port);
+
+    // All sockets are serviced from this thread through one set
+    UDPSocket socks[MBED_CFG_UDP_CLIENT_SOCKET_SET_SOCKETS];
+    SocketSet set;
+    for (int i=0; i < MBED_CFG_UDP_CLIENT_SOCKET_SET_SOCKETS; ++i) {
+        TEST_ASSERT_EQUAL(0, socks[i].open(&eth));
+        socks[i].set_blocking(false);
+        TEST_ASSERT_EQUAL(0, set.add(&socks[i], SocketSet::READABLE));
+    }
+
+    Timer timer;
+    timer.start();
+
+    for (int loop=0; loop < ECHO_LOOPS; ++loop) {
+        for (int i=0; i < MBED_CFG_UDP_CLIENT_SOCKET_SET_SOCKETS; ++i) {
+            prep_buffer(tx_buffer[i], sizeof(tx_buffer[i]));
+            TEST_ASSERT_EQUAL(sizeof(tx_buffer[i]), socks[i].sendto(addr, tx_buffer[i], sizeof(tx_buffer[i])));
+        }
+
+        int echoed = 0;
+        while (echoed < MBED_CFG_UDP_CLIENT_SOCKET_SET_SOCKETS) {
+            int ready = set.wait(WAIT_TIMEOUT);
+            TEST_ASSERT(ready > 0);
+
+            for (int r=0; r < ready; ++r) {
+                int events;
+                UDPSocket *sock = static_cast<UDPSocket *>(set.get_ready(r, &events));
+                TEST_ASSERT(sock != NULL);
+                TEST_ASSERT_EQUAL(SocketSet::READABLE, events);
+
+                int ret;
+                while ((ret = sock->recvfrom(NULL, rx_buffer, sizeof(rx_buffer))) > 0) {
+                    int i = sock - socks;
+                    TEST_ASSERT_EQUAL(sizeof(rx_buffer), ret);
+                    TEST_ASSERT_EQUAL(0, memcmp(rx_buffer, tx_buffer[i], sizeof(rx_buffer)));
+                    echoed += 1;
+                }
+                TEST_ASSERT_EQUAL(NSAPI_ERROR_WOULD_BLOCK, ret);
+            }
+        }
+    }
+
+    printf("MBED: %d sockets: %d us per round of echoes\r\n",
+            MBED_CFG_UDP_CLIENT_SOCKET_SET_SOCKETS, timer.read_us() / ECHO_LOOPS);
+
+    // Nothing is left to read, so the set only times out
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_WOULD_BLOCK, set.wait(100));
+
+    for (int i=0; i < MBED_CFG_UDP_CLIENT_SOCKET_SET_SOCKETS; ++i) {
+        socks[i].close();
+    }
+    eth.disconnect();
+    GREENTEA_TESTSUITE_RESULT(true);
+}
@@ -46,6 +46,7 @@
 /* Static arena of sockets */
 static struct lwip_socket {
     bool in_use;
+    struct lwip_socket *next_free;
 
     struct netconn *conn;
     struct netbuf *buf;
@@ -53,51 +54,192 @@ static struct lwip_socket {
 
     void (*cb)(void *);
     void *data;
+    volatile bool recv_signalled;
+    volatile u16_t recv_queued;
+
+    /* Zero-copy sends still referenced by the pcb, oldest first */
+    struct lwip_nocopy {
+        u32_t seq_end;
+        void (*release)(void *);
+        void *context;
+    } nocopy[MBED_CONF_LWIP_TCP_NOCOPY_BUFFERS];
+    u8_t nocopy_head;
+    volatile u8_t nocopy_count;
 } lwip_arena[MEMP_NUM_NETCONN];
 
+static struct lwip_socket *lwip_arena_free;
+
+/* Open-addressed map from netconns to the sockets in the arena, so that
+ * netconn events find their socket without scanning the arena. Kept at most
+ * half full so that probe sequences stay short. */
+#define LWIP_SOCKET_MAP_SIZE (2*MEMP_NUM_NETCONN)
+static struct lwip_socket *lwip_socket_map[LWIP_SOCKET_MAP_SIZE];
+
 static bool lwip_connected = false;
 
+static unsigned mbed_lwip_socket_map_hash(const struct netconn *nc)
+{
+    return ((u32_t)(uintptr_t)nc * 2654435761U) % LWIP_SOCKET_MAP_SIZE;
+}
+
+static struct lwip_socket *mbed_lwip_socket_map_find(const struct netconn *nc)
+{
+    for (unsigned i = mbed_lwip_socket_map_hash(nc); lwip_socket_map[i];
+            i = (i + 1) % LWIP_SOCKET_MAP_SIZE) {
+        if (lwip_socket_map[i]->conn == nc) {
+            return lwip_socket_map[i];
+        }
+    }
+
+    return 0;
+}
+
+static void mbed_lwip_socket_map_add(struct lwip_socket *s)
+{
+    sys_prot_t prot = sys_arch_protect();
+
+    unsigned i = mbed_lwip_socket_map_hash(s->conn);
+    while (lwip_socket_map[i]) {
+        i = (i + 1) % LWIP_SOCKET_MAP_SIZE;
+    }
+    lwip_socket_map[i] = s;
+
+    sys_arch_unprotect(prot);
+}
+
+static void mbed_lwip_socket_map_remove(struct lwip_socket *s)
+{
+    unsigned i = mbed_lwip_socket_map_hash(s->conn);
+    while (lwip_socket_map[i] && lwip_socket_map[i] != s) {
+        i = (i + 1) % LWIP_SOCKET_MAP_SIZE;
+    }
+
+    if (!lwip_socket_map[i]) {
+        return;
+    }
+
+    // Close the gap by moving back later entries of the probe sequence
+    // that can no longer be reached from their hash
+    lwip_socket_map[i] = 0;
+    for (unsigned j = (i + 1) % LWIP_SOCKET_MAP_SIZE; lwip_socket_map[j];
+            j = (j + 1) % LWIP_SOCKET_MAP_SIZE) {
+        unsigned k = mbed_lwip_socket_map_hash(lwip_socket_map[j]->conn);
+        if ((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j))) {
+            lwip_socket_map[i] = lwip_socket_map[j];
+            lwip_socket_map[j] = 0;
+            i = j;
+        }
+    }
+}
+
 static void mbed_lwip_arena_init(void)
 {
     memset(lwip_arena, 0, sizeof lwip_arena);
+    memset(lwip_socket_map, 0, sizeof lwip_socket_map);
+
+    lwip_arena_free = 0;
+    for (int i = MEMP_NUM_NETCONN-1; i >= 0; i--) {
+        lwip_arena[i].next_free = lwip_arena_free;
+        lwip_arena_free = &lwip_arena[i];
+    }
 }
 
 static struct lwip_socket *mbed_lwip_arena_alloc(void)
 {
     sys_prot_t prot = sys_arch_protect();
 
-    for (int i = 0; i < MEMP_NUM_NETCONN; i++) {
-        if (!lwip_arena[i].in_use) {
-            struct lwip_socket *s = &lwip_arena[i];
-            memset(s, 0, sizeof *s);
-            s->in_use = true;
-            sys_arch_unprotect(prot);
-            return s;
-        }
+    struct lwip_socket *s = lwip_arena_free;
+    if (s) {
+        lwip_arena_free = s->next_free;
+        memset(s, 0, sizeof *s);
+        s->in_use = true;
     }
 
     sys_arch_unprotect(prot);
-    return 0;
+    return s;
 }
 
 static void mbed_lwip_arena_dealloc(struct lwip_socket *s)
 {
+    sys_prot_t prot = sys_arch_protect();
+
+    mbed_lwip_socket_map_remove(s);
     s->in_use = false;
+    s->next_free = lwip_arena_free;
+    lwip_arena_free = s;
+
+    sys_arch_unprotect(prot);
+}
+
+/* Take the zero-copy sends that the remote host has acknowledged, or all of
+ * them once the connection is gone, off the socket and into released.
+ * Returns how many were taken. Must be called with the tcpip core locked and
+ * the arena protected; their buffers are released once it is unprotected. */
+static u8_t mbed_lwip_nocopy_take(struct lwip_socket *s, struct lwip_nocopy *released)
+{
+    const struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    u8_t count = 0;
+
+    while (s->nocopy_count) {
+        struct lwip_nocopy *n = &s->nocopy[s->nocopy_head];
+        if (pcb && (s32_t)(pcb->lastack - n->seq_end) < 0) {
+            break;
+        }
+
+        s->nocopy_head = (s->nocopy_head + 1) % MBED_CONF_LWIP_TCP_NOCOPY_BUFFERS;
+        s->nocopy_count -= 1;
+        released[count++] = *n;
+    }
+
+    return count;
+}
+
+static void mbed_lwip_nocopy_release(const struct lwip_nocopy *released, u8_t count)
+{
+    for (u8_t i = 0; i < count; i++) {
+        released[i].release(released[i].context);
+    }
 }
 
 static void mbed_lwip_socket_callback(struct netconn *nc, enum netconn_evt eh, u16_t len)
 {
+    struct lwip_nocopy released[MBED_CONF_LWIP_TCP_NOCOPY_BUFFERS];
+    u8_t release_count = 0;
     sys_prot_t prot = sys_arch_protect();
 
-    for (int i = 0; i < MEMP_NUM_NETCONN; i++) {
-        if (lwip_arena[i].in_use
-            && lwip_arena[i].conn == nc
-            && lwip_arena[i].cb) {
-            lwip_arena[i].cb(lwip_arena[i].data);
+    struct lwip_socket *s = mbed_lwip_socket_map_find(nc);
+    if (s) {
+        // acknowledgements and errors are signalled from the tcpip thread
+        if (eh == NETCONN_EVT_SENDPLUS || eh == NETCONN_EVT_ERROR) {
+            release_count = mbed_lwip_nocopy_take(s, released);
+        }
+
+        // Track what is waiting in the receive mailbox, which for UDP is
+        // the number of datagrams queued
+        if (eh == NETCONN_EVT_RCVPLUS) {
+            s->recv_queued += 1;
+        } else if (eh == NETCONN_EVT_RCVMINUS) {
+            s->recv_queued -= 1;
+        }
+
+        // A burst of received segments or connections is signalled once,
+        // until the application next tries to receive or accept. Data
+        // being consumed or buffered for sending changes no readiness.
+        bool signal = (s->cb != 0);
+        if (eh == NETCONN_EVT_RCVPLUS) {
+            signal = signal && !s->recv_signalled;
+            s->recv_signalled = s->recv_signalled || signal;
+        } else if (eh == NETCONN_EVT_RCVMINUS || eh == NETCONN_EVT_SENDMINUS) {
+            signal = false;
+        }
+
+        if (signal) {
+            s->cb(s->data);
         }
     }
 
     sys_arch_unprotect(prot);
+    mbed_lwip_nocopy_release(released, release_count);
 }
 
 
@@ -625,17 +767,50 @@ static int mbed_lwip_socket_open(nsapi_stack_t *stack, nsapi_socket_t *handle, n
         return NSAPI_ERROR_NO_SOCKET;
     }
 
+    mbed_lwip_socket_map_add(s);
     netconn_set_recvtimeout(s->conn, 1);
     *(struct lwip_socket **)handle = s;
     return 0;
 }
 
+static void mbed_lwip_nocopy_drain(struct lwip_socket *s)
+{
+    // The pcb outlives the netconn and keeps referencing the buffers of
+    // zero-copy sends until they are acknowledged. Unless configured to give
+    // them a chance to be, the connection is aborted at once to drop the
+    // references, so close does not block.
+    for (u32_t waited = 0; s->nocopy_count
+            && waited < MBED_CONF_LWIP_TCP_NOCOPY_CLOSE_TIMEOUT; waited += 10) {
+        osDelay(10);
+    }
+
+    if (!s->nocopy_count) {
+        return;
+    }
+
+    struct lwip_nocopy released[MBED_CONF_LWIP_TCP_NOCOPY_BUFFERS];
+    LOCK_TCPIP_CORE();
+    if (s->conn->pcb.tcp) {
+        tcp_abort(s->conn->pcb.tcp);
+    }
+
+    sys_prot_t prot = sys_arch_protect();
+    u8_t release_count = mbed_lwip_nocopy_take(s, released);
+    sys_arch_unprotect(prot);
+    UNLOCK_TCPIP_CORE();
+
+    mbed_lwip_nocopy_release(released, release_count);
+}
+
 static int mbed_lwip_socket_close(nsapi_stack_t *stack, nsapi_socket_t handle)
 {
     struct lwip_socket *s = (struct lwip_socket *)handle;
 
-    err_t err = netconn_delete(s->conn);
+    mbed_lwip_nocopy_drain(s);
+
+    struct netconn *conn = s->conn;
     mbed_lwip_arena_dealloc(s);
+    err_t err = netconn_delete(conn);
     return mbed_lwip_err_remap(err);
 }
 
@@ -689,12 +864,14 @@ static int mbed_lwip_socket_accept(nsapi_stack_t *stack, nsapi_socket_t server,
         return NSAPI_ERROR_NO_SOCKET;
     }
 
+    s->recv_signalled = false;
     err_t err = netconn_accept(s->conn, &ns->conn);
     if (err != ERR_OK) {
         mbed_lwip_arena_dealloc(ns);
         return mbed_lwip_err_remap(err);
     }
 
+    mbed_lwip_socket_map_add(ns);
     netconn_set_recvtimeout(ns->conn, 1);
     *(struct lwip_socket **)handle = ns;
 
@@ -717,10 +894,61 @@ static int mbed_lwip_socket_send(nsapi_stack_t *stack, nsapi_socket_t handle, co
     return (int)bytes_written;
 }
 
+static int mbed_lwip_socket_send_nocopy(nsapi_stack_t *stack, nsapi_socket_t handle, const void *data, unsigned size, void (*release)(void *), void *context)
+{
+    struct lwip_socket *s = (struct lwip_socket *)handle;
+    size_t bytes_written = 0;
+
+    if (s->conn->type != NETCONN_TCP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    if (s->nocopy_count == MBED_CONF_LWIP_TCP_NOCOPY_BUFFERS) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+
+    // NETCONN_NOCOPY queues PBUF_ROM pbufs referencing the data, which
+    // stay on the pcb until the remote host acknowledges them
+    err_t err = netconn_write_partly(s->conn, data, size, NETCONN_NOCOPY, &bytes_written);
+    if (err != ERR_OK) {
+        return mbed_lwip_err_remap(err);
+    }
+
+    if (!bytes_written) {
+        return 0;
+    }
+
+    // Track the end of the data in sequence space, releasing it at once if
+    // it has already been acknowledged or the connection has gone
+    struct lwip_nocopy released[MBED_CONF_LWIP_TCP_NOCOPY_BUFFERS];
+    LOCK_TCPIP_CORE();
+    sys_prot_t prot = sys_arch_protect();
+
+    struct lwip_nocopy *n = &s->nocopy[(s->nocopy_head + s->nocopy_count)
+            % MBED_CONF_LWIP_TCP_NOCOPY_BUFFERS];
+    n->seq_end = s->conn->pcb.tcp ? s->conn->pcb.tcp->snd_lbb : 0;
+    n->release = release;
+    n->context = context;
+    s->nocopy_count += 1;
+    u8_t release_count = mbed_lwip_nocopy_take(s, released);
+
+    sys_arch_unprotect(prot);
+    UNLOCK_TCPIP_CORE();
+
+    mbed_lwip_nocopy_release(released, release_count);
+
+    return (int)bytes_written;
+}
+
 static int mbed_lwip_socket_recv(nsapi_stack_t *stack, nsapi_socket_t handle, void *data, unsigned size)
 {
     struct lwip_socket *s = (struct lwip_socket *)handle;
 
+    // Every receive re-arms the readiness signal, including one served from
+    // a partly read netbuf; otherwise data arriving afterwards is never
+    // signalled
+    s->recv_signalled = false;
+
     if (!s->buf) {
         err_t err = netconn_recv(s->conn, &s->buf);
         s->offset = 0;
@@ -741,6 +969,65 @@ static int mbed_lwip_socket_recv(nsapi_stack_t *stack, nsapi_socket_t handle, vo
     return recv;
 }
 
+/* Lend a pbuf chain, from offset, to the application. The reference taken
+ * on the first lent pbuf keeps it and the rest of the chain alive once the
+ * netbuf is gone. Returns the number of bytes described by the buffer. */
+static u16_t mbed_lwip_lend_pbuf(nsapi_recv_buffer_t *buffer, struct pbuf *p, u16_t offset)
+{
+    u16_t size = 0;
+
+    while (p && offset >= p->len) {
+        offset -= p->len;
+        p = p->next;
+    }
+
+    buffer->count = 0;
+    buffer->handle = p;
+    if (!p) {
+        return 0;
+    }
+
+    pbuf_ref(p);
+    for (; p && buffer->count < NSAPI_RECV_BUFFER_SEGMENTS; p = p->next) {
+        buffer->segments[buffer->count].data = (u8_t *)p->payload + offset;
+        buffer->segments[buffer->count].size = p->len - offset;
+        buffer->count += 1;
+        size += p->len - offset;
+        offset = 0;
+    }
+
+    return size;
+}
+
+static int mbed_lwip_socket_recv_buffer(nsapi_stack_t *stack, nsapi_socket_t handle, nsapi_recv_buffer_t *buffer)
+{
+    struct lwip_socket *s = (struct lwip_socket *)handle;
+
+    // Every receive re-arms the readiness signal, including one served from
+    // a partly read netbuf; otherwise data arriving afterwards is never
+    // signalled
+    s->recv_signalled = false;
+
+    if (!s->buf) {
+        err_t err = netconn_recv(s->conn, &s->buf);
+        s->offset = 0;
+
+        if (err != ERR_OK) {
+            return mbed_lwip_err_remap(err);
+        }
+    }
+
+    u16_t recv = mbed_lwip_lend_pbuf(buffer, s->buf->p, s->offset);
+    s->offset += recv;
+
+    if (s->offset >= netbuf_len(s->buf)) {
+        netbuf_delete(s->buf);
+        s->buf = 0;
+    }
+
+    return recv;
+}
+
 static int mbed_lwip_socket_sendto(nsapi_stack_t *stack, nsapi_socket_t handle, nsapi_addr_t addr, uint16_t port, const void *data, unsigned size)
 {
     struct lwip_socket *s = (struct lwip_socket *)handle;
@@ -771,6 +1058,7 @@ static int mbed_lwip_socket_recvfrom(nsapi_stack_t *stack, nsapi_socket_t handle
     struct lwip_socket *s = (struct lwip_socket *)handle;
     struct netbuf *buf;
 
+    s->recv_signalled = false;
     err_t err = netconn_recv(s->conn, &buf);
     if (err != ERR_OK) {
         return mbed_lwip_err_remap(err);
@@ -785,6 +1073,122 @@ static int mbed_lwip_socket_recvfrom(nsapi_stack_t *stack, nsapi_socket_t handle
     return recv;
 }
 
+static int mbed_lwip_socket_recvfrom_buffer(nsapi_stack_t *stack, nsapi_socket_t handle, nsapi_addr_t *addr, uint16_t *port, nsapi_recv_buffer_t *buffer)
+{
+    struct lwip_socket *s = (struct lwip_socket *)handle;
+    struct netbuf *buf;
+
+    s->recv_signalled = false;
+    err_t err = netconn_recv(s->conn, &buf);
+    if (err != ERR_OK) {
+        return mbed_lwip_err_remap(err);
+    }
+
+    convert_lwip_addr_to_mbed(addr, netbuf_fromaddr(buf));
+    *port = netbuf_fromport(buf);
+
+    u16_t recv = mbed_lwip_lend_pbuf(buffer, buf->p, 0);
+    netbuf_delete(buf);
+
+    return recv;
+}
+
+static int mbed_lwip_socket_sendto_batch(nsapi_stack_t *stack, nsapi_socket_t handle, nsapi_send_datagram_t *datagrams, unsigned count)
+{
+    struct lwip_socket *s = (struct lwip_socket *)handle;
+    int ret = 0;
+    unsigned i;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_UDP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    // Hand every datagram to the pcb under a single acquisition of the
+    // core lock, rather than one netconn message per datagram
+    LOCK_TCPIP_CORE();
+
+    for (i = 0; i < count; i++) {
+        ip_addr_t ip_addr;
+        // a pbuf can not describe more than 64k
+        if (datagrams[i].size > 0xffff ||
+                !convert_mbed_addr_to_lwip(&ip_addr, &datagrams[i].addr)) {
+            ret = NSAPI_ERROR_PARAMETER;
+            break;
+        }
+
+        if (!s->conn->pcb.udp) {
+            ret = NSAPI_ERROR_NO_CONNECTION;
+            break;
+        }
+
+        struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, 0, PBUF_REF);
+        if (!p) {
+            ret = NSAPI_ERROR_NO_MEMORY;
+            break;
+        }
+
+        p->payload = (void *)datagrams[i].data;
+        p->len = p->tot_len = (u16_t)datagrams[i].size;
+        err_t err = udp_sendto(s->conn->pcb.udp, p, &ip_addr, datagrams[i].port);
+        pbuf_free(p);
+        if (err != ERR_OK) {
+            ret = mbed_lwip_err_remap(err);
+            break;
+        }
+
+        datagrams[i].length = datagrams[i].size;
+    }
+
+    UNLOCK_TCPIP_CORE();
+
+    if (i == 0 && ret < 0) {
+        return ret;
+    }
+
+    return i;
+}
+
+static int mbed_lwip_socket_recvfrom_batch(nsapi_stack_t *stack, nsapi_socket_t handle, nsapi_datagram_t *datagrams, unsigned count)
+{
+    struct lwip_socket *s = (struct lwip_socket *)handle;
+    unsigned i;
+
+    for (i = 0; i < count; i++) {
+        // Past the first datagram only take what is already queued, so the
+        // batch never waits out the receive timeout
+        if (i > 0 && !s->recv_queued) {
+            break;
+        }
+
+        struct netbuf *buf;
+        s->recv_signalled = false;
+        err_t err = netconn_recv(s->conn, &buf);
+        if (err != ERR_OK) {
+            if (i == 0) {
+                return mbed_lwip_err_remap(err);
+            }
+            break;
+        }
+
+        convert_lwip_addr_to_mbed(&datagrams[i].addr, netbuf_fromaddr(buf));
+        datagrams[i].port = netbuf_fromport(buf);
+        datagrams[i].length = netbuf_copy(buf, datagrams[i].data, (u16_t)datagrams[i].size);
+        netbuf_delete(buf);
+    }
+
+    return i;
+}
+
+static void mbed_lwip_socket_release_buffer(nsapi_stack_t *stack, nsapi_socket_t handle, nsapi_recv_buffer_t *buffer)
+{
+    if (buffer->handle) {
+        pbuf_free((struct pbuf *)buffer->handle);
+        buffer->handle = 0;
+    }
+
+    buffer->count = 0;
+}
+
 static int mbed_lwip_setsockopt(nsapi_stack_t *stack, nsapi_socket_t handle, int level, int optname, const void *optval, unsigned optlen)
 {
     struct lwip_socket *s = (struct lwip_socket *)handle;
@@ -837,6 +1241,7 @@ static void mbed_lwip_socket_attach(nsapi_stack_t *stack, nsapi_socket_t handle,
 
     s->cb = callback;
     s->data = data;
+    s->recv_signalled = false;
 }
 
 /* LWIP network stack */
@@ -854,6 +1259,12 @@ const nsapi_stack_api_t lwip_stack_api = {
     .socket_recvfrom    = mbed_lwip_socket_recvfrom,
     .setsockopt         = mbed_lwip_setsockopt,
     .socket_attach      = mbed_lwip_socket_attach,
+    .socket_send_nocopy = mbed_lwip_socket_send_nocopy,
+    .socket_recv_buffer = mbed_lwip_socket_recv_buffer,
+    .socket_recvfrom_buffer = mbed_lwip_socket_recvfrom_buffer,
+    .socket_release_buffer = mbed_lwip_socket_release_buffer,
+    .socket_sendto_batch = mbed_lwip_socket_sendto_batch,
+    .socket_recvfrom_batch = mbed_lwip_socket_recvfrom_batch,
 };
 
 nsapi_stack_t lwip_stack = {
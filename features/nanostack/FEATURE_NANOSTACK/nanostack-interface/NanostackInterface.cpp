@@ -59,6 +59,7 @@ public:
     NanostackBuffer *next;      /*<! next buffer */
     ns_address_t ns_address;    /*<! address where data is received */
     uint16_t length;            /*<! data length in this buffer */
+    uint16_t offset;            /*<! start of unread data in this buffer */
     uint8_t payload[1];          /*<! Trailing buffer data */
 };
 
@@ -94,6 +95,8 @@ public:
 
     bool data_available(void);
     size_t data_copy_and_free(void *dest, size_t len, SocketAddress *address, bool stream);
+    size_t data_lend(nsapi_recv_buffer_t *buffer, SocketAddress *address, bool stream);
+    static void data_release(nsapi_recv_buffer_t *buffer);
     void data_free_all(void);
     void data_attach(NanostackBuffer *data_buf);
 
@@ -345,14 +348,13 @@ size_t NanostackSocket::data_copy_and_free(void *dest, size_t len,
         convert_ns_addr_to_mbed(address, &data_buf->ns_address);
     }
 
-    size_t copy_size = (len > data_buf->length) ? data_buf->length : len;
-    memcpy(dest, data_buf->payload, copy_size);
+    size_t data_size = data_buf->length - data_buf->offset;
+    size_t copy_size = (len > data_size) ? data_size : len;
+    memcpy(dest, data_buf->payload + data_buf->offset, copy_size);
 
-    if (stream && (copy_size < data_buf->length)) {
-        // Update the size in the buffer
-        size_t new_buf_size = data_buf->length - copy_size;
-        memmove(data_buf->payload, data_buf->payload + copy_size, new_buf_size);
-        data_buf->length = new_buf_size;
+    if (stream && (copy_size < data_size)) {
+        // Skip the copied data in the buffer
+        data_buf->offset += copy_size;
     } else {
         // Entire packet used so free it
         rxBufChain = data_buf->next;
@@ -362,6 +364,60 @@ size_t NanostackSocket::data_copy_and_free(void *dest, size_t len,
     return copy_size;
 }
 
+size_t NanostackSocket::data_lend(nsapi_recv_buffer_t *buffer,
+                                  SocketAddress *address, bool stream)
+{
+    nanostack_assert_locked();
+    MBED_ASSERT((SOCKET_MODE_DATAGRAM == mode) ||
+                (mode == SOCKET_MODE_STREAM));
+
+    NanostackBuffer *data_buf = rxBufChain;
+    buffer->count = 0;
+    buffer->handle = data_buf;
+    if (NULL == data_buf) {
+        // No data
+        return 0;
+    }
+
+    if (address) {
+        convert_ns_addr_to_mbed(address, &data_buf->ns_address);
+    }
+
+    // Detach whole buffers from the chain, one for each segment of a
+    // stream and a single one for a datagram
+    unsigned max_count = stream ? NSAPI_RECV_BUFFER_SEGMENTS : 1;
+    NanostackBuffer *last_buf = NULL;
+    size_t size = 0;
+    while (data_buf != NULL && buffer->count < max_count) {
+        buffer->segments[buffer->count].data = data_buf->payload + data_buf->offset;
+        buffer->segments[buffer->count].size = data_buf->length - data_buf->offset;
+        size += buffer->segments[buffer->count].size;
+        buffer->count++;
+        last_buf = data_buf;
+        data_buf = data_buf->next;
+    }
+
+    rxBufChain = data_buf;
+    last_buf->next = NULL;
+    return size;
+}
+
+void NanostackSocket::data_release(nsapi_recv_buffer_t *buffer)
+{
+    nanostack_assert_locked();
+    // No mode requirement, the buffers are detached from the socket
+
+    NanostackBuffer *data_buf = (NanostackBuffer *)buffer->handle;
+    while (data_buf != NULL) {
+        NanostackBuffer *next_buf = data_buf->next;
+        FREE(data_buf);
+        data_buf = next_buf;
+    }
+
+    buffer->count = 0;
+    buffer->handle = NULL;
+}
+
 void NanostackSocket::data_free_all(void)
 {
     nanostack_assert_locked();
@@ -410,6 +466,7 @@ void NanostackSocket::event_data(socket_callback_t *sock_cb)
         return;
     }
     recv_buff->next = NULL;
+    recv_buff->offset = 0;
 
     // Write data to buffer
     int16_t length = socket_read(sock_cb->socket_id,
@@ -945,6 +1002,190 @@ int NanostackInterface::socket_recv(void *handle, void *data, unsigned size)
     return ret;
 }
 
+int NanostackInterface::socket_recv_buffer(void *handle, nsapi_recv_buffer_t *buffer)
+{
+    // Validate parameters
+    NanostackSocket * socket = static_cast<NanostackSocket *>(handle);
+    if (NULL == handle) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+    if (NULL == buffer) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    nanostack_lock();
+
+    int ret;
+    if (socket->closed()) {
+        ret = NSAPI_ERROR_NO_CONNECTION;
+    } else if (socket->data_available()) {
+        ret = socket->data_lend(buffer, NULL, true);
+    } else {
+        ret = NSAPI_ERROR_WOULD_BLOCK;
+    }
+
+    nanostack_unlock();
+
+    tr_debug("socket_recv_buffer(socket=%p) sock_id=%d, ret=%i", socket, socket->socket_id, ret);
+
+    return ret;
+}
+
+int NanostackInterface::socket_recvfrom_buffer(void *handle, SocketAddress *address, nsapi_recv_buffer_t *buffer)
+{
+    // Validate parameters
+    NanostackSocket * socket = static_cast<NanostackSocket *>(handle);
+    if (NULL == handle) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+    if (NULL == buffer) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    nanostack_lock();
+
+    int ret;
+    if (socket->closed()) {
+        ret = NSAPI_ERROR_NO_CONNECTION;
+    } else if (NANOSTACK_SOCKET_TCP == socket->proto) {
+        tr_error("recv_from() not supported with SOCKET_STREAM!");
+        ret = NSAPI_ERROR_UNSUPPORTED;
+    } else if (!socket->data_available()) {
+        ret = NSAPI_ERROR_WOULD_BLOCK;
+    } else {
+        ret = socket->data_lend(buffer, address, false);
+    }
+
+    nanostack_unlock();
+
+    tr_debug("socket_recvfrom_buffer(socket=%p) sock_id=%d, ret=%i", socket, socket->socket_id, ret);
+
+    return ret;
+}
+
+void NanostackInterface::socket_release_buffer(void *handle, nsapi_recv_buffer_t *buffer)
+{
+    // The buffers are detached from the socket, which may be closed
+    if (NULL == buffer) {
+        MBED_ASSERT(false);
+        return;
+    }
+
+    nanostack_lock();
+
+    NanostackSocket::data_release(buffer);
+
+    nanostack_unlock();
+}
+
+int NanostackInterface::socket_sendto_batch(void *handle, nsapi_send_datagram_t *datagrams, unsigned count)
+{
+    // Validate parameters
+    NanostackSocket * socket = static_cast<NanostackSocket *>(handle);
+    if (NULL == handle) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+    if (NULL == datagrams) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    nanostack_lock();
+
+    int ret = 0;
+    unsigned sent = 0;
+    if (socket->closed()) {
+        ret = NSAPI_ERROR_NO_CONNECTION;
+    } else if (NANOSTACK_SOCKET_TCP == socket->proto) {
+        tr_error("socket_sendto_batch() not supported with SOCKET_STREAM!");
+        ret = NSAPI_ERROR_UNSUPPORTED;
+    } else {
+        if (!socket->is_bound()) {
+            socket->set_bound();
+        }
+
+        for (; sent < count; sent++) {
+            if (datagrams[sent].size > 0xffff) {
+                ret = NSAPI_ERROR_PARAMETER;
+                break;
+            }
+
+            ns_address_t ns_address;
+            SocketAddress address(datagrams[sent].addr, datagrams[sent].port);
+            convert_mbed_addr_to_ns(&ns_address, &address);
+            int8_t send_to_status = ::socket_sendto(socket->socket_id, &ns_address,
+                                           (uint8_t *)datagrams[sent].data, datagrams[sent].size);
+            if (-4 == send_to_status) {
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            } else if (0 != send_to_status) {
+                tr_error("socket_sendto_batch: error=%d", send_to_status);
+                ret = NSAPI_ERROR_DEVICE_ERROR;
+                break;
+            }
+
+            datagrams[sent].length = datagrams[sent].size;
+        }
+    }
+
+    nanostack_unlock();
+
+    if (sent > 0 || ret == 0) {
+        ret = sent;
+    }
+
+    tr_debug("socket_sendto_batch(socket=%p) sock_id=%d, ret=%i", socket, socket->socket_id, ret);
+
+    return ret;
+}
+
+int NanostackInterface::socket_recvfrom_batch(void *handle, nsapi_datagram_t *datagrams, unsigned count)
+{
+    // Validate parameters
+    NanostackSocket * socket = static_cast<NanostackSocket *>(handle);
+    if (NULL == handle) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+    if (NULL == datagrams) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    nanostack_lock();
+
+    int ret;
+    if (socket->closed()) {
+        ret = NSAPI_ERROR_NO_CONNECTION;
+    } else if (NANOSTACK_SOCKET_TCP == socket->proto) {
+        tr_error("socket_recvfrom_batch() not supported with SOCKET_STREAM!");
+        ret = NSAPI_ERROR_UNSUPPORTED;
+    } else if (!socket->data_available()) {
+        ret = NSAPI_ERROR_WOULD_BLOCK;
+    } else {
+        unsigned recv = 0;
+        for (; recv < count && socket->data_available(); recv++) {
+            SocketAddress address;
+            datagrams[recv].length = socket->data_copy_and_free(datagrams[recv].data,
+                    datagrams[recv].size, &address, false);
+            datagrams[recv].addr = address.get_addr();
+            datagrams[recv].port = address.get_port();
+        }
+        ret = recv;
+    }
+
+    nanostack_unlock();
+
+    tr_debug("socket_recvfrom_batch(socket=%p) sock_id=%d, ret=%i", socket, socket->socket_id, ret);
+
+    return ret;
+}
+
 void NanostackInterface::socket_attach(void *handle, void (*callback)(void *), void *id)
 {
     // Validate parameters
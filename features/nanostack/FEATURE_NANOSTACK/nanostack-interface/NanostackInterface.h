@@ -135,6 +135,21 @@ protected:
      */
     virtual int socket_recv(void *handle, void *data, unsigned size);
 
+    /** Receive data over a TCP socket without copying it
+     *
+     *  The socket must be connected to a remote host. Lends the received
+     *  data to the caller and returns the number of bytes lent.
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param buffer   Destination for the description of the data
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual int socket_recv_buffer(void *handle, nsapi_recv_buffer_t *buffer);
+
     /** Send a packet over a UDP socket
      *
      *  Sends data to the specified address. Returns the number of bytes
@@ -169,6 +184,64 @@ protected:
      */
     virtual int socket_recvfrom(void *handle, SocketAddress *address, void *buffer, unsigned size);
 
+    /** Receive a packet over a UDP socket without copying it
+     *
+     *  Lends the received datagram to the caller and stores the source
+     *  address in address if address is not NULL. Returns the number of
+     *  bytes lent.
+     *
+     *  This call is non-blocking. If recvfrom would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param buffer   Destination for the description of the data
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual int socket_recvfrom_buffer(void *handle, SocketAddress *address, nsapi_recv_buffer_t *buffer);
+
+    /** Release a buffer lent by socket_recv_buffer or socket_recvfrom_buffer
+     *
+     *  @param handle   Socket handle
+     *  @param buffer   Buffer to release
+     */
+    virtual void socket_release_buffer(void *handle, nsapi_recv_buffer_t *buffer);
+
+    /** Send several packets over a UDP socket
+     *
+     *  Sends the datagrams in order under a single acquisition of the
+     *  stack lock, stopping at the first that can not be sent. Returns the
+     *  number of datagrams sent.
+     *
+     *  This call is non-blocking. If no datagram can be sent,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle    Socket handle
+     *  @param datagrams Datagrams to send
+     *  @param count     Number of datagrams
+     *  @return          Number of datagrams sent on success, negative error
+     *                   code if the first datagram could not be sent
+     */
+    virtual int socket_sendto_batch(void *handle, nsapi_send_datagram_t *datagrams, unsigned count);
+
+    /** Receive several packets over a UDP socket
+     *
+     *  Receives the queued datagrams, up to count, under a single
+     *  acquisition of the stack lock. Returns the number of datagrams
+     *  received.
+     *
+     *  This call is non-blocking. If no datagram has been received,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle    Socket handle
+     *  @param datagrams Destination for the datagrams
+     *  @param count     Maximum number of datagrams
+     *  @return          Number of datagrams received on success, negative
+     *                   error code if no datagram could be received
+     */
+    virtual int socket_recvfrom_batch(void *handle, nsapi_datagram_t *datagrams, unsigned count);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -70,3 +70,14 @@ int NetworkInterface::add_dns_server(const SocketAddress &address)
     return get_stack()->add_dns_server(address);
 }
 
+int NetworkInterface::gethostbyname_async(const char *name, hostbyname_cb_t callback,
+        events::EventQueue *queue, nsapi_version_t version)
+{
+    return get_stack()->gethostbyname_async(name, callback, queue, version);
+}
+
+int NetworkInterface::gethostbyname_async_cancel(int id)
+{
+    return get_stack()->gethostbyname_async_cancel(id);
+}
+
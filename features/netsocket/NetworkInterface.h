@@ -22,10 +22,15 @@
 
 #include "netsocket/nsapi_types.h"
 #include "netsocket/SocketAddress.h"
+#include "platform/Callback.h"
 
 // Predeclared class
 class NetworkStack;
 
+namespace events {
+class EventQueue;
+}
+
 
 /** NetworkInterface class
  *
@@ -33,6 +38,14 @@ class NetworkStack;
  */
 class NetworkInterface {
 public:
+    /** Hostname translation callback
+     *
+     *  @param result   0 on success, negative error code on failure
+     *  @param address  Resolved address, valid only during the callback,
+     *                  or NULL on failure
+     */
+    typedef mbed::Callback<void (int result, SocketAddress *address)> hostbyname_cb_t;
+
     virtual ~NetworkInterface() {};
 
     /** Get the local MAC address
@@ -139,6 +152,31 @@ public:
      */
     virtual int add_dns_server(const SocketAddress &address);
 
+    /** Translates a hostname to an IP address without blocking
+     *
+     *  The translation runs on the event queue, which must be dispatched,
+     *  and completes by calling callback from it.
+     *
+     *  If no stack-specific DNS resolution is provided, the hostname
+     *  will be resolve using a UDP socket on the stack.
+     *
+     *  @param host     Hostname to resolve
+     *  @param callback Callback called with the result of the translation
+     *  @param queue    Event queue the translation runs on
+     *  @param version  IP version of address to resolve
+     *  @return         Positive id of the translation on success, negative
+     *                  error code on failure
+     */
+    virtual int gethostbyname_async(const char *host, hostbyname_cb_t callback,
+            events::EventQueue *queue, nsapi_version_t version = NSAPI_IPv4);
+
+    /** Cancel a translation started by gethostbyname_async
+     *
+     *  @param id       Id returned by gethostbyname_async
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int gethostbyname_async_cancel(int id);
+
 protected:
     friend class Socket;
     friend class UDPSocket;
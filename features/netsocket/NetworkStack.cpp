@@ -51,6 +51,17 @@ int NetworkStack::add_dns_server(const SocketAddress &address)
     return nsapi_dns_add_server(address);
 }
 
+int NetworkStack::gethostbyname_async(const char *name, hostbyname_cb_t callback,
+        events::EventQueue *queue, nsapi_version_t version)
+{
+    return nsapi_dns_query_async(this, name, callback, queue, version);
+}
+
+int NetworkStack::gethostbyname_async_cancel(int id)
+{
+    return nsapi_dns_query_async_cancel(id);
+}
+
 int NetworkStack::setstackopt(int level, int optname, const void *optval, unsigned optlen)
 {
     return NSAPI_ERROR_UNSUPPORTED;
@@ -61,6 +72,58 @@ int NetworkStack::getstackopt(int level, int optname, void *optval, unsigned *op
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+int NetworkStack::socket_send_nocopy(nsapi_socket_t handle, const void *data, unsigned size,
+        void (*release)(void *), void *context)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+int NetworkStack::socket_recv_buffer(nsapi_socket_t handle, nsapi_recv_buffer_t *buffer)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+int NetworkStack::socket_recvfrom_buffer(nsapi_socket_t handle, SocketAddress *address, nsapi_recv_buffer_t *buffer)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+void NetworkStack::socket_release_buffer(nsapi_socket_t handle, nsapi_recv_buffer_t *buffer)
+{
+}
+
+int NetworkStack::socket_sendto_batch(nsapi_socket_t handle, nsapi_send_datagram_t *datagrams, unsigned count)
+{
+    for (unsigned i = 0; i < count; i++) {
+        SocketAddress address(datagrams[i].addr, datagrams[i].port);
+        int sent = socket_sendto(handle, address, datagrams[i].data, datagrams[i].size);
+        if (sent < 0) {
+            return i ? (int)i : sent;
+        }
+
+        datagrams[i].length = sent;
+    }
+
+    return count;
+}
+
+int NetworkStack::socket_recvfrom_batch(nsapi_socket_t handle, nsapi_datagram_t *datagrams, unsigned count)
+{
+    for (unsigned i = 0; i < count; i++) {
+        SocketAddress address;
+        int recv = socket_recvfrom(handle, &address, datagrams[i].data, datagrams[i].size);
+        if (recv < 0) {
+            return i ? (int)i : recv;
+        }
+
+        datagrams[i].addr = address.get_addr();
+        datagrams[i].port = address.get_port();
+        datagrams[i].length = recv;
+    }
+
+    return count;
+}
+
 int NetworkStack::setsockopt(void *handle, int level, int optname, const void *optval, unsigned optlen)
 {
     return NSAPI_ERROR_UNSUPPORTED;
@@ -225,6 +288,16 @@ protected:
         return _stack_api()->socket_send(_stack(), socket, data, size);
     }
 
+    virtual int socket_send_nocopy(nsapi_socket_t socket, const void *data, unsigned size,
+            void (*release)(void *), void *context)
+    {
+        if (!_stack_api()->socket_send_nocopy) {
+            return NetworkStack::socket_send_nocopy(socket, data, size, release, context);
+        }
+
+        return _stack_api()->socket_send_nocopy(_stack(), socket, data, size, release, context);
+    }
+
     virtual int socket_recv(nsapi_socket_t socket, void *data, unsigned size)
     {
         if (!_stack_api()->socket_recv) {
@@ -234,6 +307,15 @@ protected:
         return _stack_api()->socket_recv(_stack(), socket, data, size);
     }
 
+    virtual int socket_recv_buffer(nsapi_socket_t socket, nsapi_recv_buffer_t *buffer)
+    {
+        if (!_stack_api()->socket_recv_buffer) {
+            return NetworkStack::socket_recv_buffer(socket, buffer);
+        }
+
+        return _stack_api()->socket_recv_buffer(_stack(), socket, buffer);
+    }
+
     virtual int socket_sendto(nsapi_socket_t socket, const SocketAddress &address, const void *data, unsigned size)
     {
         if (!_stack_api()->socket_sendto) {
@@ -262,6 +344,52 @@ protected:
         return err;
     }
 
+    virtual int socket_recvfrom_buffer(nsapi_socket_t socket, SocketAddress *address, nsapi_recv_buffer_t *buffer)
+    {
+        if (!_stack_api()->socket_recvfrom_buffer) {
+            return NetworkStack::socket_recvfrom_buffer(socket, address, buffer);
+        }
+
+        nsapi_addr_t addr = {NSAPI_IPv4, 0};
+        uint16_t port = 0;
+
+        int err = _stack_api()->socket_recvfrom_buffer(_stack(), socket, &addr, &port, buffer);
+
+        if (address) {
+            address->set_addr(addr);
+            address->set_port(port);
+        }
+
+        return err;
+    }
+
+    virtual void socket_release_buffer(nsapi_socket_t socket, nsapi_recv_buffer_t *buffer)
+    {
+        if (!_stack_api()->socket_release_buffer) {
+            return NetworkStack::socket_release_buffer(socket, buffer);
+        }
+
+        return _stack_api()->socket_release_buffer(_stack(), socket, buffer);
+    }
+
+    virtual int socket_sendto_batch(nsapi_socket_t socket, nsapi_send_datagram_t *datagrams, unsigned count)
+    {
+        if (!_stack_api()->socket_sendto_batch) {
+            return NetworkStack::socket_sendto_batch(socket, datagrams, count);
+        }
+
+        return _stack_api()->socket_sendto_batch(_stack(), socket, datagrams, count);
+    }
+
+    virtual int socket_recvfrom_batch(nsapi_socket_t socket, nsapi_datagram_t *datagrams, unsigned count)
+    {
+        if (!_stack_api()->socket_recvfrom_batch) {
+            return NetworkStack::socket_recvfrom_batch(socket, datagrams, count);
+        }
+
+        return _stack_api()->socket_recvfrom_batch(_stack(), socket, datagrams, count);
+    }
+
     virtual void socket_attach(nsapi_socket_t socket, void (*callback)(void *), void *data)
     {
         if (!_stack_api()->socket_attach) {
@@ -35,6 +35,14 @@
 class NetworkStack
 {
 public:
+    /** Hostname translation callback
+     *
+     *  @param result   0 on success, negative error code on failure
+     *  @param address  Resolved address, valid only during the callback,
+     *                  or NULL on failure
+     */
+    typedef mbed::Callback<void (int result, SocketAddress *address)> hostbyname_cb_t;
+
     virtual ~NetworkStack() {};
 
     /** Get the local IP address
@@ -80,6 +88,32 @@ public:
      */
     virtual int add_dns_server(const SocketAddress &address);
 
+    /** Translates a hostname to an IP address without blocking
+     *
+     *  The translation runs on the event queue, which must be dispatched,
+     *  and completes by calling callback from it. If the hostname is an IP
+     *  address, no network transactions will be performed.
+     *
+     *  If no stack-specific DNS resolution is provided, the hostname
+     *  will be resolve using a UDP socket on the stack.
+     *
+     *  @param host     Hostname to resolve
+     *  @param callback Callback called with the result of the translation
+     *  @param queue    Event queue the translation runs on
+     *  @param version  IP version of address to resolve
+     *  @return         Positive id of the translation on success, negative
+     *                  error code on failure
+     */
+    virtual int gethostbyname_async(const char *host, hostbyname_cb_t callback,
+            events::EventQueue *queue, nsapi_version_t version = NSAPI_IPv4);
+
+    /** Cancel a translation started by gethostbyname_async
+     *
+     *  @param id       Id returned by gethostbyname_async
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int gethostbyname_async_cancel(int id);
+
     /*  Set stack-specific stack options
      *
      *  The setstackopt allow an application to pass stack-specific hints
@@ -208,6 +242,33 @@ protected:
      */
     virtual int socket_send(nsapi_socket_t handle, const void *data, unsigned size) = 0;
 
+    /** Send data over a TCP socket without copying it
+     *
+     *  The socket must be connected to a remote host. Queues data for
+     *  transmission by reference and returns the number of bytes queued
+     *  from the buffer. Those bytes must remain valid and unmodified until
+     *  release is called, which happens exactly once for each call that
+     *  returns a positive count, when the data has been acknowledged by the
+     *  remote host or the connection has failed or been closed.
+     *
+     *  The release function may be called from the stack's thread and should
+     *  not perform expensive operations such as recv/send calls.
+     *
+     *  This call is non-blocking. If send would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately. Stacks that always
+     *  copy return NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param handle   Socket handle
+     *  @param data     Buffer of data to send to the host
+     *  @param size     Size of the buffer in bytes
+     *  @param release  Function to call when the stack releases the buffer
+     *  @param context  Argument to pass to release
+     *  @return         Number of queued bytes on success, negative error
+     *                  code on failure
+     */
+    virtual int socket_send_nocopy(nsapi_socket_t handle, const void *data, unsigned size,
+            void (*release)(void *), void *context);
+
     /** Receive data over a TCP socket
      *
      *  The socket must be connected to a remote host. Returns the number of
@@ -224,6 +285,24 @@ protected:
      */
     virtual int socket_recv(nsapi_socket_t handle, void *data, unsigned size) = 0;
 
+    /** Receive data over a TCP socket without copying it
+     *
+     *  The socket must be connected to a remote host. Lends the next
+     *  received data to the caller as segments of the stack's own memory
+     *  and returns the number of bytes they hold. The buffer must be
+     *  released with socket_release_buffer.
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately. Stacks that can
+     *  not lend their buffers return NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param handle   Socket handle
+     *  @param buffer   Destination for the description of the data
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual int socket_recv_buffer(nsapi_socket_t handle, nsapi_recv_buffer_t *buffer);
+
     /** Send a packet over a UDP socket
      *
      *  Sends data to the specified address. Returns the number of bytes
@@ -258,6 +337,71 @@ protected:
      */
     virtual int socket_recvfrom(nsapi_socket_t handle, SocketAddress *address, void *buffer, unsigned size) = 0;
 
+    /** Receive a packet over a UDP socket without copying it
+     *
+     *  Lends the next received datagram to the caller as segments of the
+     *  stack's own memory and stores the source address in address if
+     *  address is not NULL. Returns the number of bytes the segments hold.
+     *  The buffer must be released with socket_release_buffer.
+     *
+     *  This call is non-blocking. If recvfrom would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately. Stacks that can
+     *  not lend their buffers return NSAPI_ERROR_UNSUPPORTED.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param buffer   Destination for the description of the data
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual int socket_recvfrom_buffer(nsapi_socket_t handle, SocketAddress *address, nsapi_recv_buffer_t *buffer);
+
+    /** Release a buffer lent by socket_recv_buffer or socket_recvfrom_buffer
+     *
+     *  The buffer may be released after the socket has been closed.
+     *
+     *  @param handle   Socket handle
+     *  @param buffer   Buffer to release
+     */
+    virtual void socket_release_buffer(nsapi_socket_t handle, nsapi_recv_buffer_t *buffer);
+
+    /** Send several packets over a UDP socket
+     *
+     *  Sends the datagrams in order, stopping at the first that can not be
+     *  sent, and stores the number of bytes sent in each datagram's length.
+     *  Returns the number of datagrams sent. By default each datagram is
+     *  passed to socket_sendto in turn.
+     *
+     *  This call is non-blocking. If no datagram can be sent,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle    Socket handle
+     *  @param datagrams Datagrams to send
+     *  @param count     Number of datagrams
+     *  @return          Number of datagrams sent on success, negative error
+     *                   code if the first datagram could not be sent
+     */
+    virtual int socket_sendto_batch(nsapi_socket_t handle, nsapi_send_datagram_t *datagrams, unsigned count);
+
+    /** Receive several packets over a UDP socket
+     *
+     *  Receives datagrams until count have been received or none are left,
+     *  storing each payload in the datagram's data, its length in length
+     *  and its source in addr and port. Payloads larger than size are
+     *  truncated. Returns the number of datagrams received. By default
+     *  socket_recvfrom is called for each datagram in turn.
+     *
+     *  This call is non-blocking. If no datagram has been received,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle    Socket handle
+     *  @param datagrams Destination for the datagrams
+     *  @param count     Maximum number of datagrams
+     *  @return          Number of datagrams received on success, negative
+     *                   error code if no datagram could be received
+     */
+    virtual int socket_recvfrom_batch(nsapi_socket_t handle, nsapi_datagram_t *datagrams, unsigned count);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -15,15 +15,26 @@
  */
 
 #include "Socket.h"
+#include "SocketSet.h"
 #include "mbed.h"
 
 Socket::Socket()
     : _stack(0)
     , _socket(0)
     , _timeout(osWaitForever)
+    , _set(0)
+    , _readable(true)
+    , _writable(true)
 {
 }
 
+Socket::~Socket()
+{
+    if (_set) {
+        _set->remove(this);
+    }
+}
+
 int Socket::open(NetworkStack *stack)
 {
     _lock.lock();
@@ -42,7 +53,9 @@ int Socket::open(NetworkStack *stack)
     }
 
     _socket = socket;
-    _event.attach(this, &Socket::event);
+    _readable = true;
+    _writable = true;
+    _event.attach(this, &Socket::stack_event);
     _stack->socket_attach(_socket, Callback<void()>::thunk, &_event);
 
     _lock.unlock();
@@ -63,7 +76,7 @@ int Socket::close()
 
     // Wakeup anything in a blocking operation
     // on this socket
-    event();
+    stack_event();
 
     _lock.unlock();
     return ret;
@@ -148,6 +161,31 @@ int Socket::getsockopt(int level, int optname, void *optval, unsigned *optlen)
 
 }
 
+void Socket::release_buffer(nsapi_recv_buffer_t *buffer)
+{
+    _lock.lock();
+
+    if (_stack) {
+        _stack->socket_release_buffer(_socket, buffer);
+    }
+
+    _lock.unlock();
+}
+
+void Socket::stack_event()
+{
+    // The stack does not say what changed, so assume both directions
+    // may make progress until an operation says otherwise
+    _readable = true;
+    _writable = true;
+
+    if (_set) {
+        _set->event();
+    }
+
+    event();
+}
+
 void Socket::attach(Callback<void()> callback)
 {
     _lock.lock();
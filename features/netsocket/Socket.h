@@ -26,6 +26,7 @@
 #include "Callback.h"
 #include "toolchain.h"
 
+class SocketSet;
 
 /** Abstract socket class
  */
@@ -33,9 +34,10 @@ class Socket {
 public:
     /** Destroy a socket
      *
-     *  Closes socket if the socket is still open
+     *  Closes socket if the socket is still open, and removes the socket
+     *  from any SocketSet it is a member of
      */
-    virtual ~Socket() {}
+    virtual ~Socket();
 
     /** Opens a socket
      *
@@ -58,6 +60,12 @@ public:
      *  Closes any open connection and deallocates any memory associated
      *  with the socket. Called from destructor if socket is not closed.
      *
+     *  If buffers passed to TCPSocket::send_nocopy have not been released
+     *  yet, the connection is aborted and their release functions are
+     *  called before close returns. On lwIP, close first blocks for up to
+     *  lwip.tcp-nocopy-close-timeout milliseconds (0 by default) waiting
+     *  for them to be acknowledged.
+     *
      *  @return         0 on success, negative error code on failure
      */
     int close();
@@ -148,6 +156,16 @@ public:
      */    
     int getsockopt(int level, int optname, void *optval, unsigned *optlen);
 
+    /** Release a receive buffer lent by the network stack
+     *
+     *  Gives back a buffer returned by TCPSocket::recv_buffer or
+     *  UDPSocket::recvfrom_buffer, after which its segments must not be
+     *  accessed. Buffers may be released after the socket has been closed.
+     *
+     *  @param buffer   Buffer to release
+     */
+    void release_buffer(nsapi_recv_buffer_t *buffer);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -186,9 +204,12 @@ public:
     }
 
 protected:
+    friend class SocketSet;
+
     Socket();
     virtual nsapi_protocol_t get_proto() = 0;
     virtual void event() = 0;
+    void stack_event();
 
     NetworkStack *_stack;
     nsapi_socket_t _socket;
@@ -196,6 +217,12 @@ protected:
     mbed::Callback<void()> _event;
     mbed::Callback<void()> _callback;
     rtos::Mutex _lock;
+
+    // Readiness tracking for SocketSet, cleared while an operation
+    // would block and set again by the next event from the stack
+    SocketSet *_set;
+    volatile bool _readable;
+    volatile bool _writable;
 };
 
 
@@ -0,0 +1,190 @@
+/* SocketSet
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SocketSet.h"
+#include "Timer.h"
+
+SocketSet::SocketSet()
+    : _count(0), _ready(0), _sem(0)
+{
+}
+
+SocketSet::~SocketSet()
+{
+    _lock.lock();
+
+    for (unsigned i = 0; i < _count; i++) {
+        _entries[i].socket->_set = 0;
+    }
+    _count = 0;
+
+    _lock.unlock();
+}
+
+int SocketSet::add(Socket *socket, int events)
+{
+    _lock.lock();
+
+    if (!socket || socket->_set) {
+        _lock.unlock();
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    if (_count >= MBED_CONF_NSAPI_SOCKET_SET_SIZE) {
+        _lock.unlock();
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    _entries[_count].socket = socket;
+    _entries[_count].events = events;
+    _entries[_count].revents = 0;
+    _count += 1;
+    socket->_set = this;
+
+    _lock.unlock();
+
+    // The socket may already be ready
+    event();
+    return 0;
+}
+
+int SocketSet::modify(Socket *socket, int events)
+{
+    _lock.lock();
+
+    for (unsigned i = 0; i < _count; i++) {
+        if (_entries[i].socket == socket) {
+            _entries[i].events = events;
+            _lock.unlock();
+            event();
+            return 0;
+        }
+    }
+
+    _lock.unlock();
+    return NSAPI_ERROR_PARAMETER;
+}
+
+void SocketSet::remove(Socket *socket)
+{
+    _lock.lock();
+
+    for (unsigned i = 0; i < _count; i++) {
+        if (_entries[i].socket == socket) {
+            socket->_set = 0;
+
+            // Keep ready entries at the front
+            if (i < _ready) {
+                _ready -= 1;
+                _entries[i] = _entries[_ready];
+                i = _ready;
+            }
+
+            _count -= 1;
+            _entries[i] = _entries[_count];
+            break;
+        }
+    }
+
+    _lock.unlock();
+}
+
+void SocketSet::event()
+{
+    // Keep at most one pending wakeup, the waiter rescans every socket
+    int32_t acquired = _sem.wait(0);
+    if (acquired <= 1) {
+        _sem.release();
+    }
+}
+
+int SocketSet::scan()
+{
+    _lock.lock();
+
+    // Move ready entries to the front so get_ready can index them
+    _ready = 0;
+    for (unsigned i = 0; i < _count; i++) {
+        Socket *socket = _entries[i].socket;
+        int revents = 0;
+
+        if (!socket->_socket) {
+            revents |= CLOSED;
+        }
+        if ((_entries[i].events & READABLE) && socket->_readable) {
+            revents |= READABLE;
+        }
+        if ((_entries[i].events & WRITABLE) && socket->_writable) {
+            revents |= WRITABLE;
+        }
+
+        _entries[i].revents = revents;
+        if (revents) {
+            entry ready = _entries[i];
+            _entries[i] = _entries[_ready];
+            _entries[_ready] = ready;
+            _ready += 1;
+        }
+    }
+
+    int ready = _ready;
+    _lock.unlock();
+    return ready;
+}
+
+int SocketSet::wait(int timeout)
+{
+    mbed::Timer timer;
+    timer.start();
+
+    while (true) {
+        int ready = scan();
+        if (ready > 0) {
+            return ready;
+        }
+
+        uint32_t remaining;
+        if (timeout < 0) {
+            remaining = osWaitForever;
+        } else if (timer.read_ms() < timeout) {
+            remaining = timeout - timer.read_ms();
+        } else {
+            return NSAPI_ERROR_WOULD_BLOCK;
+        }
+
+        if (_sem.wait(remaining) < 1 && timeout >= 0) {
+            // Timed out, but pick up anything that raced with the timeout
+            ready = scan();
+            return ready > 0 ? ready : NSAPI_ERROR_WOULD_BLOCK;
+        }
+    }
+}
+
+Socket *SocketSet::get_ready(unsigned index, int *events)
+{
+    _lock.lock();
+
+    Socket *socket = NULL;
+    if (index < _ready) {
+        socket = _entries[index].socket;
+        if (events) {
+            *events = _entries[index].revents;
+        }
+    }
+
+    _lock.unlock();
+    return socket;
+}
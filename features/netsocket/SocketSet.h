@@ -0,0 +1,141 @@
+
+/** \addtogroup netsocket */
+/** @{*/
+/* SocketSet
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SOCKETSET_H
+#define SOCKETSET_H
+
+#include "netsocket/Socket.h"
+#include "rtos/Mutex.h"
+#include "rtos/Semaphore.h"
+
+#ifndef MBED_CONF_NSAPI_SOCKET_SET_SIZE
+#define MBED_CONF_NSAPI_SOCKET_SET_SIZE 16
+#endif
+
+
+/** Set of sockets waited on together
+ *
+ *  A SocketSet lets a single thread wait until any of several sockets can
+ *  make progress, instead of dedicating a thread or a blocking call to
+ *  each socket. Sockets are usually set non-blocking and serviced with
+ *  send/recv/accept calls until they return NSAPI_ERROR_WOULD_BLOCK.
+ *
+ *  Readiness is tracked from the socket's own operations and the stack's
+ *  state change events. A socket is reported ready when its last operation
+ *  in that direction did not block, or the stack has signalled it since,
+ *  so like the events passed to Socket::attach a ready report may be
+ *  spurious and the following operation may still return
+ *  NSAPI_ERROR_WOULD_BLOCK. Errors are returned by the following operation.
+ *
+ *  A socket may be a member of at most one set at a time.
+ */
+class SocketSet {
+public:
+    /** Events that can be waited on
+     */
+    enum {
+        READABLE = 0x1, /*!< recv, recvfrom or accept may make progress */
+        WRITABLE = 0x2, /*!< send or sendto may make progress */
+        CLOSED   = 0x4, /*!< socket is not open, always reported */
+    };
+
+    /** Create an empty socket set
+     */
+    SocketSet();
+
+    /** Destroy a socket set
+     *
+     *  Removes all sockets from the set
+     */
+    ~SocketSet();
+
+    /** Add a socket to the set
+     *
+     *  @param socket   Socket to wait on
+     *  @param events   Bitmask of READABLE and WRITABLE to wait for
+     *  @return         0 on success, NSAPI_ERROR_PARAMETER if the socket is
+     *                  already in a set, NSAPI_ERROR_NO_MEMORY if the set
+     *                  is full
+     */
+    int add(Socket *socket, int events);
+
+    /** Change the events waited on for a socket in the set
+     *
+     *  @param socket   Socket in the set
+     *  @param events   Bitmask of READABLE and WRITABLE to wait for
+     *  @return         0 on success, NSAPI_ERROR_PARAMETER if the socket is
+     *                  not in this set
+     */
+    int modify(Socket *socket, int events);
+
+    /** Remove a socket from the set
+     *
+     *  Sockets are also removed when they are destroyed.
+     *
+     *  @param socket   Socket to remove
+     */
+    void remove(Socket *socket);
+
+    /** Wait until sockets in the set are ready
+     *
+     *  Returns as soon as any socket is ready for one of its events. The
+     *  sockets found ready can then be retrieved with get_ready.
+     *
+     *  @param timeout  Timeout in milliseconds, 0 to poll, or negative to
+     *                  wait forever
+     *  @return         Number of ready sockets, NSAPI_ERROR_WOULD_BLOCK if
+     *                  the timeout passed first
+     */
+    int wait(int timeout = -1);
+
+    /** Get a socket found ready by the last wait
+     *
+     *  Removing a socket from the set discards its result and may move
+     *  the result of another socket to its index.
+     *
+     *  @param index    Index from 0 up to the count returned by wait
+     *  @param events   Destination for the bitmask of ready events, may be
+     *                  NULL
+     *  @return         Ready socket, or NULL if index is out of range
+     */
+    Socket *get_ready(unsigned index, int *events = NULL);
+
+private:
+    friend class Socket;
+
+    void event();
+    int scan();
+
+    struct entry {
+        Socket *socket;
+        int events;
+        int revents;
+    };
+
+    entry _entries[MBED_CONF_NSAPI_SOCKET_SET_SIZE];
+    unsigned _count;
+    unsigned _ready;
+    rtos::Mutex _lock;
+    rtos::Semaphore _sem;
+};
+
+
+#endif
+
+/** @}*/
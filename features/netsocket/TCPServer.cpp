@@ -59,8 +59,12 @@ int TCPServer::accept(TCPSocket *connection, SocketAddress *address)
         } 
 
         _pending = 0;
+        _readable = false;
         void *socket;
         ret = _stack->socket_accept(_socket, &socket, address);
+        if (NSAPI_ERROR_WOULD_BLOCK != ret) {
+            _readable = true;
+        }
 
         if (0 == ret) {
             connection->_lock.lock();
@@ -71,7 +75,9 @@ int TCPServer::accept(TCPSocket *connection, SocketAddress *address)
 
             connection->_stack = _stack;
             connection->_socket = socket;
-            connection->_event = Callback<void()>(connection, &TCPSocket::event);
+            connection->_readable = true;
+            connection->_writable = true;
+            connection->_event = Callback<void()>(static_cast<Socket *>(connection), &TCPSocket::stack_event);
             _stack->socket_attach(socket, &Callback<void()>::thunk, &connection->_event);
 
             connection->_lock.unlock();
@@ -81,7 +81,59 @@ int TCPSocket::send(const void *data, unsigned size)
         }
 
         _pending = 0;
+        _writable = false;
         int sent = _stack->socket_send(_socket, data, size);
+        if (NSAPI_ERROR_WOULD_BLOCK != sent) {
+            _writable = true;
+        }
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
+            ret = sent;
+            break;
+        } else {
+            int32_t count;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            count = _write_sem.wait(_timeout);
+            _lock.lock();
+
+            if (count < 1) {
+                // Semaphore wait timed out so break out and return
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _write_in_progress = false;
+    _lock.unlock();
+    return ret;
+}
+
+int TCPSocket::send_nocopy(const void *data, unsigned size, void (*release)(void *), void *context)
+{
+    _lock.lock();
+    int ret;
+
+    // If this assert is hit then there are two threads
+    // performing a send at the same time which is undefined
+    // behavior
+    MBED_ASSERT(!_write_in_progress);
+    _write_in_progress = true;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        _writable = false;
+        int sent = _stack->socket_send_nocopy(_socket, data, size, release, context);
+        if (NSAPI_ERROR_WOULD_BLOCK != sent) {
+            _writable = true;
+        }
         if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
             ret = sent;
             break;
@@ -125,7 +177,59 @@ int TCPSocket::recv(void *data, unsigned size)
         }
 
         _pending = 0;
+        _readable = false;
         int recv = _stack->socket_recv(_socket, data, size);
+        if (NSAPI_ERROR_WOULD_BLOCK != recv) {
+            _readable = true;
+        }
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            ret = recv;
+            break;
+        } else {
+            int32_t count;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            count = _read_sem.wait(_timeout);
+            _lock.lock();
+
+            if (count < 1) {
+                // Semaphore wait timed out so break out and return
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _read_in_progress = false;
+    _lock.unlock();
+    return ret;
+}
+
+int TCPSocket::recv_buffer(nsapi_recv_buffer_t *buffer)
+{
+    _lock.lock();
+    int ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(!_read_in_progress);
+    _read_in_progress = true;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        _readable = false;
+        int recv = _stack->socket_recv_buffer(_socket, buffer);
+        if (NSAPI_ERROR_WOULD_BLOCK != recv) {
+            _readable = true;
+        }
         if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
             ret = recv;
             break;
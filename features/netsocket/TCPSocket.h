@@ -93,6 +93,34 @@ public:
      *                  code on failure
      */
     int send(const void *data, unsigned size);
+
+    /** Send data over a TCP socket without copying it
+     *
+     *  The socket must be connected to a remote host. Returns the number of
+     *  bytes queued from the buffer, which the stack transmits directly
+     *  from the application's memory. Those bytes must remain valid and
+     *  unmodified until release is called, which happens exactly once for
+     *  each call that returns a positive count, when the data has been
+     *  acknowledged by the remote host or the connection has failed or
+     *  been closed. The socket should stay open until then, as closing it
+     *  with buffers still unreleased aborts the connection, see close.
+     *
+     *  The release function may be called from the stack's thread and should
+     *  not perform expensive operations such as recv/send calls.
+     *
+     *  By default, send_nocopy blocks until data is queued. If socket is set
+     *  to non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK is returned
+     *  immediately. If the network stack does not support zero-copy sends,
+     *  NSAPI_ERROR_UNSUPPORTED is returned and send should be used instead.
+     *
+     *  @param data     Buffer of data to send to the host
+     *  @param size     Size of the buffer in bytes
+     *  @param release  Function to call when the stack releases the buffer
+     *  @param context  Argument to pass to release
+     *  @return         Number of queued bytes on success, negative error
+     *                  code on failure
+     */
+    int send_nocopy(const void *data, unsigned size, void (*release)(void *), void *context);
     
     /** Receive data over a TCP socket
      *
@@ -110,6 +138,25 @@ public:
      */
     int recv(void *data, unsigned size);
 
+    /** Receive data over a TCP socket without copying it
+     *
+     *  The socket must be connected to a remote host. Lends the next
+     *  received data as segments of the network stack's own memory, so that
+     *  it can be parsed in place, and returns the number of bytes they hold.
+     *  The buffer must be given back with release_buffer once parsed; the
+     *  stack can not reuse the memory until then.
+     *
+     *  By default, recv_buffer blocks until data is received. If socket is
+     *  set to non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK is returned
+     *  immediately. If the network stack can not lend its buffers,
+     *  NSAPI_ERROR_UNSUPPORTED is returned and recv should be used instead.
+     *
+     *  @param buffer   Destination for the description of the data
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    int recv_buffer(nsapi_recv_buffer_t *buffer);
+
 protected:
     friend class TCPServer;
 
@@ -66,7 +66,11 @@ int UDPSocket::sendto(const SocketAddress &address, const void *data, unsigned s
         }
 
         _pending = 0;
+        _writable = false;
         int sent = _stack->socket_sendto(_socket, address, data, size);
+        if (NSAPI_ERROR_WOULD_BLOCK != sent) {
+            _writable = true;
+        }
         if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
             ret = sent;
             break;
@@ -110,7 +114,11 @@ int UDPSocket::recvfrom(SocketAddress *address, void *buffer, unsigned size)
         }
 
         _pending = 0;
+        _readable = false;
         int recv = _stack->socket_recvfrom(_socket, address, buffer, size);
+        if (NSAPI_ERROR_WOULD_BLOCK != recv) {
+            _readable = true;
+        }
         if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
             ret = recv;
             break;
@@ -136,6 +144,150 @@ int UDPSocket::recvfrom(SocketAddress *address, void *buffer, unsigned size)
     return ret;
 }
 
+int UDPSocket::recvfrom_buffer(SocketAddress *address, nsapi_recv_buffer_t *buffer)
+{
+    _lock.lock();
+    int ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(!_read_in_progress);
+    _read_in_progress = true;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        _readable = false;
+        int recv = _stack->socket_recvfrom_buffer(_socket, address, buffer);
+        if (NSAPI_ERROR_WOULD_BLOCK != recv) {
+            _readable = true;
+        }
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            ret = recv;
+            break;
+        } else {
+            int32_t count;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            count = _read_sem.wait(_timeout);
+            _lock.lock();
+
+            if (count < 1) {
+                // Semaphore wait timed out so break out and return
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _read_in_progress = false;
+    _lock.unlock();
+    return ret;
+}
+
+int UDPSocket::sendto_batch(nsapi_send_datagram_t *datagrams, unsigned count)
+{
+    _lock.lock();
+    int ret;
+
+    // If this assert is hit then there are two threads
+    // performing a send at the same time which is undefined
+    // behavior
+    MBED_ASSERT(!_write_in_progress);
+    _write_in_progress = true;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        _writable = false;
+        int sent = _stack->socket_sendto_batch(_socket, datagrams, count);
+        if (NSAPI_ERROR_WOULD_BLOCK != sent) {
+            _writable = true;
+        }
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
+            ret = sent;
+            break;
+        } else {
+            int32_t signalled;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            signalled = _write_sem.wait(_timeout);
+            _lock.lock();
+
+            if (signalled < 1) {
+                // Semaphore wait timed out so break out and return
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _write_in_progress = false;
+    _lock.unlock();
+    return ret;
+}
+
+int UDPSocket::recvfrom_batch(nsapi_datagram_t *datagrams, unsigned count)
+{
+    _lock.lock();
+    int ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(!_read_in_progress);
+    _read_in_progress = true;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        _readable = false;
+        int recv = _stack->socket_recvfrom_batch(_socket, datagrams, count);
+        if (NSAPI_ERROR_WOULD_BLOCK != recv) {
+            _readable = true;
+        }
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            ret = recv;
+            break;
+        } else {
+            int32_t signalled;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            signalled = _read_sem.wait(_timeout);
+            _lock.lock();
+
+            if (signalled < 1) {
+                // Semaphore wait timed out so break out and return
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _read_in_progress = false;
+    _lock.unlock();
+    return ret;
+}
+
 void UDPSocket::event()
 {
     int32_t wcount = _write_sem.wait(0);
@@ -110,6 +110,66 @@ public:
      */
     int recvfrom(SocketAddress *address, void *data, unsigned size);
 
+    /** Receive a packet over a UDP socket without copying it
+     *
+     *  Lends the next received datagram as segments of the network stack's
+     *  own memory, so that it can be parsed in place, and stores the source
+     *  address in address if address is not NULL. Returns the number of
+     *  bytes the segments hold. The buffer must be given back with
+     *  release_buffer once parsed; the stack can not reuse the memory until
+     *  then.
+     *
+     *  By default, recvfrom_buffer blocks until data is received. If socket
+     *  is set to non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK is
+     *  returned immediately. If the network stack can not lend its buffers,
+     *  NSAPI_ERROR_UNSUPPORTED is returned and recvfrom should be used
+     *  instead.
+     *
+     *  @param address  Destination for the source address or NULL
+     *  @param buffer   Destination for the description of the data
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    int recvfrom_buffer(SocketAddress *address, nsapi_recv_buffer_t *buffer);
+
+    /** Send several packets over a UDP socket
+     *
+     *  Sends the datagrams in order with a single call into the network
+     *  stack, stopping at the first that can not be sent, and stores the
+     *  number of bytes sent in each datagram's length. Returns the number of
+     *  datagrams sent, which may be fewer than count. A datagram larger than
+     *  65535 bytes is not sent and fails with NSAPI_ERROR_PARAMETER.
+     *
+     *  By default, sendto_batch blocks until at least one datagram is sent.
+     *  If socket is set to non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK
+     *  is returned immediately.
+     *
+     *  @param datagrams Datagrams to send, addressed by addr and port
+     *  @param count     Number of datagrams
+     *  @return          Number of datagrams sent on success, negative error
+     *                   code on failure
+     */
+    int sendto_batch(nsapi_send_datagram_t *datagrams, unsigned count);
+
+    /** Receive several packets over a UDP socket
+     *
+     *  Receives the datagrams already queued on the socket, up to count,
+     *  with a single call into the network stack. Each payload is stored in
+     *  the datagram's data, truncated to its size, with the number of bytes
+     *  in length and the source in addr and port. Returns the number of
+     *  datagrams received.
+     *
+     *  By default, recvfrom_batch blocks until at least one datagram is
+     *  received. If socket is set to non-blocking or times out,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param datagrams Destination for the datagrams
+     *  @param count     Maximum number of datagrams
+     *  @return          Number of datagrams received on success, negative
+     *                   error code on failure
+     */
+    int recvfrom_batch(nsapi_datagram_t *datagrams, unsigned count);
+
 protected:
     virtual nsapi_protocol_t get_proto();
     virtual void event();
@@ -16,6 +16,9 @@
  */
 #include "nsapi_dns.h"
 #include "netsocket/UDPSocket.h"
+#include "events/EventQueue.h"
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -29,6 +32,22 @@
 #define DNS_BUFFER_SIZE 512
 #define DNS_TIMEOUT 5000
 #define DNS_SERVERS_SIZE 5
+#define DNS_TTL_MAX (24*60*60)
+
+#ifndef MBED_CONF_NSAPI_DNS_CACHE_SIZE
+#define MBED_CONF_NSAPI_DNS_CACHE_SIZE 3
+#endif
+
+#ifndef MBED_CONF_NSAPI_DNS_SERVERS_PARALLEL
+#define MBED_CONF_NSAPI_DNS_SERVERS_PARALLEL 2
+#endif
+
+#ifndef MBED_CONF_NSAPI_DNS_MAX_ASYNC_QUERIES
+#define MBED_CONF_NSAPI_DNS_MAX_ASYNC_QUERIES 4
+#endif
+
+#define DNS_ROUNDS ((DNS_SERVERS_SIZE + MBED_CONF_NSAPI_DNS_SERVERS_PARALLEL-1) \
+        / MBED_CONF_NSAPI_DNS_SERVERS_PARALLEL)
 
 nsapi_addr_t dns_servers[DNS_SERVERS_SIZE] = {
     {NSAPI_IPv4, {8, 8, 8, 8}},
@@ -38,13 +57,20 @@ nsapi_addr_t dns_servers[DNS_SERVERS_SIZE] = {
     {NSAPI_IPv4, {208, 67, 222, 222}},
 };
 
+// Resolver state, shared by blocking and asynchronous queries
+static SingletonPtr<PlatformMutex> dns_mutex;
+static uint16_t dns_message_id = 1;
+static nsapi_dns_stats_t dns_stats;
+
 // DNS server configuration
 extern "C" int nsapi_dns_add_server(nsapi_addr_t addr)
 {
+    dns_mutex->lock();
     memmove(&dns_servers[1], &dns_servers[0],
             (DNS_SERVERS_SIZE-1)*sizeof(nsapi_addr_t));
 
     dns_servers[0] = addr;
+    dns_mutex->unlock();
     return 0;
 }
 
@@ -82,10 +108,18 @@ static uint16_t dns_scan_word(const uint8_t **p)
 }
 
 
-static void dns_append_question(uint8_t **p, const char *host, nsapi_version_t version)
+static uint32_t dns_scan_dword(const uint8_t **p)
+{
+    uint32_t a = dns_scan_word(p);
+    uint32_t b = dns_scan_word(p);
+    return (a << 16) | b;
+}
+
+
+static void dns_append_question(uint8_t **p, uint16_t id, const char *host, nsapi_version_t version)
 {
     // fill the header
-    dns_append_word(p, 1);      // id      = 1
+    dns_append_word(p, id);     // id
     dns_append_word(p, 0x0100); // flags   = recursion required
     dns_append_word(p, 1);      // qdcount = 1
     dns_append_word(p, 0);      // ancount = 0
@@ -110,10 +144,19 @@ static void dns_append_question(uint8_t **p, const char *host, nsapi_version_t v
     dns_append_word(p, CLASS_IN);
 }
 
-static int dns_scan_response(const uint8_t **p, nsapi_addr_t *addr, unsigned addr_count)
+// Returns the number of addresses found, which is 0 if the server could not
+// resolve the host, or -1 if the packet does not answer question id or ends
+// early. The lowest TTL of the addresses is stored in ttl.
+static int dns_scan_response(const uint8_t **p, unsigned size, uint16_t id, nsapi_addr_t *addr, unsigned addr_count, uint32_t *ttl)
 {
+    const uint8_t *end = *p + size;
+
     // scan header
-    uint16_t id    = dns_scan_word(p);
+    if (size < 12) {
+        return -1;
+    }
+
+    uint16_t rid   = dns_scan_word(p);
     uint16_t flags = dns_scan_word(p);
     bool    qr     = 0x1 & (flags >> 15);
     uint8_t opcode = 0xf & (flags >> 11);
@@ -125,46 +168,79 @@ static int dns_scan_response(const uint8_t **p, nsapi_addr_t *addr, unsigned add
     dns_scan_word(p);                    // arcount
 
     // verify header is response to query
-    if (!(id == 1 && qr && opcode == 0 && rcode == 0)) {
+    if (!(rid == id && qr && opcode == 0)) {
+        return -1;
+    }
+
+    if (rcode != 0) {
         return 0;
     }
 
     // skip questions
     for (int i = 0; i < qdcount; i++) {
         while (true) {
+            if (*p == end) {
+                return -1;
+            }
+
             uint8_t len = dns_scan_byte(p);
             if (len == 0) {
                 break;
+            } else if (len > end - *p) {
+                return -1;
             }
 
             *p += len;
         }
 
+        if (end - *p < 4) {
+            return -1;
+        }
+
         dns_scan_word(p); // qtype
         dns_scan_word(p); // qclass
     }
 
     // scan each response
     unsigned count = 0;
+    *ttl = DNS_TTL_MAX;
 
     for (int i = 0; i < ancount && count < addr_count; i++) {
         while (true) {
+            if (*p == end) {
+                return -1;
+            }
+
             uint8_t len = dns_scan_byte(p);
             if (len == 0) {
                 break;
             } else if (len & 0xc0) { // this is link
+                if (*p == end) {
+                    return -1;
+                }
+
                 dns_scan_byte(p);
                 break;
+            } else if (len > end - *p) {
+                return -1;
             }
 
             *p += len;
         }
 
+        if (end - *p < 10) {
+            return -1;
+        }
+
         uint16_t rtype    = dns_scan_word(p); // rtype
         uint16_t rclass   = dns_scan_word(p); // rclass
-        *p += 4;                              // ttl
+        uint32_t rttl     = dns_scan_dword(p); // ttl
         uint16_t rdlength = dns_scan_word(p); // rdlength
 
+        if (rdlength > end - *p) {
+            return -1;
+        }
+
         if (rtype == RR_A && rclass == CLASS_IN && rdlength == NSAPI_IPv4_BYTES) {
             // accept A record
             addr->version = NSAPI_IPv4;
@@ -174,6 +250,7 @@ static int dns_scan_response(const uint8_t **p, nsapi_addr_t *addr, unsigned add
 
             addr += 1;
             count += 1;
+            *ttl = (rttl < *ttl) ? rttl : *ttl;
         } else if (rtype == RR_AAAA && rclass == CLASS_IN && rdlength == NSAPI_IPv6_BYTES) {
             // accept AAAA record
             addr->version = NSAPI_IPv6;
@@ -183,6 +260,7 @@ static int dns_scan_response(const uint8_t **p, nsapi_addr_t *addr, unsigned add
 
             addr += 1;
             count += 1;
+            *ttl = (rttl < *ttl) ? rttl : *ttl;
         } else {
             // skip unrecognized records
             *p += rdlength;
@@ -192,6 +270,191 @@ static int dns_scan_response(const uint8_t **p, nsapi_addr_t *addr, unsigned add
     return count;
 }
 
+// DNS cache, holding the first address of resolved hosts until their TTL
+// expires and evicting the least recently used entry when full
+struct dns_cache_entry {
+    char *host;
+    nsapi_addr_t addr;
+    unsigned expires;
+    unsigned accessed;
+};
+
+static dns_cache_entry dns_cache[MBED_CONF_NSAPI_DNS_CACHE_SIZE];
+static unsigned dns_cache_accesses;
+
+// Must be called with dns_mutex held. Expired entries are dropped on every
+// lookup, which keeps the wrapping millisecond tick from reviving them.
+static bool dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *addr)
+{
+    unsigned now = equeue_tick();
+    bool found = false;
+
+    for (unsigned i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
+        dns_cache_entry *entry = &dns_cache[i];
+        if (!entry->host) {
+            continue;
+        }
+
+        if ((int)(entry->expires - now) <= 0) {
+            free(entry->host);
+            entry->host = 0;
+            continue;
+        }
+
+        if (!found && entry->addr.version == version && strcmp(entry->host, host) == 0) {
+            *addr = entry->addr;
+            entry->accessed = ++dns_cache_accesses;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+// Must be called with dns_mutex held
+static void dns_cache_add(const char *host, const nsapi_addr_t *addr, uint32_t ttl)
+{
+    unsigned now = equeue_tick();
+    dns_cache_entry *entry = 0;
+
+    // replace the entry for the host, a free entry, or the least recently
+    // used entry, in that order
+    for (unsigned i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
+        if (dns_cache[i].host && dns_cache[i].addr.version == addr->version
+                && strcmp(dns_cache[i].host, host) == 0) {
+            entry = &dns_cache[i];
+            break;
+        }
+
+        if (!entry || (entry->host && (!dns_cache[i].host
+                || (int)(dns_cache[i].accessed - entry->accessed) < 0))) {
+            entry = &dns_cache[i];
+        }
+    }
+
+    if (!entry->host || strcmp(entry->host, host) != 0) {
+        free(entry->host);
+        entry->host = (char *)malloc(strlen(host) + 1);
+        if (!entry->host) {
+            return;
+        }
+        strcpy(entry->host, host);
+    }
+
+    entry->addr = *addr;
+    entry->expires = now + ((ttl < DNS_TTL_MAX) ? ttl : DNS_TTL_MAX)*1000;
+    entry->accessed = ++dns_cache_accesses;
+}
+
+// Must be called with dns_mutex held
+static void dns_record_result(const char *host, int result, const nsapi_addr_t *addr,
+        uint32_t ttl, unsigned start)
+{
+    if (result > 0) {
+        unsigned latency = equeue_tick() - start;
+        dns_stats.resolved += 1;
+        dns_stats.latency_total += latency;
+        if (latency > dns_stats.latency_max) {
+            dns_stats.latency_max = latency;
+        }
+
+        if (ttl > 0) {
+            dns_cache_add(host, addr, ttl);
+        }
+    } else {
+        dns_stats.failures += 1;
+    }
+}
+
+extern "C" void nsapi_dns_get_stats(nsapi_dns_stats_t *stats)
+{
+    dns_mutex->lock();
+    *stats = dns_stats;
+    dns_mutex->unlock();
+}
+
+extern "C" void nsapi_dns_reset_stats(void)
+{
+    dns_mutex->lock();
+    memset(&dns_stats, 0, sizeof dns_stats);
+    dns_mutex->unlock();
+}
+
+extern "C" void nsapi_dns_cache_flush(void)
+{
+    dns_mutex->lock();
+    for (unsigned i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
+        free(dns_cache[i].host);
+        dns_cache[i].host = 0;
+    }
+    dns_mutex->unlock();
+}
+
+
+// Servers are queried in rounds of MBED_CONF_NSAPI_DNS_SERVERS_PARALLEL,
+// the first answer of a round wins. Returns the number of servers the
+// question was sent to, or a negative error code.
+static int dns_send_round(UDPSocket *socket, uint8_t *packet, uint16_t id,
+        const char *host, nsapi_version_t version, unsigned round)
+{
+    uint8_t *question = packet;
+    dns_append_question(&question, id, host, version);
+
+    int sent = 0;
+    int err = 0;
+    for (unsigned i = round*MBED_CONF_NSAPI_DNS_SERVERS_PARALLEL;
+            i < (round+1)*MBED_CONF_NSAPI_DNS_SERVERS_PARALLEL && i < DNS_SERVERS_SIZE; i++) {
+        dns_mutex->lock();
+        nsapi_addr_t server = dns_servers[i];
+        dns_mutex->unlock();
+
+        err = socket->sendto(SocketAddress(server, 53), packet, question - packet);
+        if (err >= 0) {
+            sent += 1;
+        }
+    }
+
+    if (!sent && err != NSAPI_ERROR_WOULD_BLOCK) {
+        return err;
+    }
+
+    return sent;
+}
+
+// Wait for the first answer to a round sent to servers, or for every
+// server to fail
+static int dns_recv_round(UDPSocket *socket, uint8_t *packet, uint16_t id, int servers,
+        nsapi_addr_t *addr, unsigned addr_count, uint32_t *ttl)
+{
+    unsigned start = equeue_tick();
+    int failed = 0;
+
+    while (failed < servers) {
+        unsigned elapsed = equeue_tick() - start;
+        if (elapsed >= DNS_TIMEOUT) {
+            break;
+        }
+
+        socket->set_timeout(DNS_TIMEOUT - elapsed);
+        int size = socket->recvfrom(NULL, packet, DNS_BUFFER_SIZE);
+        if (size == NSAPI_ERROR_WOULD_BLOCK) {
+            break;
+        } else if (size < 0) {
+            return size;
+        }
+
+        const uint8_t *response = packet;
+        int count = dns_scan_response(&response, size, id, addr, addr_count, ttl);
+        if (count > 0) {
+            return count;
+        } else if (count == 0) {
+            failed += 1;
+        }
+    }
+
+    return NSAPI_ERROR_DNS_FAILURE;
+}
+
 // core query function
 static int nsapi_dns_query_multiple(NetworkStack *stack, const char *host,
         nsapi_addr_t *addr, unsigned addr_count, nsapi_version_t version)
@@ -202,6 +465,22 @@ static int nsapi_dns_query_multiple(NetworkStack *stack, const char *host,
         return NSAPI_ERROR_PARAMETER;
     }
 
+    // single address lookups are answered from the cache
+    dns_mutex->lock();
+    dns_stats.queries += 1;
+    bool cached = (addr_count == 1) && dns_cache_find(host, version, addr);
+    if (cached) {
+        dns_stats.cache_hits += 1;
+    }
+    uint16_t id = dns_message_id++;
+    dns_mutex->unlock();
+
+    if (cached) {
+        return 1;
+    }
+
+    unsigned start = equeue_tick();
+
     // create a udp socket
     UDPSocket socket;
     int err = socket.open(stack);
@@ -209,43 +488,25 @@ static int nsapi_dns_query_multiple(NetworkStack *stack, const char *host,
         return err;
     }
 
-    socket.set_timeout(DNS_TIMEOUT);
-
     // create network packet
     uint8_t *packet = (uint8_t *)malloc(DNS_BUFFER_SIZE);
     if (!packet) {
         return NSAPI_ERROR_NO_MEMORY;
     }
 
-    int result = NSAPI_ERROR_OK;
+    int result = NSAPI_ERROR_DNS_FAILURE;
+    uint32_t ttl = 0;
 
-    // check against each dns server
-    for (unsigned i = 0; i < DNS_SERVERS_SIZE; i++) {
-        // send the question
-        uint8_t *question = packet;
-        dns_append_question(&question, host, version);
-
-        err = socket.sendto(SocketAddress(dns_servers[i], 53), packet, DNS_BUFFER_SIZE);
-        if (err == NSAPI_ERROR_WOULD_BLOCK) {
-            continue;
-        } else if (err < 0) {
-            result = err;
-            break;
-        }
-
-        // recv the response
-        err = socket.recvfrom(NULL, packet, DNS_BUFFER_SIZE);
-        if (err == NSAPI_ERROR_WOULD_BLOCK) {
-            continue;
-        } else if (err < 0) {
-            result = err;
+    // check against each round of dns servers
+    for (unsigned round = 0; round < DNS_ROUNDS; round++) {
+        int sent = dns_send_round(&socket, packet, id, host, version, round);
+        if (sent < 0) {
+            result = sent;
             break;
         }
 
-        const uint8_t *response = packet;
-        if (!dns_scan_response(&response, addr, addr_count)) {
-            result = NSAPI_ERROR_DNS_FAILURE;
-        } else {
+        result = dns_recv_round(&socket, packet, id, sent, addr, addr_count, &ttl);
+        if (result != NSAPI_ERROR_DNS_FAILURE) {
             break;
         }
     }
@@ -253,6 +514,10 @@ static int nsapi_dns_query_multiple(NetworkStack *stack, const char *host,
     // clean up packet
     free(packet);
 
+    dns_mutex->lock();
+    dns_record_result(host, result, addr, ttl, start);
+    dns_mutex->unlock();
+
     // clean up udp
     err = socket.close();
     if (err) {
@@ -263,6 +528,356 @@ static int nsapi_dns_query_multiple(NetworkStack *stack, const char *host,
     return result;
 }
 
+
+// Asynchronous queries, driven by events on the caller's event queue
+static void dns_query_async_start(int id);
+static void dns_query_async_recv(int id);
+static void dns_query_async_timeout(int id);
+static void dns_query_async_free(int id);
+
+struct dns_query {
+    int id;
+    NetworkStack *stack;
+    events::EventQueue *queue;
+    NetworkStack::hostbyname_cb_t callback;
+    char *host;
+    nsapi_version_t version;
+    UDPSocket socket;
+    uint16_t message_id;
+    unsigned round;
+    int servers;
+    int failed;
+    int timeout_event;
+    unsigned start;
+    bool resolved;
+    bool cancelled;
+    nsapi_addr_t addr;
+
+    void socket_event() {
+        queue->call(dns_query_async_recv, id);
+    }
+};
+
+static dns_query *dns_queries[MBED_CONF_NSAPI_DNS_MAX_ASYNC_QUERIES];
+static int dns_query_id = 1;
+
+// Must be called with dns_mutex held
+static dns_query *dns_query_remove(int id)
+{
+    for (unsigned i = 0; i < MBED_CONF_NSAPI_DNS_MAX_ASYNC_QUERIES; i++) {
+        if (dns_queries[i] && dns_queries[i]->id == id) {
+            dns_query *query = dns_queries[i];
+            dns_queries[i] = 0;
+            return query;
+        }
+    }
+
+    return 0;
+}
+
+// Must be called with dns_mutex held
+static dns_query *dns_query_find(int id)
+{
+    for (unsigned i = 0; i < MBED_CONF_NSAPI_DNS_MAX_ASYNC_QUERIES; i++) {
+        if (dns_queries[i] && dns_queries[i]->id == id) {
+            return dns_queries[i];
+        }
+    }
+
+    return 0;
+}
+
+// Free a query that has been removed from dns_queries
+static void dns_query_free(dns_query *query)
+{
+    if (query->timeout_event) {
+        query->queue->cancel(query->timeout_event);
+    }
+
+    query->socket.close();
+    free(query->host);
+    delete query;
+}
+
+// Find the query of an event, or return 0 if it has completed. A cancelled
+// query is freed here, on the event queue, rather than by
+// nsapi_dns_query_async_cancel, where it could be freed while one of its
+// events runs. Must be called with dns_mutex held.
+static dns_query *dns_query_event(int id)
+{
+    dns_query *query = dns_query_find(id);
+    if (query && query->cancelled) {
+        dns_query_remove(id);
+        dns_query_free(query);
+        return 0;
+    }
+
+    return query;
+}
+
+// Complete a query that has been removed from dns_queries
+static void dns_query_complete(dns_query *query, int result)
+{
+    SocketAddress address(query->addr);
+    NetworkStack::hostbyname_cb_t callback = query->callback;
+    dns_query_free(query);
+
+    callback(result > 0 ? 0 : result, result > 0 ? &address : NULL);
+}
+
+// Send the next round that reaches a server and start its timeout. Must be
+// called with dns_mutex held.
+static int dns_query_async_send(dns_query *query)
+{
+    uint8_t *packet = (uint8_t *)malloc(DNS_BUFFER_SIZE);
+    if (!packet) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    int err = NSAPI_ERROR_DNS_FAILURE;
+    while (query->round < DNS_ROUNDS) {
+        int sent = dns_send_round(&query->socket, packet, query->message_id,
+                query->host, query->version, query->round);
+        query->round += 1;
+
+        if (sent < 0) {
+            err = sent;
+            break;
+        } else if (sent > 0) {
+            query->servers = sent;
+            query->failed = 0;
+            query->timeout_event = query->queue->call_in(DNS_TIMEOUT,
+                    dns_query_async_timeout, query->id);
+            err = query->timeout_event ? 0 : NSAPI_ERROR_NO_MEMORY;
+            break;
+        }
+    }
+
+    free(packet);
+    return err;
+}
+
+static void dns_query_async_start(int id)
+{
+    dns_mutex->lock();
+    dns_query *query = dns_query_event(id);
+    if (!query) {
+        dns_mutex->unlock();
+        return;
+    }
+
+    int result = 1;
+    if (!query->resolved) {
+        result = query->socket.open(query->stack);
+        if (!result) {
+            query->socket.set_blocking(false);
+            query->socket.attach(mbed::callback(query, &dns_query::socket_event));
+            result = dns_query_async_send(query);
+        }
+
+        if (result < 0) {
+            dns_record_result(query->host, result, &query->addr, 0, query->start);
+        }
+    }
+
+    if (result != 0) {
+        dns_query_remove(id);
+    }
+    dns_mutex->unlock();
+
+    if (result != 0) {
+        dns_query_complete(query, result);
+    }
+}
+
+static void dns_query_async_recv(int id)
+{
+    dns_mutex->lock();
+    dns_query *query = dns_query_event(id);
+    uint8_t *packet = query ? (uint8_t *)malloc(DNS_BUFFER_SIZE) : 0;
+    if (!packet) {
+        // without memory the answer is left queued until the next event
+        dns_mutex->unlock();
+        return;
+    }
+
+    int result = 0;
+    while (result == 0) {
+        int size = query->socket.recvfrom(NULL, packet, DNS_BUFFER_SIZE);
+        if (size == NSAPI_ERROR_WOULD_BLOCK) {
+            break;
+        } else if (size < 0) {
+            result = size;
+            break;
+        }
+
+        const uint8_t *response = packet;
+        uint32_t ttl;
+        int count = dns_scan_response(&response, size, query->message_id, &query->addr, 1, &ttl);
+        if (count > 0) {
+            result = count;
+            dns_record_result(query->host, result, &query->addr, ttl, query->start);
+        } else if (count == 0) {
+            query->failed += 1;
+            if (query->failed >= query->servers) {
+                // every server of the round failed, move on without waiting
+                query->queue->cancel(query->timeout_event);
+                query->timeout_event = 0;
+                result = dns_query_async_send(query);
+            }
+        }
+    }
+
+    free(packet);
+
+    if (result < 0) {
+        dns_record_result(query->host, result, &query->addr, 0, query->start);
+    }
+    if (result != 0) {
+        dns_query_remove(id);
+    }
+    dns_mutex->unlock();
+
+    if (result != 0) {
+        dns_query_complete(query, result);
+    }
+}
+
+static void dns_query_async_timeout(int id)
+{
+    dns_mutex->lock();
+    dns_query *query = dns_query_event(id);
+    if (!query) {
+        dns_mutex->unlock();
+        return;
+    }
+
+    query->timeout_event = 0;
+    int result = dns_query_async_send(query);
+    if (result < 0) {
+        dns_record_result(query->host, result, &query->addr, 0, query->start);
+        dns_query_remove(id);
+    }
+    dns_mutex->unlock();
+
+    if (result < 0) {
+        dns_query_complete(query, result);
+    }
+}
+
+static void dns_query_async_free(int id)
+{
+    dns_mutex->lock();
+    dns_query_event(id);
+    dns_mutex->unlock();
+}
+
+int nsapi_dns_query_async(NetworkStack *stack, const char *host,
+        NetworkStack::hostbyname_cb_t callback, events::EventQueue *queue,
+        nsapi_version_t version)
+{
+    // check for valid host name
+    int host_len = host ? strlen(host) : 0;
+    if (host_len > 128 || host_len == 0 || !queue) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    dns_query *query = new dns_query;
+    query->host = (char *)malloc(host_len + 1);
+    if (!query->host) {
+        delete query;
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    strcpy(query->host, host);
+    query->stack = stack;
+    query->queue = queue;
+    query->callback = callback;
+    query->version = version;
+    query->round = 0;
+    query->servers = 0;
+    query->failed = 0;
+    query->timeout_event = 0;
+    query->start = equeue_tick();
+    query->resolved = false;
+    query->cancelled = false;
+
+    // literal addresses complete without a query
+    SocketAddress literal;
+    if (literal.set_ip_address(host)) {
+        if (literal.get_ip_version() != version) {
+            dns_query_free(query);
+            return NSAPI_ERROR_DNS_FAILURE;
+        }
+
+        query->addr = literal.get_addr();
+        query->resolved = true;
+    }
+
+    dns_mutex->lock();
+
+    if (!query->resolved) {
+        dns_stats.queries += 1;
+        if (dns_cache_find(host, version, &query->addr)) {
+            dns_stats.cache_hits += 1;
+            query->resolved = true;
+        }
+    }
+
+    int slot = -1;
+    for (unsigned i = 0; i < MBED_CONF_NSAPI_DNS_MAX_ASYNC_QUERIES; i++) {
+        if (!dns_queries[i]) {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot < 0) {
+        dns_mutex->unlock();
+        dns_query_free(query);
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    query->id = dns_query_id;
+    dns_query_id = (dns_query_id < 0x7fff) ? dns_query_id + 1 : 1;
+    query->message_id = dns_message_id++;
+    dns_queries[slot] = query;
+
+    int id = query->id;
+    dns_mutex->unlock();
+
+    if (!queue->call(dns_query_async_start, id)) {
+        dns_mutex->lock();
+        query = dns_query_remove(id);
+        dns_mutex->unlock();
+
+        if (query) {
+            dns_query_free(query);
+        }
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    return id;
+}
+
+int nsapi_dns_query_async_cancel(int id)
+{
+    dns_mutex->lock();
+    dns_query *query = dns_query_find(id);
+    if (!query || query->cancelled) {
+        dns_mutex->unlock();
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    // the query is freed by its next event, which is the start or timeout
+    // event already queued if there is no memory for another
+    query->cancelled = true;
+    query->queue->call(dns_query_async_free, id);
+    dns_mutex->unlock();
+
+    return 0;
+}
+
 // convenience functions for other forms of queries
 extern "C" int nsapi_dns_query_multiple(nsapi_stack_t *stack, const char *host,
         nsapi_addr_t *addr, unsigned addr_count, nsapi_version_t version)
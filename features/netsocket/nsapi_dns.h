@@ -25,6 +25,46 @@
 #include "netsocket/NetworkStack.h"
 #endif
 
+
+/** Statistics of the DNS resolver
+ */
+typedef struct nsapi_dns_stats {
+    unsigned queries;       /*!< Hostname lookups, including cache hits */
+    unsigned cache_hits;    /*!< Lookups answered from the cache */
+    unsigned resolved;      /*!< Lookups answered by a server */
+    unsigned failures;      /*!< Lookups no server could answer */
+    unsigned latency_total; /*!< Total time of lookups answered by a server in ms */
+    unsigned latency_max;   /*!< Longest lookup answered by a server in ms */
+} nsapi_dns_stats_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Get the statistics of the DNS resolver
+ *
+ *  The hit rate is cache_hits/queries and the mean resolution latency
+ *  is latency_total/resolved.
+ *
+ *  @param stats    Destination for the statistics
+ */
+void nsapi_dns_get_stats(nsapi_dns_stats_t *stats);
+
+/** Reset the statistics of the DNS resolver
+ */
+void nsapi_dns_reset_stats(void);
+
+/** Drop every cached hostname
+ *
+ *  Hostnames are cached until the TTL of their DNS records expires. The
+ *  cache should be flushed when the network changes.
+ */
+void nsapi_dns_cache_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
 #ifndef __cplusplus
 
 
@@ -148,6 +188,52 @@ int nsapi_dns_query_multiple(S *stack, const char *host,
                 host, addr, addr_count, version);
 }
 
+/** Query a domain name server for an IP address of a given hostname
+ *  without blocking
+ *
+ *  The query runs on the event queue, which must be dispatched, and
+ *  completes by calling callback from it. Cached hostnames and IP address
+ *  literals complete on the next dispatch without a network transaction.
+ *  Up to MBED_CONF_NSAPI_DNS_MAX_ASYNC_QUERIES queries may be in progress.
+ *
+ *  @param stack    Network stack as target for DNS query
+ *  @param host     Hostname to resolve
+ *  @param callback Callback called with the result of the query
+ *  @param queue    Event queue the query runs on
+ *  @param version  IP version to resolve (defaults to NSAPI_IPv4)
+ *  @return         Positive query id on success, negative error code on
+ *                  failure
+ */
+int nsapi_dns_query_async(NetworkStack *stack, const char *host,
+        NetworkStack::hostbyname_cb_t callback, events::EventQueue *queue,
+        nsapi_version_t version = NSAPI_IPv4);
+
+/** Query a domain name server for an IP address of a given hostname
+ *  without blocking
+ *
+ *  @see nsapi_dns_query_async
+ */
+template <typename S>
+int nsapi_dns_query_async(S *stack, const char *host,
+        NetworkStack::hostbyname_cb_t callback, events::EventQueue *queue,
+        nsapi_version_t version = NSAPI_IPv4)
+{
+    return nsapi_dns_query_async(nsapi_create_stack(stack),
+                host, callback, queue, version);
+}
+
+/** Cancel an asynchronous DNS query
+ *
+ *  The callback of the query is not called once the query is cancelled.
+ *  Must not be called while the event queue may be calling the callback.
+ *  The query's socket and memory are released later by the event queue.
+ *
+ *  @param id       Query id returned by nsapi_dns_query_async
+ *  @return         0 on success, NSAPI_ERROR_PARAMETER if the query has
+ *                  already completed
+ */
+int nsapi_dns_query_async_cancel(int id);
+
 /** Add a domain name server to list of servers to query
  *
  *  @param addr     Destination for the host address
@@ -127,6 +127,75 @@ typedef struct nsapi_addr {
  */
 typedef void *nsapi_socket_t;
 
+/** Maximum number of segments in a lent receive buffer
+ *
+ *  Stream data beyond the last segment is returned by the next receive,
+ *  datagrams are truncated.
+ */
+#ifndef NSAPI_RECV_BUFFER_SEGMENTS
+#define NSAPI_RECV_BUFFER_SEGMENTS 4
+#endif
+
+/** Contiguous segment of a lent receive buffer
+ */
+typedef struct nsapi_recv_segment {
+    const void *data;
+    unsigned size;
+} nsapi_recv_segment_t;
+
+/** Receive buffer lent by a network stack
+ *
+ *  Describes received data left in the stack's own memory as a list of
+ *  segments in order, so that it can be parsed in place. The data stays
+ *  valid until the buffer is released back to the stack.
+ */
+typedef struct nsapi_recv_buffer {
+    /** Segments of the received data, count of them valid
+     */
+    nsapi_recv_segment_t segments[NSAPI_RECV_BUFFER_SEGMENTS];
+    unsigned count;
+
+    /** Opaque handle for the stack's memory
+     */
+    void *handle;
+} nsapi_recv_buffer_t;
+
+/** Datagram in a batched send
+ */
+typedef struct nsapi_send_datagram {
+    /** Address of the destination host
+     */
+    nsapi_addr_t addr;
+    uint16_t port;
+
+    /** Payload to send
+     */
+    const void *data;
+    unsigned size;
+
+    /** Number of bytes sent
+     */
+    unsigned length;
+} nsapi_send_datagram_t;
+
+/** Datagram in a batched receive
+ */
+typedef struct nsapi_datagram {
+    /** Address of the source host
+     */
+    nsapi_addr_t addr;
+    uint16_t port;
+
+    /** Destination for the payload
+     */
+    void *data;
+    unsigned size;
+
+    /** Number of bytes received
+     */
+    unsigned length;
+} nsapi_datagram_t;
+
 
 /** Enum of socket protocols
  *
@@ -476,6 +545,113 @@ typedef struct nsapi_stack_api
      *  @return         0 on success, negative error code on failure
      */    
     int (*getsockopt)(nsapi_stack_t *stack, nsapi_socket_t socket, int level, int optname, void *optval, unsigned *optlen);
+
+    /** Send data over a TCP socket without copying it
+     *
+     *  Queues data for transmission by reference. Returns the number of
+     *  bytes queued from the buffer; those bytes must remain valid and
+     *  unmodified until the stack calls release. Release is called exactly
+     *  once for each call that returns a positive count, when the data has
+     *  been acknowledged by the remote host or the connection has failed
+     *  or been closed.
+     *
+     *  This call is non-blocking. If send would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param stack    Stack handle
+     *  @param socket   Socket handle
+     *  @param data     Buffer of data to send to the host
+     *  @param size     Size of the buffer in bytes
+     *  @param release  Function to call when the stack releases the buffer
+     *  @param context  Argument to pass to release
+     *  @return         Number of queued bytes on success, negative error
+     *                  code on failure
+     */
+    int (*socket_send_nocopy)(nsapi_stack_t *stack, nsapi_socket_t socket, const void *data, unsigned size, void (*release)(void *), void *context);
+
+    /** Receive data over a TCP socket without copying it
+     *
+     *  Lends the next received data to the caller in place. Returns the
+     *  number of bytes described by the buffer, which must be released
+     *  with socket_release_buffer.
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param stack    Stack handle
+     *  @param socket   Socket handle
+     *  @param buffer   Destination for the description of the data
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    int (*socket_recv_buffer)(nsapi_stack_t *stack, nsapi_socket_t socket, nsapi_recv_buffer_t *buffer);
+
+    /** Receive a packet over a UDP socket without copying it
+     *
+     *  Lends the next received datagram to the caller in place and stores
+     *  the source address in address. Returns the number of bytes described
+     *  by the buffer, which must be released with socket_release_buffer.
+     *
+     *  This call is non-blocking. If recvfrom would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param stack    Stack handle
+     *  @param socket   Socket handle
+     *  @param addr     Destination for the address of the remote host
+     *  @param port     Destination for the port of the remote host
+     *  @param buffer   Destination for the description of the data
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    int (*socket_recvfrom_buffer)(nsapi_stack_t *stack, nsapi_socket_t socket, nsapi_addr_t *addr, uint16_t *port, nsapi_recv_buffer_t *buffer);
+
+    /** Release a buffer lent by socket_recv_buffer or socket_recvfrom_buffer
+     *
+     *  The buffer may be released after the socket has been closed.
+     *
+     *  @param stack    Stack handle
+     *  @param socket   Socket handle
+     *  @param buffer   Buffer to release
+     */
+    void (*socket_release_buffer)(nsapi_stack_t *stack, nsapi_socket_t socket, nsapi_recv_buffer_t *buffer);
+
+    /** Send several packets over a UDP socket
+     *
+     *  Sends the datagrams in order, stopping at the first that can not be
+     *  sent, and stores the number of bytes sent in each datagram's length.
+     *  Returns the number of datagrams sent. A datagram larger than 65535
+     *  bytes is not sent and fails with NSAPI_ERROR_PARAMETER.
+     *
+     *  This call is non-blocking. If no datagram can be sent,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param stack     Stack handle
+     *  @param socket    Socket handle
+     *  @param datagrams Datagrams to send
+     *  @param count     Number of datagrams
+     *  @return          Number of datagrams sent on success, negative error
+     *                   code if the first datagram could not be sent
+     */
+    int (*socket_sendto_batch)(nsapi_stack_t *stack, nsapi_socket_t socket, nsapi_send_datagram_t *datagrams, unsigned count);
+
+    /** Receive several packets over a UDP socket
+     *
+     *  Receives datagrams until count have been received or none are left,
+     *  storing each payload in the datagram's data, its length in length
+     *  and its source in addr and port. Payloads larger than size are
+     *  truncated. Returns the number of datagrams received.
+     *
+     *  This call is non-blocking. If no datagram has been received,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param stack     Stack handle
+     *  @param socket    Socket handle
+     *  @param datagrams Destination for the datagrams
+     *  @param count     Maximum number of datagrams
+     *  @return          Number of datagrams received on success, negative
+     *                   error code if no datagram could be received
+     */
+    int (*socket_recvfrom_batch)(nsapi_stack_t *stack, nsapi_socket_t socket, nsapi_datagram_t *datagrams, unsigned count);
 } nsapi_stack_api_t;
 
 
@@ -0,0 +1,236 @@
+/*
+ * mbed Microcontroller Library
+ * Copyright (c) 2006-2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** @file delta_log.cpp Test cases to measure the bytes written to storage by
+ * drv->Flush() when a single KV changes, and to check the changes survive
+ * re-initialisation when the delta log is enabled.
+ *
+ * Please consult the documentation under the test-case functions for
+ * a description of the individual test case.
+ */
+
+#include "mbed.h"
+#include "cfstore_config.h"
+#include "cfstore_test.h"
+#include "cfstore_debug.h"
+#include "Driver_Common.h"
+#include "configuration_store.h"
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+#ifdef YOTTA_CFG_CFSTORE_UVISOR
+#include "uvisor-lib/uvisor-lib.h"
+#endif /* YOTTA_CFG_CFSTORE_UVISOR */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+using namespace utest::v1;
+
+static char cfstore_delta_log_utest_msg_g[CFSTORE_UTEST_MSG_BUF_SIZE];
+
+/* Configure secure box. */
+#ifdef YOTTA_CFG_CFSTORE_UVISOR
+UVISOR_BOX_NAMESPACE("com.arm.mbed.cfstore.test.delta_log.box1");
+UVISOR_BOX_CONFIG(cfstore_delta_log_box1, UVISOR_BOX_STACK_SIZE);
+#endif /* YOTTA_CFG_CFSTORE_UVISOR */
+
+/// @cond CFSTORE_DOXYGEN_DISABLE
+#define CFSTORE_DELTA_LOG_GREENTEA_TIMEOUT_S     120
+#define CFSTORE_DELTA_LOG_KEY_NAME_FMT           "com.arm.mbed.delta_log.key%04d"
+#define CFSTORE_DELTA_LOG_KEY_NAME_COUNTER       "com.arm.mbed.delta_log.counter"
+#define CFSTORE_DELTA_LOG_KEY_NAME_BUF_SIZE      40
+#define CFSTORE_DELTA_LOG_VALUE_BUF_SIZE         16
+#define CFSTORE_DELTA_LOG_NUM_KEYS               20
+#define CFSTORE_DELTA_LOG_REPEAT                 10
+/// @endcond
+
+
+/* report whether built/configured for flash sync or async mode */
+static control_t cfstore_delta_log_test_00(const size_t call_count)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+
+    (void) call_count;
+    ret = cfstore_test_startup();
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to perform test startup (ret=%d).\n", __func__, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+    return CaseNext;
+}
+
+
+/* @brief   flush and return the flush statistics afterwards */
+static void cfstore_delta_log_test_flush(ARM_CFSTORE_FLUSH_STATS* stats)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+    ARM_CFSTORE_DRIVER* drv = &cfstore_driver;
+
+    ret = drv->Flush();
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: Flush() call failed (ret=%d).\n", __func__, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+
+    ret = cfstore_get_flush_stats(stats);
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: cfstore_get_flush_stats() call failed (ret=%d).\n", __func__, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+}
+
+
+/** @brief  create CFSTORE_DELTA_LOG_NUM_KEYS KVs and a counter KV, then
+ *          repeatedly write the counter and flush, reporting the bytes
+ *          written to storage by each flush.
+ *
+ * With the delta log enabled each flush after the first should append only
+ * the counter KV. When built for flash the store is then re-initialised and
+ * the counter checked against the last value written.
+ *
+ * The test is skipped when the flash storage driver is asynchronous, as the
+ * delta log is not used in that configuration.
+ */
+static control_t cfstore_delta_log_test_01(const size_t call_count)
+{
+    char key_name[CFSTORE_DELTA_LOG_KEY_NAME_BUF_SIZE];
+    char value[CFSTORE_DELTA_LOG_VALUE_BUF_SIZE];
+    int32_t i = 0;
+    int32_t ret = ARM_DRIVER_ERROR;
+    size_t len = 0;
+    ARM_CFSTORE_DRIVER* drv = &cfstore_driver;
+#ifdef CFSTORE_CONFIG_BACKEND_FLASH_ENABLED
+    ARM_CFSTORE_CAPABILITIES caps;
+#endif /* CFSTORE_CONFIG_BACKEND_FLASH_ENABLED */
+    ARM_CFSTORE_KEYDESC kdesc;
+    ARM_CFSTORE_FLUSH_STATS stats;
+    ARM_CFSTORE_FLUSH_STATS prev_stats;
+    uint32_t full_bytes = 0;
+
+    (void) call_count;
+    CFSTORE_FENTRYLOG("%s:entered\r\n", __func__);
+#ifdef CFSTORE_CONFIG_BACKEND_FLASH_ENABLED
+    caps = drv->GetCapabilities();
+    if(caps.asynchronous_ops){
+        CFSTORE_LOG("%s:Warning: skipping test as the storage driver is asynchronous.\r\n", __func__);
+        return CaseNext;
+    }
+#endif /* CFSTORE_CONFIG_BACKEND_FLASH_ENABLED */
+    memset(&kdesc, 0, sizeof(kdesc));
+    kdesc.drl = ARM_RETENTION_NVM;
+
+    ret = drv->Initialize(NULL, NULL);
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: Initialize() call failed (ret=%d).\n", __func__, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+
+    ret = cfstore_test_delete_all();
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to delete all KVs (ret=%d).\n", __func__, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+
+    for(i = 0; i < CFSTORE_DELTA_LOG_NUM_KEYS; i++){
+        snprintf(key_name, CFSTORE_DELTA_LOG_KEY_NAME_BUF_SIZE, CFSTORE_DELTA_LOG_KEY_NAME_FMT, (int) i);
+        len = strlen(key_name);
+        ret = cfstore_test_create(key_name, key_name, &len, &kdesc);
+        CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to create KV (key_name=%s, ret=%d).\n", __func__, key_name, (int) ret);
+        TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+    }
+    snprintf(value, CFSTORE_DELTA_LOG_VALUE_BUF_SIZE, "%08d", 0);
+    len = strlen(value);
+    ret = cfstore_test_create(CFSTORE_DELTA_LOG_KEY_NAME_COUNTER, value, &len, &kdesc);
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to create KV (key_name=%s, ret=%d).\n", __func__, CFSTORE_DELTA_LOG_KEY_NAME_COUNTER, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+
+    cfstore_delta_log_test_flush(&prev_stats);
+    full_bytes = prev_stats.last_bytes;
+    printf("cfstore delta_log: initial flush wrote %d bytes\r\n", (int) full_bytes);
+
+    for(i = 1; i <= CFSTORE_DELTA_LOG_REPEAT; i++){
+        snprintf(value, CFSTORE_DELTA_LOG_VALUE_BUF_SIZE, "%08d", (int) i);
+        len = strlen(value);
+        ret = cfstore_test_write(CFSTORE_DELTA_LOG_KEY_NAME_COUNTER, value, &len);
+        CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to write KV (key_name=%s, ret=%d).\n", __func__, CFSTORE_DELTA_LOG_KEY_NAME_COUNTER, (int) ret);
+        TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+
+        cfstore_delta_log_test_flush(&stats);
+        printf("cfstore delta_log: flush %d wrote %d bytes (delta=%d, full=%d)\r\n", (int) i,
+                (int) stats.last_bytes, (int) stats.delta_count, (int) stats.full_count);
+#ifdef CFSTORE_CONFIG_DELTA_LOG_ENABLED
+        /* the delta log may be compacted by a full flush when it fills up */
+        CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: flush was neither a delta nor a full flush.\n", __func__);
+        TEST_ASSERT_MESSAGE(stats.delta_count + stats.full_count == prev_stats.delta_count + prev_stats.full_count + 1, cfstore_delta_log_utest_msg_g);
+        if(stats.delta_count > prev_stats.delta_count){
+            CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: delta flush wrote more than the first full flush (%d >= %d).\n", __func__, (int) stats.last_bytes, (int) full_bytes);
+            TEST_ASSERT_MESSAGE(stats.last_bytes < full_bytes, cfstore_delta_log_utest_msg_g);
+        }
+#endif /* CFSTORE_CONFIG_DELTA_LOG_ENABLED */
+        prev_stats = stats;
+    }
+
+#ifdef CFSTORE_CONFIG_BACKEND_FLASH_ENABLED
+    ret = drv->Uninitialize();
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: Uninitialize() call failed (ret=%d).\n", __func__, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+
+    ret = drv->Initialize(NULL, NULL);
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: Initialize() call failed (ret=%d).\n", __func__, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+
+    len = CFSTORE_DELTA_LOG_VALUE_BUF_SIZE;
+    memset(value, 0, CFSTORE_DELTA_LOG_VALUE_BUF_SIZE);
+    ret = cfstore_test_read(CFSTORE_DELTA_LOG_KEY_NAME_COUNTER, value, &len);
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to read KV (key_name=%s, ret=%d).\n", __func__, CFSTORE_DELTA_LOG_KEY_NAME_COUNTER, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: counter not restored (value=%s).\n", __func__, value);
+    TEST_ASSERT_MESSAGE(atoi(value) == CFSTORE_DELTA_LOG_REPEAT, cfstore_delta_log_utest_msg_g);
+#endif /* CFSTORE_CONFIG_BACKEND_FLASH_ENABLED */
+
+    ret = cfstore_test_delete_all();
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to delete all KVs (ret=%d).\n", __func__, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+
+    ret = drv->Flush();
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: Flush() call failed (ret=%d).\n", __func__, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+
+    ret = drv->Uninitialize();
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_delta_log_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: Uninitialize() call failed (ret=%d).\n", __func__, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_delta_log_utest_msg_g);
+    return CaseNext;
+}
+
+
+/// @cond CFSTORE_DOXYGEN_DISABLE
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(CFSTORE_DELTA_LOG_GREENTEA_TIMEOUT_S, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+           /*          1         2         3         4         5         6        7  */
+           /* 1234567890123456789012345678901234567890123456789012345678901234567890 */
+        Case("DELTA_LOG_test_00", cfstore_delta_log_test_00),
+        Case("DELTA_LOG_test_01", cfstore_delta_log_test_01),
+};
+
+
+/* Declare your test specification with a custom setup handler */
+Specification specification(greentea_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+/// @endcond
@@ -0,0 +1,216 @@
+/*
+ * mbed Microcontroller Library
+ * Copyright (c) 2006-2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/** @file index.cpp Test cases to benchmark the drv->Open() and drv->Find()
+ * latency as the number of KVs in the CFSTORE grows.
+ *
+ * Please consult the documentation under the test-case functions for
+ * a description of the individual test case.
+ */
+
+#include "mbed.h"
+#include "cfstore_config.h"
+#include "cfstore_test.h"
+#include "cfstore_debug.h"
+#include "Driver_Common.h"
+#include "configuration_store.h"
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+#include "cfstore_utest.h"
+#ifdef YOTTA_CFG_CFSTORE_UVISOR
+#include "uvisor-lib/uvisor-lib.h"
+#endif /* YOTTA_CFG_CFSTORE_UVISOR */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+using namespace utest::v1;
+
+static char cfstore_index_utest_msg_g[CFSTORE_UTEST_MSG_BUF_SIZE];
+
+/* Configure secure box. */
+#ifdef YOTTA_CFG_CFSTORE_UVISOR
+UVISOR_BOX_NAMESPACE("com.arm.mbed.cfstore.test.index.box1");
+UVISOR_BOX_CONFIG(cfstore_index_box1, UVISOR_BOX_STACK_SIZE);
+#endif /* YOTTA_CFG_CFSTORE_UVISOR */
+
+/// @cond CFSTORE_DOXYGEN_DISABLE
+#ifdef CFSTORE_DEBUG
+#define CFSTORE_INDEX_GREENTEA_TIMEOUT_S     360
+#else
+#define CFSTORE_INDEX_GREENTEA_TIMEOUT_S     120
+#endif
+#define CFSTORE_INDEX_KEY_NAME_FMT           "com.arm.mbed.index.key%04d"
+#define CFSTORE_INDEX_KEY_NAME_QUERY         "com.arm.mbed.index.*"
+#define CFSTORE_INDEX_KEY_NAME_BUF_SIZE      32
+#define CFSTORE_INDEX_REPEAT                 100
+/// @endcond
+
+
+/* report whether built/configured for flash sync or async mode */
+static control_t cfstore_index_test_00(const size_t call_count)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+
+    (void) call_count;
+    ret = cfstore_test_startup();
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_index_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to perform test startup (ret=%d).\n", __func__, (int) ret);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_index_utest_msg_g);
+    return CaseNext;
+}
+
+
+/** @brief  create num_keys KVs, then time Open()/Close(), Find() with an exact
+ *          key name and Find() with a prefix query over them.
+ *
+ * Creation stops early if the target runs out of memory, in which case the
+ * timings are reported for the KVs that were created.
+ */
+static void cfstore_index_test_ex(int32_t num_keys)
+{
+    char key_name[CFSTORE_INDEX_KEY_NAME_BUF_SIZE];
+    char* value = (char*) "value";
+    int32_t i = 0;
+    int32_t j = 0;
+    int32_t count = 0;
+    int32_t ret = ARM_DRIVER_ERROR;
+    ARM_CFSTORE_SIZE len = 0;
+    ARM_CFSTORE_DRIVER* drv = &cfstore_driver;
+    ARM_CFSTORE_KEYDESC kdesc;
+    ARM_CFSTORE_FMODE flags;
+    ARM_CFSTORE_HANDLE_INIT(hkey);
+    ARM_CFSTORE_HANDLE_INIT(prev);
+    ARM_CFSTORE_HANDLE_INIT(next);
+    Timer timer;
+    int open_us = 0;
+    int find_us = 0;
+    int find_query_us = 0;
+
+    CFSTORE_FENTRYLOG("%s:entered\r\n", __func__);
+    memset(&kdesc, 0, sizeof(kdesc));
+    memset(&flags, 0, sizeof(flags));
+
+    for(count = 0; count < num_keys; count++){
+        snprintf(key_name, CFSTORE_INDEX_KEY_NAME_BUF_SIZE, CFSTORE_INDEX_KEY_NAME_FMT, (int) count);
+        len = strlen(value);
+        ret = cfstore_test_create(key_name, value, &len, &kdesc);
+        if(ret == ARM_CFSTORE_DRIVER_ERROR_OUT_OF_MEMORY){
+            CFSTORE_LOG("%s:Warning: out of memory after creating %d of %d KVs.\r\n", __func__, (int) count, (int) num_keys);
+            break;
+        }
+        CFSTORE_TEST_UTEST_MESSAGE(cfstore_index_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to create KV (key_name=%s, ret=%d).\n", __func__, key_name, (int) ret);
+        TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_index_utest_msg_g);
+    }
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_index_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: no KVs created.\n", __func__);
+    TEST_ASSERT_MESSAGE(count > 0, cfstore_index_utest_msg_g);
+
+    /* spread the lookups evenly across the area */
+    timer.start();
+    for(i = 0; i < CFSTORE_INDEX_REPEAT; i++){
+        j = (i * 7919) % count;
+        snprintf(key_name, CFSTORE_INDEX_KEY_NAME_BUF_SIZE, CFSTORE_INDEX_KEY_NAME_FMT, (int) j);
+
+        int start = timer.read_us();
+        ret = drv->Open(key_name, flags, hkey);
+        CFSTORE_TEST_UTEST_MESSAGE(cfstore_index_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to open KV (key_name=%s, ret=%d).\n", __func__, key_name, (int) ret);
+        TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_index_utest_msg_g);
+        drv->Close(hkey);
+        open_us += timer.read_us() - start;
+
+        start = timer.read_us();
+        ret = drv->Find(key_name, prev, next);
+        CFSTORE_TEST_UTEST_MESSAGE(cfstore_index_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to find KV (key_name=%s, ret=%d).\n", __func__, key_name, (int) ret);
+        TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_index_utest_msg_g);
+        drv->Close(next);
+        find_us += timer.read_us() - start;
+
+        start = timer.read_us();
+        ret = drv->Find(CFSTORE_INDEX_KEY_NAME_QUERY, prev, next);
+        CFSTORE_TEST_UTEST_MESSAGE(cfstore_index_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: failed to find KV (key_name_query=%s, ret=%d).\n", __func__, CFSTORE_INDEX_KEY_NAME_QUERY, (int) ret);
+        TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_index_utest_msg_g);
+        drv->Close(next);
+        find_query_us += timer.read_us() - start;
+    }
+    timer.stop();
+
+    printf("cfstore index: %d KVs, open+close %d us, find %d us, find \"%s\" %d us\r\n",
+            (int) count, open_us / CFSTORE_INDEX_REPEAT, find_us / CFSTORE_INDEX_REPEAT,
+            CFSTORE_INDEX_KEY_NAME_QUERY, find_query_us / CFSTORE_INDEX_REPEAT);
+
+    ret = drv->Uninitialize();
+    CFSTORE_TEST_UTEST_MESSAGE(cfstore_index_utest_msg_g, CFSTORE_UTEST_MSG_BUF_SIZE, "%s:Error: Uninitialize() call failed.\n", __func__);
+    TEST_ASSERT_MESSAGE(ret >= ARM_DRIVER_OK, cfstore_index_utest_msg_g);
+}
+
+
+/** @brief  benchmark with 10 KVs */
+static control_t cfstore_index_test_01_end(const size_t call_count)
+{
+    (void) call_count;
+    cfstore_index_test_ex(10);
+    return CaseNext;
+}
+
+/** @brief  benchmark with 100 KVs */
+static control_t cfstore_index_test_02_end(const size_t call_count)
+{
+    (void) call_count;
+    cfstore_index_test_ex(100);
+    return CaseNext;
+}
+
+/** @brief  benchmark with 1000 KVs */
+static control_t cfstore_index_test_03_end(const size_t call_count)
+{
+    (void) call_count;
+    cfstore_index_test_ex(1000);
+    return CaseNext;
+}
+
+
+/// @cond CFSTORE_DOXYGEN_DISABLE
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(CFSTORE_INDEX_GREENTEA_TIMEOUT_S, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+           /*          1         2         3         4         5         6        7  */
+           /* 1234567890123456789012345678901234567890123456789012345678901234567890 */
+        Case("INDEX_test_00", cfstore_index_test_00),
+        Case("INDEX_test_01_start", cfstore_utest_default_start),
+        Case("INDEX_test_01_end", cfstore_index_test_01_end),
+        Case("INDEX_test_02_start", cfstore_utest_default_start),
+        Case("INDEX_test_02_end", cfstore_index_test_02_end),
+        Case("INDEX_test_03_start", cfstore_utest_default_start),
+        Case("INDEX_test_03_end", cfstore_index_test_03_end),
+};
+
+
+/* Declare your test specification with a custom setup handler */
+Specification specification(greentea_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+/// @endcond
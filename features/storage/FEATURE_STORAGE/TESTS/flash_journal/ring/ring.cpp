@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2006-2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file ring.cpp Test cases for the ring flash journal, and a benchmark
+ * comparing its initialization time and write amplification with those of
+ * the sequential journal.
+ *
+ * The test cases expect the storage driver to complete synchronously; they
+ * are skipped otherwise.
+ */
+
+#ifdef TARGET_LIKE_POSIX
+#define AVOID_GREENTEA
+#endif
+
+#ifndef AVOID_GREENTEA
+#include "greentea-client/test_env.h"
+#endif
+#include "utest/utest.h"
+#include "unity/unity.h"
+
+#include "mbed.h"
+#include "flash-journal-strategy-ring/flash_journal_strategy_ring.h"
+#include "flash-journal-strategy-ring/flash_journal_ring_private.h"
+#include "flash-journal-strategy-sequential/flash_journal_strategy_sequential.h"
+#include <string.h>
+#include <inttypes.h>
+
+using namespace utest::v1;
+
+extern ARM_DRIVER_STORAGE ARM_Driver_Storage_MTD_K64F;
+ARM_DRIVER_STORAGE *drv = &ARM_Driver_Storage_MTD_K64F;
+
+FlashJournal_t      journal;
+
+static const size_t BUFFER_SIZE = 8192;
+static uint8_t      buffer[BUFFER_SIZE];
+static uint8_t      readBuffer[BUFFER_SIZE];
+
+/* number of small commits made by the benchmark, and the size of each */
+static const size_t BENCHMARK_COMMITS      = 16;
+static const size_t SIZEOF_BENCHMARK_WRITE = 16;
+static const size_t BENCHMARK_MOUNTS       = 8;
+
+
+/*
+ * A storage driver forwarding to the MTD, counting the traffic on its way.
+ */
+static struct {
+    uint32_t reads;
+    uint64_t readBytes;
+    uint64_t programBytes;
+    uint64_t eraseBytes;
+} counters;
+
+static ARM_DRIVER_VERSION counting_GetVersion(void)
+{
+    return drv->GetVersion();
+}
+
+static ARM_STORAGE_CAPABILITIES counting_GetCapabilities(void)
+{
+    return drv->GetCapabilities();
+}
+
+static int32_t counting_Initialize(ARM_Storage_Callback_t callback)
+{
+    return drv->Initialize(callback);
+}
+
+static int32_t counting_Uninitialize(void)
+{
+    return drv->Uninitialize();
+}
+
+static int32_t counting_PowerControl(ARM_POWER_STATE state)
+{
+    return drv->PowerControl(state);
+}
+
+static int32_t counting_ReadData(uint64_t addr, void *data, uint32_t size)
+{
+    int32_t rc = drv->ReadData(addr, data, size);
+    if (rc > ARM_DRIVER_OK) {
+        counters.reads++;
+        counters.readBytes += rc;
+    }
+    return rc;
+}
+
+static int32_t counting_ProgramData(uint64_t addr, const void *data, uint32_t size)
+{
+    int32_t rc = drv->ProgramData(addr, data, size);
+    if (rc > ARM_DRIVER_OK) {
+        counters.programBytes += rc;
+    }
+    return rc;
+}
+
+static int32_t counting_Erase(uint64_t addr, uint32_t size)
+{
+    int32_t rc = drv->Erase(addr, size);
+    if (rc > ARM_DRIVER_OK) {
+        counters.eraseBytes += rc;
+    }
+    return rc;
+}
+
+static int32_t counting_EraseAll(void)
+{
+    return drv->EraseAll();
+}
+
+static ARM_STORAGE_STATUS counting_GetStatus(void)
+{
+    return drv->GetStatus();
+}
+
+static int32_t counting_GetInfo(ARM_STORAGE_INFO *info)
+{
+    return drv->GetInfo(info);
+}
+
+static uint32_t counting_ResolveAddress(uint64_t addr)
+{
+    return drv->ResolveAddress(addr);
+}
+
+static int32_t counting_GetNextBlock(const ARM_STORAGE_BLOCK* prevBlock, ARM_STORAGE_BLOCK *nextBlock)
+{
+    return drv->GetNextBlock(prevBlock, nextBlock);
+}
+
+static int32_t counting_GetBlock(uint64_t addr, ARM_STORAGE_BLOCK *block)
+{
+    return drv->GetBlock(addr, block);
+}
+
+ARM_DRIVER_STORAGE countingDrv = {
+    counting_GetVersion,
+    counting_GetCapabilities,
+    counting_Initialize,
+    counting_Uninitialize,
+    counting_PowerControl,
+    counting_ReadData,
+    counting_ProgramData,
+    counting_Erase,
+    counting_EraseAll,
+    counting_GetStatus,
+    counting_GetInfo,
+    counting_ResolveAddress,
+    counting_GetNextBlock,
+    counting_GetBlock
+};
+
+static void fillPattern(uint8_t *data, size_t size, uint32_t seed)
+{
+    for (size_t i = 0; i < size; i++) {
+        data[i] = (uint8_t)(seed * 31 + i * 7 + (i >> 8));
+    }
+}
+
+static bool skipIfAsynchronous(const char *func)
+{
+    if (drv->GetCapabilities().asynchronous_ops) {
+        printf("%s: skipping test as the storage driver is asynchronous.\n", func);
+        return true;
+    }
+    return false;
+}
+
+/* Log a blob in chunks of at most chunkSize (a multiple of program_unit) and commit it. */
+static void logAndCommit(const uint8_t *blob, size_t size, size_t chunkSize)
+{
+    int32_t rc;
+    size_t offset = 0;
+
+    while (offset < size) {
+        size_t xfer = ((size - offset) < chunkSize) ? (size - offset) : chunkSize;
+        rc = FlashJournal_log(&journal, blob + offset, xfer);
+        TEST_ASSERT(rc > JOURNAL_STATUS_OK);
+        offset += rc;
+    }
+    rc = FlashJournal_commit(&journal);
+    TEST_ASSERT_EQUAL(1, rc);
+}
+
+/* Read back the most recently committed blob and check it against a pattern. */
+static void verifyBlob(size_t size, uint32_t seed)
+{
+    int32_t rc;
+    FlashJournal_Info_t info;
+
+    rc = FlashJournal_getInfo(&journal, &info);
+    TEST_ASSERT_EQUAL(JOURNAL_STATUS_OK, rc);
+    TEST_ASSERT_EQUAL(size, info.sizeofJournaledBlob);
+
+    fillPattern(buffer, size, seed);
+    rc = FlashJournal_read(&journal, readBuffer, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(size, rc);
+    TEST_ASSERT_EQUAL(0, memcmp(buffer, readBuffer, size));
+}
+
+static void initializeRing(void)
+{
+    int32_t rc = FlashJournal_initialize(&journal, drv, &FLASH_JOURNAL_STRATEGY_RING, NULL);
+    TEST_ASSERT_EQUAL(1, rc);
+}
+
+control_t test_formatAndInitialize(const size_t call_count)
+{
+    int32_t rc;
+    FlashJournal_Info_t info;
+
+    if (skipIfAsynchronous(__func__)) {
+        return CaseNext;
+    }
+
+    rc = flashJournalStrategyRing_format(drv, 4 /* checkpointInterval */, NULL);
+    TEST_ASSERT_EQUAL(1, rc);
+    initializeRing();
+
+    rc = FlashJournal_getInfo(&journal, &info);
+    TEST_ASSERT_EQUAL(JOURNAL_STATUS_OK, rc);
+    TEST_ASSERT(info.capacity >= BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(0, info.sizeofJournaledBlob);
+
+    rc = FlashJournal_read(&journal, readBuffer, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(JOURNAL_STATUS_EMPTY, rc);
+
+    return CaseNext;
+}
+
+control_t test_logCommitAndRead(const size_t call_count)
+{
+    int32_t rc;
+    FlashJournal_Info_t info;
+
+    if (skipIfAsynchronous(__func__)) {
+        return CaseNext;
+    }
+
+    rc = FlashJournal_getInfo(&journal, &info);
+    TEST_ASSERT_EQUAL(JOURNAL_STATUS_OK, rc);
+
+    /* requests smaller than program_unit, or beyond capacity, are rejected */
+    if (info.program_unit > 1) {
+        rc = FlashJournal_log(&journal, buffer, info.program_unit - 1);
+        TEST_ASSERT_EQUAL(JOURNAL_STATUS_SMALL_LOG_REQUEST, rc);
+    }
+    rc = FlashJournal_log(&journal, buffer, info.capacity + 1);
+    TEST_ASSERT_EQUAL(JOURNAL_STATUS_BOUNDED_CAPACITY, rc);
+
+    /* commit without logs leaves an empty blob */
+    rc = FlashJournal_commit(&journal);
+    TEST_ASSERT_EQUAL(1, rc);
+    rc = FlashJournal_read(&journal, readBuffer, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(JOURNAL_STATUS_EMPTY, rc);
+
+    fillPattern(buffer, BUFFER_SIZE, 1);
+    logAndCommit(buffer, BUFFER_SIZE, 1024);
+    verifyBlob(BUFFER_SIZE, 1);
+
+    /* readFrom the second half */
+    rc = FlashJournal_readFrom(&journal, BUFFER_SIZE / 2, readBuffer, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(BUFFER_SIZE / 2, rc);
+    TEST_ASSERT_EQUAL(0, memcmp(buffer + BUFFER_SIZE / 2, readBuffer, BUFFER_SIZE / 2));
+
+    /* the blob survives re-initialization */
+    initializeRing();
+    verifyBlob(BUFFER_SIZE, 1);
+
+    return CaseNext;
+}
+
+/* Commit enough blobs to wrap around the ring, re-initializing along the way. */
+control_t test_wrapAround(const size_t call_count)
+{
+    int32_t rc;
+    ARM_STORAGE_INFO mtdInfo;
+
+    if (skipIfAsynchronous(__func__)) {
+        return CaseNext;
+    }
+
+    rc = drv->GetInfo(&mtdInfo);
+    TEST_ASSERT_EQUAL(ARM_DRIVER_OK, rc);
+
+    size_t numCommits = 2 * (mtdInfo.total_storage / (BUFFER_SIZE / 2));
+    for (size_t i = 0; i < numCommits; i++) {
+        /* alternate between large and small blobs to vary record alignment */
+        size_t size = (i % 3) ? (BUFFER_SIZE / 2) : 24;
+        fillPattern(buffer, size, i);
+        logAndCommit(buffer, size, 512);
+
+        if ((i % 17) == 0) {
+            initializeRing();
+        }
+        verifyBlob(size, i);
+    }
+
+    return CaseNext;
+}
+
+control_t test_resetAndInitialize(const size_t call_count)
+{
+    int32_t rc;
+    FlashJournal_Info_t info;
+
+    if (skipIfAsynchronous(__func__)) {
+        return CaseNext;
+    }
+
+    rc = FlashJournal_reset(&journal);
+    TEST_ASSERT_EQUAL(1, rc);
+    rc = FlashJournal_getInfo(&journal, &info);
+    TEST_ASSERT_EQUAL(JOURNAL_STATUS_OK, rc);
+    TEST_ASSERT_EQUAL(0, info.sizeofJournaledBlob);
+
+    initializeRing();
+    rc = FlashJournal_getInfo(&journal, &info);
+    TEST_ASSERT_EQUAL(JOURNAL_STATUS_OK, rc);
+    TEST_ASSERT_EQUAL(0, info.sizeofJournaledBlob);
+
+    fillPattern(buffer, 64, 2);
+    logAndCommit(buffer, 64, 64);
+    initializeRing();
+    verifyBlob(64, 2);
+
+    return CaseNext;
+}
+
+/**
+ * Make BENCHMARK_COMMITS small commits through the counting driver, then
+ * measure initialization. Write amplification is the number of bytes
+ * programmed and erased per byte of payload committed.
+ */
+static void benchmark(const char *name, const FlashJournal_Ops_t *ops, uint64_t *amplificationP, uint32_t *mountReadsP)
+{
+    int32_t rc;
+    Timer timer;
+
+    rc = FlashJournal_initialize(&journal, &countingDrv, ops, NULL);
+    TEST_ASSERT_EQUAL(1, rc);
+
+    memset(&counters, 0, sizeof(counters));
+    for (size_t i = 0; i < BENCHMARK_COMMITS; i++) {
+        fillPattern(buffer, SIZEOF_BENCHMARK_WRITE, i);
+        logAndCommit(buffer, SIZEOF_BENCHMARK_WRITE, SIZEOF_BENCHMARK_WRITE);
+    }
+    uint64_t payload = BENCHMARK_COMMITS * SIZEOF_BENCHMARK_WRITE;
+    uint64_t programBytes = counters.programBytes;
+    uint64_t eraseBytes = counters.eraseBytes;
+
+    memset(&counters, 0, sizeof(counters));
+    timer.start();
+    for (size_t i = 0; i < BENCHMARK_MOUNTS; i++) {
+        rc = FlashJournal_initialize(&journal, &countingDrv, ops, NULL);
+        TEST_ASSERT_EQUAL(1, rc);
+    }
+    timer.stop();
+    verifyBlob(SIZEOF_BENCHMARK_WRITE, BENCHMARK_COMMITS - 1);
+
+    *amplificationP = (programBytes + eraseBytes) / payload;
+    *mountReadsP = counters.reads / BENCHMARK_MOUNTS;
+    printf("%s: %u commits of %u bytes: programmed %" PRIu64 " bytes, erased %" PRIu64 " bytes (amplification %" PRIu64 "x); "
+           "initialize: %d us, %" PRIu32 " reads, %" PRIu64 " bytes read\n",
+           name, (unsigned)BENCHMARK_COMMITS, (unsigned)SIZEOF_BENCHMARK_WRITE, programBytes, eraseBytes, *amplificationP,
+           timer.read_us() / (int)BENCHMARK_MOUNTS, *mountReadsP, counters.readBytes / BENCHMARK_MOUNTS);
+}
+
+control_t test_benchmark(const size_t call_count)
+{
+    int32_t rc;
+    uint64_t sequentialAmplification;
+    uint64_t ringAmplification;
+    uint32_t sequentialMountReads;
+    uint32_t ringMountReads;
+
+    if (skipIfAsynchronous(__func__)) {
+        return CaseNext;
+    }
+
+    rc = flashJournalStrategySequential_format(drv, 4 /* numSlots */, NULL);
+    TEST_ASSERT_EQUAL(1, rc);
+    benchmark("sequential", &FLASH_JOURNAL_STRATEGY_SEQUENTIAL, &sequentialAmplification, &sequentialMountReads);
+
+    rc = flashJournalStrategyRing_format(drv, 0 /* default checkpointInterval */, NULL);
+    TEST_ASSERT_EQUAL(1, rc);
+    benchmark("ring", &FLASH_JOURNAL_STRATEGY_RING, &ringAmplification, &ringMountReads);
+
+    TEST_ASSERT(ringAmplification < sequentialAmplification);
+
+    /* initialization reads the header, binary searches the checkpoints and
+     * scans at most a checkpoint interval's worth of records */
+    TEST_ASSERT(ringMountReads <= 1 + 2 + 16 + 2 * (RING_FLASH_JOURNAL_DEFAULT_CHECKPOINT_INTERVAL + 1));
+
+    return CaseNext;
+}
+
+#ifndef AVOID_GREENTEA
+// Custom setup handler required for proper Greentea support
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(300, "default_auto");
+    // Call the default reporting function
+    return greentea_test_setup_handler(number_of_cases);
+}
+#else
+status_t default_setup(const size_t)
+{
+    return STATUS_CONTINUE;
+}
+#endif
+
+// Specify all your test cases here
+Case cases[] = {
+    Case("format and initialize",                       test_formatAndInitialize),
+    Case("log, commit and read",                        test_logCommitAndRead),
+    Case("wrap around the ring",                        test_wrapAround),
+    Case("reset and initialize",                        test_resetAndInitialize),
+    Case("benchmark against the sequential journal",    test_benchmark),
+};
+
+// Declare your test specification with a custom setup handler
+#ifndef AVOID_GREENTEA
+Specification specification(greentea_setup, cases);
+#else
+Specification specification(default_setup, cases);
+#endif
+
+int main(int argc, char** argv)
+{
+    // Run the test specification
+    Harness::run(specification);
+}
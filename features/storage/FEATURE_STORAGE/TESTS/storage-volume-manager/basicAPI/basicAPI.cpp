@@ -87,6 +87,28 @@ void virtualMTDCallbackHandler(int32_t status, ARM_STORAGE_OPERATION operation)
     Harness::validate_callback();
 }
 
+/* callback handlers for two volumes with operations outstanding at the same time */
+static int32_t  queuedCallbackStatus[2];
+static unsigned queuedCallbackCount;
+
+void queuedCallbackHandler1(int32_t status, ARM_STORAGE_OPERATION operation)
+{
+    tr_info("in queuedCallbackHandler1");
+    queuedCallbackStatus[0] = status;
+    if (++queuedCallbackCount == 2) {
+        Harness::validate_callback();
+    }
+}
+
+void queuedCallbackHandler2(int32_t status, ARM_STORAGE_OPERATION operation)
+{
+    tr_info("in queuedCallbackHandler2");
+    queuedCallbackStatus[1] = status;
+    if (++queuedCallbackCount == 2) {
+        Harness::validate_callback();
+    }
+}
+
 control_t test_initialize(const size_t call_count)
 {
     tr_info("test_initialize: called with call_count %lu", call_count);
@@ -800,12 +822,10 @@ control_t test_concurrentAccessFromTwoVolumes(const size_t call_count)
                 status = volume1P->GetStatus();
                 TEST_ASSERT_EQUAL(1, status.busy);
                 TEST_ASSERT_EQUAL(0, status.error);
-                status = volume2P->GetStatus();
-                TEST_ASSERT_EQUAL(1, status.busy);
+                status = volume2P->GetStatus(); /* the other volume has nothing pending; it could queue an operation. */
+                TEST_ASSERT_EQUAL(0, status.busy);
                 TEST_ASSERT_EQUAL(0, status.error);
 
-                rc = volume2P->ProgramData(0, buffer, sizeofDataOperation);
-                TEST_ASSERT_EQUAL(ARM_DRIVER_ERROR_BUSY, rc);
                 rc = volume1P->ProgramData(0, buffer, sizeofDataOperation);
                 TEST_ASSERT_EQUAL(ARM_DRIVER_ERROR_BUSY, rc);
                 rc = volume1P->ReadData(0, buffer, sizeofDataOperation);
@@ -850,12 +870,10 @@ control_t test_concurrentAccessFromTwoVolumes(const size_t call_count)
                 status = volume2P->GetStatus();
                 TEST_ASSERT_EQUAL(1, status.busy);
                 TEST_ASSERT_EQUAL(0, status.error);
-                status = volume1P->GetStatus();
-                TEST_ASSERT_EQUAL(1, status.busy);
+                status = volume1P->GetStatus(); /* the other volume has nothing pending; it could queue an operation. */
+                TEST_ASSERT_EQUAL(0, status.busy);
                 TEST_ASSERT_EQUAL(0, status.error);
 
-                rc = volume1P->ProgramData(0, buffer, sizeofDataOperation);
-                TEST_ASSERT_EQUAL(ARM_DRIVER_ERROR_BUSY, rc);
                 rc = volume2P->ProgramData(0, buffer, sizeofDataOperation);
                 TEST_ASSERT_EQUAL(ARM_DRIVER_ERROR_BUSY, rc);
                 rc = volume2P->ReadData(0, buffer, sizeofDataOperation);
@@ -1063,12 +1081,10 @@ control_t test_concurrentAccessFromTwoCStorageDevices(const size_t call_count)
                 status = mtd1.GetStatus();
                 TEST_ASSERT_EQUAL(1, status.busy);
                 TEST_ASSERT_EQUAL(0, status.error);
-                status = mtd2.GetStatus();
-                TEST_ASSERT_EQUAL(1, status.busy);
+                status = mtd2.GetStatus(); /* the other volume has nothing pending; it could queue an operation. */
+                TEST_ASSERT_EQUAL(0, status.busy);
                 TEST_ASSERT_EQUAL(0, status.error);
 
-                rc = mtd2.ProgramData(0, buffer, sizeofDataOperation);
-                TEST_ASSERT_EQUAL(ARM_DRIVER_ERROR_BUSY, rc);
                 rc = mtd1.ProgramData(0, buffer, sizeofDataOperation);
                 TEST_ASSERT_EQUAL(ARM_DRIVER_ERROR_BUSY, rc);
                 rc = mtd1.ReadData(0, buffer, sizeofDataOperation);
@@ -1113,12 +1129,10 @@ control_t test_concurrentAccessFromTwoCStorageDevices(const size_t call_count)
                 status = mtd2.GetStatus();
                 TEST_ASSERT_EQUAL(1, status.busy);
                 TEST_ASSERT_EQUAL(0, status.error);
-                status = mtd1.GetStatus();
-                TEST_ASSERT_EQUAL(1, status.busy);
+                status = mtd1.GetStatus(); /* the other volume has nothing pending; it could queue an operation. */
+                TEST_ASSERT_EQUAL(0, status.busy);
                 TEST_ASSERT_EQUAL(0, status.error);
 
-                rc = mtd1.ProgramData(0, buffer, sizeofDataOperation);
-                TEST_ASSERT_EQUAL(ARM_DRIVER_ERROR_BUSY, rc);
                 rc = mtd2.ProgramData(0, buffer, sizeofDataOperation);
                 TEST_ASSERT_EQUAL(ARM_DRIVER_ERROR_BUSY, rc);
                 rc = mtd2.ReadData(0, buffer, sizeofDataOperation);
@@ -1195,6 +1209,163 @@ control_t test_concurrentAccessFromTwoCStorageDevices(const size_t call_count)
     return CaseNext;
 }
 
+template <uint64_t OFFSET1, uint64_t SIZE1, uint64_t OFFSET2, uint64_t SIZE2>
+control_t test_queuedAccessFromTwoVolumes(const size_t call_count)
+{
+    tr_info("test_queuedAccessFromTwoVolumes: called with call_count %lu", call_count);
+
+    if (MAX_VOLUMES <= 1) {
+        return CaseNext;
+    }
+
+    static StorageVolumeManager volumeManager;
+    static StorageVolume *volume1P = NULL;
+    static StorageVolume *volume2P = NULL;
+    static size_t sizeofDataOperation;
+
+    const uint8_t PATTERN_FOR_PROGRAM_DATA1 = 0xA5;
+    const uint8_t PATTERN_FOR_PROGRAM_DATA2 = 0x5A;
+    uint8_t *buffer1 = buffer;
+    uint8_t *buffer2 = buffer + (BUFFER_SIZE / 2);
+
+    static enum {
+        VOLUME_MANAGER_INITIALIZE = 1,
+        ADD_VOLUMES,
+        ERASE_BOTH,
+        PROGRAM_DATA_BOTH,
+        READ_DATA_BOTH,
+        VERIFY_BOTH,
+    } state = VOLUME_MANAGER_INITIALIZE;
+    tr_info("came in with state %u", state);
+
+    int32_t rc1;
+    int32_t rc2;
+    switch (state) {
+        case VOLUME_MANAGER_INITIALIZE:
+            rc1 = volumeManager.initialize(drv, initializeCallbackHandler);
+            TEST_ASSERT(rc1 >= ARM_DRIVER_OK);
+            if (rc1 == ARM_DRIVER_OK) {
+                TEST_ASSERT_EQUAL(1,  drv->GetCapabilities().asynchronous_ops);
+                state = ADD_VOLUMES;
+                return CaseTimeout(200) + CaseRepeatAll;
+            }
+
+            /* synchronous completion */
+            TEST_ASSERT(rc1 == 1);
+
+            /* intentional fall-through */
+
+        case ADD_VOLUMES:
+            TEST_ASSERT_EQUAL(true, volumeManager.isInitialized());
+
+            rc1 = volumeManager.addVolume(OFFSET1 /*addr*/, SIZE1 /*size*/ , &volume1P);
+            TEST_ASSERT_EQUAL(ARM_DRIVER_OK, rc1);
+            rc1 = volume1P->Initialize(queuedCallbackHandler1);
+            TEST_ASSERT_EQUAL(1, rc1);
+
+            rc2 = volumeManager.addVolume(OFFSET2 /*addr*/, SIZE2 /*size*/ , &volume2P);
+            TEST_ASSERT_EQUAL(ARM_DRIVER_OK, rc2);
+            rc2 = volume2P->Initialize(queuedCallbackHandler2);
+            TEST_ASSERT_EQUAL(1, rc2);
+
+            sizeofDataOperation = (SIZE1 > (BUFFER_SIZE / 2)) ? (BUFFER_SIZE / 2) : SIZE1;
+            sizeofDataOperation = (SIZE2 > sizeofDataOperation) ? sizeofDataOperation : SIZE2;
+            TEST_ASSERT((sizeofDataOperation > 0) && (sizeofDataOperation <= (BUFFER_SIZE / 2)));
+
+            /* intentional fall-through */
+
+        case ERASE_BOTH:
+            queuedCallbackCount = 0;
+            rc1 = volume1P->Erase(0, sizeofDataOperation);
+            TEST_ASSERT(rc1 >= ARM_DRIVER_OK);
+            rc2 = volume2P->Erase(0, sizeofDataOperation);
+            TEST_ASSERT(rc2 >= ARM_DRIVER_OK);
+            if (rc1 == ARM_DRIVER_OK) {
+                /* volume2's request waits for volume1's erase instead of failing with ARM_DRIVER_ERROR_BUSY. */
+                TEST_ASSERT_EQUAL(ARM_DRIVER_OK, rc2);
+                TEST_ASSERT_EQUAL(1, volume2P->GetStatus().busy);
+                TEST_ASSERT_EQUAL(ARM_DRIVER_ERROR_BUSY, volume2P->Erase(0, sizeofDataOperation));
+                TEST_ASSERT_EQUAL(1, volume2P->getStatistics().queuedOperations);
+                TEST_ASSERT_EQUAL(1, volume2P->getStatistics().maxQueueDepth);
+
+                state = PROGRAM_DATA_BOTH;
+                return CaseTimeout(400) + CaseRepeatAll;
+            }
+
+            queuedCallbackStatus[0] = rc1;
+            queuedCallbackStatus[1] = rc2;
+            /* intentional fallthrough */
+
+        case PROGRAM_DATA_BOTH:
+            TEST_ASSERT_EQUAL(sizeofDataOperation, queuedCallbackStatus[0]);
+            TEST_ASSERT_EQUAL(sizeofDataOperation, queuedCallbackStatus[1]);
+
+            memset(buffer1, PATTERN_FOR_PROGRAM_DATA1, sizeofDataOperation);
+            memset(buffer2, PATTERN_FOR_PROGRAM_DATA2, sizeofDataOperation);
+
+            queuedCallbackCount = 0;
+            rc1 = volume1P->ProgramData(0, buffer1, sizeofDataOperation);
+            TEST_ASSERT(rc1 >= ARM_DRIVER_OK);
+            rc2 = volume2P->ProgramData(0, buffer2, sizeofDataOperation);
+            TEST_ASSERT(rc2 >= ARM_DRIVER_OK);
+            if (rc1 == ARM_DRIVER_OK) {
+                TEST_ASSERT_EQUAL(ARM_DRIVER_OK, rc2);
+                state = READ_DATA_BOTH;
+                return CaseTimeout(400) + CaseRepeatAll;
+            }
+
+            queuedCallbackStatus[0] = rc1;
+            queuedCallbackStatus[1] = rc2;
+            /* intentional fallthrough */
+
+        case READ_DATA_BOTH:
+            TEST_ASSERT_EQUAL(sizeofDataOperation, queuedCallbackStatus[0]);
+            TEST_ASSERT_EQUAL(sizeofDataOperation, queuedCallbackStatus[1]);
+
+            memset(buffer1, 0, sizeofDataOperation);
+            memset(buffer2, 0, sizeofDataOperation);
+
+            queuedCallbackCount = 0;
+            rc1 = volume1P->ReadData(0, buffer1, sizeofDataOperation);
+            TEST_ASSERT(rc1 >= ARM_DRIVER_OK);
+            rc2 = volume2P->ReadData(0, buffer2, sizeofDataOperation);
+            TEST_ASSERT(rc2 >= ARM_DRIVER_OK);
+            if (rc1 == ARM_DRIVER_OK) {
+                TEST_ASSERT_EQUAL(ARM_DRIVER_OK, rc2);
+                state = VERIFY_BOTH;
+                return CaseTimeout(200) + CaseRepeatAll;
+            }
+
+            queuedCallbackStatus[0] = rc1;
+            queuedCallbackStatus[1] = rc2;
+            /* intentional fallthrough */
+
+        case VERIFY_BOTH:
+            TEST_ASSERT_EQUAL(sizeofDataOperation, queuedCallbackStatus[0]);
+            TEST_ASSERT_EQUAL(sizeofDataOperation, queuedCallbackStatus[1]);
+
+            for (uint32_t index = 0; index < sizeofDataOperation; index++) {
+                TEST_ASSERT_EQUAL(PATTERN_FOR_PROGRAM_DATA1, buffer1[index]);
+                TEST_ASSERT_EQUAL(PATTERN_FOR_PROGRAM_DATA2, buffer2[index]);
+            }
+
+            {
+                const StorageVolumeStatistics_t &statistics = volume2P->getStatistics();
+                TEST_ASSERT_EQUAL(3, statistics.operations);
+                TEST_ASSERT_EQUAL(sizeofDataOperation, statistics.bytesErased);
+                TEST_ASSERT_EQUAL(sizeofDataOperation, statistics.bytesProgrammed);
+                TEST_ASSERT_EQUAL(sizeofDataOperation, statistics.bytesRead);
+                TEST_ASSERT(statistics.totalLatency >= statistics.maxLatency);
+            }
+            break;
+
+        default:
+            TEST_ASSERT(false);
+    }
+
+    return CaseNext;
+}
+
 // Specify all your test cases here
 Case cases[] = {
     Case("initialize",                                    test_initialize),
@@ -1215,6 +1386,7 @@ Case cases[] = {
     Case("Concurrent accesss from two C_Storage devices", test_concurrentAccessFromTwoCStorageDevices<512*1024, 128*1024, (512+128)*1024, 128*1024>),
     Case("Concurrent accesss from two C_Storage devices", test_concurrentAccessFromTwoCStorageDevices<512*1024, 128*1024, (512+256)*1024, 128*1024>),
     Case("Concurrent accesss from two C_Storage devices", test_concurrentAccessFromTwoCStorageDevices<512*1024, 128*1024, (512+384)*1024, 128*1024>),
+    Case("Queued access from two volumes",                test_queuedAccessFromTwoVolumes<512*1024, 128*1024, (512+128)*1024, 128*1024>),
 };
 
 // Declare your test specification with a custom setup handler
@@ -875,6 +875,36 @@ typedef struct _ARM_DRIVER_CFSTORE
 
 extern ARM_CFSTORE_DRIVER cfstore_driver;
 
+
+/** @brief   Statistics of the data written to storage by Flush(), see
+ *           cfstore_get_flush_stats().
+ */
+typedef struct ARM_CFSTORE_FLUSH_STATS
+{
+    uint32_t flush_count;           //!< Number of flushes which have written to storage.
+    uint32_t delta_count;           //!< Number of flushes which have appended the changed KVs to the delta log.
+    uint32_t full_count;            //!< Number of flushes which have rewritten all KVs, compacting the delta log if enabled.
+    uint32_t last_bytes;            //!< Bytes written to storage by the last flush.
+    uint64_t total_bytes;           //!< Bytes written to storage by all flushes.
+} ARM_CFSTORE_FLUSH_STATS;
+
+/** @brief   Get the statistics of the data written to storage by Flush()
+ *           since Initialize().
+ *
+ * The byte counts include the padding to the storage program unit and the
+ * headers of the batches appended to the delta log, but not the metadata
+ * written by the flash journal. In SRAM mode nothing is written to storage
+ * and the statistics are all 0.
+ *
+ * @param    stats
+ *           On return, the flush statistics.
+ *
+ * @return   ARM_DRIVER_OK on success, otherwise
+ *           ARM_CFSTORE_DRIVER_ERROR_UNINITIALISED if the configuration store
+ *           has not been initialised.
+ */
+int32_t cfstore_get_flush_stats(ARM_CFSTORE_FLUSH_STATS* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,6 +56,36 @@
 #define CFSTORE_CONFIG_BACKEND_FLASH_ENABLED
 #endif
 
+/* CFSTORE_INDEX_DISABLE
+ *   Disable the in-RAM index used to speed up Find(), Open() and Create(). The
+ *   index is allocated from the heap so it is not available when the client
+ *   supplies a SRAM slab with CFSTORE_YOTTA_CFG_CFSTORE_SRAM_ADDR. Without the
+ *   index each lookup walks all KVs in the area.
+ */
+#if !defined CFSTORE_YOTTA_CFG_CFSTORE_SRAM_ADDR && (!defined CFSTORE_INDEX_DISABLE || CFSTORE_INDEX_DISABLE==0)
+#define CFSTORE_CONFIG_INDEX_ENABLED
+#endif
+
+/* CFSTORE_DELTA_LOG_ENABLE
+ *   Flush only the KVs created, changed or deleted since the last flush by
+ *   appending them to a delta log in a storage volume of its own, rather than
+ *   rewriting the whole area to the flash journal. The whole area is rewritten
+ *   (compacting the delta log) only when the delta log is full. On
+ *   initialisation the delta log is replayed on top of the area read from the
+ *   flash journal. The delta log requires a synchronous storage driver, and
+ *   otherwise every flush rewrites the whole area.
+ * CFSTORE_DELTA_LOG_SIZE
+ *   Size of the delta log volume in bytes, a multiple of the storage erase
+ *   unit. The volume is taken from the end of the flash journal volume, so
+ *   enabling the delta log reformats existing storage.
+ */
+#if defined CFSTORE_CONFIG_BACKEND_FLASH_ENABLED && defined CFSTORE_DELTA_LOG_ENABLE && CFSTORE_DELTA_LOG_ENABLE==1
+#define CFSTORE_CONFIG_DELTA_LOG_ENABLED
+#ifndef CFSTORE_DELTA_LOG_SIZE
+#define CFSTORE_DELTA_LOG_SIZE                  0x4000UL
+#endif
+#endif
+
 #if defined STORAGE_CONFIG_HARDWARE_MTD_K64F_ASYNC_OPS
 #define CFSTORE_STORAGE_DRIVER_CONFIG_HARDWARE_MTD_ASYNC_OPS STORAGE_CONFIG_HARDWARE_MTD_K64F_ASYNC_OPS
 #endif
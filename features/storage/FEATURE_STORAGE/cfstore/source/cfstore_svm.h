@@ -33,6 +33,9 @@ extern "C" {
 
 int32_t cfstore_svm_init(struct _ARM_DRIVER_STORAGE *mtd);
 
+/* add the delta log volume, after cfstore_svm_init() has added the flash journal volume */
+int32_t cfstore_svm_delta_log_init(struct _ARM_DRIVER_STORAGE *mtd);
+
 
 #ifdef __cplusplus
 }
@@ -34,6 +34,7 @@
 #include "cfstore_svm.h"
 #include "flash_journal_strategy_sequential.h"
 #include "flash_journal.h"
+#include "platform/mbed_crc32.h"
 #include "Driver_Common.h"
 #endif /* CFSTORE_CONFIG_BACKEND_FLASH_ENABLED */
 
@@ -62,6 +63,9 @@ ARM_DRIVER_STORAGE *cfstore_storage_drv = &ARM_Driver_Storage_MTD_K64F;
 #endif /* CFSTORE_CONFIG_BACKEND_FLASH_ENABLED */
 
 struct _ARM_DRIVER_STORAGE cfstore_journal_mtd;
+#ifdef CFSTORE_CONFIG_DELTA_LOG_ENABLED
+struct _ARM_DRIVER_STORAGE cfstore_delta_log_mtd;
+#endif /* CFSTORE_CONFIG_DELTA_LOG_ENABLED */
 
 /*
  * Defines
@@ -131,6 +135,10 @@ struct _ARM_DRIVER_STORAGE cfstore_journal_mtd;
  *
  * @param   delete
  *          indicates this KV is being deleted
+ *
+ * @param   dirty
+ *          indicates this KV has been created or changed since the last flush
+ *          and so has to be appended to the delta log on the next flush.
  */
 typedef struct cfstore_area_header_t
 {
@@ -146,7 +154,8 @@ typedef struct cfstore_area_header_t
     uint8_t refcount;
     struct flags_t {
         uint8_t delete : 1;
-        uint8_t reserved : 7;
+        uint8_t dirty : 1;
+        uint8_t reserved : 6;
     } flags ;
 } cfstore_area_header_t;
 
@@ -161,6 +170,100 @@ typedef struct cfstore_area_hkvt_t
 } cfstore_area_hkvt_t;
 
 
+#ifdef CFSTORE_CONFIG_INDEX_ENABLED
+/*
+ * @brief   in-RAM index of the KVs in the area
+ *
+ * @param   sorted
+ *          offsets of the KV headers from area_0_head, ordered by key name.
+ *
+ * @param   hash
+ *          open addressed hash table of KV header offsets plus 1, so that 0
+ *          marks an empty slot.
+ *
+ * @param   count
+ *          number of KVs in the index.
+ *
+ * @param   sorted_len
+ *          number of entries allocated for sorted.
+ *
+ * @param   hash_len
+ *          number of slots in hash, a power of 2.
+ *
+ * @param   valid
+ *          the index matches the area. If false, lookups walk the area.
+ */
+typedef struct cfstore_index_t
+{
+    uint32_t *sorted;
+    uint32_t *hash;
+    uint32_t count;
+    uint32_t sorted_len;
+    uint32_t hash_len;
+    bool valid;
+} cfstore_index_t;
+#endif /* CFSTORE_CONFIG_INDEX_ENABLED */
+
+
+#ifdef CFSTORE_CONFIG_DELTA_LOG_ENABLED
+/*
+ * @brief   state of the delta log of KVs changed since the area was last
+ *          written to the flash journal
+ *
+ * @param   deleted
+ *          buffer of the headers and key names of the KVs deleted since the
+ *          last flush, appended to the delta log on the next flush.
+ *
+ * @param   deleted_len
+ *          length of the data in deleted.
+ *
+ * @param   program_unit
+ *          program unit of the delta log volume.
+ *
+ * @param   size
+ *          size of the delta log volume, or 0 if the volume can't be used.
+ *
+ * @param   offset
+ *          offset in the delta log volume at which the next batch is written.
+ *
+ * @param   base_crc
+ *          crc32 of the flash journal blob the delta log applies to.
+ *
+ * @param   pending_crc
+ *          crc32 of the blob being written to the flash journal by a full
+ *          flush, which becomes base_crc when the write has completed.
+ *
+ * @param   erase_unit
+ *          erase unit of the delta log volume.
+ *
+ * @param   erased_value
+ *          value of erased storage bytes.
+ *
+ * @param   discard
+ *          the flash journal has been formatted so the delta log is discarded
+ *          rather than replayed.
+ *
+ * @param   valid
+ *          the delta log matches the area apart from the changes since the
+ *          last flush. If false, the next flush rewrites the whole area.
+ */
+typedef struct cfstore_delta_log_t
+{
+    uint8_t *deleted;
+    uint32_t deleted_len;
+    uint32_t program_unit;
+    uint32_t size;
+    uint32_t offset;
+    uint32_t base_crc;
+    uint32_t pending_crc;
+    uint32_t erase_unit;
+    uint8_t erased_value;
+    bool discard;
+    bool valid;
+} cfstore_delta_log_t;
+#endif /* CFSTORE_CONFIG_DELTA_LOG_ENABLED */
+
+
 /* helper struct */
 typedef struct cfstore_client_notify_data_t
 {
@@ -254,6 +357,7 @@ static int32_t cfstore_fsm_state_handle_event(cfstore_fsm_t* fsm, cfstore_fsm_ev
 static int32_t cfstore_fsm_state_set(cfstore_fsm_t* fsm, cfstore_fsm_state_t new_state, void* ctx);
 #endif  /* CFSTORE_CONFIG_BACKEND_FLASH_ENABLED */
 static int32_t cfstore_get_key_name_ex(cfstore_area_hkvt_t *hkvt, char* key_name, uint8_t *key_name_len);
+static int32_t cfstore_delete_ex(cfstore_area_hkvt_t* hkvt);
 
 
 /* Walking Area HKVT's While Inserting   a New HKVT:
@@ -373,6 +477,16 @@ static int32_t cfstore_get_key_name_ex(cfstore_area_hkvt_t *hkvt, char* key_name
  *          plus padding so the sram blob size is a multiple of flash
  *          program_unit.
  *          - accessed in app & intr context; hence needs CS protection.
+ *
+ * @param   index
+ *          in-RAM index of the KVs in the area used to speed up lookups by
+ *          key name. See cfstore_index_build().
+ *
+ * @param   delta
+ *          delta log state. See cfstore_delta_log_append().
+ *
+ * @param   flush_stats
+ *          statistics of the data written to storage by flushes.
  */
 typedef struct cfstore_ctx_t
 {
@@ -396,13 +510,22 @@ typedef struct cfstore_ctx_t
     uint32_t area_dirty_flag : 1;
     uint32_t f_reserved0 : 30;
 
+#ifdef CFSTORE_CONFIG_INDEX_ENABLED
+    cfstore_index_t index;
+#endif /* CFSTORE_CONFIG_INDEX_ENABLED */
+
 #ifdef CFSTORE_CONFIG_BACKEND_FLASH_ENABLED
     /* flash journal related data */
     FlashJournal_t jrnl;
     FlashJournal_Info_t info;
     FlashJournal_OpCode_t cmd_code;
     uint64_t expected_blob_size;
+    ARM_CFSTORE_FLUSH_STATS flush_stats;
 #endif /* CFSTORE_CONFIG_BACKEND_FLASH_ENABLED */
+
+#ifdef CFSTORE_CONFIG_DELTA_LOG_ENABLED
+    cfstore_delta_log_t delta;
+#endif /* CFSTORE_CONFIG_DELTA_LOG_ENABLED */
 } cfstore_ctx_t;
 
 
@@ -1489,6 +1612,1051 @@ static int32_t cfstore_realloc_ex(ARM_CFSTORE_SIZE size, uint64_t *allocated_siz
 }
 
 
+/*
+ * KV index
+ *
+ * The index holds the offset of each KV header from area_0_head twice: in an
+ * array sorted by key name, which is binary searched to answer queries of the
+ * form "prefix*", and in a hash table to answer exact key name queries.
+ * Offsets are stored rather than pointers so realloc() moving the area doesn't
+ * invalidate the index. When KVs are memmove()-ed within the area, the offsets
+ * are shifted by cfstore_index_shift() in the same way as cfstore_file_update()
+ * updates the file head pointers.
+ *
+ * The index isn't part of the area so is allocated directly from the heap.
+ * If memory for the index can't be allocated, the index is marked invalid and
+ * cfstore_find_ex() walks the area until the index is next built.
+ */
+
+#ifdef CFSTORE_CONFIG_INDEX_ENABLED
+
+#define CFSTORE_INDEX_SORTED_LEN_MIN        8
+#define CFSTORE_INDEX_HASH_LEN_MIN          16
+#define CFSTORE_INDEX_OFFSET_NONE           UINT32_MAX
+
+static CFSTORE_INLINE cfstore_area_hkvt_t cfstore_index_get_hkvt(uint32_t offset)
+{
+    return cfstore_get_hkvt_from_head_ptr(cfstore_ctx_get()->area_0_head + offset);
+}
+
+/* @brief   FNV-1a hash of a key name */
+static uint32_t cfstore_index_hash(const uint8_t* key, uint8_t key_len)
+{
+    uint32_t hash = 2166136261u;
+
+    while(key_len-- > 0){
+        hash ^= *key++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* @brief   compare the key name of the KV at offset with key, returning <0, 0 or >0 as memcmp() */
+static int32_t cfstore_index_cmp(uint32_t offset, const uint8_t* key, uint8_t key_len)
+{
+    int32_t ret = 0;
+    uint8_t kv_key_len = 0;
+    cfstore_area_hkvt_t hkvt = cfstore_index_get_hkvt(offset);
+
+    kv_key_len = cfstore_hkvt_get_key_len(&hkvt);
+    ret = memcmp(hkvt.key, key, kv_key_len < key_len ? kv_key_len : key_len);
+    if(ret == 0){
+        ret = (int32_t) kv_key_len - (int32_t) key_len;
+    }
+    return ret;
+}
+
+/* @brief   qsort() comparison function for ordering KV offsets by key name */
+static int cfstore_index_sort_cmp(const void* a, const void* b)
+{
+    cfstore_area_hkvt_t hkvt = cfstore_index_get_hkvt(*(const uint32_t*) b);
+    return (int) cfstore_index_cmp(*(const uint32_t*) a, hkvt.key, cfstore_hkvt_get_key_len(&hkvt));
+}
+
+/* @brief   position in the sorted array of the first KV with a key name not less than key */
+static uint32_t cfstore_index_lower_bound(cfstore_index_t* index, const uint8_t* key, uint8_t key_len)
+{
+    uint32_t lo = 0;
+    uint32_t hi = index->count;
+    uint32_t mid = 0;
+
+    while(lo < hi){
+        mid = lo + (hi - lo) / 2;
+        if(cfstore_index_cmp(index->sorted[mid], key, key_len) < 0){
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* @brief   position in the sorted array of the first KV after start with a key name not starting with prefix */
+static uint32_t cfstore_index_prefix_end(cfstore_index_t* index, uint32_t start, const uint8_t* prefix, uint8_t prefix_len)
+{
+    uint32_t lo = start;
+    uint32_t hi = index->count;
+    uint32_t mid = 0;
+    cfstore_area_hkvt_t hkvt;
+
+    /* KVs from start onwards aren't less than prefix, so either start with it or are greater */
+    while(lo < hi){
+        mid = lo + (hi - lo) / 2;
+        hkvt = cfstore_index_get_hkvt(index->sorted[mid]);
+        if(cfstore_hkvt_get_key_len(&hkvt) >= prefix_len && memcmp(hkvt.key, prefix, prefix_len) == 0){
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* @brief   home slot in the hash table of the KV at offset */
+static uint32_t cfstore_index_hash_home(cfstore_index_t* index, uint32_t offset)
+{
+    cfstore_area_hkvt_t hkvt = cfstore_index_get_hkvt(offset);
+    return cfstore_index_hash(hkvt.key, cfstore_hkvt_get_key_len(&hkvt)) & (index->hash_len - 1);
+}
+
+static void cfstore_index_hash_insert(cfstore_index_t* index, uint32_t offset)
+{
+    uint32_t mask = index->hash_len - 1;
+    uint32_t slot = cfstore_index_hash_home(index, offset);
+
+    while(index->hash[slot] != 0){
+        slot = (slot + 1) & mask;
+    }
+    index->hash[slot] = offset + 1;
+}
+
+/* @brief   remove the KV at offset from the hash table
+ *
+ * Entries later in the probe sequence are moved back into the vacated slot
+ * where their home slot allows it, so lookups don't stop early at the gap.
+ */
+static void cfstore_index_hash_remove(cfstore_index_t* index, uint32_t offset)
+{
+    uint32_t mask = index->hash_len - 1;
+    uint32_t slot = cfstore_index_hash_home(index, offset);
+    uint32_t next = 0;
+    uint32_t home = 0;
+
+    while(index->hash[slot] != offset + 1){
+        CFSTORE_ASSERT(index->hash[slot] != 0);
+        slot = (slot + 1) & mask;
+    }
+    next = slot;
+    while(true){
+        next = (next + 1) & mask;
+        if(index->hash[next] == 0){
+            break;
+        }
+        home = cfstore_index_hash_home(index, index->hash[next] - 1);
+        /* the entry can fill the gap if the gap is between its home slot and its slot */
+        if(((next - home) & mask) >= ((next - slot) & mask)){
+            index->hash[slot] = index->hash[next];
+            slot = next;
+        }
+    }
+    index->hash[slot] = 0;
+}
+
+/* @brief   make room in the index for count KVs */
+static int32_t cfstore_index_reserve(cfstore_index_t* index, uint32_t count)
+{
+    uint32_t i = 0;
+    uint32_t len = 0;
+    uint32_t* ptr = NULL;
+
+    if(count > index->sorted_len){
+        len = index->sorted_len > 0 ? index->sorted_len : CFSTORE_INDEX_SORTED_LEN_MIN;
+        while(len < count){
+            len *= 2;
+        }
+        ptr = (uint32_t*) realloc(index->sorted, len * sizeof(uint32_t));
+        if(ptr == NULL){
+            return ARM_CFSTORE_DRIVER_ERROR_OUT_OF_MEMORY;
+        }
+        index->sorted = ptr;
+        index->sorted_len = len;
+    }
+    /* keep the hash table at most half full so probe sequences stay short */
+    if(2 * count > index->hash_len){
+        len = index->hash_len > 0 ? index->hash_len : CFSTORE_INDEX_HASH_LEN_MIN;
+        while(len < 2 * count){
+            len *= 2;
+        }
+        ptr = (uint32_t*) calloc(len, sizeof(uint32_t));
+        if(ptr == NULL){
+            return ARM_CFSTORE_DRIVER_ERROR_OUT_OF_MEMORY;
+        }
+        free(index->hash);
+        index->hash = ptr;
+        index->hash_len = len;
+        for(i = 0; i < index->count; i++){
+            cfstore_index_hash_insert(index, index->sorted[i]);
+        }
+    }
+    return ARM_DRIVER_OK;
+}
+
+/* @brief   free the index memory, leaving the index invalid */
+static void cfstore_index_destroy(void)
+{
+    cfstore_index_t* index = &cfstore_ctx_get()->index;
+
+    CFSTORE_FENTRYLOG("%s:entered\n", __func__);
+    free(index->sorted);
+    free(index->hash);
+    memset(index, 0, sizeof(cfstore_index_t));
+}
+
+/* @brief   build the index from the KVs in the area
+ *
+ * Called when the area has been loaded from backing store, after which the
+ * index is kept up to date as KVs are created, resized and deleted.
+ */
+static int32_t cfstore_index_build(void)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+    uint32_t count = 0;
+    cfstore_area_hkvt_t hkvt;
+    cfstore_ctx_t* ctx = cfstore_ctx_get();
+    cfstore_index_t* index = &ctx->index;
+
+    CFSTORE_FENTRYLOG("%s:entered\n", __func__);
+    cfstore_index_destroy();
+
+    /* count the KVs so the index is allocated in one go */
+    ret = cfstore_get_head_hkvt(&hkvt);
+    while(ret >= ARM_DRIVER_OK && cfstore_hkvt_is_valid(&hkvt, ctx->area_0_tail)){
+        count++;
+        ret = cfstore_get_next_hkvt(&hkvt, &hkvt);
+    }
+    ret = cfstore_index_reserve(index, count);
+    if(ret < ARM_DRIVER_OK){
+        CFSTORE_ERRLOG("%s:Error: unable to allocate index for %d KVs\n", __func__, (int) count);
+        cfstore_index_destroy();
+        return ret;
+    }
+    ret = cfstore_get_head_hkvt(&hkvt);
+    while(ret >= ARM_DRIVER_OK && cfstore_hkvt_is_valid(&hkvt, ctx->area_0_tail)){
+        index->sorted[index->count++] = (uint32_t) (hkvt.head - ctx->area_0_head);
+        cfstore_index_hash_insert(index, (uint32_t) (hkvt.head - ctx->area_0_head));
+        ret = cfstore_get_next_hkvt(&hkvt, &hkvt);
+    }
+    if(index->count > 1){
+        qsort(index->sorted, index->count, sizeof(uint32_t), cfstore_index_sort_cmp);
+    }
+    index->valid = true;
+    CFSTORE_TP(CFSTORE_TP_INIT, "%s:indexed %d KVs\n", __func__, (int) index->count);
+    return ARM_DRIVER_OK;
+}
+
+/* @brief   add the KV at offset to the index, after its header and key name have been written */
+static void cfstore_index_insert(uint32_t offset)
+{
+    uint32_t pos = 0;
+    cfstore_area_hkvt_t hkvt;
+    cfstore_index_t* index = &cfstore_ctx_get()->index;
+
+    if(!index->valid){
+        return;
+    }
+    if(cfstore_index_reserve(index, index->count + 1) < ARM_DRIVER_OK){
+        CFSTORE_ERRLOG("%s:Error: unable to grow index, falling back to searching the area\n", __func__);
+        cfstore_index_destroy();
+        return;
+    }
+    hkvt = cfstore_index_get_hkvt(offset);
+    pos = cfstore_index_lower_bound(index, hkvt.key, cfstore_hkvt_get_key_len(&hkvt));
+    memmove(&index->sorted[pos + 1], &index->sorted[pos], (index->count - pos) * sizeof(uint32_t));
+    index->sorted[pos] = offset;
+    index->count++;
+    cfstore_index_hash_insert(index, offset);
+}
+
+/** @brief  Update the index after size_diff bytes have been inserted or removed
+ *          at the end of the KV at offset, moving the KVs that follow it.
+ */
+static void cfstore_index_shift(uint32_t offset, int32_t size_diff)
+{
+    uint32_t i = 0;
+    cfstore_index_t* index = &cfstore_ctx_get()->index;
+
+    if(!index->valid){
+        return;
+    }
+    for(i = 0; i < index->count; i++){
+        if(index->sorted[i] > offset){
+            index->sorted[i] += size_diff;
+        }
+    }
+    for(i = 0; i < index->hash_len; i++){
+        if(index->hash[i] > offset + 1){
+            index->hash[i] += size_diff;
+        }
+    }
+}
+
+/* @brief   remove the KV at offset from the index, before the kv_size bytes of
+ *          the KV are removed from the area */
+static void cfstore_index_remove(uint32_t offset, ARM_CFSTORE_SIZE kv_size)
+{
+    uint32_t pos = 0;
+    cfstore_area_hkvt_t hkvt;
+    cfstore_index_t* index = &cfstore_ctx_get()->index;
+
+    if(!index->valid){
+        return;
+    }
+    /* there can be more than one KV with the same name while a KV marked
+     * for deletion is still open, so find this KV amongst them */
+    hkvt = cfstore_index_get_hkvt(offset);
+    pos = cfstore_index_lower_bound(index, hkvt.key, cfstore_hkvt_get_key_len(&hkvt));
+    while(pos < index->count && index->sorted[pos] != offset){
+        pos++;
+    }
+    CFSTORE_ASSERT(pos < index->count);
+    memmove(&index->sorted[pos], &index->sorted[pos + 1], (index->count - pos - 1) * sizeof(uint32_t));
+    index->count--;
+    cfstore_index_hash_remove(index, offset);
+    cfstore_index_shift(offset, -1 * (int32_t) kv_size);
+}
+
+/* @brief   helper function to check whether the KV at offset is a candidate
+ *          for a find following the KV at min_offset */
+static bool cfstore_index_is_candidate(uint32_t offset, uint32_t min_offset, uint32_t found)
+{
+    cfstore_area_hkvt_t hkvt;
+
+    /* find() returns matches in area order, so the candidate must follow the
+     * previous match and precede the best candidate so far */
+    if(offset < min_offset || offset >= found){
+        return false;
+    }
+    hkvt = cfstore_index_get_hkvt(offset);
+    if(cfstore_hkvt_get_flags_delete(&hkvt) || !cfstore_is_kv_client_readable(&hkvt)){
+        return false;
+    }
+    return true;
+}
+
+/** @brief  Find the KV following prev in the area which matches the query,
+ *          using the index.
+ *
+ * @return  false if the index can't answer the query, in which case the caller
+ *          should walk the area. Otherwise true, with the return code as for
+ *          cfstore_find_ex() in ret.
+ */
+static bool cfstore_index_find(const char* key_name_query, cfstore_area_hkvt_t *prev, cfstore_area_hkvt_t *next, int32_t* ret)
+{
+    uint8_t query_len = 0;
+    uint32_t i = 0;
+    uint32_t end = 0;
+    uint32_t slot = 0;
+    uint32_t mask = 0;
+    uint32_t offset = 0;
+    uint32_t min_offset = 0;
+    uint32_t found = CFSTORE_INDEX_OFFSET_NONE;
+    const char* wildcard = NULL;
+    cfstore_ctx_t* ctx = cfstore_ctx_get();
+    cfstore_index_t* index = &ctx->index;
+
+    if(!index->valid || index->count == 0){
+        return false;
+    }
+    query_len = (uint8_t) strlen(key_name_query);
+    wildcard = strchr(key_name_query, '*');
+    /* only a single trailing '*' can be answered from the sorted array, and a
+     * query of "*" matches every KV so may as well walk the area */
+    if(wildcard != NULL && (wildcard != &key_name_query[query_len - 1] || query_len == 1)){
+        return false;
+    }
+    if(wildcard != NULL){
+        query_len--;
+        i = cfstore_index_lower_bound(index, (const uint8_t*) key_name_query, query_len);
+        end = cfstore_index_prefix_end(index, i, (const uint8_t*) key_name_query, query_len);
+        /* finding the next match in area order means checking all n matches in
+         * the sorted array, whereas the walk visits about count/n KVs, so leave
+         * queries matching many KVs to the walk */
+        if((end - i) * (end - i) > index->count){
+            return false;
+        }
+    }
+    if(prev != NULL){
+        min_offset = (uint32_t) (prev->head - ctx->area_0_head) + 1;
+    }
+
+    if(wildcard == NULL){
+        /* exact key name. Look at every KV in the probe sequence as there may
+         * be more than one KV with the name, see cfstore_index_remove() */
+        mask = index->hash_len - 1;
+        slot = cfstore_index_hash((const uint8_t*) key_name_query, query_len) & mask;
+        while(index->hash[slot] != 0){
+            offset = index->hash[slot] - 1;
+            if(cfstore_index_is_candidate(offset, min_offset, found) && cfstore_index_cmp(offset, (const uint8_t*) key_name_query, query_len) == 0){
+                found = offset;
+            }
+            slot = (slot + 1) & mask;
+        }
+    } else {
+        /* prefix query. matching KVs are contiguous in the sorted array */
+        for(; i < end; i++){
+            offset = index->sorted[i];
+            if(cfstore_index_is_candidate(offset, min_offset, found)){
+                found = offset;
+            }
+        }
+    }
+
+    if(found == CFSTORE_INDEX_OFFSET_NONE){
+        CFSTORE_TP(CFSTORE_TP_FIND, "%s:No more KVs found\n", __func__);
+        memset((void*) next, 0, sizeof(cfstore_area_hkvt_t));
+        *ret = ARM_CFSTORE_DRIVER_ERROR_KEY_NOT_FOUND;
+        return true;
+    }
+    *next = cfstore_index_get_hkvt(found);
+    *ret = ARM_DRIVER_OK;
+    return true;
+}
+
+#else
+
+static int32_t cfstore_index_build(void) { return ARM_DRIVER_OK; }
+static void cfstore_index_destroy(void) { }
+static void cfstore_index_insert(uint32_t offset) { (void) offset; }
+static void cfstore_index_shift(uint32_t offset, int32_t size_diff) { (void) offset; (void) size_diff; }
+static void cfstore_index_remove(uint32_t offset, ARM_CFSTORE_SIZE kv_size) { (void) offset; (void) kv_size; }
+static bool cfstore_index_find(const char* key_name_query, cfstore_area_hkvt_t *prev, cfstore_area_hkvt_t *next, int32_t* ret)
+{
+    (void) key_name_query; (void) prev; (void) next; (void) ret;
+    return false;
+}
+
+#endif /* CFSTORE_CONFIG_INDEX_ENABLED */
+
+
+#ifdef CFSTORE_CONFIG_BACKEND_FLASH_ENABLED
+/* @brief   update the flush statistics for a flush which has written len bytes to storage */
+static void cfstore_flash_stats_add(cfstore_ctx_t* ctx, bool delta, uint32_t len)
+{
+    ctx->flush_stats.flush_count++;
+    if(delta){
+        ctx->flush_stats.delta_count++;
+    } else {
+        ctx->flush_stats.full_count++;
+    }
+    ctx->flush_stats.last_bytes = len;
+    ctx->flush_stats.total_bytes += len;
+}
+#endif /* CFSTORE_CONFIG_BACKEND_FLASH_ENABLED */
+
+
+/*
+ * Delta log
+ *
+ * The sequential flash journal can only store a complete copy of the area, so
+ * without the delta log every flush rewrites all the KVs. The delta log is kept
+ * in a storage volume of its own and a flush appends to it a batch holding
+ * only the KVs created or changed since the last flush (those with the dirty
+ * flag set in their header) and the KVs deleted since the last flush. Entries
+ * use the area KV format; a deleted KV is recorded as an entry with the delete
+ * flag set and no value. The log starts with a header holding the crc32 of the
+ * flash journal blob the batches apply to, so a log left over from another
+ * blob is never replayed. When a batch doesn't fit, the flush rewrites the
+ * area to the flash journal as before, and the log is then erased and
+ * restarted for the new blob.
+ *
+ * Each batch has a header holding the length and crc32 of its entries. The
+ * batch header is programmed before the entries, so a batch torn by a power
+ * failure fails its crc check. Replay stops at the first erased batch header.
+ * A torn or corrupt batch ends the replay and marks the log invalid, so the
+ * next flush rewrites the area and restarts the log.
+ *
+ * The delta log is only used with a synchronous storage driver, as appending a
+ * batch completes within the Flush() call.
+ */
+
+#ifdef CFSTORE_CONFIG_DELTA_LOG_ENABLED
+
+#define CFSTORE_DELTA_LOG_MAGIC             0x47444643      /* "CFDG" */
+#define CFSTORE_DELTA_LOG_BATCH_MAGIC       0x48424643      /* "CFBH" */
+#define CFSTORE_DELTA_LOG_BUF_SIZE          CFSTORE_FLASH_STACK_BUF_SIZE
+
+/* @brief   header at the start of the delta log volume */
+typedef struct cfstore_delta_log_header_t
+{
+    uint32_t magic;
+    uint32_t base_crc;
+} cfstore_delta_log_header_t;
+
+/* @brief   header at the start of each batch, followed by length bytes of entries */
+typedef struct cfstore_delta_log_batch_t
+{
+    uint32_t magic;
+    uint32_t length;
+    uint32_t crc;
+} cfstore_delta_log_batch_t;
+
+/* @brief   state for writing the entries of a batch
+ *
+ * @param   buf
+ *          buffer used to program the entries a multiple of program units at
+ *          a time.
+ *
+ * @param   buf_len
+ *          length of the data in buf.
+ *
+ * @param   offset
+ *          offset in the delta log volume at which buf is programmed.
+ *
+ * @param   length
+ *          length of the entries written so far.
+ *
+ * @param   program
+ *          if true the entries are programmed to storage, otherwise only
+ *          their length and crc32 are computed.
+ *
+ * @param   crc
+ *          crc32 of the entries written so far, when not programming.
+ *
+ * @param   status
+ *          status of the storage operations, < ARM_DRIVER_OK on failure.
+ */
+typedef struct cfstore_delta_log_writer_t
+{
+    uint8_t buf[CFSTORE_DELTA_LOG_BUF_SIZE];
+    uint32_t buf_len;
+    uint32_t offset;
+    uint32_t length;
+    bool program;
+    mbed_crc32_t crc;
+    int32_t status;
+} cfstore_delta_log_writer_t;
+
+static uint32_t cfstore_delta_log_round_up(cfstore_delta_log_t* delta, uint32_t size)
+{
+    return (size + delta->program_unit - 1) / delta->program_unit * delta->program_unit;
+}
+
+/* @brief   check a synchronous storage operation has completed for size bytes */
+static int32_t cfstore_delta_log_io_status(int32_t ret, uint32_t size)
+{
+    if(ret < ARM_DRIVER_OK || (uint32_t) ret != size){
+        CFSTORE_ERRLOG("%s:Error: delta log storage operation failed (ret=%d, size=%d)\n", __func__, (int) ret, (int) size);
+        return ARM_CFSTORE_DRIVER_ERROR_JOURNAL_STATUS_STORAGE_IO_ERROR;
+    }
+    return ARM_DRIVER_OK;
+}
+
+static int32_t cfstore_delta_log_read(uint32_t offset, void* data, uint32_t size)
+{
+    return cfstore_delta_log_io_status(cfstore_delta_log_mtd.ReadData(offset, data, size), size);
+}
+
+/* @brief   program a header of size bytes at offset, padded to a program unit */
+static int32_t cfstore_delta_log_program_header(cfstore_delta_log_t* delta, uint32_t offset, const void* data, uint32_t size)
+{
+    uint8_t buf[CFSTORE_DELTA_LOG_BUF_SIZE];
+    uint32_t len = cfstore_delta_log_round_up(delta, size);
+
+    memset(buf, delta->erased_value, len);
+    memcpy(buf, data, size);
+    return cfstore_delta_log_io_status(cfstore_delta_log_mtd.ProgramData(offset, buf, len), len);
+}
+
+static void cfstore_delta_log_write(cfstore_delta_log_writer_t* writer, const uint8_t* data, uint32_t len)
+{
+    uint32_t n = 0;
+
+    writer->length += len;
+    if(!writer->program){
+        mbed_crc32_update(&writer->crc, data, len);
+        return;
+    }
+    while(len > 0 && writer->status >= ARM_DRIVER_OK){
+        n = CFSTORE_DELTA_LOG_BUF_SIZE - writer->buf_len;
+        n = len < n ? len : n;
+        memcpy(writer->buf + writer->buf_len, data, n);
+        writer->buf_len += n;
+        data += n;
+        len -= n;
+        if(writer->buf_len == CFSTORE_DELTA_LOG_BUF_SIZE){
+            writer->status = cfstore_delta_log_io_status(cfstore_delta_log_mtd.ProgramData(writer->offset, writer->buf, writer->buf_len), writer->buf_len);
+            writer->offset += writer->buf_len;
+            writer->buf_len = 0;
+        }
+    }
+}
+
+/* @brief   program the remaining buffered entry data, padded to a program unit */
+static void cfstore_delta_log_write_flush(cfstore_delta_log_t* delta, cfstore_delta_log_writer_t* writer)
+{
+    uint32_t len = cfstore_delta_log_round_up(delta, writer->buf_len);
+
+    if(writer->buf_len > 0 && writer->status >= ARM_DRIVER_OK){
+        memset(writer->buf + writer->buf_len, delta->erased_value, len - writer->buf_len);
+        writer->status = cfstore_delta_log_io_status(cfstore_delta_log_mtd.ProgramData(writer->offset, writer->buf, len), len);
+        writer->offset += len;
+        writer->buf_len = 0;
+    }
+}
+
+/* @brief   write the entries of a batch: the KVs deleted since the last flush
+ *          followed by the KVs created or changed since the last flush.
+ *
+ * The deleted KVs come first so that deleting a KV and then creating another
+ * with the same name replays as a create.
+ */
+static void cfstore_delta_log_write_entries(cfstore_ctx_t* ctx, cfstore_delta_log_writer_t* writer)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+    cfstore_area_header_t hdr;
+    cfstore_area_hkvt_t hkvt;
+
+    cfstore_delta_log_write(writer, ctx->delta.deleted, ctx->delta.deleted_len);
+    ret = cfstore_get_head_hkvt(&hkvt);
+    while(ret >= ARM_DRIVER_OK && cfstore_hkvt_is_valid(&hkvt, ctx->area_0_tail)){
+        memcpy(&hdr, hkvt.head, sizeof(hdr));
+        if(hdr.flags.dirty){
+            hdr.refcount = 0;
+            hdr.flags.dirty = false;
+            if(hdr.flags.delete){
+                hdr.vlength = 0;
+            }
+            cfstore_delta_log_write(writer, (const uint8_t*) &hdr, sizeof(hdr));
+            cfstore_delta_log_write(writer, hkvt.key, hdr.klength + hdr.vlength);
+        }
+        ret = cfstore_get_next_hkvt(&hkvt, &hkvt);
+    }
+}
+
+/* @brief   forget the changes since the last flush once they have been persisted */
+static void cfstore_delta_log_clean(cfstore_ctx_t* ctx)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+    cfstore_area_hkvt_t hkvt;
+
+    ret = cfstore_get_head_hkvt(&hkvt);
+    while(ret >= ARM_DRIVER_OK && cfstore_hkvt_is_valid(&hkvt, ctx->area_0_tail)){
+        ((cfstore_area_header_t*) hkvt.head)->flags.dirty = false;
+        ret = cfstore_get_next_hkvt(&hkvt, &hkvt);
+    }
+    CFSTORE_FREE(ctx->delta.deleted);
+    ctx->delta.deleted = NULL;
+    ctx->delta.deleted_len = 0;
+}
+
+/* @brief   erase the delta log and start a new one for the flash journal blob
+ *          with crc32 base_crc.
+ *
+ * Only the erase units up to delta->offset are erased, as the rest of the
+ * volume hasn't been programmed since it was last erased.
+ */
+static int32_t cfstore_delta_log_reset(cfstore_ctx_t* ctx, uint32_t base_crc)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+    uint32_t len = 0;
+    cfstore_delta_log_t* delta = &ctx->delta;
+    cfstore_delta_log_header_t header;
+
+    CFSTORE_FENTRYLOG("%s:entered\n", __func__);
+    if(delta->size == 0){
+        return ARM_DRIVER_OK;
+    }
+    delta->valid = false;
+    len = (delta->offset + delta->erase_unit - 1) / delta->erase_unit * delta->erase_unit;
+    len = len < delta->size ? len : delta->size;
+    ret = cfstore_delta_log_io_status(cfstore_delta_log_mtd.Erase(0, len), len);
+    if(ret < ARM_DRIVER_OK){
+        CFSTORE_ERRLOG("%s:Error: failed to erase delta log (ret=%d)\n", __func__, (int) ret);
+        return ret;
+    }
+    header.magic = CFSTORE_DELTA_LOG_MAGIC;
+    header.base_crc = base_crc;
+    ret = cfstore_delta_log_program_header(delta, 0, &header, sizeof(header));
+    if(ret < ARM_DRIVER_OK){
+        CFSTORE_ERRLOG("%s:Error: failed to program delta log header (ret=%d)\n", __func__, (int) ret);
+        return ret;
+    }
+    delta->base_crc = base_crc;
+    delta->offset = cfstore_delta_log_round_up(delta, sizeof(header));
+    delta->valid = true;
+    return ARM_DRIVER_OK;
+}
+
+/* @brief   initialise the delta log volume. If the volume can't be used
+ *          delta->size is left 0 and every flush rewrites the whole area.
+ */
+static void cfstore_delta_log_init(cfstore_ctx_t* ctx)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+    cfstore_delta_log_t* delta = &ctx->delta;
+    ARM_STORAGE_CAPABILITIES caps;
+    ARM_STORAGE_INFO info;
+    ARM_STORAGE_BLOCK block;
+
+    CFSTORE_FENTRYLOG("%s:entered\n", __func__);
+    delta->size = 0;
+    delta->valid = false;
+    ret = cfstore_svm_delta_log_init(&cfstore_delta_log_mtd);
+    if(ret < ARM_DRIVER_OK){
+        CFSTORE_ERRLOG("%s:Error: unable to initialize delta log volume (ret=%d)\n", __func__, (int) ret);
+        return;
+    }
+    caps = cfstore_delta_log_mtd.GetCapabilities();
+    if(caps.asynchronous_ops){
+        CFSTORE_TP(CFSTORE_TP_INIT, "%s:delta log disabled as storage driver is asynchronous\n", __func__);
+        return;
+    }
+    if(cfstore_delta_log_mtd.GetInfo(&info) != ARM_DRIVER_OK || cfstore_delta_log_mtd.GetNextBlock(NULL, &block) != ARM_DRIVER_OK){
+        CFSTORE_ERRLOG("%s:Error: unable to get delta log volume info\n", __func__);
+        return;
+    }
+    delta->program_unit = info.program_unit > 0 ? info.program_unit : 1;
+    if(CFSTORE_DELTA_LOG_BUF_SIZE % delta->program_unit != 0 || block.attributes.erase_unit == 0){
+        CFSTORE_ERRLOG("%s:Error: delta log unsupported (program_unit=%d, erase_unit=%d)\n", __func__, (int) delta->program_unit, (int) block.attributes.erase_unit);
+        return;
+    }
+    delta->erase_unit = block.attributes.erase_unit;
+    delta->erased_value = info.erased_value ? 0xff : 0x00;
+    delta->size = (uint32_t) info.total_storage;
+}
+
+/* @brief   free the delta log memory */
+static void cfstore_delta_log_deinit(void)
+{
+    cfstore_delta_log_t* delta = &cfstore_ctx_get()->delta;
+
+    CFSTORE_FREE(delta->deleted);
+    delta->deleted = NULL;
+    delta->deleted_len = 0;
+}
+
+/* @brief   the flash journal has been formatted, so the delta log no longer applies */
+static void cfstore_delta_log_discard(cfstore_ctx_t* ctx)
+{
+    ctx->delta.discard = true;
+}
+
+/* @brief   record a KV has been created or changed so it's appended to the
+ *          delta log on the next flush */
+static CFSTORE_INLINE void cfstore_delta_log_mark(cfstore_area_hkvt_t* hkvt)
+{
+    ((cfstore_area_header_t*) hkvt->head)->flags.dirty = true;
+}
+
+/* @brief   record a KV is being removed from the area so its deletion is
+ *          appended to the delta log on the next flush */
+static void cfstore_delta_log_delete(cfstore_area_hkvt_t* hkvt)
+{
+    uint8_t* ptr = NULL;
+    uint32_t len = 0;
+    cfstore_area_header_t hdr;
+    cfstore_delta_log_t* delta = &cfstore_ctx_get()->delta;
+
+    if(!delta->valid){
+        return;
+    }
+    memcpy(&hdr, hkvt->head, sizeof(hdr));
+    hdr.vlength = 0;
+    hdr.refcount = 0;
+    hdr.flags.delete = true;
+    hdr.flags.dirty = false;
+    len = sizeof(hdr) + hdr.klength;
+    ptr = (uint8_t*) CFSTORE_REALLOC(delta->deleted, delta->deleted_len + len);
+    if(ptr == NULL){
+        /* the deletion can't be recorded so the next flush has to rewrite the whole area */
+        CFSTORE_ERRLOG("%s:Error: unable to allocate memory to record deleted KV\n", __func__);
+        delta->valid = false;
+        return;
+    }
+    memcpy(ptr + delta->deleted_len, &hdr, sizeof(hdr));
+    memcpy(ptr + delta->deleted_len + sizeof(hdr), hkvt->key, hdr.klength);
+    delta->deleted = ptr;
+    delta->deleted_len += len;
+}
+
+/* @brief   flush by appending the KVs changed since the last flush to the
+ *          delta log.
+ *
+ * @return  ARM_DRIVER_OK if the changes have been flushed, otherwise
+ *          < ARM_DRIVER_OK if they have to be flushed by rewriting the whole
+ *          area to the flash journal because the delta log is full or unusable.
+ */
+static int32_t cfstore_delta_log_append(cfstore_ctx_t* ctx)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+    uint32_t header_len = 0;
+    uint32_t batch_len = 0;
+    cfstore_delta_log_t* delta = &ctx->delta;
+    cfstore_delta_log_batch_t batch;
+    cfstore_delta_log_writer_t writer;
+
+    CFSTORE_FENTRYLOG("%s:entered\n", __func__);
+    if(!delta->valid){
+        return ARM_DRIVER_ERROR;
+    }
+    if(ctx->area_dirty_flag == false){
+        return ARM_DRIVER_OK;
+    }
+    /* compute the length and crc32 of the entries before writing any of them */
+    memset(&writer, 0, sizeof(writer));
+    mbed_crc32_init(&writer.crc);
+    cfstore_delta_log_write_entries(ctx, &writer);
+    batch.magic = CFSTORE_DELTA_LOG_BATCH_MAGIC;
+    batch.length = writer.length;
+    batch.crc = mbed_crc32_final(&writer.crc);
+    if(batch.length == 0){
+        ctx->area_dirty_flag = false;
+        return ARM_DRIVER_OK;
+    }
+    header_len = cfstore_delta_log_round_up(delta, sizeof(batch));
+    batch_len = header_len + cfstore_delta_log_round_up(delta, batch.length);
+    if(batch_len > delta->size - delta->offset){
+        CFSTORE_TP(CFSTORE_TP_FLUSH, "%s:delta log full (offset=%d, batch_len=%d)\n", __func__, (int) delta->offset, (int) batch_len);
+        return ARM_DRIVER_ERROR;
+    }
+    ret = cfstore_delta_log_program_header(delta, delta->offset, &batch, sizeof(batch));
+    if(ret >= ARM_DRIVER_OK){
+        memset(&writer, 0, sizeof(writer));
+        writer.program = true;
+        writer.offset = delta->offset + header_len;
+        cfstore_delta_log_write_entries(ctx, &writer);
+        cfstore_delta_log_write_flush(delta, &writer);
+        ret = writer.status;
+    }
+    if(ret < ARM_DRIVER_OK){
+        CFSTORE_ERRLOG("%s:Error: failed to append to delta log (ret=%d)\n", __func__, (int) ret);
+        /* the batch may be partly programmed so rewrite the area and restart the log */
+        delta->offset += batch_len;
+        delta->valid = false;
+        return ret;
+    }
+    CFSTORE_TP(CFSTORE_TP_FLUSH, "%s:appended %d bytes to delta log at offset %d\n", __func__, (int) batch_len, (int) delta->offset);
+    delta->offset += batch_len;
+    cfstore_delta_log_clean(ctx);
+    ctx->area_dirty_flag = false;
+    cfstore_flash_stats_add(ctx, true, batch_len);
+    return ARM_DRIVER_OK;
+}
+
+/* @brief   start rewriting the area to the flash journal, which will replace
+ *          the blob the delta log applies to */
+static void cfstore_delta_log_compact_begin(cfstore_ctx_t* ctx)
+{
+    ctx->delta.pending_crc = mbed_crc32(0, ctx->area_0_head, ctx->expected_blob_size);
+}
+
+/* @brief   the area has been rewritten to the flash journal, so restart the
+ *          delta log for the new blob */
+static void cfstore_delta_log_compact_end(cfstore_ctx_t* ctx)
+{
+    cfstore_delta_log_reset(ctx, ctx->delta.pending_crc);
+    cfstore_delta_log_clean(ctx);
+}
+
+/* @brief   check the crc32 of the length bytes of batch entries at offset */
+static int32_t cfstore_delta_log_check_batch(uint32_t offset, cfstore_delta_log_batch_t* batch)
+{
+    int32_t ret = ARM_DRIVER_OK;
+    uint32_t pos = 0;
+    uint32_t len = 0;
+    uint8_t buf[CFSTORE_DELTA_LOG_BUF_SIZE];
+    mbed_crc32_t crc;
+
+    mbed_crc32_init(&crc);
+    for(pos = 0; pos < batch->length; pos += len){
+        len = batch->length - pos;
+        len = len < CFSTORE_DELTA_LOG_BUF_SIZE ? len : CFSTORE_DELTA_LOG_BUF_SIZE;
+        ret = cfstore_delta_log_read(offset + pos, buf, len);
+        if(ret < ARM_DRIVER_OK){
+            return ret;
+        }
+        mbed_crc32_update(&crc, buf, len);
+    }
+    if(mbed_crc32_final(&crc) != batch->crc){
+        CFSTORE_ERRLOG("%s:Error: delta log batch crc check failed (offset=%d)\n", __func__, (int) offset);
+        return ARM_DRIVER_ERROR;
+    }
+    return ARM_DRIVER_OK;
+}
+
+/* @brief   remove the KVs called key from the area */
+static int32_t cfstore_delta_log_remove(const uint8_t* key, uint8_t key_len)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+    uint32_t offset = 0;
+    cfstore_area_hkvt_t hkvt;
+    cfstore_ctx_t* ctx = cfstore_ctx_get();
+
+    ret = cfstore_get_head_hkvt(&hkvt);
+    while(ret >= ARM_DRIVER_OK && cfstore_hkvt_is_valid(&hkvt, ctx->area_0_tail)){
+        if(cfstore_hkvt_get_key_len(&hkvt) == key_len && memcmp(hkvt.key, key, key_len) == 0){
+            /* the following KVs move down to offset, and the area may move */
+            offset = (uint32_t) (hkvt.head - ctx->area_0_head);
+            ret = cfstore_delete_ex(&hkvt);
+            if(ret < ARM_DRIVER_OK){
+                return ret;
+            }
+            if(offset >= cfstore_ctx_get_kv_total_len()){
+                break;
+            }
+            hkvt = cfstore_get_hkvt_from_head_ptr(ctx->area_0_head + offset);
+            continue;
+        }
+        ret = cfstore_get_next_hkvt(&hkvt, &hkvt);
+    }
+    return ARM_DRIVER_OK;
+}
+
+/* @brief   apply the length bytes of batch entries at offset to the area */
+static int32_t cfstore_delta_log_apply_batch(uint32_t offset, uint32_t length)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+    uint32_t end = offset + length;
+    ARM_CFSTORE_SIZE kv_total_size = 0;
+    uint8_t* head = NULL;
+    cfstore_area_header_t hdr;
+    uint8_t key[CFSTORE_KEY_NAME_MAX_LENGTH];
+    cfstore_ctx_t* ctx = cfstore_ctx_get();
+
+    while(offset < end){
+        if(end - offset < sizeof(hdr)){
+            return ARM_DRIVER_ERROR;
+        }
+        ret = cfstore_delta_log_read(offset, &hdr, sizeof(hdr));
+        if(ret < ARM_DRIVER_OK){
+            return ret;
+        }
+        offset += sizeof(hdr);
+        if(hdr.klength == 0 || hdr.klength > CFSTORE_KEY_NAME_MAX_LENGTH || hdr.klength > end - offset || hdr.vlength > end - offset - hdr.klength){
+            CFSTORE_ERRLOG("%s:Error: invalid delta log entry (klength=%d, vlength=%d)\n", __func__, (int) hdr.klength, (int) hdr.vlength);
+            return ARM_DRIVER_ERROR;
+        }
+        ret = cfstore_delta_log_read(offset, key, hdr.klength);
+        if(ret < ARM_DRIVER_OK){
+            return ret;
+        }
+        offset += hdr.klength;
+        ret = cfstore_delta_log_remove(key, hdr.klength);
+        if(ret < ARM_DRIVER_OK){
+            return ret;
+        }
+        if(hdr.flags.delete){
+            continue;
+        }
+        /* append the KV to the area, reading the value directly into place */
+        kv_total_size = cfstore_ctx_get_kv_total_len();
+        ret = cfstore_realloc_ex(kv_total_size + sizeof(hdr) + hdr.klength + hdr.vlength, NULL);
+        if(ret < ARM_DRIVER_OK){
+            return ret;
+        }
+        head = ctx->area_0_head + kv_total_size;
+        memcpy(head, &hdr, sizeof(hdr));
+        memcpy(head + sizeof(hdr), key, hdr.klength);
+        if(hdr.vlength > 0){
+            ret = cfstore_delta_log_read(offset, head + sizeof(hdr) + hdr.klength, hdr.vlength);
+            if(ret < ARM_DRIVER_OK){
+                return ret;
+            }
+        }
+        offset += hdr.vlength;
+    }
+    return ARM_DRIVER_OK;
+}
+
+/* @brief   replay the delta log on top of the area read from the flash journal */
+static void cfstore_delta_log_load(cfstore_ctx_t* ctx)
+{
+    int32_t ret = ARM_DRIVER_ERROR;
+    uint32_t i = 0;
+    uint32_t blob_crc = 0;
+    uint32_t header_len = 0;
+    uint32_t batch_len = 0;
+    uint32_t count = 0;
+    cfstore_delta_log_t* delta = &ctx->delta;
+    cfstore_delta_log_header_t header;
+    cfstore_delta_log_batch_t batch;
+
+    CFSTORE_FENTRYLOG("%s:entered\n", __func__);
+    if(delta->size == 0){
+        return;
+    }
+    blob_crc = mbed_crc32(0, ctx->area_0_head, ctx->info.sizeofJournaledBlob);
+    ret = cfstore_delta_log_read(0, &header, sizeof(header));
+    if(ret < ARM_DRIVER_OK || delta->discard || header.magic != CFSTORE_DELTA_LOG_MAGIC || header.base_crc != blob_crc){
+        /* the log doesn't apply to the blob, so erase the whole log and start again */
+        CFSTORE_TP(CFSTORE_TP_INIT, "%s:discarding delta log\n", __func__);
+        delta->discard = false;
+        delta->offset = delta->size;
+        cfstore_delta_log_reset(ctx, blob_crc);
+        return;
+    }
+    delta->base_crc = blob_crc;
+    delta->offset = cfstore_delta_log_round_up(delta, sizeof(header));
+    header_len = cfstore_delta_log_round_up(delta, sizeof(batch));
+    /* replayed changes are already in the log, so delta->valid is set only when done */
+    while(delta->size - delta->offset >= header_len){
+        ret = cfstore_delta_log_read(delta->offset, &batch, sizeof(batch));
+        if(ret < ARM_DRIVER_OK){
+            break;
+        }
+        for(i = 0; i < sizeof(batch) && ((uint8_t*) &batch)[i] == delta->erased_value; i++);
+        if(i == sizeof(batch)){
+            /* end of the log */
+            delta->valid = true;
+            break;
+        }
+        if(batch.magic != CFSTORE_DELTA_LOG_BATCH_MAGIC || batch.length > delta->size - delta->offset - header_len){
+            CFSTORE_ERRLOG("%s:Error: invalid delta log batch header (offset=%d)\n", __func__, (int) delta->offset);
+            ret = ARM_DRIVER_ERROR;
+            break;
+        }
+        ret = cfstore_delta_log_check_batch(delta->offset + header_len, &batch);
+        if(ret < ARM_DRIVER_OK){
+            break;
+        }
+        ret = cfstore_delta_log_apply_batch(delta->offset + header_len, batch.length);
+        if(ret < ARM_DRIVER_OK){
+            CFSTORE_ERRLOG("%s:Error: failed to replay delta log batch (offset=%d, ret=%d)\n", __func__, (int) delta->offset, (int) ret);
+            break;
+        }
+        batch_len = header_len + cfstore_delta_log_round_up(delta, batch.length);
+        delta->offset += batch_len;
+        count++;
+    }
+    if(delta->size - delta->offset < header_len){
+        /* the log is full */
+        delta->valid = true;
+    }
+    if(!delta->valid){
+        /* the next flush rewrites the area and erases the whole log */
+        delta->offset = delta->size;
+    }
+    cfstore_delta_log_clean(ctx);
+    CFSTORE_TP(CFSTORE_TP_INIT, "%s:replayed %d delta log batches (valid=%d)\n", __func__, (int) count, (int) delta->valid);
+}
+
+#else
+
+static CFSTORE_INLINE void cfstore_delta_log_mark(cfstore_area_hkvt_t* hkvt) { (void) hkvt; }
+static CFSTORE_INLINE void cfstore_delta_log_delete(cfstore_area_hkvt_t* hkvt) { (void) hkvt; }
+static CFSTORE_INLINE void cfstore_delta_log_deinit(void) { }
+#ifdef CFSTORE_CONFIG_BACKEND_FLASH_ENABLED
+static CFSTORE_INLINE void cfstore_delta_log_init(cfstore_ctx_t* ctx) { (void) ctx; }
+static CFSTORE_INLINE void cfstore_delta_log_discard(cfstore_ctx_t* ctx) { (void) ctx; }
+static CFSTORE_INLINE int32_t cfstore_delta_log_append(cfstore_ctx_t* ctx) { (void) ctx; return ARM_DRIVER_ERROR; }
+static CFSTORE_INLINE void cfstore_delta_log_compact_begin(cfstore_ctx_t* ctx) { (void) ctx; }
+static CFSTORE_INLINE void cfstore_delta_log_compact_end(cfstore_ctx_t* ctx) { (void) ctx; }
+static CFSTORE_INLINE void cfstore_delta_log_load(cfstore_ctx_t* ctx) { (void) ctx; }
+#endif /* CFSTORE_CONFIG_BACKEND_FLASH_ENABLED */
+
+#endif /* CFSTORE_CONFIG_DELTA_LOG_ENABLED */
+
+
 #ifdef CFSTORE_CONFIG_BACKEND_FLASH_ENABLED
 
 /*
@@ -1620,6 +2788,7 @@ static int32_t cfstore_fsm_init_on_entry(void* context)
         cfstore_fsm_state_set(&ctx->fsm, cfstore_fsm_state_formatting, ctx);
         return ARM_DRIVER_OK;
     }
+    cfstore_delta_log_init(ctx);
 
     ret = FlashJournal_initialize(&ctx->jrnl, (ARM_DRIVER_STORAGE *) &cfstore_journal_mtd, &FLASH_JOURNAL_STRATEGY_SEQUENTIAL, cfstore_flash_journal_callback);
     CFSTORE_TP(CFSTORE_TP_FSM, "%s:FlashJournal_initialize ret=%d\n", __func__, (int) ret);
@@ -1817,6 +2986,13 @@ static int32_t cfstore_fsm_read_on_exit(void* context)
     cfstore_ctx_t* ctx = (cfstore_ctx_t*) context;
 
     CFSTORE_FENTRYLOG("%s:entered:\n", __func__);
+    /* the area has been loaded from flash so replay the changes in the delta
+     * log and index the KVs. If the read failed the index is left invalid, and
+     * finds walk the area */
+    if(ctx->status >= ARM_DRIVER_OK){
+        cfstore_delta_log_load(ctx);
+        cfstore_index_build();
+    }
     /* notify client of initialisation status */
     cfstore_client_notify_data_init(&ctx->client_notify_data, CFSTORE_OPCODE_INITIALIZE, ctx->status, NULL);
     ctx->client_callback_notify_flag = true;
@@ -1851,6 +3027,7 @@ int32_t cfstore_fsm_log_on_entry(void* context)
     /* log the changes to flash even when the area has shrunk to 0, as its necessary to erase the flash */
     if(ctx->area_dirty_flag == true)
     {
+        cfstore_delta_log_compact_begin(ctx);
         if(ctx->expected_blob_size > 0){
             CFSTORE_TP(CFSTORE_TP_FLUSH, "%s:logging: ctx->area_0_head=%p, ctx->expected_blob_size-%d\n", __func__, ctx->area_0_head, (int) ctx->expected_blob_size);
             ret = FlashJournal_log(&ctx->jrnl, (const void*) ctx->area_0_head, ctx->expected_blob_size);
@@ -2000,6 +3177,10 @@ static int32_t cfstore_fsm_commit_on_exit(void* context)
     cfstore_ctx_t* ctx = (cfstore_ctx_t*) context;
 
     CFSTORE_FENTRYLOG("%s:entered:\n", __func__);
+    if(ctx->status >= ARM_DRIVER_OK && ctx->area_dirty_flag == true){
+        cfstore_flash_stats_add(ctx, false, (uint32_t) ctx->expected_blob_size);
+        cfstore_delta_log_compact_end(ctx);
+    }
     ctx->area_dirty_flag = false;
     /* notify client of commit status */
     cfstore_client_notify_data_init(&ctx->client_notify_data, CFSTORE_OPCODE_FLUSH, ctx->status, NULL);
@@ -2015,7 +3196,16 @@ static int32_t cfstore_fsm_commit_on_exit(void* context)
 static int32_t cfstore_fsm_ready_on_commit_req(void* context)
 {
     cfstore_ctx_t* ctx = (cfstore_ctx_t*) context;
+    cfstore_client_notify_data_t notify_data;
+
     CFSTORE_FENTRYLOG("%s:entered\n", __func__);
+    /* appending the changes to the delta log completes synchronously. If that
+     * isn't possible then rewrite the whole area to the flash journal */
+    if(cfstore_delta_log_append(ctx) >= ARM_DRIVER_OK){
+        cfstore_client_notify_data_init(&notify_data, CFSTORE_OPCODE_FLUSH, ARM_DRIVER_OK, NULL);
+        cfstore_ctx_client_notify(ctx, &notify_data);
+        return ARM_DRIVER_OK;
+    }
     return cfstore_fsm_state_set(&ctx->fsm, cfstore_fsm_state_logging, ctx);
 }
 
@@ -2033,6 +3223,7 @@ static int32_t cfstore_fsm_format_on_entry(void* context)
 
     CFSTORE_FENTRYLOG("%s:entered\n", __func__);
 
+    cfstore_delta_log_discard(ctx);
     ret = flashJournalStrategySequential_format((ARM_DRIVER_STORAGE *) &cfstore_journal_mtd, CFSTORE_FLASH_NUMSLOTS, cfstore_flash_journal_callback);
     CFSTORE_TP(CFSTORE_TP_FSM, "%s:flashJournalStrategySequential_format ret=%d\n", __func__, (int) ret);
     if(ret < ARM_DRIVER_OK){
@@ -2224,6 +3415,10 @@ static int32_t cfstore_flash_init(void)
     ctx->fsm.event = cfstore_fsm_event_max;
     ctx->fsm.state = cfstore_fsm_state_stopped;
     memset(&ctx->info, 0, sizeof(ctx->info));
+    memset(&ctx->flush_stats, 0, sizeof(ctx->flush_stats));
+#ifdef CFSTORE_CONFIG_DELTA_LOG_ENABLED
+    memset(&ctx->delta, 0, sizeof(ctx->delta));
+#endif /* CFSTORE_CONFIG_DELTA_LOG_ENABLED */
     ret = cfstore_fsm_state_set(&ctx->fsm, cfstore_fsm_state_initing, ctx);
     if(ret < 0){
         CFSTORE_DBGLOG("%s:Error: cfstore_fsm_state_set() failed\n", __func__);
@@ -2292,6 +3487,7 @@ static int32_t cfstore_flash_init(void)
     cfstore_ctx_t* ctx = cfstore_ctx_get();
 
     CFSTORE_FENTRYLOG("%s:SRAM:entered:\n", __func__);
+    cfstore_index_build();
     cfstore_client_notify_data_init(&notify_data, CFSTORE_OPCODE_INITIALIZE, ARM_DRIVER_OK, NULL);
     cfstore_ctx_client_notify(ctx, &notify_data);
     return ARM_DRIVER_OK;
@@ -2372,7 +3568,11 @@ static int32_t cfstore_delete_ex(cfstore_area_hkvt_t* hkvt)
      *     start of heap block to a new location, in which case all cfstore_file_t::head pointers
      *     need to be updated. cfstore_realloc() can only do this starting from a set of correct
      *     cfstore_file_t::head pointers i.e. after 1. has been completed.
+     *  3. The index and delta log are updated before the memmove() as they need the key name of
+     *     the deleted KV.
      */
+    cfstore_index_remove((uint32_t) (hkvt->head - ctx->area_0_head), kv_size);
+    cfstore_delta_log_delete(hkvt);
     memmove(hkvt->head, hkvt->tail, ctx->area_0_tail - hkvt->tail);
     /* zero the deleted KV memory */
     memset(ctx->area_0_tail-kv_size, 0, kv_size);
@@ -3098,6 +4298,7 @@ static int32_t cfstore_delete(ARM_CFSTORE_HANDLE hkey)
     cfstore_hkvt_set_flags_delete(&hkvt, true);
 
     /* set the dirty flag so the changes are persisted to backing store when flushed */
+    cfstore_delta_log_mark(&hkvt);
     ctx->area_dirty_flag = true;
 
 out0:
@@ -3130,6 +4331,9 @@ static int32_t cfstore_find_ex(const char* key_name_query, cfstore_area_hkvt_t *
     cfstore_ctx_t* ctx = cfstore_ctx_get();
 
     CFSTORE_TP((CFSTORE_TP_FIND|CFSTORE_TP_FENTRY), "%s:entered: key_name_query=\"%s\", prev=%p, next=%p\n", __func__, key_name_query, prev, next);
+    if(cfstore_index_find(key_name_query, prev, next, &ret)){
+        return ret;
+    }
     if(prev == NULL){
         ret = cfstore_get_head_hkvt(next);
         /* CFSTORE_TP(CFSTORE_TP_FIND, "%s:next->head=%p, next->key=%p, next->value=%p, next->tail=%p, \n", __func__, next->head, next->key, next->value, next->tail); */
@@ -3360,6 +4564,7 @@ static int32_t cfstore_recreate(const char* key_name, ARM_CFSTORE_SIZE value_len
     if (kv_size_diff < 0){
         /* value blob size shrinking => do memmove() before realloc() which will free memory */
         memmove(hkvt->tail + kv_size_diff, hkvt->tail, memmove_len);
+        cfstore_index_shift((uint32_t) (hkvt->head - ctx->area_0_head), kv_size_diff);
         ret = cfstore_file_update(hkvt->head, kv_size_diff);
         if(ret < ARM_DRIVER_OK){
             CFSTORE_ERRLOG("%s:Error:file update failed\n", __func__);
@@ -3383,6 +4588,7 @@ static int32_t cfstore_recreate(const char* key_name, ARM_CFSTORE_SIZE value_len
     if(kv_size_diff > 0) {
         /* value blob size growing requires memmove() after realloc() */
         memmove(hkvt->tail+kv_size_diff, hkvt->tail, memmove_len);
+        cfstore_index_shift((uint32_t) (hkvt->head - ctx->area_0_head), kv_size_diff);
         ret = cfstore_file_update(hkvt->head, kv_size_diff);
         if(ret < ARM_DRIVER_OK){
             CFSTORE_ERRLOG("%s:Error:file update failed\n", __func__);
@@ -3395,6 +4601,7 @@ static int32_t cfstore_recreate(const char* key_name, ARM_CFSTORE_SIZE value_len
     /* set the new value length in the header */
     cfstore_hkvt_set_value_len(hkvt, value_len);
     cfstore_file_create(hkvt, flags, hkey, &ctx->file_list);
+    cfstore_delta_log_mark(hkvt);
     ctx->area_dirty_flag = true;
 
 #ifdef CFSTORE_DEBUG
@@ -3527,6 +4734,7 @@ static int32_t cfstore_create(const char* key_name, ARM_CFSTORE_SIZE value_len,
     hdr->perm_other_write = kdesc->acl.perm_other_write;
     hdr->perm_other_execute = kdesc->acl.perm_other_execute;
     strncpy((char*)hdr + sizeof(cfstore_area_header_t), key_name, strlen(key_name));
+    cfstore_index_insert((uint32_t) area_size);
     hkvt = cfstore_get_hkvt_from_head_ptr((uint8_t*) hdr);
     if(cfstore_flags_is_default(kdesc->flags)){
         /* set as read-only by default default */
@@ -3537,6 +4745,7 @@ static int32_t cfstore_create(const char* key_name, ARM_CFSTORE_SIZE value_len,
         flags.write = kdesc->flags.write;
     }
     cfstore_file_create(&hkvt, flags, hkey, &ctx->file_list);
+    cfstore_delta_log_mark(&hkvt);
     ctx->area_dirty_flag = true;
     ret = ARM_DRIVER_OK;
 out1:
@@ -3826,6 +5035,7 @@ static int32_t cfstore_write(ARM_CFSTORE_HANDLE hkey, const char* data, ARM_CFST
     memcpy(hkvt.value + file->wlocation, data, *len);
     file->wlocation += *len;
     cfstore_hkvt_dump(&hkvt, __func__);
+    cfstore_delta_log_mark(&hkvt);
     ctx->area_dirty_flag = true;
     ret = *len;
 out0:
@@ -4046,6 +5256,8 @@ static int32_t cfstore_uninitialise(void)
             ctx->area_0_head = NULL;
             ctx->area_0_tail = NULL;
         }
+        cfstore_index_destroy();
+        cfstore_delta_log_deinit();
     }
 out:
     /* notify client */
@@ -4083,6 +5295,26 @@ out0:
 }
 
 
+/* @brief  See definition in configuration_store.h for description. */
+int32_t cfstore_get_flush_stats(ARM_CFSTORE_FLUSH_STATS* stats)
+{
+    cfstore_ctx_t* ctx = cfstore_ctx_get();
+
+    CFSTORE_FENTRYLOG("%s:entered\n", __func__);
+    CFSTORE_ASSERT(stats != NULL);
+    if(!cfstore_ctx_is_initialised(ctx)) {
+        CFSTORE_ERRLOG("%s:Error: CFSTORE is not initialised.\n", __func__);
+        return ARM_CFSTORE_DRIVER_ERROR_UNINITIALISED;
+    }
+#ifdef CFSTORE_CONFIG_BACKEND_FLASH_ENABLED
+    memcpy(stats, &ctx->flush_stats, sizeof(ARM_CFSTORE_FLUSH_STATS));
+#else
+    memset(stats, 0, sizeof(ARM_CFSTORE_FLUSH_STATS));
+#endif /* CFSTORE_CONFIG_BACKEND_FLASH_ENABLED */
+    return ARM_DRIVER_OK;
+}
+
+
 #ifdef YOTTA_CFG_CFSTORE_UVISOR
 
 /*
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2006-2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __FLASH_JOURNAL_RING_PRIVATE_H__
+#define __FLASH_JOURNAL_RING_PRIVATE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "flash-journal/flash_journal.h"
+
+static const uint32_t RING_FLASH_JOURNAL_HEADER_MAGIC     = 0xCEA0121BUL;
+static const uint32_t RING_FLASH_JOURNAL_HEADER_VERSION   = 1;
+static const uint32_t RING_FLASH_JOURNAL_RECORD_MAGIC     = 0xCE0212A1UL;
+static const uint32_t RING_FLASH_JOURNAL_CHECKPOINT_MAGIC = 0xCE0212C7UL;
+
+/** Number of sectors between the journal header and the ring, holding checkpoint records. */
+#define RING_FLASH_JOURNAL_CHECKPOINT_SECTORS       2
+/** Smallest number of sectors in the ring. */
+#define RING_FLASH_JOURNAL_MIN_SECTORS              4
+/** Default number of commits between checkpoints. */
+#define RING_FLASH_JOURNAL_DEFAULT_CHECKPOINT_INTERVAL 16
+
+typedef enum {
+    RING_JOURNAL_STATE_NOT_INITIALIZED,
+    RING_JOURNAL_STATE_INITIALIZED,
+    RING_JOURNAL_STATE_RESETING,
+    RING_JOURNAL_STATE_LOGGING,         /**< programming the body of a record. */
+    RING_JOURNAL_STATE_COMMITTING,      /**< programming the head of a record. */
+    RING_JOURNAL_STATE_CHECKPOINTING,   /**< recording a committed record as a checkpoint. */
+    RING_JOURNAL_STATE_ERASING_AHEAD,   /**< erasing the sector ahead of the writer after a commit. */
+    RING_JOURNAL_STATE_READING,
+} RingFlashJournalState_t;
+
+/**
+ * The storage operation currently issued (or about to be issued) on behalf of
+ * the command in progress.
+ */
+typedef enum {
+    RING_JOURNAL_IO_NONE,
+    RING_JOURNAL_IO_ERASE,              /**< erase the ring from erasedPosition up to the next sector boundary. */
+    RING_JOURNAL_IO_PROGRAM,            /**< program the body or head of the record being logged. */
+    RING_JOURNAL_IO_CHECKPOINT_ERASE,   /**< erase the checkpoint sector about to be written. */
+    RING_JOURNAL_IO_CHECKPOINT_PROGRAM, /**< program a checkpoint record. */
+    RING_JOURNAL_IO_READ,
+    RING_JOURNAL_IO_RESET_ERASE,        /**< erase the checkpoint sectors and the ring. */
+} RingFlashJournalIo_t;
+
+/**
+ * Meta-data placed at the head of a ring journal, in a sector of its own.
+ */
+typedef struct _RingFlashJournalHeader {
+    FlashJournalHeader_t genericHeader;      /** Generic meta-data placed at the head of a Journal; common to all journal types. */
+    uint32_t             magic;              /** Ring journal header specific magic code. */
+    uint32_t             version;            /** Revision number for this ring journal header. */
+    uint32_t             sizeofSector;       /** Size of a sector; a multiple of the erase units of all the storage blocks. */
+    uint32_t             numSectors;         /** Number of sectors in the ring. */
+    uint32_t             checkpointInterval; /** Number of commits between checkpoints. */
+    uint32_t             reserved[3];
+} RingFlashJournalHeader_t;
+
+/**
+ * Meta-data placed at the head of a record in the ring. The body of the
+ * record follows immediately.
+ *
+ * @note the body is programmed before the head, so a record with a valid
+ *     head has a complete body. headCrc32 is placed last so that a partially
+ *     programmed head isn't accepted as valid.
+ */
+typedef struct _RingFlashJournalRecordHead {
+    uint32_t magic;
+    uint32_t sequenceNumber;
+    uint32_t sizeofBlob;     /**< the size of the payload in this record. */
+    uint32_t blobCrc32;      /**< CRC32 of the payload. */
+    uint32_t reserved;
+    uint32_t headCrc32;      /**< CRC32 of the preceding fields. */
+} RingFlashJournalRecordHead_t;
+
+/**
+ * A checkpoint names a committed record from which initialization starts its
+ * scan of the ring. Checkpoints are appended to the checkpoint sectors, which
+ * are used alternately.
+ */
+typedef struct _RingFlashJournalCheckpoint {
+    uint32_t magic;
+    uint32_t sequenceNumber; /**< sequence number of the record. */
+    uint64_t position;       /**< position of the record in the log. */
+    uint32_t reserved;
+    uint32_t crc32;          /**< CRC32 of the preceding fields. */
+} RingFlashJournalCheckpoint_t;
+
+/**
+ * Positions in the log increase monotonically as records are appended, and
+ * map onto the ring modulo its size.
+ */
+typedef struct _RingFlashJournal_t {
+    FlashJournal_Ops_t             ops;                      /**< the mandatory OPS table defining the strategy. */
+    FlashJournal_Callback_t        callback;                 /**< command completion callback. */
+    ARM_DRIVER_STORAGE            *mtd;                      /**< The underlying Memory-Technology-Device. */
+    ARM_STORAGE_CAPABILITIES       mtdCapabilities;          /**< the return from mtd->GetCapabilities(); held for quick reference. */
+    uint32_t                       programUnit;              /**< the MTD's program_unit. */
+    uint64_t                       mtdStartOffset;           /**< the start of the address range maintained by the underlying MTD. */
+    uint32_t                       sizeofSector;             /**< size of a sector, the unit in which the ring is erased. */
+    uint32_t                       numSectors;               /**< number of sectors in the ring. */
+    uint32_t                       sizeofJournaledBlob;      /**< size of the most recently committed blob. */
+    uint32_t                       checkpointInterval;       /**< number of commits between checkpoints. */
+    uint32_t                       checkpointSlot;           /**< index of the next free checkpoint slot. */
+    uint32_t                       checkpointSequenceNumber; /**< sequence number of the checkpointed record. */
+    uint64_t                       checkpointPosition;       /**< position of the checkpointed record; no sector at or after it may be erased. */
+    uint64_t                       livePosition;             /**< position of the most recently committed record, or ARM_STORAGE_INVALID_OFFSET. */
+    uint64_t                       writePosition;            /**< position following the most recently committed record. */
+    uint64_t                       erasedPosition;           /**< the log is erased from writePosition up to this position. */
+    uint32_t                       nextSequenceNumber;       /**< the sequence number of the next record to be committed. */
+    uint8_t                        state;                    /**< RingFlashJournalState_t */
+    uint8_t                        io;                       /**< RingFlashJournalIo_t */
+    uint8_t                        prevCommand;              /**< FlashJournal_OpCode_t of the last command issued to the journal. */
+    uint8_t                        erasedValue;              /**< the value of an erased byte. */
+
+    /**
+     * The following is a union of sub-structures meant to keep state relevant
+     * to the commands during their execution.
+     */
+    union {
+        /** state relevant to logging and committing a record. */
+        struct {
+            uint64_t       recordPosition;  /**< position of the record being logged. */
+            uint64_t       position;        /**< position at which the next data will be programmed. */
+            const uint8_t *dataBeingLogged; /**< the next data to be programmed. */
+            uint32_t       amountLeftToLog;
+            uint32_t       blobCrc32;       /**< CRC32 of the payload logged so far. */
+            uint32_t       amountLogged;    /**< the amount to be reported on completion of log(). */
+            union {
+                RingFlashJournalRecordHead_t head;       /**< head being programmed by commit. */
+                RingFlashJournalCheckpoint_t checkpoint; /**< checkpoint being programmed. */
+            };
+        } log;
+
+        /** state relevant to read-back of data. */
+        struct {
+            uint64_t       position;         /**< the position from which the next data will be read. */
+            const uint8_t *blob;             /**< the original buffer receiving data. */
+            uint8_t       *dataBeingRead;    /**< the next data to be read-into. */
+            uint32_t       amountLeftToRead;
+            uint32_t       logicalOffset;    /**< the logical offset within the blob at which the next read will occur. */
+        } read;
+
+        /** state relevant to reset. */
+        struct {
+            uint64_t       mtdEraseOffset;
+        } reset;
+    };
+} RingFlashJournal_t;
+
+/**<
+ * A static assert to ensure that the size of RingFlashJournal_t is smaller than
+ * FlashJournal_t. The caller will only allocate a FlashJournal_t and expect the
+ * Ring Strategy to reuse that space for a RingFlashJournal_t.
+ */
+typedef char AssertRingJournalSizeLessThanOrEqualToGenericJournal[sizeof(RingFlashJournal_t)<=sizeof(FlashJournal_t)?1:-1];
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif /* __FLASH_JOURNAL_RING_PRIVATE_H__ */
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2006-2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __FLASH_JOURNAL_STRATEGY_RING_H__
+#define __FLASH_JOURNAL_STRATEGY_RING_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "flash-journal/flash_journal.h"
+
+/**
+ * Create/format a ring flash journal over a storage device.
+ *
+ * Where the sequential journal rewrites a whole slot for every commit, the
+ * ring journal appends each committed blob as a variable-sized record to a
+ * circular log spanning all the sectors of the device, so a small blob only
+ * costs an erase once a sector's worth of records has been written. Sectors
+ * are erased ahead of the writer at the end of each commit, so that log()
+ * normally only has to program.
+ *
+ * Every 'checkpointInterval' commits the most recent record is noted in a
+ * checkpoint. Initialization reads only the journal header, the latest
+ * checkpoint (found with a binary search of the checkpoint sector) and the
+ * records committed after it, so mount time doesn't grow with the size of the
+ * journal. A larger interval means fewer checkpoint writes at the cost of a
+ * longer scan during initialization.
+ *
+ * Reads from the storage device must complete synchronously. initialize()
+ * fails with JOURNAL_STATUS_ERROR if the MTD's Initialize or the read of the
+ * journal header is left pending, and any other ReadData the MTD defers fails
+ * the operation with JOURNAL_STATUS_UNSUPPORTED. Program and erase operations
+ * may be asynchronous.
+ *
+ * This function must be called *once* for each incarnation of a ring journal.
+ * It erases the entire device.
+ *
+ * @param[in] mtd
+ *              The underlying Storage driver. Its program_unit must divide the
+ *              24 byte record header (i.e. be at most 8).
+ *
+ * @param[in] checkpointInterval
+ *              Number of commits between checkpoints; 0 selects the default.
+ *
+ * @param[in] callback
+ *                Caller-defined callback to be invoked upon command completion
+ *                in case the storage device executes operations asynchronously.
+ *                Use a NULL pointer when no callback signals are required.
+ *
+ * @note: this is an asynchronous operation, but it can finish
+ * synchronously if the underlying MTD supports that.
+ *
+ * @return
+ *   The function executes in the following ways:
+ *   - When the operation is asynchronous, the function only starts the
+ *     format and control returns to the caller with an JOURNAL_STATUS_OK
+ *     before the actual completion of the operation (or with an appropriate
+ *     error code in case of failure). When the operation is completed the
+ *     command callback is invoked with 1 passed in as the 'status' parameter
+ *     of the callback. In case of errors, the completion callback is invoked
+ *     with an error status.
+ *   - When the operation is executed by the journal in a blocking (i.e.
+ *     synchronous) manner, control returns to the caller only upon the actual
+ *     completion of the operation or the discovery of a failure condition. In
+ *     this case, the function returns 1 to signal successful synchronous
+ *     completion or an appropriate error code, and no further
+ *     invocation of the completion callback should be expected at a later time.
+ *
+ *     +-------------------------------+    ^
+ *     |  Journal Header               |    |   one sector
+ *     |  starts with generic header   |    |
+ *     |  followed by specific header  |    |
+ *     +-------------------------------+    v
+ *     +-------------------------------+    ^
+ *     |  checkpoint | checkpoint | ...|    |   two sectors, used alternately;
+ *     +-------------------------------+    |   checkpoints are appended in
+ *     |  checkpoint | ...             |    |   program_unit aligned slots
+ *     +-------------------------------+    v
+ *     +-------------------------------+    ^
+ *     | record head | BLOB n          |    |
+ *     |      | record head | BLOB n+1 |    |   the ring: the remaining sectors.
+ *     | ...                           |    |   Records are packed end to end and
+ *     |  record head | BLOB n+2       |    |   may wrap from the last sector to
+ *     | ...  <- erased ahead of the   |    |   the first.
+ *     |         writer                |    |
+ *     +-------------------------------+    v
+ */
+int32_t               flashJournalStrategyRing_format(ARM_DRIVER_STORAGE      *mtd,
+                                                      uint32_t                 checkpointInterval,
+                                                      FlashJournal_Callback_t  callback);
+
+int32_t               flashJournalStrategyRing_initialize(FlashJournal_t           *journal,
+                                                          ARM_DRIVER_STORAGE       *mtd,
+                                                          const FlashJournal_Ops_t *ops,
+                                                          FlashJournal_Callback_t   callback);
+FlashJournal_Status_t flashJournalStrategyRing_getInfo(FlashJournal_t *journal, FlashJournal_Info_t *info);
+int32_t               flashJournalStrategyRing_read(FlashJournal_t *journal, void *blob, size_t n);
+int32_t               flashJournalStrategyRing_readFrom(FlashJournal_t *journal, size_t offset, void *blob, size_t n);
+int32_t               flashJournalStrategyRing_log(FlashJournal_t *journal, const void *blob, size_t n);
+int32_t               flashJournalStrategyRing_commit(FlashJournal_t *journal);
+int32_t               flashJournalStrategyRing_reset(FlashJournal_t *journal);
+
+static const FlashJournal_Ops_t FLASH_JOURNAL_STRATEGY_RING = {
+    flashJournalStrategyRing_initialize,
+    flashJournalStrategyRing_getInfo,
+    flashJournalStrategyRing_read,
+    flashJournalStrategyRing_readFrom,
+    flashJournalStrategyRing_log,
+    flashJournalStrategyRing_commit,
+    flashJournalStrategyRing_reset
+};
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif /* __FLASH_JOURNAL_STRATEGY_RING_H__ */
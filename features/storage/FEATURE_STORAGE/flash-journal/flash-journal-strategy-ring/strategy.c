@@ -0,0 +1,1147 @@
+/*
+ * Copyright (c) 2006-2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The ring journal appends each committed blob to a circular log as a record:
+ * a head followed by the blob. Records are packed end to end; the next record
+ * starts where the previous one ended (skipping to the start of the ring if
+ * its head wouldn't fit before the end), or at the following sector boundary
+ * if that position is unusable because a record there was abandoned. The body
+ * of a record is programmed as it is logged, and the head, which makes the
+ * record valid, is programmed by commit.
+ *
+ * Positions in the log only ever increase, so it's easy to tell whether a
+ * sector about to be erased still holds records needed by initialization:
+ * every record from the checkpointed one onwards must be kept, as
+ * initialization scans forward from the checkpoint to find the most recent
+ * record. When the writer catches up with the checkpoint, a new checkpoint is
+ * written for the most recent record, freeing the sectors before it.
+ */
+
+#include "flash-journal-strategy-ring/flash_journal_ring_private.h"
+#include "flash-journal-strategy-ring/flash_journal_strategy_ring.h"
+#include "platform/mbed_crc32.h"
+#include <stddef.h>
+#include <string.h>
+
+static RingFlashJournal_t *activeRingJournal;
+
+/* The following singleton captures the state of the format machine. Format is
+ * handled differently because it executes even before a journal exists (or a
+ * Journal_t can be initialized. */
+static struct {
+    ARM_DRIVER_STORAGE       *mtd;
+    RingFlashJournalHeader_t  header;
+    FlashJournal_Callback_t   callback;
+    uint64_t                  mtdAddr;
+    uint64_t                  mtdEraseOffset;
+} ringFormatInfo;
+
+static void    ringMtdHandler(int32_t status, ARM_STORAGE_OPERATION operation);
+static void    ringFormatHandler(int32_t status, ARM_STORAGE_OPERATION operation);
+static int32_t ringProgress(RingFlashJournal_t *journal);
+static int32_t flashJournalStrategyRing_format_progress(int32_t status, ARM_STORAGE_OPERATION operationWhichJustFinshed);
+
+
+static inline uint64_t roundUp_uint64(uint64_t N, uint64_t BOUNDARY) {
+    return (((N + BOUNDARY - 1) / BOUNDARY) * BOUNDARY);
+}
+
+static inline uint64_t roundDown_uint64(uint64_t N, uint64_t BOUNDARY) {
+    return ((N / BOUNDARY) * BOUNDARY);
+}
+
+static inline uint64_t ringSize(const RingFlashJournal_t *journal)
+{
+    return (uint64_t)journal->numSectors * journal->sizeofSector;
+}
+
+/* Largest blob which is guaranteed to fit alongside the most recent one. */
+static inline uint32_t ringCapacity(const RingFlashJournal_t *journal)
+{
+    return ((journal->numSectors / 2) - 1) * journal->sizeofSector - sizeof(RingFlashJournalRecordHead_t);
+}
+
+static inline uint32_t checkpointSlotsPerSector(const RingFlashJournal_t *journal)
+{
+    return journal->sizeofSector / sizeof(RingFlashJournalCheckpoint_t);
+}
+
+/* Storage address of a position in the log. */
+static inline uint64_t ringAddress(const RingFlashJournal_t *journal, uint64_t position)
+{
+    return journal->mtdStartOffset
+           + (1 + RING_FLASH_JOURNAL_CHECKPOINT_SECTORS) * (uint64_t)journal->sizeofSector
+           + (position % ringSize(journal));
+}
+
+static inline uint64_t checkpointAddress(const RingFlashJournal_t *journal, uint32_t slot)
+{
+    uint32_t sector = slot / checkpointSlotsPerSector(journal);
+    return journal->mtdStartOffset
+           + (uint64_t)(1 + sector) * journal->sizeofSector
+           + (slot % checkpointSlotsPerSector(journal)) * sizeof(RingFlashJournalCheckpoint_t);
+}
+
+/* Number of bytes from a position to the end of the ring. */
+static inline uint64_t ringLeft(const RingFlashJournal_t *journal, uint64_t position)
+{
+    return ringSize(journal) - (position % ringSize(journal));
+}
+
+/* The position at which a record following 'position' starts; a record head never wraps. */
+static inline uint64_t ringRecordPosition(const RingFlashJournal_t *journal, uint64_t position)
+{
+    if (ringLeft(journal, position) < sizeof(RingFlashJournalRecordHead_t)) {
+        position += ringLeft(journal, position);
+    }
+    return position;
+}
+
+static inline int32_t storageStatus(int32_t rc)
+{
+    return (rc == ARM_STORAGE_ERROR_RUNTIME_OR_INTEGRITY_FAILURE) ?
+               JOURNAL_STATUS_STORAGE_RUNTIME_OR_INTEGRITY_FAILURE : JOURNAL_STATUS_STORAGE_IO_ERROR;
+}
+
+static int32_t ringMtdGetStartAddr(ARM_DRIVER_STORAGE *mtd, uint64_t *startAddrP)
+{
+    ARM_STORAGE_BLOCK mtdBlock;
+    if ((mtd->GetNextBlock(NULL, &mtdBlock)) != ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_STORAGE_API_ERROR;
+    }
+    if (!ARM_STORAGE_VALID_BLOCK(&mtdBlock)) {
+        return JOURNAL_STATUS_ERROR;
+    }
+
+    *startAddrP = mtdBlock.addr;
+    return JOURNAL_STATUS_OK;
+}
+
+/**
+ * Determine the sector size: the least common multiple of the erase units of
+ * all the storage blocks, and at least large enough to hold the journal header.
+ */
+static int32_t ringMtdGetSectorSize(ARM_DRIVER_STORAGE *mtd, uint32_t *sizeofSectorP)
+{
+    ARM_STORAGE_BLOCK block;
+    ARM_STORAGE_BLOCK prevBlock;
+    uint32_t sizeofSector = 1;
+
+    for (int32_t rc = mtd->GetNextBlock(NULL, &block);
+         (rc == ARM_DRIVER_OK) && ARM_STORAGE_VALID_BLOCK(&block);
+         rc = mtd->GetNextBlock(&prevBlock, &block)) {
+        prevBlock = block;
+
+        uint32_t a = sizeofSector;
+        uint32_t b = block.attributes.erase_unit;
+        if (!block.attributes.erasable || (b == 0)) {
+            return JOURNAL_STATUS_PARAMETER;
+        }
+        while (b != 0) {
+            uint32_t t = a % b;
+            a = b;
+            b = t;
+        }
+        sizeofSector = (sizeofSector / a) * block.attributes.erase_unit;
+    }
+    while (sizeofSector < sizeof(RingFlashJournalHeader_t)) {
+        sizeofSector *= 2;
+    }
+
+    *sizeofSectorP = sizeofSector;
+    return JOURNAL_STATUS_OK;
+}
+
+/**
+ * Read from the log into a buffer, wrapping around the end of the ring.
+ * This is only used during initialization and read() sanity checks, and
+ * requires synchronous completion.
+ */
+static int32_t ringReadData(RingFlashJournal_t *journal, uint64_t position, void *buffer, uint32_t size)
+{
+    uint8_t *data = (uint8_t *)buffer;
+
+    while (size) {
+        uint32_t xfer = (ringLeft(journal, position) < size) ? (uint32_t)ringLeft(journal, position) : size;
+        int32_t rc = journal->mtd->ReadData(ringAddress(journal, position), data, xfer);
+        if (rc != (int32_t)xfer) {
+            if ((rc == ARM_DRIVER_OK) && journal->mtdCapabilities.asynchronous_ops) {
+                return JOURNAL_STATUS_UNSUPPORTED;
+            }
+            return JOURNAL_STATUS_STORAGE_IO_ERROR;
+        }
+        position += xfer;
+        data     += xfer;
+        size     -= xfer;
+    }
+
+    return JOURNAL_STATUS_OK;
+}
+
+/**
+ * Look for the record with a given sequence number at a position, or else at
+ * the next sector boundary.
+ *
+ * @param [out] headP
+ *                  the head of the record.
+ * @param [out] recordPositionP
+ *                  the position of the record.
+ * @return 1 if the record was found, 0 if not, or an error.
+ */
+static int32_t ringFindRecord(RingFlashJournal_t           *journal,
+                              uint64_t                      position,
+                              uint32_t                      sequenceNumber,
+                              RingFlashJournalRecordHead_t *headP,
+                              uint64_t                     *recordPositionP)
+{
+    int32_t rc;
+
+    for (unsigned probe = 0; probe < 2; probe++) {
+        if ((rc = ringReadData(journal, position, headP, sizeof(RingFlashJournalRecordHead_t))) != JOURNAL_STATUS_OK) {
+            return rc;
+        }
+        if ((headP->magic          == RING_FLASH_JOURNAL_RECORD_MAGIC) &&
+            (headP->sequenceNumber == sequenceNumber)                  &&
+            (headP->sizeofBlob     <= ringCapacity(journal))           &&
+            (headP->headCrc32      == mbed_crc32(0, headP, offsetof(RingFlashJournalRecordHead_t, headCrc32)))) {
+            *recordPositionP = position;
+            return 1;
+        }
+
+        if ((position % journal->sizeofSector) == 0) {
+            break;
+        }
+        position = roundUp_uint64(position, journal->sizeofSector);
+    }
+
+    return 0;
+}
+
+/* Verify the body of a record against the CRC32 in its head. */
+static int32_t ringRecordBodyIsSane(RingFlashJournal_t *journal, uint64_t recordPosition, const RingFlashJournalRecordHead_t *headP)
+{
+    #define CRC_CHUNK_SIZE 64
+    uint8_t  crcBuffer[CRC_CHUNK_SIZE];
+    uint32_t crc32 = 0;
+    uint64_t position = recordPosition + sizeof(RingFlashJournalRecordHead_t);
+    uint32_t amountLeft = headP->sizeofBlob;
+    int32_t  rc;
+
+    while (amountLeft) {
+        uint32_t xfer = (amountLeft < CRC_CHUNK_SIZE) ? amountLeft : CRC_CHUNK_SIZE;
+        if ((rc = ringReadData(journal, position, crcBuffer, xfer)) != JOURNAL_STATUS_OK) {
+            return rc;
+        }
+        crc32       = mbed_crc32(crc32, crcBuffer, xfer);
+        position   += xfer;
+        amountLeft -= xfer;
+    }
+
+    return (crc32 == headP->blobCrc32) ? 1 : JOURNAL_STATUS_ERROR;
+}
+
+static int32_t ringReadCheckpoint(RingFlashJournal_t *journal, uint32_t slot, RingFlashJournalCheckpoint_t *checkpointP)
+{
+    int32_t rc = journal->mtd->ReadData(checkpointAddress(journal, slot), checkpointP, sizeof(RingFlashJournalCheckpoint_t));
+    if (rc != sizeof(RingFlashJournalCheckpoint_t)) {
+        if ((rc == ARM_DRIVER_OK) && journal->mtdCapabilities.asynchronous_ops) {
+            return JOURNAL_STATUS_UNSUPPORTED;
+        }
+        return JOURNAL_STATUS_STORAGE_IO_ERROR;
+    }
+
+    return JOURNAL_STATUS_OK;
+}
+
+static inline bool ringCheckpointIsValid(const RingFlashJournalCheckpoint_t *checkpointP)
+{
+    return (checkpointP->magic == RING_FLASH_JOURNAL_CHECKPOINT_MAGIC) &&
+           (checkpointP->crc32 == mbed_crc32(0, checkpointP, offsetof(RingFlashJournalCheckpoint_t, crc32)));
+}
+
+static inline bool ringCheckpointIsBlank(const RingFlashJournal_t *journal, const RingFlashJournalCheckpoint_t *checkpointP)
+{
+    const uint8_t *p = (const uint8_t *)checkpointP;
+    for (unsigned i = 0; i < sizeof(RingFlashJournalCheckpoint_t); i++) {
+        if (p[i] != journal->erasedValue) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Find the latest checkpoint. Each checkpoint sector is filled in order, so
+ * the active sector is the one whose first checkpoint is the more recent, and
+ * its used slots are a prefix found with a binary search.
+ */
+static int32_t ringLoadCheckpoint(RingFlashJournal_t *journal)
+{
+    RingFlashJournalCheckpoint_t checkpoint[RING_FLASH_JOURNAL_CHECKPOINT_SECTORS];
+    bool     valid[RING_FLASH_JOURNAL_CHECKPOINT_SECTORS];
+    uint32_t slotsPerSector = checkpointSlotsPerSector(journal);
+    int32_t  rc;
+
+    for (unsigned sector = 0; sector < RING_FLASH_JOURNAL_CHECKPOINT_SECTORS; sector++) {
+        if ((rc = ringReadCheckpoint(journal, sector * slotsPerSector, &checkpoint[sector])) != JOURNAL_STATUS_OK) {
+            return rc;
+        }
+        valid[sector] = ringCheckpointIsValid(&checkpoint[sector]);
+    }
+
+    if (!valid[0] && !valid[1]) {
+        /* records are found by scanning from the start of the log */
+        journal->checkpointSlot           = 0;
+        journal->checkpointSequenceNumber = 0;
+        journal->checkpointPosition       = 0;
+        return JOURNAL_STATUS_OK;
+    }
+
+    /* We take advantage of properties of unsigned arithmetic to take wraparounds into account. */
+    unsigned active = (valid[1] && (!valid[0] || ((int32_t)(checkpoint[1].sequenceNumber - checkpoint[0].sequenceNumber) > 0))) ? 1 : 0;
+    uint32_t first = active * slotsPerSector;
+    uint32_t lo = 0;
+    uint32_t hi = slotsPerSector;
+    while (hi - lo > 1) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if ((rc = ringReadCheckpoint(journal, first + mid, &checkpoint[active])) != JOURNAL_STATUS_OK) {
+            return rc;
+        }
+        if (ringCheckpointIsBlank(journal, &checkpoint[active])) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+
+    /* the next checkpoint goes after the last used slot, even if it was only partially programmed */
+    journal->checkpointSlot = (first + lo + 1) % (RING_FLASH_JOURNAL_CHECKPOINT_SECTORS * slotsPerSector);
+    if ((rc = ringReadCheckpoint(journal, first + lo, &checkpoint[active])) != JOURNAL_STATUS_OK) {
+        return rc;
+    }
+    if (!ringCheckpointIsValid(&checkpoint[active])) {
+        if ((rc = ringReadCheckpoint(journal, first + lo - 1, &checkpoint[active])) != JOURNAL_STATUS_OK) {
+            return rc;
+        }
+        if (!ringCheckpointIsValid(&checkpoint[active])) {
+            return JOURNAL_STATUS_METADATA_ERROR;
+        }
+    }
+
+    journal->checkpointSequenceNumber = checkpoint[active].sequenceNumber;
+    journal->checkpointPosition       = checkpoint[active].position;
+    return 1;
+}
+
+/**
+ * Scan forward from the checkpoint for the most recently committed record.
+ */
+static int32_t discoverLatestRecord(RingFlashJournal_t *journal, bool checkpointed)
+{
+    RingFlashJournalRecordHead_t head;
+    uint64_t position       = journal->checkpointPosition;
+    uint32_t sequenceNumber = journal->checkpointSequenceNumber;
+    uint64_t recordPosition;
+    int32_t  rc;
+
+    journal->livePosition        = ARM_STORAGE_INVALID_OFFSET;
+    journal->sizeofJournaledBlob = 0;
+    while ((rc = ringFindRecord(journal, position, sequenceNumber, &head, &recordPosition)) == 1) {
+        journal->livePosition        = recordPosition;
+        journal->sizeofJournaledBlob = head.sizeofBlob;
+        position = ringRecordPosition(journal, recordPosition + sizeof(RingFlashJournalRecordHead_t) + head.sizeofBlob);
+        ++sequenceNumber;
+    }
+    if (rc < JOURNAL_STATUS_OK) {
+        return rc;
+    }
+    if (checkpointed && (journal->livePosition == ARM_STORAGE_INVALID_OFFSET)) {
+        return JOURNAL_STATUS_METADATA_ERROR; /* the checkpointed record is missing */
+    }
+
+    /* The remainder of the sector may hold part of an abandoned record, and
+     * nothing is known to be erased. */
+    journal->nextSequenceNumber = sequenceNumber;
+    journal->writePosition      = roundUp_uint64(position, journal->sizeofSector);
+    journal->erasedPosition     = journal->writePosition;
+    return JOURNAL_STATUS_OK;
+}
+
+/**
+ * Validate the header at the start of the MTD.
+ *
+ * @param [in/out] headerP
+ *                     Caller-allocated header which gets filled in during validation.
+ *
+ * @return JOURNAL_STATUS_OK if the header is sane.
+ */
+static int32_t readAndVerifyRingJournalHeader(RingFlashJournal_t *journal, RingFlashJournalHeader_t *headerP)
+{
+    int32_t rc = journal->mtd->ReadData(journal->mtdStartOffset, headerP, sizeof(RingFlashJournalHeader_t));
+    if (rc < ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_STORAGE_IO_ERROR;
+    } else if (rc == ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_ERROR;
+    }
+
+    if ((headerP->genericHeader.magic        != FLASH_JOURNAL_HEADER_MAGIC)        ||
+        (headerP->genericHeader.version      != FLASH_JOURNAL_HEADER_VERSION)      ||
+        (headerP->genericHeader.sizeofHeader != sizeof(RingFlashJournalHeader_t))  ||
+        (headerP->magic                      != RING_FLASH_JOURNAL_HEADER_MAGIC)   ||
+        (headerP->version                    != RING_FLASH_JOURNAL_HEADER_VERSION)) {
+        return JOURNAL_STATUS_NOT_FORMATTED;
+    }
+
+    uint32_t expectedCRC = headerP->genericHeader.checksum;
+    headerP->genericHeader.checksum = 0;
+    if (mbed_crc32(0, headerP, sizeof(RingFlashJournalHeader_t)) != expectedCRC) {
+        return JOURNAL_STATUS_METADATA_ERROR;
+    }
+    if ((headerP->sizeofSector       <  sizeof(RingFlashJournalHeader_t))  ||
+        (headerP->numSectors         <  RING_FLASH_JOURNAL_MIN_SECTORS)    ||
+        (headerP->checkpointInterval == 0)                                 ||
+        (headerP->genericHeader.totalSize != (uint64_t)headerP->sizeofSector * (1 + RING_FLASH_JOURNAL_CHECKPOINT_SECTORS + headerP->numSectors))) {
+        return JOURNAL_STATUS_METADATA_ERROR;
+    }
+
+    return JOURNAL_STATUS_OK;
+}
+
+int32_t flashJournalStrategyRing_format(ARM_DRIVER_STORAGE      *mtd,
+                                        uint32_t                 checkpointInterval,
+                                        FlashJournal_Callback_t  callback)
+{
+    int32_t rc;
+
+    if (mtd == NULL) {
+        return JOURNAL_STATUS_PARAMETER;
+    }
+    ARM_STORAGE_INFO mtdInfo;
+    if (mtd->GetInfo(&mtdInfo) < ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_STORAGE_API_ERROR;
+    }
+    uint64_t mtdAddr;
+    if (ringMtdGetStartAddr(mtd, &mtdAddr) < JOURNAL_STATUS_OK) {
+        return JOURNAL_STATUS_STORAGE_API_ERROR;
+    }
+    uint32_t sizeofSector;
+    if ((rc = ringMtdGetSectorSize(mtd, &sizeofSector)) != JOURNAL_STATUS_OK) {
+        return rc;
+    }
+    if ((mtdInfo.program_unit > 1) && ((sizeof(RingFlashJournalRecordHead_t) % mtdInfo.program_unit) != 0)) {
+        return JOURNAL_STATUS_UNSUPPORTED; /* record heads and checkpoints must be whole program units */
+    }
+    if ((mtdAddr % sizeofSector) != 0) { /* ensure that the journal starts at an erase-boundary */
+        return JOURNAL_STATUS_PARAMETER;
+    }
+    uint64_t totalSectors = mtdInfo.total_storage / sizeofSector;
+    if (totalSectors < 1 + RING_FLASH_JOURNAL_CHECKPOINT_SECTORS + RING_FLASH_JOURNAL_MIN_SECTORS) {
+        return JOURNAL_STATUS_PARAMETER;
+    }
+
+    RingFlashJournalHeader_t *headerP = &ringFormatInfo.header;
+    memset(headerP, 0, sizeof(RingFlashJournalHeader_t));
+    headerP->genericHeader.magic         = FLASH_JOURNAL_HEADER_MAGIC;
+    headerP->genericHeader.version       = FLASH_JOURNAL_HEADER_VERSION;
+    headerP->genericHeader.sizeofHeader  = sizeof(RingFlashJournalHeader_t);
+    headerP->genericHeader.journalOffset = sizeofSector;
+    headerP->genericHeader.totalSize     = totalSectors * sizeofSector;
+    headerP->magic                       = RING_FLASH_JOURNAL_HEADER_MAGIC;
+    headerP->version                     = RING_FLASH_JOURNAL_HEADER_VERSION;
+    headerP->sizeofSector                = sizeofSector;
+    headerP->numSectors                  = (uint32_t)totalSectors - 1 - RING_FLASH_JOURNAL_CHECKPOINT_SECTORS;
+    headerP->checkpointInterval          = checkpointInterval ? checkpointInterval : RING_FLASH_JOURNAL_DEFAULT_CHECKPOINT_INTERVAL;
+    headerP->genericHeader.checksum      = mbed_crc32(0, headerP, sizeof(RingFlashJournalHeader_t));
+
+    ringFormatInfo.mtd            = mtd;
+    ringFormatInfo.mtdAddr        = mtdAddr;
+    ringFormatInfo.mtdEraseOffset = mtdAddr;
+    ringFormatInfo.callback       = callback;
+
+    /* initialize MTD */
+    rc = mtd->Initialize(ringFormatHandler);
+    if (rc < ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_STORAGE_API_ERROR;
+    } else if (rc == ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_OK; /* An asynchronous operation is pending; it will result in a completion callback
+                                   * where the rest of processing will take place. */
+    }
+    if (rc != 1) {
+        return JOURNAL_STATUS_STORAGE_API_ERROR; /* synchronous completion is expected to return 1 */
+    }
+
+    /* progress the rest of the format state-machine */
+    return flashJournalStrategyRing_format_progress(ARM_DRIVER_OK, ARM_STORAGE_OPERATION_INITIALIZE);
+}
+
+/**
+ * Progress the state machine for the 'format' operation: erase the entire
+ * journal, so that no stale records remain in the ring, then program the
+ * header. This method can also be called from an interrupt handler.
+ *
+ * @return  < JOURNAL_STATUS_OK for error
+ *          = JOURNAL_STATUS_OK to signal pending asynchronous activity
+ *          > JOURNAL_STATUS_OK for completion
+ */
+static int32_t flashJournalStrategyRing_format_progress(int32_t status, ARM_STORAGE_OPERATION operationWhichJustFinshed)
+{
+    int32_t rc;
+    uint64_t endOffset = ringFormatInfo.mtdAddr + ringFormatInfo.header.genericHeader.totalSize;
+
+    switch (operationWhichJustFinshed) {
+        case ARM_STORAGE_OPERATION_INITIALIZE:
+            if (status != ARM_DRIVER_OK) {
+                return JOURNAL_STATUS_STORAGE_API_ERROR;
+            }
+            status = 0;
+
+            /* intentional fall-through */
+
+        case ARM_STORAGE_OPERATION_ERASE:
+            if (status < ARM_DRIVER_OK) {
+                return storageStatus(status);
+            }
+            ringFormatInfo.mtdEraseOffset += status;
+            while (ringFormatInfo.mtdEraseOffset < endOffset) {
+                rc = (ringFormatInfo.mtd)->Erase(ringFormatInfo.mtdEraseOffset, endOffset - ringFormatInfo.mtdEraseOffset);
+                if (rc < ARM_DRIVER_OK) {
+                    return storageStatus(rc);
+                } else if (rc == ARM_DRIVER_OK) {
+                    return JOURNAL_STATUS_OK; /* An asynchronous operation is pending; it will result in a completion callback
+                                               * where the rest of processing will take place. */
+                }
+                ringFormatInfo.mtdEraseOffset += rc;
+            }
+
+            rc = (ringFormatInfo.mtd)->ProgramData(ringFormatInfo.mtdAddr, &ringFormatInfo.header, sizeof(RingFlashJournalHeader_t));
+            if (rc < ARM_DRIVER_OK) {
+                return storageStatus(rc);
+            } else if (rc == ARM_DRIVER_OK) {
+                return JOURNAL_STATUS_OK; /* An asynchronous operation is pending; it will result in a completion callback
+                                           * where the rest of processing will take place. */
+            }
+            /* handle synchronous completion of programData */
+            status = rc;
+
+            /* intentional fall-through */
+
+        case ARM_STORAGE_OPERATION_PROGRAM_DATA:
+            if (status != (int32_t)sizeof(RingFlashJournalHeader_t)) {
+                return JOURNAL_STATUS_STORAGE_IO_ERROR;
+            }
+
+            return 1; /* acknowledge the completion of format */
+
+        default:
+            return JOURNAL_STATUS_STORAGE_API_ERROR; /* we don't expect to be here */
+    }
+}
+
+int32_t flashJournalStrategyRing_initialize(FlashJournal_t           *_journal,
+                                            ARM_DRIVER_STORAGE       *mtd,
+                                            const FlashJournal_Ops_t *ops,
+                                            FlashJournal_Callback_t   callback)
+{
+    int32_t rc;
+
+    /* initialize MTD */
+    rc = mtd->Initialize(ringMtdHandler);
+    if (rc < ARM_DRIVER_OK) {
+        memset(_journal, 0, sizeof(FlashJournal_t));
+        return JOURNAL_STATUS_STORAGE_API_ERROR;
+    }
+    if (rc == ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_ERROR;
+    }
+
+    RingFlashJournal_t *journal;
+    activeRingJournal = journal = (RingFlashJournal_t *)_journal;
+    journal->state           = RING_JOURNAL_STATE_NOT_INITIALIZED;
+    journal->io              = RING_JOURNAL_IO_NONE;
+    journal->mtd             = mtd;
+    journal->mtdCapabilities = mtd->GetCapabilities(); /* fetch MTD's capabilities */
+
+    /* Setup start address within MTD. */
+    if ((rc = ringMtdGetStartAddr(journal->mtd, &journal->mtdStartOffset)) != JOURNAL_STATUS_OK) {
+        return rc;
+    }
+    ARM_STORAGE_INFO mtdInfo;
+    if ((rc = mtd->GetInfo(&mtdInfo)) != ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_STORAGE_API_ERROR;
+    }
+    journal->programUnit = mtdInfo.program_unit ? mtdInfo.program_unit : 1;
+    journal->erasedValue = mtdInfo.erased_value ? 0xFF : 0x00;
+    if ((sizeof(RingFlashJournalRecordHead_t) % journal->programUnit) != 0) {
+        return JOURNAL_STATUS_UNSUPPORTED;
+    }
+
+    RingFlashJournalHeader_t journalHeader;
+    if ((rc = readAndVerifyRingJournalHeader(journal, &journalHeader)) != JOURNAL_STATUS_OK) {
+        return rc;
+    }
+    if (journalHeader.genericHeader.totalSize > mtdInfo.total_storage) {
+        return JOURNAL_STATUS_METADATA_ERROR; /* the journal was formatted for a larger MTD */
+    }
+
+    /* initialize the journal structure */
+    memcpy(&journal->ops, ops, sizeof(FlashJournal_Ops_t));
+    journal->sizeofSector       = journalHeader.sizeofSector;
+    journal->numSectors         = journalHeader.numSectors;
+    journal->checkpointInterval = journalHeader.checkpointInterval;
+    journal->callback           = callback;
+    journal->prevCommand        = FLASH_JOURNAL_OPCODE_INITIALIZE;
+
+    if ((rc = ringLoadCheckpoint(journal)) < JOURNAL_STATUS_OK) {
+        return rc;
+    }
+    if ((rc = discoverLatestRecord(journal, (rc == 1))) != JOURNAL_STATUS_OK) {
+        return rc;
+    }
+
+    journal->state = RING_JOURNAL_STATE_INITIALIZED;
+    return 1; /* synchronous completion */
+}
+
+FlashJournal_Status_t flashJournalStrategyRing_getInfo(FlashJournal_t *_journal, FlashJournal_Info_t *infoP)
+{
+    RingFlashJournal_t *journal;
+    activeRingJournal = journal = (RingFlashJournal_t *)_journal;
+
+    infoP->capacity            = ringCapacity(journal);
+    infoP->sizeofJournaledBlob = journal->sizeofJournaledBlob;
+    infoP->program_unit        = journal->programUnit;
+    return JOURNAL_STATUS_OK;
+}
+
+static int32_t flashJournalStrategyRing_read_sanityChecks(RingFlashJournal_t *journal, const void *blob, size_t sizeofBlob)
+{
+    if ((journal == NULL) || (blob == NULL) || (sizeofBlob == 0)) {
+        return JOURNAL_STATUS_PARAMETER;
+    }
+    if (journal->state == RING_JOURNAL_STATE_NOT_INITIALIZED) {
+        return JOURNAL_STATUS_NOT_INITIALIZED;
+    }
+    if (journal->state != RING_JOURNAL_STATE_INITIALIZED) {
+        return JOURNAL_STATUS_ERROR; /* journal is in an un-expected state. */
+    }
+    if ((journal->sizeofJournaledBlob == 0) || (journal->read.logicalOffset >= journal->sizeofJournaledBlob)) {
+        journal->read.logicalOffset = 0;
+        return JOURNAL_STATUS_EMPTY;
+    }
+
+    return JOURNAL_STATUS_OK;
+}
+
+/* Start reading the most recent blob from read.logicalOffset. */
+static int32_t ringStartRead(RingFlashJournal_t *journal, void *blob, size_t sizeofBlob)
+{
+    uint32_t amountLeft = journal->sizeofJournaledBlob - journal->read.logicalOffset;
+
+    journal->read.position         = journal->livePosition + sizeof(RingFlashJournalRecordHead_t) + journal->read.logicalOffset;
+    journal->read.blob             = (const uint8_t *)blob;
+    journal->read.dataBeingRead    = (uint8_t *)blob;
+    journal->read.amountLeftToRead = (amountLeft < sizeofBlob) ? amountLeft : sizeofBlob;
+
+    journal->state       = RING_JOURNAL_STATE_READING;
+    journal->prevCommand = FLASH_JOURNAL_OPCODE_READ_BLOB;
+    return ringProgress(journal);
+}
+
+int32_t flashJournalStrategyRing_read(FlashJournal_t *_journal, void *blob, size_t sizeofBlob)
+{
+    RingFlashJournal_t *journal;
+    activeRingJournal = journal = (RingFlashJournal_t *)_journal;
+
+    if (journal->prevCommand != FLASH_JOURNAL_OPCODE_READ_BLOB) {
+        journal->read.logicalOffset = 0;
+    }
+
+    int32_t rc;
+    if ((rc = flashJournalStrategyRing_read_sanityChecks(journal, blob, sizeofBlob)) != JOURNAL_STATUS_OK) {
+        return rc;
+    }
+
+    if (journal->read.logicalOffset == 0) {
+        /* Establish the sanity of the record before proceeding with the read. */
+        RingFlashJournalRecordHead_t head;
+        uint64_t recordPosition;
+        if ((ringFindRecord(journal, journal->livePosition, journal->nextSequenceNumber - 1, &head, &recordPosition) != 1) ||
+            (recordPosition != journal->livePosition) ||
+            (ringRecordBodyIsSane(journal, recordPosition, &head) != 1)) {
+            return JOURNAL_STATUS_STORAGE_IO_ERROR;
+        }
+    }
+
+    return ringStartRead(journal, blob, sizeofBlob);
+}
+
+int32_t flashJournalStrategyRing_readFrom(FlashJournal_t *_journal, size_t offset, void *blob, size_t sizeofBlob)
+{
+    RingFlashJournal_t *journal;
+    activeRingJournal = journal = (RingFlashJournal_t *)_journal;
+
+    journal->read.logicalOffset = offset;
+    int32_t rc;
+    if ((rc = flashJournalStrategyRing_read_sanityChecks(journal, blob, sizeofBlob)) != JOURNAL_STATUS_OK) {
+        return rc;
+    }
+
+    return ringStartRead(journal, blob, sizeofBlob);
+}
+
+/* Start a new record following the most recently committed one. */
+static inline void ringStartRecord(RingFlashJournal_t *journal)
+{
+    journal->log.recordPosition = ringRecordPosition(journal, journal->writePosition);
+    journal->log.position       = journal->log.recordPosition + sizeof(RingFlashJournalRecordHead_t);
+    journal->log.blobCrc32      = 0;
+}
+
+int32_t flashJournalStrategyRing_log(FlashJournal_t *_journal, const void *blob, size_t size)
+{
+    RingFlashJournal_t *journal;
+    activeRingJournal = journal = (RingFlashJournal_t *)_journal;
+
+    if ((journal == NULL) || (blob == NULL) || (size == 0)) {
+        return JOURNAL_STATUS_PARAMETER;
+    }
+    if (journal->state == RING_JOURNAL_STATE_NOT_INITIALIZED) {
+        return JOURNAL_STATUS_NOT_INITIALIZED;
+    }
+    if ((journal->state != RING_JOURNAL_STATE_INITIALIZED) && (journal->state != RING_JOURNAL_STATE_LOGGING)) {
+        return JOURNAL_STATUS_ERROR; /* journal is in an un-expected state. */
+    }
+
+    /* the amount already logged for the record in progress */
+    uint64_t amountLogged = 0;
+    if (journal->state == RING_JOURNAL_STATE_LOGGING) {
+        amountLogged = journal->log.position - journal->log.recordPosition - sizeof(RingFlashJournalRecordHead_t);
+    }
+    if (amountLogged + size > ringCapacity(journal)) {
+        return JOURNAL_STATUS_BOUNDED_CAPACITY; /* adding this log chunk would cause us to exceed capacity. */
+    }
+    /* ensure that the request is at least as large as the minimum program unit */
+    if (size < journal->programUnit) {
+        return JOURNAL_STATUS_SMALL_LOG_REQUEST;
+    }
+
+    if (journal->state == RING_JOURNAL_STATE_INITIALIZED) {
+        /* This is the first log in the sequence. */
+        ringStartRecord(journal);
+    }
+    journal->log.dataBeingLogged = (const uint8_t *)blob;
+    journal->log.amountLeftToLog = size - (size % journal->programUnit);
+    journal->log.amountLogged    = journal->log.amountLeftToLog;
+
+    journal->state       = RING_JOURNAL_STATE_LOGGING;
+    journal->prevCommand = FLASH_JOURNAL_OPCODE_LOG_BLOB;
+    return ringProgress(journal);
+}
+
+int32_t flashJournalStrategyRing_commit(FlashJournal_t *_journal)
+{
+    RingFlashJournal_t *journal;
+    activeRingJournal = journal = (RingFlashJournal_t *)_journal;
+
+    if (journal == NULL) {
+        return JOURNAL_STATUS_PARAMETER;
+    }
+    if (journal->state == RING_JOURNAL_STATE_NOT_INITIALIZED) {
+        return JOURNAL_STATUS_NOT_INITIALIZED;
+    }
+    if ((journal->state != RING_JOURNAL_STATE_INITIALIZED) && (journal->state != RING_JOURNAL_STATE_LOGGING)) {
+        return JOURNAL_STATUS_ERROR; /* journal is in an un-expected state. */
+    }
+
+    if (journal->state == RING_JOURNAL_STATE_INITIALIZED) {
+        /* commit() without any preceding log() operations logs an empty blob. */
+        ringStartRecord(journal);
+    }
+
+    journal->state       = RING_JOURNAL_STATE_COMMITTING;
+    journal->prevCommand = FLASH_JOURNAL_OPCODE_COMMIT;
+    return ringProgress(journal);
+}
+
+int32_t flashJournalStrategyRing_reset(FlashJournal_t *_journal)
+{
+    RingFlashJournal_t *journal;
+    activeRingJournal = journal = (RingFlashJournal_t *)_journal;
+
+    if (journal->state == RING_JOURNAL_STATE_NOT_INITIALIZED) {
+        return JOURNAL_STATUS_NOT_INITIALIZED;
+    }
+
+    /* erase everything following the journal header */
+    journal->reset.mtdEraseOffset = journal->mtdStartOffset + journal->sizeofSector;
+    journal->io                   = RING_JOURNAL_IO_NONE;
+    journal->state                = RING_JOURNAL_STATE_RESETING;
+    journal->prevCommand          = FLASH_JOURNAL_OPCODE_RESET;
+    return ringProgress(journal);
+}
+
+/**
+ * Prepare a checkpoint for the most recently committed record, erasing the
+ * next checkpoint sector first if the slot is at its start.
+ */
+static int32_t ringPlanCheckpoint(RingFlashJournal_t *journal)
+{
+    RingFlashJournalCheckpoint_t *checkpointP = &journal->log.checkpoint;
+
+    memset(checkpointP, 0, sizeof(RingFlashJournalCheckpoint_t));
+    checkpointP->magic          = RING_FLASH_JOURNAL_CHECKPOINT_MAGIC;
+    checkpointP->sequenceNumber = journal->nextSequenceNumber - 1;
+    checkpointP->position       = journal->livePosition;
+    checkpointP->crc32          = mbed_crc32(0, checkpointP, offsetof(RingFlashJournalCheckpoint_t, crc32));
+
+    journal->io = ((journal->checkpointSlot % checkpointSlotsPerSector(journal)) == 0) ?
+                      RING_JOURNAL_IO_CHECKPOINT_ERASE : RING_JOURNAL_IO_CHECKPOINT_PROGRAM;
+    return JOURNAL_STATUS_OK;
+}
+
+/* Returns true if the sector at erasedPosition still holds records needed to find the most recent one. */
+static inline bool ringEraseWouldOverrunCheckpoint(const RingFlashJournal_t *journal)
+{
+    return (roundDown_uint64(journal->erasedPosition, journal->sizeofSector) + journal->sizeofSector) >
+           (journal->checkpointPosition + ringSize(journal));
+}
+
+/* Prepare to erase the next sector ahead of the record being logged. */
+static int32_t ringPlanErase(RingFlashJournal_t *journal)
+{
+    if (ringEraseWouldOverrunCheckpoint(journal)) {
+        if ((journal->livePosition == ARM_STORAGE_INVALID_OFFSET) || (journal->livePosition == journal->checkpointPosition)) {
+            return JOURNAL_STATUS_BOUNDED_CAPACITY;
+        }
+        /* move the checkpoint up to the most recent record to free the older ones */
+        return ringPlanCheckpoint(journal);
+    }
+
+    journal->io = RING_JOURNAL_IO_ERASE;
+    return JOURNAL_STATUS_OK;
+}
+
+/**
+ * Decide the next storage operation for the command in progress.
+ *
+ * @return  < JOURNAL_STATUS_OK for error
+ *          = JOURNAL_STATUS_OK with journal->io set to the next operation
+ *          > JOURNAL_STATUS_OK for completion of the command
+ */
+static int32_t ringPlanNextIo(RingFlashJournal_t *journal)
+{
+    switch (journal->state) {
+        case RING_JOURNAL_STATE_LOGGING:
+            if (journal->log.amountLeftToLog == 0) {
+                return journal->log.amountLogged;
+            }
+            if (journal->erasedPosition < journal->log.position + journal->programUnit) {
+                return ringPlanErase(journal);
+            }
+            journal->io = RING_JOURNAL_IO_PROGRAM;
+            return JOURNAL_STATUS_OK;
+
+        case RING_JOURNAL_STATE_COMMITTING:
+            if (journal->erasedPosition < journal->log.position) {
+                return ringPlanErase(journal); /* only for commit() without logs */
+            }
+            memset(&journal->log.head, 0, sizeof(RingFlashJournalRecordHead_t));
+            journal->log.head.magic          = RING_FLASH_JOURNAL_RECORD_MAGIC;
+            journal->log.head.sequenceNumber = journal->nextSequenceNumber;
+            journal->log.head.sizeofBlob     = (uint32_t)(journal->log.position - journal->log.recordPosition - sizeof(RingFlashJournalRecordHead_t));
+            journal->log.head.blobCrc32      = journal->log.blobCrc32;
+            journal->log.head.headCrc32      = mbed_crc32(0, &journal->log.head, offsetof(RingFlashJournalRecordHead_t, headCrc32));
+            journal->io = RING_JOURNAL_IO_PROGRAM;
+            return JOURNAL_STATUS_OK;
+
+        case RING_JOURNAL_STATE_CHECKPOINTING:
+            return ringPlanCheckpoint(journal);
+
+        case RING_JOURNAL_STATE_ERASING_AHEAD:
+            /* keep a sector erased ahead of the writer, as far as the checkpoint allows */
+            if ((journal->erasedPosition >= journal->writePosition + journal->sizeofSector) ||
+                ringEraseWouldOverrunCheckpoint(journal)) {
+                journal->state = RING_JOURNAL_STATE_INITIALIZED;
+                return 1; /* commit returns 1 upon completion. */
+            }
+            journal->io = RING_JOURNAL_IO_ERASE;
+            return JOURNAL_STATUS_OK;
+
+        case RING_JOURNAL_STATE_READING:
+            if (journal->read.amountLeftToRead == 0) {
+                journal->state = RING_JOURNAL_STATE_INITIALIZED;
+                return (journal->read.dataBeingRead - journal->read.blob);
+            }
+            journal->io = RING_JOURNAL_IO_READ;
+            return JOURNAL_STATUS_OK;
+
+        case RING_JOURNAL_STATE_RESETING:
+            if (journal->reset.mtdEraseOffset < journal->mtdStartOffset + (1 + RING_FLASH_JOURNAL_CHECKPOINT_SECTORS) * (uint64_t)journal->sizeofSector + ringSize(journal)) {
+                journal->io = RING_JOURNAL_IO_RESET_ERASE;
+                return JOURNAL_STATUS_OK;
+            }
+            journal->checkpointSlot           = 0;
+            journal->checkpointSequenceNumber = 0;
+            journal->checkpointPosition       = 0;
+            journal->livePosition             = ARM_STORAGE_INVALID_OFFSET;
+            journal->sizeofJournaledBlob      = 0;
+            journal->nextSequenceNumber       = 0;
+            journal->writePosition            = 0;
+            journal->erasedPosition           = ringSize(journal);
+            journal->state                    = RING_JOURNAL_STATE_INITIALIZED;
+            return 1;
+
+        default:
+            return JOURNAL_STATUS_ERROR; /* journal is in an un-expected state. */
+    }
+}
+
+/* Issue the storage operation in journal->io. */
+static int32_t ringIssueIo(RingFlashJournal_t *journal)
+{
+    ARM_DRIVER_STORAGE *mtd = journal->mtd;
+    uint64_t xfer;
+
+    switch (journal->io) {
+        case RING_JOURNAL_IO_ERASE:
+            return mtd->Erase(ringAddress(journal, journal->erasedPosition),
+                              journal->sizeofSector - (journal->erasedPosition % journal->sizeofSector));
+
+        case RING_JOURNAL_IO_PROGRAM:
+            if (journal->state == RING_JOURNAL_STATE_COMMITTING) {
+                return mtd->ProgramData(ringAddress(journal, journal->log.recordPosition), &journal->log.head, sizeof(RingFlashJournalRecordHead_t));
+            }
+            xfer = journal->log.amountLeftToLog;
+            if (xfer > journal->erasedPosition - journal->log.position) {
+                xfer = journal->erasedPosition - journal->log.position;
+            }
+            if (xfer > ringLeft(journal, journal->log.position)) {
+                xfer = ringLeft(journal, journal->log.position);
+            }
+            xfer -= xfer % journal->programUnit; /* align transfer-size with program_unit. */
+            return mtd->ProgramData(ringAddress(journal, journal->log.position), journal->log.dataBeingLogged, (uint32_t)xfer);
+
+        case RING_JOURNAL_IO_CHECKPOINT_ERASE:
+            return mtd->Erase(checkpointAddress(journal, journal->checkpointSlot), journal->sizeofSector);
+
+        case RING_JOURNAL_IO_CHECKPOINT_PROGRAM:
+            return mtd->ProgramData(checkpointAddress(journal, journal->checkpointSlot), &journal->log.checkpoint, sizeof(RingFlashJournalCheckpoint_t));
+
+        case RING_JOURNAL_IO_READ:
+            xfer = journal->read.amountLeftToRead;
+            if (xfer > ringLeft(journal, journal->read.position)) {
+                xfer = ringLeft(journal, journal->read.position);
+            }
+            return mtd->ReadData(ringAddress(journal, journal->read.position), journal->read.dataBeingRead, (uint32_t)xfer);
+
+        case RING_JOURNAL_IO_RESET_ERASE:
+            xfer = journal->mtdStartOffset + (1 + RING_FLASH_JOURNAL_CHECKPOINT_SECTORS) * (uint64_t)journal->sizeofSector + ringSize(journal);
+            return mtd->Erase(journal->reset.mtdEraseOffset, (uint32_t)(xfer - journal->reset.mtdEraseOffset));
+
+        default:
+            return JOURNAL_STATUS_ERROR;
+    }
+}
+
+/**
+ * Account for the completion of the storage operation in journal->io.
+ * 'status' is the number of bytes transferred or an error.
+ */
+static int32_t ringCompleteIo(RingFlashJournal_t *journal, int32_t status)
+{
+    if (status < ARM_DRIVER_OK) {
+        return storageStatus(status);
+    }
+    if (status == ARM_DRIVER_OK) {
+        return JOURNAL_STATUS_STORAGE_IO_ERROR; /* no progress */
+    }
+
+    switch (journal->io) {
+        case RING_JOURNAL_IO_ERASE:
+            journal->erasedPosition += status;
+            break;
+
+        case RING_JOURNAL_IO_PROGRAM:
+            if (journal->state == RING_JOURNAL_STATE_LOGGING) {
+                journal->log.blobCrc32        = mbed_crc32(journal->log.blobCrc32, journal->log.dataBeingLogged, status);
+                journal->log.position        += status;
+                journal->log.dataBeingLogged += status;
+                journal->log.amountLeftToLog -= status;
+                break;
+            }
+            if (status != sizeof(RingFlashJournalRecordHead_t)) {
+                return JOURNAL_STATUS_STORAGE_IO_ERROR;
+            }
+            /* the record is committed */
+            journal->livePosition        = journal->log.recordPosition;
+            journal->sizeofJournaledBlob = journal->log.head.sizeofBlob;
+            journal->writePosition       = ringRecordPosition(journal, journal->log.position);
+            ++journal->nextSequenceNumber;
+            journal->state = ((journal->nextSequenceNumber - 1 - journal->checkpointSequenceNumber) >= journal->checkpointInterval) ?
+                                 RING_JOURNAL_STATE_CHECKPOINTING : RING_JOURNAL_STATE_ERASING_AHEAD;
+            break;
+
+        case RING_JOURNAL_IO_CHECKPOINT_ERASE:
+            if (status != (int32_t)journal->sizeofSector) {
+                return JOURNAL_STATUS_STORAGE_IO_ERROR;
+            }
+            journal->io = RING_JOURNAL_IO_CHECKPOINT_PROGRAM;
+            return JOURNAL_STATUS_OK;
+
+        case RING_JOURNAL_IO_CHECKPOINT_PROGRAM:
+            if (status != sizeof(RingFlashJournalCheckpoint_t)) {
+                return JOURNAL_STATUS_STORAGE_IO_ERROR;
+            }
+            journal->checkpointSequenceNumber = journal->log.checkpoint.sequenceNumber;
+            journal->checkpointPosition       = journal->log.checkpoint.position;
+            journal->checkpointSlot           = (journal->checkpointSlot + 1) % (RING_FLASH_JOURNAL_CHECKPOINT_SECTORS * checkpointSlotsPerSector(journal));
+            if (journal->state == RING_JOURNAL_STATE_CHECKPOINTING) {
+                journal->state = RING_JOURNAL_STATE_ERASING_AHEAD;
+            }
+            break;
+
+        case RING_JOURNAL_IO_READ:
+            journal->read.position         += status;
+            journal->read.dataBeingRead    += status;
+            journal->read.amountLeftToRead -= status;
+            journal->read.logicalOffset    += status;
+            break;
+
+        case RING_JOURNAL_IO_RESET_ERASE:
+            journal->reset.mtdEraseOffset += status;
+            break;
+
+        default:
+            return JOURNAL_STATUS_ERROR;
+    }
+
+    journal->io = RING_JOURNAL_IO_NONE;
+    return JOURNAL_STATUS_OK;
+}
+
+/**
+ * Abandon the command in progress after an error, leaving the journal in a
+ * state which allows further operations.
+ */
+static int32_t ringAbortCommand(RingFlashJournal_t *journal, int32_t rc)
+{
+    if (journal->io == RING_JOURNAL_IO_CHECKPOINT_PROGRAM) {
+        /* a partially programmed slot can't be reused */
+        journal->checkpointSlot = (journal->checkpointSlot + 1) % (RING_FLASH_JOURNAL_CHECKPOINT_SECTORS * checkpointSlotsPerSector(journal));
+    }
+
+    switch (journal->state) {
+        case RING_JOURNAL_STATE_LOGGING:
+        case RING_JOURNAL_STATE_COMMITTING:
+            /* The record may have been partially programmed; the next one
+             * starts afresh at the following sector boundary. */
+            journal->writePosition  = roundUp_uint64(journal->log.recordPosition, journal->sizeofSector);
+            journal->erasedPosition = journal->writePosition;
+            break;
+
+        case RING_JOURNAL_STATE_CHECKPOINTING:
+        case RING_JOURNAL_STATE_ERASING_AHEAD:
+            /* the record is committed, but the sector being erased ahead may be left partially erased */
+            if (journal->erasedPosition > roundUp_uint64(journal->writePosition, journal->sizeofSector)) {
+                journal->erasedPosition = roundUp_uint64(journal->writePosition, journal->sizeofSector);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    journal->io    = RING_JOURNAL_IO_NONE;
+    journal->state = RING_JOURNAL_STATE_INITIALIZED; /* reset state */
+    return rc;
+}
+
+/**
+ * Progress the state machine for the command in progress until it completes
+ * or has to wait for asynchronous activity. This method can also be called
+ * from an interrupt handler.
+ *
+ * @return  < JOURNAL_STATUS_OK for error
+ *          = JOURNAL_STATUS_OK to signal pending asynchronous activity
+ *          > JOURNAL_STATUS_OK for completion
+ */
+static int32_t ringProgress(RingFlashJournal_t *journal)
+{
+    int32_t rc;
+
+    while (true) {
+        if (journal->io == RING_JOURNAL_IO_NONE) {
+            if ((rc = ringPlanNextIo(journal)) < JOURNAL_STATUS_OK) {
+                return ringAbortCommand(journal, rc);
+            }
+            if (journal->io == RING_JOURNAL_IO_NONE) {
+                return rc;
+            }
+        }
+
+        rc = ringIssueIo(journal);
+        if ((rc == ARM_DRIVER_OK) && journal->mtdCapabilities.asynchronous_ops) {
+            return JOURNAL_STATUS_OK; /* we've got pending asynchronous activity. */
+        }
+        if ((rc = ringCompleteIo(journal, rc)) < JOURNAL_STATUS_OK) {
+            return ringAbortCommand(journal, rc);
+        }
+    }
+}
+
+static void ringFormatHandler(int32_t status, ARM_STORAGE_OPERATION operation)
+{
+    if (status < ARM_DRIVER_OK) {
+        if (ringFormatInfo.callback) {
+            ringFormatInfo.callback(storageStatus(status), FLASH_JOURNAL_OPCODE_FORMAT);
+        }
+        return;
+    }
+
+    int32_t rc = flashJournalStrategyRing_format_progress(status, operation);
+    if (rc != JOURNAL_STATUS_OK) {
+        if (ringFormatInfo.callback) {
+            ringFormatInfo.callback(rc, FLASH_JOURNAL_OPCODE_FORMAT);
+        }
+    }
+}
+
+static void ringMtdHandler(int32_t status, ARM_STORAGE_OPERATION operation)
+{
+    RingFlashJournal_t *journal = activeRingJournal;
+    int32_t rc;
+
+    if (operation == ARM_STORAGE_OPERATION_INITIALIZE) {
+        if (journal->callback) {
+            journal->callback(status < ARM_DRIVER_OK ? JOURNAL_STATUS_STORAGE_API_ERROR : JOURNAL_STATUS_OK, FLASH_JOURNAL_OPCODE_INITIALIZE);
+        }
+        return;
+    }
+    if (journal->io == RING_JOURNAL_IO_NONE) {
+        return; /* no operation is pending */
+    }
+
+    if ((rc = ringCompleteIo(journal, status)) < JOURNAL_STATUS_OK) {
+        rc = ringAbortCommand(journal, rc);
+    } else {
+        rc = ringProgress(journal);
+    }
+    if ((rc != JOURNAL_STATUS_OK) && journal->callback) {
+        journal->callback(rc, (FlashJournal_OpCode_t)journal->prevCommand);
+    }
+}
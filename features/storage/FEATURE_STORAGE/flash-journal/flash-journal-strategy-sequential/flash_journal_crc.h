@@ -24,6 +24,15 @@ extern "C" {
 
 typedef uint32_t  flash_journal_crc32_t;
 
+/**
+ * CRC32 over a message supplied in fragments, kept for existing users.
+ *
+ * flashJournalCrcReset() starts a new message, and each call to
+ * flashJournalCrcCummulative() appends a fragment and returns the CRC of the
+ * message so far. The state is shared by all callers, so this is not
+ * reentrant; new code should use the context based API in
+ * platform/mbed_crc32.h, which computes the same CRC.
+ */
 void flashJournalCrcReset(void);
 flash_journal_crc32_t flashJournalCrcCummulative(unsigned char const message[], int nBytes);
 
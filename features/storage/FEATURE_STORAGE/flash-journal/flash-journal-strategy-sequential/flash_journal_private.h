@@ -23,6 +23,7 @@ extern "C" {
 #endif // __cplusplus
 
 #include "flash-journal/flash_journal.h"
+#include "platform/mbed_crc32.h"
 
 static inline uint32_t roundUp_uint32(uint32_t N, uint32_t BOUNDARY) {
     return ((((N) + (BOUNDARY) - 1) / (BOUNDARY)) * (BOUNDARY));
@@ -130,6 +131,7 @@ typedef struct _SequentialFlashJournal_t {
         struct {
             const uint8_t *blob;           /**< the original buffer holding source data. */
             size_t         sizeofBlob;
+            mbed_crc32_t   crc;            /**< CRC32 of the head and the data logged so far. */
             union {
                 struct {
                     uint64_t mtdEraseOffset;
@@ -15,10 +15,10 @@
  * limitations under the License.
  */
 
-#include "flash-journal-strategy-sequential/flash_journal_crc.h"
 #include "flash-journal-strategy-sequential/flash_journal_private.h"
 #include "flash-journal-strategy-sequential/flash_journal_strategy_sequential.h"
 #include "support_funcs.h"
+#include "platform/mbed_crc32.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -114,8 +114,7 @@ int32_t readAndVerifyJournalHeader(SequentialFlashJournal_t *journal, Sequential
 
     uint32_t expectedCRC = headerP->genericHeader.checksum;
     headerP->genericHeader.checksum = 0;
-    flashJournalCrcReset();
-    uint32_t computedCRC = flashJournalCrcCummulative((const unsigned char *)&headerP->genericHeader, sizeof(SequentialFlashJournalLogHead_t));
+    uint32_t computedCRC = mbed_crc32(0, &headerP->genericHeader, sizeof(SequentialFlashJournalLogHead_t));
     if (computedCRC != expectedCRC) {
         //printf("readAndVerifyJournalHeader: checksum mismatch during header verification: expected = %u, computed = %u\n", (unsigned int) expectedCRC, (unsigned int) computedCRC);
         return JOURNAL_STATUS_METADATA_ERROR;
@@ -170,6 +169,10 @@ int32_t flashJournalStrategySequential_initialize(FlashJournal_t           *_jou
     if ((rc = readAndVerifyJournalHeader(journal, &journalHeader)) != JOURNAL_STATUS_OK) {
         return rc;
     }
+    /* the journal was formatted for a larger MTD, e.g. before the volume was shrunk */
+    if (journalHeader.genericHeader.totalSize > mtdCapacity) {
+        return JOURNAL_STATUS_METADATA_ERROR;
+    }
 
     /* initialize the journal structure */
     memcpy(&journal->ops, ops, sizeof(FlashJournal_Ops_t));
@@ -324,8 +327,8 @@ int32_t flashJournalStrategySequential_commit(FlashJournal_t *_journal)
 
     if (journal->prevCommand == FLASH_JOURNAL_OPCODE_LOG_BLOB) {
         /* the tail has already been setup during previous calls to log(); we can now include it in the crc32. */
-        journal->log.tail.crc32 = flashJournalCrcCummulative((const unsigned char *)&journal->log.tail, sizeof(SequentialFlashJournalLogTail_t));
-        flashJournalCrcReset();
+        mbed_crc32_update(&journal->log.crc, &journal->log.tail, sizeof(SequentialFlashJournalLogTail_t));
+        journal->log.tail.crc32 = mbed_crc32_final(&journal->log.crc);
 
         journal->log.mtdOffset       = journal->log.mtdTailOffset;
         journal->log.dataBeingLogged = (const uint8_t *)&journal->log.tail;
@@ -0,0 +1,575 @@
+/*
+ * Copyright (c) 2006-2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "storage-sim/storage_sim.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Redefine this macro to a printf equivalent to print trace */
+#define tr_debug(...)
+
+static const ARM_DRIVER_VERSION version = {
+    .api = ARM_STORAGE_API_VERSION,
+    .drv = ARM_DRIVER_VERSION_MAJOR_MINOR(1,00)
+};
+
+static struct storage_sim_data {
+    storage_sim_config_t   config;
+    ARM_STORAGE_CAPABILITIES caps;
+    ARM_STORAGE_INFO       info;
+    ARM_STORAGE_BLOCK      block;
+    ARM_Storage_Callback_t commandCompletionCallback;
+    bool                   configured;
+    bool                   initialized;
+    bool                   pending;         /**< an asynchronous operation is in progress. */
+    bool                   failed;          /**< the last operation failed; reported by GetStatus. */
+    uint64_t               now;             /**< the simulated clock, in microseconds. */
+    uint64_t               completionTime;  /**< when the pending operation completes. */
+
+    /* the pending operation */
+    ARM_STORAGE_OPERATION  currentCommand;
+    uint64_t               currentOperatingStorageAddress;
+    uint32_t               sizeofCurrentOperation;
+    void                  *currentReadBuffer;
+    const uint8_t         *currentOperatingData;
+
+    storage_sim_stats_t    stats;
+} sim;
+
+void storage_sim_config_default(storage_sim_config_t *config)
+{
+    memset(config, 0, sizeof(storage_sim_config_t));
+    config->program_unit         = 8;
+    config->optimal_program_unit = 1024;
+    config->erase_unit           = 4096;
+    config->program_cycles       = ARM_STORAGE_PROGRAM_CYCLES_INFINITE;
+    config->asynchronous         = 0;
+    config->asynchronous_reads   = 0;
+    config->erased_value         = 1;
+    config->read_setup_us        = 1;
+    config->read_ns_per_byte     = 10;
+    config->program_setup_us     = 5;
+    config->program_us_per_unit  = 30;
+    config->erase_us_per_unit    = 15000;
+}
+
+int32_t storage_sim_configure(const storage_sim_config_t *config, int erase)
+{
+    if ((config->memory == NULL) ||
+        (config->size == 0) ||
+        (config->erase_unit == 0) ||
+        ((config->size % config->erase_unit) != 0) ||
+        (config->program_unit == 0) ||
+        ((config->erase_unit % config->program_unit) != 0) ||
+        (config->size > UINT32_MAX)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    memset(&sim, 0, sizeof(sim));
+    sim.config = *config;
+    if (sim.config.optimal_program_unit == 0) {
+        sim.config.optimal_program_unit = sim.config.program_unit;
+    }
+
+    sim.caps.asynchronous_ops = (config->asynchronous || config->asynchronous_reads) ? 1 : 0;
+    sim.caps.erase_all        = 1;
+
+    sim.info.total_storage        = config->size;
+    sim.info.program_unit         = config->program_unit;
+    sim.info.optimal_program_unit = sim.config.optimal_program_unit;
+    sim.info.program_cycles       = config->program_cycles;
+    sim.info.erased_value         = config->erased_value ? 1 : 0;
+    sim.info.memory_mapped        = 0;
+    sim.info.programmability      = ARM_STORAGE_PROGRAMMABILITY_ERASABLE;
+    sim.info.retention_level      = ARM_RETENTION_NVM;
+
+    sim.block.addr                       = config->base_addr;
+    sim.block.size                       = config->size;
+    sim.block.attributes.erasable        = 1;
+    sim.block.attributes.programmable    = 1;
+    sim.block.attributes.erase_unit      = config->erase_unit;
+
+    if (erase) {
+        memset(config->memory, config->erased_value ? 0xFF : 0x00, (size_t)config->size);
+        if (config->erase_counts != NULL) {
+            memset(config->erase_counts, 0, (size_t)(config->size / config->erase_unit) * sizeof(uint32_t));
+        }
+    }
+
+    sim.configured = true;
+    return ARM_DRIVER_OK;
+}
+
+uint64_t storage_sim_now(void)
+{
+    return sim.now;
+}
+
+/**
+ * Latency of the operation described by the current* fields.
+ */
+static uint64_t latencyOfCurrentCommand(void)
+{
+    const storage_sim_config_t *config = &sim.config;
+
+    switch (sim.currentCommand) {
+        case ARM_STORAGE_OPERATION_READ_DATA:
+            return config->read_setup_us + ((uint64_t)sim.sizeofCurrentOperation * config->read_ns_per_byte) / 1000;
+        case ARM_STORAGE_OPERATION_PROGRAM_DATA:
+            return config->program_setup_us +
+                   (uint64_t)((sim.sizeofCurrentOperation + config->program_unit - 1) / config->program_unit) * config->program_us_per_unit;
+        case ARM_STORAGE_OPERATION_ERASE:
+        case ARM_STORAGE_OPERATION_ERASE_ALL:
+            return (uint64_t)(sim.sizeofCurrentOperation / config->erase_unit) * config->erase_us_per_unit;
+        default:
+            return 0;
+    }
+}
+
+static int32_t programCurrentCommand(void)
+{
+    uint8_t       *dst = sim.config.memory + (sim.currentOperatingStorageAddress - sim.config.base_addr);
+    const uint8_t *src = sim.currentOperatingData;
+    bool           verified = true;
+
+    sim.stats.programs++;
+    sim.stats.bytes_programmed += sim.sizeofCurrentOperation;
+
+    /* Like flash, programming can only move bits away from the erased value. */
+    for (uint32_t i = 0; i < sim.sizeofCurrentOperation; i++) {
+        uint8_t programmed = sim.config.erased_value ? (uint8_t)(dst[i] & src[i]) : (uint8_t)(dst[i] | src[i]);
+        if (programmed != src[i]) {
+            verified = false;
+        }
+        dst[i] = programmed;
+    }
+    if (!verified) {
+        tr_debug("storage_sim: program at 0x%llx over unerased data", sim.currentOperatingStorageAddress);
+        return ARM_STORAGE_ERROR_RUNTIME_OR_INTEGRITY_FAILURE;
+    }
+
+    return (int32_t)sim.sizeofCurrentOperation;
+}
+
+static int32_t eraseCurrentCommand(void)
+{
+    uint64_t offset = sim.currentOperatingStorageAddress - sim.config.base_addr;
+
+    for (uint64_t erased = 0; erased < sim.sizeofCurrentOperation; erased += sim.config.erase_unit) {
+        if (sim.config.erase_counts != NULL) {
+            uint32_t *count = &sim.config.erase_counts[(offset + erased) / sim.config.erase_unit];
+            if ((sim.config.program_cycles != ARM_STORAGE_PROGRAM_CYCLES_INFINITE) && (*count >= sim.config.program_cycles)) {
+                tr_debug("storage_sim: erase unit at 0x%llx is worn out", sim.currentOperatingStorageAddress + erased);
+                return ARM_STORAGE_ERROR_RUNTIME_OR_INTEGRITY_FAILURE;
+            }
+            (*count)++;
+        }
+        memset(sim.config.memory + offset + erased, sim.config.erased_value ? 0xFF : 0x00, sim.config.erase_unit);
+        sim.stats.erases++;
+    }
+
+    return (sim.currentCommand == ARM_STORAGE_OPERATION_ERASE_ALL) ? 1 : (int32_t)sim.sizeofCurrentOperation;
+}
+
+/**
+ * Carry out the operation described by the current* fields.
+ *
+ * @return the status to be returned for synchronous completion or passed to
+ *     the completion callback.
+ */
+static int32_t executeCurrentCommand(void)
+{
+    int32_t status;
+
+    switch (sim.currentCommand) {
+        case ARM_STORAGE_OPERATION_READ_DATA:
+            memcpy(sim.currentReadBuffer,
+                   sim.config.memory + (sim.currentOperatingStorageAddress - sim.config.base_addr),
+                   sim.sizeofCurrentOperation);
+            sim.stats.reads++;
+            sim.stats.bytes_read += sim.sizeofCurrentOperation;
+            status = (int32_t)sim.sizeofCurrentOperation;
+            break;
+
+        case ARM_STORAGE_OPERATION_PROGRAM_DATA:
+            status = programCurrentCommand();
+            break;
+
+        case ARM_STORAGE_OPERATION_ERASE:
+        case ARM_STORAGE_OPERATION_ERASE_ALL:
+            status = eraseCurrentCommand();
+            break;
+
+        default:
+            status = ARM_DRIVER_ERROR;
+            break;
+    }
+
+    sim.failed = (status < ARM_DRIVER_OK);
+    return status;
+}
+
+/**
+ * Start the operation described by the current* fields; either carry it out
+ * right away, advancing the clock by its latency, or leave it pending until the
+ * clock reaches its completion time.
+ */
+static int32_t startCurrentCommand(void)
+{
+    uint64_t latency = latencyOfCurrentCommand();
+
+    sim.stats.busy_us += latency;
+    if (!sim.caps.asynchronous_ops ||
+        ((sim.currentCommand == ARM_STORAGE_OPERATION_READ_DATA) && !sim.config.asynchronous_reads)) {
+        sim.now += latency;
+        return executeCurrentCommand();
+    }
+
+    sim.pending        = true;
+    sim.completionTime = sim.now + latency;
+    return ARM_DRIVER_OK;
+}
+
+static void completeCurrentCommand(void)
+{
+    sim.pending = false;
+    sim.now     = sim.completionTime;
+
+    int32_t status = executeCurrentCommand();
+    if (sim.commandCompletionCallback) {
+        sim.commandCompletionCallback(status, sim.currentCommand);
+    }
+}
+
+void storage_sim_advance(uint64_t us)
+{
+    uint64_t until = sim.now + us;
+
+    while (sim.pending && (sim.completionTime <= until)) {
+        completeCurrentCommand();
+    }
+    sim.now = until;
+}
+
+uint32_t storage_sim_dispatch(void)
+{
+    uint32_t completed = 0;
+
+    while (sim.pending) {
+        completeCurrentCommand();
+        completed++;
+    }
+    return completed;
+}
+
+void storage_sim_get_stats(storage_sim_stats_t *stats)
+{
+    *stats = sim.stats;
+    stats->min_erase_count = 0;
+    stats->max_erase_count = 0;
+
+    if (sim.configured && (sim.config.erase_counts != NULL)) {
+        uint32_t numEraseUnits = (uint32_t)(sim.config.size / sim.config.erase_unit);
+
+        stats->min_erase_count = UINT32_MAX;
+        for (uint32_t index = 0; index < numEraseUnits; index++) {
+            uint32_t count = sim.config.erase_counts[index];
+            if (count < stats->min_erase_count) {
+                stats->min_erase_count = count;
+            }
+            if (count > stats->max_erase_count) {
+                stats->max_erase_count = count;
+            }
+        }
+    }
+}
+
+void storage_sim_reset_stats(void)
+{
+    memset(&sim.stats, 0, sizeof(sim.stats));
+}
+
+int32_t storage_sim_save(const char *path)
+{
+    if (!sim.configured) {
+        return ARM_DRIVER_ERROR;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        return ARM_DRIVER_ERROR;
+    }
+
+    size_t numEraseUnits = (size_t)(sim.config.size / sim.config.erase_unit);
+    bool   written = (fwrite(sim.config.memory, 1, (size_t)sim.config.size, file) == sim.config.size);
+    if (written && (sim.config.erase_counts != NULL)) {
+        written = (fwrite(sim.config.erase_counts, sizeof(uint32_t), numEraseUnits, file) == numEraseUnits);
+    }
+    if (fclose(file) != 0) {
+        written = false;
+    }
+
+    return written ? ARM_DRIVER_OK : ARM_DRIVER_ERROR;
+}
+
+int32_t storage_sim_load(const storage_sim_config_t *config, const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return ARM_DRIVER_ERROR;
+    }
+
+    size_t numEraseUnits = (size_t)(config->size / config->erase_unit);
+    bool   read = (fread(config->memory, 1, (size_t)config->size, file) == config->size);
+    if (read && (config->erase_counts != NULL)) {
+        read = (fread(config->erase_counts, sizeof(uint32_t), numEraseUnits, file) == numEraseUnits);
+    }
+    fclose(file);
+
+    return read ? ARM_DRIVER_OK : ARM_DRIVER_ERROR;
+}
+
+/*
+ * The ARM_DRIVER_STORAGE interface.
+ */
+
+static ARM_DRIVER_VERSION getVersion(void)
+{
+    return version;
+}
+
+static ARM_STORAGE_CAPABILITIES getCapabilities(void)
+{
+    return sim.caps;
+}
+
+static int32_t initialize(ARM_Storage_Callback_t callback)
+{
+    tr_debug("called initialize(%p)", callback);
+
+    if (!sim.configured) {
+        return ARM_DRIVER_ERROR;
+    }
+    if (sim.pending) {
+        return (int32_t)ARM_DRIVER_ERROR_BUSY;
+    }
+
+    sim.commandCompletionCallback = callback;
+    sim.initialized               = true;
+    return 1; /* synchronous completion. */
+}
+
+static int32_t uninitialize(void)
+{
+    tr_debug("called uninitialize");
+
+    if (!sim.initialized) {
+        return ARM_DRIVER_ERROR;
+    }
+    if (sim.pending) {
+        return (int32_t)ARM_DRIVER_ERROR_BUSY;
+    }
+
+    sim.commandCompletionCallback = NULL;
+    sim.initialized               = false;
+    return 1; /* synchronous completion. */
+}
+
+static int32_t powerControl(ARM_POWER_STATE state)
+{
+    (void)state;
+    tr_debug("called powerControl(%u)", state);
+
+    return 1; /* signal synchronous completion. */
+}
+
+/**
+ * Check that [addr, addr + size) lies within the device and, if 'unit' is
+ * non-zero, that the range is aligned to it.
+ */
+static int32_t checkRange(uint64_t addr, uint32_t size, uint32_t unit)
+{
+    if (!sim.initialized) {
+        return ARM_DRIVER_ERROR; /* illegal */
+    }
+    if (sim.pending) {
+        return (int32_t)ARM_DRIVER_ERROR_BUSY;
+    }
+    if ((size == 0) ||
+        (addr < sim.config.base_addr) ||
+        ((addr - sim.config.base_addr) > sim.config.size) ||
+        (size > (sim.config.size - (addr - sim.config.base_addr)))) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+    if ((unit > 1) && ((((addr - sim.config.base_addr) % unit) != 0) || ((size % unit) != 0))) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+static int32_t readData(uint64_t addr, void *data, uint32_t size)
+{
+    tr_debug("called ReadData(%llu, %p, %lu)", addr, data, size);
+
+    int32_t rc = checkRange(addr, size, 0);
+    if (rc != ARM_DRIVER_OK) {
+        return rc;
+    }
+    if (data == NULL) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    sim.currentCommand                 = ARM_STORAGE_OPERATION_READ_DATA;
+    sim.currentOperatingStorageAddress = addr;
+    sim.sizeofCurrentOperation         = size;
+    sim.currentReadBuffer              = data;
+    return startCurrentCommand();
+}
+
+static int32_t programData(uint64_t addr, const void *data, uint32_t size)
+{
+    tr_debug("called ProgramData(%llu, %p, %lu)", addr, data, size);
+
+    int32_t rc = checkRange(addr, size, sim.config.program_unit);
+    if (rc != ARM_DRIVER_OK) {
+        return rc;
+    }
+    if (data == NULL) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    sim.currentCommand                 = ARM_STORAGE_OPERATION_PROGRAM_DATA;
+    sim.currentOperatingStorageAddress = addr;
+    sim.sizeofCurrentOperation         = size;
+    sim.currentOperatingData           = (const uint8_t *)data;
+    return startCurrentCommand();
+}
+
+static int32_t erase(uint64_t addr, uint32_t size)
+{
+    tr_debug("called erase(%llu, %lu)", addr, size);
+
+    int32_t rc = checkRange(addr, size, sim.config.erase_unit);
+    if (rc != ARM_DRIVER_OK) {
+        return rc;
+    }
+
+    sim.currentCommand                 = ARM_STORAGE_OPERATION_ERASE;
+    sim.currentOperatingStorageAddress = addr;
+    sim.sizeofCurrentOperation         = size;
+    return startCurrentCommand();
+}
+
+static int32_t eraseAll(void)
+{
+    tr_debug("called eraseAll");
+
+    int32_t rc = checkRange(sim.config.base_addr, (uint32_t)sim.config.size, sim.config.erase_unit);
+    if (rc != ARM_DRIVER_OK) {
+        return rc;
+    }
+
+    sim.currentCommand                 = ARM_STORAGE_OPERATION_ERASE_ALL;
+    sim.currentOperatingStorageAddress = sim.config.base_addr;
+    sim.sizeofCurrentOperation         = (uint32_t)sim.config.size;
+    return startCurrentCommand();
+}
+
+static ARM_STORAGE_STATUS getStatus(void)
+{
+    ARM_STORAGE_STATUS status = {
+        .busy  = 0,
+        .error = 0,
+    };
+
+    if (!sim.initialized) {
+        status.error = 1;
+        return status;
+    }
+
+    if (sim.pending) {
+        status.busy = 1;
+    } else if (sim.failed) {
+        status.error = 1;
+    }
+    return status;
+}
+
+static int32_t getInfo(ARM_STORAGE_INFO *infoP)
+{
+    memcpy(infoP, &sim.info, sizeof(ARM_STORAGE_INFO));
+
+    return ARM_DRIVER_OK;
+}
+
+static uint32_t resolveAddress(uint64_t addr)
+{
+    (void)addr;
+    return ARM_STORAGE_INVALID_ADDRESS; /* not memory mapped. */
+}
+
+static int32_t nextBlock(const ARM_STORAGE_BLOCK *prevP, ARM_STORAGE_BLOCK *nextP)
+{
+    if ((prevP == NULL) && sim.configured) {
+        /* fetching the first (and only) block */
+        if (nextP) {
+            memcpy(nextP, &sim.block, sizeof(ARM_STORAGE_BLOCK));
+        }
+        return ARM_DRIVER_OK;
+    }
+
+    if (nextP) {
+        nextP->addr = ARM_STORAGE_INVALID_OFFSET;
+        nextP->size = 0;
+    }
+    return ARM_DRIVER_ERROR;
+}
+
+static int32_t getBlock(uint64_t addr, ARM_STORAGE_BLOCK *blockP)
+{
+    if (sim.configured && (addr >= sim.block.addr) && (addr < (sim.block.addr + sim.block.size))) {
+        if (blockP) {
+            memcpy(blockP, &sim.block, sizeof(ARM_STORAGE_BLOCK));
+        }
+        return ARM_DRIVER_OK;
+    }
+
+    if (blockP) {
+        blockP->addr = ARM_STORAGE_INVALID_OFFSET;
+        blockP->size = 0;
+    }
+    return ARM_DRIVER_ERROR;
+}
+
+ARM_DRIVER_STORAGE ARM_Driver_Storage_MTD_SIM = {
+    .GetVersion      = getVersion,
+    .GetCapabilities = getCapabilities,
+    .Initialize      = initialize,
+    .Uninitialize    = uninitialize,
+    .PowerControl    = powerControl,
+    .ReadData        = readData,
+    .ProgramData     = programData,
+    .Erase           = erase,
+    .EraseAll        = eraseAll,
+    .GetStatus       = getStatus,
+    .GetInfo         = getInfo,
+    .ResolveAddress  = resolveAddress,
+    .GetNextBlock    = nextBlock,
+    .GetBlock        = getBlock
+};
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2006-2017, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __STORAGE_SIM_H__
+#define __STORAGE_SIM_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "storage_abstraction/Driver_Storage.h"
+
+/**
+ * A simulated NOR flash implementing the complete ARM_DRIVER_STORAGE
+ * contract over caller-provided memory, so that the storage stack (cfstore,
+ * flash-journal, storage-volume-manager) can be exercised and measured on any
+ * target or on a host.
+ *
+ * The device behaves like internal flash: programming can only change bits
+ * away from the erased value, program and erase ranges must be aligned to
+ * program_unit and erase_unit, and erases wear out after program_cycles.
+ *
+ * Timing is modelled with a simulated clock rather than by sleeping, so
+ * measurements are deterministic and independent of the host. Synchronous
+ * operations advance the clock by their latency before returning. In
+ * asynchronous mode operations return ARM_DRIVER_OK, take effect when the
+ * clock reaches their completion time and then invoke the completion callback;
+ * the clock is advanced by storage_sim_advance() or storage_sim_dispatch().
+ * Initialize, Uninitialize and PowerControl always complete synchronously.
+ */
+
+/** Geometry, behaviour and timing of the simulated device. */
+typedef struct storage_sim_config {
+    uint8_t  *memory;               /**< backing memory of 'size' bytes, owned by the caller. */
+    uint32_t *erase_counts;         /**< optional erase counters, one per erase unit, owned by the caller; may be NULL. */
+    uint64_t  base_addr;            /**< address of the (single) storage block in the storage map. */
+    uint64_t  size;                 /**< size of the device; a multiple of erase_unit. */
+    uint32_t  program_unit;
+    uint32_t  optimal_program_unit;
+    uint32_t  erase_unit;
+    uint32_t  program_cycles;       /**< erases of an erase unit before it fails; ARM_STORAGE_PROGRAM_CYCLES_INFINITE for no wear-out. */
+    uint8_t   asynchronous;         /**< complete ProgramData, Erase and EraseAll with a callback. */
+    uint8_t   asynchronous_reads;   /**< complete ReadData with a callback as well; memory-mapped flash (e.g. K64F) always reads synchronously. */
+    uint8_t   erased_value;         /**< 1 for erased bytes reading 0xFF, 0 for 0x00. */
+
+    uint32_t  read_setup_us;        /**< latency of each ReadData. */
+    uint32_t  read_ns_per_byte;
+    uint32_t  program_setup_us;     /**< latency of each ProgramData. */
+    uint32_t  program_us_per_unit;  /**< additional latency per program_unit programmed. */
+    uint32_t  erase_us_per_unit;    /**< latency per erase_unit erased. */
+} storage_sim_config_t;
+
+/** Activity counters, as returned by storage_sim_get_stats(). */
+typedef struct storage_sim_stats {
+    uint32_t  reads;                /**< ReadData operations. */
+    uint32_t  programs;             /**< ProgramData operations. */
+    uint32_t  erases;               /**< erase units erased, by Erase or EraseAll. */
+    uint64_t  bytes_read;
+    uint64_t  bytes_programmed;
+    uint64_t  busy_us;              /**< simulated time the device spent executing operations. */
+    uint32_t  min_erase_count;      /**< wear of the least erased erase unit; 0 without erase_counts. */
+    uint32_t  max_erase_count;      /**< wear of the most erased erase unit; 0 without erase_counts. */
+} storage_sim_stats_t;
+
+/** The simulated device. storage_sim_configure() must be called before use. */
+extern ARM_DRIVER_STORAGE ARM_Driver_Storage_MTD_SIM;
+
+/**
+ * Fill in a configuration resembling the internal flash of a Cortex-M
+ * microcontroller (8 byte program unit, 4KB erase unit, tens of microseconds
+ * per program unit and tens of milliseconds per erase), synchronous and
+ * without wear-out. The caller supplies memory, size and optionally erase_counts.
+ */
+void storage_sim_config_default(storage_sim_config_t *config);
+
+/**
+ * (Re)configure the simulated device. Any pending operation is discarded, the
+ * memory is erased when 'erase' is set and the erase counters are then zeroed;
+ * otherwise the memory and erase counters are used as found, e.g. as loaded by
+ * storage_sim_load(). The clock and statistics are reset.
+ *
+ * @return ARM_DRIVER_OK, or ARM_DRIVER_ERROR_PARAMETER for an inconsistent geometry.
+ */
+int32_t storage_sim_configure(const storage_sim_config_t *config, int erase);
+
+/** @return the simulated time in microseconds since storage_sim_configure(). */
+uint64_t storage_sim_now(void);
+
+/**
+ * Advance the simulated clock by 'us' microseconds, e.g. to model time spent
+ * computing between operations, completing the pending operation if the clock
+ * reaches its completion time. Operations issued by the completion callback
+ * start at the time of completion.
+ */
+void storage_sim_advance(uint64_t us);
+
+/**
+ * Advance the simulated clock until no operation is pending, completing each
+ * operation in turn, including those issued by completion callbacks.
+ *
+ * @return the number of operations completed.
+ */
+uint32_t storage_sim_dispatch(void);
+
+/** Read the activity counters and the wear of the device. */
+void storage_sim_get_stats(storage_sim_stats_t *stats);
+
+/** Zero the activity counters; the clock and the erase counters are unaffected. */
+void storage_sim_reset_stats(void);
+
+/**
+ * Save the contents of the device, followed by the erase counters if any, to
+ * a file, so that a later run can storage_sim_load() it and measure e.g. the
+ * time to mount an aged journal.
+ *
+ * @return ARM_DRIVER_OK, or ARM_DRIVER_ERROR if the file can't be written.
+ */
+int32_t storage_sim_save(const char *path);
+
+/**
+ * Load the contents of the device (and the erase counters if any) from a file
+ * written by storage_sim_save() for the same configuration. Call
+ * storage_sim_configure() with 'erase' cleared afterwards to start using it.
+ *
+ * @return ARM_DRIVER_OK, or ARM_DRIVER_ERROR if the file can't be read.
+ */
+int32_t storage_sim_load(const storage_sim_config_t *config, const char *path);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif /* __STORAGE_SIM_H__ */
@@ -0,0 +1,281 @@
+/*
+ * Host benchmark of the flash-journal strategies over the simulated storage driver
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "storage-sim/storage_sim.h"
+#include "flash-journal-strategy-sequential/flash_journal_strategy_sequential.h"
+#include "flash-journal-strategy-ring/flash_journal_strategy_ring.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+
+// Benchmark setup
+#define BENCH_STORAGE_SIZE (512*1024)
+#define BENCH_COMMITS 200
+#define BENCH_SEQUENTIAL_SLOTS 4
+#define BENCH_RING_CHECKPOINT_INTERVAL 16
+
+static uint8_t memory[BENCH_STORAGE_SIZE];
+static uint32_t erase_counts[BENCH_STORAGE_SIZE / 4096];
+static uint8_t blob[16*1024];
+static uint8_t readback[16*1024];
+
+static ARM_DRIVER_STORAGE *mtd = &ARM_Driver_Storage_MTD_SIM;
+static FlashJournal_t journal;
+
+static const uint32_t blob_sizes[] = {64, 1024, 16*1024};
+
+
+// Test assert
+#define check(test) do { \
+    if (!(test)) { \
+        printf("\e[31mfailed %s:%d: %s\e[0m\n", __FILE__, __LINE__, #test); \
+        exit(1); \
+    } \
+} while (0)
+
+
+// Completion of journal operations
+static int32_t callback_status;
+static int callback_count;
+
+static void journal_callback(int32_t status, FlashJournal_OpCode_t cmd_code) {
+    (void)cmd_code;
+    callback_status = status;
+    callback_count++;
+}
+
+// Wait for the journal operation that returned rc, returning its status
+static int32_t complete(int32_t rc) {
+    if (rc != JOURNAL_STATUS_OK) {
+        return rc;
+    }
+
+    callback_count = 0;
+    storage_sim_dispatch();
+    check(callback_count == 1);
+    return callback_status;
+}
+
+
+// Strategies under test
+struct strategy {
+    const char *name;
+    const FlashJournal_Ops_t *ops;
+    int32_t (*format)(void);
+};
+
+static int32_t format_sequential(void) {
+    return flashJournalStrategySequential_format(mtd, BENCH_SEQUENTIAL_SLOTS, journal_callback);
+}
+
+static int32_t format_ring(void) {
+    return flashJournalStrategyRing_format(mtd, BENCH_RING_CHECKPOINT_INTERVAL, journal_callback);
+}
+
+static const struct strategy strategies[] = {
+    {"sequential", &FLASH_JOURNAL_STRATEGY_SEQUENTIAL, format_sequential},
+    {"ring",       &FLASH_JOURNAL_STRATEGY_RING,       format_ring},
+};
+
+
+static void fill(uint8_t *buffer, uint32_t size, uint32_t seed) {
+    for (uint32_t i = 0; i < size; i++) {
+        buffer[i] = (uint8_t)(seed*131 + i*7 + (i >> 8));
+    }
+}
+
+static uint64_t mount(const struct strategy *strategy) {
+    uint64_t start = storage_sim_now();
+    int32_t rc = complete(FlashJournal_initialize(&journal, mtd, strategy->ops, journal_callback));
+    check(rc == 1);
+    return storage_sim_now() - start;
+}
+
+static void commit(uint32_t size, uint32_t seed) {
+    fill(blob, size, seed);
+
+    uint32_t logged = 0;
+    while (logged < size) {
+        int32_t rc = complete(FlashJournal_log(&journal, blob + logged, size - logged));
+        check(rc > 0);
+        logged += rc;
+    }
+
+    check(complete(FlashJournal_commit(&journal)) == 1);
+}
+
+static void verify(uint32_t size, uint32_t seed) {
+    fill(blob, size, seed);
+    check(complete(FlashJournal_read(&journal, readback, size)) == (int32_t)size);
+    check(memcmp(blob, readback, size) == 0);
+}
+
+
+// Run one strategy over a freshly configured device
+static void bench_strategy(const struct strategy *strategy, int asynchronous) {
+    storage_sim_config_t config;
+    storage_sim_config_default(&config);
+    config.memory = memory;
+    config.erase_counts = erase_counts;
+    config.size = BENCH_STORAGE_SIZE;
+    config.asynchronous = asynchronous;
+    check(storage_sim_configure(&config, 1) == ARM_DRIVER_OK);
+
+    const char *mode = asynchronous ? "async" : "sync";
+    uint64_t start = storage_sim_now();
+    check(complete(strategy->format()) == 1);
+    printf("%-10s %-5s format: %10" PRIu64 " us\n",
+            strategy->name, mode, storage_sim_now() - start);
+    printf("%-10s %-5s mount (empty): %10" PRIu64 " us\n",
+            strategy->name, mode, mount(strategy));
+
+    uint32_t seed = 0;
+    for (unsigned i = 0; i < sizeof(blob_sizes)/sizeof(blob_sizes[0]); i++) {
+        uint32_t size = blob_sizes[i];
+        storage_sim_reset_stats();
+        start = storage_sim_now();
+        for (unsigned j = 0; j < BENCH_COMMITS; j++) {
+            commit(size, ++seed);
+        }
+        uint64_t elapsed = storage_sim_now() - start;
+        verify(size, seed);
+
+        storage_sim_stats_t stats;
+        storage_sim_get_stats(&stats);
+        uint64_t written = stats.bytes_programmed + (uint64_t)stats.erases*config.erase_unit;
+        printf("%-10s %-5s commit %5" PRIu32 "B: %10" PRIu64 " us/commit, "
+                "write amplification %6.2f (programmed %6.2f, erased %6.2f)\n",
+                strategy->name, mode, size, elapsed / BENCH_COMMITS,
+                (double)written / ((uint64_t)size*BENCH_COMMITS),
+                (double)stats.bytes_programmed / ((uint64_t)size*BENCH_COMMITS),
+                (double)stats.erases*config.erase_unit / ((uint64_t)size*BENCH_COMMITS));
+
+        uint64_t mount_time = mount(strategy);
+        verify(size, seed);
+        printf("%-10s %-5s mount: %10" PRIu64 " us\n",
+                strategy->name, mode, mount_time);
+    }
+
+    storage_sim_stats_t stats;
+    storage_sim_get_stats(&stats);
+    printf("%-10s %-5s wear: %" PRIu32 "..%" PRIu32 " erases per sector\n",
+            strategy->name, mode, stats.min_erase_count, stats.max_erase_count);
+}
+
+
+// Check the driver itself against the storage contract
+static int32_t driver_status;
+static ARM_STORAGE_OPERATION driver_operation;
+static int driver_count;
+
+static void driver_callback(int32_t status, ARM_STORAGE_OPERATION operation) {
+    driver_status = status;
+    driver_operation = operation;
+    driver_count++;
+}
+
+static void test_driver(void) {
+    storage_sim_config_t config;
+    storage_sim_config_default(&config);
+    config.memory = memory;
+    config.erase_counts = erase_counts;
+    config.size = 64*1024;
+    config.base_addr = 0x80000;
+    config.program_cycles = 2;
+    check(storage_sim_configure(&config, 1) == ARM_DRIVER_OK);
+
+    ARM_STORAGE_BLOCK block;
+    check(mtd->GetNextBlock(NULL, &block) == ARM_DRIVER_OK);
+    check(block.addr == 0x80000 && block.size == 64*1024);
+    check(block.attributes.erase_unit == 4096);
+    check(mtd->GetNextBlock(&block, &block) != ARM_DRIVER_OK);
+    check(!ARM_STORAGE_VALID_BLOCK(&block));
+    check(mtd->GetBlock(0x80000 + 64*1024, NULL) != ARM_DRIVER_OK);
+
+    // synchronous operations
+    uint8_t data[16];
+    memset(data, 0x5a, sizeof(data));
+    check(mtd->ReadData(0x80000, data, 8) == ARM_DRIVER_ERROR);
+    check(mtd->Initialize(driver_callback) == 1);
+    check(mtd->ProgramData(0x80004, data, 8) == ARM_DRIVER_ERROR_PARAMETER);
+    check(mtd->ProgramData(0x80000, data, 12) == ARM_DRIVER_ERROR_PARAMETER);
+    check(mtd->ProgramData(0x80000 + 64*1024, data, 8) == ARM_DRIVER_ERROR_PARAMETER);
+    check(mtd->Erase(0x80000, 100) == ARM_DRIVER_ERROR_PARAMETER);
+
+    uint64_t start = storage_sim_now();
+    check(mtd->ProgramData(0x80000, data, 16) == 16);
+    check(storage_sim_now() - start == config.program_setup_us + 2*config.program_us_per_unit);
+    data[0] = 0xff;
+    check(mtd->ProgramData(0x80000, data, 8) == ARM_STORAGE_ERROR_RUNTIME_OR_INTEGRITY_FAILURE);
+    check(mtd->GetStatus().error);
+    check(mtd->ReadData(0x80000, data, 1) == 1 && data[0] == 0x5a);
+    check(!mtd->GetStatus().error);
+
+    // wear-out
+    check(mtd->Erase(0x80000, 4096) == 4096);
+    check(mtd->Erase(0x80000, 8192) == 8192);
+    check(mtd->ReadData(0x80000, data, 1) == 1 && data[0] == 0xff);
+    check(mtd->Erase(0x80000, 4096) == ARM_STORAGE_ERROR_RUNTIME_OR_INTEGRITY_FAILURE);
+    storage_sim_stats_t stats;
+    storage_sim_get_stats(&stats);
+    check(stats.erases == 3 && stats.min_erase_count == 0 && stats.max_erase_count == 2);
+
+    // asynchronous operations
+    config.asynchronous = 1;
+    config.asynchronous_reads = 1;
+    config.program_cycles = ARM_STORAGE_PROGRAM_CYCLES_INFINITE;
+    check(storage_sim_configure(&config, 1) == ARM_DRIVER_OK);
+    check(mtd->GetCapabilities().asynchronous_ops);
+    check(mtd->Initialize(driver_callback) == 1);
+
+    memset(data, 0x33, sizeof(data));
+    driver_count = 0;
+    check(mtd->ProgramData(0x80008, data, 8) == ARM_DRIVER_OK);
+    check(mtd->GetStatus().busy);
+    check(mtd->ReadData(0x80008, data, 8) == ARM_DRIVER_ERROR_BUSY);
+    storage_sim_advance(config.program_setup_us);
+    check(driver_count == 0 && mtd->GetStatus().busy);
+    storage_sim_advance(config.program_us_per_unit);
+    check(driver_count == 1 && !mtd->GetStatus().busy);
+    check(driver_status == 8 && driver_operation == ARM_STORAGE_OPERATION_PROGRAM_DATA);
+
+    memset(data, 0, sizeof(data));
+    check(mtd->ReadData(0x80008, data, 8) == ARM_DRIVER_OK);
+    check(data[0] == 0);
+    check(storage_sim_dispatch() == 1);
+    check(driver_count == 2 && driver_status == 8 && data[0] == 0x33);
+
+    check(mtd->EraseAll() == ARM_DRIVER_OK);
+    check(storage_sim_dispatch() == 1);
+    check(driver_status == 1 && driver_operation == ARM_STORAGE_OPERATION_ERASE_ALL);
+    check(storage_sim_now() == config.program_setup_us + config.program_us_per_unit
+            + config.read_setup_us + 16*config.erase_us_per_unit);
+}
+
+
+// Entry point
+int main(void) {
+    test_driver();
+
+    for (unsigned i = 0; i < sizeof(strategies)/sizeof(strategies[0]); i++) {
+        bench_strategy(&strategies[i], 0);
+        bench_strategy(&strategies[i], 1);
+    }
+
+    printf("\e[32mdone\e[0m\n");
+    return 0;
+}
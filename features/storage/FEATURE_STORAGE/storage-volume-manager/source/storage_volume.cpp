@@ -29,6 +29,31 @@ void StorageVolume::setup(uint64_t _addr, uint64_t _size, StorageVolumeManager *
     volumeSize    = _size;
     volumeManager = _volumeManager;
     allocated     = true;
+    queued        = false;
+    resetStatistics();
+}
+
+/**
+ * Is an operation of this volume either in progress or waiting for the storage?
+ */
+bool StorageVolume::hasRequest(void) const
+{
+    return queued || (volumeManager->activeVolume == this);
+}
+
+/**
+ * Hand an operation over to the volume-manager; it is started right away if
+ * the storage is available, or else queued until the operations of other
+ * volumes have completed.
+ */
+int32_t StorageVolume::submitRequest(ARM_STORAGE_OPERATION operation, uint64_t addr, const void *data, uint32_t size)
+{
+    request.operation = operation;
+    request.addr      = addr;
+    request.data      = data;
+    request.size      = size;
+
+    return volumeManager->submitRequest(this);
 }
 
 ARM_DRIVER_VERSION StorageVolume::GetVersion(void)
@@ -77,16 +102,12 @@ int32_t StorageVolume::PowerControl(ARM_POWER_STATE state)
     if (!allocated) {
         return STORAGE_VOLUME_MANAGER_STATUS_ERROR_VOLUME_NOT_ALLOCATED;
     }
-    if (volumeManager->activeVolume != NULL) {
+    if (hasRequest()) {
         return ARM_DRIVER_ERROR_BUSY;
     }
 
-    volumeManager->activeVolume = this;
-    int32_t rc = volumeManager->getStorage()->PowerControl(state);
-    if (rc != ARM_DRIVER_OK) {
-        volumeManager->activeVolume = NULL; /* we're certain that there is no more pending asynch. activity */
-    }
-    return rc;
+    request.state = state;
+    return submitRequest(ARM_STORAGE_OPERATION_POWER_CONTROL, 0, NULL, 0);
 }
 
 int32_t StorageVolume::ReadData(uint64_t addr, void *data, uint32_t size)
@@ -95,19 +116,14 @@ int32_t StorageVolume::ReadData(uint64_t addr, void *data, uint32_t size)
     if (!allocated) {
         return STORAGE_VOLUME_MANAGER_STATUS_ERROR_VOLUME_NOT_ALLOCATED;
     }
-    if (volumeManager->activeVolume != NULL) {
+    if (hasRequest()) {
         return ARM_DRIVER_ERROR_BUSY;
     }
     if ((size > volumeSize) || ((addr + size) > volumeSize)) {
         return ARM_DRIVER_ERROR_PARAMETER;
     }
 
-    volumeManager->activeVolume = this;
-    int32_t rc = volumeManager->getStorage()->ReadData(volumeOffset + addr, data, size);
-    if (rc != ARM_DRIVER_OK) {
-        volumeManager->activeVolume = NULL; /* we're certain that there is no more pending asynch. activity */
-    }
-    return rc;
+    return submitRequest(ARM_STORAGE_OPERATION_READ_DATA, volumeOffset + addr, data, size);
 }
 
 int32_t StorageVolume::ProgramData(uint64_t addr, const void *data, uint32_t size)
@@ -116,19 +132,14 @@ int32_t StorageVolume::ProgramData(uint64_t addr, const void *data, uint32_t siz
     if (!allocated) {
         return STORAGE_VOLUME_MANAGER_STATUS_ERROR_VOLUME_NOT_ALLOCATED;
     }
-    if (volumeManager->activeVolume != NULL) {
+    if (hasRequest()) {
         return ARM_DRIVER_ERROR_BUSY;
     }
     if ((size > volumeSize) || ((addr + size) > volumeSize)) {
         return ARM_DRIVER_ERROR_PARAMETER;
     }
 
-    volumeManager->activeVolume = this;
-    int32_t rc = volumeManager->getStorage()->ProgramData(volumeOffset + addr, data, size);
-    if (rc != ARM_DRIVER_OK) {
-        volumeManager->activeVolume = NULL; /* we're certain that there is no more pending asynch. activity */
-    }
-    return rc;
+    return submitRequest(ARM_STORAGE_OPERATION_PROGRAM_DATA, volumeOffset + addr, data, size);
 }
 
 int32_t StorageVolume::Erase(uint64_t addr, uint32_t size)
@@ -137,19 +148,14 @@ int32_t StorageVolume::Erase(uint64_t addr, uint32_t size)
     if (!allocated) {
         return STORAGE_VOLUME_MANAGER_STATUS_ERROR_VOLUME_NOT_ALLOCATED;
     }
-    if (volumeManager->activeVolume != NULL) {
+    if (hasRequest()) {
         return ARM_DRIVER_ERROR_BUSY;
     }
     if ((size > volumeSize) || ((addr + size) > volumeSize)) {
         return ARM_DRIVER_ERROR_PARAMETER;
     }
 
-    volumeManager->activeVolume = this;
-    int32_t rc = volumeManager->getStorage()->Erase(volumeOffset + addr, size);
-    if (rc != ARM_DRIVER_OK) {
-        volumeManager->activeVolume = NULL; /* we're certain that there is no more pending asynch. activity */
-    }
-    return rc;
+    return submitRequest(ARM_STORAGE_OPERATION_ERASE, volumeOffset + addr, NULL, size);
 }
 
 int32_t StorageVolume::EraseAll(void)
@@ -158,7 +164,7 @@ int32_t StorageVolume::EraseAll(void)
     if (!allocated) {
         return STORAGE_VOLUME_MANAGER_STATUS_ERROR_VOLUME_NOT_ALLOCATED;
     }
-    if (volumeManager->activeVolume != NULL) {
+    if (hasRequest()) {
         return ARM_DRIVER_ERROR_BUSY;
     }
 
@@ -177,17 +183,13 @@ int32_t StorageVolume::EraseAll(void)
         }
     }
 
-    volumeManager->activeVolume = this;
-    rc = volumeManager->getStorage()->EraseAll();
-    if (rc != ARM_DRIVER_OK) {
-        volumeManager->activeVolume = NULL; /* we're certain that there is no more pending asynch. activity */
-    }
-    return rc;
+    return submitRequest(ARM_STORAGE_OPERATION_ERASE_ALL, 0, NULL, (uint32_t)volumeSize);
 }
 
 ARM_STORAGE_STATUS StorageVolume::GetStatus(void)
 {
-    const uint32_t busy = ((volumeManager->activeVolume != NULL) ? (uint32_t)1 : (uint32_t)0);
+    /* Other volumes may keep the storage busy, but their operations don't stop this volume from queueing one. */
+    const uint32_t busy = (hasRequest() ? (uint32_t)1 : (uint32_t)0);
     ARM_STORAGE_STATUS status = {0, 0};
     status.busy = busy;
     return status;
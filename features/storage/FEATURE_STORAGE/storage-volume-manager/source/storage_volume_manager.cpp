@@ -16,6 +16,8 @@
  */
 
 #include "storage-volume-manager/storage_volume_manager.h"
+#include "hal/us_ticker_api.h"
+#include "platform/critical.h"
 #include <string.h>
 #include <inttypes.h>
 
@@ -106,6 +108,7 @@ STORAGE_API_DEFINITIONS_FOR_VOLUMES(MAX_VOLUMES);
 int32_t StorageVolumeManager::initialize(ARM_DRIVER_STORAGE *mtd, InitializeCallback_t callback)
 {
     activeVolume        = NULL;
+    lastDispatchedIndex = MAX_VOLUMES - 1;
     initializeCallback  = callback;
 
     storage             = mtd;
@@ -256,18 +259,22 @@ void StorageVolumeManager::storageCallback(int32_t status, ARM_STORAGE_OPERATION
         case ARM_STORAGE_OPERATION_PROGRAM_DATA:
         case ARM_STORAGE_OPERATION_ERASE:
         case ARM_STORAGE_OPERATION_ERASE_ALL:
-            if (volumeManager->activeVolume != NULL) {
-                /* Reset activeVolume and invoke callback. We reset activeVolume before the
-                 * callback because the callback may attempt to launch another asynchronous
-                 * operation, which requires 'activeVolume' to be NULL. */
-                StorageVolume *callbackVolume = volumeManager->activeVolume; /* remember the volume which will receive the callback. */
-                volumeManager->activeVolume   = NULL;
-
-                if (callbackVolume->isAllocated() && callbackVolume->getCallback()) {
-                    (callbackVolume->getCallback())(status, operation);
-                }
+        {
+            /* Reset activeVolume and start the next queued request before invoking the
+             * callback. The callback may attempt to launch another operation from the
+             * same volume; this then queues up behind the requests of the other
+             * volumes instead of overtaking them. */
+            core_util_critical_section_enter();
+            StorageVolume *callbackVolume = volumeManager->activeVolume; /* remember the volume which will receive the callback. */
+            volumeManager->activeVolume   = NULL;
+            core_util_critical_section_exit();
+
+            if (callbackVolume != NULL) {
+                volumeManager->dispatchQueuedRequests();
+                volumeManager->completeRequest(callbackVolume, status, true);
             }
             break;
+        }
 
         default:
             tr_error("StorageVolumeManager_callback: unknown operation %u", operation);
@@ -284,3 +291,170 @@ size_t StorageVolumeManager::findIndexOfUnusedVolume(void) const {
     }
     return index;
 }
+
+size_t StorageVolumeManager::numQueuedRequests(void) const {
+    size_t count = 0;
+    for (size_t index = 0; index < MAX_VOLUMES; index++) {
+        if (volumes[index].queued) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int32_t StorageVolumeManager::submitRequest(StorageVolume *volume)
+{
+    volume->request.startTime = us_ticker_read();
+
+    /* The check for a busy storage and the queueing (or claiming of the
+     * storage) must not be split by the completion of the active request,
+     * which may run from an interrupt and would otherwise leave this request
+     * stranded in the queue. */
+    core_util_critical_section_enter();
+    if ((activeVolume != NULL) || (numQueuedRequests() > 0)) {
+        if (!storageCapabilities.asynchronous_ops) {
+            core_util_critical_section_exit();
+            /* the request can't be completed later; we're being called while
+             * a synchronous operation is in progress, e.g. from an interrupt. */
+            return ARM_DRIVER_ERROR_BUSY;
+        }
+
+        size_t depth = numQueuedRequests() + ((activeVolume != NULL) ? 1 : 0);
+        volume->statistics.queuedOperations++;
+        if (depth > volume->statistics.maxQueueDepth) {
+            volume->statistics.maxQueueDepth = depth;
+        }
+
+        volume->queued = true;
+        core_util_critical_section_exit();
+
+        tr_debug("StorageVolumeManager::submitRequest: queued operation %u behind %u others", volume->request.operation, depth);
+        return ARM_DRIVER_OK; /* the request will be dispatched from storageCallback(), resulting in a callback. */
+    }
+    activeVolume = volume; /* claim the storage; startRequest() releases it unless asynchronous activity is left pending. */
+    core_util_critical_section_exit();
+
+    int32_t rc = startRequest(volume);
+    if (rc != ARM_DRIVER_OK) {
+        /* synchronous completion or failure; the status is returned instead of being passed to the callback. */
+        completeRequest(volume, rc, false);
+    }
+    return rc;
+}
+
+/**
+ * Issue a volume's request to the storage.
+ *
+ * @return the return value of the storage operation; activeVolume remains set
+ *     only if it returned ARM_DRIVER_OK for pending asynchronous activity.
+ */
+int32_t StorageVolumeManager::startRequest(StorageVolume *volume)
+{
+    const StorageVolumeRequest_t &request = volume->request;
+    int32_t rc;
+
+    activeVolume = volume;
+    switch (request.operation) {
+        case ARM_STORAGE_OPERATION_POWER_CONTROL:
+            rc = storage->PowerControl(request.state);
+            break;
+        case ARM_STORAGE_OPERATION_READ_DATA:
+            rc = storage->ReadData(request.addr, const_cast<void *>(request.data), request.size);
+            break;
+        case ARM_STORAGE_OPERATION_PROGRAM_DATA:
+            rc = storage->ProgramData(request.addr, request.data, request.size);
+            break;
+        case ARM_STORAGE_OPERATION_ERASE:
+            rc = storage->Erase(request.addr, request.size);
+            break;
+        case ARM_STORAGE_OPERATION_ERASE_ALL:
+            rc = storage->EraseAll();
+            break;
+        default:
+            rc = ARM_DRIVER_ERROR;
+            break;
+    }
+
+    if (rc != ARM_DRIVER_OK) {
+        activeVolume = NULL; /* we're certain that there is no more pending asynch. activity */
+    }
+    return rc;
+}
+
+/**
+ * Start queued requests, taking the volumes in turn, until one of them leaves
+ * asynchronous activity pending. Requests completing synchronously (or
+ * failing) are reported to their volume's callback right away, since the
+ * volume has already been told to expect one.
+ */
+void StorageVolumeManager::dispatchQueuedRequests(void)
+{
+    while (true) {
+        core_util_critical_section_enter();
+        if (activeVolume != NULL) {
+            core_util_critical_section_exit();
+            return;
+        }
+
+        StorageVolume *volume = NULL;
+        for (size_t count = 1; count <= MAX_VOLUMES; count++) {
+            size_t index = (lastDispatchedIndex + count) % MAX_VOLUMES;
+            if (volumes[index].queued) {
+                volume              = &volumes[index];
+                lastDispatchedIndex = index;
+                break;
+            }
+        }
+        if (volume == NULL) {
+            core_util_critical_section_exit();
+            return;
+        }
+
+        volume->queued = false;
+        activeVolume   = volume;
+        core_util_critical_section_exit();
+
+        int32_t rc = startRequest(volume);
+        if (rc != ARM_DRIVER_OK) {
+            completeRequest(volume, rc, true);
+        }
+    }
+}
+
+/**
+ * Account for a completed request and, if 'invokeCallback' is set, pass its
+ * status on to the volume's callback.
+ */
+void StorageVolumeManager::completeRequest(StorageVolume *volume, int32_t status, bool invokeCallback)
+{
+    const StorageVolumeRequest_t &request    = volume->request;
+    StorageVolumeStatistics_t    &statistics = volume->statistics;
+
+    uint32_t latency = us_ticker_read() - request.startTime;
+    statistics.operations++;
+    statistics.totalLatency += latency;
+    if (latency > statistics.maxLatency) {
+        statistics.maxLatency = latency;
+    }
+
+    if (status >= ARM_DRIVER_OK) {
+        switch (request.operation) {
+            case ARM_STORAGE_OPERATION_READ_DATA:
+                statistics.bytesRead += request.size;
+                break;
+            case ARM_STORAGE_OPERATION_PROGRAM_DATA:
+                statistics.bytesProgrammed += request.size;
+                break;
+            case ARM_STORAGE_OPERATION_ERASE:
+            case ARM_STORAGE_OPERATION_ERASE_ALL:
+                statistics.bytesErased += request.size;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (invokeCallback && volume->isAllocated() && volume->getCallback()) {
+        (volume->getCallback())(status, request.operation);
+    }
+}
@@ -23,6 +23,7 @@
 #endif // __cplusplus
 
 #include "storage_abstraction/Driver_Storage.h"
+#include <string.h>
 
 #if !defined(YOTTA_CFG_STORAGE_VOLUME_MANAGER_MAX_VOLUMES)
 #define MAX_VOLUMES 4
@@ -86,9 +87,39 @@ typedef enum _StorageVolumeManager_Status
 typedef void (*InitializeCallback_t)(int32_t status);
 class StorageVolumeManager; /* forward declaration */
 
+/**
+ * Statistics kept by the volume-manager for each volume. Latencies are
+ * measured from the request to its completion, including any time spent
+ * queued behind the operations of other volumes.
+ */
+typedef struct _StorageVolumeStatistics {
+    uint32_t operations;       ///< operations completed, successfully or not.
+    uint32_t queuedOperations; ///< operations which had to wait for the operations of other volumes.
+    uint32_t maxQueueDepth;    ///< the most operations found ahead of an operation of this volume.
+    uint64_t bytesRead;
+    uint64_t bytesProgrammed;
+    uint64_t bytesErased;
+    uint64_t totalLatency;     ///< the sum of the latencies of all operations, in microseconds.
+    uint32_t maxLatency;       ///< the longest latency of an operation, in microseconds.
+} StorageVolumeStatistics_t;
+
+/**
+ * An operation requested through a volume. While the storage is busy with an
+ * operation of another volume, the request is held by the volume until the
+ * volume-manager dispatches it from its completion callback.
+ */
+typedef struct _StorageVolumeRequest {
+    ARM_STORAGE_OPERATION operation;
+    uint64_t              addr;      ///< address within the underlying storage.
+    const void           *data;      ///< source for ProgramData, destination for ReadData.
+    uint32_t              size;
+    ARM_POWER_STATE       state;     ///< for PowerControl.
+    uint32_t              startTime; ///< us_ticker timestamp of the request.
+} StorageVolumeRequest_t;
+
 class StorageVolume {
 public:
-    StorageVolume() : allocated(false) { /* empty */ }
+    StorageVolume() : allocated(false), queued(false) { /* empty */ }
 
 public:
     void setup(uint64_t addr, uint64_t size, StorageVolumeManager *volumeManager);
@@ -119,6 +150,7 @@ public:
 
     void deallocate(void) {
         allocated = false;
+        queued    = false;
     }
 
     /*
@@ -134,6 +166,12 @@ public:
     const ARM_Storage_Callback_t &getCallback(void) const {
         return callback;
     }
+    const StorageVolumeStatistics_t &getStatistics(void) const {
+        return statistics;
+    }
+    void resetStatistics(void) {
+        memset(&statistics, 0, sizeof(statistics));
+    }
 
 private:
     bool overlapsWithBlock(const ARM_STORAGE_BLOCK* blockP) const {
@@ -151,12 +189,20 @@ private:
         blockP->addr -= volumeOffset;
     }
 
+    bool hasRequest(void) const;
+    int32_t submitRequest(ARM_STORAGE_OPERATION operation, uint64_t addr, const void *data, uint32_t size);
+
 private:
-    bool                    allocated;
-    uint64_t                volumeOffset;
-    uint64_t                volumeSize;
-    ARM_Storage_Callback_t  callback;
-    StorageVolumeManager   *volumeManager;
+    friend class StorageVolumeManager;
+
+    bool                      allocated;
+    bool                      queued;        /* the request is waiting for the storage to become available. */
+    uint64_t                  volumeOffset;
+    uint64_t                  volumeSize;
+    ARM_Storage_Callback_t    callback;
+    StorageVolumeManager     *volumeManager;
+    StorageVolumeRequest_t    request;       /* the operation in progress or queued, if any. */
+    StorageVolumeStatistics_t statistics;
 };
 
 class StorageVolumeManager {
@@ -215,6 +261,8 @@ private:
     friend int32_t StorageVolume::Erase(uint64_t addr, uint32_t size);
     friend int32_t StorageVolume::EraseAll(void);
     friend ARM_STORAGE_STATUS StorageVolume::GetStatus(void);
+    friend bool StorageVolume::hasRequest(void) const;
+    friend int32_t StorageVolume::submitRequest(ARM_STORAGE_OPERATION operation, uint64_t addr, const void *data, uint32_t size);
     StorageVolume *activeVolume; /* This state-variable is set to point to a volume
                                   * while there is pending activity. It tracks
                                   * the volume which is at the source of the
@@ -253,8 +301,20 @@ private:
 private:
     size_t findIndexOfUnusedVolume(void) const;
 
+    /*
+     * Requests from volumes. While the storage is busy, each volume may have one
+     * request queued; requests are dispatched from the completion callback,
+     * taking volumes in turn so that none is starved.
+     */
+    int32_t submitRequest(StorageVolume *volume);
+    int32_t startRequest(StorageVolume *volume);
+    void    dispatchQueuedRequests(void);
+    void    completeRequest(StorageVolume *volume, int32_t status, bool invokeCallback);
+    size_t  numQueuedRequests(void) const;
+
 private:
     bool                      initialized;
+    size_t                    lastDispatchedIndex; /* index of the volume whose request was dispatched last. */
     ARM_DRIVER_STORAGE       *storage;
     ARM_STORAGE_INFO          storageInfo;
     ARM_STORAGE_CAPABILITIES  storageCapabilities;
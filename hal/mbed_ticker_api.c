@@ -17,6 +17,171 @@
 #include "hal/ticker_api.h"
 #include "platform/critical.h"
 
+static inline timestamp_t event_deadline(const ticker_event_t *obj) {
+    return obj->timestamp + obj->slack;
+}
+
+#if MBED_CONF_PLATFORM_TICKER_PAIRING_HEAP
+/* Pending events are kept in an intrusive pairing heap. Each event links to
+ * its first child, its next sibling and, through prev, to either its parent
+ * (if it is the first child) or its previous sibling. The back pointer lets
+ * an arbitrary event be unlinked in O(1) without searching for it.
+ *
+ * Events are compared pairwise by deadline with the same wrap-around
+ * arithmetic as the sorted list, so the queue behaves identically as long as all pending
+ * events lie within half the counter range of each other.
+ */
+static ticker_event_t *heap_meld(ticker_event_t *a, ticker_event_t *b) {
+    if ((int)(event_deadline(b) - event_deadline(a)) < 0) {
+        ticker_event_t *t = a;
+        a = b;
+        b = t;
+    }
+
+    // b becomes the first child of a
+    b->prev = a;
+    b->next = a->child;
+    if (a->child != NULL) {
+        a->child->prev = b;
+    }
+    a->child = b;
+
+    return a;
+}
+
+static ticker_event_t *heap_merge_pairs(ticker_event_t *first) {
+    // first pass, meld siblings pairwise from left to right, collecting
+    // the results in reverse order
+    ticker_event_t *pairs = NULL;
+    while (first != NULL) {
+        ticker_event_t *a = first;
+        ticker_event_t *b = a->next;
+        if (b != NULL) {
+            first = b->next;
+            a->next = NULL;
+            b->next = NULL;
+            a = heap_meld(a, b);
+        } else {
+            first = NULL;
+        }
+
+        a->next = pairs;
+        pairs = a;
+    }
+
+    // second pass, meld the results from right to left
+    ticker_event_t *root = pairs;
+    pairs = root->next;
+    root->next = NULL;
+    while (pairs != NULL) {
+        ticker_event_t *p = pairs;
+        pairs = p->next;
+        p->next = NULL;
+        root = heap_meld(root, p);
+    }
+
+    root->prev = NULL;
+    return root;
+}
+
+static void queue_insert(ticker_event_queue_t *queue, ticker_event_t *obj) {
+    obj->next = NULL;
+    obj->child = NULL;
+    obj->prev = NULL;
+
+    if (queue->head == NULL) {
+        queue->head = obj;
+    } else {
+        queue->head = heap_meld(queue->head, obj);
+        queue->head->prev = NULL;
+    }
+}
+
+static void queue_pop(ticker_event_queue_t *queue) {
+    ticker_event_t *root = queue->head;
+    queue->head = root->child ? heap_merge_pairs(root->child) : NULL;
+
+    root->child = NULL;
+}
+
+static void queue_remove(ticker_event_queue_t *queue, ticker_event_t *obj) {
+    if (queue->head == obj) {
+        queue_pop(queue);
+        return;
+    }
+
+    // events that are not queued have no back pointer
+    if (obj->prev == NULL) {
+        return;
+    }
+
+    // unlink ourselves from our parent or previous sibling
+    if (obj->prev->child == obj) {
+        obj->prev->child = obj->next;
+    } else {
+        obj->prev->next = obj->next;
+    }
+    if (obj->next != NULL) {
+        obj->next->prev = obj->prev;
+    }
+
+    // and hand our children back to the heap
+    if (obj->child != NULL) {
+        queue->head = heap_meld(queue->head, heap_merge_pairs(obj->child));
+        queue->head->prev = NULL;
+    }
+
+    obj->next = NULL;
+    obj->child = NULL;
+    obj->prev = NULL;
+}
+#else
+static void queue_insert(ticker_event_queue_t *queue, ticker_event_t *obj) {
+    /* Go through the list until we either reach the end, or find
+       an element this should come before (which is possibly the
+       head). */
+    ticker_event_t *prev = NULL, *p = queue->head;
+    while (p != NULL) {
+        /* check if we come before p */
+        if ((int)(event_deadline(obj) - event_deadline(p)) < 0) {
+            break;
+        }
+        /* go to the next element */
+        prev = p;
+        p = p->next;
+    }
+    /* if prev is NULL we're at the head */
+    if (prev == NULL) {
+        queue->head = obj;
+    } else {
+        prev->next = obj;
+    }
+    /* if we're at the end p will be NULL, which is correct */
+    obj->next = p;
+}
+
+static void queue_pop(ticker_event_queue_t *queue) {
+    queue->head = queue->head->next;
+}
+
+static void queue_remove(ticker_event_queue_t *queue, ticker_event_t *obj) {
+    if (queue->head == obj) {
+        // first in the list, so just drop me
+        queue_pop(queue);
+    } else {
+        // find the object before me, then drop me
+        ticker_event_t* p = queue->head;
+        while (p != NULL) {
+            if (p->next == obj) {
+                p->next = obj->next;
+                break;
+            }
+            p = p->next;
+        }
+    }
+}
+#endif
+
 void ticker_set_handler(const ticker_data_t *const data, ticker_event_handler handler) {
     data->interface->init();
 
@@ -25,6 +190,7 @@ void ticker_set_handler(const ticker_data_t *const data, ticker_event_handler ha
 
 void ticker_irq_handler(const ticker_data_t *const data) {
     data->interface->clear_interrupt();
+    data->queue->irq_count++;
 
     /* Go through all the pending TimerEvents */
     while (1) {
@@ -34,55 +200,49 @@ void ticker_irq_handler(const ticker_data_t *const data) {
             return;
         }
 
-        if ((int)(data->queue->head->timestamp - data->interface->read()) <= 0) {
-            // This event was in the past:
-            //      point to the following one and execute its handler
+        timestamp_t now = data->interface->read();
+        if ((int)(data->queue->head->timestamp - now) > 0) {
+            // This event and the following ones in the queue are in the future:
+            //      set its deadline as next interrupt and return
+            data->interface->set_interrupt(event_deadline(data->queue->head));
+            return;
+        }
+
+        // Fire every event that is due against a single reading of the
+        // counter. Events are ordered by deadline, so we stop at the first
+        // one that is not yet due even if a later one is; it will be fired
+        // no later than its own deadline.
+        do {
             ticker_event_t *p = data->queue->head;
-            data->queue->head = data->queue->head->next;
+            queue_pop(data->queue);
+            data->queue->event_count++;
             if (data->queue->event_handler != NULL) {
                 (*data->queue->event_handler)(p->id); // NOTE: the handler can set new events
             }
             /* Note: We continue back to examining the head because calling the
              * event handler may have altered the chain of pending events. */
-        } else {
-            // This event and the following ones in the list are in the future:
-            //      set it as next interrupt and return
-            data->interface->set_interrupt(data->queue->head->timestamp);
-            return;
-        }
+        } while (data->queue->head != NULL &&
+                 (int)(data->queue->head->timestamp - now) <= 0);
     }
 }
 
 void ticker_insert_event(const ticker_data_t *const data, ticker_event_t *obj, timestamp_t timestamp, uint32_t id) {
+    ticker_insert_event_with_slack(data, obj, timestamp, 0, id);
+}
+
+void ticker_insert_event_with_slack(const ticker_data_t *const data, ticker_event_t *obj, timestamp_t timestamp, timestamp_t slack, uint32_t id) {
     /* disable interrupts for the duration of the function */
     core_util_critical_section_enter();
 
     // initialise our data
     obj->timestamp = timestamp;
+    obj->slack = slack;
     obj->id = id;
 
-    /* Go through the list until we either reach the end, or find
-       an element this should come before (which is possibly the
-       head). */
-    ticker_event_t *prev = NULL, *p = data->queue->head;
-    while (p != NULL) {
-        /* check if we come before p */
-        if ((int)(timestamp - p->timestamp) < 0) {
-            break;
-        }
-        /* go to the next element */
-        prev = p;
-        p = p->next;
-    }
-    /* if prev is NULL we're at the head */
-    if (prev == NULL) {
-        data->queue->head = obj;
-        data->interface->set_interrupt(timestamp);
-    } else {
-        prev->next = obj;
+    queue_insert(data->queue, obj);
+    if (data->queue->head == obj) {
+        data->interface->set_interrupt(event_deadline(obj));
     }
-    /* if we're at the end p will be NULL, which is correct */
-    obj->next = p;
 
     core_util_critical_section_exit();
 }
@@ -90,25 +250,16 @@ void ticker_insert_event(const ticker_data_t *const data, ticker_event_t *obj, t
 void ticker_remove_event(const ticker_data_t *const data, ticker_event_t *obj) {
     core_util_critical_section_enter();
 
-    // remove this object from the list
+    // remove this object from the queue
     if (data->queue->head == obj) {
-        // first in the list, so just drop me
-        data->queue->head = obj->next;
+        queue_remove(data->queue, obj);
         if (data->queue->head == NULL) {
             data->interface->disable_interrupt();
         } else {
-            data->interface->set_interrupt(data->queue->head->timestamp);
+            data->interface->set_interrupt(event_deadline(data->queue->head));
         }
     } else {
-        // find the object before me, then drop me
-        ticker_event_t* p = data->queue->head;
-        while (p != NULL) {
-            if (p->next == obj) {
-                p->next = obj->next;
-                break;
-            }
-            p = p->next;
-        }
+        queue_remove(data->queue, obj);
     }
 
     core_util_critical_section_exit();
@@ -126,10 +277,18 @@ int ticker_get_next_timestamp(const ticker_data_t *const data, timestamp_t *time
     /* if head is NULL, there are no pending events */
     core_util_critical_section_enter();
     if (data->queue->head != NULL) {
-        *timestamp = data->queue->head->timestamp;
+        *timestamp = event_deadline(data->queue->head);
         ret = 1;
     }
     core_util_critical_section_exit();
 
     return ret;
 }
+
+void ticker_get_stats(const ticker_data_t *const data, ticker_stats_t *stats)
+{
+    core_util_critical_section_enter();
+    stats->irq_count = data->queue->irq_count;
+    stats->event_count = data->queue->event_count;
+    core_util_critical_section_exit();
+}
@@ -25,11 +25,24 @@
 typedef uint32_t timestamp_t;
 
 /** Ticker's event structure
+ *
+ * Events are ordered by their deadline, timestamp + slack. An event may be
+ * fired at any time between its timestamp and its deadline, which lets
+ * events with overlapping windows share a single interrupt.
+ *
+ * When MBED_CONF_PLATFORM_TICKER_PAIRING_HEAP is enabled the queue is kept
+ * as an intrusive pairing heap and next links siblings rather than the
+ * next event in time.
  */
 typedef struct ticker_event_s {
     timestamp_t            timestamp; /**< Event's timestamp */
+    timestamp_t            slack;     /**< Tolerated delay past the timestamp */
     uint32_t               id;        /**< TimerEvent object */
     struct ticker_event_s *next;      /**< Next event in the queue */
+#if MBED_CONF_PLATFORM_TICKER_PAIRING_HEAP
+    struct ticker_event_s *child;     /**< First child in the heap */
+    struct ticker_event_s *prev;      /**< Parent if first child, otherwise previous sibling */
+#endif
 } ticker_event_t;
 
 typedef void (*ticker_event_handler)(uint32_t id);
@@ -48,9 +61,18 @@ typedef struct {
  */
 typedef struct {
     ticker_event_handler event_handler; /**< Event handler */
-    ticker_event_t *head;               /**< A pointer to head */
+    ticker_event_t *head;               /**< A pointer to head (the heap root in pairing heap mode) */
+    uint32_t irq_count;                 /**< Number of interrupts serviced */
+    uint32_t event_count;               /**< Number of events fired */
 } ticker_event_queue_t;
 
+/** Ticker's statistics
+ */
+typedef struct {
+    uint32_t irq_count;   /**< Number of interrupts serviced */
+    uint32_t event_count; /**< Number of events fired */
+} ticker_stats_t;
+
 /** Ticker's data structure
  */
 typedef struct {
@@ -96,6 +118,20 @@ void ticker_remove_event(const ticker_data_t *const data, ticker_event_t *obj);
  */
 void ticker_insert_event(const ticker_data_t *const data, ticker_event_t *obj, timestamp_t timestamp, uint32_t id);
 
+/** Insert an event to the queue, allowing it to fire late
+ *
+ * The event may be fired at any time between timestamp and
+ * timestamp + slack, so that events with overlapping windows are
+ * serviced from a single interrupt.
+ *
+ * @param data      The ticker's data
+ * @param obj       The event object to be inserted to the queue
+ * @param timestamp The event's timestamp
+ * @param slack     The tolerated delay past the timestamp
+ * @param id        The event object
+ */
+void ticker_insert_event_with_slack(const ticker_data_t *const data, ticker_event_t *obj, timestamp_t timestamp, timestamp_t slack, uint32_t id);
+
 /** Read the current ticker's timestamp
  *
  * @param data The ticker's data
@@ -104,12 +140,25 @@ void ticker_insert_event(const ticker_data_t *const data, ticker_event_t *obj, t
 timestamp_t ticker_read(const ticker_data_t *const data);
 
 /** Read the next event's timestamp
+ *
+ * For events inserted with slack this is the event's deadline, the time at
+ * which the ticker interrupt is set to fire.
  *
  * @param data The ticker's data
  * @return 1 if timestamp is pending event, 0 if there's no event pending
  */
 int ticker_get_next_timestamp(const ticker_data_t *const data, timestamp_t *timestamp);
 
+/** Read the ticker's interrupt and event counters
+ *
+ * Comparing the number of events fired against the number of interrupts
+ * serviced shows how many wakeups were saved by coalescing events.
+ *
+ * @param data  The ticker's data
+ * @param stats Structure to fill with the counters
+ */
+void ticker_get_stats(const ticker_data_t *const data, ticker_stats_t *stats);
+
 /**@}*/
 
 #ifdef __cplusplus
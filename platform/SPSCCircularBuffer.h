@@ -0,0 +1,225 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SPSCCIRCULARBUFFER_H
+#define MBED_SPSCCIRCULARBUFFER_H
+
+#include <stdint.h>
+#include <string.h>
+#include "cmsis.h"
+
+namespace mbed {
+/** \addtogroup platform */
+/** @{*/
+
+/** Templated single-producer single-consumer circular buffer class
+ *
+ *  Unlike CircularBuffer, this buffer never enters a critical section. It is
+ *  safe as long as only one context pushes and only one context pops, for
+ *  example an interrupt handler feeding a thread. The producer only writes
+ *  the head index and the consumer only writes the tail index. Each side
+ *  issues a data memory barrier (__DMB) after reading the other side's index
+ *  and before touching the elements it covers, and again before publishing
+ *  its own index, so the consumer never reads a half written element and the
+ *  producer never overwrites an element that is still being read.
+ *
+ *  A full buffer rejects new data rather than overwriting the oldest
+ *  element, since the producer can not move the consumer's tail.
+ *
+ *  The bulk push_n, pop_n and peek functions copy elements with memcpy, so
+ *  T must be safe to copy as raw memory.
+ *
+ *  @Note Synchronization level: Interrupt safe for one producer and one
+ *  consumer
+ */
+template<typename T, uint32_t BufferSize>
+class SPSCCircularBuffer {
+    // indexes are masked instead of wrapped with %
+    typedef char buffer_size_must_be_a_power_of_two[
+            (BufferSize > 0 && (BufferSize & (BufferSize - 1)) == 0) ? 1 : -1];
+
+public:
+    SPSCCircularBuffer() : _head(0), _tail(0) {
+    }
+
+    ~SPSCCircularBuffer() {
+    }
+
+    /** Push an element to the buffer, called only by the producer
+     *
+     * @param data Data to be pushed to the buffer
+     * @return True if the data was pushed, false if the buffer is full
+     */
+    bool push(const T& data) {
+        uint32_t head = _head;
+        if (head - _tail == BufferSize) {
+            return false;
+        }
+
+        // the consumer is done with the slot before we overwrite it
+        __DMB();
+        _pool[head & MASK] = data;
+        __DMB();
+        _head = head + 1;
+        return true;
+    }
+
+    /** Push up to n elements to the buffer, called only by the producer
+     *
+     * @param data Data to be pushed to the buffer
+     * @param n Number of elements in data
+     * @return Number of elements pushed, less than n if the buffer filled up
+     */
+    uint32_t push_n(const T *data, uint32_t n) {
+        uint32_t head = _head;
+        uint32_t space = BufferSize - (head - _tail);
+        if (n > space) {
+            n = space;
+        }
+
+        __DMB();
+        // copy in at most two spans, up to the end of the buffer and
+        // then from the start
+        uint32_t first = BufferSize - (head & MASK);
+        if (first > n) {
+            first = n;
+        }
+        memcpy(&_pool[head & MASK], data, first*sizeof(T));
+        memcpy(&_pool[0], data + first, (n - first)*sizeof(T));
+
+        __DMB();
+        _head = head + n;
+        return n;
+    }
+
+    /** Pop an element from the buffer, called only by the consumer
+     *
+     * @param data Data popped from the buffer
+     * @return True if the buffer is not empty and data contains an element, false otherwise
+     */
+    bool pop(T& data) {
+        uint32_t tail = _tail;
+        if (_head == tail) {
+            return false;
+        }
+
+        __DMB();
+        data = _pool[tail & MASK];
+        __DMB();
+        _tail = tail + 1;
+        return true;
+    }
+
+    /** Pop up to n elements from the buffer, called only by the consumer
+     *
+     * @param data Buffer for the popped elements
+     * @param n Maximum number of elements to pop
+     * @return Number of elements popped
+     */
+    uint32_t pop_n(T *data, uint32_t n) {
+        uint32_t tail = _tail;
+        uint32_t count = _head - tail;
+        if (n > count) {
+            n = count;
+        }
+
+        __DMB();
+        uint32_t first = BufferSize - (tail & MASK);
+        if (first > n) {
+            first = n;
+        }
+        memcpy(data, &_pool[tail & MASK], first*sizeof(T));
+        memcpy(data + first, &_pool[0], (n - first)*sizeof(T));
+
+        __DMB();
+        _tail = tail + n;
+        return n;
+    }
+
+    /** Look at the oldest elements without copying them, called only by
+     *  the consumer
+     *
+     *  The elements stay in the buffer until released with consume. Only
+     *  the elements up to the end of the underlying array are returned, so
+     *  a second peek may return more elements after a consume.
+     *
+     * @param data Set to the oldest element in the buffer
+     * @return Number of contiguous elements available at data
+     */
+    uint32_t peek(const T **data) {
+        uint32_t tail = _tail;
+        uint32_t count = _head - tail;
+        uint32_t first = BufferSize - (tail & MASK);
+
+        __DMB();
+        *data = &_pool[tail & MASK];
+        return count < first ? count : first;
+    }
+
+    /** Release elements returned by peek, called only by the consumer
+     *
+     * @param n Number of elements to release, at most the count returned by peek
+     */
+    void consume(uint32_t n) {
+        __DMB();
+        _tail = _tail + n;
+    }
+
+    /** Check if the buffer is empty
+     *
+     * @return True if the buffer is empty, false if not
+     */
+    bool empty() const {
+        return _head == _tail;
+    }
+
+    /** Check if the buffer is full
+     *
+     * @return True if the buffer is full, false if not
+     */
+    bool full() const {
+        return _head - _tail == BufferSize;
+    }
+
+    /** Number of elements in the buffer
+     *
+     * @return Number of elements that can be popped
+     */
+    uint32_t size() const {
+        return _head - _tail;
+    }
+
+    /** Reset the buffer, must not be called while the producer or
+     *  consumer is active
+     *
+     */
+    void reset() {
+        _head = 0;
+        _tail = 0;
+    }
+
+private:
+    static const uint32_t MASK = BufferSize - 1;
+
+    T _pool[BufferSize];
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+};
+
+}
+
+#endif
+
+/** @}*/
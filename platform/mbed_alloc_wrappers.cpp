@@ -19,6 +19,7 @@
 #include "platform/toolchain.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
+#include "platform/mbed_tlsf.h"
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
@@ -34,7 +35,17 @@
 
 Both tracers can be activated and deactivated in any combination. If both tracers
 are active, the second one (MBED_MEM_TRACING_ENABLED) will trace the first one's
-(MBED_HEAP_STATS_ENABLED) memory calls.*/
+(MBED_HEAP_STATS_ENABLED) memory calls.
+
+Independently of the tracers, the platform.tlsf-heap config option serves
+allocations from a TLSF heap carved out of the toolchain's heap on first use,
+giving bounded allocation time. Allocations that do not fit in the TLSF heap
+fall back to the toolchain's heap.*/
+
+#if MBED_CONF_PLATFORM_TLSF_HEAP && \
+    ((defined(TOOLCHAIN_GCC) && !defined(FEATURE_UVISOR)) || defined(TOOLCHAIN_ARM))
+#define MBED_TLSF_HEAP_ENABLED
+#endif
 
 /******************************************************************************/
 /* Implementation of the runtime max heap usage checker                       */
@@ -65,6 +76,83 @@ void mbed_stats_heap_get(mbed_stats_heap_t *stats)
 #endif
 }
 
+/******************************************************************************/
+/* TLSF heap                                                                  */
+/******************************************************************************/
+
+#ifdef MBED_TLSF_HEAP_ENABLED
+static SingletonPtr<PlatformMutex> tlsf_mutex;
+static mbed_tlsf_t *tlsf_heap;
+static bool tlsf_heap_reserved;
+static char *tlsf_heap_start;
+static char *tlsf_heap_end;
+
+/* Memory for the TLSF heap, taken from the toolchain's heap */
+static void *tlsf_heap_reserve(size_t size);
+
+/* Must be called with tlsf_mutex held */
+static void tlsf_heap_init(void)
+{
+    if (tlsf_heap_reserved) {
+        return;
+    }
+
+    tlsf_heap_reserved = true;
+    void *mem = tlsf_heap_reserve(MBED_CONF_PLATFORM_TLSF_HEAP_SIZE);
+    if (mem != NULL) {
+        tlsf_heap = mbed_tlsf_create(mem, MBED_CONF_PLATFORM_TLSF_HEAP_SIZE);
+        tlsf_heap_start = (char*)mem;
+        tlsf_heap_end = tlsf_heap_start + MBED_CONF_PLATFORM_TLSF_HEAP_SIZE;
+    }
+}
+
+static bool tlsf_heap_owns(void *ptr)
+{
+    // The bounds are only set once, before any pointer into the heap exists
+    return (char*)ptr >= tlsf_heap_start && (char*)ptr < tlsf_heap_end;
+}
+
+static void *tlsf_heap_malloc(size_t size)
+{
+    void *ptr = NULL;
+    tlsf_mutex->lock();
+    tlsf_heap_init();
+    if (tlsf_heap != NULL) {
+        ptr = mbed_tlsf_malloc(tlsf_heap, size);
+    }
+    tlsf_mutex->unlock();
+    return ptr;
+}
+
+static void *tlsf_heap_realloc(void *ptr, size_t size)
+{
+    tlsf_mutex->lock();
+    void *new_ptr = mbed_tlsf_realloc(tlsf_heap, ptr, size);
+    tlsf_mutex->unlock();
+    return new_ptr;
+}
+
+static void tlsf_heap_free(void *ptr)
+{
+    tlsf_mutex->lock();
+    mbed_tlsf_free(tlsf_heap, ptr);
+    tlsf_mutex->unlock();
+}
+#endif // #ifdef MBED_TLSF_HEAP_ENABLED
+
+void mbed_stats_heap_ext_get(mbed_stats_heap_ext_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_stats_heap_ext_t));
+#ifdef MBED_TLSF_HEAP_ENABLED
+    tlsf_mutex->lock();
+    tlsf_heap_init();
+    if (tlsf_heap != NULL) {
+        mbed_tlsf_stats(tlsf_heap, stats);
+    }
+    tlsf_mutex->unlock();
+#endif
+}
+
 /******************************************************************************/
 /* GCC memory allocation wrappers                                             */
 /******************************************************************************/
@@ -85,11 +173,80 @@ extern "C" {
 // TODO: memory tracing doesn't work with uVisor enabled.
 #if !defined(FEATURE_UVISOR)
 
+#ifdef MBED_TLSF_HEAP_ENABLED
+#include <reent.h>
+
+static void *tlsf_heap_reserve(size_t size) {
+    return __real__malloc_r(_REENT, size);
+}
+#endif
+
+static void *heap_malloc(struct _reent *r, size_t size) {
+#ifdef MBED_TLSF_HEAP_ENABLED
+    void *ptr = tlsf_heap_malloc(size);
+    if (ptr != NULL) {
+        return ptr;
+    }
+#endif
+    return __real__malloc_r(r, size);
+}
+
+static void *heap_realloc(struct _reent *r, void *ptr, size_t size) {
+#ifdef MBED_TLSF_HEAP_ENABLED
+    if (ptr == NULL) {
+        return heap_malloc(r, size);
+    }
+
+    if (tlsf_heap_owns(ptr)) {
+        if (size == 0) {
+            tlsf_heap_free(ptr);
+            return NULL;
+        }
+
+        // Move to the toolchain's heap if the TLSF heap is exhausted
+        void *new_ptr = tlsf_heap_realloc(ptr, size);
+        if (new_ptr == NULL) {
+            new_ptr = __real__malloc_r(r, size);
+            if (new_ptr != NULL) {
+                size_t old_size = mbed_tlsf_usable_size(ptr);
+                memcpy(new_ptr, ptr, (old_size < size) ? old_size : size);
+                tlsf_heap_free(ptr);
+            }
+        }
+        return new_ptr;
+    }
+#endif
+    return __real__realloc_r(r, ptr, size);
+}
+
+static void heap_free(struct _reent *r, void *ptr) {
+#ifdef MBED_TLSF_HEAP_ENABLED
+    if (tlsf_heap_owns(ptr)) {
+        tlsf_heap_free(ptr);
+        return;
+    }
+#endif
+    __real__free_r(r, ptr);
+}
+
+static void *heap_calloc(struct _reent *r, size_t nmemb, size_t size) {
+#ifdef MBED_TLSF_HEAP_ENABLED
+    if (size == 0 || nmemb <= SIZE_MAX / size) {
+        void *ptr = tlsf_heap_malloc(nmemb * size);
+        if (ptr != NULL) {
+            memset(ptr, 0, nmemb * size);
+            return ptr;
+        }
+    }
+#endif
+    return __real__calloc_r(r, nmemb, size);
+}
+
 extern "C" void * __wrap__malloc_r(struct _reent * r, size_t size) {
     void *ptr = NULL;
 #ifdef MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
-    alloc_info_t *alloc_info = (alloc_info_t*)__real__malloc_r(r, size + sizeof(alloc_info_t));
+    alloc_info_t *alloc_info = (alloc_info_t*)heap_malloc(r, size + sizeof(alloc_info_t));
     if (alloc_info != NULL) {
         alloc_info->size = size;
         ptr = (void*)(alloc_info + 1);
@@ -104,7 +261,7 @@ extern "C" void * __wrap__malloc_r(struct _reent * r, size_t size) {
     }
     malloc_stats_mutex->unlock();
 #else // #ifdef MBED_HEAP_STATS_ENABLED
-    ptr = __real__malloc_r(r, size);
+    ptr = heap_malloc(r, size);
 #endif // #ifdef MBED_HEAP_STATS_ENABLED
 #ifdef MBED_MEM_TRACING_ENABLED
     mem_trace_mutex->lock();
@@ -144,7 +301,7 @@ extern "C" void * __wrap__realloc_r(struct _reent * r, void * ptr, size_t size)
         free(ptr);
     }
 #else // #ifdef MBED_HEAP_STATS_ENABLED
-    new_ptr = __real__realloc_r(r, ptr, size);
+    new_ptr = heap_realloc(r, ptr, size);
 #endif // #ifdef MBED_HEAP_STATS_ENABLED
 #ifdef MBED_MEM_TRACING_ENABLED
     mem_trace_mutex->lock();
@@ -163,10 +320,10 @@ extern "C" void __wrap__free_r(struct _reent * r, void * ptr) {
         heap_stats.current_size -= alloc_info->size;
         heap_stats.alloc_cnt -= 1;
     }
-    __real__free_r(r, (void*)alloc_info);
+    heap_free(r, (void*)alloc_info);
     malloc_stats_mutex->unlock();
 #else // #ifdef MBED_HEAP_STATS_ENABLED
-    __real__free_r(r, ptr);
+    heap_free(r, ptr);
 #endif // #ifdef MBED_HEAP_STATS_ENABLED
 #ifdef MBED_MEM_TRACING_ENABLED
     mem_trace_mutex->lock();
@@ -186,6 +343,8 @@ extern "C" void * __wrap__calloc_r(struct _reent * r, size_t nmemb, size_t size)
     if (ptr != NULL) {
         memset(ptr, 0, nmemb * size);
     }
+#elif !defined(FEATURE_UVISOR) // #ifdef MBED_HEAP_STATS_ENABLED
+    ptr = heap_calloc(r, nmemb, size);
 #else // #ifdef MBED_HEAP_STATS_ENABLED
     ptr = __real__calloc_r(r, nmemb, size);
 #endif // #ifdef MBED_HEAP_STATS_ENABLED
@@ -204,8 +363,8 @@ extern "C" void * __wrap__calloc_r(struct _reent * r, size_t nmemb, size_t size)
 
 #elif defined(TOOLCHAIN_ARM) // #if defined(TOOLCHAIN_GCC)
 
-/* Enable hooking of memory function only if tracing is also enabled */
-#if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED)
+/* Enable hooking of memory function only if tracing or the TLSF heap is also enabled */
+#if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED) || defined(MBED_TLSF_HEAP_ENABLED)
 
 extern "C" {
     void *$Super$$malloc(size_t size);
@@ -214,11 +373,78 @@ extern "C" {
     void $Super$$free(void *ptr);
 }
 
+#ifdef MBED_TLSF_HEAP_ENABLED
+static void *tlsf_heap_reserve(size_t size) {
+    return $Super$$malloc(size);
+}
+#endif
+
+static void *heap_malloc(size_t size) {
+#ifdef MBED_TLSF_HEAP_ENABLED
+    void *ptr = tlsf_heap_malloc(size);
+    if (ptr != NULL) {
+        return ptr;
+    }
+#endif
+    return $Super$$malloc(size);
+}
+
+static void *heap_realloc(void *ptr, size_t size) {
+#ifdef MBED_TLSF_HEAP_ENABLED
+    if (ptr == NULL) {
+        return heap_malloc(size);
+    }
+
+    if (tlsf_heap_owns(ptr)) {
+        if (size == 0) {
+            tlsf_heap_free(ptr);
+            return NULL;
+        }
+
+        // Move to the toolchain's heap if the TLSF heap is exhausted
+        void *new_ptr = tlsf_heap_realloc(ptr, size);
+        if (new_ptr == NULL) {
+            new_ptr = $Super$$malloc(size);
+            if (new_ptr != NULL) {
+                size_t old_size = mbed_tlsf_usable_size(ptr);
+                memcpy(new_ptr, ptr, (old_size < size) ? old_size : size);
+                tlsf_heap_free(ptr);
+            }
+        }
+        return new_ptr;
+    }
+#endif
+    return $Super$$realloc(ptr, size);
+}
+
+static void heap_free(void *ptr) {
+#ifdef MBED_TLSF_HEAP_ENABLED
+    if (tlsf_heap_owns(ptr)) {
+        tlsf_heap_free(ptr);
+        return;
+    }
+#endif
+    $Super$$free(ptr);
+}
+
+static void *heap_calloc(size_t nmemb, size_t size) {
+#ifdef MBED_TLSF_HEAP_ENABLED
+    if (size == 0 || nmemb <= SIZE_MAX / size) {
+        void *ptr = tlsf_heap_malloc(nmemb * size);
+        if (ptr != NULL) {
+            memset(ptr, 0, nmemb * size);
+            return ptr;
+        }
+    }
+#endif
+    return $Super$$calloc(nmemb, size);
+}
+
 extern "C" void* $Sub$$malloc(size_t size) {
     void *ptr = NULL;
 #ifdef MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
-    alloc_info_t *alloc_info = (alloc_info_t*)$Super$$malloc(size + sizeof(alloc_info_t));
+    alloc_info_t *alloc_info = (alloc_info_t*)heap_malloc(size + sizeof(alloc_info_t));
     if (alloc_info != NULL) {
         alloc_info->size = size;
         ptr = (void*)(alloc_info + 1);
@@ -233,7 +459,7 @@ extern "C" void* $Sub$$malloc(size_t size) {
     }
     malloc_stats_mutex->unlock();
 #else // #ifdef MBED_HEAP_STATS_ENABLED
-    ptr = $Super$$malloc(size);
+    ptr = heap_malloc(size);
 #endif // #ifdef MBED_HEAP_STATS_ENABLED
 #ifdef MBED_MEM_TRACING_ENABLED
     mem_trace_mutex->lock();
@@ -268,7 +494,7 @@ extern "C" void* $Sub$$realloc(void *ptr, size_t size) {
         free(ptr);
     }
 #else // #ifdef MBED_HEAP_STATS_ENABLED
-    new_ptr = $Super$$realloc(ptr, size);
+    new_ptr = heap_realloc(ptr, size);
 #endif // #ifdef MBED_HEAP_STATS_ENABLED
 #ifdef MBED_MEM_TRACING_ENABLED
     mem_trace_mutex->lock();
@@ -287,7 +513,7 @@ extern "C" void *$Sub$$calloc(size_t nmemb, size_t size) {
         memset(ptr, 0, nmemb * size);
     }
 #else // #ifdef MBED_HEAP_STATS_ENABLED
-    ptr = $Super$$calloc(nmemb, size);
+    ptr = heap_calloc(nmemb, size);
 #endif // #ifdef MBED_HEAP_STATS_ENABLED
 #ifdef MBED_MEM_TRACING_ENABLED
     mem_trace_mutex->lock();
@@ -306,10 +532,10 @@ extern "C" void $Sub$$free(void *ptr) {
         heap_stats.current_size -= alloc_info->size;
         heap_stats.alloc_cnt -= 1;
     }
-    $Super$$free((void*)alloc_info);
+    heap_free((void*)alloc_info);
     malloc_stats_mutex->unlock();
 #else // #ifdef MBED_HEAP_STATS_ENABLED
-    $Super$$free(ptr);
+    heap_free(ptr);
 #endif // #ifdef MBED_HEAP_STATS_ENABLED
 #ifdef MBED_MEM_TRACING_ENABLED
     mem_trace_mutex->lock();
@@ -318,7 +544,7 @@ extern "C" void $Sub$$free(void *ptr) {
 #endif // #ifdef MBED_MEM_TRACING_ENABLED
 }
 
-#endif // #if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED)
+#endif // #if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED) || defined(MBED_TLSF_HEAP_ENABLED)
 
 /******************************************************************************/
 /* Allocation wrappers for other toolchains are not supported yet             */
@@ -334,5 +560,9 @@ extern "C" void $Sub$$free(void *ptr) {
 #warning Heap statistics are not supported with the current toolchain.
 #endif
 
+#if MBED_CONF_PLATFORM_TLSF_HEAP
+#warning The TLSF heap is not supported with the current toolchain.
+#endif
+
 #endif // #if defined(TOOLCHAIN_GCC)
 
@@ -0,0 +1,106 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CRC32_H
+#define MBED_CRC32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** CRC-32 as used by Ethernet, zlib and PNG
+ *
+ *  Reflected polynomial 0x04C11DB7, initial value and final xor 0xFFFFFFFF;
+ *  the CRC of "123456789" is 0xCBF43926.
+ *
+ *  The table kernel is chosen with the platform.crc32-slices configuration
+ *  option, trading flash for speed:
+ *   - 0: a 64 byte table, processing a nibble at a time
+ *   - 1: a 1KB table, processing a byte at a time
+ *   - 4: 4KB of tables, processing a word at a time (slicing-by-4)
+ *   - 8: 8KB of tables, processing two words at a time (slicing-by-8)
+ *
+ *  Slicing kernels load aligned words, which makes them suitable for
+ *  Cortex-M0 as well as M4/M7, and fall back to a byte at a time on
+ *  big-endian targets.
+ *
+ *  All state is kept in the caller's context, so independent computations
+ *  may be interleaved and run from any thread or interrupt.
+ */
+typedef struct mbed_crc32 {
+    uint32_t remainder;
+} mbed_crc32_t;
+
+/** Start a new CRC computation
+ *
+ *  @param ctx  Context to initialize
+ */
+void mbed_crc32_init(mbed_crc32_t *ctx);
+
+/** Append data to a CRC computation
+ *
+ *  @param ctx  Context of the computation
+ *  @param data Data to append
+ *  @param size Size of the data in bytes
+ */
+void mbed_crc32_update(mbed_crc32_t *ctx, const void *data, size_t size);
+
+/** Get the CRC of all data appended so far
+ *
+ *  The context is left unchanged, so more data may be appended afterwards.
+ *
+ *  @param ctx  Context of the computation
+ *  @return     The CRC
+ */
+uint32_t mbed_crc32_final(const mbed_crc32_t *ctx);
+
+/** Compute a CRC in one call, optionally continuing an earlier one
+ *
+ *  @param crc  CRC of the preceding data, or 0 to start a new computation
+ *  @param data Data to append
+ *  @param size Size of the data in bytes
+ *  @return     The CRC of the preceding data followed by this data
+ */
+uint32_t mbed_crc32(uint32_t crc, const void *data, size_t size);
+
+#if DEVICE_CRC
+/** Target hook for a CRC peripheral, provided by targets defining DEVICE_CRC
+ *
+ *  Called for each update before the table kernel. The target may process
+ *  any leading part of the data, for example only whole words or only
+ *  updates which are large enough to be worth the set up cost, and leaves
+ *  the rest to the table kernel. The target is responsible for sharing the
+ *  peripheral between threads and interrupts.
+ *
+ *  @param remainder CRC remainder (not inverted), to be updated
+ *  @param data      Data to append
+ *  @param size      Size of the data in bytes
+ *  @return          Number of leading bytes processed
+ */
+size_t crc32_target_update(uint32_t *remainder, const uint8_t *data, size_t size);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
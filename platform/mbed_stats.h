@@ -36,6 +36,27 @@ typedef struct {
  */
 void mbed_stats_heap_get(mbed_stats_heap_t *stats);
 
+/** Number of size classes in mbed_stats_heap_ext_t. Class 0 holds blocks
+ *  smaller than 128 bytes, class n holds blocks of 2^(n+6) up to 2^(n+7)
+ *  bytes and the last class also holds all larger blocks.
+ */
+#define MBED_STATS_HEAP_CLASSES 12
+
+typedef struct {
+    uint32_t heap_size;         /**< Bytes managed by the heap. */
+    uint32_t free_size;         /**< Bytes in free blocks. */
+    uint32_t largest_free;      /**< Size of the largest free block. */
+    uint32_t fragmentation;     /**< Percentage of free bytes outside the largest free block. */
+    uint32_t free_blocks[MBED_STATS_HEAP_CLASSES];  /**< Free blocks per size class. */
+} mbed_stats_heap_ext_t;
+
+/**
+ * Fill the passed in structure with extended heap stats. These are only
+ * available when the TLSF heap is enabled, otherwise the structure is
+ * zeroed.
+ */
+void mbed_stats_heap_ext_get(mbed_stats_heap_ext_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,420 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/mbed_tlsf.h"
+#include <stdbool.h>
+#include <string.h>
+
+/* Allocations are aligned to 8 bytes, and each power of two of block size
+ * is split into 16 lists. Blocks smaller than 128 bytes all share the first
+ * power of two, split linearly in steps of 8 bytes. */
+#define TLSF_ALIGN_LOG2     3
+#define TLSF_ALIGN          (1u << TLSF_ALIGN_LOG2)
+#define TLSF_SL_LOG2        4
+#define TLSF_SL_COUNT       (1u << TLSF_SL_LOG2)
+#define TLSF_FL_SHIFT       (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_FL_COUNT       (MBED_TLSF_FL_INDEX_MAX - TLSF_FL_SHIFT + 1)
+#define TLSF_SMALL_BLOCK    (1u << TLSF_FL_SHIFT)
+
+#if TLSF_FL_COUNT < 1 || TLSF_FL_COUNT > 31
+#error "MBED_TLSF_FL_INDEX_MAX out of range"
+#endif
+
+/* Every block starts with a header linking it to its physical neighbours.
+ * The size counts the payload following the header, and its low bit marks
+ * free blocks, which keep their free list links in the payload. */
+typedef struct tlsf_block {
+    struct tlsf_block *prev_phys;
+    size_t size;
+
+    struct tlsf_block *next_free;
+    struct tlsf_block *prev_free;
+} tlsf_block_t;
+
+#define BLOCK_FREE          ((size_t)1)
+#define BLOCK_START         offsetof(tlsf_block_t, next_free)
+#define BLOCK_SIZE_MIN      \
+    ((sizeof(tlsf_block_t) - BLOCK_START + TLSF_ALIGN - 1) & ~(size_t)(TLSF_ALIGN - 1))
+#define BLOCK_SIZE_MAX      (((size_t)1 << MBED_TLSF_FL_INDEX_MAX) - TLSF_ALIGN)
+
+struct mbed_tlsf {
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[TLSF_FL_COUNT];
+    tlsf_block_t *blocks[TLSF_FL_COUNT][TLSF_SL_COUNT];
+    size_t heap_size;
+};
+
+
+/* Bit scans, compiling down to a single instruction where available */
+static inline int tlsf_fls(uint32_t word)
+{
+#if defined(__GNUC__)
+    return word ? 31 - __builtin_clz(word) : -1;
+#elif defined(__CC_ARM)
+    return word ? 31 - __clz(word) : -1;
+#else
+    int bit = -1;
+    while (word) {
+        bit++;
+        word >>= 1;
+    }
+    return bit;
+#endif
+}
+
+static inline int tlsf_ffs(uint32_t word)
+{
+    return tlsf_fls(word & (~word + 1));
+}
+
+
+/* Block helpers */
+static inline size_t block_size(const tlsf_block_t *block)
+{
+    return block->size & ~BLOCK_FREE;
+}
+
+static inline bool block_is_free(const tlsf_block_t *block)
+{
+    return block->size & BLOCK_FREE;
+}
+
+static inline void *block_to_ptr(tlsf_block_t *block)
+{
+    return (unsigned char *)block + BLOCK_START;
+}
+
+static inline tlsf_block_t *block_from_ptr(void *ptr)
+{
+    return (tlsf_block_t *)((unsigned char *)ptr - BLOCK_START);
+}
+
+static inline tlsf_block_t *block_next(tlsf_block_t *block)
+{
+    return (tlsf_block_t *)((unsigned char *)block_to_ptr(block) + block_size(block));
+}
+
+/* Round a request up to a valid block size, or 0 if it is too large */
+static inline size_t adjust_size(size_t size)
+{
+    if (size > BLOCK_SIZE_MAX) {
+        return 0;
+    }
+
+    size = (size + TLSF_ALIGN - 1) & ~(size_t)(TLSF_ALIGN - 1);
+    return size < BLOCK_SIZE_MIN ? BLOCK_SIZE_MIN : size;
+}
+
+
+/* Find the list a block of the given size belongs to */
+static inline void mapping_insert(size_t size, int *fli, int *sli)
+{
+    int fl, sl;
+    if (size < TLSF_SMALL_BLOCK) {
+        fl = 0;
+        sl = (int)size / (TLSF_SMALL_BLOCK / TLSF_SL_COUNT);
+    } else {
+        fl = tlsf_fls((uint32_t)size);
+        sl = (int)(size >> (fl - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+        fl -= TLSF_FL_SHIFT - 1;
+    }
+
+    *fli = fl;
+    *sli = sl;
+}
+
+/* Find the first list whose blocks are all large enough for the given
+ * size, by rounding the size up to the next list boundary */
+static inline void mapping_search(size_t size, int *fli, int *sli)
+{
+    if (size >= TLSF_SMALL_BLOCK) {
+        size += ((size_t)1 << (tlsf_fls((uint32_t)size) - TLSF_SL_LOG2)) - 1;
+    }
+
+    mapping_insert(size, fli, sli);
+}
+
+static tlsf_block_t *search_suitable_block(mbed_tlsf_t *tlsf, int *fli, int *sli)
+{
+    int fl = *fli;
+    int sl = *sli;
+
+    // look for a non-empty list in the same power of two first, then
+    // take the smallest list in the next non-empty power of two
+    uint32_t sl_map = tlsf->sl_bitmap[fl] & (~0u << sl);
+    if (!sl_map) {
+        uint32_t fl_map = tlsf->fl_bitmap & (~0u << (fl + 1));
+        if (!fl_map) {
+            return NULL;
+        }
+
+        fl = tlsf_ffs(fl_map);
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+    sl = tlsf_ffs(sl_map);
+
+    *fli = fl;
+    *sli = sl;
+    return tlsf->blocks[fl][sl];
+}
+
+
+/* Free list maintenance */
+static void remove_free_block(mbed_tlsf_t *tlsf, tlsf_block_t *block, int fl, int sl)
+{
+    tlsf_block_t *prev = block->prev_free;
+    tlsf_block_t *next = block->next_free;
+    if (next) {
+        next->prev_free = prev;
+    }
+
+    if (prev) {
+        prev->next_free = next;
+    } else {
+        tlsf->blocks[fl][sl] = next;
+        if (!next) {
+            tlsf->sl_bitmap[fl] &= ~(1u << sl);
+            if (!tlsf->sl_bitmap[fl]) {
+                tlsf->fl_bitmap &= ~(1u << fl);
+            }
+        }
+    }
+}
+
+static void insert_free_block(mbed_tlsf_t *tlsf, tlsf_block_t *block, int fl, int sl)
+{
+    tlsf_block_t *head = tlsf->blocks[fl][sl];
+    block->next_free = head;
+    block->prev_free = NULL;
+    if (head) {
+        head->prev_free = block;
+    }
+
+    tlsf->blocks[fl][sl] = block;
+    tlsf->fl_bitmap |= 1u << fl;
+    tlsf->sl_bitmap[fl] |= 1u << sl;
+}
+
+static void block_remove(mbed_tlsf_t *tlsf, tlsf_block_t *block)
+{
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+    remove_free_block(tlsf, block, fl, sl);
+}
+
+static void block_insert(mbed_tlsf_t *tlsf, tlsf_block_t *block)
+{
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+    insert_free_block(tlsf, block, fl, sl);
+}
+
+/* Split the end off a block if it is large enough to form a block of its
+ * own, returning the new block marked as free */
+static tlsf_block_t *block_split(tlsf_block_t *block, size_t size)
+{
+    if (block_size(block) < size + BLOCK_START + BLOCK_SIZE_MIN) {
+        return NULL;
+    }
+
+    tlsf_block_t *rest = (tlsf_block_t *)((unsigned char *)block_to_ptr(block) + size);
+    rest->size = block_size(block) - size - BLOCK_START;
+    rest->prev_phys = block;
+    block_next(rest)->prev_phys = rest;
+    rest->size |= BLOCK_FREE;
+
+    block->size = size | (block->size & BLOCK_FREE);
+    return rest;
+}
+
+/* Absorb free physical neighbours into a block */
+static tlsf_block_t *block_merge_prev(mbed_tlsf_t *tlsf, tlsf_block_t *block)
+{
+    tlsf_block_t *prev = block->prev_phys;
+    if (prev && block_is_free(prev)) {
+        block_remove(tlsf, prev);
+        prev->size += block_size(block) + BLOCK_START;
+        block_next(prev)->prev_phys = prev;
+        block = prev;
+    }
+
+    return block;
+}
+
+static tlsf_block_t *block_merge_next(mbed_tlsf_t *tlsf, tlsf_block_t *block)
+{
+    tlsf_block_t *next = block_next(block);
+    if (block_is_free(next)) {
+        block_remove(tlsf, next);
+        block->size += block_size(next) + BLOCK_START;
+        block_next(block)->prev_phys = block;
+    }
+
+    return block;
+}
+
+
+/* Heap operations */
+mbed_tlsf_t *mbed_tlsf_create(void *mem, size_t size)
+{
+    // the control structure is followed by a single free block spanning
+    // the memory, and a zero sized sentinel block that is never free
+    size_t control = (sizeof(mbed_tlsf_t) + TLSF_ALIGN - 1) & ~(size_t)(TLSF_ALIGN - 1);
+    if (size < control + 2*BLOCK_START + BLOCK_SIZE_MIN) {
+        return NULL;
+    }
+
+    size_t pool = (size - control - 2*BLOCK_START) & ~(size_t)(TLSF_ALIGN - 1);
+    if (pool > BLOCK_SIZE_MAX) {
+        pool = BLOCK_SIZE_MAX;
+    }
+
+    mbed_tlsf_t *tlsf = (mbed_tlsf_t *)mem;
+    memset(tlsf, 0, sizeof(mbed_tlsf_t));
+    tlsf->heap_size = pool;
+
+    tlsf_block_t *block = (tlsf_block_t *)((unsigned char *)mem + control);
+    block->prev_phys = NULL;
+    block->size = pool | BLOCK_FREE;
+
+    tlsf_block_t *sentinel = block_next(block);
+    sentinel->prev_phys = block;
+    sentinel->size = 0;
+
+    block_insert(tlsf, block);
+    return tlsf;
+}
+
+void *mbed_tlsf_malloc(mbed_tlsf_t *tlsf, size_t size)
+{
+    size = adjust_size(size);
+    if (!size) {
+        return NULL;
+    }
+
+    int fl, sl;
+    mapping_search(size, &fl, &sl);
+    if (fl >= TLSF_FL_COUNT) {
+        return NULL;
+    }
+
+    tlsf_block_t *block = search_suitable_block(tlsf, &fl, &sl);
+    if (!block) {
+        return NULL;
+    }
+    remove_free_block(tlsf, block, fl, sl);
+
+    // free blocks never neighbour each other, so the remainder can go
+    // straight back on a free list
+    tlsf_block_t *rest = block_split(block, size);
+    if (rest) {
+        block_insert(tlsf, rest);
+    }
+
+    block->size &= ~BLOCK_FREE;
+    return block_to_ptr(block);
+}
+
+void *mbed_tlsf_realloc(mbed_tlsf_t *tlsf, void *ptr, size_t size)
+{
+    if (!ptr) {
+        return mbed_tlsf_malloc(tlsf, size);
+    }
+
+    if (!size) {
+        mbed_tlsf_free(tlsf, ptr);
+        return NULL;
+    }
+
+    size_t adjusted = adjust_size(size);
+    if (!adjusted) {
+        return NULL;
+    }
+
+    tlsf_block_t *block = block_from_ptr(ptr);
+    size_t current = block_size(block);
+    if (adjusted > current) {
+        // grow into the next block if it is free and large enough,
+        // otherwise move the allocation
+        tlsf_block_t *next = block_next(block);
+        if (block_is_free(next) &&
+                current + BLOCK_START + block_size(next) >= adjusted) {
+            block_merge_next(tlsf, block);
+        } else {
+            void *moved = mbed_tlsf_malloc(tlsf, size);
+            if (moved) {
+                memcpy(moved, ptr, current);
+                mbed_tlsf_free(tlsf, ptr);
+            }
+            return moved;
+        }
+    }
+
+    // return any excess to the heap
+    tlsf_block_t *rest = block_split(block, adjusted);
+    if (rest) {
+        rest = block_merge_next(tlsf, rest);
+        block_insert(tlsf, rest);
+    }
+
+    return ptr;
+}
+
+void mbed_tlsf_free(mbed_tlsf_t *tlsf, void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    tlsf_block_t *block = block_from_ptr(ptr);
+    block->size |= BLOCK_FREE;
+    block = block_merge_prev(tlsf, block);
+    block = block_merge_next(tlsf, block);
+    block_insert(tlsf, block);
+}
+
+size_t mbed_tlsf_usable_size(void *ptr)
+{
+    return block_size(block_from_ptr(ptr));
+}
+
+void mbed_tlsf_stats(mbed_tlsf_t *tlsf, mbed_stats_heap_ext_t *stats)
+{
+    memset(stats, 0, sizeof(mbed_stats_heap_ext_t));
+    stats->heap_size = tlsf->heap_size;
+
+    for (int fl = 0; fl < TLSF_FL_COUNT; fl++) {
+        for (int sl = 0; sl < (int)TLSF_SL_COUNT; sl++) {
+            for (tlsf_block_t *block = tlsf->blocks[fl][sl]; block; block = block->next_free) {
+                uint32_t size = block_size(block);
+                stats->free_size += size;
+                if (size > stats->largest_free) {
+                    stats->largest_free = size;
+                }
+
+                int size_class = size < 128 ? 0 : tlsf_fls(size) - 6;
+                if (size_class > MBED_STATS_HEAP_CLASSES - 1) {
+                    size_class = MBED_STATS_HEAP_CLASSES - 1;
+                }
+                stats->free_blocks[size_class] += 1;
+            }
+        }
+    }
+
+    if (stats->free_size) {
+        stats->fragmentation = 100 - (uint32_t)(
+                (uint64_t)stats->largest_free * 100 / stats->free_size);
+    }
+}
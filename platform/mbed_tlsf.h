@@ -0,0 +1,108 @@
+/** \addtogroup platform */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2017 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_TLSF_H
+#define MBED_TLSF_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/mbed_stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Two-level segregated-fit allocator
+ *
+ *  Free blocks are kept in lists indexed first by the power of two of their
+ *  size and then by a linear subdivision of that range. A pair of bitmaps
+ *  locates the smallest suitable non-empty list with a couple of bit scans,
+ *  so allocation and deallocation take bounded time regardless of the
+ *  state of the heap, and adjacent free blocks are merged immediately.
+ *
+ *  The allocator is not thread safe, callers must serialize access to each
+ *  heap.
+ */
+typedef struct mbed_tlsf mbed_tlsf_t;
+
+/** Log2 of the largest block the allocator can manage, each additional
+ *  power of two costs 16 list pointers in the heap's control structure.
+ */
+#ifndef MBED_TLSF_FL_INDEX_MAX
+#define MBED_TLSF_FL_INDEX_MAX 24
+#endif
+
+/** Create a heap in the provided memory
+ *
+ *  The control structure is placed at the start of the memory, and the
+ *  remainder is available for allocations.
+ *
+ *  @param mem  Memory for the heap, must be aligned to 8 bytes
+ *  @param size Size of the memory in bytes
+ *  @return     The heap, or NULL if the memory is too small
+ */
+mbed_tlsf_t *mbed_tlsf_create(void *mem, size_t size);
+
+/** Allocate memory from a heap
+ *
+ *  @param tlsf The heap
+ *  @param size Size of the allocation in bytes
+ *  @return     Memory aligned to 8 bytes, or NULL if no free block fits
+ */
+void *mbed_tlsf_malloc(mbed_tlsf_t *tlsf, size_t size);
+
+/** Resize an allocation, in place if possible
+ *
+ *  @param tlsf The heap
+ *  @param ptr  Allocation to resize, or NULL to allocate
+ *  @param size New size in bytes, or 0 to free
+ *  @return     The resized allocation, or NULL on failure in which case
+ *              ptr is unchanged
+ */
+void *mbed_tlsf_realloc(mbed_tlsf_t *tlsf, void *ptr, size_t size);
+
+/** Free memory allocated from a heap
+ *
+ *  @param tlsf The heap
+ *  @param ptr  Allocation to free, may be NULL
+ */
+void mbed_tlsf_free(mbed_tlsf_t *tlsf, void *ptr);
+
+/** Usable size of an allocation
+ *
+ *  @param ptr  Allocation from a heap
+ *  @return     Bytes usable at ptr, at least the requested size
+ */
+size_t mbed_tlsf_usable_size(void *ptr);
+
+/** Collect the free block statistics of a heap
+ *
+ *  This walks the free lists, so unlike the allocation functions it takes
+ *  time proportional to the number of free blocks.
+ *
+ *  @param tlsf  The heap
+ *  @param stats Structure to fill in
+ */
+void mbed_tlsf_stats(mbed_tlsf_t *tlsf, mbed_stats_heap_ext_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
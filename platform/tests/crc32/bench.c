@@ -0,0 +1,114 @@
+/*
+ * Host correctness test and throughput benchmark for mbed_crc32
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/mbed_crc32.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+
+// Benchmark setup
+#define BENCH_BUFFER_SIZE (64*1024)
+#define BENCH_BYTES (256*1024*1024)
+
+static uint8_t buffer[BENCH_BUFFER_SIZE + 8];
+
+static uint64_t bench_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+
+// Bit at a time reference
+static uint32_t reference_crc32(const uint8_t *data, size_t size) {
+    uint32_t crc = 0xFFFFFFFF;
+    while (size--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+static int check(void) {
+    if (mbed_crc32(0, "123456789", 9) != 0xCBF43926) {
+        printf("check value mismatch\n");
+        return 1;
+    }
+
+    // every alignment and length up to a few words, split at every point
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t size = 0; size < 64; size++) {
+            const uint8_t *data = buffer + offset;
+            uint32_t expected = reference_crc32(data, size);
+            for (size_t split = 0; split <= size; split++) {
+                mbed_crc32_t ctx;
+                mbed_crc32_init(&ctx);
+                mbed_crc32_update(&ctx, data, split);
+                mbed_crc32_update(&ctx, data + split, size - split);
+                if (mbed_crc32_final(&ctx) != expected ||
+                    mbed_crc32(mbed_crc32(0, data, split), data + split, size - split) != expected) {
+                    printf("mismatch at offset %zu size %zu split %zu\n", offset, size, split);
+                    return 1;
+                }
+            }
+        }
+    }
+
+    if (mbed_crc32(0, buffer, BENCH_BUFFER_SIZE) != reference_crc32(buffer, BENCH_BUFFER_SIZE)) {
+        printf("mismatch on the whole buffer\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+static double bench(size_t size, size_t offset) {
+    volatile uint32_t sink = 0;
+    size_t rounds = BENCH_BYTES / size;
+    if (rounds > 4*1024*1024) {
+        rounds = 4*1024*1024;
+    }
+
+    uint64_t start = bench_time();
+    for (size_t i = 0; i < rounds; i++) {
+        sink ^= mbed_crc32(0, buffer + offset, size);
+    }
+    uint64_t elapsed = bench_time() - start;
+    (void)sink;
+
+    return (double)rounds*size / ((double)elapsed / 1e9) / (1024*1024);
+}
+
+int main(void) {
+    srand(1);
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = rand();
+    }
+
+    if (check()) {
+        return 1;
+    }
+
+    printf("crc32-slices=%d: %8.1f MB/s (64KB), %8.1f MB/s (64KB unaligned), "
+           "%8.1f MB/s (256B), %8.1f MB/s (16B)\n",
+           MBED_CONF_PLATFORM_CRC32_SLICES,
+           bench(BENCH_BUFFER_SIZE, 0), bench(BENCH_BUFFER_SIZE, 1),
+           bench(256, 0), bench(16, 0));
+    return 0;
+}
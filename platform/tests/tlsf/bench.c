@@ -0,0 +1,191 @@
+/*
+ * Host stress test and latency benchmark for the TLSF heap
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/mbed_tlsf.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+
+// Benchmark setup
+#define BENCH_HEAP_SIZE (256*1024)
+#define BENCH_SLOTS 1024
+#define BENCH_OPS 1000000
+#define BENCH_MAX_SIZE 2048
+
+struct bench_heap {
+    const char *name;
+    void *(*malloc)(size_t size);
+    void (*free)(void *ptr);
+};
+
+static mbed_tlsf_t *tlsf;
+
+static void *tlsf_malloc(size_t size) {
+    return mbed_tlsf_malloc(tlsf, size);
+}
+
+static void tlsf_free(void *ptr) {
+    mbed_tlsf_free(tlsf, ptr);
+}
+
+static const struct bench_heap bench_heaps[] = {
+    {"libc", malloc, free},
+    {"tlsf", tlsf_malloc, tlsf_free},
+};
+
+static uint64_t bench_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+
+static int bench_compare(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_report(const char *heap, const char *op,
+        uint32_t *samples, uint32_t count) {
+    qsort(samples, count, sizeof(uint32_t), bench_compare);
+    printf("%s %s: p50 %"PRIu32" ns, p99 %"PRIu32" ns, "
+            "p99.9 %"PRIu32" ns, max %"PRIu32" ns\n",
+            heap, op,
+            samples[count/2],
+            samples[count - count/100 - 1],
+            samples[count - count/1000 - 1],
+            samples[count - 1]);
+}
+
+// sizes are spread logarithmically, as most allocations are small
+static size_t bench_size(void) {
+    int bits = 3 + rand() % 9;
+    return 1 + rand() % (1 << bits);
+}
+
+
+// Random malloc/free churn over a fixed number of slots, each allocation
+// is filled with its slot number and checked when freed
+static void bench_run(const struct bench_heap *heap) {
+    static void *slots[BENCH_SLOTS];
+    static size_t sizes[BENCH_SLOTS];
+    static uint32_t malloc_ns[BENCH_OPS];
+    static uint32_t free_ns[BENCH_OPS];
+    uint32_t mallocs = 0;
+    uint32_t frees = 0;
+    uint32_t failures = 0;
+
+    memset(slots, 0, sizeof(slots));
+    srand(1);
+
+    for (int i = 0; i < BENCH_OPS; i++) {
+        int slot = rand() % BENCH_SLOTS;
+        if (slots[slot]) {
+            unsigned char *p = slots[slot];
+            for (size_t j = 0; j < sizes[slot]; j++) {
+                if (p[j] != (unsigned char)slot) {
+                    printf("%s: corrupted allocation\n", heap->name);
+                    exit(1);
+                }
+            }
+
+            uint64_t start = bench_time();
+            heap->free(slots[slot]);
+            free_ns[frees++] = bench_time() - start;
+            slots[slot] = NULL;
+        } else {
+            size_t size = bench_size();
+            uint64_t start = bench_time();
+            void *p = heap->malloc(size);
+            malloc_ns[mallocs++] = bench_time() - start;
+
+            if (!p) {
+                failures++;
+                continue;
+            }
+
+            memset(p, slot, size);
+            slots[slot] = p;
+            sizes[slot] = size;
+        }
+    }
+
+    for (int i = 0; i < BENCH_SLOTS; i++) {
+        heap->free(slots[i]);
+    }
+
+    bench_report(heap->name, "malloc", malloc_ns, mallocs);
+    bench_report(heap->name, "free", free_ns, frees);
+    if (failures) {
+        printf("%s: %"PRIu32" failed allocations\n", heap->name, failures);
+    }
+}
+
+
+// Free block statistics of a fragmented heap
+static void bench_stats(void) {
+    static void *slots[BENCH_SLOTS];
+    srand(2);
+    for (int i = 0; i < BENCH_SLOTS; i++) {
+        slots[i] = mbed_tlsf_malloc(tlsf, bench_size());
+    }
+    for (int i = 0; i < BENCH_SLOTS; i += 2) {
+        mbed_tlsf_free(tlsf, slots[i]);
+    }
+
+    mbed_stats_heap_ext_t stats;
+    mbed_tlsf_stats(tlsf, &stats);
+    printf("tlsf stats: heap %"PRIu32", free %"PRIu32", largest free %"PRIu32", "
+            "fragmentation %"PRIu32"%%\n",
+            stats.heap_size, stats.free_size, stats.largest_free,
+            stats.fragmentation);
+    printf("tlsf free blocks per class:");
+    for (int i = 0; i < MBED_STATS_HEAP_CLASSES; i++) {
+        printf(" %"PRIu32, stats.free_blocks[i]);
+    }
+    printf("\n");
+
+    for (int i = 1; i < BENCH_SLOTS; i += 2) {
+        mbed_tlsf_free(tlsf, slots[i]);
+    }
+
+    // everything merges back into a single block
+    mbed_tlsf_stats(tlsf, &stats);
+    if (stats.free_size != stats.heap_size || stats.fragmentation != 0) {
+        printf("tlsf: heap did not coalesce\n");
+        exit(1);
+    }
+}
+
+
+int main() {
+    static uint64_t heap[BENCH_HEAP_SIZE/sizeof(uint64_t)];
+    tlsf = mbed_tlsf_create(heap, sizeof(heap));
+    if (!tlsf) {
+        printf("tlsf: heap creation failed\n");
+        return 1;
+    }
+
+    printf("beginning benchmark, %d operations over %d slots...\n",
+            BENCH_OPS, BENCH_SLOTS);
+    for (unsigned i = 0; i < sizeof(bench_heaps)/sizeof(bench_heaps[0]); i++) {
+        bench_run(&bench_heaps[i]);
+    }
+    bench_stats();
+    printf("done!\n");
+}